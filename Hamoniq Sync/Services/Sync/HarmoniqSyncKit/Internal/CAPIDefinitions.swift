@@ -18,6 +18,8 @@ public let HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA: harmoniq_sync_error_t = -2
 public let HARMONIQ_SYNC_ERROR_PROCESSING_FAILED: harmoniq_sync_error_t = -3
 public let HARMONIQ_SYNC_ERROR_OUT_OF_MEMORY: harmoniq_sync_error_t = -4
 public let HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT: harmoniq_sync_error_t = -5
+public let HARMONIQ_SYNC_ERROR_CANCELLED: harmoniq_sync_error_t = -6
+public let HARMONIQ_SYNC_ERROR_TIMEOUT: harmoniq_sync_error_t = -7
 
 // Method types
 public typealias harmoniq_sync_method_t = Int32
@@ -37,9 +39,17 @@ public struct harmoniq_sync_result_t {
     public let noise_floor_db: Double
     public let method: (Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8, Int8)
     public let error: harmoniq_sync_error_t
+    public let offset_samples_fractional: Double
+    public let drift_ppm: Double
+    public let drift_segments: Int32
+    public let searched_offset_samples: Int64
     
-    public init(offset_samples: Int64 = 0, confidence: Double = 0.0, peak_correlation: Double = 0.0, secondary_peak_ratio: Double = 0.0, snr_estimate: Double = 0.0, noise_floor_db: Double = -60.0, method: String = "mock", error: harmoniq_sync_error_t = HARMONIQ_SYNC_SUCCESS) {
+    public init(offset_samples: Int64 = 0, confidence: Double = 0.0, peak_correlation: Double = 0.0, secondary_peak_ratio: Double = 0.0, snr_estimate: Double = 0.0, noise_floor_db: Double = -60.0, method: String = "mock", error: harmoniq_sync_error_t = HARMONIQ_SYNC_SUCCESS, offset_samples_fractional: Double? = nil, drift_ppm: Double = 0.0, drift_segments: Int32 = 0, searched_offset_samples: Int64 = 0) {
         self.offset_samples = offset_samples
+        self.offset_samples_fractional = offset_samples_fractional ?? Double(offset_samples)
+        self.drift_ppm = drift_ppm
+        self.drift_segments = drift_segments
+        self.searched_offset_samples = searched_offset_samples
         self.confidence = confidence
         self.peak_correlation = peak_correlation
         self.secondary_peak_ratio = secondary_peak_ratio
@@ -82,14 +92,26 @@ public struct harmoniq_sync_config_t {
     public let hop_size: Int32
     public let noise_gate_db: Double
     public let enable_drift_correction: Int32
+    public let worker_count: Int32
+    public let coarse_hop_size: Int32
+    public let analysis_sample_rate: Double
+    public let hybrid_cascade: Int32
+    public let correlation_precision: Int32
+    public let correlation_memory_mb: Int32
     
-    public init(confidence_threshold: Double = 0.7, max_offset_samples: Int64 = 0, window_size: Int32 = 1024, hop_size: Int32 = 256, noise_gate_db: Double = -40.0, enable_drift_correction: Int32 = 1) {
+    public init(confidence_threshold: Double = 0.7, max_offset_samples: Int64 = 0, window_size: Int32 = 1024, hop_size: Int32 = 256, noise_gate_db: Double = -40.0, enable_drift_correction: Int32 = 1, worker_count: Int32 = 0, coarse_hop_size: Int32 = 0, analysis_sample_rate: Double = 0, hybrid_cascade: Int32 = 0, correlation_precision: Int32 = 0, correlation_memory_mb: Int32 = 0) {
         self.confidence_threshold = confidence_threshold
         self.max_offset_samples = max_offset_samples
         self.window_size = window_size
         self.hop_size = hop_size
         self.noise_gate_db = noise_gate_db
         self.enable_drift_correction = enable_drift_correction
+        self.worker_count = worker_count
+        self.coarse_hop_size = coarse_hop_size
+        self.analysis_sample_rate = analysis_sample_rate
+        self.hybrid_cascade = hybrid_cascade
+        self.correlation_precision = correlation_precision
+        self.correlation_memory_mb = correlation_memory_mb
     }
 }
 
@@ -155,7 +177,7 @@ public func harmoniq_sync_align(
         offset_samples: offsetSamples,
         confidence: confidence,
         peak_correlation: correlation,
-        secondary_peak_ratio: 0.3,
+        secondary_peak_ratio: 3.0,
         snr_estimate: 25.0,
         noise_floor_db: -45.0,
         method: methodName,
@@ -28,17 +28,19 @@ public class SyncEngine {
         public let secondaryPeakRatio: Double
         public let snrEstimate: Double
         public let noiseFloorDb: Double
+        public let driftPpm: Double  // Target clock drift (0 = none detected)
         public let method: String
         public let isValid: Bool
         
         internal init(from cResult: harmoniq_sync_result_t, sampleRate: Double) {
             self.offsetSamples = cResult.offset_samples
-            self.offsetSeconds = Double(cResult.offset_samples) / sampleRate
+            self.offsetSeconds = cResult.offset_samples_fractional / sampleRate
             self.confidence = cResult.confidence
             self.peakCorrelation = cResult.peak_correlation
             self.secondaryPeakRatio = cResult.secondary_peak_ratio
             self.snrEstimate = cResult.snr_estimate
             self.noiseFloorDb = cResult.noise_floor_db
+            self.driftPpm = cResult.drift_ppm
             self.method = extractHarmoniqSyncMethodString(from: cResult.method)
             self.isValid = cResult.error == HARMONIQ_SYNC_SUCCESS
         }
@@ -90,7 +92,7 @@ public class SyncEngine {
     
     public struct HarmoniqSyncConfiguration {
         public let confidenceThreshold: Double
-        public let maxOffsetSeconds: Double?
+        public let maxOffsetSeconds: Double?  // Largest offset searched (nil = a quarter of the shorter clip)
         public let windowSize: Int
         public let hopSize: Int?
         public let noiseGateDb: Double
@@ -126,7 +128,13 @@ public class SyncEngine {
                 window_size: Int32(windowSize),
                 hop_size: Int32(actualHopSize),
                 noise_gate_db: noiseGateDb,
-                enable_drift_correction: enableDriftCorrection ? 1 : 0
+                enable_drift_correction: enableDriftCorrection ? 1 : 0,
+                worker_count: 0,
+                coarse_hop_size: 0,
+                analysis_sample_rate: 0,
+                hybrid_cascade: 0,
+                correlation_precision: 0,
+                correlation_memory_mb: 0
             )
         }
     }
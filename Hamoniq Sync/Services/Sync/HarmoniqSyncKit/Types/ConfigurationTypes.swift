@@ -11,7 +11,7 @@ import Foundation
 
 public struct HarmoniqSyncConfiguration: Sendable {
     public let confidenceThreshold: Double
-    public let maxOffsetSeconds: Double?
+    public let maxOffsetSeconds: Double?  // Largest offset searched (nil = a quarter of the shorter clip)
     public let windowSize: Int
     public let hopSize: Int?
     public let noiseGateDb: Double
@@ -44,7 +44,10 @@ public struct HarmoniqSyncConfiguration: Sendable {
             window_size: Int32(windowSize),
             hop_size: Int32(actualHopSize),
             noise_gate_db: noiseGateDb,
-            enable_drift_correction: enableDriftCorrection ? 1 : 0
+            enable_drift_correction: enableDriftCorrection ? 1 : 0,
+            worker_count: 0,
+            coarse_hop_size: 0,
+            analysis_sample_rate: 0
         )
     }
     
@@ -33,6 +33,10 @@ public enum SyncEngineError: LocalizedError, CustomDebugStringConvertible, Senda
             self = .outOfMemory(requestedBytes: 0) // Unknown size
         case HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT:
             self = .unsupportedFormat(formatDescription: context.isEmpty ? "Unknown format" : context)
+        case HARMONIQ_SYNC_ERROR_CANCELLED:
+            self = .cancelled
+        case HARMONIQ_SYNC_ERROR_TIMEOUT:
+            self = .processingFailed(context.isEmpty ? "Operation timed out" : context)
         default:
             self = .processingFailed("Unknown error code: \(cError)")
         }
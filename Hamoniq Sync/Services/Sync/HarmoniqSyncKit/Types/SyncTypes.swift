@@ -93,6 +93,7 @@ public struct AlignmentResult: Sendable {
     public let secondaryPeakRatio: Double
     public let snrEstimate: Double
     public let noiseFloorDb: Double
+    public let driftPpm: Double  // Target clock drift (0 = none detected)
     public let method: String
     public let isValid: Bool
     
@@ -105,7 +106,8 @@ public struct AlignmentResult: Sendable {
         snrEstimate: Double,
         noiseFloorDb: Double,
         method: String,
-        isValid: Bool
+        isValid: Bool,
+        driftPpm: Double = 0.0
     ) {
         self.offsetSamples = offsetSamples
         self.offsetSeconds = offsetSeconds
@@ -114,18 +116,20 @@ public struct AlignmentResult: Sendable {
         self.secondaryPeakRatio = secondaryPeakRatio
         self.snrEstimate = snrEstimate
         self.noiseFloorDb = noiseFloorDb
+        self.driftPpm = driftPpm
         self.method = method
         self.isValid = isValid
     }
 
     internal init(from cResult: harmoniq_sync_result_t, sampleRate: Double) {
         self.offsetSamples = cResult.offset_samples
-        self.offsetSeconds = Double(cResult.offset_samples) / sampleRate
+        self.offsetSeconds = cResult.offset_samples_fractional / sampleRate
         self.confidence = cResult.confidence
         self.peakCorrelation = cResult.peak_correlation
         self.secondaryPeakRatio = cResult.secondary_peak_ratio
         self.snrEstimate = cResult.snr_estimate
         self.noiseFloorDb = cResult.noise_floor_db
+        self.driftPpm = cResult.drift_ppm
         self.method = String(cString: withUnsafeBytes(of: cResult.method) { bytes in
             bytes.bindMemory(to: CChar.self).baseAddress!
         })
@@ -286,7 +290,7 @@ extension AlignmentResult {
             components.append("SNR: \(String(format: "%.1f dB", snrEstimate))")
         }
         
-        if secondaryPeakRatio < 0.5 {
+        if secondaryPeakRatio > 2.0 {
             components.append("Clear primary peak")
         } else {
             components.append("Multiple potential peaks")
@@ -334,7 +338,8 @@ extension SyncEngine.AlignmentResult {
             snrEstimate: snrEstimate,
             noiseFloorDb: noiseFloorDb,
             method: method,
-            isValid: isValid
+            isValid: isValid,
+            driftPpm: driftPpm
         )
     }
 }
\ No newline at end of file
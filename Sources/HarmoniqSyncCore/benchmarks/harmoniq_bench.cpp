@@ -0,0 +1,809 @@
+//
+//  harmoniq_bench.cpp
+//  HarmoniqSyncCore
+//
+//  Micro and macro benchmarks with JSON output and baseline comparison
+//
+//  Usage: harmoniq_bench [--filter TEXT] [--list] [--quick] [--max-duration SECONDS]
+//                        [--output FILE] [--baseline FILE] [--tolerance FRACTION]
+//         harmoniq_bench --calibrate FILE [--machine-class NAME] [--quick] [--max-duration SECONDS]
+//
+//  Results are written as JSON (stdout unless --output is given), one
+//  benchmark object per line. With --baseline the run is compared against a
+//  file written earlier by --output; the exit status is 2 if any benchmark
+//  got slower than the tolerance allows.
+//
+//  --calibrate runs every method over a sweep of clip lengths and analysis
+//  settings and writes the fitted CostModel profile for this machine class,
+//  to be loaded with harmoniq_sync_load_cost_profile.
+//
+//  The precision/ benchmarks also report offset_error_samples: the largest
+//  offset difference of single precision correlation or 16-bit cached features
+//  from double precision on exact features.
+//
+
+#include "alignment_engine.hpp"
+#include "audio_processor.hpp"
+#include "correlation_engine.hpp"
+#include "cost_model.hpp"
+#include "dsp_backend.hpp"
+#include "feature_cache.hpp"
+#include "streaming_feature_extractor.hpp"
+#include "sync_engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifndef HARMONIQ_BENCH_VERSION
+#define HARMONIQ_BENCH_VERSION "unknown"
+#endif
+
+using namespace HarmoniqSync;
+
+namespace {
+
+// MARK: - Constants
+
+// Synthetic clips are generated at a typical analysis rate
+const double SAMPLE_RATE = 22050.0;
+
+// Longest clip handed to AudioProcessor (its load limit is 10M samples)
+const double MAX_PCM_DURATION = 300.0;
+
+// Delay of every target relative to its reference
+const double TARGET_OFFSET_SECONDS = 1.5;
+
+// Length of the looped source material and of one gain segment
+const double BASE_DURATION = 37.3;
+const double GAIN_SEGMENT_SECONDS = 0.29;
+
+// Block size used to feed streaming extractors
+const size_t STREAM_BLOCK_SIZE = 4096;
+
+// Number of targets in the batch benchmarks
+const size_t BATCH_TARGETS = 4;
+
+// Runs per calibration point (timing noise is part of what is fitted)
+const int CALIBRATION_REPEATS = 2;
+
+// Lag window of the direct kernel benchmarks, in frames
+const size_t NARROW_LAG_WINDOW = 128;
+
+const char* const METHOD_NAMES[] = {"spectralFlux", "chroma", "energy", "mfcc", "hybrid"};
+
+// MARK: - Options
+
+struct Options {
+    std::string filter;
+    std::string outputPath;
+    std::string baselinePath;
+    std::string calibratePath;
+    std::string machineClass;
+    double maxDuration = 600.0;
+    double minTime = 0.5;         // Seconds of measured time per repetition
+    int repetitions = 3;
+    double tolerance = 0.10;      // Allowed ns/op increase over the baseline
+    bool list = false;
+};
+
+// MARK: - Results
+
+struct Result {
+    std::string name;
+    size_t iterations = 0;
+    double nsPerOp = 0.0;
+    double audioSeconds = 0.0;    // Audio analysed per operation (0 = not applicable)
+    size_t peakRssBytes = 0;
+    double offsetErrorSamples = -1.0;  // Offset difference from the double precision path (< 0 = not measured)
+
+    /// Seconds of audio processed per second of wall time
+    double realtimeFactor() const {
+        return audioSeconds > 0.0 && nsPerOp > 0.0 ? audioSeconds / (nsPerOp * 1e-9) : 0.0;
+    }
+};
+
+// MARK: - Memory
+
+/// Reset the peak resident set size where the OS allows it (Linux only)
+void resetPeakRss() {
+#if defined(__linux__)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs) clearRefs << "5";
+#endif
+}
+
+/// Peak resident set size since the last reset (process lifetime on other platforms)
+size_t peakRssBytes() {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return static_cast<size_t>(std::strtoull(line.c_str() + 6, nullptr, 10)) * 1024;
+        }
+    }
+#endif
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss);           // Bytes on Darwin
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;    // Kilobytes elsewhere
+#endif
+}
+
+// MARK: - Synthetic Audio
+
+uint64_t mix(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/// Deterministic clip of any length that never has to be held in memory.
+/// A short base buffer of decaying pitched notes over noise is looped under a
+/// per-segment pseudo-random gain, so the envelope never repeats. Sample i of a
+/// target delayed by d is sample i - d of the reference.
+class ClipSource {
+public:
+    ClipSource() : base_(static_cast<size_t>(BASE_DURATION * SAMPLE_RATE)) {
+        const size_t noteLength = static_cast<size_t>(0.25 * SAMPLE_RATE);
+        std::mt19937 gen(7);
+        std::normal_distribution<float> noise(0.0f, 0.05f);
+
+        for (size_t i = 0; i < base_.size(); ++i) {
+            uint64_t note = mix(i / noteLength);
+            double frequency = 110.0 * std::pow(2.0, static_cast<double>(note % 36) / 12.0);
+            double decay = std::exp(-static_cast<double>(i % noteLength) / (0.08 * SAMPLE_RATE));
+            double tone = std::sin(2.0 * M_PI * frequency * static_cast<double>(i) / SAMPLE_RATE);
+            base_[i] = static_cast<float>(0.4 * decay * tone) + noise(gen);
+        }
+    }
+
+    /// Write samples [start, start + length) of a clip delayed by `delay` samples
+    void fill(int64_t start, size_t length, int64_t delay, float* output) const {
+        const int64_t segment = static_cast<int64_t>(GAIN_SEGMENT_SECONDS * SAMPLE_RATE);
+        for (size_t i = 0; i < length; ++i) {
+            int64_t index = start + static_cast<int64_t>(i) - delay;
+            if (index < 0) {
+                output[i] = 0.0f;
+                continue;
+            }
+            float gain = 0.2f + 0.8f * static_cast<float>(mix(static_cast<uint64_t>(index / segment)) & 0xffff) / 65535.0f;
+            output[i] = gain * base_[static_cast<size_t>(index) % base_.size()];
+        }
+    }
+
+    std::vector<float> generate(double duration, int64_t delay = 0) const {
+        std::vector<float> samples(static_cast<size_t>(duration * SAMPLE_RATE));
+        fill(0, samples.size(), delay, samples.data());
+        return samples;
+    }
+
+private:
+    std::vector<float> base_;
+};
+
+// MARK: - Runner
+
+class Runner {
+public:
+    explicit Runner(const Options& options) : options_(options) {}
+
+    /// Time `op` unless the filter excludes `name`
+    /// @param audioSeconds Audio analysed by one call (for the realtime factor)
+    void run(const std::string& name, double audioSeconds, const std::function<double()>& op) {
+        if (!matches(name)) return;
+        if (options_.list) {
+            std::cout << name << "\n";
+            return;
+        }
+
+        Result result;
+        result.name = name;
+        result.audioSeconds = audioSeconds;
+
+        resetPeakRss();
+
+        // The first call doubles as warm-up and sizes the repetitions; calls
+        // longer than a repetition are reported as a single sample
+        double first = timeCalls(op, 1);
+        std::vector<double> samples;
+        size_t iterations = 1;
+        if (first >= options_.minTime) {
+            samples.push_back(first);
+        } else {
+            iterations = static_cast<size_t>(std::ceil(options_.minTime / std::max(first, 1e-9)));
+            iterations = std::max<size_t>(1, std::min<size_t>(iterations, 100000000));
+            for (int r = 0; r < options_.repetitions; ++r) {
+                samples.push_back(timeCalls(op, iterations) / iterations);
+            }
+        }
+
+        std::sort(samples.begin(), samples.end());
+        result.iterations = iterations * samples.size();
+        result.nsPerOp = samples[samples.size() / 2] * 1e9;
+        result.peakRssBytes = peakRssBytes();
+
+        std::cerr << "  " << name << ": " << formatNanoseconds(result.nsPerOp) << "/op";
+        if (result.realtimeFactor() > 0.0) std::cerr << ", " << result.realtimeFactor() << "x realtime";
+        std::cerr << ", peak RSS " << result.peakRssBytes / (1024 * 1024) << " MiB\n";
+
+        results_.push_back(result);
+    }
+
+    /// Record the offset error of the result last measured under `name`
+    void annotate(const std::string& name, double offsetErrorSamples) {
+        for (auto it = results_.rbegin(); it != results_.rend(); ++it) {
+            if (it->name != name) continue;
+            it->offsetErrorSamples = offsetErrorSamples;
+            std::cerr << "  " << name << ": offset error " << offsetErrorSamples << " samples\n";
+            return;
+        }
+    }
+
+    /// True if `name` passes the filter
+    bool matches(const std::string& name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+
+    /// True if `name` will actually be timed (set-up can be skipped otherwise)
+    bool willMeasure(const std::string& name) const { return !options_.list && matches(name); }
+
+    const std::vector<Result>& results() const { return results_; }
+
+private:
+    const Options& options_;
+    std::vector<Result> results_;
+    volatile double sink_ = 0.0;   // Keeps results observable so calls are not optimized away
+
+    double timeCalls(const std::function<double()>& op, size_t iterations) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            sink_ += op();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    static std::string formatNanoseconds(double ns) {
+        char buffer[32];
+        if (ns >= 1e9) std::snprintf(buffer, sizeof(buffer), "%.3f s", ns * 1e-9);
+        else if (ns >= 1e6) std::snprintf(buffer, sizeof(buffer), "%.3f ms", ns * 1e-6);
+        else if (ns >= 1e3) std::snprintf(buffer, sizeof(buffer), "%.3f us", ns * 1e-3);
+        else std::snprintf(buffer, sizeof(buffer), "%.1f ns", ns);
+        return buffer;
+    }
+};
+
+std::string durationLabel(double seconds) {
+    std::ostringstream label;
+    if (seconds >= 3600.0 && std::fmod(seconds, 3600.0) == 0.0) label << seconds / 3600.0 << "h";
+    else if (seconds >= 60.0 && std::fmod(seconds, 60.0) == 0.0) label << seconds / 60.0 << "min";
+    else label << seconds << "s";
+    return label.str();
+}
+
+// MARK: - Micro Benchmarks
+
+void benchmarkFFT(Runner& runner) {
+    AudioProcessor processor;
+    std::vector<float> magnitude;
+    for (size_t size : {512u, 1024u, 2048u, 4096u}) {
+        std::vector<float> frame(size);
+        std::mt19937 gen(static_cast<unsigned>(size));
+        std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+        for (float& sample : frame) sample = value(gen);
+
+        runner.run("fft/computeFFT/" + std::to_string(size), 0.0, [&]() {
+            processor.computeFFT(frame.data(), frame.size(), magnitude);
+            return static_cast<double>(magnitude[1]);
+        });
+    }
+}
+
+void benchmarkExtraction(Runner& runner, const ClipSource& source) {
+    const double duration = 30.0;
+    auto samples = source.generate(duration);
+    AudioProcessor processor;
+    processor.loadAudioView(samples.data(), samples.size(), SAMPLE_RATE);
+
+    // Every call starts cold: spectrograms are cached per processor
+    auto cold = [&](const std::function<size_t()>& extract) {
+        return [&processor, extract]() {
+            processor.clearSpectrogramCache();
+            return static_cast<double>(extract());
+        };
+    };
+
+    runner.run("extract/spectrogram/30s", duration, cold([&]() { return processor.getSpectrogram(1024, 256).numFrames; }));
+    runner.run("extract/spectralFlux/30s", duration, cold([&]() { return processor.extractSpectralFlux(1024, 256).size(); }));
+    runner.run("extract/chroma/30s", duration, cold([&]() { return processor.extractChromaFeatures(4096, 1024).size(); }));
+    runner.run("extract/energy/30s", duration, cold([&]() { return processor.extractEnergyProfile(512, 128).size(); }));
+    runner.run("extract/mfcc/30s", duration, cold([&]() { return processor.extractMFCC(13, 1024, 256).size(); }));
+}
+
+void benchmarkCorrelation(Runner& runner) {
+    CorrelationEngine engine;
+    CorrelationEngine single;
+    single.setPrecision(CorrelationEngine::Precision::Single);
+    AlignmentEngine alignment;
+    std::mt19937 gen(11);
+    std::normal_distribution<float> value(0.0f, 1.0f);
+
+    for (size_t frames : {1000u, 10000u, 100000u, 1000000u}) {
+        std::vector<float> a(frames), b(frames);
+        for (float& x : a) x = value(gen);
+        for (size_t i = 0; i < frames; ++i) b[i] = a[(i + frames / 10) % frames];
+
+        runner.run("correlate/crossCorrelate/" + std::to_string(frames), 0.0, [&]() {
+            return engine.crossCorrelate(a, b)[frames];
+        });
+        runner.run("correlate/crossCorrelateSingle/" + std::to_string(frames), 0.0, [&]() {
+            return single.crossCorrelate(a, b)[frames];
+        });
+
+        // Direct kernel over a narrow lag window
+        runner.run("correlate/crossCorrelateNarrow/" + std::to_string(frames), 0.0, [&]() {
+            return engine.crossCorrelate(a, b, NARROW_LAG_WINDOW, CorrelationEngine::Mode::Direct)[NARROW_LAG_WINDOW];
+        });
+        runner.run("correlate/crossCorrelateNarrowSingle/" + std::to_string(frames), 0.0, [&]() {
+            return single.crossCorrelate(a, b, NARROW_LAG_WINDOW, CorrelationEngine::Mode::Direct)[NARROW_LAG_WINDOW];
+        });
+
+        // 2 * frames - 1 lags, as alignment sees for two clips of this length
+        const std::string peakName = "peak/findBestAlignment/" + std::to_string(frames);
+        std::vector<double> correlation;
+        if (runner.willMeasure(peakName)) correlation = engine.crossCorrelate(a, b);
+        runner.run(peakName, 0.0, [&]() {
+            return alignment.findBestAlignment(correlation).confidence;
+        });
+    }
+}
+
+// MARK: - Macro Benchmarks
+
+void benchmarkAlignment(Runner& runner, const ClipSource& source, const Options& options) {
+    const int64_t delay = static_cast<int64_t>(TARGET_OFFSET_SECONDS * SAMPLE_RATE);
+
+    for (double duration : {10.0, 60.0, 300.0}) {
+        if (duration > options.maxDuration || duration > MAX_PCM_DURATION) continue;
+        const std::string label = durationLabel(duration);
+        auto reference = source.generate(duration);
+        auto target = source.generate(duration, delay);
+
+        // Loading views inside the call keeps feature extraction in the measurement
+        AlignmentEngine engine;
+        runner.run("align/alignHybrid/" + label, 2.0 * duration, [&]() {
+            AudioProcessor referenceAudio, targetAudio;
+            referenceAudio.loadAudioView(reference.data(), reference.size(), SAMPLE_RATE);
+            targetAudio.loadAudioView(target.data(), target.size(), SAMPLE_RATE);
+            return engine.alignHybrid(referenceAudio, targetAudio).offset_samples;
+        });
+
+        std::vector<std::vector<float>> targets;
+        for (size_t t = 0; t < BATCH_TARGETS; ++t) {
+            targets.push_back(source.generate(duration, delay * static_cast<int64_t>(t + 1)));
+        }
+        std::vector<const float*> targetPointers;
+        std::vector<size_t> targetLengths;
+        for (const auto& clip : targets) {
+            targetPointers.push_back(clip.data());
+            targetLengths.push_back(clip.size());
+        }
+
+        SyncEngine syncEngine;
+        runner.run("align/processBatch" + std::to_string(BATCH_TARGETS) + "/" + label,
+                   (1.0 + BATCH_TARGETS) * duration, [&]() {
+            auto results = syncEngine.processBatch(reference.data(), reference.size(),
+                                                   targetPointers.data(), targetLengths.data(), targetPointers.size(),
+                                                   SAMPLE_RATE, HARMONIQ_SYNC_HYBRID);
+            return static_cast<double>(results.back().offset_samples);
+        });
+    }
+
+    // Clips longer than AudioProcessor's load limit go through the streaming extractor
+    for (double duration : {10.0, 60.0, 600.0, 3600.0, 10800.0}) {
+        if (duration > options.maxDuration) continue;
+        const size_t length = static_cast<size_t>(duration * SAMPLE_RATE);
+
+        AlignmentEngine engine;
+        runner.run("align/alignHybridStreaming/" + durationLabel(duration), 2.0 * duration, [&]() {
+            StreamingFeatureExtractor referenceStream(SAMPLE_RATE, HARMONIQ_SYNC_HYBRID, engine.getConfig());
+            StreamingFeatureExtractor targetStream(SAMPLE_RATE, HARMONIQ_SYNC_HYBRID, engine.getConfig());
+            std::vector<float> block(STREAM_BLOCK_SIZE);
+
+            for (size_t start = 0; start < length; start += STREAM_BLOCK_SIZE) {
+                size_t count = std::min(STREAM_BLOCK_SIZE, length - start);
+                source.fill(static_cast<int64_t>(start), count, 0, block.data());
+                referenceStream.processBlock(block.data(), count);
+                source.fill(static_cast<int64_t>(start), count, delay, block.data());
+                targetStream.processBlock(block.data(), count);
+            }
+
+            auto referenceFeatures = engine.prepareReferenceFeatures(referenceStream);
+            auto targetFeatures = engine.prepareFeatures(targetStream);
+            return engine.alignHybrid(referenceFeatures, targetFeatures).offset_samples;
+        });
+    }
+}
+
+// MARK: - Precision
+
+/// Time single precision alignment and 16-bit feature loads, with their offset error.
+/// Both sides are plain prepared features (no sample-domain refinement), so the
+/// errors are those of the feature correlation itself.
+void benchmarkPrecision(Runner& runner, const ClipSource& source, const Options& options) {
+    const int64_t delay = static_cast<int64_t>(TARGET_OFFSET_SECONDS * SAMPLE_RATE);
+    const std::string directory = (std::filesystem::temp_directory_path() / "harmoniq_bench_features").string();
+
+    for (double duration : {60.0, 300.0}) {
+        if (duration > options.maxDuration || duration > MAX_PCM_DURATION) continue;
+        const std::string label = durationLabel(duration);
+        auto referenceSamples = source.generate(duration);
+        auto targetSamples = source.generate(duration, delay);
+        AudioProcessor referenceAudio, targetAudio;
+        referenceAudio.loadAudioView(referenceSamples.data(), referenceSamples.size(), SAMPLE_RATE);
+        targetAudio.loadAudioView(targetSamples.data(), targetSamples.size(), SAMPLE_RATE);
+
+        AlignmentEngine exact;
+        AlignmentEngine::Config config = exact.getConfig();
+        config.confidenceThreshold = 0.0;
+        exact.setConfig(config);
+        config.correlationPrecision = CorrelationEngine::Precision::Single;
+        AlignmentEngine single;
+        single.setConfig(config);
+
+        std::vector<AlignmentEngine::ClipFeatures> reference, target;
+        std::vector<double> expected;
+        for (int m = HARMONIQ_SYNC_SPECTRAL_FLUX; m <= HARMONIQ_SYNC_HYBRID; ++m) {
+            auto method = static_cast<harmoniq_sync_method_t>(m);
+            reference.push_back(exact.prepareFeatures(referenceAudio, method));
+            target.push_back(exact.prepareFeatures(targetAudio, method));
+            expected.push_back(exact.alignFeatures(reference.back(), target.back(), method).offset_samples_fractional);
+        }
+
+        for (int m = HARMONIQ_SYNC_SPECTRAL_FLUX; m <= HARMONIQ_SYNC_HYBRID; ++m) {
+            auto method = static_cast<harmoniq_sync_method_t>(m);
+            for (AlignmentEngine* engine : {&exact, &single}) {
+                const std::string name = std::string("precision/") + METHOD_NAMES[m] +
+                                         (engine == &exact ? "/double/" : "/single/") + label;
+                runner.run(name, 2.0 * duration, [&]() {
+                    return engine->alignFeatures(reference[m], target[m], method).offset_samples_fractional;
+                });
+                if (engine == &single && runner.willMeasure(name)) {
+                    double offset = engine->alignFeatures(reference[m], target[m], method).offset_samples_fractional;
+                    runner.annotate(name, std::abs(offset - expected[m]));
+                }
+            }
+        }
+
+        // Loads of both hybrid clips from each storage; the error is the worst over all methods
+        auto keyFor = [&](int method, int clip) {
+            return FeatureCache::Key{static_cast<uint64_t>(2 * method + clip), static_cast<uint64_t>(duration)};
+        };
+        const std::pair<FeatureCache::Storage, const char*> storages[] = {
+            {FeatureCache::Storage::Float32, "float32"},
+            {FeatureCache::Storage::BFloat16, "bfloat16"},
+            {FeatureCache::Storage::Int16, "int16"},
+        };
+        for (const auto& storage : storages) {
+            const std::string name = std::string("precision/featureLoad/") + storage.second + "/" + label;
+            if (!runner.willMeasure(name)) continue;
+
+            FeatureCache cache(directory, storage.first);
+            for (int m = HARMONIQ_SYNC_SPECTRAL_FLUX; m <= HARMONIQ_SYNC_HYBRID; ++m) {
+                cache.store(keyFor(m, 0), reference[m]);
+                cache.store(keyFor(m, 1), target[m]);
+            }
+
+            AlignmentEngine::ClipFeatures loadedReference, loadedTarget;
+            runner.run(name, 2.0 * duration, [&]() {
+                cache.load(keyFor(HARMONIQ_SYNC_HYBRID, 0), loadedReference);
+                cache.load(keyFor(HARMONIQ_SYNC_HYBRID, 1), loadedTarget);
+                return static_cast<double>(loadedReference.spectralFlux.size() + loadedTarget.spectralFlux.size());
+            });
+
+            double worst = 0.0;
+            for (int m = HARMONIQ_SYNC_SPECTRAL_FLUX; m <= HARMONIQ_SYNC_HYBRID; ++m) {
+                if (!cache.load(keyFor(m, 0), loadedReference) || !cache.load(keyFor(m, 1), loadedTarget)) continue;
+                auto method = static_cast<harmoniq_sync_method_t>(m);
+                double offset = exact.alignFeatures(loadedReference, loadedTarget, method).offset_samples_fractional;
+                worst = std::max(worst, std::abs(offset - expected[m]));
+            }
+            runner.annotate(name, worst);
+        }
+    }
+    std::error_code ignored;
+    std::filesystem::remove_all(directory, ignored);
+}
+
+// MARK: - Calibration
+
+/// Time SyncEngine::process over lengths, methods and settings and fit a cost profile
+bool calibrate(const ClipSource& source, const Options& options) {
+    const int64_t delay = static_cast<int64_t>(TARGET_OFFSET_SECONDS * SAMPLE_RATE);
+    const bool quick = options.repetitions == 1;
+
+    // Settings that change the work differently: window and hop, decimation, drift and a bounded search
+    std::vector<harmoniq_sync_config_t> configs;
+    harmoniq_sync_config_t base = harmoniq_sync_default_config();
+    base.confidence_threshold = 0.0;   // Every run is a sample, however ambiguous the clip
+    base.enable_drift_correction = 0;
+    configs.push_back(base);
+
+    harmoniq_sync_config_t wide = base;
+    wide.window_size = 2048;
+    wide.hop_size = 512;
+    configs.push_back(wide);
+
+    harmoniq_sync_config_t fine = base;
+    fine.window_size = 512;
+    fine.hop_size = 128;
+    fine.enable_drift_correction = 1;
+    configs.push_back(fine);
+
+    harmoniq_sync_config_t decimated = base;
+    decimated.analysis_sample_rate = SAMPLE_RATE / 2.0;
+    decimated.max_offset_samples = static_cast<int64_t>(5.0 * SAMPLE_RATE);
+    configs.push_back(decimated);
+
+    std::vector<CostModel::Sample> samples;
+    SyncEngine engine;
+    for (double duration : {5.0, 10.0, 20.0, 40.0, 80.0, 160.0}) {
+        if (duration > options.maxDuration || (quick && duration > 20.0)) continue;
+        auto reference = source.generate(duration);
+        auto target = source.generate(duration, delay);
+
+        for (int m = HARMONIQ_SYNC_SPECTRAL_FLUX; m <= HARMONIQ_SYNC_HYBRID; ++m) {
+            auto method = static_cast<harmoniq_sync_method_t>(m);
+            for (const auto& config : configs) {
+                engine.setConfig(config);
+                for (int repeat = 0; repeat < CALIBRATION_REPEATS; ++repeat) {
+                    engine.process(reference.data(), reference.size(), target.data(), target.size(),
+                                   SAMPLE_RATE, method);
+                    auto stats = engine.getLastProcessingStats();
+                    if (!stats.successful) continue;
+
+                    CostModel::Sample sample;
+                    sample.job = CostModel::Job::fromConfig(config, method, reference.size(), target.size(), SAMPLE_RATE);
+                    sample.stages = stats.stages;
+                    sample.wallSeconds = stats.processingTimeSeconds;
+                    samples.push_back(sample);
+                }
+            }
+            std::cerr << "  calibrate/" << durationLabel(duration) << "/method " << m << ": "
+                      << samples.size() << " runs\n";
+        }
+    }
+
+    std::string machineClass = options.machineClass;
+    if (machineClass.empty()) {
+        machineClass = std::string(DSP::backendName()) + "-" + std::to_string(std::thread::hardware_concurrency()) + "core";
+    }
+
+    CostModel model;
+    model.calibrate(samples, machineClass);
+    if (!model.save(options.calibratePath)) {
+        std::cerr << "Cannot write " << options.calibratePath << "\n";
+        return false;
+    }
+
+    std::cerr << "Profile " << machineClass << " written to " << options.calibratePath << "\n";
+    for (int m = HARMONIQ_SYNC_SPECTRAL_FLUX; m <= HARMONIQ_SYNC_HYBRID; ++m) {
+        const auto& row = model.getCoefficients(static_cast<harmoniq_sync_method_t>(m));
+        std::cerr << "  method " << m << ": " << row.samples << " runs, wall factor " << row.wallFactor
+                  << ", log error " << row.logError << ", memory factor " << row.memoryFactor << "\n";
+    }
+    return true;
+}
+
+// MARK: - JSON
+
+std::string escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+/// Read name -> ns/op from a file written by writeJson (one benchmark per line)
+bool readBaseline(const std::string& path, std::map<std::string, double>& baseline) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    const std::string nameKey = "\"name\": \"";
+    const std::string timeKey = "\"ns_per_op\": ";
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t nameStart = line.find(nameKey);
+        size_t timeStart = line.find(timeKey);
+        if (nameStart == std::string::npos || timeStart == std::string::npos) continue;
+
+        nameStart += nameKey.size();
+        size_t nameEnd = line.find('"', nameStart);
+        if (nameEnd == std::string::npos) continue;
+
+        baseline[line.substr(nameStart, nameEnd - nameStart)] =
+            std::strtod(line.c_str() + timeStart + timeKey.size(), nullptr);
+    }
+    return true;
+}
+
+void writeJson(std::ostream& out, const std::vector<Result>& results,
+               const std::map<std::string, double>* baseline, double tolerance) {
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    out.precision(10);
+    out << "{\n";
+    out << "  \"context\": {\"version\": \"" << HARMONIQ_BENCH_VERSION << "\", \"dsp_backend\": \""
+        << DSP::backendName() << "\", \"sample_rate\": " << SAMPLE_RATE << ", \"date\": \"" << date << "\"},\n";
+    out << "  \"benchmarks\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        out << "    {\"name\": \"" << escape(result.name) << "\", \"iterations\": " << result.iterations
+            << ", \"ns_per_op\": " << result.nsPerOp
+            << ", \"realtime_factor\": " << result.realtimeFactor()
+            << ", \"peak_rss_bytes\": " << result.peakRssBytes;
+        if (result.offsetErrorSamples >= 0.0) {
+            out << ", \"offset_error_samples\": " << result.offsetErrorSamples;
+        }
+
+        if (baseline) {
+            auto it = baseline->find(result.name);
+            if (it != baseline->end() && it->second > 0.0) {
+                double change = result.nsPerOp / it->second - 1.0;
+                out << ", \"baseline_ns_per_op\": " << it->second << ", \"change\": " << change
+                    << ", \"regression\": " << (change > tolerance ? "true" : "false");
+            }
+        }
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+/// Print the comparison table; returns the number of regressions
+size_t compare(const std::vector<Result>& results, const std::map<std::string, double>& baseline, double tolerance) {
+    size_t regressions = 0;
+    std::cerr << "\nComparison against baseline (tolerance " << tolerance * 100.0 << "%):\n";
+    for (const Result& result : results) {
+        auto it = baseline.find(result.name);
+        if (it == baseline.end() || it->second <= 0.0) {
+            std::cerr << "  " << result.name << ": new\n";
+            continue;
+        }
+
+        double change = result.nsPerOp / it->second - 1.0;
+        bool regressed = change > tolerance;
+        regressions += regressed;
+
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%+.1f%%", change * 100.0);
+        std::cerr << "  " << result.name << ": " << buffer << (regressed ? "  REGRESSION" : "") << "\n";
+    }
+    return regressions;
+}
+
+// MARK: - Command Line
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&](const char* flag) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << flag << "\n";
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        const char* text = nullptr;
+        if (arg == "--filter") {
+            if (!(text = value("--filter"))) return false;
+            options.filter = text;
+        } else if (arg == "--output") {
+            if (!(text = value("--output"))) return false;
+            options.outputPath = text;
+        } else if (arg == "--baseline") {
+            if (!(text = value("--baseline"))) return false;
+            options.baselinePath = text;
+        } else if (arg == "--calibrate") {
+            if (!(text = value("--calibrate"))) return false;
+            options.calibratePath = text;
+        } else if (arg == "--machine-class") {
+            if (!(text = value("--machine-class"))) return false;
+            options.machineClass = text;
+        } else if (arg == "--max-duration") {
+            if (!(text = value("--max-duration"))) return false;
+            options.maxDuration = std::atof(text);
+        } else if (arg == "--tolerance") {
+            if (!(text = value("--tolerance"))) return false;
+            options.tolerance = std::atof(text);
+        } else if (arg == "--quick") {
+            options.minTime = 0.05;
+            options.repetitions = 1;
+        } else if (arg == "--list") {
+            options.list = true;
+        } else {
+            std::cerr << "Unknown option " << arg << "\n"
+                      << "Usage: harmoniq_bench [--filter TEXT] [--list] [--quick] [--max-duration SECONDS]\n"
+                      << "                      [--output FILE] [--baseline FILE] [--tolerance FRACTION]\n"
+                      << "       harmoniq_bench --calibrate FILE [--machine-class NAME] [--quick] [--max-duration SECONDS]\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    std::map<std::string, double> baseline;
+    if (!options.baselinePath.empty() && !readBaseline(options.baselinePath, baseline)) {
+        std::cerr << "Cannot read baseline " << options.baselinePath << "\n";
+        return 1;
+    }
+
+    if (!options.calibratePath.empty()) {
+        std::cerr << "HarmoniqSyncCore cost calibration (" << DSP::backendName() << " DSP backend)\n";
+        ClipSource source;
+        return calibrate(source, options) ? 0 : 1;
+    }
+
+    if (!options.list) {
+        std::cerr << "HarmoniqSyncCore benchmarks (" << DSP::backendName() << " DSP backend)\n";
+    }
+
+    Runner runner(options);
+    ClipSource source;
+    benchmarkFFT(runner);
+    benchmarkExtraction(runner, source);
+    benchmarkCorrelation(runner);
+    benchmarkAlignment(runner, source, options);
+    benchmarkPrecision(runner, source, options);
+
+    if (options.list) return 0;
+
+    const std::map<std::string, double>* comparison = options.baselinePath.empty() ? nullptr : &baseline;
+    if (options.outputPath.empty()) {
+        writeJson(std::cout, runner.results(), comparison, options.tolerance);
+    } else {
+        std::ofstream file(options.outputPath);
+        if (!file) {
+            std::cerr << "Cannot write " << options.outputPath << "\n";
+            return 1;
+        }
+        writeJson(file, runner.results(), comparison, options.tolerance);
+    }
+
+    size_t regressions = comparison ? compare(runner.results(), baseline, options.tolerance) : 0;
+    return regressions > 0 ? 2 : 0;
+}
@@ -9,12 +9,21 @@
 #define ALIGNMENT_ENGINE_HPP
 
 #include "audio_processor.hpp"
+#include "correlation_engine.hpp"
+#include "correlation_analyzer.hpp"
+#include "landmark_index.hpp"
+#include "timeline_solver.hpp"
 #include "harmoniq_sync.h"
 #include <vector>
+#include <functional>
 #include <string>
+#include <memory>
 
 namespace HarmoniqSync {
 
+class FeatureCache;
+class StreamingFeatureExtractor;
+
 class AlignmentEngine {
 public:
     // MARK: - Lifecycle
@@ -26,11 +35,24 @@ public:
     
     struct Config {
         double confidenceThreshold = 0.7;
-        int64_t maxOffsetSamples = 0;  // 0 = auto-calculate
+        int64_t maxOffsetSamples = 0;  // Bounds the searched lag window (0 = 25% of the shorter clip; results report the bound)
         int windowSize = 1024;
         int hopSize = 0;  // 0 = auto-calculate (windowSize/4)
         double noiseGateDb = -40.0;
         bool enableDriftCorrection = true;
+        CorrelationEngine::Mode correlationMode = CorrelationEngine::Mode::Auto;  // Direct/FFT kernel selection
+        CorrelationEngine::Precision correlationPrecision = CorrelationEngine::Precision::Double;  // Feature correlation arithmetic
+        // Working memory a spectral flux or energy correlation may use before its lag scores are
+        // streamed from the partitioned kernel into peak picking instead of stored (0 = no limit)
+        size_t correlationMemoryBytes = 0;
+        int numWorkers = 0;  // Batch worker threads (0 = all pool threads, 1 = serial)
+        bool concurrentHybrid = true;  // Hybrid runs its four methods as parallel tasks (bounded by numWorkers)
+        
+        // Rate features are extracted at (0 = source rate). Clips are decimated by
+        // floor(sourceRate / analysisSampleRate), so the actual rate is at least this.
+        // windowSize and hopSize apply at the analysis rate; offsets, maxOffsetSamples
+        // and coarseToFine.hopSize stay in source samples.
+        double analysisSampleRate = 0.0;
         
         // Algorithm-specific parameters
         struct {
@@ -52,11 +74,78 @@ public:
             int numMelFilters = 26;
             bool includeC0 = false;  // Include 0th coefficient
         } mfcc;
+        
+        // Multi-resolution search for spectral flux and energy
+        struct {
+            int hopSize = 0;          // Hop of the decimated envelope in samples (0 = disabled, e.g. 4096)
+            int refineRadius = 2;     // Coarse frames searched on either side of the candidate
+            size_t minCoarseFrames = 16;  // Shorter coarse envelopes fall back to a single-resolution search
+        } coarseToFine;
+        
+        // Sub-hop offset refinement
+        struct {
+            bool interpolatePeak = true;  // Parabolic interpolation of the feature correlation peak
+            bool sampleDomain = true;     // GCC-PHAT on raw samples within one hop of the feature offset
+            size_t segmentSize = 8192;    // Samples per GCC-PHAT segment
+            size_t maxExcerpts = 8;       // Reference segments kept by prepared references
+        } refinement;
+        
+        // Clock drift estimation (active when enableDriftCorrection is set)
+        struct {
+            size_t numSegments = 16;           // Local alignments spread across the overlap
+            double segmentSeconds = 20.0;      // Length of each local alignment
+            double minDurationSeconds = 60.0;  // Shorter overlaps are not measured
+            double maxPpm = 200.0;             // Bounds the lag searched around the global offset
+            double minPpm = 2.0;               // Smaller fitted drift is reported as none
+            double minSegmentCorrelation = 0.3;  // Segments matching worse than this are discarded
+            size_t minSegments = 4;            // Segments that must agree with the fitted line
+        } drift;
+        
+        // Hybrid cascade: methods run cheapest first and stop once their results settle,
+        // instead of always combining all four (concurrentHybrid does not apply)
+        struct {
+            bool enabled = false;
+            double acceptConfidence = 0.9;  // A single method this confident ends the cascade
+            int toleranceSamples = 0;       // Two offsets this close agree (0 = the energy hop)
+        } cascade;
+        
+        // Landmark search (alignLandmarks): onset-pair fingerprints vote for offsets and
+        // spectral flux is correlated only around the best voted ones
+        struct {
+            float onsetThreshold = 0.05f;      // Flux above its local mean needed for an onset
+            int onsetWindow = 8;               // Frames in the onset peak-picking window
+            LandmarkIndex::Settings fingerprint;
+            size_t maxCandidates = 4;          // Voted offsets checked by dense correlation
+            size_t minVotes = 4;               // Fewer agreeing landmarks do not make a candidate
+            int toleranceFrames = 1;           // Offsets this close vote together
+            int refineRadius = 32;             // Frames correlated on either side of a candidate
+        } landmarks;
+        
+        // Clip grouping (groupClips): landmark votes propose overlapping pairs, which are
+        // verified like alignLandmarks results and placed on timelines by TimelineSolver
+        struct {
+            size_t maxPairsPerClip = 8;     // Most-voted other clips verified per clip
+            double toleranceSamples = 0.0;  // Pairs disagreeing with the spanning tree by more are dropped (0 = two hops)
+        } grouping;
+        
+        // Peak picking on correlation curves
+        struct {
+            size_t maxPeaks = 4;          // Local maxima tracked per curve (primary and runners-up)
+            size_t exclusionRadius = 10;  // Lags around a peak that belong to it, also left out of the SNR noise estimate
+        } peakPicking;
     };
     
-    void setConfig(const Config& config) { config_ = config; }
+    void setConfig(const Config& config) {
+        config_ = config;
+        correlationEngine_.setPrecision(config.correlationPrecision);
+    }
     const Config& getConfig() const { return config_; }
     
+    /// Persistent store consulted by prepareFeatures() (nullptr = always extract)
+    /// The cache may be shared by any number of engines.
+    void setFeatureCache(std::shared_ptr<const FeatureCache> cache) { featureCache_ = std::move(cache); }
+    const std::shared_ptr<const FeatureCache>& getFeatureCache() const { return featureCache_; }
+    
     // MARK: - Alignment Methods
     
     /// Align using spectral flux (best for speech/dialogue)
@@ -74,6 +163,122 @@ public:
     /// Hybrid alignment combining multiple methods
     harmoniq_sync_result_t alignHybrid(const AudioProcessor& reference, const AudioProcessor& target);
     
+    // MARK: - Feature Preparation
+    
+    /// Memoized FFTs of a reference clip's feature streams, one cache per
+    /// correlated stream (chroma and MFCC caches hold every dimension)
+    struct FeatureSpectra {
+        CorrelationEngine::SpectrumCache spectralFlux;
+        CorrelationEngine::SpectrumCache energy;
+        CorrelationEngine::SpectrumCache chroma;
+        CorrelationEngine::SpectrumCache mfcc;
+    };
+    
+    /// Short raw-sample segment of a reference clip kept for sample-domain refinement
+    struct SampleExcerpt {
+        size_t start = 0;            // Position in the reference, in samples
+        std::vector<float> samples;
+    };
+    
+    /// Post-processed feature streams of one clip, ready for correlation.
+    /// Only the streams needed by `method` are populated (all of them for hybrid),
+    /// plus the energy profile for drift estimation when chroma or MFCC is used.
+    /// Instances are immutable after preparation and safe to share across threads.
+    struct ClipFeatures {
+        harmoniq_sync_method_t method = HARMONIQ_SYNC_SPECTRAL_FLUX;
+        size_t audioLength = 0;          // Source length in samples
+        double sampleRate = 0.0;
+        int hopSize = 0;                 // Hop of the spectral streams
+        int energyHopSize = 0;           // Hop of the energy profile
+        std::vector<float> spectralFlux; // Thresholded, smoothed, normalized
+        FeatureMatrix chroma;            // frames x numChromaBins
+        std::vector<float> energy;       // Smoothed, normalized RMS
+        FeatureMatrix mfcc;              // frames x numCoeffs
+        std::shared_ptr<FeatureSpectra> spectra;  // Set on reference features only
+        std::vector<SampleExcerpt> excerpts;      // Reference only: loudest raw segments, loudest first
+        std::shared_ptr<const LandmarkIndex> landmarks;  // Set by prepareLandmarkReference only
+    };
+    
+    /// Extract and post-process the features required by a method
+    /// With a feature cache set, unchanged clips are read back instead of extracted.
+    ClipFeatures prepareFeatures(const AudioProcessor& audio, harmoniq_sync_method_t method) const;
+    
+    /// Prepare features for a clip that will be matched against many targets
+    /// Same as prepareFeatures, plus a transform cache so FFT correlation only
+    /// transforms the target side after the first use of each FFT size.
+    ClipFeatures prepareReferenceFeatures(const AudioProcessor& audio, harmoniq_sync_method_t method) const;
+    
+    /// Post-process features extracted incrementally by a streaming extractor
+    /// The stream's method and hop sizes are used; post-processing parameters come from this engine.
+    ClipFeatures prepareFeatures(const StreamingFeatureExtractor& stream) const;
+    
+    /// Reference variant of prepareFeatures(const StreamingFeatureExtractor&)
+    ClipFeatures prepareReferenceFeatures(const StreamingFeatureExtractor& stream) const;
+    
+    /// Align a target against reference features prepared for the same method
+    harmoniq_sync_result_t alignPrepared(const ClipFeatures& reference, const AudioProcessor& target, harmoniq_sync_method_t method);
+    
+    /// Alignment from prepared features (see prepareFeatures)
+    harmoniq_sync_result_t alignSpectralFlux(const ClipFeatures& reference, const ClipFeatures& target);
+    harmoniq_sync_result_t alignChromaFeatures(const ClipFeatures& reference, const ClipFeatures& target);
+    harmoniq_sync_result_t alignEnergyCorrelation(const ClipFeatures& reference, const ClipFeatures& target);
+    harmoniq_sync_result_t alignMFCC(const ClipFeatures& reference, const ClipFeatures& target);
+    harmoniq_sync_result_t alignHybrid(const ClipFeatures& reference, const ClipFeatures& target);
+    
+    /// Dispatch to one of the single-method overloads above (hybrid included)
+    harmoniq_sync_result_t alignFeatures(const ClipFeatures& reference, const ClipFeatures& target, harmoniq_sync_method_t method);
+    
+    // MARK: - Landmark Search
+    
+    /// Onset-pair fingerprints of a clip (Config::landmarks), from onsets picked in
+    /// spectral flux prepared for the same clip
+    std::vector<LandmarkIndex::Landmark> extractLandmarks(const AudioProcessor& audio, const ClipFeatures& features) const;
+    
+    /// Spectral flux reference features plus a landmark index of the reference
+    ClipFeatures prepareLandmarkReference(const AudioProcessor& audio) const;
+    
+    /// Locate a target by landmark voting, then correlate spectral flux only within
+    /// Config::landmarks.refineRadius frames of the best voted offsets. Unlike the dense
+    /// methods the whole reference is searched unless maxOffsetSamples is set, so a short
+    /// clip is found anywhere in a long recording at a cost that grows with the number of
+    /// landmarks rather than with the number of lags.
+    harmoniq_sync_result_t alignLandmarks(const AudioProcessor& reference, const AudioProcessor& target);
+    
+    /// Landmark search against features from prepareLandmarkReference
+    harmoniq_sync_result_t alignLandmarks(const ClipFeatures& reference, const AudioProcessor& target);
+    
+    // MARK: - Drift Correction
+    
+    /// Linear clock drift of a target against a reference
+    /// The offset at reference sample r is offsetAtStart + ppm * 1e-6 * r.
+    struct DriftInfo {
+        bool detected = false;
+        double ppm = 0.0;               // Parts per million, positive when the target clock runs fast
+        double offsetAtStart = 0.0;     // Fitted offset at reference sample 0, in samples
+        size_t segmentsUsed = 0;        // Local alignments that agree with the fit (0 = not measured)
+        bool correctionApplied = false; // The result offset was re-anchored to the fitted line
+    };
+    
+    /// Detect drift from local alignments along the clip and correct the result in place
+    /// Each of Config::drift.numSegments reference segments is correlated against the target
+    /// over a lag window bounded by maxPpm around the result offset (segments run on the
+    /// shared thread pool), then offset against time is fitted with a Theil-Sen line.
+    /// If drift is detected the result receives drift_ppm and an offset re-anchored to
+    /// reference sample 0; drift_segments is set whenever drift was measured.
+    DriftInfo detectAndCorrectDrift(const ClipFeatures& reference,
+                                    const ClipFeatures& target,
+                                    harmoniq_sync_result_t& result) const;
+    
+    /// Resample a target so it runs at the reference clock
+    /// Output sample m is read from target position (m - offset) * (1 + ppm * 1e-6) + offset
+    /// with cubic interpolation, so the corrected target keeps `offsetSamples` against the
+    /// reference over its whole length. Positions outside the target read as silence.
+    /// @param offsetSamples Offset at reference sample 0 (DriftInfo::offsetAtStart)
+    /// @param ppm Drift to remove (DriftInfo::ppm)
+    /// @return `length` samples
+    static std::vector<float> correctDrift(const float* samples, size_t length,
+                                           double offsetSamples, double ppm);
+    
     // MARK: - Onset Detection (Public for testing)
     
     /// Detect onsets from spectral flux using peak picking
@@ -89,37 +294,145 @@ public:
     // MARK: - Batch Processing
     
     /// Align multiple targets against single reference
+    /// Reference features are extracted once; targets are spread across the shared
+    /// thread pool (Config::numWorkers) and results are returned in input order.
     std::vector<harmoniq_sync_result_t> alignBatch(
         const AudioProcessor& reference,
         const std::vector<AudioProcessor>& targets,
         harmoniq_sync_method_t method
     );
     
-private:
-    // MARK: - Private Members
+    /// Align multiple targets against reference features prepared for `method`
+    std::vector<harmoniq_sync_result_t> alignBatch(
+        const ClipFeatures& reference,
+        const std::vector<AudioProcessor>& targets,
+        harmoniq_sync_method_t method
+    );
     
-    Config config_;
+    // MARK: - Clip Grouping
     
-    // Working buffers for correlation analysis
-    mutable std::vector<double> correlationBuffer;
-    mutable std::vector<float> featureBuffer1;
-    mutable std::vector<float> featureBuffer2;
+    /// Verified alignment of one candidate pair of clips
+    struct PairAlignment {
+        size_t reference;               // Lower clip index of the pair
+        size_t target;
+        size_t votes;                   // Landmarks shared at the proposed offsets
+        harmoniq_sync_result_t result;  // Target against reference (alignLandmarks semantics)
+        bool consistent = false;        // Successful and used by the timeline fit
+    };
     
-    // MARK: - Core Correlation Functions
+    /// Clips placed on shared timelines
+    struct ClipGrouping {
+        std::vector<TimelineSolver::Placement> clips;  // One per input clip, in input order
+        size_t groupCount = 0;
+        std::vector<PairAlignment> pairs;              // Every verified candidate pair
+    };
+    
+    /// Sort many clips from several recorders into groups that share a timeline
+    /// One landmark index is built over all clips (clips prepared in parallel), every
+    /// clip queries it for the other clips sharing most fingerprints, only those
+    /// candidate pairs are verified by dense correlation (in parallel), and the
+    /// verified offsets are fitted to one start position per clip. The cost grows with
+    /// the number of clips times Config::grouping.maxPairsPerClip instead of with every
+    /// pair of clips. Clips must share one sample rate.
+    ClipGrouping groupClips(const std::vector<AudioProcessor>& clips);
     
-    /// Compute cross-correlation between two feature vectors
-    std::vector<double> crossCorrelate(const std::vector<float>& a, const std::vector<float>& b) const;
+    // MARK: - Peak Analysis
     
-    /// Find the best alignment from correlation data
+    /// Best alignment found in one correlation curve
     struct CorrelationPeak {
         size_t index;
         double value;
         double confidence;
-        double secondaryPeakRatio;
+        double secondaryPeakRatio;    // Primary over the strongest peak outside its exclusion radius
+        double snrEstimate = 0.0;     // Peak over median noise magnitude (dB)
+        double noiseFloorDb = -60.0;  // 10th percentile magnitude (dB)
     };
     
+    /// Find the best alignment from correlation data (peak, confidence, peak ratio and noise)
+    /// All scores come from one CorrelationAnalyzer pass over the curve.
     CorrelationPeak findBestAlignment(const std::vector<double>& correlation) const;
     
+    /// Score the peak of a curve already pushed through a finished analyzer
+    CorrelationPeak scorePeak(const CorrelationAnalyzer& analysis) const;
+    
+private:
+    // MARK: - Private Members
+    
+    Config config_;
+    std::shared_ptr<const FeatureCache> featureCache_;
+    
+    // Correlation kernels (owns reusable FFT setup and buffers)
+    CorrelationEngine correlationEngine_;
+    
+    // Working buffers for correlation analysis
+    mutable std::vector<double> correlationBuffer;
+    mutable std::vector<float> featureBuffer1;
+    mutable std::vector<float> featureBuffer2;
+    
+    // MARK: - Core Correlation Functions
+    
+    /// Compute cross-correlation between two feature vectors over lags [-maxLag, +maxLag]
+    /// @param cacheA Optional transform cache attached to the reference stream `a`
+    std::vector<double> crossCorrelate(const std::vector<float>& a, const std::vector<float>& b, size_t maxLag,
+                                       CorrelationEngine::SpectrumCache* cacheA = nullptr) const;
+    
+    /// Correlate two scalar streams over [-maxLag, +maxLag] and pick the best peak
+    /// When the whole-signal kernel would exceed Config::correlationMemoryBytes, lag scores
+    /// stream from the partitioned kernel straight into the peak analysis and the peak's
+    /// neighbours for interpolation are evaluated directly, so no curve is stored.
+    /// @param sampleOffset Interpolated offset of the peak in samples
+    CorrelationPeak correlatePeak(const std::vector<float>& a, const std::vector<float>& b, size_t maxLag,
+                                  int hopSize, CorrelationEngine::SpectrumCache* cacheA,
+                                  double& sampleOffset) const;
+    
+    /// Two-stage search: full lag window on decimated envelopes, then full-resolution
+    /// lags around the coarse candidate. On success `coarseCorrelation` and `peak`
+    /// describe the coarse curve, except peak.value, which is the refined peak.
+    /// @return False if coarse-to-fine is disabled or the streams are too short
+    bool searchCoarseToFine(const std::vector<float>& reference, const std::vector<float>& target,
+                            int hopSize, size_t maxLag,
+                            std::vector<double>& coarseCorrelation,
+                            CorrelationPeak& peak, double& sampleOffset) const;
+    
+    /// Refine a successful result with GCC-PHAT between a reference excerpt and the
+    /// matching target samples, searching one hop either side of the feature offset. Unchanged if disabled,
+    /// the overlap is too short or the samples do not confirm a nearby lag.
+    harmoniq_sync_result_t refineWithSamples(harmoniq_sync_result_t result,
+                                             const std::vector<SampleExcerpt>& excerpts,
+                                             const AudioProcessor& target,
+                                             const ClipFeatures& features) const;
+    
+    /// Pick the loudest reference segments for refineWithSamples
+    std::vector<SampleExcerpt> selectExcerpts(const AudioProcessor& audio) const;
+    
+    /// Loudest segments within samples [first, last) of a clip
+    std::vector<SampleExcerpt> selectExcerpts(const AudioProcessor& audio, size_t first, size_t last) const;
+    
+    /// Landmark voting and dense verification for alignLandmarks
+    /// @param referenceAudio Reference PCM when at hand, so refinement excerpts can be
+    ///        picked inside the overlap instead of from the prepared reference
+    harmoniq_sync_result_t searchLandmarks(const ClipFeatures& reference, const AudioProcessor& target,
+                                           const AudioProcessor* referenceAudio);
+    
+    /// Run body(engine, index) for every index on the shared thread pool (Config::numWorkers)
+    /// Slot 0 runs on this engine and every other slot on its own, so scratch buffers are never shared.
+    void parallelForEach(size_t count, const std::function<void(AlignmentEngine&, size_t)>& body);
+    
+    /// Dense spectral flux correlation within Config::landmarks.refineRadius frames of
+    /// each candidate offset; the strongest peak becomes the result
+    harmoniq_sync_result_t verifyLandmarkOffsets(const ClipFeatures& reference, const ClipFeatures& target,
+                                                 const std::vector<int64_t>& offsetFrames) const;
+    
+    /// Drift estimation and sample-domain refinement of a verified landmark result
+    harmoniq_sync_result_t finishLandmarkResult(harmoniq_sync_result_t result,
+                                                const ClipFeatures& reference,
+                                                const ClipFeatures& targetFeatures,
+                                                const AudioProcessor& target,
+                                                const AudioProcessor* referenceAudio) const;
+    
+    /// Average consecutive blocks of `factor` frames and renormalize
+    std::vector<float> decimateFeatures(const std::vector<float>& features, size_t factor) const;
+    
     /// Three-factor confidence scoring structure
     struct ConfidenceFactors {
         double correlationStrength = 0.0;  // Raw peak value normalized by signal energy
@@ -127,11 +440,11 @@ private:
         double snr = 0.0;                  // Ratio of primary peak to secondary peak
     };
     
-    /// Calculate confidence score based on three-factor system
-    double calculateConfidence(const std::vector<double>& correlation, size_t peakIndex) const;
+    /// Calculate confidence score of the primary peak based on three-factor system
+    double calculateConfidence(const CorrelationAnalyzer& analysis) const;
     
     /// Calculate individual confidence factors
-    ConfidenceFactors calculateConfidenceFactors(const std::vector<double>& correlation, size_t peakIndex) const;
+    ConfidenceFactors calculateConfidenceFactors(const CorrelationAnalyzer& analysis) const;
     
     /// Calibration framework for mapping raw scores to [0.0, 1.0] range
     struct CalibrationParameters {
@@ -156,11 +469,26 @@ private:
     /// Apply calibration to normalize confidence factors
     ConfidenceFactors calibrateFactors(const ConfidenceFactors& rawFactors) const;
     
-    /// Calculate signal-to-noise ratio estimate
-    double calculateSNREstimate(const std::vector<double>& correlation, size_t peakIndex) const;
+    /// Calculate signal-to-noise ratio estimate of the primary peak
+    double calculateSNREstimate(const CorrelationAnalyzer& analysis) const;
     
     /// Calculate noise floor in correlation
-    double calculateNoiseFloor(const std::vector<double>& correlation) const;
+    double calculateNoiseFloor(const CorrelationAnalyzer& analysis) const;
+    
+    // MARK: - Hybrid Combination
+    
+    /// Confidence-weighted consensus of successful single-method results
+    harmoniq_sync_result_t combineHybridResults(const std::vector<harmoniq_sync_result_t>& results) const;
+    
+    /// Hybrid cascade, cheapest method first. `extract` runs before each stage and may fill
+    /// the streams that method needs into the features; returning false aborts the cascade
+    /// with an invalid-input error.
+    harmoniq_sync_result_t alignCascade(const ClipFeatures& reference, const ClipFeatures& target,
+                                        const std::function<bool(harmoniq_sync_method_t)>& extract);
+    
+    /// Add the streams of one method to features, leaving streams already present alone
+    /// @return False if the clip is invalid (NaN/Inf samples)
+    bool extendFeatures(const AudioProcessor& audio, harmoniq_sync_method_t method, ClipFeatures& features) const;
     
     // MARK: - Feature Processing
     
@@ -173,26 +501,26 @@ private:
     /// Normalize feature vector
     void normalizeFeatures(std::vector<float>& features) const;
     
-    // MARK: - Drift Correction
+    // MARK: - Drift Estimation
     
-    struct DriftInfo {
-        bool detected = false;
-        double ppm = 0.0;  // Parts per million
-        bool correctionApplied = false;
+    /// One local alignment of the drift search
+    struct DriftSegment {
+        bool valid = false;
+        double position = 0.0;  // Centre of the reference segment, in samples
+        double offset = 0.0;    // Local offset, in samples
     };
     
-    /// Detect and correct time drift between audio sources
-    DriftInfo detectAndCorrectDrift(
-        const std::vector<float>& refFeatures,
-        std::vector<float>& targetFeatures,
-        double sampleRate
-    ) const;
+    /// Align one reference segment against the target within [firstLag, lastLag] frames
+    DriftSegment alignDriftSegment(const std::vector<float>& reference, const std::vector<float>& target,
+                                   size_t start, size_t length, int64_t firstLag, int64_t lastLag,
+                                   int hopSize) const;
     
     // MARK: - Result Creation
     
     /// Create result structure from alignment data
+    /// offsetSamples may be fractional; offset_samples receives its rounded value
     harmoniq_sync_result_t createResult(
-        int64_t offsetSamples,
+        double offsetSamples,
         double confidence,
         double peakCorrelation,
         double secondaryPeakRatio,
@@ -224,6 +552,47 @@ private:
     /// Calculate maximum reasonable offset based on audio lengths
     int64_t calculateMaxOffset(size_t refLength, size_t targetLength) const;
     
+    /// Convert the maximum offset into a lag window in feature frames
+    size_t calculateMaxLag(size_t refLength, size_t targetLength, int hopSize) const;
+    
+    /// Resolve the configured hop size (0 = windowSize / autoDivisor)
+    int resolveHopSize(int autoDivisor = 4) const;
+    
+    /// Integer decimation factor reaching analysisSampleRate from a source rate (1 = none)
+    int resolveDecimation(double sampleRate) const;
+    
+    /// prepareFeatures() without the feature cache
+    ClipFeatures extractFeatures(const AudioProcessor& audio, harmoniq_sync_method_t method) const;
+    
+    /// Threshold, smooth and normalize raw feature streams in place
+    void postProcessFeatures(ClipFeatures& features) const;
+    
+    /// Attach empty transform caches to reference features
+    void attachSpectra(ClipFeatures& features) const;
+    
+    /// Convert a peak index in a symmetric lag window into a sample offset
+    int64_t lagIndexToSamples(size_t peakIndex, size_t correlationSize, int hopSize) const;
+    
+    /// Fractional position of the true maximum relative to peakIndex, in [-0.5, 0.5]
+    /// (parabolic fit through the peak and its neighbours, 0 if disabled or at an edge)
+    double interpolatePeak(const std::vector<double>& correlation, size_t peakIndex) const;
+    
+    /// lagIndexToSamples plus the interpolated sub-frame position
+    double interpolatedOffset(const std::vector<double>& correlation, size_t peakIndex, int hopSize) const;
+    
+    /// Largest |offset| in samples that a window of maxLag frames covers between streams of these
+    /// lengths, reported as searched_offset_samples
+    int64_t searchedOffset(size_t refFrames, size_t targetFrames, size_t maxLag, int hopSize) const;
+    
+    /// Pearson coefficient of two feature streams over their overlap at the frame lag nearest
+    /// sampleOffset, reported as peak_correlation (correlation curves hold unnormalized means)
+    double peakCoefficient(const std::vector<float>& a, const std::vector<float>& b,
+                           double sampleOffset, int hopSize) const;
+    
+    /// Multichannel form pooling the weighted dimensions (empty weights count each equally)
+    double peakCoefficient(const FeatureMatrix& a, const FeatureMatrix& b, double sampleOffset, int hopSize,
+                           const std::vector<double>& weights) const;
+    
     /// Get method name as string
     std::string getMethodName(harmoniq_sync_method_t method) const;
 };
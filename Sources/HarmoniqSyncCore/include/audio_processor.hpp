@@ -8,13 +8,42 @@
 #ifndef AUDIO_PROCESSOR_HPP
 #define AUDIO_PROCESSOR_HPP
 
+#include "audio_statistics.hpp"
+#include "feature_matrix.hpp"
+#include "spectrum_kernel.hpp"
 #include <vector>
 #include <memory>
-#include <complex>
-#include <Accelerate/Accelerate.h>
 
 namespace HarmoniqSync {
 
+/// Read-only view of a processor's samples, owned or borrowed
+struct SampleSpan {
+    const float* samples = nullptr;
+    size_t length = 0;
+
+    const float* data() const { return samples; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    const float* begin() const { return samples; }
+    const float* end() const { return samples + length; }
+    const float& operator[](size_t index) const { return samples[index]; }
+};
+
+/// Short-time magnitude spectrum of a clip for one (windowSize, hopSize) pair.
+/// Frames are stored row-major in a single aligned buffer so feature
+/// extractors can walk them without per-frame allocations.
+struct Spectrogram {
+    int windowSize = 0;
+    int hopSize = 0;
+    double sampleRate = 0.0;        // Rate of the analysed audio (maps bins to Hz)
+    size_t numFrames = 0;
+    size_t numBins = 0;             // windowSize / 2 (DC .. Nyquist - 1)
+    FeatureMatrix magnitudes;       // numFrames x numBins, dense
+
+    const float* frame(size_t index) const { return magnitudes.row(index); }
+    bool empty() const { return numFrames == 0; }
+};
+
 class AudioProcessor {
 public:
     // MARK: - Lifecycle
@@ -38,16 +67,38 @@ public:
     /// @return True if successful
     bool loadAudio(const float* samples, size_t length, double sampleRate, double targetSampleRate = 0.0);
     
+    /// Borrow caller-owned audio without copying it
+    /// The buffer must stay alive and unchanged until the processor is cleared,
+    /// reloaded or destroyed. Instead of a separate scan, NaN/Inf samples are
+    /// detected by the first feature pass over the clip, after which isValid()
+    /// returns false and extractors return empty results. Preprocessing copies
+    /// the samples into owned storage before modifying them.
+    /// @param samples Audio samples (mono)
+    /// @param length Number of samples
+    /// @param sampleRate Sample rate of the audio
+    /// @param targetSampleRate Target sample rate (0 = no resampling; resampling produces owned samples)
+    /// @return True if successful
+    bool loadAudioView(const float* samples, size_t length, double sampleRate, double targetSampleRate = 0.0);
+    
     /// Clear loaded audio data
     void clear();
     
     // MARK: - Getters
     
-    const std::vector<float>& getAudioData() const { return audioData; }
+    SampleSpan getAudioData() const { return {sampleData, sampleCount}; }
     double getSampleRate() const { return sampleRate; }
-    size_t getLength() const { return audioData.size(); }
-    double getDurationSeconds() const { return getLength() / sampleRate; }
-    bool isValid() const { return !audioData.empty() && sampleRate > 0; }
+    size_t getLength() const { return sampleCount; }
+    double getDurationSeconds() const { return sampleRate > 0 ? getLength() / sampleRate : 0.0; }
+    bool isValid() const { return sampleCount > 0 && sampleRate > 0 && sampleCheck != SampleCheck::NonFinite; }
+    
+    /// True when the samples are borrowed from the caller rather than owned
+    bool isView() const { return sampleCount > 0 && sampleData != audioData.data(); }
+    
+    /// Level, clipping and sign-change statistics of the samples
+    /// loadAudio gathers them in the pass that copies and checks the samples;
+    /// views, resampled and preprocessed audio measure them on first use. A view
+    /// found to hold NaN/Inf samples here becomes invalid, as after a feature pass.
+    const AudioStatistics& getStatistics() const;
     
     // MARK: - Feature Extraction
     
@@ -66,8 +117,11 @@ public:
     /// Extract chroma features (harmonic content)
     /// @param windowSize FFT window size (default: 4096)
     /// @param hopSize Hop size (default: windowSize/4)
-    /// @return 12-dimensional chroma vectors concatenated
-    std::vector<float> extractChromaFeatures(int windowSize = 4096, int hopSize = 0) const;
+    /// @param numChromaBins Pitch classes per octave (default: 12)
+    /// @param harmonicWeighting Credit the pitch classes of lower harmonics too
+    /// @return numChromaBins-dimensional chroma vectors concatenated
+    std::vector<float> extractChromaFeatures(int windowSize = 4096, int hopSize = 0,
+                                             int numChromaBins = 12, bool harmonicWeighting = false) const;
     
     /// Extract energy profile
     /// @param windowSize Analysis window size (default: 512)
@@ -79,8 +133,47 @@ public:
     /// @param numCoeffs Number of MFCC coefficients (default: 13)
     /// @param windowSize FFT window size (default: 1024)
     /// @param hopSize Hop size (default: windowSize/4)
+    /// @param numMelFilters Number of mel filters (default: 26)
     /// @return MFCC coefficients concatenated
-    std::vector<float> extractMFCC(int numCoeffs = 13, int windowSize = 1024, int hopSize = 0) const;
+    std::vector<float> extractMFCC(int numCoeffs = 13, int windowSize = 1024, int hopSize = 0, int numMelFilters = 26) const;
+    
+    // MARK: - Spectrogram
+    
+    /// Get the magnitude spectrogram, computing it on first use
+    /// Results are cached per (windowSize, hopSize) until the audio changes, so
+    /// spectral flux, chroma and MFCC extraction share a single STFT pass.
+    /// The reference stays valid until the audio is modified or the cache is cleared.
+    /// @param windowSize FFT window size (power of 2)
+    /// @param hopSize Hop size (default: windowSize/4)
+    /// @return Cached spectrogram
+    const Spectrogram& getSpectrogram(int windowSize = 1024, int hopSize = 0) const;
+    
+    /// Most recently computed spectrogram of the current samples (nullptr if none is cached)
+    const Spectrogram* getCachedSpectrogram() const;
+    
+    /// Drop all cached spectrograms
+    void clearSpectrogramCache() const;
+    
+    /// Derive spectral flux from a precomputed spectrogram
+    std::vector<float> extractSpectralFlux(const Spectrogram& spectrogram) const;
+    
+    /// Derive chroma vectors from a precomputed spectrogram
+    /// The bin-to-pitch-class map comes from the shared ChromaPlan cache.
+    std::vector<float> extractChromaFeatures(const Spectrogram& spectrogram, int numChromaBins = 12,
+                                             bool harmonicWeighting = false) const;
+    
+    /// Derive MFCC coefficients from a precomputed spectrogram
+    /// The filterbank and DCT tables come from the shared MFCCPlan cache.
+    std::vector<float> extractMFCC(const Spectrogram& spectrogram, int numCoeffs = 13, int numMelFilters = 26) const;
+    
+    /// Derive chroma vectors into a matrix, one row per spectrogram frame
+    /// The matrix is resized in place, so reusing it across calls avoids reallocation.
+    void extractChromaFeatures(const Spectrogram& spectrogram, FeatureMatrix& chroma,
+                               int numChromaBins = 12, bool harmonicWeighting = false) const;
+    
+    /// Derive MFCC coefficients into a matrix, one row per spectrogram frame
+    void extractMFCC(const Spectrogram& spectrogram, FeatureMatrix& mfcc,
+                     int numCoeffs = 13, int numMelFilters = 26) const;
     
     // MARK: - Preprocessing
     
@@ -111,50 +204,60 @@ public:
     void powerToDb(const std::vector<float>& power, std::vector<float>& db, float minDb = -120.0f) const;
     
 private:
+    // Streams frames through the same per-frame DSP as the batch extractors
+    friend class StreamingFeatureExtractor;
+    
     // MARK: - Private Members
     
-    std::vector<float> audioData;
+    /// NaN/Inf state of the samples; views start out Pending
+    enum class SampleCheck { Pending, Finite, NonFinite };
+    
+    std::vector<float> audioData;   // Owned samples (empty for views)
+    const float* sampleData;        // audioData.data() or the borrowed buffer
+    size_t sampleCount;
     double sampleRate;
+    mutable SampleCheck sampleCheck;
     
-    // Working buffers for DSP operations
-    mutable std::vector<float> workingBuffer;
-    mutable std::vector<std::complex<float>> fftBuffer;
-    mutable std::vector<float> windowFunction;
+    // Shared spectrum kernel of the last frame length (window, FFT plan and scratch are its own)
+    mutable std::shared_ptr<const SpectrumKernel> spectrumKernel;
     
-    // Apple Accelerate FFT setup
-    FFTSetup fftSetup;
-    vDSP_Length log2MaxFrameSize;
-    mutable DSPSplitComplex splitComplex;
+    // Spectrograms keyed by (windowSize, hopSize), invalidated when audioData changes
+    mutable std::vector<std::unique_ptr<Spectrogram>> spectrogramCache;
+    
+    // Statistics of the current samples (null until measured)
+    mutable std::unique_ptr<AudioStatistics> statistics;
     
     // MARK: - Private Methods
     
-    /// Resample audio data
+    /// Validate loading parameters shared by loadAudio and loadAudioView
+    static bool isLoadable(const float* samples, size_t length, double sampleRate, double targetSampleRate);
+    
+    /// Resample audio data into owned storage
     bool resampleAudio(double targetSampleRate);
     
-    /// Apply Hann window
-    void applyHannWindow(float* data, size_t length) const;
+    /// Copy borrowed samples into owned storage before they are modified
+    void makeSamplesOwned();
     
-    /// Convert frequency to mel scale
-    static float frequencyToMel(float frequency);
+    /// Drop the spectrograms and statistics of samples that have changed
+    void samplesChanged();
     
-    /// Convert mel scale to frequency
-    static float melToFrequency(float mel);
+    /// Fold the finiteness of samples [checkedEnd, end) into a pending check
+    /// Called frame by frame from the first feature pass so each sample is checked once.
+    void checkSamples(size_t& checkedEnd, size_t end, bool& finite) const;
     
-    /// Create mel filter bank
-    std::vector<std::vector<float>> createMelFilterBank(int numFilters, int fftSize, double sampleRate) const;
+    /// Record the outcome of a pending check
+    void finishSampleCheck(bool finite) const;
     
-    /// Compute DCT for MFCC
-    void computeDCT(const std::vector<float>& input, std::vector<float>& output, int numCoeffs) const;
+    /// Spectrum kernel for a frame length, looked up once per length change
+    /// @throws std::invalid_argument unless the length is a power of 2 up to the maximum frame size
+    const SpectrumKernel& kernelFor(size_t frameLength) const;
     
-    /// Compute chroma vector from magnitude spectrum
-    void computeChromaVector(const std::vector<float>& magnitude, std::vector<float>& chroma) const;
+    /// Compute one windowed magnitude frame into a caller-provided buffer of length/2 values
+    void computeMagnitudeFrame(const float* input, size_t inputLength, float* magnitude) const;
     
     /// Calculate RMS energy
     float calculateRMSEnergy(const float* data, size_t length) const;
     
-    /// Find peak value in array
-    float findPeak(const float* data, size_t length) const;
-    
     /// Apply median filtering for smoothing
     void smoothFeatures(std::vector<float>& features, int filterSize) const;
 };
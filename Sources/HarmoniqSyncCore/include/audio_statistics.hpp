@@ -0,0 +1,83 @@
+//
+//  audio_statistics.hpp
+//  HarmoniqSyncCore
+//
+//  Sample-level statistics of a clip gathered in one fused pass
+//
+
+#ifndef AUDIO_STATISTICS_HPP
+#define AUDIO_STATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace HarmoniqSync {
+
+struct Spectrogram;
+
+/// Level, sign-change and validity statistics of a sample buffer.
+/// measure() walks the buffer once in cache-sized blocks with a branch-free
+/// loop the compiler vectorizes, keeping float partials per block and folding
+/// them into double totals, so loading, validation and quality reports share a
+/// single read of the samples. Non-finite samples are counted and left out of
+/// every other statistic.
+struct AudioStatistics {
+    static constexpr float DEFAULT_SILENCE_THRESHOLD = 0.001f;  // -60 dBFS
+    static constexpr float DEFAULT_CLIPPING_THRESHOLD = 0.95f;  // Fraction of full scale
+    static constexpr uint32_t EXPONENT_MASK = 0x7F800000;        // All ones for NaN and infinity
+
+    size_t sampleCount = 0;
+    size_t nonFiniteCount = 0;     // NaN or infinite samples
+    size_t firstNonFinite = 0;     // Index of the first of them (sampleCount when there are none)
+    size_t silentCount = 0;        // |x| < silenceThreshold
+    size_t clippedCount = 0;       // |x| >= clippingThreshold
+    size_t zeroCrossings = 0;      // Neighbouring samples on opposite sides of zero (non-finite ones count as zero)
+    double peak = 0.0;             // Largest |x|
+    double offset = 0.0;           // First sample; sums are taken around it to keep the variance exact
+    double sum = 0.0;              // Sum of (x - offset)
+    double sumSquares = 0.0;       // Sum of (x - offset)^2
+    float silenceThreshold = DEFAULT_SILENCE_THRESHOLD;
+    float clippingThreshold = DEFAULT_CLIPPING_THRESHOLD;
+
+    // MARK: - Measurement
+
+    /// Gather the statistics of a buffer in one pass
+    /// @param copy Optional destination the samples are copied to in the same pass
+    static AudioStatistics measure(const float* samples, size_t length,
+                                   float silenceThreshold = DEFAULT_SILENCE_THRESHOLD,
+                                   float clippingThreshold = DEFAULT_CLIPPING_THRESHOLD,
+                                   float* copy = nullptr);
+
+    /// True unless the sample is NaN or infinite
+    /// Tests the exponent bits, so it still holds when the build assumes finite math.
+    static bool isFiniteSample(float sample) {
+        uint32_t bits;
+        std::memcpy(&bits, &sample, sizeof(bits));
+        return (bits & EXPONENT_MASK) != EXPONENT_MASK;
+    }
+
+    /// True when no sample of the buffer is NaN or infinite, without gathering the rest
+    static bool allFiniteSamples(const float* samples, size_t length);
+
+    /// Magnitude-weighted mean frequency of a spectrogram in Hz (0 if it holds no energy)
+    static double spectralCentroid(const Spectrogram& spectrogram);
+
+    // MARK: - Derived Values
+
+    bool allFinite() const { return nonFiniteCount == 0; }
+    size_t finiteCount() const { return sampleCount - nonFiniteCount; }
+
+    double mean() const;
+    double variance() const;
+    double rms() const;
+
+    /// Ratios over all samples, as the quality report uses them
+    double silenceRatio() const;
+    double clippingRatio() const;
+    double zeroCrossingRate() const;
+};
+
+} // namespace HarmoniqSync
+
+#endif /* AUDIO_STATISTICS_HPP */
@@ -0,0 +1,80 @@
+//
+//  chroma_plan.hpp
+//  HarmoniqSyncCore
+//
+//  Cached bin-to-pitch-class map for chroma extraction
+//
+
+#ifndef CHROMA_PLAN_HPP
+#define CHROMA_PLAN_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Precomputed mapping from magnitude bins to pitch classes for one
+/// (sampleRate, numBins, numChromaBins, harmonicWeighting) configuration.
+/// Consecutive bins that credit the same pitch class with the same weight are
+/// stored as one run, so a frame costs one short sum per run instead of a
+/// log2 per bin. Plans are immutable and shared across threads through get().
+class ChromaPlan {
+public:
+    // MARK: - Lifecycle
+
+    /// Build the map (prefer get(), which reuses plans)
+    /// @param sampleRate Rate of the analysed audio
+    /// @param numBins Magnitude bins per frame (windowSize / 2)
+    /// @param numChromaBins Pitch classes per octave (12 = one per semitone)
+    /// @param harmonicWeighting Also credit the pitch classes of f/2 .. f/4 with decaying weights
+    ChromaPlan(double sampleRate, size_t numBins, int numChromaBins, bool harmonicWeighting);
+
+    /// Shared plan for a configuration, built on first use (thread-safe)
+    static std::shared_ptr<const ChromaPlan> get(double sampleRate, size_t numBins, int numChromaBins, bool harmonicWeighting);
+
+    // MARK: - Processing
+
+    /// Compute sum-normalized chroma vectors for consecutive magnitude frames
+    /// @param magnitudes numFrames x numBins values, row-major
+    /// @param numFrames Number of frames
+    /// @param output numFrames x numChromaBins values, row-major
+    void apply(const float* magnitudes, size_t numFrames, float* output) const;
+
+    // MARK: - Getters
+
+    double getSampleRate() const { return sampleRate_; }
+    size_t getNumBins() const { return numBins_; }
+    int getNumChromaBins() const { return numChromaBins_; }
+    bool usesHarmonicWeighting() const { return harmonicWeighting_; }
+
+    /// Number of contiguous (bin span, pitch class) runs
+    size_t getRunCount() const { return runs_.size(); }
+
+private:
+    // MARK: - Private Members
+
+    /// Consecutive bins credited to one pitch class with one weight
+    struct Run {
+        size_t start = 0;       // First bin
+        size_t length = 0;      // Bins covered
+        int chromaClass = 0;    // Destination pitch class
+        float weight = 1.0f;    // Applied to the summed magnitudes
+    };
+
+    double sampleRate_;
+    size_t numBins_;
+    int numChromaBins_;
+    bool harmonicWeighting_;
+
+    std::vector<Run> runs_;
+
+    // MARK: - Private Methods
+
+    /// Build the runs for every harmonic considered
+    void buildRuns();
+};
+
+} // namespace HarmoniqSync
+
+#endif /* CHROMA_PLAN_HPP */
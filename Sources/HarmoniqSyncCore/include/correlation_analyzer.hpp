@@ -0,0 +1,107 @@
+//
+//  correlation_analyzer.hpp
+//  HarmoniqSyncCore
+//
+//  Single-pass statistics and peak extraction for correlation curves
+//
+
+#ifndef CORRELATION_ANALYZER_HPP
+#define CORRELATION_ANALYZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Gathers everything peak picking and confidence scoring need from one
+/// correlation curve in a single O(N) pass: the strongest local maxima, RMS,
+/// mean absolute value and a histogram of magnitudes for approximate quantiles.
+/// Lag scores are pushed in order, so the curve never has to be stored.
+class CorrelationAnalyzer {
+public:
+    /// Local maximum of the curve
+    struct Peak {
+        size_t index;
+        double value;
+    };
+
+    // MARK: - Lifecycle
+
+    /// @param maxPeaks Number of local maxima kept (at least 1)
+    /// @param exclusionRadius Lags on either side of a peak that belong to it: a weaker
+    ///        maximum within this distance of a kept peak is not a separate peak
+    CorrelationAnalyzer(size_t maxPeaks, size_t exclusionRadius);
+
+    /// Forget all pushed values, keeping the settings and buffers
+    void reset();
+
+    // MARK: - Accumulation
+
+    /// Append the next lag scores
+    void push(const double* values, size_t count);
+
+    /// Complete the curve; call once after the last push, before the queries
+    void finish();
+
+    /// reset(), push() and finish() for a whole curve
+    void analyze(const std::vector<double>& correlation);
+
+    // MARK: - Results
+
+    /// Number of values pushed
+    size_t size() const { return count_; }
+
+    /// Strongest local maxima, descending by value (ties: lower index first), pairwise
+    /// more than exclusionRadius apart. The first one is the first global maximum.
+    const std::vector<Peak>& getPeaks() const { return peaks_; }
+
+    /// Root mean square of the values (0 for an empty curve)
+    double rms() const;
+
+    /// Mean of the absolute values (0 for an empty curve)
+    double meanAbs() const;
+
+    /// Absolute value at rank floor(size * fraction) of the sorted magnitudes
+    /// Interpolated within a histogram bucket, so within about 3% of the exact value.
+    double absQuantile(double fraction) const;
+
+    /// absQuantile() over the values outside the primary peak's exclusion zone
+    /// The excluded values are taken to lie above the quantile, which holds for any
+    /// peak that stands out of the noise.
+    double noiseQuantile(double fraction) const;
+
+    size_t getMaxPeaks() const { return maxPeaks_; }
+    size_t getExclusionRadius() const { return exclusionRadius_; }
+
+private:
+    // MARK: - Private Members
+
+    size_t maxPeaks_;
+    size_t exclusionRadius_;
+
+    size_t count_ = 0;
+    double sumSquares_ = 0.0;
+    double sumAbs_ = 0.0;
+    double maxAbs_ = 0.0;
+
+    // Rising edge of the last two values, for local maximum detection
+    double previous_ = 0.0;
+    bool rising_ = true;
+    double admission_;                  // Maxima must exceed this to be offered
+
+    std::vector<Peak> peaks_;           // Kept maxima, descending
+    std::vector<uint32_t> histogram_;   // Magnitude counts per logarithmic bucket
+
+    // MARK: - Private Methods
+
+    /// Offer a local maximum to the peak list
+    void offerPeak(size_t index, double value);
+
+    /// Quantile over the first `count` histogram entries in rank order
+    double quantile(double fraction, size_t count) const;
+};
+
+} // namespace HarmoniqSync
+
+#endif /* CORRELATION_ANALYZER_HPP */
@@ -0,0 +1,339 @@
+//
+//  correlation_engine.hpp
+//  HarmoniqSyncCore
+//
+//  Cross-correlation kernels for feature alignment
+//
+
+#ifndef CORRELATION_ENGINE_HPP
+#define CORRELATION_ENGINE_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "dsp_backend.hpp"
+#include "feature_matrix.hpp"
+
+namespace HarmoniqSync {
+
+/// Computes per-lag normalized cross-correlation between feature vectors.
+/// Two interchangeable kernels are provided: a direct time-domain loop and a
+/// zero-padded real FFT path (conjugate multiply + inverse). Both produce the
+/// same output layout, so callers never need to know which one ran.
+///
+/// Both kernels run in double precision by default. In single precision the
+/// transforms, spectra and inner products are float, halving the memory traffic
+/// of the bandwidth-bound loops; direct sums are accumulated in short float
+/// blocks folded into a double total, so their error does not grow with the
+/// input length. Results are returned as double either way.
+///
+/// For very long streams a partitioned kernel streams the lag scores in blocks
+/// instead of returning them, so its working memory is set by the lag window
+/// rather than by the input lengths.
+///
+/// FFT plans come from DSP::sharedRealFFT and are shared with every other
+/// engine; padding and spectrum buffers belong to the instance, so one instance
+/// serves one thread at a time.
+class CorrelationEngine {
+public:
+    // MARK: - Types
+
+    enum class Mode {
+        Auto,    // Pick the cheaper kernel from the input lengths
+        Direct,  // Always use the O(N·M) time-domain loop
+        FFT      // Always use the frequency-domain kernel
+    };
+    
+    /// Arithmetic of the feature correlation kernels
+    enum class Precision {
+        Double,  // Double transforms and accumulators
+        Single   // Float transforms and block-wise float accumulation (GCC-PHAT stays double)
+    };
+    
+    /// Storage order of a multichannel feature matrix
+    enum class Layout {
+        FrameMajor,     // values[frame * dims + dim], as the extractors return them
+        DimensionMajor  // values[dim * frames + frame]
+    };
+    
+    /// Receives consecutive blocks of lag scores, lowest lag first
+    using LagSink = std::function<void(const double* values, size_t count)>;
+    
+    /// Memoized forward transforms of one fixed input vector, keyed by transform size.
+    /// Partitioned reference spectra are kept under their own keys.
+    /// Attach one to a reference stream that is correlated against many targets so
+    /// the FFT kernel only transforms the target side. Safe to share across threads.
+    class SpectrumCache {
+    public:
+        using Spectrum = std::shared_ptr<const std::vector<double>>;
+        using SingleSpectrum = std::shared_ptr<const std::vector<float>>;
+        
+        /// Look up the packed spectrum for a 2^log2Size transform (null if absent)
+        Spectrum find(size_t log2Size) const;
+        
+        /// Look up the packed single precision spectrum for a 2^log2Size transform (null if absent)
+        SingleSpectrum findSingle(size_t log2Size) const;
+        
+        /// Store the packed spectrum for a 2^log2Size transform
+        void store(size_t log2Size, Spectrum spectrum);
+        void store(size_t log2Size, SingleSpectrum spectrum);
+        
+        /// Number of cached spectra over both precisions
+        size_t size() const;
+        
+    private:
+        mutable std::mutex mutex_;
+        std::map<size_t, Spectrum> spectra_;
+        std::map<size_t, SingleSpectrum> singleSpectra_;
+    };
+
+    // MARK: - Lifecycle
+
+    CorrelationEngine();
+    ~CorrelationEngine();
+
+    // Non-copyable but movable
+    CorrelationEngine(const CorrelationEngine&) = delete;
+    CorrelationEngine& operator=(const CorrelationEngine&) = delete;
+    CorrelationEngine(CorrelationEngine&& other) noexcept;
+    CorrelationEngine& operator=(CorrelationEngine&& other) noexcept;
+
+    // MARK: - Precision
+
+    /// Select the arithmetic of later correlations (default: Double)
+    void setPrecision(Precision value) { precision = value; }
+    Precision getPrecision() const { return precision; }
+
+    // MARK: - Correlation
+
+    /// Unbounded lag window (search every lag with at least one overlapping frame)
+    static constexpr size_t UNBOUNDED_LAG = std::numeric_limits<size_t>::max();
+
+    /// Compute cross-correlation normalized by the overlap count of each lag
+    /// @param a First feature vector (reference)
+    /// @param b Second feature vector (target)
+    /// @param mode Kernel selection (default: automatic)
+    /// @return 2*min(N,M)-1 values; index k holds lag k-(min(N,M)-1), i.e. sum(a[i]*b[i+lag])/count
+    std::vector<double> crossCorrelate(const std::vector<float>& a,
+                                       const std::vector<float>& b,
+                                       Mode mode = Mode::Auto) const;
+
+    /// Compute cross-correlation restricted to lags in [-maxLag, +maxLag]
+    /// @param a First feature vector (reference)
+    /// @param b Second feature vector (target)
+    /// @param maxLag Largest absolute lag to evaluate, in frames
+    /// @param mode Kernel selection (default: automatic)
+    /// @return 2*W+1 values with W = lagWindow(N, M, maxLag); index k holds lag k-W
+    /// @param cacheA Optional transform cache for `a`; must always be used with the same `a`
+    std::vector<double> crossCorrelate(const std::vector<float>& a,
+                                       const std::vector<float>& b,
+                                       size_t maxLag,
+                                       Mode mode = Mode::Auto,
+                                       SpectrumCache* cacheA = nullptr) const;
+
+    /// Compute the weighted mean of per-dimension cross-correlations in one pass
+    /// Equivalent to correlating every dimension separately and averaging the results
+    /// with the given weights, but the FFT kernel sums the weighted cross spectra and
+    /// runs a single inverse transform, and neither kernel de-interleaves the inputs.
+    /// @param a First feature matrix (reference), a.size() / dims frames
+    /// @param b Second feature matrix (target), b.size() / dims frames
+    /// @param dims Values per frame
+    /// @param maxLag Largest absolute lag to evaluate, in frames
+    /// @param layout Storage order shared by both matrices
+    /// @param weights One weight per dimension (empty = uniform); normalized to sum to 1
+    /// @param mode Kernel selection (default: automatic)
+    /// @param cacheA Optional transform cache for every dimension of `a`; must always be used with the same `a`
+    /// @return 2*W+1 values over frames with W = lagWindow(framesA, framesB, maxLag); index k holds lag k-W
+    std::vector<double> crossCorrelateMultichannel(const std::vector<float>& a,
+                                                   const std::vector<float>& b,
+                                                   size_t dims,
+                                                   size_t maxLag,
+                                                   Layout layout = Layout::FrameMajor,
+                                                   const std::vector<double>& weights = {},
+                                                   Mode mode = Mode::Auto,
+                                                   SpectrumCache* cacheA = nullptr) const;
+
+    /// Weighted multichannel correlation of two feature matrices (rows may be padded)
+    /// @param a Reference matrix
+    /// @param b Target matrix with the same number of dimensions
+    /// @see crossCorrelateMultichannel(const std::vector<float>&, const std::vector<float>&, size_t, size_t, Layout, const std::vector<double>&, Mode, SpectrumCache*)
+    std::vector<double> crossCorrelateMultichannel(const FeatureMatrix& a,
+                                                   const FeatureMatrix& b,
+                                                   size_t maxLag,
+                                                   const std::vector<double>& weights = {},
+                                                   Mode mode = Mode::Auto,
+                                                   SpectrumCache* cacheA = nullptr) const;
+
+    /// Compute cross-correlation over an arbitrary contiguous lag range
+    /// Meant for narrow refinement windows around a known candidate, so it always
+    /// runs the direct kernel. Lags without overlap produce 0.
+    /// @param a First feature vector (reference)
+    /// @param b Second feature vector (target)
+    /// @param firstLag Smallest lag to evaluate, in frames
+    /// @param lastLag Largest lag to evaluate, in frames (>= firstLag)
+    /// @return lastLag-firstLag+1 values; index k holds lag firstLag+k
+    std::vector<double> crossCorrelateRange(const std::vector<float>& a,
+                                            const std::vector<float>& b,
+                                            int64_t firstLag,
+                                            int64_t lastLag) const;
+
+    /// Generalized cross-correlation with phase transform (GCC-PHAT)
+    /// Every frequency bin of the cross spectrum is whitened to unit magnitude, so
+    /// broadband signals produce a sharp peak at the true lag regardless of their
+    /// spectral colour. Used on short raw-sample segments to refine feature offsets.
+    /// @param a First signal (reference)
+    /// @param b Second signal (target)
+    /// @param maxLag Largest absolute lag to evaluate, in samples
+    /// @return 2*W+1 values with W = lagWindow(N, M, maxLag); index k holds lag k-W
+    std::vector<double> crossCorrelatePHAT(const std::vector<float>& a,
+                                           const std::vector<float>& b,
+                                           size_t maxLag) const;
+
+    /// Uniformly partitioned FFT correlation over lags [-W, +W], W = lagWindow(N, M, maxLag)
+    /// Reference and target are cut into segments transformed once each at
+    /// 2 * partitionLength points (overlap-save). The reference partitions are visited in
+    /// turn against a frequency-domain delay line of the target segments they meet, and
+    /// the cross spectra are summed per block of partitionLength lags; one inverse per
+    /// block then hands the normalized scores to the sink. Working memory is about 8W
+    /// values, whatever the input lengths; with cacheA the reference partition spectra
+    /// (about 2N values) are kept in the cache for the next target.
+    /// Produces the values of crossCorrelate(a, b, maxLag) up to rounding.
+    /// @param a First feature vector (reference)
+    /// @param b Second feature vector (target)
+    /// @param maxLag Largest absolute lag to evaluate, in frames
+    /// @param partitionLength Frames per partition and lags per block (power of two >= 2)
+    /// @param sink Called with 2*W+1 values in total, in blocks of at most partitionLength
+    /// @param cacheA Optional transform cache for `a`; must always be used with the same `a`
+    /// @throws std::invalid_argument if partitionLength is not a supported power of two
+    void crossCorrelatePartitioned(const std::vector<float>& a,
+                                   const std::vector<float>& b,
+                                   size_t maxLag,
+                                   size_t partitionLength,
+                                   const LagSink& sink,
+                                   SpectrumCache* cacheA = nullptr) const;
+
+    /// Partition length that keeps a correlation within a working memory budget
+    /// Counts the buffers and lag output of the whole-signal kernel crossCorrelate
+    /// would run, and of the partitioned kernel at each partition length.
+    /// @param budgetBytes Working memory allowed for one correlation (0 = no limit)
+    /// @return 0 if the whole-signal kernel fits the budget or partitioning would not
+    ///         save memory, else the largest partition length within the budget (at
+    ///         least the smallest supported one)
+    static size_t partitionLengthForBudget(size_t lengthA, size_t lengthB, size_t maxLag,
+                                           size_t budgetBytes, Precision precision = Precision::Double);
+
+    /// Working memory of one correlation, as partitionLengthForBudget counts it
+    /// @param partitionLength Partition length of the partitioned kernel (0 = whole-signal kernel)
+    static size_t workingBytes(size_t lengthA, size_t lengthB, size_t maxLag, size_t partitionLength = 0,
+                               Precision precision = Precision::Double);
+
+    /// Effective half-width of the lag window for the given lengths
+    /// @return min(maxLag, min(N,M)-1), or 0 if either length is 0
+    static size_t lagWindow(size_t lengthA, size_t lengthB, size_t maxLag = UNBOUNDED_LAG);
+
+    /// Check whether the automatic mode selects the FFT kernel for these lengths
+    /// @param lengthA Length of the first feature vector
+    /// @param lengthB Length of the second feature vector
+    /// @param maxLag Largest absolute lag that will be evaluated
+    /// @return True if the FFT kernel is expected to be cheaper
+    static bool shouldUseFFT(size_t lengthA, size_t lengthB, size_t maxLag = UNBOUNDED_LAG);
+
+private:
+    // MARK: - Private Members
+
+    /// FFT plan and working buffers of the frequency-domain kernels at one precision
+    template <typename T>
+    struct Workspace {
+        std::shared_ptr<const DSP::RealFFT<T>> fft;  // Shared plan, regrown on demand
+        std::vector<T> paddedBuffer;
+        std::vector<T> spectrumA;              // Split complex halves
+        std::vector<T> spectrumB;
+        std::vector<T> spectrumSum;
+        std::vector<T> delayLine;              // Target segment spectra of the partitioned kernel
+    };
+
+    mutable Workspace<double> doubleWorkspace;
+    mutable Workspace<float> singleWorkspace;
+    Precision precision = Precision::Double;
+
+    // MARK: - Private Methods
+
+    /// Time-domain kernel over lags [firstLag, firstLag + correlation.size())
+    void correlateDirect(const float* a, size_t lengthA,
+                         const float* b, size_t lengthB,
+                         int64_t firstLag,
+                         std::vector<double>& correlation) const;
+
+    /// Frequency-domain kernel over lags [-window, +window]
+    template <typename T>
+    void correlateFFT(Workspace<T>& work,
+                      const float* a, size_t lengthA,
+                      const float* b, size_t lengthB,
+                      size_t window,
+                      SpectrumCache* cacheA,
+                      std::vector<double>& correlation) const;
+
+    /// Strided read-only view of one multichannel operand
+    struct ChannelView {
+        const float* values;
+        size_t frames;
+        size_t frameStride;  // Distance between consecutive frames of one dimension
+        size_t dimStride;    // Distance between dimensions of one frame
+    };
+
+    /// Validate weights, pick a kernel and run it
+    std::vector<double> correlateMultichannel(const ChannelView& a, const ChannelView& b, size_t dims,
+                                              size_t maxLag, const std::vector<double>& weights,
+                                              Mode mode, SpectrumCache* cacheA) const;
+
+    /// Time-domain multichannel kernel over lags [-window, +window]
+    void correlateDirectMultichannel(const ChannelView& a, const ChannelView& b, size_t dims,
+                                     const std::vector<double>& weights,
+                                     size_t window,
+                                     std::vector<double>& correlation) const;
+
+    /// Frequency-domain multichannel kernel over lags [-window, +window]
+    template <typename T>
+    void correlateFFTMultichannel(Workspace<T>& work,
+                                  const ChannelView& a, const ChannelView& b, size_t dims,
+                                  const std::vector<double>& weights,
+                                  size_t window,
+                                  SpectrumCache* cacheA,
+                                  std::vector<double>& correlation) const;
+
+    /// Partitioned frequency-domain kernel over lags [-window, +window], streamed to sink
+    template <typename T>
+    void correlatePartitioned(Workspace<T>& work,
+                              const float* a, size_t lengthA,
+                              const float* b, size_t lengthB,
+                              size_t window, size_t partitionLength,
+                              SpectrumCache* cacheA,
+                              const LagSink& sink) const;
+
+    /// Phase-transform kernel over lags [-window, +window]
+    void correlatePHAT(const float* a, size_t lengthA,
+                       const float* b, size_t lengthB,
+                       size_t window,
+                       std::vector<double>& correlation) const;
+
+    /// Transform a zero-padded real signal into the packed split complex buffer
+    /// @param stride Distance between consecutive input values (one column of a frame-major matrix)
+    template <typename T>
+    void forwardTransform(Workspace<T>& work,
+                          const float* input, size_t length, size_t fftSize,
+                          size_t log2Size, std::vector<T>& spectrum,
+                          size_t stride = 1) const;
+
+    /// Make sure the workspace's FFT setup supports transforms of 2^log2Size points
+    template <typename T>
+    void ensureFFTSetup(Workspace<T>& work, size_t log2Size) const;
+};
+
+} // namespace HarmoniqSync
+
+#endif /* CORRELATION_ENGINE_HPP */
@@ -0,0 +1,152 @@
+//
+//  cost_model.hpp
+//  HarmoniqSyncCore
+//
+//  Calibrated time and memory predictions for alignment jobs
+//
+
+#ifndef COST_MODEL_HPP
+#define COST_MODEL_HPP
+
+#include "harmoniq_sync.h"
+#include "stage_profiler.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Predicts the time and memory an alignment job needs on one class of machine.
+/// Every pipeline stage has a work measure derived from the job the same way the
+/// engine sizes its buffers and picks its kernels: samples for loading and
+/// decimation, frames x window x log2(window) for the STFT, the direct or FFT
+/// cost CorrelationEngine would choose for correlation, lag counts for peak
+/// picking and scoring. Seconds per unit of work are fitted per method and stage
+/// from measured StageProfiles, and the spread of the measured wall times around
+/// the fit gives a confidence bound. A profile of coefficients can be saved per
+/// machine class and loaded at start-up; harmoniq_bench --calibrate writes one.
+class CostModel {
+public:
+    /// Number of methods with their own coefficients (the four singles and hybrid)
+    static constexpr size_t METHOD_COUNT = PROFILED_METHOD_COUNT + 1;
+
+    /// The parameters an alignment cost depends on
+    struct Job {
+        harmoniq_sync_method_t method = HARMONIQ_SYNC_SPECTRAL_FLUX;
+        size_t referenceSamples = 0;
+        size_t targetSamples = 0;
+        double sampleRate = 44100.0;
+        int windowSize = 1024;
+        int hopSize = 256;                // 0 = windowSize / 4
+        int64_t maxOffsetSamples = 0;     // 0 = every overlapping lag
+        double analysisSampleRate = 0.0;  // 0 = analyse at the input rate
+        int coarseHopSize = 0;            // Coarse-to-fine search hop (0 = single resolution)
+        bool driftCorrection = false;
+        size_t correlationMemoryBytes = 0; // Scalar correlations above this stream lags in partitions (0 = no limit)
+
+        /// Job for one alignment with a C configuration
+        static Job fromConfig(const harmoniq_sync_config_t& config, harmoniq_sync_method_t method,
+                              size_t referenceSamples, size_t targetSamples, double sampleRate);
+    };
+
+    /// Work units per stage and the storage a job holds at its peak
+    struct Work {
+        std::array<double, PROCESSING_STAGE_COUNT> units{};
+        double featureBytes = 0.0;  // Spectrograms and feature streams (what StageProfile tracks)
+        double bufferBytes = 0.0;   // Input samples, decimated copies and correlation buffers
+    };
+
+    /// Fitted coefficients of one method
+    struct Coefficients {
+        std::array<double, PROCESSING_STAGE_COUNT> secondsPerUnit{};
+        double wallFactor = 1.0;    // Wall time over summed stage time (parallel stages run concurrently)
+        double logError = 0.25;     // Standard deviation of log(measured / predicted) wall time
+        double memoryFactor = 1.0;  // Largest measured over predicted feature bytes
+        size_t samples = 0;         // Calibration runs behind the coefficients (0 = built-in)
+    };
+
+    struct Prediction {
+        std::array<double, PROCESSING_STAGE_COUNT> stageSeconds{};
+        double seconds = 0.0;        // Expected wall time
+        double upperSeconds = 0.0;   // Wall time not exceeded at the requested confidence
+        size_t peakBytes = 0;        // Peak memory held by the job
+    };
+
+    struct Admission {
+        bool admitted = false;       // Meets the deadline and fits the memory budget
+        bool meetsDeadline = false;
+        bool fitsMemory = false;
+        double onTimeProbability = 0.0;  // Probability of finishing before the deadline
+        Prediction prediction;
+    };
+
+    /// One measured run for calibration
+    struct Sample {
+        Job job;
+        StageProfile stages;   // Stage seconds and peak feature bytes of the run
+        double wallSeconds = 0.0;
+    };
+
+    // MARK: - Lifecycle
+
+    /// Built-in coefficients, measured on the reference development machine
+    CostModel();
+
+    // MARK: - Prediction
+
+    /// Work a job performs in each stage
+    static Work measureWork(const Job& job);
+
+    /// Expected time and memory of a job
+    /// @param confidence Probability that the wall time stays below upperSeconds (0.5 .. 0.9999)
+    Prediction predict(const Job& job, double confidence = 0.95) const;
+
+    /// Decide whether a job can run within a deadline and a memory budget
+    /// @param deadlineSeconds Wall time available (<= 0 = no deadline)
+    /// @param memoryBudgetBytes Memory available (0 = no limit)
+    /// @param confidence Required probability of meeting the deadline
+    Admission admit(const Job& job, double deadlineSeconds, size_t memoryBudgetBytes,
+                    double confidence = 0.95) const;
+
+    // MARK: - Calibration
+
+    /// Fit coefficients to measured runs
+    /// Stages and methods the samples do not exercise keep their current coefficients.
+    /// @param samples Successful runs, ideally spanning the lengths and settings to be predicted
+    /// @param machineClass Name stored with the profile
+    void calibrate(const std::vector<Sample>& samples, const std::string& machineClass);
+
+    // MARK: - Profiles
+
+    /// Write the coefficients as a text profile
+    /// @return False if the file cannot be written
+    bool save(const std::string& path) const;
+
+    /// Replace the coefficients with a profile written by save()
+    /// @return False if the file cannot be read or is not a cost profile; the model is then unchanged
+    bool load(const std::string& path);
+
+    // MARK: - Shared Model
+
+    /// Model used by estimators that are not given one (built-in until setShared)
+    static std::shared_ptr<const CostModel> shared();
+
+    /// Install the process-wide model (nullptr restores the built-in coefficients)
+    static void setShared(std::shared_ptr<const CostModel> model);
+
+    // MARK: - Getters
+
+    const std::string& getMachineClass() const { return machineClass_; }
+    const Coefficients& getCoefficients(harmoniq_sync_method_t method) const;
+
+private:
+    std::string machineClass_;
+    std::array<Coefficients, METHOD_COUNT> coefficients_;
+};
+
+} // namespace HarmoniqSync
+
+#endif /* COST_MODEL_HPP */
@@ -0,0 +1,69 @@
+//
+//  decimator.hpp
+//  HarmoniqSyncCore
+//
+//  Anti-aliased integer-factor decimation for reduced-rate analysis
+//
+
+#ifndef DECIMATOR_HPP
+#define DECIMATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Linear-phase FIR decimator for one integer factor.
+/// The Kaiser-windowed sinc lowpass is centred on each output sample, so
+/// output n lines up with input n * factor and offsets measured on decimated
+/// audio map back to the source rate by multiplying by the factor. Only the
+/// kept output samples are computed (polyphase via DSP::decimate). Decimators
+/// are immutable and shared across threads through get().
+class Decimator {
+public:
+    // MARK: - Lifecycle
+
+    /// Design the filter (prefer get(), which reuses decimators)
+    /// @param factor Integer decimation factor (1 = pass-through)
+    /// @throws std::invalid_argument if factor < 1
+    explicit Decimator(int factor);
+
+    /// Shared decimator for a factor, built on first use (thread-safe)
+    static std::shared_ptr<const Decimator> get(int factor);
+
+    // MARK: - Processing
+
+    /// Number of output samples for an input length: ceil(length / factor)
+    static size_t outputLength(size_t length, int factor);
+
+    /// Lowpass and downsample; samples beyond either end are treated as zeros
+    /// @param input Source samples
+    /// @param length Number of source samples
+    /// @param output outputLength(length, factor) values
+    void process(const float* input, size_t length, float* output) const;
+
+    /// Convenience overload that sizes the output vector
+    void process(const float* input, size_t length, std::vector<float>& output) const;
+
+    // MARK: - Getters
+
+    int getFactor() const { return factor_; }
+    size_t getNumTaps() const { return taps_.size(); }
+
+private:
+    // MARK: - Private Members
+
+    int factor_;
+    size_t halfLength_;         // Taps on either side of the centre tap
+    std::vector<float> taps_;   // Symmetric, unity DC gain
+
+    // MARK: - Private Methods
+
+    /// Kaiser-windowed sinc with its cutoff at the output Nyquist frequency
+    void designFilter();
+};
+
+} // namespace HarmoniqSync
+
+#endif /* DECIMATOR_HPP */
@@ -0,0 +1,175 @@
+//
+//  dsp_backend.hpp
+//  HarmoniqSyncCore
+//
+//  Vector and FFT kernels behind a backend chosen at configure time
+//
+
+#ifndef DSP_BACKEND_HPP
+#define DSP_BACKEND_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace HarmoniqSync {
+namespace DSP {
+
+/// The kernels every DSP call site in the core goes through. One backend is
+/// compiled in (HARMONIQ_DSP_BACKEND): Accelerate forwards to vDSP unchanged,
+/// Portable is a plain C++ implementation written so the compiler can
+/// vectorize it. All functions work on contiguous arrays and follow the vDSP
+/// semantics of the routine they replace, so results do not depend on the
+/// backend beyond rounding.
+
+/// Name of the compiled-in backend ("Accelerate" or "Portable")
+const char* backendName();
+
+// MARK: - Types
+
+/// Real and imaginary halves of a complex vector stored in separate arrays
+template <typename T>
+struct SplitComplex {
+    T* realp;
+    T* imagp;
+};
+
+// MARK: - Real FFT
+
+/// Radix-2 in-place real FFT plan for transforms of up to 2^maxLog2Size points.
+/// Uses the vDSP packed format: N real samples are held as N/2 complex values
+/// (even samples in realp, odd samples in imagp, see pack()). The forward
+/// transform leaves 2x the DFT bins 0..N/2-1 in place, with the purely real
+/// Nyquist bin stored in imagp[0]. The inverse takes the same layout, so a
+/// forward and inverse round trip scales the signal by 2N. Plans hold no
+/// per-call state and can be used from several threads at once.
+template <typename T>
+class RealFFT {
+public:
+    /// @param maxLog2Size Largest supported transform, as log2 of its length (>= 1)
+    /// @throws std::invalid_argument if maxLog2Size is 0
+    /// @throws std::runtime_error if the backend cannot create the plan
+    explicit RealFFT(size_t maxLog2Size);
+    ~RealFFT();
+
+    // Non-copyable but movable
+    RealFFT(const RealFFT&) = delete;
+    RealFFT& operator=(const RealFFT&) = delete;
+    RealFFT(RealFFT&& other) noexcept;
+    RealFFT& operator=(RealFFT&& other) noexcept;
+
+    size_t getMaxLog2Size() const { return maxLog2Size_; }
+
+    /// Forward transform of 2^log2Size packed real samples (1 <= log2Size <= max)
+    void forward(const SplitComplex<T>& data, size_t log2Size) const;
+
+    /// Inverse transform of a packed spectrum back to packed real samples
+    void inverse(const SplitComplex<T>& data, size_t log2Size) const;
+
+private:
+    struct Setup;
+
+    std::unique_ptr<Setup> setup_;
+    size_t maxLog2Size_;
+};
+
+extern template class RealFFT<float>;
+extern template class RealFFT<double>;
+
+/// Process-wide plan for transforms of up to at least 2^minLog2Size points.
+/// One plan per precision is kept, the largest requested so far; a request
+/// beyond it replaces the kept plan, while callers still holding the smaller
+/// one keep using it. Safe to call from any thread.
+/// @throws std::invalid_argument if minLog2Size is 0
+template <typename T>
+std::shared_ptr<const RealFFT<T>> sharedRealFFT(size_t minLog2Size);
+
+/// Split 2 * count interleaved real samples into packed form (vDSP_ctoz).
+/// The input may share storage with the split halves.
+void pack(const float* input, const SplitComplex<float>& split, size_t count);
+void pack(const double* input, const SplitComplex<double>& split, size_t count);
+
+/// Interleave count packed values back into 2 * count real samples (vDSP_ztoc)
+void unpack(const SplitComplex<float>& split, float* output, size_t count);
+void unpack(const SplitComplex<double>& split, double* output, size_t count);
+
+// MARK: - Complex Vectors
+
+/// realp^2 + imagp^2 of each element
+void squaredMagnitudes(const SplitComplex<float>& input, float* output, size_t count);
+
+/// output = conj(a) * b, element-wise; output may alias either input
+void multiplyConjugate(const SplitComplex<float>& a, const SplitComplex<float>& b,
+                       const SplitComplex<float>& output, size_t count);
+void multiplyConjugate(const SplitComplex<double>& a, const SplitComplex<double>& b,
+                       const SplitComplex<double>& output, size_t count);
+
+/// output = a + b, element-wise; output may alias either input
+void add(const SplitComplex<float>& a, const SplitComplex<float>& b,
+         const SplitComplex<float>& output, size_t count);
+void add(const SplitComplex<double>& a, const SplitComplex<double>& b,
+         const SplitComplex<double>& output, size_t count);
+
+// MARK: - Real Vectors
+
+/// output = a * b, element-wise
+void multiply(const float* a, const float* b, float* output, size_t count);
+
+/// output = input * scale
+void scale(const float* input, float scale, float* output, size_t count);
+void scale(const double* input, double scale, double* output, size_t count);
+
+/// output = input + offset
+void addScalar(const float* input, float offset, float* output, size_t count);
+
+/// output = input * scale + offset
+void scaleAdd(const float* input, float scale, float offset, float* output, size_t count);
+
+/// output = max(input, lower)
+void threshold(const float* input, float lower, float* output, size_t count);
+
+/// output = sqrt(input)
+void squareRoot(const float* input, float* output, size_t count);
+
+/// output = log10(input)
+void log10(const float* input, float* output, size_t count);
+
+// MARK: - Reductions
+
+/// Sum of the elements (0 for an empty vector)
+float sum(const float* input, size_t count);
+
+/// Sum of the squared elements
+float sumOfSquares(const float* input, size_t count);
+
+/// Arithmetic mean (count must be > 0)
+float mean(const float* input, size_t count);
+
+/// Smallest and largest element (count must be > 0)
+float minimum(const float* input, size_t count);
+float maximum(const float* input, size_t count);
+
+/// Sum of a[i] * b[i]
+float dot(const float* a, const float* b, size_t count);
+
+// MARK: - Filters and Windows
+
+/// RMS-normalized Hann window, w[i] = 0.8165 * (1 - cos(2 * pi * i / length)) (vDSP_HANN_NORM)
+void hannWindow(float* window, size_t length);
+
+/// Process-wide hannWindow coefficients of the given length, built once per length
+/// Safe to call from any thread.
+std::shared_ptr<const std::vector<float>> sharedHannWindow(size_t length);
+
+/// Decimating FIR: output[n] = sum over p of input[n * factor + p] * taps[p].
+/// The input must hold (numOutputs - 1) * factor + numTaps samples.
+void decimate(const float* input, size_t factor, const float* taps, size_t numTaps,
+              float* output, size_t numOutputs);
+
+/// Row-major matrix product: c (rows x cols) = a (rows x inner) * b (inner x cols)
+void matrixMultiply(const float* a, const float* b, float* c, size_t rows, size_t cols, size_t inner);
+
+} // namespace DSP
+} // namespace HarmoniqSync
+
+#endif /* DSP_BACKEND_HPP */
@@ -9,10 +9,14 @@
 #define ERROR_HANDLER_HPP
 
 #include "harmoniq_sync.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <map>
 #include <string>
 #include <vector>
 #include <chrono>
-#include <mutex>
 #include <memory>
 #include <functional>
 
@@ -28,6 +32,9 @@ enum class ErrorSeverity {
     Critical = 5
 };
 
+/// Number of ErrorSeverity levels
+static constexpr size_t ERROR_SEVERITY_COUNT = 6;
+
 /// Comprehensive error context with detailed information
 struct ErrorContext {
     harmoniq_sync_error_t code;
@@ -50,11 +57,34 @@ struct ErrorContext {
 };
 
 /// Error handler interface for custom error processing
+///
+/// logError never waits for another thread: events go into a fixed-capacity
+/// lock-free ring that many threads fill and one reader at a time drains into
+/// a bounded history, and the counters behind getStats() are sharded per
+/// thread. Readers (getRecentErrors, drainEvents) only contend with each other.
+/// When the ring is full the logging thread drains it itself, or retries while
+/// another thread does; an event that still finds no slot is dropped and counted.
 class ErrorHandler {
 public:
     /// Error callback function type
     using ErrorCallback = std::function<void(const ErrorContext&)>;
     
+    /// Events accepted by the ring before a reader has to drain it
+    static constexpr size_t EVENT_RING_CAPACITY = 1024;
+    
+    /// Drained events kept for getRecentErrors and drainEvents
+    static constexpr size_t EVENT_HISTORY_CAPACITY = 1000;
+    
+    /// Events that reached logError, summed over the per-thread counter shards
+    struct LogStats {
+        std::array<uint64_t, ERROR_SEVERITY_COUNT> logged{};  // Accepted events, indexed by ErrorSeverity
+        uint64_t filtered = 0;  // Below the minimum severity
+        uint64_t dropped = 0;   // Found the ring full while another thread drained it
+        
+        /// Accepted events of every severity
+        uint64_t totalLogged() const;
+    };
+    
     /// Create error context with automatic timestamp
     static ErrorContext createError(
         harmoniq_sync_error_t code,
@@ -77,9 +107,18 @@ public:
     /// Log error to all registered handlers
     static void logError(const ErrorContext& context);
     
-    /// Get recent errors (thread-safe)
+    /// Get recent errors (thread-safe), oldest first
     static std::vector<ErrorContext> getRecentErrors(size_t maxCount = 100);
     
+    /// Events logged after a cursor, oldest first, for exporters that read the log incrementally
+    /// @param cursor Events already read (0 on the first call), advanced past the returned events.
+    ///        Events that left the history before they were read are skipped.
+    static std::vector<ErrorContext> drainEvents(uint64_t& cursor,
+                                                 size_t maxCount = std::numeric_limits<size_t>::max());
+    
+    /// Counters of every event since start-up (clearErrorLog leaves them alone)
+    static LogStats getStats();
+    
     /// Clear error log
     static void clearErrorLog();
     
@@ -108,10 +147,7 @@ public:
     static std::string createOperationId();
 
 private:
-    static std::mutex errorMutex_;
-    static std::vector<ErrorContext> errorLog_;
-    static std::vector<ErrorCallback> callbacks_;
-    static ErrorSeverity minimumSeverity_;
+    static std::atomic<ErrorSeverity> minimumSeverity_;
     static std::atomic<uint64_t> operationCounter_;
 };
 
@@ -0,0 +1,97 @@
+//
+//  feature_cache.hpp
+//  HarmoniqSyncCore
+//
+//  Persistent on-disk store of prepared feature streams keyed by audio content
+//
+
+#ifndef FEATURE_CACHE_HPP
+#define FEATURE_CACHE_HPP
+
+#include "alignment_engine.hpp"
+#include "harmoniq_sync.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace HarmoniqSync {
+
+/// Directory of post-processed feature streams, one file per clip and feature settings.
+/// Files are named after a hash of the PCM and a hash of everything that shapes
+/// the features (method, window, hop, analysis rate and post-processing), so an
+/// unchanged clip is never extracted twice and a changed setting never reads stale
+/// features. Files are written to a temporary name and renamed into place, and read
+/// back through a read-only memory mapping, so one directory can be shared by any
+/// number of engines, threads and processes. The format is versioned and native-endian;
+/// files that do not match are ignored and overwritten.
+///
+/// Values are stored as float by default. The 16-bit storages halve the files and
+/// the page-cache traffic of every load; values are widened back to float when
+/// read, so only their precision changes. Each storage uses its own file names.
+class FeatureCache {
+public:
+    /// Encoding of the stored feature values
+    enum class Storage {
+        Float32,   // Exact values
+        BFloat16,  // Upper half of each float: full range, 8 significant bits
+        Int16      // Signed 16 bits of the stream's peak magnitude (per-stream scale)
+    };
+
+    /// Identifies one cache file
+    struct Key {
+        uint64_t contentHash = 0;   // hashContent() of the source clip
+        uint64_t settingsHash = 0;  // hashSettings() of the extraction settings
+    };
+
+    // MARK: - Lifecycle
+
+    /// @param directory Cache directory, created if missing
+    /// @param storage Encoding of the values this cache writes and reads
+    /// @throws std::invalid_argument if the directory is empty or cannot be created
+    explicit FeatureCache(const std::string& directory, Storage storage = Storage::Float32);
+
+    // Non-copyable (counters are shared by all users of one cache)
+    FeatureCache(const FeatureCache&) = delete;
+    FeatureCache& operator=(const FeatureCache&) = delete;
+
+    // MARK: - Keys
+
+    /// Fast 64-bit hash of the samples, their count and rate (memory bandwidth bound)
+    static uint64_t hashContent(const float* samples, size_t length, double sampleRate);
+
+    /// Hash of the configuration fields that feature preparation depends on
+    static uint64_t hashSettings(const AlignmentEngine::Config& config, harmoniq_sync_method_t method);
+
+    // MARK: - Access
+
+    /// Read features back (references are prepared again from them: no spectra or excerpts)
+    /// @return False on a miss or an unreadable or mismatched file; `features` is untouched
+    bool load(const Key& key, AlignmentEngine::ClipFeatures& features) const;
+
+    /// Write features, replacing any existing file for the key
+    /// @return False if the file could not be written (the cache is only an accelerator)
+    bool store(const Key& key, const AlignmentEngine::ClipFeatures& features) const;
+
+    /// Path of the file holding a key
+    std::string pathFor(const Key& key) const;
+
+    // MARK: - Getters
+
+    const std::string& getDirectory() const { return directory_; }
+    Storage getStorage() const { return storage_; }
+    size_t getHits() const { return hits_.load(std::memory_order_relaxed); }
+    size_t getMisses() const { return misses_.load(std::memory_order_relaxed); }
+
+private:
+    // MARK: - Private Members
+
+    std::string directory_;
+    Storage storage_;
+    mutable std::atomic<size_t> hits_{0};
+    mutable std::atomic<size_t> misses_{0};
+};
+
+} // namespace HarmoniqSync
+
+#endif /* FEATURE_CACHE_HPP */
@@ -0,0 +1,83 @@
+//
+//  feature_filters.hpp
+//  HarmoniqSyncCore
+//
+//  Allocation-free median filters, percentiles and normalization for feature streams
+//
+
+#ifndef FEATURE_FILTERS_HPP
+#define FEATURE_FILTERS_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Post-processing kernels shared by AudioProcessor, AlignmentEngine and the
+/// streaming extractor. None of them allocate per element: small median windows
+/// use fixed compare-exchange networks on the stack, larger ones a RunningMedian
+/// whose buffers are sized once, and percentiles select instead of sorting.
+class FeatureFilters {
+public:
+    // MARK: - Median Filtering
+
+    /// Median of exactly 3, 5 or 7 values via an optimal compare-exchange network
+    /// The values are reordered in place.
+    static float median3(float* values);
+    static float median5(float* values);
+    static float median7(float* values);
+
+    /// Median filter in place with a window of 2*(filterSize/2)+1 values
+    /// The first and last filterSize/2 values are left unchanged. Windows up to 7
+    /// use the networks above, larger ones a RunningMedian.
+    static void medianFilter(std::vector<float>& features, int filterSize);
+
+    /// Median of a sliding window of fixed size
+    /// Keeps the window sorted; each push replaces the oldest value, costing a
+    /// binary search and one memmove of at most windowSize values.
+    class RunningMedian {
+    public:
+        explicit RunningMedian(size_t windowSize);
+
+        /// Add a value, evicting the oldest one once the window is full
+        void push(float value);
+
+        /// Median of the values pushed so far (upper median while filling, 0 if empty)
+        float median() const;
+
+        /// Number of values currently in the window
+        size_t size() const { return count_; }
+
+        /// Discard all values, keeping the buffers
+        void clear();
+
+    private:
+        std::vector<float> ring_;    // Values in arrival order
+        std::vector<float> sorted_;  // Same values, ascending
+        size_t head_ = 0;            // Oldest value in ring_
+        size_t count_ = 0;
+    };
+
+    // MARK: - Percentiles
+
+    /// Value at rank floor(length * fraction) of the sorted data, without sorting
+    /// Short inputs use nth_element on a copy in `scratch`; long inputs are
+    /// bucketed in a histogram first so only the values of one bucket are selected.
+    /// The result is exact either way.
+    /// @param scratch Reusable buffer, resized as needed
+    /// @return 0 for empty input
+    static float percentile(const float* values, size_t length, float fraction, std::vector<float>& scratch);
+    static double percentile(const double* values, size_t length, double fraction, std::vector<double>& scratch);
+
+    /// percentile() of the absolute values
+    static double absPercentile(const double* values, size_t length, double fraction, std::vector<double>& scratch);
+
+    // MARK: - Normalization
+
+    /// Rescale to [0, 1] by the minimum and maximum (unchanged if constant)
+    static void normalizeRange(std::vector<float>& features);
+};
+
+} // namespace HarmoniqSync
+
+#endif /* FEATURE_FILTERS_HPP */
@@ -0,0 +1,116 @@
+//
+//  feature_matrix.hpp
+//  HarmoniqSyncCore
+//
+//  Contiguous, cache-line aligned frames x dims storage for feature streams
+//
+
+#ifndef FEATURE_MATRIX_HPP
+#define FEATURE_MATRIX_HPP
+
+#include "stage_profiler.hpp"
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Standard allocator returning storage aligned to `Alignment` bytes
+/// Allocations are accounted in the active StageProfile.
+template <typename T, size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t count) {
+        T* pointer = static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+        StageProfiler::recordAllocation(count * sizeof(T));
+        return pointer;
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        StageProfiler::recordDeallocation(count * sizeof(T));
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/// Row-major matrix of feature frames, one row per analysis frame.
+/// Storage starts on a 64-byte boundary so rows can be handed straight to the
+/// DSP backend kernels. Rows are `stride` values apart; extractors write dense matrices
+/// (stride == numDims), which also makes the whole buffer one flat vector.
+/// Resizing keeps the capacity, so a reused matrix stops allocating once it
+/// has seen its largest size.
+class FeatureMatrix {
+public:
+    /// Byte alignment of the first value
+    static constexpr size_t ALIGNMENT = 64;
+
+    using Storage = std::vector<float, AlignedAllocator<float, ALIGNMENT>>;
+
+    // MARK: - Lifecycle
+
+    FeatureMatrix() = default;
+
+    /// Zero-initialized matrix
+    /// @param numFrames Number of rows
+    /// @param numDims Values per frame
+    /// @param stride Distance between rows in values (0 = dense, i.e. numDims)
+    FeatureMatrix(size_t numFrames, size_t numDims, size_t stride = 0);
+
+    // MARK: - Shape
+
+    /// Reshape in place, keeping existing rows when the row layout is unchanged
+    /// @throws std::invalid_argument if stride is non-zero and smaller than numDims
+    void resize(size_t numFrames, size_t numDims, size_t stride = 0);
+
+    /// Append rows at the end and return the first of them (layout must already be set)
+    float* appendFrames(size_t count);
+
+    /// Drop all frames but keep the layout and capacity
+    void clear() { numFrames_ = 0; values_.clear(); }
+
+    /// Number of frames produced by sliding a window over a signal
+    /// @return (length - windowSize) / hopSize + 1, or 0 if the window does not fit
+    static size_t frameCount(size_t length, size_t windowSize, size_t hopSize);
+
+    // MARK: - Access
+
+    float* row(size_t frame) { return values_.data() + frame * stride_; }
+    const float* row(size_t frame) const { return values_.data() + frame * stride_; }
+
+    float* data() { return values_.data(); }
+    const float* data() const { return values_.data(); }
+
+    size_t getNumFrames() const { return numFrames_; }
+    size_t getNumDims() const { return numDims_; }
+    size_t getStride() const { return stride_; }
+    size_t size() const { return numFrames_ * numDims_; }
+    bool empty() const { return numFrames_ == 0 || numDims_ == 0; }
+    bool isDense() const { return stride_ == numDims_; }
+
+    /// Dense frame-major copy (frames x dims concatenated)
+    std::vector<float> toVector() const;
+
+private:
+    // MARK: - Private Members
+
+    Storage values_;
+    size_t numFrames_ = 0;
+    size_t numDims_ = 0;
+    size_t stride_ = 0;
+};
+
+} // namespace HarmoniqSync
+
+#endif /* FEATURE_MATRIX_HPP */
@@ -97,6 +97,9 @@ public:
     );
     
     /// Get recommended degradation for resource constraints
+    /// Admission is decided on CostModel::shared() predictions for spectral flux:
+    /// the predicted 95% time bound against maxProcessingTime and the predicted
+    /// peak memory against availableMemory.
     static DegradationResult recommendDegradation(
         const AudioQualityReport& referenceAudio,
         const AudioQualityReport& targetAudio,
@@ -154,6 +157,21 @@ public:
         double estimatedTime
     );
     
+    /// Adjust configuration until the calibrated cost model predicts it meets a deadline
+    /// Cheaper settings are tried in order of quality impact (longer hop, coarse-to-fine
+    /// search, a lower analysis rate, a shorter window) and kept cumulatively.
+    /// @param confidence Required probability of finishing within maxProcessingTime
+    /// @return First configuration whose predicted bound fits, or the cheapest one tried
+    static harmoniq_sync_config_t adjustForTimeConstraints(
+        const harmoniq_sync_config_t& baseConfig,
+        harmoniq_sync_method_t method,
+        size_t refSampleCount,
+        size_t targetSampleCount,
+        double sampleRate,
+        double maxProcessingTime,
+        double confidence = 0.95
+    );
+    
     /// Get processing quality estimate for configuration
     static double estimateQualityImpact(
         const harmoniq_sync_config_t& original,
@@ -205,11 +223,14 @@ public:
         int windowSize;
         int hopSize;
         double noiseGate;
+        int coarseHopSize;          // Coarse-to-fine pyramid hop (0 = single resolution)
+        double analysisSampleRate;  // Decimated feature rate (0 = source rate)
         double expectedSpeedup;
         double expectedAccuracyLoss;
         
         QualityLevel() : confidenceThreshold(0.7), windowSize(1024), hopSize(256),
-                        noiseGate(-40.0), expectedSpeedup(1.0), expectedAccuracyLoss(0.0) {}
+                        noiseGate(-40.0), coarseHopSize(0), analysisSampleRate(0.0),
+                        expectedSpeedup(1.0), expectedAccuracyLoss(0.0) {}
     };
     
     /// Get predefined quality levels
@@ -263,6 +284,8 @@ public:
     );
     
     /// Estimate resource requirements for configuration
+    /// Expected wall time and peak memory from CostModel::shared() for a reference
+    /// and target of audioLength samples at 44.1 kHz.
     static ResourceMonitor estimateResourceRequirements(
         const harmoniq_sync_config_t& config,
         size_t audioLength,
@@ -23,7 +23,9 @@ typedef enum {
     HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA = -2,
     HARMONIQ_SYNC_ERROR_PROCESSING_FAILED = -3,
     HARMONIQ_SYNC_ERROR_OUT_OF_MEMORY = -4,
-    HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT = -5
+    HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT = -5,
+    HARMONIQ_SYNC_ERROR_CANCELLED = -6,
+    HARMONIQ_SYNC_ERROR_TIMEOUT = -7
 } harmoniq_sync_error_t;
 
 typedef enum {
@@ -37,12 +39,16 @@ typedef enum {
 typedef struct {
     int64_t offset_samples;          // Alignment offset in samples
     double confidence;               // Confidence score [0.0, 1.0]
-    double peak_correlation;         // Maximum correlation value
-    double secondary_peak_ratio;     // Ratio of second-best to best peak
+    double peak_correlation;         // Pearson coefficient of the aligned features at the offset [-1.0, 1.0]
+    double secondary_peak_ratio;     // Best peak over second-best peak (>= 1, larger is clearer)
     double snr_estimate;            // Signal-to-noise ratio estimate (dB)
     double noise_floor_db;          // Noise floor level (dB)
     char method[32];                // Algorithm used
     harmoniq_sync_error_t error;    // Error code (0 = success)
+    double offset_samples_fractional; // Sub-sample refined offset (offset_samples is its rounded value)
+    double drift_ppm;               // Target clock drift; offset at reference sample r is offset + drift_ppm * 1e-6 * r
+    int drift_segments;             // Local alignments supporting drift_ppm (0 = drift not measured)
+    int64_t searched_offset_samples; // Every offset within +/- this many samples was searched; larger ones cannot be found
 } harmoniq_sync_result_t;
 
 typedef struct {
@@ -53,13 +59,40 @@ typedef struct {
 
 typedef struct {
     double confidence_threshold;     // Minimum confidence to accept result
-    int64_t max_offset_samples;     // Maximum search offset
+    int64_t max_offset_samples;     // Largest |offset| searched in samples (0 = a quarter of the shorter clip)
     int window_size;                // Analysis window size
     int hop_size;                   // Hop size for analysis
     double noise_gate_db;           // Noise gate threshold
     int enable_drift_correction;   // Enable drift correction (0/1)
+    int worker_count;               // Batch worker threads (0 = auto, 1 = serial)
+    int coarse_hop_size;            // Coarse-to-fine search hop in samples (0 = single resolution)
+    double analysis_sample_rate;    // Feature extraction rate in Hz, reached by integer decimation (0 = source rate)
+    int hybrid_cascade;             // Hybrid runs the cheapest methods first and stops once they agree (0/1)
+    int correlation_precision;      // Feature correlation in double (0) or single precision (1, half the memory traffic)
+    int correlation_memory_mb;      // Working memory per flux or energy correlation before lags are streamed in partitions (0 = no limit)
 } harmoniq_sync_config_t;
 
+typedef struct {
+    double total_seconds;            // Wall time of the call
+    double audio_length_seconds;     // Longest clip (batch: mean over all clips)
+    double realtime_ratio;           // total_seconds / audio_length_seconds
+    double load_seconds;             // Input validation and loading
+    double resample_seconds;         // Decimation to the analysis rate
+    double stft_seconds;             // Spectrogram frames
+    double feature_seconds;          // Flux, chroma, MFCC and energy extraction
+    double post_process_seconds;     // Feature thresholding, smoothing and normalization
+    double correlation_seconds;      // Cross-correlation kernels
+    double peak_picking_seconds;     // Best-lag search
+    double confidence_seconds;       // Confidence, SNR and noise floor scoring
+    double drift_seconds;            // Clock drift estimation
+    double refinement_seconds;       // Sample-domain offset refinement
+    double method_seconds[4];        // Correlation and scoring per method, indexed by harmoniq_sync_method_t (hybrid fills all four)
+    size_t peak_allocated_bytes;     // Peak spectrogram and feature matrix storage held at once
+    harmoniq_sync_method_t method;   // Method of the call
+    int successful;                  // Call produced a result (0/1)
+    int method_runs[4];              // Alignments per method, indexed like method_seconds (a hybrid cascade skips the methods it did not need)
+} harmoniq_sync_stats_t;
+
 // MARK: - Core Alignment Functions
 
 /// Align two audio clips using specified method
@@ -97,6 +130,20 @@ harmoniq_sync_batch_result_t harmoniq_sync_align_batch(
     const harmoniq_sync_config_t* config
 );
 
+/// Resample a target so it runs at the reference clock
+/// Uses the offset and drift of an alignment result; the output keeps offset_samples
+/// against the reference over its whole length. A result without drift copies the target.
+/// @param target_audio Target audio samples that produced the result
+/// @param target_length Number of samples in target audio
+/// @param result Alignment result for this target
+/// @param output Buffer for target_length corrected samples (must not overlap target_audio)
+/// @return Error code (HARMONIQ_SYNC_SUCCESS on success)
+harmoniq_sync_error_t harmoniq_sync_correct_drift(
+    const float* target_audio, size_t target_length,
+    const harmoniq_sync_result_t* result,
+    float* output
+);
+
 // MARK: - Configuration Management
 
 /// Create default configuration
@@ -144,6 +191,8 @@ size_t harmoniq_sync_min_audio_length(harmoniq_sync_method_t method, double samp
 // MARK: - Engine Management
 
 /// Opaque handle to sync engine instance
+/// The handle may be used from multiple threads concurrently; processing calls run
+/// in parallel and configuration changes apply to calls started afterwards.
 typedef struct harmoniq_sync_engine harmoniq_sync_engine_t;
 
 /// Create new sync engine instance
@@ -184,6 +233,294 @@ harmoniq_sync_error_t harmoniq_sync_set_engine_config(
 /// @return Current configuration
 harmoniq_sync_config_t harmoniq_sync_get_engine_config(harmoniq_sync_engine_t* engine);
 
+/// Keep prepared features on disk so unchanged clips are not extracted again
+/// Files are keyed by a hash of the PCM and of the feature settings, so a changed
+/// clip or setting never reads stale features. A directory may be shared by any
+/// number of engines and processes; deleting files at any time is safe.
+/// @param engine Sync engine instance
+/// @param directory Cache directory, created if missing (NULL or "" disables the cache)
+/// @return Error code (HARMONIQ_SYNC_ERROR_INVALID_INPUT if the directory cannot be created)
+harmoniq_sync_error_t harmoniq_sync_set_feature_cache_directory(
+    harmoniq_sync_engine_t* engine,
+    const char* directory
+);
+
+/// Encoding of the values in feature cache files
+typedef enum {
+    HARMONIQ_SYNC_FEATURE_STORAGE_FLOAT32 = 0,   // Exact values
+    HARMONIQ_SYNC_FEATURE_STORAGE_BFLOAT16 = 1,  // Half the size, 8 significant bits
+    HARMONIQ_SYNC_FEATURE_STORAGE_INT16 = 2      // Half the size, 16 bits of each stream's peak
+} harmoniq_sync_feature_storage_t;
+
+/// Keep prepared features on disk with a chosen value encoding
+/// Like harmoniq_sync_set_feature_cache_directory (which uses FLOAT32). The 16-bit
+/// storages halve the files and the memory traffic of loading them; features are
+/// read back at that precision. Files of different storages do not replace each other.
+/// @param engine Sync engine instance
+/// @param directory Cache directory, created if missing (NULL or "" disables the cache)
+/// @param storage Value encoding of the files
+/// @return Error code (HARMONIQ_SYNC_ERROR_INVALID_INPUT for an unknown storage or a directory that cannot be created)
+harmoniq_sync_error_t harmoniq_sync_set_feature_cache(
+    harmoniq_sync_engine_t* engine,
+    const char* directory,
+    harmoniq_sync_feature_storage_t storage
+);
+
+/// Get statistics of the last process call on an engine
+/// Stage times are exclusive, so nested stages are not counted twice; together they
+/// cover most of total_seconds. After a batch call the stage times sum the work of
+/// all worker threads and may exceed total_seconds.
+/// @param engine Sync engine instance
+/// @param stats Output statistics (zeroed if the engine has not processed anything)
+/// @return Error code (HARMONIQ_SYNC_SUCCESS on success)
+harmoniq_sync_error_t harmoniq_sync_get_last_stats(
+    const harmoniq_sync_engine_t* engine,
+    harmoniq_sync_stats_t* stats
+);
+
+// MARK: - Cost Prediction
+
+typedef struct {
+    double expected_seconds;         // Expected wall time of the alignment
+    double upper_seconds;            // Wall time not exceeded at the requested confidence
+    double on_time_probability;      // Probability of finishing before the deadline
+    size_t peak_bytes;               // Peak memory held by the alignment
+    int admitted;                    // Meets the deadline and fits the memory budget (0/1)
+    double stage_seconds[10];        // Expected seconds per stage, ordered like the stage fields of harmoniq_sync_stats_t
+} harmoniq_sync_cost_estimate_t;
+
+/// Replace the built-in cost coefficients with a profile calibrated for this machine class
+/// Profiles are written by harmoniq_bench --calibrate; the profile applies to every engine
+/// that has no model of its own.
+/// @param path Profile file (NULL restores the built-in coefficients)
+/// @return HARMONIQ_SYNC_SUCCESS, or HARMONIQ_SYNC_ERROR_INVALID_INPUT if the file is not a cost profile
+harmoniq_sync_error_t harmoniq_sync_load_cost_profile(const char* path);
+
+/// Predict the time and memory of aligning two clips with the engine's configuration
+/// and decide whether the alignment fits a deadline and a memory budget
+/// @param engine Sync engine instance
+/// @param ref_count Number of samples in reference audio
+/// @param target_count Number of samples in target audio
+/// @param sample_rate Sample rate of both clips
+/// @param method Alignment method to predict
+/// @param deadline_seconds Wall time available (<= 0 = no deadline)
+/// @param memory_budget_bytes Memory available (0 = no limit)
+/// @param confidence Required probability of meeting the deadline (0.5 .. 0.9999)
+/// @param estimate Output estimate
+/// @return Error code (HARMONIQ_SYNC_SUCCESS on success)
+harmoniq_sync_error_t harmoniq_sync_estimate_cost(
+    const harmoniq_sync_engine_t* engine,
+    size_t ref_count, size_t target_count,
+    double sample_rate,
+    harmoniq_sync_method_t method,
+    double deadline_seconds,
+    size_t memory_budget_bytes,
+    double confidence,
+    harmoniq_sync_cost_estimate_t* estimate
+);
+
+// MARK: - Asynchronous Processing
+
+/// Opaque handle to a synchronization running on the internal thread pool
+typedef struct harmoniq_sync_operation harmoniq_sync_operation_t;
+
+/// Completion callback, called once on a pool thread after an operation finishes
+/// The result is only valid during the call. The callback may wait on the operation,
+/// which returns at once, and may release it.
+/// @param operation Operation that finished
+/// @param result Final result (error is CANCELLED or TIMEOUT if the operation was stopped)
+/// @param user_data User data passed to harmoniq_sync_process_async
+typedef void (*harmoniq_sync_completion_callback_t)(
+    harmoniq_sync_operation_t* operation,
+    const harmoniq_sync_result_t* result,
+    void* user_data
+);
+
+/// Start harmoniq_sync_process without blocking the caller
+/// The engine and both sample buffers must stay valid until the operation finishes, that
+/// is until harmoniq_sync_wait returns or the callback is called; they may be released
+/// from the callback. user_data must stay valid until the callback returns, which can be
+/// after harmoniq_sync_wait has returned.
+/// Cancellation and the timeout are honoured within one analysis frame or block of
+/// correlation lags.
+/// @param engine Sync engine instance
+/// @param reference_samples Reference audio samples (mono, float)
+/// @param ref_count Number of samples in reference audio
+/// @param target_samples Target audio samples (mono, float)
+/// @param target_count Number of samples in target audio
+/// @param timeout_seconds Limit counted from this call (0 = no limit)
+/// @param callback Completion callback (may be NULL)
+/// @param user_data Passed to the callback
+/// @return Operation handle to release with harmoniq_sync_release_operation, or NULL on invalid input
+harmoniq_sync_operation_t* harmoniq_sync_process_async(
+    harmoniq_sync_engine_t* engine,
+    const float* reference_samples, size_t ref_count,
+    const float* target_samples, size_t target_count,
+    double timeout_seconds,
+    harmoniq_sync_completion_callback_t callback,
+    void* user_data
+);
+
+/// Request cancellation of a running operation
+/// The operation completes with HARMONIQ_SYNC_ERROR_CANCELLED unless it already finished.
+/// @param operation Operation handle
+/// @return Error code
+harmoniq_sync_error_t harmoniq_sync_cancel(harmoniq_sync_operation_t* operation);
+
+/// Block until an operation finishes
+/// @param operation Operation handle
+/// @param result Output sync result (may be NULL)
+/// @return Error code of the operation's result
+harmoniq_sync_error_t harmoniq_sync_wait(harmoniq_sync_operation_t* operation, harmoniq_sync_result_t* result);
+
+/// Release an operation handle
+/// Does not cancel or wait: a running operation still completes and calls its callback.
+/// @param operation Operation handle (may be NULL)
+void harmoniq_sync_release_operation(harmoniq_sync_operation_t* operation);
+
+// MARK: - Reference Fingerprints
+
+/// Opaque handle to a precomputed reference clip
+/// Holds the extracted, normalized reference features so that matching one
+/// master track against many clips pays the reference cost only once.
+/// The handle may be used from multiple threads concurrently.
+typedef struct harmoniq_sync_reference harmoniq_sync_reference_t;
+
+/// Extract reference features for repeated alignment
+/// @param reference_audio Reference audio samples (mono, float); not retained
+/// @param ref_length Number of samples in reference audio
+/// @param sample_rate Sample rate of the reference
+/// @param method Alignment method the reference is prepared for
+/// @param config Configuration parameters (NULL = defaults), captured at creation
+/// @return Reference handle or NULL on failure
+harmoniq_sync_reference_t* harmoniq_sync_create_reference(
+    const float* reference_audio, size_t ref_length,
+    double sample_rate,
+    harmoniq_sync_method_t method,
+    const harmoniq_sync_config_t* config
+);
+
+/// Destroy reference handle
+/// @param reference Reference handle to destroy
+void harmoniq_sync_destroy_reference(harmoniq_sync_reference_t* reference);
+
+/// Align a target clip against a precomputed reference
+/// @param reference Reference handle
+/// @param target_audio Target audio samples (mono, float)
+/// @param target_length Number of samples in target audio
+/// @param sample_rate Sample rate of the target (must match the reference)
+/// @return Alignment result with offset and confidence metrics
+harmoniq_sync_result_t harmoniq_sync_align_with_reference(
+    const harmoniq_sync_reference_t* reference,
+    const float* target_audio, size_t target_length,
+    double sample_rate
+);
+
+/// Align multiple target clips against a precomputed reference
+/// @param reference Reference handle
+/// @param target_audios Array of pointers to target audio data
+/// @param target_lengths Array of target audio lengths
+/// @param target_count Number of target clips
+/// @param sample_rate Sample rate for all targets (must match the reference)
+/// @return Batch result with all alignment results, in input order
+harmoniq_sync_batch_result_t harmoniq_sync_align_batch_with_reference(
+    const harmoniq_sync_reference_t* reference,
+    const float** target_audios, const size_t* target_lengths, size_t target_count,
+    double sample_rate
+);
+
+// MARK: - Clip Grouping
+
+typedef struct {
+    int64_t timeline_offset_samples;    // Start of the clip on its group's timeline (earliest clip of a group at 0)
+    double timeline_offset_fractional;  // Unrounded timeline_offset_samples
+    int group;                          // Clips with the same group share a timeline
+    int pair_count;                     // Verified pairs placing the clip (0 = matched no other clip)
+} harmoniq_sync_clip_placement_t;
+
+typedef struct {
+    harmoniq_sync_clip_placement_t* placements;  // One per clip, in input order
+    size_t count;
+    size_t group_count;
+    harmoniq_sync_error_t error;
+} harmoniq_sync_grouping_result_t;
+
+/// Sort clips from several recorders into groups that share a timeline
+/// One landmark index over all clips proposes the pairs that share most fingerprints;
+/// only those are verified by dense alignment, and the verified offsets are fitted to
+/// one start position per clip, so the cost grows with the number of clips rather
+/// than with the number of pairs. Clips are prepared and pairs verified in parallel.
+/// @param clip_audios Array of pointers to clip audio data (mono, float)
+/// @param clip_lengths Array of clip lengths
+/// @param clip_count Number of clips
+/// @param sample_rate Sample rate for all clips
+/// @param config Configuration parameters (NULL = defaults). Unlike pairwise alignment, which searches
+///               a quarter of the shorter clip when max_offset_samples is 0, grouping then searches every overlap
+/// @return Placements of all clips; free with harmoniq_sync_free_grouping_result
+harmoniq_sync_grouping_result_t harmoniq_sync_group_clips(
+    const float** clip_audios, const size_t* clip_lengths, size_t clip_count,
+    double sample_rate,
+    const harmoniq_sync_config_t* config
+);
+
+/// Free grouping results
+/// @param grouping_result Grouping result to free
+void harmoniq_sync_free_grouping_result(harmoniq_sync_grouping_result_t* grouping_result);
+
+// MARK: - Live Tracking
+
+/// Opaque handle to a live tracker following several feeds against feed 0
+/// Buffers are allocated at creation; pushing audio never allocates or locks.
+typedef struct harmoniq_sync_tracker harmoniq_sync_tracker_t;
+
+typedef struct {
+    int valid;                      // Nonzero once the window is filled and the peak is strong enough
+    double offset_samples;          // Content at reference sample r is at feed sample r + offset_samples
+    double confidence;              // Normalized peak correlation [0.0, 1.0]
+    double secondary_peak_ratio;    // Best peak over second-best peak (>= 1, larger is clearer)
+    double drift_ppm;               // Offset change per reference sample, parts per million
+    int drift_points;               // Estimates behind drift_ppm (0 = drift not measured yet)
+    double time_seconds;            // Reference time the estimate was made at
+} harmoniq_sync_live_estimate_t;
+
+/// Create a live tracker
+/// @param sample_rate Sample rate of all feeds
+/// @param feed_count Number of feeds including the reference feed 0 (>= 2)
+/// @param window_seconds Audio correlated for each estimate (0 = default 8 s)
+/// @param max_lag_seconds Largest offset tracked in either direction (0 = default 1 s)
+/// @param update_interval_ms Time between estimates (0 = default 100 ms)
+/// @return Tracker handle or NULL on failure
+harmoniq_sync_tracker_t* harmoniq_sync_create_tracker(
+    double sample_rate, size_t feed_count,
+    double window_seconds, double max_lag_seconds, double update_interval_ms
+);
+
+/// Destroy tracker handle
+/// @param tracker Tracker handle to destroy
+void harmoniq_sync_destroy_tracker(harmoniq_sync_tracker_t* tracker);
+
+/// Push a block of one feed's audio; safe to call from a real-time audio thread
+/// @param tracker Tracker handle
+/// @param feed Feed index (0 = reference)
+/// @param samples Audio samples (mono, float)
+/// @param length Number of samples
+/// @return HARMONIQ_SYNC_SUCCESS, or HARMONIQ_SYNC_ERROR_INVALID_INPUT if the block was rejected
+harmoniq_sync_error_t harmoniq_sync_tracker_push(
+    harmoniq_sync_tracker_t* tracker, size_t feed,
+    const float* samples, size_t length
+);
+
+/// Read the latest estimate of a feed
+/// One thread may read estimates while another pushes audio.
+/// @param tracker Tracker handle
+/// @param feed Feed index (>= 1)
+/// @param estimate Output estimate
+/// @return HARMONIQ_SYNC_SUCCESS or HARMONIQ_SYNC_ERROR_INVALID_INPUT
+harmoniq_sync_error_t harmoniq_sync_tracker_get_estimate(
+    harmoniq_sync_tracker_t* tracker, size_t feed,
+    harmoniq_sync_live_estimate_t* estimate
+);
+
 // MARK: - Version Information
 
 /// Get library version string
@@ -9,6 +9,8 @@
 #define INPUT_VALIDATOR_HPP
 
 #include "harmoniq_sync.h"
+#include "audio_processor.hpp"
+#include "audio_statistics.hpp"
 #include "error_handler.hpp"
 #include <vector>
 #include <string>
@@ -88,6 +90,8 @@ public:
     );
     
     /// Perform comprehensive audio quality analysis
+    /// One fused pass gathers every sample statistic; the spectral centroid is
+    /// estimated from the zero-crossing rate (exact for a pure tone).
     static AudioQualityReport analyzeAudioQuality(
         const float* audioData,
         size_t sampleCount,
@@ -95,6 +99,24 @@ public:
         const std::string& audioName = "audio"
     );
     
+    /// Quality analysis of loaded audio
+    /// Reuses the statistics the processor gathered while loading and takes the
+    /// spectral centroid from its cached spectrogram when one exists.
+    static AudioQualityReport analyzeAudioQuality(
+        const AudioProcessor& audio,
+        const std::string& audioName = "audio"
+    );
+    
+    /// Quality report from measured statistics
+    /// @param spectrogram Spectrogram of the same audio for the spectral centroid
+    ///                    (nullptr = zero-crossing estimate)
+    static AudioQualityReport analyzeAudioQuality(
+        const AudioStatistics& statistics,
+        double sampleRate,
+        const std::string& audioName = "audio",
+        const Spectrogram* spectrogram = nullptr
+    );
+    
     /// Check if audio has sufficient content for synchronization
     static bool hasSufficientContent(
         const AudioQualityReport& report,
@@ -163,6 +185,7 @@ public:
     // MARK: - Performance Estimation
     
     /// Estimate processing time for given parameters
+    /// Expected wall time from CostModel::shared() for a reference and target of the given length.
     static double estimateProcessingTime(
         size_t audioLengthSamples,
         double sampleRate,
@@ -171,6 +194,7 @@ public:
     );
     
     /// Estimate memory usage for processing
+    /// Peak bytes CostModel::shared() predicts for hybrid alignment, the largest of any method.
     static size_t estimateMemoryUsage(
         size_t refSampleCount,
         size_t targetSampleCount,
@@ -191,6 +215,7 @@ public:
         double maxSilenceRatio = 0.9;       // 90% silence max
         double minDynamicRange = 12.0;      // 12dB minimum
         double maxClippingRatio = 0.05;     // 5% clipping max
+        double clippingLevel = 0.95;        // Fraction of full scale counted as clipped
         
         // Configuration limits
         double minConfidenceThreshold = 0.0;
@@ -217,34 +242,19 @@ private:
     
     // MARK: - Internal Analysis Functions
     
-    /// Calculate RMS level
-    static double calculateRMSLevel(const float* audioData, size_t sampleCount);
+    /// Sample statistics at the configured silence and clipping thresholds, in one pass
+    static AudioStatistics measureAudio(const float* audioData, size_t sampleCount);
     
-    /// Calculate peak level
-    static double calculatePeakLevel(const float* audioData, size_t sampleCount);
-    
-    /// Calculate silence ratio
-    static double calculateSilenceRatio(
-        const float* audioData, 
-        size_t sampleCount,
-        double silenceThreshold
-    );
-    
-    /// Calculate clipping ratio
-    static double calculateClippingRatio(
+    /// Check the pointer, length and sample rate of a clip without reading its samples
+    static ErrorContext validateAudioParameters(
         const float* audioData,
         size_t sampleCount,
-        double clippingThreshold = 0.95
+        double sampleRate,
+        const std::string& audioName
     );
     
-    /// Calculate spectral centroid
-    static double calculateSpectralCentroid(const float* audioData, size_t sampleCount);
-    
-    /// Calculate zero crossing rate
-    static double calculateZeroCrossingRate(const float* audioData, size_t sampleCount);
-    
-    /// Check if signal is monotonic (constant)
-    static bool isMonotonic(const float* audioData, size_t sampleCount, double threshold = 0.001);
+    /// Check measured statistics for NaN or infinite samples
+    static ErrorContext validateSamples(const AudioStatistics& statistics, const std::string& audioName);
     
     /// Generate quality recommendations
     static std::vector<std::string> generateRecommendations(const AudioQualityReport& report);
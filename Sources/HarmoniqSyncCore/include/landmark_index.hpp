@@ -0,0 +1,107 @@
+//
+//  landmark_index.hpp
+//  HarmoniqSyncCore
+//
+//  Onset-pair fingerprints and an inverted index for offset voting
+//
+
+#ifndef LANDMARK_INDEX_HPP
+#define LANDMARK_INDEX_HPP
+
+#include "audio_processor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Sparse fingerprints for locating a short clip inside long recordings.
+/// A landmark pairs an onset with one of the onsets that follow it and hashes the
+/// dominant frequency band at both onsets together with the frame distance between
+/// them. Recordings of the same event share landmarks at a constant frame offset, so
+/// looking the landmarks of a target up in an index of reference landmarks and voting
+/// on the offsets they imply finds the alignment in time proportional to the number
+/// of landmarks instead of the number of lags. The index is immutable once built and
+/// can be queried from several threads at once.
+class LandmarkIndex {
+public:
+    /// Shape of the fingerprints (index and query landmarks must use the same settings)
+    struct Settings {
+        size_t fanOut = 4;           // Following onsets each onset is paired with
+        int maxPairFrames = 64;      // Longest frame distance inside one pair (at most 1023)
+        int numBands = 32;           // Logarithmic bands between minFrequency and maxFrequency (at most 32)
+        double minFrequency = 150.0;
+        double maxFrequency = 8000.0;  // Clamped to the clip's Nyquist frequency
+        size_t maxPostings = 256;    // Hashes stored more often than this (all clips) are too common to vote
+    };
+
+    /// One fingerprint: a hash and the frame of its first onset
+    struct Landmark {
+        uint32_t hash;
+        uint32_t frame;
+    };
+
+    /// Offset supported by the landmarks of a query
+    struct Match {
+        size_t clip;           // Index of the indexed clip
+        int64_t offsetFrames;  // Query frame minus clip frame of the agreeing landmarks
+        size_t votes;          // Landmarks agreeing within the vote tolerance
+    };
+
+    // MARK: - Fingerprints
+
+    /// Landmarks from a clip's onsets
+    /// The band of an onset is the strongest band of a ~46 ms window starting at the
+    /// onset frame, so bands are comparable between clips at different sample rates.
+    /// @param onsets Ascending onset frames
+    /// @param audio Source clip the onsets were detected in
+    /// @param hopSize Source samples per onset frame
+    /// @return Landmarks in ascending frame order
+    static std::vector<Landmark> extractLandmarks(const std::vector<size_t>& onsets,
+                                                  const AudioProcessor& audio,
+                                                  int hopSize,
+                                                  const Settings& settings);
+
+    // MARK: - Lifecycle
+
+    /// Index the landmarks of one or more clips (clip ids are positions in `clips`)
+    explicit LandmarkIndex(const std::vector<std::vector<Landmark>>& clips, const Settings& settings);
+
+    // MARK: - Query
+
+    /// Strongest offsets between a query and the indexed clips, most votes first
+    /// Matches on one clip are more than 2 * `toleranceFrames` apart, so they share no votes.
+    /// @param landmarks Landmarks of the query clip (same Settings)
+    /// @param maxMatches Matches returned at most
+    /// @param toleranceFrames Offsets this close to each other vote together
+    /// @param minVotes Offsets with fewer votes are not returned
+    std::vector<Match> query(const std::vector<Landmark>& landmarks, size_t maxMatches,
+                             int toleranceFrames = 1, size_t minVotes = 2) const;
+
+    // MARK: - Getters
+
+    const Settings& getSettings() const { return settings_; }
+    size_t getClipCount() const { return clipLandmarks_.size(); }
+    size_t getLandmarkCount() const { return postings_.size(); }
+
+    /// Landmarks stored for one clip
+    size_t getLandmarkCount(size_t clip) const { return clipLandmarks_.at(clip); }
+
+private:
+    /// Entry of the inverted index
+    struct Posting {
+        uint32_t hash;
+        uint32_t clip;
+        uint32_t frame;
+    };
+
+    // MARK: - Private Members
+
+    Settings settings_;
+    std::vector<Posting> postings_;      // Sorted by hash, then clip and frame
+    std::vector<size_t> clipLandmarks_;  // Landmarks per clip
+};
+
+} // namespace HarmoniqSync
+
+#endif /* LANDMARK_INDEX_HPP */
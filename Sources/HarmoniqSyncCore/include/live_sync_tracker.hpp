@@ -0,0 +1,209 @@
+//
+//  live_sync_tracker.hpp
+//  HarmoniqSyncCore
+//
+//  Continuous offset and drift tracking of live feeds with bounded latency
+//
+
+#ifndef LIVE_SYNC_TRACKER_HPP
+#define LIVE_SYNC_TRACKER_HPP
+
+#include "spectrum_kernel.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Tracks the offset and drift of live feeds against a reference feed (feed 0).
+/// Audio of every feed is pushed in blocks, as StreamingFeatureExtractor does for
+/// files. Each completed hop yields one onset-envelope frame (spectral flux with
+/// its running mean removed), and each pair of reference and feed frames updates
+/// per-lag running correlation sums over a sliding window: the newest product is
+/// added and the one leaving the window subtracted, so nothing is recomputed from
+/// scratch. Every update interval the normalized peak over the lag range becomes
+/// the feed's estimate, and a least-squares line through recent estimates gives
+/// its drift.
+///
+/// All buffers are sized at construction; processBlock never allocates or locks.
+/// Its cost is bounded by the block length: per completed hop one windowed FFT,
+/// per feed frame 2 * getLagCount() multiply-adds, and per update interval one
+/// O(getLagCount()) scan of each feed. getWorstBlockSeconds() reports the slowest
+/// block seen, for checking the budget on the target machine.
+///
+/// Feeds are assumed to start together; offsets beyond maxLagSeconds are not
+/// tracked. A feed may run ahead of another by up to maxSkewSeconds of pushed
+/// audio; beyond that the pair restarts its window from the newest frames.
+class LiveSyncTracker {
+public:
+    struct Settings {
+        int windowSize = 1024;              // FFT window (power of two)
+        int hopSize = 256;                  // Samples per envelope frame
+        double windowSeconds = 8.0;         // Audio correlated for each estimate
+        double maxLagSeconds = 1.0;         // Largest |offset| tracked
+        double updateIntervalMs = 100.0;    // Time between estimates
+        double maxSkewSeconds = 2.0;        // How far one feed's pushes may run ahead of another's
+        double meanSeconds = 0.5;           // Time constant of the running mean removed from the envelope
+        double minCorrelation = 0.3;        // Peak correlation an estimate needs to be valid
+        double driftSpacingSeconds = 0.5;   // Least time between estimates kept for the drift fit
+        size_t driftHistory = 128;          // Kept estimates fitted for the drift
+        size_t minDriftPoints = 8;          // Kept estimates needed before a drift is reported
+    };
+
+    /// Latest estimate for one feed, with the sign of an alignment result:
+    /// content at reference sample r is at feed sample r + offsetSamples
+    struct Estimate {
+        bool valid = false;             // Window filled and peak above minCorrelation
+        double offsetSamples = 0.0;     // Interpolated peak lag
+        double confidence = 0.0;        // Normalized peak correlation (0..1)
+        double secondaryPeakRatio = 1.0; // Peak over the strongest lag outside its neighbourhood, as in results
+        double driftPpm = 0.0;          // Offset change per reference sample, ppm (as DriftInfo::ppm)
+        size_t driftPoints = 0;         // Kept estimates behind driftPpm (0 = no drift yet)
+        double timeSeconds = 0.0;       // Reference time at the end of the correlated window
+        uint64_t updates = 0;           // Estimates produced since construction or reset
+    };
+
+    // MARK: - Lifecycle
+
+    /// Allocate every buffer the tracker will use
+    /// @param sampleRate Sample rate of all feeds
+    /// @param feedCount Number of feeds including the reference (>= 2)
+    /// @param settings Tracking parameters
+    /// @throws std::invalid_argument if the rate, feed count or settings are unusable
+    LiveSyncTracker(double sampleRate, size_t feedCount, const Settings& settings);
+
+    // Non-copyable, non-movable (estimates are published through atomics)
+    LiveSyncTracker(const LiveSyncTracker&) = delete;
+    LiveSyncTracker& operator=(const LiveSyncTracker&) = delete;
+
+    // MARK: - Streaming
+
+    /// Append a block of one feed's audio and update every estimate it completes.
+    /// Real-time safe: no allocation, locking or unbounded work.
+    /// @param feed Feed index (0 = reference)
+    /// @param samples Audio samples (mono)
+    /// @param length Number of samples (0 is a no-op)
+    /// @return False if the feed is out of range, the block is null or contains
+    ///         non-finite samples; the block is then ignored
+    bool processBlock(size_t feed, const float* samples, size_t length);
+
+    /// Discard all buffered audio, correlation sums and estimates
+    /// Must not run concurrently with processBlock.
+    void reset();
+
+    // MARK: - Estimates
+
+    /// Most recent estimate of a feed (feed 0 always returns an empty estimate).
+    /// One thread may call this while another pushes blocks; estimates are
+    /// handed over through a lock-free triple buffer per feed.
+    /// @throws std::out_of_range if the feed index is invalid
+    Estimate getEstimate(size_t feed);
+
+    // MARK: - Getters
+
+    const Settings& getSettings() const { return settings_; }
+    double getSampleRate() const { return sampleRate_; }
+    size_t getFeedCount() const { return feeds_.size(); }
+
+    /// Envelope frames correlated per estimate
+    size_t getWindowFrames() const { return windowFrames_; }
+
+    /// Number of lags searched, 2 * max lag in frames + 1
+    size_t getLagCount() const { return lagCount_; }
+
+    /// Envelope frames a feed has produced
+    size_t getFrameCount(size_t feed) const { return feeds_.at(feed).frames; }
+
+    /// Bytes held by the tracker's buffers; constant for the tracker's lifetime
+    size_t getFootprintBytes() const { return footprintBytes_; }
+
+    /// Most envelope frames a processBlock call of the given length can complete
+    size_t getMaxFramesPerBlock(size_t blockLength) const;
+
+    /// Wall time of the slowest processBlock call so far, in seconds
+    double getWorstBlockSeconds() const { return worstBlockSeconds_.load(std::memory_order_relaxed); }
+
+private:
+    // MARK: - Private Types
+
+    struct Feed {
+        std::vector<float> window;      // Samples of the window in progress
+        size_t filled = 0;
+        std::vector<float> previous;    // Magnitudes of the last frame
+        bool hasPrevious = false;
+        double mean = 0.0;              // Running mean of the flux
+        std::vector<float> envelope;    // Ring of envelope frames, frame n at n % ringFrames_
+        std::vector<double> energy;     // Ring of running sums of envelope^2 up to frame n
+        size_t frames = 0;
+    };
+
+    struct Pair {
+        std::vector<double> sums;       // Per lag: sum of reference * feed products in the window
+        size_t consumed = 0;            // Frames correlated so far
+        size_t start = 0;               // First frame of the current window (moves on restart)
+        std::vector<double> driftTimes; // Ring of valid estimate times (reference samples)
+        std::vector<double> driftOffsets;
+        size_t driftCount = 0;
+        size_t driftNext = 0;
+        double lastOffset = 0.0;
+        Estimate current;
+
+        // Triple buffer: the writer fills slots[back], then swaps it with the
+        // published index; bit 2 of published marks a slot the reader has not taken
+        Estimate slots[3];
+        std::atomic<uint8_t> published{1};
+        uint8_t back = 0;
+        uint8_t front = 2;
+    };
+
+    // MARK: - Private Members
+
+    double sampleRate_;
+    Settings settings_;
+    size_t windowFrames_;
+    size_t maxLagFrames_;
+    size_t lagCount_;
+    size_t ringFrames_;
+    size_t skewFrames_;
+    size_t updateFrames_;
+    double meanRate_;
+    size_t footprintBytes_;
+
+    std::vector<Feed> feeds_;
+    std::vector<Pair> pairs_;   // pairs_[f - 1] tracks feed f against feed 0
+
+    // Spectrum kernel and per-frame scratch shared by all feeds
+    std::shared_ptr<const SpectrumKernel> spectrumKernel_;
+    std::vector<float> magnitude_;
+    std::vector<double> correlation_;
+
+    std::atomic<double> worstBlockSeconds_{0.0};
+
+    // MARK: - Private Methods
+
+    /// Turn a full window into one envelope frame and advance by a hop
+    void extractFrame(size_t feed);
+
+    /// Correlate every frame both streams of a pair have
+    void advancePair(size_t feed);
+
+    /// Fold frame pair.consumed into the window sums
+    void correlateFrame(size_t feed);
+
+    /// Peak search over the window, drift fit and publication
+    void updateEstimate(size_t feed);
+
+    /// Start a new window at the given frame
+    void restartPair(Pair& pair, size_t frame);
+
+    /// Hand the pair's current estimate to the reader
+    void publish(Pair& pair);
+
+    /// Running energy of a feed's envelope up to frame index (empty before frame 0)
+    double energyAt(const Feed& feed, int64_t frame) const;
+};
+
+} // namespace HarmoniqSync
+
+#endif /* LIVE_SYNC_TRACKER_HPP */
@@ -0,0 +1,93 @@
+//
+//  mfcc_plan.hpp
+//  HarmoniqSyncCore
+//
+//  Cached mel filterbank and DCT basis for MFCC extraction
+//
+
+#ifndef MFCC_PLAN_HPP
+#define MFCC_PLAN_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Precomputed tables that turn magnitude frames into MFCCs for one
+/// (sampleRate, numBins, numFilters, numCoeffs) configuration.
+/// Each triangular mel filter is stored as a start bin plus its non-zero
+/// weights, and the DCT-II is a numFilters x numCoeffs basis matrix, so a block
+/// of frames costs one short dot product per filter and one matrix multiply.
+/// Plans are immutable and shared across threads through get().
+class MFCCPlan {
+public:
+    // MARK: - Lifecycle
+
+    /// Build the tables (prefer get(), which reuses plans)
+    /// @param sampleRate Rate of the analysed audio
+    /// @param numBins Magnitude bins per frame (windowSize / 2)
+    /// @param numFilters Number of triangular mel filters
+    /// @param numCoeffs Number of cepstral coefficients kept
+    MFCCPlan(double sampleRate, size_t numBins, int numFilters, int numCoeffs);
+
+    /// Shared plan for a configuration, built on first use (thread-safe)
+    static std::shared_ptr<const MFCCPlan> get(double sampleRate, size_t numBins, int numFilters, int numCoeffs);
+
+    // MARK: - Processing
+
+    /// Compute MFCCs for consecutive magnitude frames
+    /// @param magnitudes numFrames x numBins values, row-major
+    /// @param numFrames Number of frames
+    /// @param output numFrames x numCoeffs values, row-major
+    void apply(const float* magnitudes, size_t numFrames, float* output) const;
+
+    // MARK: - Getters
+
+    double getSampleRate() const { return sampleRate_; }
+    size_t getNumBins() const { return numBins_; }
+    int getNumFilters() const { return numFilters_; }
+    int getNumCoeffs() const { return numCoeffs_; }
+
+    /// Total non-zero filterbank weights (numFilters x numBins when dense)
+    size_t getWeightCount() const { return weights_.size(); }
+
+    // MARK: - Mel Scale
+
+    /// Convert frequency to mel scale
+    static float frequencyToMel(float frequency);
+
+    /// Convert mel scale to frequency
+    static float melToFrequency(float mel);
+
+private:
+    // MARK: - Private Members
+
+    /// Non-zero span of one triangular filter
+    struct Filter {
+        size_t start = 0;   // First bin
+        size_t length = 0;  // Bins covered
+        size_t offset = 0;  // Position of the first weight in weights_
+    };
+
+    double sampleRate_;
+    size_t numBins_;
+    int numFilters_;
+    int numCoeffs_;
+
+    std::vector<Filter> filters_;
+    std::vector<float> weights_;   // Filter weights, concatenated
+    std::vector<float> dctBasis_;  // numFilters x numCoeffs, row-major
+
+    // MARK: - Private Methods
+
+    /// Build the sparse triangular filterbank
+    void buildFilterBank();
+
+    /// Build the DCT-II basis: dctBasis_[n][k] = cos(pi * k * (n + 0.5) / numFilters)
+    void buildDCTBasis();
+};
+
+} // namespace HarmoniqSync
+
+#endif /* MFCC_PLAN_HPP */
@@ -13,6 +13,8 @@
 #include <memory>
 #include <functional>
 #include <string>
+#include <map>
+#include <vector>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
@@ -43,6 +45,45 @@ private:
     mutable std::condition_variable condition_;
 };
 
+/// Installs a cancellation token and deadline on the calling thread (RAII)
+/// Extraction and correlation loops call check() once per frame or block of lags,
+/// so a cancelled or expired operation unwinds within milliseconds. Work handed to
+/// the thread pool forwards current() to its tasks. Scopes nest; the innermost wins.
+class CancellationScope {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Token and deadline of one scope (no token and Clock::time_point::max() = unlimited)
+    struct Context {
+        const CancellationToken* token = nullptr;
+        Clock::time_point deadline = Clock::time_point::max();
+    };
+
+    /// @param token Checked for cancellation; must outlive the scope (may be null)
+    /// @param deadline Time after which check() reports a timeout
+    explicit CancellationScope(const CancellationToken* token,
+                               Clock::time_point deadline = Clock::time_point::max());
+    explicit CancellationScope(const Context& context);
+    ~CancellationScope();
+
+    // Non-copyable, non-movable (installed on the calling thread)
+    CancellationScope(const CancellationScope&) = delete;
+    CancellationScope& operator=(const CancellationScope&) = delete;
+
+    /// Context of the innermost scope on this thread
+    static Context current();
+
+    /// Throw if the innermost scope was cancelled or has passed its deadline
+    /// @throws OperationCancelledException after CancellationToken::cancel()
+    /// @throws OperationTimeoutException once the deadline has passed
+    static void check();
+
+private:
+    Context previous_;
+
+    static Context& threadContext();
+};
+
 /// Progress information with detailed metrics
 struct ProgressInfo {
     float percentage;                    // 0.0 to 100.0
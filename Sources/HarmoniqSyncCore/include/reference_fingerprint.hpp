@@ -0,0 +1,81 @@
+//
+//  reference_fingerprint.hpp
+//  HarmoniqSyncCore
+//
+//  Precomputed reference features for repeated alignment
+//
+
+#ifndef REFERENCE_FINGERPRINT_HPP
+#define REFERENCE_FINGERPRINT_HPP
+
+#include "alignment_engine.hpp"
+#include "streaming_feature_extractor.hpp"
+#include "harmoniq_sync.h"
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Reference clip reduced to its post-processed feature streams.
+/// Built once from the master track and matched against any number of
+/// targets; the reference PCM is not retained. Feature transforms used by
+/// FFT correlation are memoized per size on first use. All alignment calls
+/// are const and safe to issue concurrently from multiple threads.
+class ReferenceFingerprint {
+public:
+    // MARK: - Lifecycle
+    
+    /// Extract reference features
+    /// @param samples Reference audio samples (mono)
+    /// @param length Number of samples
+    /// @param sampleRate Sample rate of the reference
+    /// @param method Alignment method the fingerprint is prepared for
+    /// @param config Engine configuration used for extraction and alignment
+    /// @throws std::invalid_argument if the audio cannot be loaded or the method is unknown
+    ReferenceFingerprint(const float* samples, size_t length, double sampleRate,
+                         harmoniq_sync_method_t method,
+                         const AlignmentEngine::Config& config);
+    
+    /// Build a fingerprint from features streamed block by block
+    /// Method and configuration are taken from the extractor.
+    /// @param stream Extractor that has been fed the complete reference
+    /// @throws std::invalid_argument if no audio has been pushed to the stream
+    explicit ReferenceFingerprint(const StreamingFeatureExtractor& stream);
+    
+    // Non-copyable but movable
+    ReferenceFingerprint(const ReferenceFingerprint&) = delete;
+    ReferenceFingerprint& operator=(const ReferenceFingerprint&) = delete;
+    ReferenceFingerprint(ReferenceFingerprint&&) = default;
+    ReferenceFingerprint& operator=(ReferenceFingerprint&&) = default;
+    
+    // MARK: - Alignment
+    
+    /// Align a single target against the reference
+    /// @param samples Target audio samples (mono)
+    /// @param length Number of samples
+    /// @param sampleRate Sample rate of the target (must match the reference)
+    /// @return Alignment result
+    harmoniq_sync_result_t align(const float* samples, size_t length, double sampleRate) const;
+    
+    /// Align multiple targets against the reference (results in input order)
+    std::vector<harmoniq_sync_result_t> alignBatch(const float* const* samples, const size_t* lengths,
+                                                   size_t count, double sampleRate) const;
+    
+    // MARK: - Getters
+    
+    harmoniq_sync_method_t getMethod() const { return method_; }
+    double getSampleRate() const { return features_.sampleRate; }
+    size_t getLength() const { return features_.audioLength; }
+    const AlignmentEngine::Config& getConfig() const { return config_; }
+    const AlignmentEngine::ClipFeatures& getFeatures() const { return features_; }
+    
+private:
+    // MARK: - Private Members
+    
+    AlignmentEngine::Config config_;
+    harmoniq_sync_method_t method_;
+    AlignmentEngine::ClipFeatures features_;
+};
+
+} // namespace HarmoniqSync
+
+#endif /* REFERENCE_FINGERPRINT_HPP */
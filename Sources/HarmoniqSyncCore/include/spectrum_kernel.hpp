@@ -0,0 +1,85 @@
+//
+//  spectrum_kernel.hpp
+//  HarmoniqSyncCore
+//
+//  Windowed magnitude and power spectra of single frames, specialised per frame length
+//
+
+#ifndef SPECTRUM_KERNEL_HPP
+#define SPECTRUM_KERNEL_HPP
+
+#include "dsp_backend.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Hann-windowed spectrum of one frame of a fixed length. The window table, the
+/// FFT plan and log2 of the length are resolved once when the kernel is built,
+/// and frames are transformed in stack scratch, so a frame costs one fused
+/// window-and-pack loop, the FFT and one fused magnitude loop. The standard
+/// window sizes (512, 1024, 2048 and 4096) dispatch to instantiations compiled
+/// for their length, whose loops the compiler unrolls and vectorizes; other
+/// powers of two run the same loops with a runtime length. Kernels are
+/// immutable and shared across threads through get().
+class SpectrumKernel {
+public:
+    /// Longest supported frame
+    static constexpr size_t MAX_FRAME_LENGTH = 16384;
+
+    // MARK: - Lifecycle
+
+    /// Build a kernel (prefer get(), which reuses kernels)
+    /// @param frameLength Samples per frame, a power of two from 2 to MAX_FRAME_LENGTH
+    /// @throws std::invalid_argument for any other length
+    explicit SpectrumKernel(size_t frameLength);
+
+    /// Shared kernel for a frame length, built on first use (thread-safe)
+    /// @throws std::invalid_argument if the length is not supported
+    static std::shared_ptr<const SpectrumKernel> get(size_t frameLength);
+
+    // MARK: - Processing
+
+    /// Magnitude spectrum sqrt(|X_k|^2 / N) of a Hann-windowed frame
+    /// Bin 0 holds the DC and Nyquist terms together, as in the packed FFT format.
+    /// @param input frameLength samples
+    /// @param magnitude frameLength / 2 values
+    void magnitude(const float* input, float* magnitude) const { magnitudeFunction_(*this, input, magnitude); }
+
+    /// Power spectrum |X_k|^2 / N^2 of a Hann-windowed frame
+    /// @param input frameLength samples
+    /// @param power frameLength / 2 values
+    void power(const float* input, float* power) const { powerFunction_(*this, input, power); }
+
+    // MARK: - Getters
+
+    size_t getFrameLength() const { return frameLength_; }
+    size_t getBinCount() const { return frameLength_ / 2; }
+
+    /// True when the length has a compile-time specialised kernel
+    bool isSpecialized() const { return specialized_; }
+
+private:
+    using FrameFunction = void (*)(const SpectrumKernel& kernel, const float* input, float* output);
+
+    // MARK: - Private Members
+
+    size_t frameLength_;
+    size_t log2Length_;
+    bool specialized_;
+    std::shared_ptr<const std::vector<float>> window_;
+    std::shared_ptr<const DSP::RealFFT<float>> fft_;
+    FrameFunction magnitudeFunction_;
+    FrameFunction powerFunction_;
+
+    // MARK: - Private Methods
+
+    /// Window, transform and reduce one frame; Length 0 takes the length from the kernel
+    template <size_t Length, bool Power>
+    static void transformFrame(const SpectrumKernel& kernel, const float* input, float* output);
+};
+
+} // namespace HarmoniqSync
+
+#endif /* SPECTRUM_KERNEL_HPP */
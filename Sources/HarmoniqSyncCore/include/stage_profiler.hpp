@@ -0,0 +1,144 @@
+//
+//  stage_profiler.hpp
+//  HarmoniqSyncCore
+//
+//  Per-stage timing and allocation tracking for the alignment pipeline
+//
+
+#ifndef STAGE_PROFILER_HPP
+#define STAGE_PROFILER_HPP
+
+#include "harmoniq_sync.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace HarmoniqSync {
+
+/// Pipeline stages timed by ScopedStageTimer
+enum class ProcessingStage : size_t {
+    LoadValidate = 0,       // Input checks and loading audio
+    Resample,               // Anti-aliased decimation to the analysis rate
+    STFT,                   // Windowed FFT frames of the spectrogram
+    FeatureExtraction,      // Flux, chroma, MFCC and energy from spectra and samples
+    FeaturePostProcessing,  // Thresholding, smoothing and normalization
+    Correlation,            // Cross-correlation kernels
+    PeakPicking,            // Best-lag search
+    Confidence,             // Confidence, SNR and noise floor scoring
+    DriftEstimation,        // Local alignments and line fit
+    Refinement,             // Sample-domain GCC-PHAT refinement
+    Count
+};
+
+/// Number of timed stages
+static constexpr size_t PROCESSING_STAGE_COUNT = static_cast<size_t>(ProcessingStage::Count);
+
+/// Single methods combined by hybrid alignment (spectral flux through MFCC)
+static constexpr size_t PROFILED_METHOD_COUNT = 4;
+
+/// Timings and allocation high-water mark collected by one StageProfiler
+struct StageProfile {
+    /// Exclusive seconds per stage: a nested stage pauses the enclosing one,
+    /// so the stages never count the same time twice
+    std::array<double, PROCESSING_STAGE_COUNT> stageSeconds{};
+
+    /// Inclusive correlation and scoring seconds per single method, indexed by
+    /// harmoniq_sync_method_t (hybrid fills all four)
+    std::array<double, PROFILED_METHOD_COUNT> methodSeconds{};
+    
+    /// Alignments per single method, indexed like methodSeconds (a hybrid
+    /// cascade leaves out the methods it did not need)
+    std::array<uint32_t, PROFILED_METHOD_COUNT> methodRuns{};
+
+    /// Largest number of aligned feature bytes (spectrograms, chroma and MFCC
+    /// matrices) held at once
+    size_t peakAllocatedBytes = 0;
+
+    /// Aligned feature bytes currently held; negative when storage allocated
+    /// before profiling started is released
+    int64_t allocatedBytes = 0;
+
+    double seconds(ProcessingStage stage) const { return stageSeconds[static_cast<size_t>(stage)]; }
+
+    /// Fold in a profile recorded concurrently on another thread
+    /// Times are summed, so they measure work rather than wall time.
+    void merge(const StageProfile& other);
+};
+
+/// Collects stage timings on the calling thread for its lifetime (RAII)
+/// Profilers nest: the innermost one receives the samples, and the time spent
+/// under it still counts towards the stage running in the enclosing profile.
+/// A null profile suspends collection. Timers on threads without a profiler
+/// cost one thread-local read.
+class StageProfiler {
+public:
+    explicit StageProfiler(StageProfile* profile);
+    ~StageProfiler();
+
+    // Non-copyable, non-movable (installed on the calling thread)
+    StageProfiler(const StageProfiler&) = delete;
+    StageProfiler& operator=(const StageProfiler&) = delete;
+
+    /// Wall time since the profiler was installed
+    double getElapsedSeconds() const;
+
+    /// Profile receiving samples on this thread (nullptr when not profiling)
+    static StageProfile* active();
+
+    /// Account aligned storage in the active profile
+    static void recordAllocation(size_t bytes) noexcept;
+    static void recordDeallocation(size_t bytes) noexcept;
+
+private:
+    struct SavedState {
+        StageProfile* profile;
+        ProcessingStage stage;
+        std::chrono::steady_clock::time_point mark;
+    };
+
+    SavedState previous_;
+    std::chrono::steady_clock::time_point start_;
+
+    /// Profiler state of the calling thread
+    static SavedState& threadState();
+
+    /// Charge the time since the last mark to the running stage and move the mark
+    static void charge(SavedState& state, std::chrono::steady_clock::time_point now);
+
+    friend class ScopedStageTimer;
+};
+
+/// Charges the time until destruction to one stage of the active profile
+class ScopedStageTimer {
+public:
+    explicit ScopedStageTimer(ProcessingStage stage);
+    ~ScopedStageTimer();
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    StageProfile* profile_;
+    ProcessingStage enclosing_;
+};
+
+/// Adds the time until destruction to StageProfile::methodSeconds and counts
+/// the run in StageProfile::methodRuns
+class ScopedMethodTimer {
+public:
+    explicit ScopedMethodTimer(harmoniq_sync_method_t method);
+    ~ScopedMethodTimer();
+
+    ScopedMethodTimer(const ScopedMethodTimer&) = delete;
+    ScopedMethodTimer& operator=(const ScopedMethodTimer&) = delete;
+
+private:
+    StageProfile* profile_;
+    size_t index_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace HarmoniqSync
+
+#endif /* STAGE_PROFILER_HPP */
@@ -0,0 +1,144 @@
+//
+//  streaming_feature_extractor.hpp
+//  HarmoniqSyncCore
+//
+//  Incremental feature extraction from pushed audio blocks
+//
+
+#ifndef STREAMING_FEATURE_EXTRACTOR_HPP
+#define STREAMING_FEATURE_EXTRACTOR_HPP
+
+#include "audio_processor.hpp"
+#include "alignment_engine.hpp"
+#include "harmoniq_sync.h"
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Push-based counterpart of AudioProcessor's feature extractors.
+/// Audio arrives in blocks of any size (e.g. straight from a decoder) and
+/// every analysis frame is computed as soon as its window is complete. Only
+/// the samples of the window still in progress are buffered, so the clip's
+/// PCM never has to be held in memory and the clip length is not limited by
+/// AudioProcessor's load limit.
+///
+/// Frame positions, window and hop sizes follow AlignmentEngine::prepareFeatures
+/// for the same configuration, and the feature getters return exactly what the
+/// AudioProcessor batch extractors would return for the concatenated blocks.
+/// Streams are always analysed at their input rate; Config::analysisSampleRate
+/// is not applied.
+class StreamingFeatureExtractor {
+public:
+    // MARK: - Lifecycle
+
+    /// Create an extractor for the streams a method needs
+    /// @param sampleRate Sample rate of the incoming audio
+    /// @param method Alignment method whose features are extracted (all streams for hybrid)
+    /// @param config Engine configuration providing window, hop and MFCC sizes
+    /// @throws std::invalid_argument if the rate, method or window size is unsupported
+    StreamingFeatureExtractor(double sampleRate,
+                              harmoniq_sync_method_t method,
+                              const AlignmentEngine::Config& config = AlignmentEngine::Config());
+
+    // Non-copyable but movable
+    StreamingFeatureExtractor(const StreamingFeatureExtractor&) = delete;
+    StreamingFeatureExtractor& operator=(const StreamingFeatureExtractor&) = delete;
+    StreamingFeatureExtractor(StreamingFeatureExtractor&&) = default;
+    StreamingFeatureExtractor& operator=(StreamingFeatureExtractor&&) = default;
+
+    // MARK: - Streaming
+
+    /// Append a block of samples and extract every frame it completes
+    /// @param samples Audio samples (mono)
+    /// @param length Number of samples (0 is a no-op)
+    /// @return False if the block is null or contains non-finite samples; the block is then ignored
+    bool processBlock(const float* samples, size_t length);
+
+    /// Discard all buffered audio and extracted features
+    void reset();
+
+    // MARK: - Features
+
+    /// Spectral flux over the samples pushed so far (as AudioProcessor::extractSpectralFlux)
+    std::vector<float> getSpectralFlux() const;
+
+    /// Chroma matrix, frames x numChromaBins (as AudioProcessor::extractChromaFeatures)
+    const FeatureMatrix& getChromaFeatures() const { return chroma_; }
+
+    /// RMS energy profile (as AudioProcessor::extractEnergyProfile)
+    std::vector<float> getEnergyProfile() const;
+
+    /// MFCC matrix, frames x numCoeffs (as AudioProcessor::extractMFCC)
+    const FeatureMatrix& getMFCC() const { return mfcc_; }
+
+    // MARK: - Getters
+
+    harmoniq_sync_method_t getMethod() const { return method_; }
+    double getSampleRate() const { return sampleRate_; }
+    const AlignmentEngine::Config& getConfig() const { return config_; }
+    int getWindowSize() const { return config_.windowSize; }
+    int getHopSize() const { return hopSize_; }
+    int getEnergyHopSize() const { return energyHopSize_; }
+
+    /// Total number of samples pushed since construction or the last reset
+    size_t getSamplesProcessed() const { return samplesProcessed_; }
+
+    /// Number of spectral frames extracted so far
+    size_t getSpectralFrameCount() const { return spectralFrames_; }
+
+    /// Number of samples currently held for incomplete windows
+    size_t getBufferedSamples() const { return buffer_.size(); }
+
+private:
+    // MARK: - Private Members
+
+    double sampleRate_;
+    harmoniq_sync_method_t method_;
+    AlignmentEngine::Config config_;
+    int hopSize_;
+    int energyHopSize_;
+
+    bool wantsSpectralFlux_;
+    bool wantsChroma_;
+    bool wantsEnergy_;
+    bool wantsMFCC_;
+
+    // FFT setup and per-frame derivations shared with the batch path
+    AudioProcessor dsp_;
+
+    // Pending samples; buffer_[0] is absolute sample bufferStart_
+    std::vector<float> buffer_;
+    size_t bufferStart_;
+    size_t samplesProcessed_;
+    size_t nextSpectralFrame_;  // Absolute start of the next spectral window
+    size_t nextEnergyFrame_;    // Absolute start of the next energy window
+    size_t spectralFrames_;
+
+    // Last magnitude frame, needed for the flux of the first frame of the next block
+    std::vector<float> previousMagnitude_;
+
+    // Raw streams; flux and energy are median-smoothed on read like the batch extractors
+    std::vector<float> spectralFlux_;
+    FeatureMatrix chroma_;
+    std::vector<float> energy_;
+    FeatureMatrix mfcc_;
+
+    // Scratch spectrogram and feature rows for the frames completed by one block
+    Spectrogram blockSpectrogram_;
+    FeatureMatrix blockFeatures_;
+
+    // MARK: - Private Methods
+
+    /// Extract all complete spectral frames from the buffer
+    void extractSpectralFrames();
+
+    /// Extract all complete energy frames from the buffer
+    void extractEnergyFrames();
+
+    /// Drop samples no pending window needs any more
+    void trimBuffer();
+};
+
+} // namespace HarmoniqSync
+
+#endif /* STREAMING_FEATURE_EXTRACTOR_HPP */
@@ -10,15 +10,65 @@
 
 #include "audio_processor.hpp"
 #include "alignment_engine.hpp"
+#include "cost_model.hpp"
+#include "stage_profiler.hpp"
+#include "operation_control.hpp"
 #include "harmoniq_sync.h"
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <functional>
 
 namespace HarmoniqSync {
 
+/// Handle to a synchronization started with SyncEngine::processAsync
+/// Thread-safe: any thread may cancel, poll or wait on the operation.
+class SyncOperation {
+public:
+    SyncOperation() = default;
+    
+    // Non-copyable, non-movable (shared with the running task)
+    SyncOperation(const SyncOperation&) = delete;
+    SyncOperation& operator=(const SyncOperation&) = delete;
+    
+    /// Request cancellation; the operation finishes with HARMONIQ_SYNC_ERROR_CANCELLED
+    /// at its next frame or block of lags (no effect once it has finished)
+    void cancel();
+    
+    /// True once the result is available (the completion callback may still be running)
+    bool isFinished() const;
+    
+    /// Block until the operation finishes and return its result
+    /// The result is published before the completion callback runs, so the callback may wait.
+    harmoniq_sync_result_t wait() const;
+    
+    /// Token checked by the running operation
+    const CancellationToken& getCancellationToken() const { return token_; }
+
+private:
+    CancellationToken token_;
+    mutable std::mutex mutex_;
+    mutable std::condition_variable finishedCondition_;
+    bool finished_ = false;
+    harmoniq_sync_result_t result_ = {};
+    
+    /// Publish the result and wake waiters
+    void finish(const harmoniq_sync_result_t& result);
+    
+    friend class SyncEngine;
+};
+
 /// High-level synchronization engine that orchestrates the full sync process
 /// This class provides the main interface for end-to-end audio synchronization
+///
+/// Thread-safe and reentrant: one engine may serve concurrent process, processBatch
+/// and processAsync calls. FFT plans, windows and filterbanks are immutable and
+/// shared process-wide; each call leases an AlignmentEngine with its scratch buffers
+/// from a pool of idle ones and returns it warm, so calls never wait on each other
+/// beyond the lease itself. Configuration, cache and callback changes apply to
+/// calls that start afterwards.
 class SyncEngine {
 public:
     // MARK: - Lifecycle
@@ -34,6 +84,12 @@ public:
     /// Get current configuration
     harmoniq_sync_config_t getConfig() const;
     
+    /// Read and write prepared features through a persistent cache (nullptr = disabled)
+    void setFeatureCache(std::shared_ptr<const FeatureCache> cache);
+    
+    /// Current feature cache (nullptr when disabled)
+    std::shared_ptr<const FeatureCache> getFeatureCache() const;
+    
     // MARK: - Main Processing Interface
     
     /// Process two audio buffers and return sync result
@@ -68,12 +124,35 @@ public:
         harmoniq_sync_method_t method
     );
     
+    // MARK: - Asynchronous Processing
+    
+    /// Completion callback, called on a pool thread with the final result
+    using CompletionCallback = std::function<void(const harmoniq_sync_result_t& result)>;
+    
+    /// Run process() on the shared thread pool
+    /// The engine and both buffers must stay valid until the operation finishes (wait()
+    /// returns or the completion starts); other calls may run on the engine meanwhile. Cancellation and timeout are checked per
+    /// frame and per block of lags; a stopped operation completes with
+    /// HARMONIQ_SYNC_ERROR_CANCELLED or HARMONIQ_SYNC_ERROR_TIMEOUT.
+    /// @param timeout Limit counted from this call (zero or negative = no limit)
+    /// @param completion Called once after the operation is marked finished (may be empty)
+    /// @return Operation handle for cancelling and waiting
+    std::shared_ptr<SyncOperation> processAsync(
+        const float* referenceAudio, size_t refLength,
+        const float* targetAudio, size_t targetLength,
+        double sampleRate,
+        harmoniq_sync_method_t method,
+        std::chrono::milliseconds timeout,
+        CompletionCallback completion
+    );
+    
     // MARK: - Progress Monitoring
     
     /// Progress callback function type
     using ProgressCallback = std::function<void(float progress, const std::string& status)>;
     
     /// Set progress callback for monitoring long operations
+    /// Called on the thread running each call, so concurrent calls invoke it concurrently.
     void setProgressCallback(ProgressCallback callback);
     
     /// Clear progress callback
@@ -93,37 +172,87 @@ public:
     
     // MARK: - Performance Metrics
     
+    /// Predict the cost of aligning two clips with the current configuration
+    /// @param confidence Probability that the wall time stays below Prediction::upperSeconds
+    CostModel::Prediction predictCost(
+        size_t refLength, size_t targetLength,
+        double sampleRate,
+        harmoniq_sync_method_t method,
+        double confidence = 0.95
+    ) const;
+    
+    /// Decide whether aligning two clips meets a deadline and a memory budget
+    /// @param deadlineSeconds Wall time available (<= 0 = no deadline)
+    /// @param memoryBudgetBytes Memory available (0 = no limit)
+    CostModel::Admission admitJob(
+        size_t refLength, size_t targetLength,
+        double sampleRate,
+        harmoniq_sync_method_t method,
+        double deadlineSeconds,
+        size_t memoryBudgetBytes,
+        double confidence = 0.95
+    ) const;
+    
     /// Get estimated processing time for given parameters
+    /// Expected wall time of predictCost for a reference and target of the given length.
     double estimateProcessingTime(
         size_t audioLengthSamples,
         double sampleRate,
         harmoniq_sync_method_t method
     ) const;
     
-    /// Get last processing statistics
+    /// Predict costs with a calibrated model (nullptr = CostModel::shared())
+    void setCostModel(std::shared_ptr<const CostModel> model);
+    
+    /// Model behind predictCost and admitJob
+    std::shared_ptr<const CostModel> getCostModel() const;
+    
+    /// Per-call processing statistics
     struct ProcessingStats {
         double processingTimeSeconds = 0.0;
         double audioLengthSeconds = 0.0;
         double realtimeRatio = 0.0;  // processing_time / audio_length
-        size_t memoryUsedBytes = 0;
+        size_t memoryUsedBytes = 0;  // Peak aligned feature storage (stages.peakAllocatedBytes)
         harmoniq_sync_method_t methodUsed = HARMONIQ_SYNC_SPECTRAL_FLUX;
         bool successful = false;
+        StageProfile stages;         // Per-stage timings; batch stages sum the work of all workers
     };
     
+    /// Statistics of the call that finished last
     ProcessingStats getLastProcessingStats() const;
 
 private:
+    // MARK: - Private Types
+    
+    /// Alignment engine borrowed from the idle pool for one call
+    class EngineLease;
+    
     // MARK: - Private Members
     
+    // Guards every member below; held only to copy or swap state, never during processing
+    mutable std::mutex stateMutex_;
+    
     harmoniq_sync_config_t config_;
-    std::unique_ptr<AlignmentEngine> alignmentEngine_;
+    AlignmentEngine::Config engineConfig_;  // config_ converted once per setConfig
+    std::shared_ptr<const FeatureCache> featureCache_;
+    std::vector<std::unique_ptr<AlignmentEngine>> idleEngines_;
     ProgressCallback progressCallback_;
     ProcessingStats lastStats_;
+    std::shared_ptr<const CostModel> costModel_;
     
     // MARK: - Internal Processing
     
-    /// Update progress and call callback if set
-    void updateProgress(float progress, const std::string& status);
+    /// Take an idle alignment engine (or create one) set up with the current configuration
+    std::unique_ptr<AlignmentEngine> acquireEngine();
+    
+    /// Return a leased engine to the idle pool, keeping its buffers warm
+    void releaseEngine(std::unique_ptr<AlignmentEngine> engine);
+    
+    /// Progress callback in effect when a call starts
+    ProgressCallback snapshotProgressCallback() const;
+    
+    /// Call the callback if set
+    static void updateProgress(const ProgressCallback& callback, float progress, const std::string& status);
     
     /// Convert C config to C++ config
     AlignmentEngine::Config convertConfig(const harmoniq_sync_config_t& cConfig) const;
@@ -134,13 +263,13 @@ private:
         const std::string& method
     ) const;
     
-    /// Update processing statistics
+    /// Update processing statistics from the profile collected during the call
     void updateProcessingStats(
-        double processingTime,
+        const StageProfiler& profiler,
+        const StageProfile& profile,
         double audioLength,
         harmoniq_sync_method_t method,
-        bool successful,
-        size_t memoryUsed = 0
+        bool successful
     );
 };
 
@@ -0,0 +1,94 @@
+//
+//  thread_pool.hpp
+//  HarmoniqSyncCore
+//
+//  Persistent work-stealing thread pool for batch alignment
+//
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Fixed-size pool of worker threads with one task deque per worker.
+/// Workers pop their own deque from the front and steal from the back of
+/// other deques when idle. Threads live for the lifetime of the pool, so
+/// repeated batch calls do not pay thread creation costs.
+class ThreadPool {
+public:
+    // MARK: - Lifecycle
+
+    /// Create a pool
+    /// @param threadCount Number of worker threads (0 = hardware concurrency - 1, at least 1)
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    // Non-copyable, non-movable (workers capture this)
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Process-wide pool shared by all engines
+    static ThreadPool& shared();
+
+    // MARK: - Scheduling
+
+    /// Number of worker threads owned by the pool
+    size_t getThreadCount() const { return workers_.size(); }
+
+    /// Queue a task for asynchronous execution
+    /// Tasks must handle their own errors; escaping exceptions are discarded.
+    void submit(std::function<void()> task);
+
+    /// Run body(index, slot) for every index in [0, count) and wait for completion
+    /// At most maxParallelism invocations run concurrently and each one receives a
+    /// slot in [0, parallelism) that no other concurrent invocation shares, so
+    /// callers can keep per-slot scratch state without locking. The calling thread
+    /// takes part in the work. The first exception thrown by body is rethrown here.
+    /// @param count Number of indices to process
+    /// @param maxParallelism Upper bound on concurrent invocations (0 = pool size + 1)
+    /// @param body Work item, called once per index
+    void parallelFor(size_t count, size_t maxParallelism,
+                     const std::function<void(size_t index, size_t slot)>& body);
+
+    /// Number of slots parallelFor would use for the given arguments
+    size_t resolveParallelism(size_t count, size_t maxParallelism) const;
+
+private:
+    // MARK: - Private Members
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    std::atomic<size_t> pendingTasks_;
+    std::atomic<size_t> nextQueue_;
+    bool stopping_;
+
+    // MARK: - Private Methods
+
+    /// Main loop of worker thread workerIndex
+    void workerLoop(size_t workerIndex);
+
+    /// Run one queued task, preferring the given queue and stealing from the others
+    /// @return True if a task was executed
+    bool tryRunTask(size_t preferredQueue);
+};
+
+} // namespace HarmoniqSync
+
+#endif /* THREAD_POOL_HPP */
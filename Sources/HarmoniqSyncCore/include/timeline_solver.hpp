@@ -0,0 +1,57 @@
+//
+//  timeline_solver.hpp
+//  HarmoniqSyncCore
+//
+//  Consistent clip positions from pairwise alignment offsets
+//
+
+#ifndef TIMELINE_SOLVER_HPP
+#define TIMELINE_SOLVER_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace HarmoniqSync {
+
+/// Places clips on shared timelines from pairwise offsets.
+/// Clips linked by measurements form a group with one timeline. A maximum-weight
+/// spanning tree of each group gives a first placement, measurements that disagree
+/// with it by more than a tolerance are discarded as false matches, and the rest
+/// are fitted by weighted least squares, so redundant pairs average out instead of
+/// the tree's errors adding up along long chains.
+class TimelineSolver {
+public:
+    /// Offset of one clip against another, with the sign of an alignment result:
+    /// content at reference sample r is at target sample r + offsetSamples
+    struct Measurement {
+        size_t reference;
+        size_t target;
+        double offsetSamples;
+        double weight = 1.0;  // Relative trust (> 0), e.g. the alignment confidence
+    };
+
+    /// Position of one clip
+    struct Placement {
+        size_t group = 0;            // Clips in the same group share a timeline
+        double startSamples = 0.0;   // Timeline position of the clip's first sample (earliest clip of a group at 0)
+        size_t measurements = 0;     // Consistent measurements involving the clip (0 = alone in its group)
+    };
+
+    struct Solution {
+        std::vector<Placement> clips;
+        std::vector<bool> consistent;  // Per measurement: used by the fit
+        size_t groupCount = 0;         // Groups are numbered by their lowest clip index
+    };
+
+    // MARK: - Solving
+
+    /// @param clipCount Number of clips; measurement indices must be below it
+    /// @param measurements Pairwise offsets (self-pairs and non-positive weights are ignored)
+    /// @param toleranceSamples Largest disagreement with the spanning tree a measurement may have
+    /// @throws std::invalid_argument if a measurement refers to a clip out of range
+    static Solution solve(size_t clipCount, const std::vector<Measurement>& measurements, double toleranceSamples);
+};
+
+} // namespace HarmoniqSync
+
+#endif /* TIMELINE_SOLVER_HPP */
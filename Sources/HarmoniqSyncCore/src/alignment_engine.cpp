@@ -6,13 +6,72 @@
 //
 
 #include "../include/alignment_engine.hpp"
+#include "../include/streaming_feature_extractor.hpp"
+#include "../include/thread_pool.hpp"
+#include "../include/feature_filters.hpp"
+#include "../include/dsp_backend.hpp"
+#include "../include/stage_profiler.hpp"
+#include "../include/operation_control.hpp"
+#include "../include/feature_cache.hpp"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <map>
 #include <numeric>
 #include <limits>
 
 namespace HarmoniqSync {
 
+// MARK: - Constants
+
+// Sample-domain refinement needs a segment several search radii long
+static const int64_t MIN_REFINEMENT_HOPS = 4;
+
+// Candidate reference segment positions ranked by energy for refinement excerpts
+static const size_t MAX_EXCERPT_CANDIDATES = 32;
+
+// GCC-PHAT peaks below this fraction of a perfect match are ignored
+static const double MIN_PHAT_PEAK = 0.05;
+
+// Drift segments shorter than this many frames give unreliable local offsets
+static const int64_t MIN_DRIFT_SEGMENT_FRAMES = 64;
+
+// Hybrid cascade order, cheapest first: energy needs no spectrogram, spectral flux is a
+// single stream once the STFT is paid for, chroma and MFCC correlate many channels
+static const harmoniq_sync_method_t CASCADE_ORDER[] = {
+    HARMONIQ_SYNC_ENERGY, HARMONIQ_SYNC_SPECTRAL_FLUX, HARMONIQ_SYNC_CHROMA, HARMONIQ_SYNC_MFCC
+};
+
+// Fitted drift must move the offset by this many frames across the overlap to count
+static const double MIN_DRIFT_SPAN_FRAMES = 0.5;
+
+// MARK: - Helpers
+
+// Vertex of the parabola through a peak and its two neighbours, clamped to [-0.5, 0.5]
+// (0 when the centre is not a strict local maximum)
+static double parabolicVertex(double left, double centre, double right) {
+    double curvature = left - 2.0 * centre + right;
+    if (curvature >= 0.0) {
+        return 0.0;
+    }
+    
+    double delta = 0.5 * (left - right) / curvature;
+    return std::max(-0.5, std::min(0.5, delta));
+}
+
+// Median of a scratch vector (reordered in place, mean of the middle pair for even sizes)
+static double medianOf(std::vector<double>& values) {
+    size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    double upper = values[middle];
+    if (values.size() % 2 != 0) {
+        return upper;
+    }
+    
+    double lower = *std::max_element(values.begin(), values.begin() + middle);
+    return 0.5 * (lower + upper);
+}
+
 // MARK: - Lifecycle
 
 AlignmentEngine::AlignmentEngine() = default;
@@ -26,97 +85,330 @@ harmoniq_sync_result_t AlignmentEngine::alignSpectralFlux(const AudioProcessor&
         return createErrorResult(error, "Spectral Flux");
     }
     
-    // Note: We work directly with the inputs since AudioProcessor is non-copyable
-    // In production, consider cloning the data for thread safety
-    // TODO: Add clone() method to AudioProcessor for thread safety
+    auto refFeatures = prepareFeatures(reference, HARMONIQ_SYNC_SPECTRAL_FLUX);
+    auto targetFeatures = prepareFeatures(target, HARMONIQ_SYNC_SPECTRAL_FLUX);
+    
+    // Features come back empty when the first pass finds NaN/Inf samples
+    if (refFeatures.audioLength == 0 || targetFeatures.audioLength == 0) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Spectral Flux");
+    }
     
-    auto refFeatures = reference.extractSpectralFlux(config_.windowSize, config_.hopSize);
-    auto targetFeatures = target.extractSpectralFlux(config_.windowSize, config_.hopSize);
+    auto result = alignSpectralFlux(refFeatures, targetFeatures);
+    detectAndCorrectDrift(refFeatures, targetFeatures, result);
+    return refineWithSamples(result, selectExcerpts(reference), target, refFeatures);
+}
+
+harmoniq_sync_result_t AlignmentEngine::alignChromaFeatures(const AudioProcessor& reference, const AudioProcessor& target) {
+    if (auto error = validateInputs(reference, target); error != HARMONIQ_SYNC_SUCCESS) {
+        return createErrorResult(error, "Chroma Features");
+    }
+    
+    auto refFeatures = prepareFeatures(reference, HARMONIQ_SYNC_CHROMA);
+    auto targetFeatures = prepareFeatures(target, HARMONIQ_SYNC_CHROMA);
+    
+    // Features come back empty when the first pass finds NaN/Inf samples
+    if (refFeatures.audioLength == 0 || targetFeatures.audioLength == 0) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Chroma Features");
+    }
+    
+    auto result = alignChromaFeatures(refFeatures, targetFeatures);
+    detectAndCorrectDrift(refFeatures, targetFeatures, result);
+    return refineWithSamples(result, selectExcerpts(reference), target, refFeatures);
+}
+
+harmoniq_sync_result_t AlignmentEngine::alignEnergyCorrelation(const AudioProcessor& reference, const AudioProcessor& target) {
+    if (auto error = validateInputs(reference, target); error != HARMONIQ_SYNC_SUCCESS) {
+        return createErrorResult(error, "Energy Correlation");
+    }
+    
+    auto refFeatures = prepareFeatures(reference, HARMONIQ_SYNC_ENERGY);
+    auto targetFeatures = prepareFeatures(target, HARMONIQ_SYNC_ENERGY);
+    
+    // Features come back empty when the first pass finds NaN/Inf samples
+    if (refFeatures.audioLength == 0 || targetFeatures.audioLength == 0) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Energy Correlation");
+    }
+    
+    auto result = alignEnergyCorrelation(refFeatures, targetFeatures);
+    detectAndCorrectDrift(refFeatures, targetFeatures, result);
+    return refineWithSamples(result, selectExcerpts(reference), target, refFeatures);
+}
+
+harmoniq_sync_result_t AlignmentEngine::alignMFCC(const AudioProcessor& reference, const AudioProcessor& target) {
+    if (auto error = validateInputs(reference, target); error != HARMONIQ_SYNC_SUCCESS) {
+        return createErrorResult(error, "MFCC");
+    }
+    
+    auto refFeatures = prepareFeatures(reference, HARMONIQ_SYNC_MFCC);
+    auto targetFeatures = prepareFeatures(target, HARMONIQ_SYNC_MFCC);
+    
+    // Features come back empty when the first pass finds NaN/Inf samples
+    if (refFeatures.audioLength == 0 || targetFeatures.audioLength == 0) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "MFCC");
+    }
+    
+    auto result = alignMFCC(refFeatures, targetFeatures);
+    detectAndCorrectDrift(refFeatures, targetFeatures, result);
+    return refineWithSamples(result, selectExcerpts(reference), target, refFeatures);
+}
+
+harmoniq_sync_result_t AlignmentEngine::alignHybrid(const AudioProcessor& reference, const AudioProcessor& target) {
+    if (auto error = validateInputs(reference, target); error != HARMONIQ_SYNC_SUCCESS) {
+        return createErrorResult(error, "Hybrid");
+    }
+    
+    ClipFeatures refFeatures, targetFeatures;
+    harmoniq_sync_result_t result;
+    
+    if (config_.cascade.enabled) {
+        // Each clip's streams are extracted only when the cascade reaches their method
+        result = alignCascade(refFeatures, targetFeatures, [&](harmoniq_sync_method_t method) {
+            return extendFeatures(reference, method, refFeatures) && extendFeatures(target, method, targetFeatures);
+        });
+    } else {
+        refFeatures = prepareFeatures(reference, HARMONIQ_SYNC_HYBRID);
+        targetFeatures = prepareFeatures(target, HARMONIQ_SYNC_HYBRID);
+        
+        // Features come back empty when the first pass finds NaN/Inf samples
+        if (refFeatures.audioLength == 0 || targetFeatures.audioLength == 0) {
+            return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Hybrid");
+        }
+        
+        result = alignHybrid(refFeatures, targetFeatures);
+    }
+    
+    detectAndCorrectDrift(refFeatures, targetFeatures, result);
+    return refineWithSamples(result, selectExcerpts(reference), target, refFeatures);
+}
+
+// MARK: - Feature Preparation
+
+AlignmentEngine::ClipFeatures AlignmentEngine::prepareFeatures(const AudioProcessor& audio, harmoniq_sync_method_t method) const {
+    if (!featureCache_ || !audio.isValid()) {
+        return extractFeatures(audio, method);
+    }
+    
+    FeatureCache::Key key;
+    {
+        ScopedStageTimer timer(ProcessingStage::FeatureExtraction);
+        auto samples = audio.getAudioData();
+        key.contentHash = FeatureCache::hashContent(samples.data(), samples.size(), audio.getSampleRate());
+        key.settingsHash = FeatureCache::hashSettings(config_, method);
+        
+        ClipFeatures cached;
+        if (featureCache_->load(key, cached)) {
+            return cached;
+        }
+    }
+    
+    // Rejected clips come back empty and are not stored
+    ClipFeatures features = extractFeatures(audio, method);
+    if (features.audioLength > 0) {
+        featureCache_->store(key, features);
+    }
+    return features;
+}
+
+AlignmentEngine::ClipFeatures AlignmentEngine::extractFeatures(const AudioProcessor& audio, harmoniq_sync_method_t method) const {
+    ClipFeatures features;
+    features.method = method;
+    features.audioLength = audio.getLength();
+    features.sampleRate = audio.getSampleRate();
+    features.hopSize = resolveHopSize();
+    features.energyHopSize = resolveHopSize(2);
+    
+    if (!audio.isValid()) {
+        return features;
+    }
+    
+    // High-rate clips are analysed on an anti-aliased, decimated copy
+    const int hopSize = features.hopSize;
+    const int energyHopSize = features.energyHopSize;
+    AudioProcessor decimated;
+    const AudioProcessor* analysed = &audio;
+    int decimation = resolveDecimation(audio.getSampleRate());
+    bool resampled = false;
+    if (decimation > 1) {
+        ScopedStageTimer timer(ProcessingStage::Resample);
+        resampled = decimated.loadAudioView(audio.getAudioData().data(), audio.getLength(), audio.getSampleRate(),
+                                            audio.getSampleRate() / decimation);
+    }
+    if (resampled) {
+        analysed = &decimated;
+        
+        // Hops are reported in source samples, so lags map straight back to the source rate
+        features.hopSize *= decimation;
+        features.energyHopSize *= decimation;
+    }
+    
+    bool hybrid = (method == HARMONIQ_SYNC_HYBRID);
+    ScopedStageTimer extraction(ProcessingStage::FeatureExtraction);
+    
+    // Spectral streams share the processor's cached spectrogram
+    if (hybrid || method == HARMONIQ_SYNC_SPECTRAL_FLUX) {
+        features.spectralFlux = analysed->extractSpectralFlux(config_.windowSize, hopSize);
+    }
+    
+    if (hybrid || method == HARMONIQ_SYNC_CHROMA) {
+        analysed->extractChromaFeatures(analysed->getSpectrogram(config_.windowSize, hopSize), features.chroma,
+                                        config_.chroma.numChromaBins, config_.chroma.useHarmonicWeighting);
+    }
+    
+    // Chroma and MFCC have no scalar stream, so drift is measured on the energy profile
+    bool driftEnergy = config_.enableDriftCorrection && (method == HARMONIQ_SYNC_CHROMA || method == HARMONIQ_SYNC_MFCC);
+    if (hybrid || method == HARMONIQ_SYNC_ENERGY || driftEnergy) {
+        features.energy = analysed->extractEnergyProfile(config_.windowSize, energyHopSize);
+    }
+    
+    if (hybrid || method == HARMONIQ_SYNC_MFCC) {
+        analysed->extractMFCC(analysed->getSpectrogram(config_.windowSize, hopSize), features.mfcc,
+                              config_.mfcc.numCoeffs, config_.mfcc.numMelFilters);
+    }
+    
+    // Views are checked for NaN/Inf by the first feature pass; rejected clips keep no samples
+    if (!analysed->isValid()) {
+        ClipFeatures rejected;
+        rejected.method = method;
+        return rejected;
+    }
+    
+    postProcessFeatures(features);
+    return features;
+}
+
+AlignmentEngine::ClipFeatures AlignmentEngine::prepareFeatures(const StreamingFeatureExtractor& stream) const {
+    ClipFeatures features;
+    features.method = stream.getMethod();
+    features.audioLength = stream.getSamplesProcessed();
+    features.sampleRate = stream.getSampleRate();
+    features.hopSize = stream.getHopSize();
+    features.energyHopSize = stream.getEnergyHopSize();
+    
+    // The stream only extracted what its method needs, so copying all of them is safe
+    features.spectralFlux = stream.getSpectralFlux();
+    features.chroma = stream.getChromaFeatures();
+    features.energy = stream.getEnergyProfile();
+    features.mfcc = stream.getMFCC();
+    
+    postProcessFeatures(features);
+    return features;
+}
+
+AlignmentEngine::ClipFeatures AlignmentEngine::prepareReferenceFeatures(const AudioProcessor& audio, harmoniq_sync_method_t method) const {
+    ClipFeatures features = prepareFeatures(audio, method);
+    if (features.audioLength == 0) {
+        return features;
+    }
+    
+    features.excerpts = selectExcerpts(audio);
+    attachSpectra(features);
+    return features;
+}
+
+AlignmentEngine::ClipFeatures AlignmentEngine::prepareReferenceFeatures(const StreamingFeatureExtractor& stream) const {
+    ClipFeatures features = prepareFeatures(stream);
+    attachSpectra(features);
+    return features;
+}
+
+harmoniq_sync_result_t AlignmentEngine::alignPrepared(const ClipFeatures& reference, const AudioProcessor& target, harmoniq_sync_method_t method) {
+    std::string methodName = getMethodName(method);
+    
+    if (reference.audioLength == 0 || reference.sampleRate <= 0.0 || !target.isValid()) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, methodName);
+    }
+    
+    if (std::abs(reference.sampleRate - target.getSampleRate()) > 1.0) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT, methodName);
+    }
+    
+    ClipFeatures targetFeatures;
+    harmoniq_sync_result_t result;
+    
+    if (method == HARMONIQ_SYNC_HYBRID && config_.cascade.enabled) {
+        // Target streams are extracted only when the cascade reaches their method
+        result = alignCascade(reference, targetFeatures, [&](harmoniq_sync_method_t stage) {
+            return extendFeatures(target, stage, targetFeatures);
+        });
+    } else {
+        targetFeatures = prepareFeatures(target, method);
+        if (targetFeatures.audioLength == 0) {
+            return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, methodName);
+        }
+        
+        result = alignFeatures(reference, targetFeatures, method);
+    }
+    
+    detectAndCorrectDrift(reference, targetFeatures, result);
+    
+    // The target PCM is at hand, so reference excerpts allow sample-domain refinement
+    return refineWithSamples(result, reference.excerpts, target, reference);
+}
+
+// MARK: - Alignment From Prepared Features
+
+harmoniq_sync_result_t AlignmentEngine::alignSpectralFlux(const ClipFeatures& reference, const ClipFeatures& target) {
+    ScopedMethodTimer methodTimer(HARMONIQ_SYNC_SPECTRAL_FLUX);
+    const auto& refFeatures = reference.spectralFlux;
+    const auto& targetFeatures = target.spectralFlux;
     
     if (refFeatures.empty() || targetFeatures.empty()) {
         return createErrorResult(HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA, "Spectral Flux");
     }
     
-    // Apply adaptive thresholding to emphasize onsets
-    applyAdaptiveThreshold(refFeatures, 0.1f);
-    applyAdaptiveThreshold(targetFeatures, 0.1f);
+    int hopSize = reference.hopSize;
+    size_t maxLag = calculateMaxLag(reference.audioLength, target.audioLength, hopSize);
     
-    // Apply median filtering
-    smoothFeatures(refFeatures, config_.spectralFlux.medianFilterSize);
-    smoothFeatures(targetFeatures, config_.spectralFlux.medianFilterSize);
+    std::vector<double> correlation;
+    CorrelationPeak peak;
+    double sampleOffset = 0.0;
     
-    // Normalize features
-    normalizeFeatures(refFeatures);
-    normalizeFeatures(targetFeatures);
-    
-    // Perform cross-correlation
-    auto correlation = crossCorrelate(refFeatures, targetFeatures);
-    auto peak = findBestAlignment(correlation);
+    if (!searchCoarseToFine(refFeatures, targetFeatures, hopSize, maxLag, correlation, peak, sampleOffset)) {
+        // Perform cross-correlation over the bounded lag window
+        peak = correlatePeak(refFeatures, targetFeatures, maxLag, hopSize,
+                             reference.spectra ? &reference.spectra->spectralFlux : nullptr, sampleOffset);
+    }
     
     if (peak.confidence < config_.confidenceThreshold) {
         return createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "Spectral Flux");
     }
     
-    // Convert feature index to sample offset
-    int64_t sampleOffset = static_cast<int64_t>(peak.index) * config_.hopSize - static_cast<int64_t>(refFeatures.size() * config_.hopSize / 2);
-    
-    // Calculate quality metrics
-    double snrEstimate = calculateSNREstimate(correlation, peak.index);
-    double noiseFloor = calculateNoiseFloor(correlation);
-    
-    return createResult(
+    harmoniq_sync_result_t result = createResult(
         sampleOffset,
         peak.confidence,
-        peak.value,
+        peakCoefficient(refFeatures, targetFeatures, sampleOffset, hopSize),
         peak.secondaryPeakRatio,
-        snrEstimate,
-        noiseFloor,
+        peak.snrEstimate,
+        peak.noiseFloorDb,
         "Spectral Flux"
     );
+    result.searched_offset_samples = searchedOffset(refFeatures.size(), targetFeatures.size(), maxLag, hopSize);
+    return result;
 }
 
-harmoniq_sync_result_t AlignmentEngine::alignChromaFeatures(const AudioProcessor& reference, const AudioProcessor& target) {
-    if (auto error = validateInputs(reference, target); error != HARMONIQ_SYNC_SUCCESS) {
-        return createErrorResult(error, "Chroma Features");
-    }
-    
-    // Extract chroma features (12-dimensional vectors)
-    auto refFeatures = reference.extractChromaFeatures(config_.windowSize, config_.hopSize);
-    auto targetFeatures = target.extractChromaFeatures(config_.windowSize, config_.hopSize);
+harmoniq_sync_result_t AlignmentEngine::alignChromaFeatures(const ClipFeatures& reference, const ClipFeatures& target) {
+    ScopedMethodTimer methodTimer(HARMONIQ_SYNC_CHROMA);
+    const auto& refFeatures = reference.chroma;
+    const auto& targetFeatures = target.chroma;
     
     if (refFeatures.empty() || targetFeatures.empty()) {
         return createErrorResult(HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA, "Chroma Features");
     }
     
-    // Chroma features are already normalized in extraction
+    int hopSize = reference.hopSize;
+    size_t maxLag = calculateMaxLag(reference.audioLength, target.audioLength, hopSize);
     
-    // For chroma features, we compute correlation on each chroma dimension and combine
-    std::vector<double> combinedCorrelation;
+    if (refFeatures.getNumDims() != targetFeatures.getNumDims()) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Chroma Features");
+    }
     
-    // Process each chroma dimension (C, C#, D, D#, E, F, F#, G, G#, A, A#, B)
-    for (int chromaDim = 0; chromaDim < config_.chroma.numChromaBins; ++chromaDim) {
-        // Extract single dimension
-        std::vector<float> refChroma, targetChroma;
-        
-        for (size_t i = chromaDim; i < refFeatures.size(); i += 12) {
-            refChroma.push_back(refFeatures[i]);
-        }
-        for (size_t i = chromaDim; i < targetFeatures.size(); i += 12) {
-            targetChroma.push_back(targetFeatures[i]);
-        }
-        
-        if (refChroma.empty() || targetChroma.empty()) continue;
-        
-        auto chromaCorrelation = crossCorrelate(refChroma, targetChroma);
-        
-        // Combine correlations (weighted average)
-        if (combinedCorrelation.empty()) {
-            combinedCorrelation = chromaCorrelation;
-        } else {
-            for (size_t i = 0; i < std::min(combinedCorrelation.size(), chromaCorrelation.size()); ++i) {
-                combinedCorrelation[i] = (combinedCorrelation[i] + chromaCorrelation[i]) / 2.0;
-            }
-        }
+    // All chroma dimensions (C, C#, D, ... for 12 bins) count equally in one multichannel pass
+    std::vector<double> combinedCorrelation;
+    {
+        ScopedStageTimer timer(ProcessingStage::Correlation);
+        combinedCorrelation = correlationEngine_.crossCorrelateMultichannel(
+            refFeatures, targetFeatures, maxLag, {}, config_.correlationMode,
+            reference.spectra ? &reference.spectra->chroma : nullptr);
     }
     
     if (combinedCorrelation.empty()) {
@@ -130,116 +422,90 @@ harmoniq_sync_result_t AlignmentEngine::alignChromaFeatures(const AudioProcessor
     }
     
     // Convert to sample offset
-    int64_t sampleOffset = static_cast<int64_t>(peak.index) * config_.hopSize - static_cast<int64_t>(refFeatures.size() / 12 * config_.hopSize / 2);
-    
-    double snrEstimate = calculateSNREstimate(combinedCorrelation, peak.index);
-    double noiseFloor = calculateNoiseFloor(combinedCorrelation);
+    double sampleOffset = interpolatedOffset(combinedCorrelation, peak.index, hopSize);
     
-    return createResult(
+    harmoniq_sync_result_t result = createResult(
         sampleOffset,
         peak.confidence,
-        peak.value,
+        peakCoefficient(refFeatures, targetFeatures, sampleOffset, hopSize, {}),
         peak.secondaryPeakRatio,
-        snrEstimate,
-        noiseFloor,
+        peak.snrEstimate,
+        peak.noiseFloorDb,
         "Chroma Features"
     );
+    result.searched_offset_samples = searchedOffset(refFeatures.getNumFrames(), targetFeatures.getNumFrames(), maxLag, hopSize);
+    return result;
 }
 
-harmoniq_sync_result_t AlignmentEngine::alignEnergyCorrelation(const AudioProcessor& reference, const AudioProcessor& target) {
-    if (auto error = validateInputs(reference, target); error != HARMONIQ_SYNC_SUCCESS) {
-        return createErrorResult(error, "Energy Correlation");
-    }
-    
-    // Extract energy profiles
-    auto refFeatures = reference.extractEnergyProfile(config_.windowSize, config_.hopSize);
-    auto targetFeatures = target.extractEnergyProfile(config_.windowSize, config_.hopSize);
+harmoniq_sync_result_t AlignmentEngine::alignEnergyCorrelation(const ClipFeatures& reference, const ClipFeatures& target) {
+    ScopedMethodTimer methodTimer(HARMONIQ_SYNC_ENERGY);
+    const auto& refFeatures = reference.energy;
+    const auto& targetFeatures = target.energy;
     
     if (refFeatures.empty() || targetFeatures.empty()) {
         return createErrorResult(HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA, "Energy Correlation");
     }
     
-    // Apply smoothing
-    smoothFeatures(refFeatures, config_.energy.smoothingWindowSize);
-    smoothFeatures(targetFeatures, config_.energy.smoothingWindowSize);
+    int hopSize = reference.energyHopSize;
+    size_t maxLag = calculateMaxLag(reference.audioLength, target.audioLength, hopSize);
     
-    // Normalize features
-    normalizeFeatures(refFeatures);
-    normalizeFeatures(targetFeatures);
+    std::vector<double> correlation;
+    CorrelationPeak peak;
+    double sampleOffset = 0.0;
     
-    // Perform cross-correlation
-    auto correlation = crossCorrelate(refFeatures, targetFeatures);
-    auto peak = findBestAlignment(correlation);
+    if (!searchCoarseToFine(refFeatures, targetFeatures, hopSize, maxLag, correlation, peak, sampleOffset)) {
+        // Perform cross-correlation over the bounded lag window
+        peak = correlatePeak(refFeatures, targetFeatures, maxLag, hopSize,
+                             reference.spectra ? &reference.spectra->energy : nullptr, sampleOffset);
+    }
     
     if (peak.confidence < config_.confidenceThreshold) {
         return createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "Energy Correlation");
     }
     
-    // Convert to sample offset
-    int64_t sampleOffset = static_cast<int64_t>(peak.index) * config_.hopSize - static_cast<int64_t>(refFeatures.size() * config_.hopSize / 2);
-    
-    double snrEstimate = calculateSNREstimate(correlation, peak.index);
-    double noiseFloor = calculateNoiseFloor(correlation);
     
-    return createResult(
+    harmoniq_sync_result_t result = createResult(
         sampleOffset,
         peak.confidence,
-        peak.value,
+        peakCoefficient(refFeatures, targetFeatures, sampleOffset, hopSize),
         peak.secondaryPeakRatio,
-        snrEstimate,
-        noiseFloor,
+        peak.snrEstimate,
+        peak.noiseFloorDb,
         "Energy Correlation"
     );
+    result.searched_offset_samples = searchedOffset(refFeatures.size(), targetFeatures.size(), maxLag, hopSize);
+    return result;
 }
 
-harmoniq_sync_result_t AlignmentEngine::alignMFCC(const AudioProcessor& reference, const AudioProcessor& target) {
-    if (auto error = validateInputs(reference, target); error != HARMONIQ_SYNC_SUCCESS) {
-        return createErrorResult(error, "MFCC");
-    }
-    
-    // Extract MFCC features
-    auto refFeatures = reference.extractMFCC(config_.mfcc.numCoeffs, config_.windowSize, config_.hopSize);
-    auto targetFeatures = target.extractMFCC(config_.mfcc.numCoeffs, config_.windowSize, config_.hopSize);
+harmoniq_sync_result_t AlignmentEngine::alignMFCC(const ClipFeatures& reference, const ClipFeatures& target) {
+    ScopedMethodTimer methodTimer(HARMONIQ_SYNC_MFCC);
+    const auto& refFeatures = reference.mfcc;
+    const auto& targetFeatures = target.mfcc;
     
     if (refFeatures.empty() || targetFeatures.empty()) {
         return createErrorResult(HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA, "MFCC");
     }
     
-    // For MFCC, we can either correlate the full feature vectors or individual coefficients
-    // We'll use the approach of correlating coefficient-wise and combining
+    int hopSize = reference.hopSize;
+    size_t maxLag = calculateMaxLag(reference.audioLength, target.audioLength, hopSize);
     
-    std::vector<double> combinedCorrelation;
+    if (refFeatures.getNumDims() != targetFeatures.getNumDims()) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "MFCC");
+    }
     
-    // Process each MFCC coefficient
-    for (int coeff = 0; coeff < config_.mfcc.numCoeffs; ++coeff) {
-        // Extract single coefficient across time
-        std::vector<float> refCoeff, targetCoeff;
-        
-        for (size_t i = coeff; i < refFeatures.size(); i += config_.mfcc.numCoeffs) {
-            refCoeff.push_back(refFeatures[i]);
-        }
-        for (size_t i = coeff; i < targetFeatures.size(); i += config_.mfcc.numCoeffs) {
-            targetCoeff.push_back(targetFeatures[i]);
-        }
-        
-        if (refCoeff.empty() || targetCoeff.empty()) continue;
-        
-        // Skip C0 if configured (energy-related coefficient)
-        if (!config_.mfcc.includeC0 && coeff == 0) continue;
-        
-        auto coeffCorrelation = crossCorrelate(refCoeff, targetCoeff);
-        
-        // Weight lower coefficients more (they contain more perceptually relevant information)
-        double weight = 1.0 / (1.0 + coeff * 0.1);
-        
-        if (combinedCorrelation.empty()) {
-            combinedCorrelation = coeffCorrelation;
-            for (double& val : combinedCorrelation) val *= weight;
-        } else {
-            for (size_t i = 0; i < std::min(combinedCorrelation.size(), coeffCorrelation.size()); ++i) {
-                combinedCorrelation[i] = (combinedCorrelation[i] + coeffCorrelation[i] * weight) / 2.0;
-            }
-        }
+    // Weight lower coefficients more (they contain more perceptually relevant information),
+    // and drop C0 unless configured (energy-related coefficient)
+    std::vector<double> weights(refFeatures.getNumDims());
+    for (size_t coeff = 0; coeff < weights.size(); ++coeff) {
+        weights[coeff] = (coeff == 0 && !config_.mfcc.includeC0) ? 0.0 : 1.0 / (1.0 + coeff * 0.1);
+    }
+    
+    std::vector<double> combinedCorrelation;
+    {
+        ScopedStageTimer timer(ProcessingStage::Correlation);
+        combinedCorrelation = correlationEngine_.crossCorrelateMultichannel(
+            refFeatures, targetFeatures, maxLag, weights, config_.correlationMode,
+            reference.spectra ? &reference.spectra->mfcc : nullptr);
     }
     
     if (combinedCorrelation.empty()) {
@@ -253,40 +519,145 @@ harmoniq_sync_result_t AlignmentEngine::alignMFCC(const AudioProcessor& referenc
     }
     
     // Convert to sample offset
-    int64_t sampleOffset = static_cast<int64_t>(peak.index) * config_.hopSize - static_cast<int64_t>(refFeatures.size() / config_.mfcc.numCoeffs * config_.hopSize / 2);
-    
-    double snrEstimate = calculateSNREstimate(combinedCorrelation, peak.index);
-    double noiseFloor = calculateNoiseFloor(combinedCorrelation);
+    double sampleOffset = interpolatedOffset(combinedCorrelation, peak.index, hopSize);
     
-    return createResult(
+    harmoniq_sync_result_t result = createResult(
         sampleOffset,
         peak.confidence,
-        peak.value,
+        peakCoefficient(refFeatures, targetFeatures, sampleOffset, hopSize, weights),
         peak.secondaryPeakRatio,
-        snrEstimate,
-        noiseFloor,
+        peak.snrEstimate,
+        peak.noiseFloorDb,
         "MFCC"
     );
+    result.searched_offset_samples = searchedOffset(refFeatures.getNumFrames(), targetFeatures.getNumFrames(), maxLag, hopSize);
+    return result;
 }
 
-harmoniq_sync_result_t AlignmentEngine::alignHybrid(const AudioProcessor& reference, const AudioProcessor& target) {
-    if (auto error = validateInputs(reference, target); error != HARMONIQ_SYNC_SUCCESS) {
-        return createErrorResult(error, "Hybrid");
+harmoniq_sync_result_t AlignmentEngine::alignFeatures(const ClipFeatures& reference, const ClipFeatures& target,
+                                                      harmoniq_sync_method_t method) {
+    switch (method) {
+        case HARMONIQ_SYNC_SPECTRAL_FLUX:
+            return alignSpectralFlux(reference, target);
+        case HARMONIQ_SYNC_CHROMA:
+            return alignChromaFeatures(reference, target);
+        case HARMONIQ_SYNC_ENERGY:
+            return alignEnergyCorrelation(reference, target);
+        case HARMONIQ_SYNC_MFCC:
+            return alignMFCC(reference, target);
+        case HARMONIQ_SYNC_HYBRID:
+            return alignHybrid(reference, target);
+        default:
+            return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Unknown");
+    }
+}
+
+harmoniq_sync_result_t AlignmentEngine::alignHybrid(const ClipFeatures& reference, const ClipFeatures& target) {
+    if (config_.cascade.enabled) {
+        return alignCascade(reference, target, [](harmoniq_sync_method_t) { return true; });
     }
     
-    // Run multiple algorithms
-    auto spectralResult = alignSpectralFlux(reference, target);
-    auto chromaResult = alignChromaFeatures(reference, target);
-    auto energyResult = alignEnergyCorrelation(reference, target);
-    auto mfccResult = alignMFCC(reference, target);
+    // Run the single methods on the shared feature streams, indexed by method
+    std::vector<harmoniq_sync_result_t> methodResults(PROFILED_METHOD_COUNT);
+    
+    ThreadPool& pool = ThreadPool::shared();
+    size_t workerCount = config_.concurrentHybrid
+        ? pool.resolveParallelism(methodResults.size(), static_cast<size_t>(std::max(0, config_.numWorkers)))
+        : 1;
     
-    // Collect valid results
+    if (workerCount <= 1) {
+        for (size_t i = 0; i < methodResults.size(); ++i) {
+            methodResults[i] = alignFeatures(reference, target, static_cast<harmoniq_sync_method_t>(i));
+        }
+    } else {
+        // The caller runs slot 0 on this engine and every helper slot owns one, so
+        // correlation scratch buffers are never shared. The prepared features are
+        // read-only and each method has its own spectrum cache.
+        std::vector<AlignmentEngine> helpers(workerCount - 1);
+        for (auto& helper : helpers) {
+            helper.setConfig(config_);
+        }
+        
+        StageProfile* profile = StageProfiler::active();
+        std::vector<StageProfile> slotProfiles(profile ? workerCount : 0);
+        auto cancellation = CancellationScope::current();
+        
+        pool.parallelFor(methodResults.size(), workerCount, [&](size_t index, size_t slot) {
+            StageProfiler profiler(profile ? &slotProfiles[slot] : nullptr);
+            CancellationScope scope(cancellation);
+            AlignmentEngine& engine = slot == 0 ? *this : helpers[slot - 1];
+            methodResults[index] = engine.alignFeatures(reference, target, static_cast<harmoniq_sync_method_t>(index));
+        });
+        
+        for (const auto& slotProfile : slotProfiles) {
+            profile->merge(slotProfile);
+        }
+    }
+    
+    // Collect valid results, in method order so the consensus does not depend on scheduling
     std::vector<harmoniq_sync_result_t> results;
-    if (spectralResult.error == HARMONIQ_SYNC_SUCCESS) results.push_back(spectralResult);
-    if (chromaResult.error == HARMONIQ_SYNC_SUCCESS) results.push_back(chromaResult);
-    if (energyResult.error == HARMONIQ_SYNC_SUCCESS) results.push_back(energyResult);
-    if (mfccResult.error == HARMONIQ_SYNC_SUCCESS) results.push_back(mfccResult);
+    for (const auto& result : methodResults) {
+        if (result.error == HARMONIQ_SYNC_SUCCESS) results.push_back(result);
+    }
+    
+    return combineHybridResults(results);
+}
+
+harmoniq_sync_result_t AlignmentEngine::alignCascade(const ClipFeatures& reference, const ClipFeatures& target,
+                                                     const std::function<bool(harmoniq_sync_method_t)>& extract) {
+    const auto& settings = config_.cascade;
+    
+    std::vector<harmoniq_sync_result_t> results;
+    for (harmoniq_sync_method_t method : CASCADE_ORDER) {
+        if (!extract(method)) {
+            return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Hybrid");
+        }
+        
+        // Failed methods (including those below confidenceThreshold) only pass the turn
+        auto result = alignFeatures(reference, target, method);
+        if (result.error != HARMONIQ_SYNC_SUCCESS) {
+            continue;
+        }
+        
+        // A confident method settles on its own, otherwise the first earlier result it agrees with
+        if (result.confidence >= settings.acceptConfidence) {
+            return combineHybridResults({result});
+        }
+        double tolerance = settings.toleranceSamples > 0 ? settings.toleranceSamples : reference.energyHopSize;
+        for (const auto& earlier : results) {
+            if (std::abs(earlier.offset_samples_fractional - result.offset_samples_fractional) <= tolerance) {
+                return combineHybridResults({earlier, result});
+            }
+        }
+        results.push_back(result);
+    }
+    
+    // Nothing settled: every method ran, so fall back to the full consensus
+    return combineHybridResults(results);
+}
+
+bool AlignmentEngine::extendFeatures(const AudioProcessor& audio, harmoniq_sync_method_t method, ClipFeatures& features) const {
+    ClipFeatures stage = prepareFeatures(audio, method);
+    if (stage.audioLength == 0) {
+        return false;
+    }
+    
+    if (features.audioLength == 0) {
+        features.method = HARMONIQ_SYNC_HYBRID;
+        features.audioLength = stage.audioLength;
+        features.sampleRate = stage.sampleRate;
+        features.hopSize = stage.hopSize;
+        features.energyHopSize = stage.energyHopSize;
+    }
     
+    if (features.spectralFlux.empty()) features.spectralFlux = std::move(stage.spectralFlux);
+    if (features.chroma.empty()) features.chroma = std::move(stage.chroma);
+    if (features.energy.empty()) features.energy = std::move(stage.energy);
+    if (features.mfcc.empty()) features.mfcc = std::move(stage.mfcc);
+    return true;
+}
+
+harmoniq_sync_result_t AlignmentEngine::combineHybridResults(const std::vector<harmoniq_sync_result_t>& results) const {
     if (results.empty()) {
         return createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "Hybrid");
     }
@@ -303,7 +674,7 @@ harmoniq_sync_result_t AlignmentEngine::alignHybrid(const AudioProcessor& refere
     for (const auto& result : results) {
         double weight = result.confidence;
         totalWeight += weight;
-        weightedOffset += result.offset_samples * weight;
+        weightedOffset += result.offset_samples_fractional * weight;
         weightedConfidence += result.confidence * weight;
         weightedCorrelation += result.peak_correlation * weight;
         weightedSNR += result.snr_estimate * weight;
@@ -311,7 +682,7 @@ harmoniq_sync_result_t AlignmentEngine::alignHybrid(const AudioProcessor& refere
     }
     
     if (totalWeight > 0.0) {
-        int64_t finalOffset = static_cast<int64_t>(weightedOffset / totalWeight);
+        double finalOffset = weightedOffset / totalWeight;
         double finalConfidence = weightedConfidence / totalWeight;
         double finalCorrelation = weightedCorrelation / totalWeight;
         double finalSNR = weightedSNR / totalWeight;
@@ -324,7 +695,7 @@ harmoniq_sync_result_t AlignmentEngine::alignHybrid(const AudioProcessor& refere
         }
         avgSecondaryRatio /= results.size();
         
-        return createResult(
+        harmoniq_sync_result_t combined = createResult(
             finalOffset,
             finalConfidence,
             finalCorrelation,
@@ -333,6 +704,13 @@ harmoniq_sync_result_t AlignmentEngine::alignHybrid(const AudioProcessor& refere
             finalNoiseFloor,
             "Hybrid"
         );
+        
+        // Only offsets every combined method could reach were searched by all of them
+        combined.searched_offset_samples = results.front().searched_offset_samples;
+        for (const auto& result : results) {
+            combined.searched_offset_samples = std::min(combined.searched_offset_samples, result.searched_offset_samples);
+        }
+        return combined;
     }
     
     return createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "Hybrid");
@@ -345,157 +723,407 @@ std::vector<harmoniq_sync_result_t> AlignmentEngine::alignBatch(
     const std::vector<AudioProcessor>& targets,
     harmoniq_sync_method_t method
 ) {
-    std::vector<harmoniq_sync_result_t> results;
-    results.reserve(targets.size());
+    std::vector<harmoniq_sync_result_t> results(targets.size());
+    if (targets.empty()) {
+        return results;
+    }
     
-    for (const auto& target : targets) {
-        harmoniq_sync_result_t result;
-        
-        switch (method) {
-            case HARMONIQ_SYNC_SPECTRAL_FLUX:
-                result = alignSpectralFlux(reference, target);
-                break;
-            case HARMONIQ_SYNC_CHROMA:
-                result = alignChromaFeatures(reference, target);
-                break;
-            case HARMONIQ_SYNC_ENERGY:
-                result = alignEnergyCorrelation(reference, target);
-                break;
-            case HARMONIQ_SYNC_MFCC:
-                result = alignMFCC(reference, target);
-                break;
-            case HARMONIQ_SYNC_HYBRID:
-                result = alignHybrid(reference, target);
-                break;
-            default:
-                result = createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Unknown");
-                break;
+    if (method < HARMONIQ_SYNC_SPECTRAL_FLUX || method > HARMONIQ_SYNC_HYBRID) {
+        std::fill(results.begin(), results.end(), createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Unknown"));
+        return results;
+    }
+    
+    if (!reference.isValid()) {
+        std::fill(results.begin(), results.end(), createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, getMethodName(method)));
+        return results;
+    }
+    
+    // Reference features are extracted once and shared read-only by every worker
+    auto refFeatures = prepareReferenceFeatures(reference, method);
+    if (refFeatures.audioLength == 0) {
+        std::fill(results.begin(), results.end(), createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, getMethodName(method)));
+        return results;
+    }
+    
+    return alignBatch(refFeatures, targets, method);
+}
+
+std::vector<harmoniq_sync_result_t> AlignmentEngine::alignBatch(
+    const ClipFeatures& refFeatures,
+    const std::vector<AudioProcessor>& targets,
+    harmoniq_sync_method_t method
+) {
+    std::vector<harmoniq_sync_result_t> results(targets.size());
+    if (targets.empty()) {
+        return results;
+    }
+    
+    ThreadPool& pool = ThreadPool::shared();
+    size_t workerCount = pool.resolveParallelism(targets.size(), static_cast<size_t>(std::max(0, config_.numWorkers)));
+    
+    if (workerCount <= 1) {
+        for (size_t i = 0; i < targets.size(); ++i) {
+            results[i] = alignPrepared(refFeatures, targets[i], method);
         }
-        
-        results.push_back(result);
+        return results;
+    }
+    
+    // Each slot owns an engine so correlation scratch buffers are never shared.
+    // Targets are distinct processors, so their spectrogram caches are only
+    // touched by the worker that aligns them.
+    std::vector<AlignmentEngine> workers(workerCount);
+    for (auto& worker : workers) {
+        worker.setConfig(config_);
+        worker.setFeatureCache(featureCache_);
+    }
+    
+    // Workers profile into their own slot; the caller's profile receives the sum
+    StageProfile* profile = StageProfiler::active();
+    std::vector<StageProfile> slotProfiles(profile ? workerCount : 0);
+    auto cancellation = CancellationScope::current();
+    
+    pool.parallelFor(targets.size(), workerCount, [&](size_t index, size_t slot) {
+        StageProfiler profiler(profile ? &slotProfiles[slot] : nullptr);
+        CancellationScope scope(cancellation);
+        results[index] = workers[slot].alignPrepared(refFeatures, targets[index], method);
+    });
+    
+    for (const auto& slotProfile : slotProfiles) {
+        profile->merge(slotProfile);
     }
     
     return results;
 }
 
-// MARK: - Core Correlation Functions
+// MARK: - Clip Grouping
 
-std::vector<double> AlignmentEngine::crossCorrelate(const std::vector<float>& a, const std::vector<float>& b) const {
-    if (a.empty() || b.empty()) return {};
-    
-    size_t maxLag = std::min(a.size(), b.size());
-    size_t correlationSize = 2 * maxLag - 1;
-    std::vector<double> correlation(correlationSize, 0.0);
+AlignmentEngine::ClipGrouping AlignmentEngine::groupClips(const std::vector<AudioProcessor>& clips) {
+    ClipGrouping grouping;
+    const size_t count = clips.size();
+    if (count == 0) {
+        return grouping;
+    }
     
-    // Calculate cross-correlation for different lags
-    for (size_t lag = 0; lag < correlationSize; ++lag) {
-        int actualLag = static_cast<int>(lag) - static_cast<int>(maxLag) + 1;
-        double sum = 0.0;
-        size_t count = 0;
-        
-        for (size_t i = 0; i < a.size(); ++i) {
-            int j = static_cast<int>(i) + actualLag;
-            if (j >= 0 && j < static_cast<int>(b.size())) {
-                sum += a[i] * b[j];
-                count++;
+    const auto& settings = config_.grouping;
+    const auto& landmarkSettings = config_.landmarks;
+    const double sampleRate = clips[0].getSampleRate();
+    
+    // Stage 1: spectral flux and landmarks of every clip. Clips that cannot be
+    // prepared keep empty features and end up alone in their own group.
+    std::vector<ClipFeatures> features(count);
+    std::vector<std::vector<LandmarkIndex::Landmark>> landmarks(count);
+    parallelForEach(count, [&](AlignmentEngine& engine, size_t index) {
+        const auto& clip = clips[index];
+        if (!clip.isValid() || clip.getLength() == 0 || std::abs(clip.getSampleRate() - sampleRate) > 1.0) {
+            return;
+        }
+        features[index] = engine.prepareFeatures(clip, HARMONIQ_SYNC_SPECTRAL_FLUX);
+        if (features[index].audioLength > 0) {
+            landmarks[index] = engine.extractLandmarks(clip, features[index]);
+        }
+    });
+    
+    LandmarkIndex index(landmarks, landmarkSettings.fingerprint);
+    
+    // Stage 2: every clip proposes the clips sharing most fingerprints with it. A query
+    // also finds the clip itself, so it asks for that many extra matches.
+    size_t offsetsPerPair = std::max<size_t>(1, landmarkSettings.maxCandidates);
+    size_t maxMatches = (settings.maxPairsPerClip + 1) * offsetsPerPair;
+    std::vector<std::vector<LandmarkIndex::Match>> matches(count);
+    parallelForEach(count, [&](AlignmentEngine&, size_t clip) {
+        ScopedStageTimer timer(ProcessingStage::PeakPicking);
+        matches[clip] = index.query(landmarks[clip], maxMatches, landmarkSettings.toleranceFrames,
+                                    landmarkSettings.minVotes);
+    });
+    
+    // Candidate offsets per pair, keyed by (lower, higher) clip index with the lower clip as reference
+    struct Candidate {
+        size_t votes = 0;
+        std::vector<int64_t> offsetFrames;
+    };
+    std::map<std::pair<size_t, size_t>, Candidate> candidates;
+    for (size_t clip = 0; clip < count; ++clip) {
+        std::vector<size_t> partners;
+        for (const auto& match : matches[clip]) {
+            if (match.clip == clip) continue;
+            if (std::find(partners.begin(), partners.end(), match.clip) == partners.end()) {
+                if (partners.size() == settings.maxPairsPerClip) continue;
+                partners.push_back(match.clip);
             }
+            
+            // Match offsets are query (target) frames minus indexed (reference) frames
+            bool queryIsTarget = match.clip < clip;
+            auto& candidate = candidates[{std::min(clip, match.clip), std::max(clip, match.clip)}];
+            int64_t offset = queryIsTarget ? match.offsetFrames : -match.offsetFrames;
+            bool known = std::any_of(candidate.offsetFrames.begin(), candidate.offsetFrames.end(), [&](int64_t existing) {
+                return std::abs(existing - offset) <= 2 * static_cast<int64_t>(std::max(0, landmarkSettings.toleranceFrames));
+            });
+            if (!known && candidate.offsetFrames.size() < offsetsPerPair) {
+                candidate.offsetFrames.push_back(offset);
+            }
+            candidate.votes = std::max(candidate.votes, match.votes);
         }
+    }
+    
+    // Stage 3: dense verification of the candidate pairs only
+    std::vector<const Candidate*> pending;
+    for (const auto& [key, candidate] : candidates) {
+        PairAlignment pair;
+        pair.reference = key.first;
+        pair.target = key.second;
+        pair.votes = candidate.votes;
+        pair.result = createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "Landmarks");
+        grouping.pairs.push_back(pair);
+        pending.push_back(&candidate);
+    }
+    
+    parallelForEach(grouping.pairs.size(), [&](AlignmentEngine& engine, size_t k) {
+        auto& pair = grouping.pairs[k];
+        const auto& reference = features[pair.reference];
+        const auto& target = features[pair.target];
+        auto result = engine.verifyLandmarkOffsets(reference, target, pending[k]->offsetFrames);
+        pair.result = engine.finishLandmarkResult(result, reference, target, clips[pair.target], &clips[pair.reference]);
+    });
+    
+    // Stage 4: one start position per clip from all verified offsets
+    std::vector<TimelineSolver::Measurement> measurements;
+    std::vector<size_t> measuredPairs;
+    int hopSize = 0;
+    for (size_t k = 0; k < grouping.pairs.size(); ++k) {
+        const auto& pair = grouping.pairs[k];
+        if (pair.result.error != HARMONIQ_SYNC_SUCCESS) continue;
         
-        if (count > 0) {
-            correlation[lag] = sum / count;
+        measurements.push_back({pair.reference, pair.target, pair.result.offset_samples_fractional,
+                                std::max(pair.result.confidence, 1e-6)});
+        measuredPairs.push_back(k);
+        hopSize = std::max(hopSize, features[pair.reference].hopSize);
+    }
+    
+    double tolerance = settings.toleranceSamples > 0.0 ? settings.toleranceSamples : 2.0 * hopSize;
+    auto solution = TimelineSolver::solve(count, measurements, tolerance);
+    for (size_t m = 0; m < measurements.size(); ++m) {
+        grouping.pairs[measuredPairs[m]].consistent = solution.consistent[m];
+    }
+    
+    grouping.clips = std::move(solution.clips);
+    grouping.groupCount = solution.groupCount;
+    return grouping;
+}
+
+void AlignmentEngine::parallelForEach(size_t count, const std::function<void(AlignmentEngine&, size_t)>& body) {
+    ThreadPool& pool = ThreadPool::shared();
+    size_t workerCount = pool.resolveParallelism(count, static_cast<size_t>(std::max(0, config_.numWorkers)));
+    
+    if (workerCount <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            body(*this, i);
         }
+        return;
+    }
+    
+    // The caller runs slot 0 on this engine and every helper slot owns one
+    std::vector<AlignmentEngine> helpers(workerCount - 1);
+    for (auto& helper : helpers) {
+        helper.setConfig(config_);
+        helper.setFeatureCache(featureCache_);
+    }
+    
+    StageProfile* profile = StageProfiler::active();
+    std::vector<StageProfile> slotProfiles(profile ? workerCount : 0);
+    auto cancellation = CancellationScope::current();
+    
+    pool.parallelFor(count, workerCount, [&](size_t index, size_t slot) {
+        StageProfiler profiler(profile ? &slotProfiles[slot] : nullptr);
+        CancellationScope scope(cancellation);
+        body(slot == 0 ? *this : helpers[slot - 1], index);
+    });
+    
+    for (const auto& slotProfile : slotProfiles) {
+        profile->merge(slotProfile);
+    }
+}
+
+// MARK: - Core Correlation Functions
+
+std::vector<double> AlignmentEngine::crossCorrelate(const std::vector<float>& a, const std::vector<float>& b, size_t maxLag,
+                                                    CorrelationEngine::SpectrumCache* cacheA) const {
+    // Direct loop for short vectors, zero-padded FFT for long ones (same per-lag normalization)
+    // Only lags in [-maxLag, +maxLag] are evaluated, so peak picking is bounded as well
+    ScopedStageTimer timer(ProcessingStage::Correlation);
+    return correlationEngine_.crossCorrelate(a, b, maxLag, config_.correlationMode, cacheA);
+}
+
+AlignmentEngine::CorrelationPeak AlignmentEngine::correlatePeak(const std::vector<float>& a, const std::vector<float>& b,
+                                                                size_t maxLag, int hopSize,
+                                                                CorrelationEngine::SpectrumCache* cacheA,
+                                                                double& sampleOffset) const {
+    size_t partitionLength = config_.correlationMode == CorrelationEngine::Mode::Direct ? 0
+        : CorrelationEngine::partitionLengthForBudget(a.size(), b.size(), maxLag, config_.correlationMemoryBytes,
+                                                      correlationEngine_.getPrecision());
+    if (partitionLength == 0) {
+        auto correlation = crossCorrelate(a, b, maxLag, cacheA);
+        CorrelationPeak peak = findBestAlignment(correlation);
+        sampleOffset = interpolatedOffset(correlation, peak.index, hopSize);
+        return peak;
+    }
+    
+    // Each block of lags is analysed as it arrives; peak picking times itself inside the correlation stage
+    CorrelationAnalyzer analysis(config_.peakPicking.maxPeaks, config_.peakPicking.exclusionRadius);
+    {
+        ScopedStageTimer timer(ProcessingStage::Correlation);
+        correlationEngine_.crossCorrelatePartitioned(a, b, maxLag, partitionLength, [&](const double* values, size_t count) {
+            ScopedStageTimer peakTimer(ProcessingStage::PeakPicking);
+            analysis.push(values, count);
+        }, cacheA);
     }
     
-    return correlation;
+    CorrelationPeak peak;
+    {
+        ScopedStageTimer timer(ProcessingStage::PeakPicking);
+        analysis.finish();
+        peak = scorePeak(analysis);
+    }
+    
+    // Parabolic interpolation only needs the lags next to the peak
+    int64_t window = static_cast<int64_t>(CorrelationEngine::lagWindow(a.size(), b.size(), maxLag));
+    int64_t lag = static_cast<int64_t>(peak.index) - window;
+    sampleOffset = static_cast<double>(lagIndexToSamples(peak.index, static_cast<size_t>(2 * window + 1), hopSize));
+    if (lag > -window && lag < window) {
+        auto neighbours = correlationEngine_.crossCorrelateRange(a, b, lag - 1, lag + 1);
+        sampleOffset += interpolatePeak(neighbours, 1) * hopSize;
+    }
+    return peak;
 }
 
-AlignmentEngine::CorrelationPeak AlignmentEngine::findBestAlignment(const std::vector<double>& correlation) const {
-    if (correlation.empty()) {
-        return {0, 0.0, 0.0, 1.0};
+bool AlignmentEngine::searchCoarseToFine(const std::vector<float>& reference, const std::vector<float>& target,
+                                         int hopSize, size_t maxLag,
+                                         std::vector<double>& coarseCorrelation,
+                                         CorrelationPeak& peak, double& sampleOffset) const {
+    ScopedStageTimer timer(ProcessingStage::Correlation);
+    const auto& settings = config_.coarseToFine;
+    if (settings.hopSize <= 0 || hopSize <= 0) return false;
+    
+    size_t factor = static_cast<size_t>(settings.hopSize / hopSize);
+    if (factor < 2) return false;
+    
+    std::vector<float> coarseReference = decimateFeatures(reference, factor);
+    std::vector<float> coarseTarget = decimateFeatures(target, factor);
+    if (std::min(coarseReference.size(), coarseTarget.size()) < settings.minCoarseFrames) {
+        return false;
     }
     
-    // Find maximum correlation
-    auto maxIt = std::max_element(correlation.begin(), correlation.end());
-    size_t maxIndex = std::distance(correlation.begin(), maxIt);
-    double maxValue = *maxIt;
+    // Stage 1: full lag window on the decimated envelopes
+    size_t coarseMaxLag = (maxLag + factor - 1) / factor;
+    coarseCorrelation = crossCorrelate(coarseReference, coarseTarget, coarseMaxLag);
+    peak = findBestAlignment(coarseCorrelation);
+    
+    int64_t coarseWindow = static_cast<int64_t>(coarseCorrelation.size() - 1) / 2;
+    int64_t candidateLag = (static_cast<int64_t>(peak.index) - coarseWindow) * static_cast<int64_t>(factor);
+    
+    // Stage 2: full-resolution lags around the candidate only
+    int64_t radius = static_cast<int64_t>(std::max(1, settings.refineRadius)) * static_cast<int64_t>(factor);
+    int64_t limit = static_cast<int64_t>(CorrelationEngine::lagWindow(reference.size(), target.size(), maxLag));
+    int64_t firstLag = std::max(-limit, candidateLag - radius);
+    int64_t lastLag = std::min(limit, candidateLag + radius);
+    if (firstLag > lastLag) return false;
+    
+    auto fineCorrelation = correlationEngine_.crossCorrelateRange(reference, target, firstLag, lastLag);
+    auto fineIt = std::max_element(fineCorrelation.begin(), fineCorrelation.end());
+    size_t fineIndex = static_cast<size_t>(std::distance(fineCorrelation.begin(), fineIt));
+    
+    // Confidence metrics stay on the coarse curve, which covers the whole search range
+    peak.value = *fineIt;
+    sampleOffset = (static_cast<double>(firstLag + static_cast<int64_t>(fineIndex))
+                    + interpolatePeak(fineCorrelation, fineIndex)) * hopSize;
+    return true;
+}
+
+std::vector<float> AlignmentEngine::decimateFeatures(const std::vector<float>& features, size_t factor) const {
+    std::vector<float> decimated;
+    decimated.reserve(features.size() / factor);
+    
+    // Block means keep the envelope shape without aliasing single-frame spikes
+    for (size_t start = 0; start + factor <= features.size(); start += factor) {
+        float sum = std::accumulate(features.begin() + start, features.begin() + start + factor, 0.0f);
+        decimated.push_back(sum / static_cast<float>(factor));
+    }
     
-    // Find second highest peak (for secondary peak ratio)
-    double secondMax = -1e10; // Use large negative number instead of infinity
-    for (size_t i = 0; i < correlation.size(); ++i) {
-        if (i != maxIndex && correlation[i] > secondMax) {
-            secondMax = correlation[i];
-        }
+    normalizeFeatures(decimated);
+    return decimated;
+}
+
+AlignmentEngine::CorrelationPeak AlignmentEngine::findBestAlignment(const std::vector<double>& correlation) const {
+    ScopedStageTimer timer(ProcessingStage::PeakPicking);
+    
+    // One pass over the curve gathers the peaks and every statistic scored below
+    CorrelationAnalyzer analysis(config_.peakPicking.maxPeaks, config_.peakPicking.exclusionRadius);
+    analysis.analyze(correlation);
+    return scorePeak(analysis);
+}
+
+AlignmentEngine::CorrelationPeak AlignmentEngine::scorePeak(const CorrelationAnalyzer& analysis) const {
+    const auto& peaks = analysis.getPeaks();
+    if (peaks.empty()) {
+        return {0, 0.0, 0.0, 1.0};
     }
     
-    double secondaryPeakRatio = (secondMax > 0) ? (maxValue / secondMax) : 1e10;
+    CorrelationPeak peak = {peaks[0].index, peaks[0].value, 0.0, 1e10};
     
-    // Calculate confidence based on peak prominence
-    double confidence = calculateConfidence(correlation, maxIndex);
+    // The runner-up is a separate peak, not a neighbouring lag of the same one
+    if (peaks.size() > 1 && peaks[1].value > 0) {
+        peak.secondaryPeakRatio = peaks[0].value / peaks[1].value;
+    }
     
-    return {maxIndex, maxValue, confidence, secondaryPeakRatio};
+    peak.confidence = calculateConfidence(analysis);
+    peak.snrEstimate = calculateSNREstimate(analysis);
+    peak.noiseFloorDb = calculateNoiseFloor(analysis);
+    return peak;
 }
 
-AlignmentEngine::ConfidenceFactors AlignmentEngine::calculateConfidenceFactors(const std::vector<double>& correlation, size_t peakIndex) const {
+AlignmentEngine::ConfidenceFactors AlignmentEngine::calculateConfidenceFactors(const CorrelationAnalyzer& analysis) const {
     ConfidenceFactors factors;
     
-    if (correlation.empty() || peakIndex >= correlation.size()) {
+    const auto& peaks = analysis.getPeaks();
+    if (peaks.empty()) {
         return factors; // Return zeros
     }
     
-    double peakValue = correlation[peakIndex];
+    double peakValue = std::abs(peaks[0].value);
     
     // Factor 1: Correlation Strength (Peak Height)
     // Normalize the raw peak value by the energy of the correlation function
-    double correlationEnergy = 0.0;
-    for (double val : correlation) {
-        correlationEnergy += val * val;
-    }
-    correlationEnergy = std::sqrt(correlationEnergy / correlation.size());
-    
+    double correlationEnergy = analysis.rms();
     if (correlationEnergy > 1e-10) {
-        factors.correlationStrength = std::abs(peakValue) / correlationEnergy;
-        factors.correlationStrength = std::max(0.0, std::min(1.0, factors.correlationStrength));
+        factors.correlationStrength = std::max(0.0, std::min(1.0, peakValue / correlationEnergy));
     }
     
     // Factor 2: Peak Sharpness (Clarity)
     // Ratio of primary peak to average correlation value
-    double mean = std::accumulate(correlation.begin(), correlation.end(), 0.0) / correlation.size();
-    double avgAbsCorrelation = 0.0;
-    for (double val : correlation) {
-        avgAbsCorrelation += std::abs(val);
-    }
-    avgAbsCorrelation /= correlation.size();
-    
+    double avgAbsCorrelation = analysis.meanAbs();
     if (avgAbsCorrelation > 1e-10) {
-        factors.peakSharpness = std::abs(peakValue) / avgAbsCorrelation;
         // Normalize to [0,1] using tanh to handle extreme values
-        factors.peakSharpness = std::tanh(factors.peakSharpness / 10.0);
+        factors.peakSharpness = std::tanh(peakValue / avgAbsCorrelation / 10.0);
     }
     
     // Factor 3: Signal-to-Noise Ratio (Secondary Peak Ratio)
-    // Find second highest peak
-    double secondMaxValue = -1e10;
-    for (size_t i = 0; i < correlation.size(); ++i) {
-        if (i != peakIndex && correlation[i] > secondMaxValue) {
-            secondMaxValue = correlation[i];
-        }
-    }
+    double secondMaxValue = peaks.size() > 1 ? peaks[1].value : 0.0;
     
-    if (secondMaxValue > 1e-10 && std::abs(peakValue) > 1e-10) {
-        factors.snr = std::abs(peakValue) / std::abs(secondMaxValue);
+    if (secondMaxValue > 1e-10 && peakValue > 1e-10) {
+        factors.snr = peakValue / secondMaxValue;
         // Convert to [0,1] range using logarithmic scaling
         factors.snr = std::tanh(std::log(factors.snr + 1.0) / 3.0);
-    } else if (std::abs(peakValue) > 1e-10) {
+    } else if (peakValue > 1e-10) {
         factors.snr = 1.0; // Perfect SNR if no secondary peak
     }
     
     return factors;
 }
 
-double AlignmentEngine::calculateConfidence(const std::vector<double>& correlation, size_t peakIndex) const {
-    if (correlation.empty()) return 0.0;
+double AlignmentEngine::calculateConfidence(const CorrelationAnalyzer& analysis) const {
+    ScopedStageTimer timer(ProcessingStage::Confidence);
+    if (analysis.size() == 0) return 0.0;
     
-    ConfidenceFactors factors = calculateConfidenceFactors(correlation, peakIndex);
+    ConfidenceFactors factors = calculateConfidenceFactors(analysis);
     
     // Combine factors into a single score [0.0, 1.0]
     // Weighted average as specified in Sprint 2 plan
@@ -506,103 +1134,536 @@ double AlignmentEngine::calculateConfidence(const std::vector<double>& correlati
     return std::max(0.0, std::min(1.0, confidence));
 }
 
-double AlignmentEngine::calculateSNREstimate(const std::vector<double>& correlation, size_t peakIndex) const {
-    if (correlation.empty()) return 0.0;
+double AlignmentEngine::calculateSNREstimate(const CorrelationAnalyzer& analysis) const {
+    ScopedStageTimer timer(ProcessingStage::Confidence);
+    if (analysis.getPeaks().empty()) return 0.0;
     
-    double signal = correlation[peakIndex];
+    double signal = analysis.getPeaks().front().value;
     
-    // Estimate noise as the median of correlation values (excluding peak region)
-    std::vector<double> noiseValues;
-    int exclusionWindow = 10;
+    // Estimate noise as the median magnitude outside the peak region
+    double noise = analysis.noiseQuantile(0.5);
+    if (noise > 0) {
+        return 20.0 * std::log10(std::abs(signal) / noise);
+    }
     
-    for (size_t i = 0; i < correlation.size(); ++i) {
-        if (abs(static_cast<int>(i) - static_cast<int>(peakIndex)) > exclusionWindow) {
-            noiseValues.push_back(std::abs(correlation[i]));
+    return 40.0; // High SNR if noise is effectively zero
+}
+
+double AlignmentEngine::calculateNoiseFloor(const CorrelationAnalyzer& analysis) const {
+    ScopedStageTimer timer(ProcessingStage::Confidence);
+    if (analysis.size() == 0) return -60.0;
+    
+    // Find the 10th percentile as noise floor estimate
+    return 20.0 * std::log10(analysis.absQuantile(0.1) + 1e-10);
+}
+
+// MARK: - Offset Refinement
+
+std::vector<AlignmentEngine::SampleExcerpt> AlignmentEngine::selectExcerpts(const AudioProcessor& audio) const {
+    return selectExcerpts(audio, 0, audio.getLength());
+}
+
+std::vector<AlignmentEngine::SampleExcerpt> AlignmentEngine::selectExcerpts(const AudioProcessor& audio,
+                                                                            size_t first, size_t last) const {
+    std::vector<SampleExcerpt> excerpts;
+    const auto& samples = audio.getAudioData();
+    last = std::min(last, samples.size());
+    if (first >= last) return excerpts;
+    
+    size_t segment = std::min(config_.refinement.segmentSize, last - first);
+    if (!config_.refinement.sampleDomain || segment == 0 || config_.refinement.maxExcerpts == 0) {
+        return excerpts;
+    }
+    
+    // Evenly spaced, half-overlapping candidates; the loudest ones carry the most phase information
+    size_t span = last - first - segment;
+    size_t candidates = std::min(MAX_EXCERPT_CANDIDATES, span / std::max<size_t>(1, segment / 2) + 1);
+    
+    std::vector<std::pair<float, size_t>> ranked;
+    ranked.reserve(candidates);
+    for (size_t c = 0; c < candidates; ++c) {
+        size_t start = first + (candidates > 1 ? span * c / (candidates - 1) : 0);
+        float energy = DSP::sumOfSquares(samples.data() + start, segment);
+        if (energy > 0.0f) {
+            ranked.emplace_back(energy, start);
         }
     }
     
-    if (noiseValues.empty()) return 40.0; // Default high SNR
+    size_t keep = std::min(config_.refinement.maxExcerpts, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
     
-    std::sort(noiseValues.begin(), noiseValues.end());
-    double noise = noiseValues[noiseValues.size() / 2]; // Median
+    // Kept in descending energy order so refinement can take the first one that fits
+    for (size_t k = 0; k < keep; ++k) {
+        size_t start = ranked[k].second;
+        excerpts.push_back({start, std::vector<float>(samples.begin() + start, samples.begin() + start + segment)});
+    }
+    return excerpts;
+}
+
+harmoniq_sync_result_t AlignmentEngine::refineWithSamples(harmoniq_sync_result_t result,
+                                                          const std::vector<SampleExcerpt>& excerpts,
+                                                          const AudioProcessor& target,
+                                                          const ClipFeatures& features) const {
+    ScopedStageTimer timer(ProcessingStage::Refinement);
+    
+    if (result.error != HARMONIQ_SYNC_SUCCESS || !config_.refinement.sampleDomain || excerpts.empty()) {
+        return result;
+    }
     
-    if (noise > 0) {
-        return 20.0 * std::log10(std::abs(signal) / noise);
+    // The feature offset is accurate to about one hop of the coarsest stream used
+    bool usesEnergy = features.method == HARMONIQ_SYNC_ENERGY || features.method == HARMONIQ_SYNC_HYBRID;
+    int64_t radius = std::max(features.hopSize, usesEnergy ? features.energyHopSize : 0);
+    if (radius <= 0) return result;
+    
+    const auto& targetSamples = target.getAudioData();
+    const double drift = result.drift_ppm * 1e-6;
+    
+    // With drift the offset at an excerpt follows the fitted line
+    auto offsetAt = [&](size_t position) {
+        return static_cast<int64_t>(std::llround(result.offset_samples_fractional + drift * position));
+    };
+    
+    // Loudest excerpt whose counterpart lies entirely inside the target
+    const SampleExcerpt* excerpt = nullptr;
+    for (const auto& candidate : excerpts) {
+        int64_t start = static_cast<int64_t>(candidate.start) + offsetAt(candidate.start);
+        int64_t length = static_cast<int64_t>(candidate.samples.size());
+        if (start >= 0 && start + length <= static_cast<int64_t>(targetSamples.size()) &&
+            length >= MIN_REFINEMENT_HOPS * radius) {
+            excerpt = &candidate;
+            break;
+        }
     }
+    if (!excerpt) return result;
     
-    return 40.0; // High SNR if noise is effectively zero
+    const int64_t offset = offsetAt(excerpt->start);
+    auto targetBegin = targetSamples.begin() + (static_cast<int64_t>(excerpt->start) + offset);
+    std::vector<float> targetSegment(targetBegin, targetBegin + excerpt->samples.size());
+    
+    auto phat = correlationEngine_.crossCorrelatePHAT(excerpt->samples, targetSegment, static_cast<size_t>(radius));
+    auto peakIt = std::max_element(phat.begin(), phat.end());
+    size_t peakIndex = static_cast<size_t>(std::distance(phat.begin(), peakIt));
+    int64_t window = static_cast<int64_t>(phat.size() - 1) / 2;
+    int64_t residual = static_cast<int64_t>(peakIndex) - window;
+    
+    // A weak or edge peak means the samples do not confirm any lag near the feature offset
+    if (*peakIt < MIN_PHAT_PEAK || std::abs(residual) == window) {
+        return result;
+    }
+    
+    double refined = static_cast<double>(offset + residual) + interpolatePeak(phat, peakIndex)
+                   - drift * excerpt->start;
+    result.offset_samples_fractional = refined;
+    result.offset_samples = static_cast<int64_t>(std::llround(refined));
+    return result;
 }
 
-double AlignmentEngine::calculateNoiseFloor(const std::vector<double>& correlation) const {
-    if (correlation.empty()) return -60.0;
+// MARK: - Landmark Search
+
+std::vector<LandmarkIndex::Landmark> AlignmentEngine::extractLandmarks(const AudioProcessor& audio,
+                                                                       const ClipFeatures& features) const {
+    ScopedStageTimer timer(ProcessingStage::FeatureExtraction);
+    const auto& settings = config_.landmarks;
+    
+    std::vector<size_t> onsets;
+    detectOnsets(features.spectralFlux, onsets, settings.onsetThreshold, settings.onsetWindow);
+    return LandmarkIndex::extractLandmarks(onsets, audio, features.hopSize, settings.fingerprint);
+}
+
+AlignmentEngine::ClipFeatures AlignmentEngine::prepareLandmarkReference(const AudioProcessor& audio) const {
+    ClipFeatures features = prepareReferenceFeatures(audio, HARMONIQ_SYNC_SPECTRAL_FLUX);
+    if (features.audioLength == 0) {
+        return features;
+    }
     
-    // Find the 10th percentile as noise floor estimate
-    std::vector<double> sortedValues = correlation;
-    for (double& val : sortedValues) {
-        val = std::abs(val);
+    features.landmarks = std::make_shared<const LandmarkIndex>(
+        std::vector<std::vector<LandmarkIndex::Landmark>>{extractLandmarks(audio, features)},
+        config_.landmarks.fingerprint);
+    return features;
+}
+
+harmoniq_sync_result_t AlignmentEngine::alignLandmarks(const AudioProcessor& reference, const AudioProcessor& target) {
+    if (auto error = validateInputs(reference, target); error != HARMONIQ_SYNC_SUCCESS) {
+        return createErrorResult(error, "Landmarks");
     }
-    std::sort(sortedValues.begin(), sortedValues.end());
     
-    double noiseFloor = sortedValues[sortedValues.size() / 10];
-    return 20.0 * std::log10(noiseFloor + 1e-10);
+    ClipFeatures refFeatures = prepareLandmarkReference(reference);
+    if (refFeatures.audioLength == 0) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Landmarks");
+    }
+    return searchLandmarks(refFeatures, target, &reference);
 }
 
-// MARK: - Feature Processing
+harmoniq_sync_result_t AlignmentEngine::alignLandmarks(const ClipFeatures& reference, const AudioProcessor& target) {
+    return searchLandmarks(reference, target, nullptr);
+}
 
-void AlignmentEngine::smoothFeatures(std::vector<float>& features, int filterSize) const {
-    if (features.size() < 3 || filterSize < 3) return;
+harmoniq_sync_result_t AlignmentEngine::searchLandmarks(const ClipFeatures& reference, const AudioProcessor& target,
+                                                        const AudioProcessor* referenceAudio) {
+    const auto& settings = config_.landmarks;
+    
+    if (!reference.landmarks || reference.audioLength == 0 || !target.isValid()) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Landmarks");
+    }
+    
+    if (std::abs(reference.sampleRate - target.getSampleRate()) > 1.0) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT, "Landmarks");
+    }
+    
+    ClipFeatures targetFeatures = prepareFeatures(target, HARMONIQ_SYNC_SPECTRAL_FLUX);
+    if (targetFeatures.audioLength == 0) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "Landmarks");
+    }
     
-    std::vector<float> smoothed = features;
-    int halfSize = filterSize / 2;
+    if (reference.spectralFlux.empty() || targetFeatures.spectralFlux.empty()) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA, "Landmarks");
+    }
     
-    for (size_t i = halfSize; i < features.size() - halfSize; ++i) {
-        std::vector<float> window;
-        for (int j = -halfSize; j <= halfSize; ++j) {
-            window.push_back(features[i + j]);
+    std::vector<int64_t> candidates;
+    {
+        auto landmarks = extractLandmarks(target, targetFeatures);
+        ScopedStageTimer timer(ProcessingStage::PeakPicking);
+        for (const auto& match : reference.landmarks->query(landmarks, settings.maxCandidates,
+                                                            settings.toleranceFrames, settings.minVotes)) {
+            candidates.push_back(match.offsetFrames);
         }
+    }
+    
+    auto result = verifyLandmarkOffsets(reference, targetFeatures, candidates);
+    return finishLandmarkResult(result, reference, targetFeatures, target, referenceAudio);
+}
+
+harmoniq_sync_result_t AlignmentEngine::verifyLandmarkOffsets(const ClipFeatures& reference, const ClipFeatures& target,
+                                                              const std::vector<int64_t>& offsetFrames) const {
+    const auto& refFlux = reference.spectralFlux;
+    const auto& targetFlux = target.spectralFlux;
+    if (refFlux.empty() || targetFlux.empty()) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA, "Landmarks");
+    }
+    
+    // Only an explicit maxOffsetSamples bounds the search; otherwise every overlapping lag is allowed
+    int hopSize = reference.hopSize;
+    int64_t minLag = -static_cast<int64_t>(refFlux.size() - 1);
+    int64_t maxLag = static_cast<int64_t>(targetFlux.size() - 1);
+    if (config_.maxOffsetSamples > 0) {
+        int64_t bound = static_cast<int64_t>(calculateMaxLag(reference.audioLength, target.audioLength, hopSize));
+        minLag = std::max(minLag, -bound);
+        maxLag = std::min(maxLag, bound);
+    }
+    
+    // Dense correlation around each voted offset; the strongest verified peak wins
+    int64_t radius = std::max(1, config_.landmarks.refineRadius);
+    std::vector<double> correlation;
+    CorrelationPeak peak = {0, 0.0, 0.0, 1.0};
+    int64_t firstLag = 0;
+    bool found = false;
+    for (int64_t candidate : offsetFrames) {
+        int64_t first = std::max(minLag, candidate - radius);
+        int64_t last = std::min(maxLag, candidate + radius);
+        if (first > last) continue;
         
-        // Median filter
-        std::sort(window.begin(), window.end());
-        smoothed[i] = window[window.size() / 2];
+        std::vector<double> local;
+        {
+            ScopedStageTimer timer(ProcessingStage::Correlation);
+            local = correlationEngine_.crossCorrelateRange(refFlux, targetFlux, first, last);
+        }
+        auto localPeak = findBestAlignment(local);
+        if (!found || localPeak.value > peak.value) {
+            correlation = std::move(local);
+            peak = localPeak;
+            firstLag = first;
+            found = true;
+        }
+    }
+    
+    if (!found || peak.confidence < config_.confidenceThreshold) {
+        return createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "Landmarks");
     }
     
-    features = std::move(smoothed);
+    double sampleOffset = (static_cast<double>(firstLag + static_cast<int64_t>(peak.index))
+                           + interpolatePeak(correlation, peak.index)) * hopSize;
+    harmoniq_sync_result_t result = createResult(
+        sampleOffset,
+        peak.confidence,
+        peakCoefficient(refFlux, targetFlux, sampleOffset, hopSize),
+        peak.secondaryPeakRatio,
+        peak.snrEstimate,
+        peak.noiseFloorDb,
+        "Landmarks"
+    );
+    result.searched_offset_samples = std::min(-minLag, maxLag) * hopSize;
+    return result;
 }
 
-void AlignmentEngine::applyAdaptiveThreshold(std::vector<float>& features, float percentile) const {
-    if (features.empty()) return;
+harmoniq_sync_result_t AlignmentEngine::finishLandmarkResult(harmoniq_sync_result_t result,
+                                                             const ClipFeatures& reference,
+                                                             const ClipFeatures& targetFeatures,
+                                                             const AudioProcessor& target,
+                                                             const AudioProcessor* referenceAudio) const {
+    detectAndCorrectDrift(reference, targetFeatures, result);
+    if (!referenceAudio) {
+        return refineWithSamples(result, reference.excerpts, target, reference);
+    }
+    
+    // A short target overlaps a small part of a long reference, so excerpts come from that part
+    int64_t overlapStart = std::max<int64_t>(0, -result.offset_samples);
+    int64_t overlapEnd = std::min<int64_t>(static_cast<int64_t>(referenceAudio->getLength()),
+                                           static_cast<int64_t>(target.getLength()) - result.offset_samples);
+    if (overlapEnd <= overlapStart) return result;
+    return refineWithSamples(result,
+                             selectExcerpts(*referenceAudio, static_cast<size_t>(overlapStart), static_cast<size_t>(overlapEnd)),
+                             target, reference);
+}
+
+// MARK: - Drift Correction
+
+AlignmentEngine::DriftInfo AlignmentEngine::detectAndCorrectDrift(const ClipFeatures& reference,
+                                                                  const ClipFeatures& target,
+                                                                  harmoniq_sync_result_t& result) const {
+    ScopedStageTimer timer(ProcessingStage::DriftEstimation);
+    DriftInfo info;
+    const auto& settings = config_.drift;
+    if (!config_.enableDriftCorrection || result.error != HARMONIQ_SYNC_SUCCESS || settings.numSegments < 2) {
+        return info;
+    }
+    
+    // Spectral flux has the finer hop; the energy profile covers the other methods
+    const std::vector<float>* refStream = &reference.spectralFlux;
+    const std::vector<float>* targetStream = &target.spectralFlux;
+    int hopSize = reference.hopSize;
+    if (refStream->empty() || targetStream->empty()) {
+        refStream = &reference.energy;
+        targetStream = &target.energy;
+        hopSize = reference.energyHopSize;
+    }
+    if (refStream->empty() || targetStream->empty() || hopSize <= 0 || reference.sampleRate <= 0.0) {
+        return info;
+    }
+    
+    // Reference frames whose counterpart lies inside the target under the global offset
+    const double globalLag = result.offset_samples_fractional / hopSize;
+    const int64_t refFrames = static_cast<int64_t>(refStream->size());
+    const int64_t targetFrames = static_cast<int64_t>(targetStream->size());
+    int64_t overlapBegin = std::max<int64_t>(0, static_cast<int64_t>(std::ceil(-globalLag)));
+    int64_t overlapEnd = std::min(refFrames, static_cast<int64_t>(std::floor(targetFrames - globalLag)));
+    
+    const double framesPerSecond = reference.sampleRate / hopSize;
+    if (overlapEnd - overlapBegin < static_cast<int64_t>(settings.minDurationSeconds * framesPerSecond)) {
+        return info;
+    }
+    
+    // Lag window for the largest accepted drift, plus slack for the parabolic fit.
+    // Segments keep clear of the overlap edges so every searched lag fully overlaps.
+    const int64_t radius = static_cast<int64_t>(std::ceil(settings.maxPpm * 1e-6 * (overlapEnd - overlapBegin))) + 2;
+    overlapBegin += radius;
+    overlapEnd -= radius;
+    const int64_t overlap = overlapEnd - overlapBegin;
+    
+    int64_t segmentLength = std::min(static_cast<int64_t>(settings.segmentSeconds * framesPerSecond), overlap / 4);
+    if (segmentLength < MIN_DRIFT_SEGMENT_FRAMES) {
+        return info;
+    }
     
-    // Calculate threshold as percentile
-    std::vector<float> sorted = features;
-    std::sort(sorted.begin(), sorted.end());
-    float threshold = sorted[static_cast<size_t>(sorted.size() * percentile)];
+    // Local alignments are independent, so they are spread across the shared pool
+    const size_t count = settings.numSegments;
+    const int64_t roundedLag = static_cast<int64_t>(std::llround(globalLag));
+    std::vector<DriftSegment> segments(count);
+    auto cancellation = CancellationScope::current();
+    
+    ThreadPool::shared().parallelFor(count, static_cast<size_t>(std::max(0, config_.numWorkers)), [&](size_t index, size_t) {
+        // Segments are timed as a whole by the drift stage, whichever thread runs them
+        StageProfiler suspended(nullptr);
+        CancellationScope scope(cancellation);
+        int64_t start = overlapBegin + (overlap - segmentLength) * static_cast<int64_t>(index) / static_cast<int64_t>(count - 1);
+        int64_t expected = start + roundedLag;
+        segments[index] = alignDriftSegment(*refStream, *targetStream, static_cast<size_t>(start),
+                                            static_cast<size_t>(segmentLength),
+                                            expected - radius, expected + radius, hopSize);
+    });
+    
+    std::vector<DriftSegment> points;
+    for (const auto& segment : segments) {
+        if (segment.valid) {
+            points.push_back(segment);
+        }
+    }
+    
+    const size_t minSegments = std::max<size_t>(2, settings.minSegments);
+    if (points.size() < minSegments) {
+        return info;
+    }
+    
+    // Theil-Sen line: median pairwise slope, then median intercept, so a few
+    // segments locked onto repeated material cannot tilt the fit
+    std::vector<double> slopes;
+    slopes.reserve(points.size() * (points.size() - 1) / 2);
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (size_t j = i + 1; j < points.size(); ++j) {
+            slopes.push_back((points[j].offset - points[i].offset) / (points[j].position - points[i].position));
+        }
+    }
+    double slope = medianOf(slopes);
+    
+    std::vector<double> intercepts;
+    intercepts.reserve(points.size());
+    for (const auto& point : points) {
+        intercepts.push_back(point.offset - slope * point.position);
+    }
+    double intercept = medianOf(intercepts);
+    
+    // Least-squares refit on the segments within one frame of the robust line
+    double n = 0.0, sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+    for (const auto& point : points) {
+        if (std::abs(point.offset - (intercept + slope * point.position)) <= hopSize) {
+            n += 1.0;
+            sumX += point.position;
+            sumY += point.offset;
+            sumXX += point.position * point.position;
+            sumXY += point.position * point.offset;
+        }
+    }
+    
+    size_t inliers = static_cast<size_t>(n);
+    if (inliers < minSegments) {
+        return info;
+    }
+    
+    double denominator = n * sumXX - sumX * sumX;
+    if (denominator > 0.0) {
+        slope = (n * sumXY - sumX * sumY) / denominator;
+        intercept = (sumY - slope * sumX) / n;
+    }
     
-    // Apply threshold
-    for (float& feature : features) {
-        feature = std::max(0.0f, feature - threshold);
+    info.segmentsUsed = inliers;
+    info.ppm = slope * 1e6;
+    info.offsetAtStart = intercept;
+    result.drift_segments = static_cast<int>(inliers);
+    
+    // Below the floor, or too little movement across the clip to tell from fit noise
+    double span = static_cast<double>(overlap) * hopSize;
+    info.detected = std::abs(info.ppm) >= settings.minPpm &&
+                    std::abs(slope) * span >= MIN_DRIFT_SPAN_FRAMES * hopSize;
+    if (!info.detected) {
+        return info;
     }
+    
+    result.drift_ppm = info.ppm;
+    result.offset_samples_fractional = info.offsetAtStart;
+    result.offset_samples = static_cast<int64_t>(std::llround(info.offsetAtStart));
+    info.correctionApplied = true;
+    return info;
 }
 
-void AlignmentEngine::normalizeFeatures(std::vector<float>& features) const {
-    if (features.empty()) return;
+AlignmentEngine::DriftSegment AlignmentEngine::alignDriftSegment(const std::vector<float>& reference,
+                                                                 const std::vector<float>& target,
+                                                                 size_t start, size_t length,
+                                                                 int64_t firstLag, int64_t lastLag,
+                                                                 int hopSize) const {
+    DriftSegment segment;
+    segment.position = (static_cast<double>(start) + 0.5 * length) * hopSize;
+    
+    // Zero-mean excerpt, so the correlation follows the shape of the envelope
+    std::vector<float> excerpt(reference.begin() + start, reference.begin() + start + length);
+    float mean = DSP::mean(excerpt.data(), length);
+    DSP::addScalar(excerpt.data(), -mean, excerpt.data(), length);
+    
+    float excerptEnergy = DSP::sumOfSquares(excerpt.data(), length);
+    if (excerptEnergy <= 0.0f) return segment;
+    
+    auto correlation = correlationEngine_.crossCorrelateRange(excerpt, target, firstLag, lastLag);
+    auto peakIt = std::max_element(correlation.begin(), correlation.end());
+    size_t peakIndex = static_cast<size_t>(std::distance(correlation.begin(), peakIt));
+    
+    // An edge peak means the local offset lies outside the drift window
+    if (correlation.size() < 3 || peakIndex == 0 || peakIndex + 1 == correlation.size()) {
+        return segment;
+    }
+    
+    int64_t lag = firstLag + static_cast<int64_t>(peakIndex);
+    if (lag < 0 || lag + static_cast<int64_t>(length) > static_cast<int64_t>(target.size())) {
+        return segment;
+    }
+    
+    // Pearson coefficient at the peak (correlation values are means over the segment)
+    float windowMean = DSP::mean(target.data() + lag, length);
+    float windowSquares = DSP::sumOfSquares(target.data() + lag, length);
+    double windowEnergy = windowSquares - static_cast<double>(length) * windowMean * windowMean;
+    if (windowEnergy <= 0.0) return segment;
     
-    // Find min and max
-    auto minMax = std::minmax_element(features.begin(), features.end());
-    float minVal = *minMax.first;
-    float maxVal = *minMax.second;
+    double coefficient = *peakIt * length / std::sqrt(static_cast<double>(excerptEnergy) * windowEnergy);
+    if (coefficient < config_.drift.minSegmentCorrelation) {
+        return segment;
+    }
     
-    if (maxVal > minVal) {
-        float range = maxVal - minVal;
-        for (float& feature : features) {
-            feature = (feature - minVal) / range;
+    double delta = parabolicVertex(correlation[peakIndex - 1], *peakIt, correlation[peakIndex + 1]);
+    segment.offset = (static_cast<double>(lag - static_cast<int64_t>(start)) + delta) * hopSize;
+    segment.valid = true;
+    return segment;
+}
+
+std::vector<float> AlignmentEngine::correctDrift(const float* samples, size_t length,
+                                                 double offsetSamples, double ppm) {
+    std::vector<float> corrected(length, 0.0f);
+    if (!samples || length == 0) return corrected;
+    
+    if (ppm == 0.0) {
+        std::copy(samples, samples + length, corrected.begin());
+        return corrected;
+    }
+    
+    const double rate = 1.0 + ppm * 1e-6;
+    const int64_t last = static_cast<int64_t>(length) - 1;
+    auto sampleAt = [&](int64_t index) {
+        return index < 0 || index > last ? 0.0f : samples[index];
+    };
+    
+    for (size_t m = 0; m < length; ++m) {
+        double position = (static_cast<double>(m) - offsetSamples) * rate + offsetSamples;
+        if (position < 0.0 || position > static_cast<double>(last)) {
+            continue;
         }
+        
+        // Catmull-Rom cubic through the four samples around the read position
+        double base = std::floor(position);
+        int64_t index = static_cast<int64_t>(base);
+        float t = static_cast<float>(position - base);
+        float p0 = sampleAt(index - 1);
+        float p1 = sampleAt(index);
+        float p2 = sampleAt(index + 1);
+        float p3 = sampleAt(index + 2);
+        
+        corrected[m] = p1 + 0.5f * t * (p2 - p0 + t * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3 +
+                                                       t * (3.0f * (p1 - p2) + p3 - p0)));
     }
+    return corrected;
+}
+
+// MARK: - Feature Processing
+
+void AlignmentEngine::smoothFeatures(std::vector<float>& features, int filterSize) const {
+    FeatureFilters::medianFilter(features, filterSize);
+}
+
+void AlignmentEngine::applyAdaptiveThreshold(std::vector<float>& features, float percentile) const {
+    if (features.empty()) return;
+    
+    std::vector<float> scratch;
+    float threshold = FeatureFilters::percentile(features.data(), features.size(), percentile, scratch);
+    
+    // max(0, x - threshold)
+    DSP::addScalar(features.data(), -threshold, features.data(), features.size());
+    DSP::threshold(features.data(), 0.0f, features.data(), features.size());
+}
+
+void AlignmentEngine::normalizeFeatures(std::vector<float>& features) const {
+    FeatureFilters::normalizeRange(features);
 }
 
 // MARK: - Result Creation
 
 harmoniq_sync_result_t AlignmentEngine::createResult(
-    int64_t offsetSamples,
+    double offsetSamples,
     double confidence,
     double peakCorrelation,
     double secondaryPeakRatio,
@@ -613,7 +1674,8 @@ harmoniq_sync_result_t AlignmentEngine::createResult(
 ) const {
     harmoniq_sync_result_t result = {};
     
-    result.offset_samples = offsetSamples;
+    result.offset_samples = static_cast<int64_t>(std::llround(offsetSamples));
+    result.offset_samples_fractional = offsetSamples;
     result.confidence = confidence;
     result.peak_correlation = peakCorrelation;
     result.secondary_peak_ratio = secondaryPeakRatio;
@@ -630,12 +1692,14 @@ harmoniq_sync_result_t AlignmentEngine::createResult(
 }
 
 harmoniq_sync_result_t AlignmentEngine::createErrorResult(harmoniq_sync_error_t error, const std::string& method) const {
-    return createResult(0, 0.0, 0.0, 1.0, 0.0, -60.0, method, error);
+    return createResult(0.0, 0.0, 0.0, 1.0, 0.0, -60.0, method, error);
 }
 
 // MARK: - Validation
 
 harmoniq_sync_error_t AlignmentEngine::validateInputs(const AudioProcessor& reference, const AudioProcessor& target) const {
+    ScopedStageTimer timer(ProcessingStage::LoadValidate);
+    
     if (!reference.isValid() || !target.isValid()) {
         return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
     }
@@ -758,6 +1822,138 @@ int64_t AlignmentEngine::calculateMaxOffset(size_t refLength, size_t targetLengt
     return static_cast<int64_t>(minLength / 4);
 }
 
+size_t AlignmentEngine::calculateMaxLag(size_t refLength, size_t targetLength, int hopSize) const {
+    int64_t maxOffset = calculateMaxOffset(refLength, targetLength);
+    if (hopSize <= 0 || maxOffset <= 0) {
+        return 0;
+    }
+    
+    // Round up so an offset of exactly maxOffsetSamples is still reachable
+    return static_cast<size_t>((maxOffset + hopSize - 1) / hopSize);
+}
+
+void AlignmentEngine::postProcessFeatures(ClipFeatures& features) const {
+    ScopedStageTimer timer(ProcessingStage::FeaturePostProcessing);
+    
+    if (!features.spectralFlux.empty()) {
+        // Apply adaptive thresholding to emphasize onsets
+        applyAdaptiveThreshold(features.spectralFlux, 0.1f);
+        
+        // Apply median filtering
+        smoothFeatures(features.spectralFlux, config_.spectralFlux.medianFilterSize);
+        
+        // Normalize features
+        normalizeFeatures(features.spectralFlux);
+    }
+    
+    // Chroma features are already normalized in extraction
+    
+    if (!features.energy.empty()) {
+        smoothFeatures(features.energy, config_.energy.smoothingWindowSize);
+        normalizeFeatures(features.energy);
+    }
+}
+
+void AlignmentEngine::attachSpectra(ClipFeatures& features) const {
+    features.spectra = std::make_shared<FeatureSpectra>();
+}
+
+int AlignmentEngine::resolveHopSize(int autoDivisor) const {
+    if (config_.hopSize > 0) {
+        return config_.hopSize;
+    }
+    return std::max(1, config_.windowSize / autoDivisor);
+}
+
+int AlignmentEngine::resolveDecimation(double sampleRate) const {
+    if (config_.analysisSampleRate <= 0.0 || sampleRate <= config_.analysisSampleRate) {
+        return 1;
+    }
+    return std::max(1, static_cast<int>(sampleRate / config_.analysisSampleRate));
+}
+
+int64_t AlignmentEngine::lagIndexToSamples(size_t peakIndex, size_t correlationSize, int hopSize) const {
+    // Correlation layout is symmetric around zero lag: index k holds lag k - (size - 1) / 2
+    int64_t window = static_cast<int64_t>(correlationSize - 1) / 2;
+    return (static_cast<int64_t>(peakIndex) - window) * hopSize;
+}
+
+double AlignmentEngine::interpolatePeak(const std::vector<double>& correlation, size_t peakIndex) const {
+    if (!config_.refinement.interpolatePeak || peakIndex == 0 || peakIndex + 1 >= correlation.size()) {
+        return 0.0;
+    }
+    
+    return parabolicVertex(correlation[peakIndex - 1], correlation[peakIndex], correlation[peakIndex + 1]);
+}
+
+double AlignmentEngine::interpolatedOffset(const std::vector<double>& correlation, size_t peakIndex, int hopSize) const {
+    return static_cast<double>(lagIndexToSamples(peakIndex, correlation.size(), hopSize))
+         + interpolatePeak(correlation, peakIndex) * hopSize;
+}
+
+int64_t AlignmentEngine::searchedOffset(size_t refFrames, size_t targetFrames, size_t maxLag, int hopSize) const {
+    return static_cast<int64_t>(CorrelationEngine::lagWindow(refFrames, targetFrames, maxLag)) * hopSize;
+}
+
+double AlignmentEngine::peakCoefficient(const std::vector<float>& a, const std::vector<float>& b,
+                                        double sampleOffset, int hopSize) const {
+    // Frame i of a meets frame i + lag of b
+    int64_t lag = hopSize > 0 ? std::llround(sampleOffset / hopSize) : 0;
+    int64_t begin = std::max<int64_t>(0, -lag);
+    int64_t end = std::min(static_cast<int64_t>(a.size()), static_cast<int64_t>(b.size()) - lag);
+    if (end - begin < 2) return 0.0;
+    
+    double sumA = 0.0, sumB = 0.0, squaresA = 0.0, squaresB = 0.0, products = 0.0;
+    for (int64_t i = begin; i < end; ++i) {
+        double x = a[i], y = b[i + lag];
+        sumA += x;
+        sumB += y;
+        squaresA += x * x;
+        squaresB += y * y;
+        products += x * y;
+    }
+    double count = static_cast<double>(end - begin);
+    double varianceA = squaresA - sumA * sumA / count;
+    double varianceB = squaresB - sumB * sumB / count;
+    if (!(varianceA > 0.0) || !(varianceB > 0.0)) return 0.0;
+    return std::clamp((products - sumA * sumB / count) / std::sqrt(varianceA * varianceB), -1.0, 1.0);
+}
+
+double AlignmentEngine::peakCoefficient(const FeatureMatrix& a, const FeatureMatrix& b, double sampleOffset,
+                                        int hopSize, const std::vector<double>& weights) const {
+    size_t dims = std::min(a.getNumDims(), b.getNumDims());
+    int64_t lag = hopSize > 0 ? std::llround(sampleOffset / hopSize) : 0;
+    int64_t begin = std::max<int64_t>(0, -lag);
+    int64_t end = std::min(static_cast<int64_t>(a.getNumFrames()), static_cast<int64_t>(b.getNumFrames()) - lag);
+    if (dims == 0 || end - begin < 2) return 0.0;
+    
+    std::vector<double> sumA(dims, 0.0), sumB(dims, 0.0), squaresA(dims, 0.0), squaresB(dims, 0.0), products(dims, 0.0);
+    for (int64_t i = begin; i < end; ++i) {
+        const float* rowA = a.row(static_cast<size_t>(i));
+        const float* rowB = b.row(static_cast<size_t>(i + lag));
+        for (size_t d = 0; d < dims; ++d) {
+            double x = rowA[d], y = rowB[d];
+            sumA[d] += x;
+            sumB[d] += y;
+            squaresA[d] += x * x;
+            squaresB[d] += y * y;
+            products[d] += x * y;
+        }
+    }
+    
+    // Weighted sums of the per-dimension covariances and variances
+    double count = static_cast<double>(end - begin);
+    double covariance = 0.0, varianceA = 0.0, varianceB = 0.0;
+    for (size_t d = 0; d < dims; ++d) {
+        double weight = weights.empty() ? 1.0 : weights[d];
+        covariance += weight * (products[d] - sumA[d] * sumB[d] / count);
+        varianceA += weight * (squaresA[d] - sumA[d] * sumA[d] / count);
+        varianceB += weight * (squaresB[d] - sumB[d] * sumB[d] / count);
+    }
+    if (!(varianceA > 0.0) || !(varianceB > 0.0)) return 0.0;
+    return std::clamp(covariance / std::sqrt(varianceA * varianceB), -1.0, 1.0);
+}
+
 std::string AlignmentEngine::getMethodName(harmoniq_sync_method_t method) const {
     switch (method) {
         case HARMONIQ_SYNC_SPECTRAL_FLUX: return "Spectral Flux";
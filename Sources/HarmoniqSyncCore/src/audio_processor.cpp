@@ -3,11 +3,16 @@
 //  HarmoniqSyncCore
 //
 //  High-performance audio feature extraction for sync algorithms
-//  Uses Apple Accelerate framework for optimal performance on Apple Silicon
+//  DSP kernels come from the configured backend (Accelerate on Apple platforms)
 //
 
 #include "../include/audio_processor.hpp"
-#include <Accelerate/Accelerate.h>
+#include "../include/feature_filters.hpp"
+#include "../include/chroma_plan.hpp"
+#include "../include/mfcc_plan.hpp"
+#include "../include/decimator.hpp"
+#include "../include/operation_control.hpp"
+#include "../include/stage_profiler.hpp"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
@@ -25,83 +30,54 @@ static const size_t MAX_FRAME_SIZE = 8192;
 static const size_t MAX_AUDIO_LENGTH = 10000000; // ~4 minutes at 44.1kHz
 static const double MIN_SAMPLE_RATE = 8000.0;
 static const double MAX_SAMPLE_RATE = 192000.0;
+static const size_t MAX_CACHED_SPECTROGRAMS = 2; // One full-length spectrogram can reach tens of MB
 
 // MARK: - Lifecycle
 
 AudioProcessor::AudioProcessor() 
-    : sampleRate(0.0)
-    , fftSetup(nullptr)
-    , log2MaxFrameSize(0)
+    : sampleData(nullptr)
+    , sampleCount(0)
+    , sampleRate(0.0)
+    , sampleCheck(SampleCheck::Finite)
 {
-    // Pre-allocate working buffers to avoid runtime allocation
-    workingBuffer.reserve(MAX_FRAME_SIZE);
-    fftBuffer.reserve(MAX_FRAME_SIZE / 2);
-    windowFunction.reserve(MAX_FRAME_SIZE);
-    
-    // Initialize Apple Accelerate FFT setup for maximum expected frame size
-    log2MaxFrameSize = static_cast<vDSP_Length>(log2(MAX_FRAME_SIZE));
-    fftSetup = vDSP_create_fftsetup(log2MaxFrameSize, FFT_RADIX2);
-    
-    if (!fftSetup) {
-        throw std::runtime_error("Failed to initialize Apple Accelerate FFT setup");
-    }
-    
-    // Initialize split complex buffer for FFT operations
-    splitComplex.realp = nullptr;
-    splitComplex.imagp = nullptr;
 }
 
-AudioProcessor::~AudioProcessor() {
-    // Clean up Apple Accelerate FFT setup
-    if (fftSetup) {
-        vDSP_destroy_fftsetup(fftSetup);
-        fftSetup = nullptr;
-    }
-}
+AudioProcessor::~AudioProcessor() = default;
 
 // MARK: - Move Semantics
 
 AudioProcessor::AudioProcessor(AudioProcessor&& other) noexcept
     : audioData(std::move(other.audioData))
+    , sampleData(other.sampleData)
+    , sampleCount(other.sampleCount)
     , sampleRate(other.sampleRate)
-    , workingBuffer(std::move(other.workingBuffer))
-    , fftBuffer(std::move(other.fftBuffer))
-    , windowFunction(std::move(other.windowFunction))
-    , fftSetup(other.fftSetup)
-    , log2MaxFrameSize(other.log2MaxFrameSize)
-    , splitComplex(other.splitComplex)
+    , sampleCheck(other.sampleCheck)
+    , spectrumKernel(std::move(other.spectrumKernel))
+    , spectrogramCache(std::move(other.spectrogramCache))
+    , statistics(std::move(other.statistics))
 {
-    // Take ownership of the FFT setup
-    other.fftSetup = nullptr;
+    // Owned samples moved with the vector buffer
+    other.sampleData = nullptr;
+    other.sampleCount = 0;
     other.sampleRate = 0.0;
-    other.log2MaxFrameSize = 0;
-    other.splitComplex.realp = nullptr;
-    other.splitComplex.imagp = nullptr;
 }
 
 AudioProcessor& AudioProcessor::operator=(AudioProcessor&& other) noexcept {
     if (this != &other) {
-        // Clean up our current resources
-        if (fftSetup) {
-            vDSP_destroy_fftsetup(fftSetup);
-        }
-        
         // Move data from other
         audioData = std::move(other.audioData);
+        sampleData = other.sampleData;
+        sampleCount = other.sampleCount;
         sampleRate = other.sampleRate;
-        workingBuffer = std::move(other.workingBuffer);
-        fftBuffer = std::move(other.fftBuffer);
-        windowFunction = std::move(other.windowFunction);
-        fftSetup = other.fftSetup;
-        log2MaxFrameSize = other.log2MaxFrameSize;
-        splitComplex = other.splitComplex;
+        sampleCheck = other.sampleCheck;
+        spectrumKernel = std::move(other.spectrumKernel);
+        spectrogramCache = std::move(other.spectrogramCache);
+        statistics = std::move(other.statistics);
         
         // Reset other's state
-        other.fftSetup = nullptr;
+        other.sampleData = nullptr;
+        other.sampleCount = 0;
         other.sampleRate = 0.0;
-        other.log2MaxFrameSize = 0;
-        other.splitComplex.realp = nullptr;
-        other.splitComplex.imagp = nullptr;
     }
     return *this;
 }
@@ -109,6 +85,86 @@ AudioProcessor& AudioProcessor::operator=(AudioProcessor&& other) noexcept {
 // MARK: - Audio Loading
 
 bool AudioProcessor::loadAudio(const float* samples, size_t length, double inputSampleRate, double targetSampleRate) {
+    if (!isLoadable(samples, length, inputSampleRate, targetSampleRate)) {
+        return false;
+    }
+    
+    // Clear previous data
+    clear();
+    
+    try {
+        // Copy audio data, measuring it and validating NaN or infinite values in the same pass
+        audioData.resize(length);
+        auto measured = std::make_unique<AudioStatistics>(
+            AudioStatistics::measure(samples, length, AudioStatistics::DEFAULT_SILENCE_THRESHOLD,
+                                     AudioStatistics::DEFAULT_CLIPPING_THRESHOLD, audioData.data()));
+        if (!measured->allFinite()) {
+            clear(); // Clean up on error
+            return false; // Invalid audio data
+        }
+        
+        sampleData = audioData.data();
+        sampleCount = length;
+        sampleRate = inputSampleRate;
+        statistics = std::move(measured);
+        
+        // Resample if needed and target sample rate is significantly different
+        if (targetSampleRate > 0 && std::abs(targetSampleRate - inputSampleRate) > 1.0) {
+            if (!resampleAudio(targetSampleRate)) {
+                clear(); // Clean up on error
+                return false;
+            }
+        }
+        
+    } catch (const OperationCancelledException&) {
+        clear();
+        throw; // Not a load failure: let the operation unwind
+    } catch (const OperationTimeoutException&) {
+        clear();
+        throw;
+    } catch (const std::exception&) {
+        clear(); // Clean up on exception
+        return false;
+    }
+    
+    return true;
+}
+
+bool AudioProcessor::loadAudioView(const float* samples, size_t length, double inputSampleRate, double targetSampleRate) {
+    if (!isLoadable(samples, length, inputSampleRate, targetSampleRate)) {
+        return false;
+    }
+    
+    clear();
+    
+    // No copy and no scan: the first feature pass checks the samples
+    sampleData = samples;
+    sampleCount = length;
+    sampleRate = inputSampleRate;
+    sampleCheck = SampleCheck::Pending;
+    
+    try {
+        if (targetSampleRate > 0 && std::abs(targetSampleRate - inputSampleRate) > 1.0) {
+            if (!resampleAudio(targetSampleRate)) {
+                clear();
+                return false;
+            }
+        }
+    } catch (const OperationCancelledException&) {
+        clear();
+        throw;
+    } catch (const OperationTimeoutException&) {
+        clear();
+        throw;
+    } catch (const std::exception&) {
+        clear();
+        return false;
+    }
+    
+    return true;
+}
+
+bool AudioProcessor::isLoadable(const float* samples, size_t length, double inputSampleRate, double targetSampleRate) {
     // Comprehensive input validation
     if (!samples) {
         return false; // Null pointer
@@ -131,52 +187,31 @@ bool AudioProcessor::loadAudio(const float* samples, size_t length, double input
         return false; // Invalid target sample rate
     }
     
-    // Clear previous data
-    clear();
-    
-    try {
-        // Copy audio data with bounds checking
-        audioData.reserve(length);
-        audioData.assign(samples, samples + length);
-        sampleRate = inputSampleRate;
-        
-        // Validate the copied data for NaN or infinite values
-        for (size_t i = 0; i < length; ++i) {
-            if (!std::isfinite(audioData[i])) {
-                clear(); // Clean up on error
-                return false; // Invalid audio data
-            }
-        }
-        
-        // Resample if needed and target sample rate is significantly different
-        if (targetSampleRate > 0 && std::abs(targetSampleRate - inputSampleRate) > 1.0) {
-            if (!resampleAudio(targetSampleRate)) {
-                clear(); // Clean up on error
-                return false;
-            }
-        }
-        
-    } catch (const std::exception&) {
-        clear(); // Clean up on exception
-        return false;
-    }
-    
     return true;
 }
 
 void AudioProcessor::clear() {
     audioData.clear();
     audioData.shrink_to_fit(); // Release memory
+    sampleData = nullptr;
+    sampleCount = 0;
     sampleRate = 0.0;
+    sampleCheck = SampleCheck::Finite;
     
-    // Clear working buffers but maintain capacity for reuse
-    workingBuffer.clear();
-    fftBuffer.clear(); 
-    windowFunction.clear();
-    
-    // Reset split complex pointers
-    splitComplex.realp = nullptr;
-    splitComplex.imagp = nullptr;
+    clearSpectrogramCache();
+    statistics.reset();
+}
+
+// MARK: - Statistics
+
+const AudioStatistics& AudioProcessor::getStatistics() const {
+    if (!statistics) {
+        statistics = std::make_unique<AudioStatistics>(AudioStatistics::measure(sampleData, sampleCount));
+        if (sampleCheck == SampleCheck::Pending) {
+            finishSampleCheck(statistics->allFinite());
+        }
+    }
+    return *statistics;
 }
 
 // MARK: - Feature Extraction
@@ -184,39 +219,7 @@ void AudioProcessor::clear() {
 std::vector<float> AudioProcessor::extractSpectralFlux(int windowSize, int hopSize) const {
     if (!isValid()) return {};
     
-    if (hopSize <= 0) hopSize = windowSize / 4;
-    
-    std::vector<float> spectralFlux;
-    std::vector<float> prevMagnitude;
-    
-    // Process overlapping windows
-    for (size_t pos = 0; pos + windowSize <= audioData.size(); pos += hopSize) {
-        // Compute magnitude spectrum
-        std::vector<float> magnitude;
-        computeFFT(&audioData[pos], windowSize, magnitude);
-        
-        if (!prevMagnitude.empty()) {
-            // Calculate spectral flux (sum of positive differences)
-            float flux = 0.0f;
-            size_t minSize = std::min(magnitude.size(), prevMagnitude.size());
-            
-            for (size_t i = 1; i < minSize; ++i) { // Skip DC component
-                float diff = magnitude[i] - prevMagnitude[i];
-                if (diff > 0) {
-                    flux += diff;
-                }
-            }
-            
-            spectralFlux.push_back(flux);
-        }
-        
-        prevMagnitude = std::move(magnitude);
-    }
-    
-    // Apply median filtering for smoothing
-    smoothFeatures(spectralFlux, 3);
-    
-    return spectralFlux;
+    return extractSpectralFlux(getSpectrogram(windowSize, hopSize));
 }
 
 void AudioProcessor::extractSpectralFlux(const std::vector<std::vector<float>>& spectralFrames,
@@ -259,41 +262,35 @@ void AudioProcessor::extractSpectralFlux(const std::vector<std::vector<float>>&
     }
 }
 
-std::vector<float> AudioProcessor::extractChromaFeatures(int windowSize, int hopSize) const {
+std::vector<float> AudioProcessor::extractChromaFeatures(int windowSize, int hopSize,
+                                                         int numChromaBins, bool harmonicWeighting) const {
     if (!isValid()) return {};
     
-    if (hopSize <= 0) hopSize = windowSize / 4;
-    
-    std::vector<float> chromaFeatures;
-    
-    // Process overlapping windows
-    for (size_t pos = 0; pos + windowSize <= audioData.size(); pos += hopSize) {
-        // Compute magnitude spectrum
-        std::vector<float> magnitude;
-        computeFFT(&audioData[pos], windowSize, magnitude);
-        
-        // Extract 12-dimensional chroma vector
-        std::vector<float> chroma(12, 0.0f);
-        computeChromaVector(magnitude, chroma);
-        
-        // Append to feature vector
-        chromaFeatures.insert(chromaFeatures.end(), chroma.begin(), chroma.end());
-    }
-    
-    return chromaFeatures;
+    return extractChromaFeatures(getSpectrogram(windowSize, hopSize), numChromaBins, harmonicWeighting);
 }
 
 std::vector<float> AudioProcessor::extractEnergyProfile(int windowSize, int hopSize) const {
     if (!isValid()) return {};
     
     if (hopSize <= 0) hopSize = windowSize / 2;
+    if (windowSize <= 0 || hopSize <= 0) return {};
     
-    std::vector<float> energyProfile;
+    // Sized up front from the frame count, then filled in place
+    std::vector<float> energyProfile(FeatureMatrix::frameCount(sampleCount, windowSize, hopSize));
+    bool checking = (sampleCheck == SampleCheck::Pending);
+    size_t checkedEnd = 0;
+    bool finite = true;
+    for (size_t frame = 0; frame < energyProfile.size(); ++frame) {
+        CancellationScope::check();
+        size_t start = frame * hopSize;
+        if (checking) checkSamples(checkedEnd, start + windowSize, finite);
+        energyProfile[frame] = calculateRMSEnergy(sampleData + start, windowSize);
+    }
     
-    // Process overlapping windows
-    for (size_t pos = 0; pos + windowSize <= audioData.size(); pos += hopSize) {
-        float energy = calculateRMSEnergy(&audioData[pos], windowSize);
-        energyProfile.push_back(energy);
+    if (checking) {
+        checkSamples(checkedEnd, sampleCount, finite);
+        finishSampleCheck(finite);
+        if (!finite) return {};
     }
     
     // Apply smoothing
@@ -302,52 +299,165 @@ std::vector<float> AudioProcessor::extractEnergyProfile(int windowSize, int hopS
     return energyProfile;
 }
 
-std::vector<float> AudioProcessor::extractMFCC(int numCoeffs, int windowSize, int hopSize) const {
+std::vector<float> AudioProcessor::extractMFCC(int numCoeffs, int windowSize, int hopSize, int numMelFilters) const {
     if (!isValid()) return {};
     
+    return extractMFCC(getSpectrogram(windowSize, hopSize), numCoeffs, numMelFilters);
+}
+
+// MARK: - Spectrogram
+
+const Spectrogram& AudioProcessor::getSpectrogram(int windowSize, int hopSize) const {
     if (hopSize <= 0) hopSize = windowSize / 4;
     
-    std::vector<float> mfccFeatures;
+    for (const auto& cached : spectrogramCache) {
+        if (cached->windowSize == windowSize && cached->hopSize == hopSize) {
+            return *cached;
+        }
+    }
     
-    // Create mel filter bank
-    int numMelFilters = 26;
-    auto melFilters = createMelFilterBank(numMelFilters, windowSize / 2, sampleRate);
+    auto spectrogram = std::make_unique<Spectrogram>();
+    spectrogram->windowSize = windowSize;
+    spectrogram->hopSize = hopSize;
+    spectrogram->sampleRate = sampleRate;
+    spectrogram->numBins = static_cast<size_t>(windowSize / 2);
     
-    // Process overlapping windows
-    for (size_t pos = 0; pos + windowSize <= audioData.size(); pos += hopSize) {
-        // Compute magnitude spectrum
-        std::vector<float> magnitude;
-        computeFFT(&audioData[pos], windowSize, magnitude);
+    if (isValid() && windowSize > 0 && hopSize > 0) {
+        ScopedStageTimer timer(ProcessingStage::STFT);
+        spectrogram->numFrames = FeatureMatrix::frameCount(sampleCount, windowSize, hopSize);
+        spectrogram->magnitudes.resize(spectrogram->numFrames, spectrogram->numBins);
         
-        // Apply mel filter bank
-        std::vector<float> melEnergy(numMelFilters, 0.0f);
-        for (int i = 0; i < numMelFilters; ++i) {
-            for (size_t j = 0; j < magnitude.size() && j < melFilters[i].size(); ++j) {
-                melEnergy[i] += magnitude[j] * melFilters[i][j];
+        // Single STFT pass written straight into the contiguous matrix, with the
+        // kernel of this window size resolved once rather than per frame.
+        // A pending view is checked for NaN/Inf frame by frame while each frame is in cache.
+        const SpectrumKernel& kernel = kernelFor(static_cast<size_t>(windowSize));
+        bool checking = (sampleCheck == SampleCheck::Pending);
+        size_t checkedEnd = 0;
+        bool finite = true;
+        for (size_t frame = 0; frame < spectrogram->numFrames; ++frame) {
+            CancellationScope::check();
+            size_t start = frame * hopSize;
+            if (checking) checkSamples(checkedEnd, start + windowSize, finite);
+            kernel.magnitude(sampleData + start, spectrogram->magnitudes.row(frame));
+        }
+        
+        if (checking) {
+            checkSamples(checkedEnd, sampleCount, finite);
+            finishSampleCheck(finite);
+            if (!finite) {
+                spectrogram->numFrames = 0;
+                spectrogram->magnitudes.resize(0, spectrogram->numBins);
             }
-            // Log energy (with small epsilon to avoid log(0))
-            melEnergy[i] = std::log(melEnergy[i] + 1e-10f);
         }
+    }
+    
+    if (spectrogramCache.size() >= MAX_CACHED_SPECTROGRAMS) {
+        spectrogramCache.erase(spectrogramCache.begin());
+    }
+    spectrogramCache.push_back(std::move(spectrogram));
+    
+    return *spectrogramCache.back();
+}
+
+const Spectrogram* AudioProcessor::getCachedSpectrogram() const {
+    return spectrogramCache.empty() ? nullptr : spectrogramCache.back().get();
+}
+
+void AudioProcessor::clearSpectrogramCache() const {
+    spectrogramCache.clear();
+}
+
+std::vector<float> AudioProcessor::extractSpectralFlux(const Spectrogram& spectrogram) const {
+    std::vector<float> spectralFlux;
+    if (spectrogram.numFrames < 2) return spectralFlux;
+    
+    spectralFlux.resize(spectrogram.numFrames - 1);
+    
+    for (size_t frame = 1; frame < spectrogram.numFrames; ++frame) {
+        CancellationScope::check();
+        const float* prevMagnitude = spectrogram.frame(frame - 1);
+        const float* magnitude = spectrogram.frame(frame);
         
-        // Compute DCT to get MFCC coefficients
-        std::vector<float> mfcc(numCoeffs);
-        computeDCT(melEnergy, mfcc, numCoeffs);
+        // Calculate spectral flux (sum of positive differences)
+        float flux = 0.0f;
+        for (size_t i = 1; i < spectrogram.numBins; ++i) { // Skip DC component
+            float diff = magnitude[i] - prevMagnitude[i];
+            if (diff > 0) {
+                flux += diff;
+            }
+        }
         
-        // Append to feature vector
-        mfccFeatures.insert(mfccFeatures.end(), mfcc.begin(), mfcc.end());
+        spectralFlux[frame - 1] = flux;
     }
     
+    // Apply median filtering for smoothing
+    smoothFeatures(spectralFlux, 3);
+    
+    return spectralFlux;
+}
+
+std::vector<float> AudioProcessor::extractChromaFeatures(const Spectrogram& spectrogram, int numChromaBins,
+                                                         bool harmonicWeighting) const {
+    std::vector<float> chromaFeatures;
+    if (spectrogram.empty() || numChromaBins <= 0) return chromaFeatures;
+    
+    // Bin-to-pitch-class runs are built once per configuration
+    auto plan = ChromaPlan::get(spectrogram.sampleRate, spectrogram.numBins, numChromaBins, harmonicWeighting);
+    
+    chromaFeatures.resize(spectrogram.numFrames * numChromaBins);
+    plan->apply(spectrogram.magnitudes.data(), spectrogram.numFrames, chromaFeatures.data());
+    
+    return chromaFeatures;
+}
+
+std::vector<float> AudioProcessor::extractMFCC(const Spectrogram& spectrogram, int numCoeffs, int numMelFilters) const {
+    std::vector<float> mfccFeatures;
+    if (spectrogram.empty() || numCoeffs <= 0 || numMelFilters <= 0) return mfccFeatures;
+    
+    // Sparse filterbank and DCT basis are built once per configuration
+    auto plan = MFCCPlan::get(spectrogram.sampleRate, spectrogram.numBins, numMelFilters, numCoeffs);
+    
+    mfccFeatures.resize(spectrogram.numFrames * numCoeffs);
+    plan->apply(spectrogram.magnitudes.data(), spectrogram.numFrames, mfccFeatures.data());
+    
     return mfccFeatures;
 }
 
+void AudioProcessor::extractChromaFeatures(const Spectrogram& spectrogram, FeatureMatrix& chroma,
+                                           int numChromaBins, bool harmonicWeighting) const {
+    if (spectrogram.empty() || numChromaBins <= 0) {
+        chroma.resize(0, static_cast<size_t>(std::max(0, numChromaBins)));
+        return;
+    }
+    
+    auto plan = ChromaPlan::get(spectrogram.sampleRate, spectrogram.numBins, numChromaBins, harmonicWeighting);
+    chroma.resize(spectrogram.numFrames, static_cast<size_t>(numChromaBins));
+    plan->apply(spectrogram.magnitudes.data(), spectrogram.numFrames, chroma.data());
+}
+
+void AudioProcessor::extractMFCC(const Spectrogram& spectrogram, FeatureMatrix& mfcc,
+                                 int numCoeffs, int numMelFilters) const {
+    if (spectrogram.empty() || numCoeffs <= 0 || numMelFilters <= 0) {
+        mfcc.resize(0, static_cast<size_t>(std::max(0, numCoeffs)));
+        return;
+    }
+    
+    auto plan = MFCCPlan::get(spectrogram.sampleRate, spectrogram.numBins, numMelFilters, numCoeffs);
+    mfcc.resize(spectrogram.numFrames, static_cast<size_t>(numCoeffs));
+    plan->apply(spectrogram.magnitudes.data(), spectrogram.numFrames, mfcc.data());
+}
+
 // MARK: - Preprocessing
 
 void AudioProcessor::applyPreEmphasis(float alpha) {
-    if (!isValid() || audioData.size() < 2) return;
+    if (!isValid() || sampleCount < 2) return;
     
+    makeSamplesOwned();
     for (size_t i = audioData.size() - 1; i > 0; --i) {
         audioData[i] = audioData[i] - alpha * audioData[i - 1];
     }
+    
+    samplesChanged();
 }
 
 void AudioProcessor::applyNoiseGate(float thresholdDb) {
@@ -355,22 +465,28 @@ void AudioProcessor::applyNoiseGate(float thresholdDb) {
     
     float threshold = std::pow(10.0f, thresholdDb / 20.0f);
     
+    makeSamplesOwned();
     for (float& sample : audioData) {
         if (std::abs(sample) < threshold) {
             sample = 0.0f;
         }
     }
+    
+    samplesChanged();
 }
 
 void AudioProcessor::normalize(float targetPeak) {
     if (!isValid()) return;
     
-    float peak = findPeak(audioData.data(), audioData.size());
+    float peak = static_cast<float>(getStatistics().peak);
     if (peak > 0.0f) {
         float scale = targetPeak / peak;
+        makeSamplesOwned();
         for (float& sample : audioData) {
             sample *= scale;
         }
+        
+        samplesChanged();
     }
 }
 
@@ -379,10 +495,25 @@ void AudioProcessor::normalize(float targetPeak) {
 bool AudioProcessor::resampleAudio(double targetSampleRate) {
     if (sampleRate == targetSampleRate) return true;
     
-    // Simple linear interpolation resampling
-    // For production use, consider using a proper resampling library
+    // Reads owned or borrowed samples alike; the output is always owned.
+    // Integer downsampling goes through the anti-aliasing decimator.
+    double factor = sampleRate / targetSampleRate;
+    int integerFactor = static_cast<int>(std::lround(factor));
+    if (integerFactor >= 2 && std::abs(factor - integerFactor) < 1e-9) {
+        std::vector<float> decimated;
+        Decimator::get(integerFactor)->process(sampleData, sampleCount, decimated);
+        
+        audioData = std::move(decimated);
+        sampleData = audioData.data();
+        sampleCount = audioData.size();
+        sampleRate = targetSampleRate;
+        samplesChanged();
+        return true;
+    }
+    
+    // Other ratios use simple linear interpolation (no anti-aliasing)
     double ratio = targetSampleRate / sampleRate;
-    size_t newLength = static_cast<size_t>(audioData.size() * ratio);
+    size_t newLength = static_cast<size_t>(sampleCount * ratio);
     
     std::vector<float> resampled;
     resampled.reserve(newLength);
@@ -390,124 +521,81 @@ bool AudioProcessor::resampleAudio(double targetSampleRate) {
     for (size_t i = 0; i < newLength; ++i) {
         double srcIndex = i / ratio;
         size_t index0 = static_cast<size_t>(srcIndex);
-        size_t index1 = std::min(index0 + 1, audioData.size() - 1);
+        size_t index1 = std::min(index0 + 1, sampleCount - 1);
         double frac = srcIndex - index0;
         
-        if (index0 < audioData.size()) {
-            float value = audioData[index0] * (1.0 - frac) + audioData[index1] * frac;
+        if (index0 < sampleCount) {
+            float value = sampleData[index0] * (1.0 - frac) + sampleData[index1] * frac;
             resampled.push_back(value);
         }
     }
     
     audioData = std::move(resampled);
+    sampleData = audioData.data();
+    sampleCount = audioData.size();
     sampleRate = targetSampleRate;
+    samplesChanged();
     
     return true;
 }
 
-void AudioProcessor::applyHannWindow(float* data, size_t length) const {
-    // Ensure window function is computed using vDSP for optimal performance
-    if (windowFunction.size() != length) {
-        windowFunction.resize(length);
-        
-        // Use Apple's optimized Hann window generation
-        vDSP_hann_window(windowFunction.data(), vDSP_Length(length), vDSP_HANN_NORM);
-    }
+void AudioProcessor::makeSamplesOwned() {
+    if (!isView()) return;
     
-    // Apply window using vectorized multiplication
-    vDSP_vmul(data, 1, windowFunction.data(), 1, data, 1, vDSP_Length(length));
+    audioData.assign(sampleData, sampleData + sampleCount);
+    sampleData = audioData.data();
 }
 
-void AudioProcessor::computeFFT(const float* input, size_t inputLength, std::vector<float>& magnitude) const {
-    // Validate input length is power of 2
-    if (inputLength == 0 || (inputLength & (inputLength - 1)) != 0) {
-        throw std::invalid_argument("FFT length must be power of 2 and > 0");
-    }
-    
-    if (inputLength > MAX_FRAME_SIZE) {
-        throw std::invalid_argument("FFT length exceeds maximum frame size");
-    }
-    
-    vDSP_Length log2Length = static_cast<vDSP_Length>(log2(inputLength));
-    size_t halfLength = inputLength / 2;
-    
-    // Prepare magnitude output
-    magnitude.resize(halfLength);
+void AudioProcessor::samplesChanged() {
+    clearSpectrogramCache();
+    statistics.reset();
+}
+
+void AudioProcessor::checkSamples(size_t& checkedEnd, size_t end, bool& finite) const {
+    end = std::min(end, sampleCount);
+    if (end <= checkedEnd) return;
     
-    // Ensure working buffer is large enough
-    if (workingBuffer.size() < inputLength) {
-        workingBuffer.resize(inputLength);
+    finite &= AudioStatistics::allFiniteSamples(sampleData + checkedEnd, end - checkedEnd);
+    checkedEnd = end;
+}
+
+void AudioProcessor::finishSampleCheck(bool finite) const {
+    sampleCheck = finite ? SampleCheck::Finite : SampleCheck::NonFinite;
+}
+
+const SpectrumKernel& AudioProcessor::kernelFor(size_t frameLength) const {
+    if (!spectrumKernel || spectrumKernel->getFrameLength() != frameLength) {
+        // Validate input length is power of 2
+        if (frameLength == 0 || (frameLength & (frameLength - 1)) != 0) {
+            throw std::invalid_argument("FFT length must be power of 2 and > 0");
+        }
+        
+        if (frameLength > MAX_FRAME_SIZE) {
+            throw std::invalid_argument("FFT length exceeds maximum frame size");
+        }
+        
+        spectrumKernel = SpectrumKernel::get(frameLength);
     }
-    
-    // Copy and window the input
-    std::copy(input, input + inputLength, workingBuffer.begin());
-    applyHannWindow(workingBuffer.data(), inputLength);
-    
-    // Set up split complex structure using working buffer
-    DSPSplitComplex localSplitComplex;
-    localSplitComplex.realp = workingBuffer.data();
-    localSplitComplex.imagp = workingBuffer.data() + halfLength;
-    
-    // Convert real input to split complex format (interleaved to split)
-    vDSP_ctoz((const DSPComplex*)workingBuffer.data(), 2, &localSplitComplex, 1, halfLength);
-    
-    // Perform forward FFT
-    vDSP_fft_zrip(fftSetup, &localSplitComplex, 1, log2Length, FFT_FORWARD);
-    
-    // Compute magnitude spectrum: sqrt(real^2 + imag^2)
-    vDSP_zvmags(&localSplitComplex, 1, magnitude.data(), 1, halfLength);
-    
-    // Apply scaling for proper normalization
-    float scale = 1.0f / inputLength;
-    vDSP_vsmul(magnitude.data(), 1, &scale, magnitude.data(), 1, halfLength);
-    
-    // Take square root to get magnitude from power
-    int length_int = static_cast<int>(halfLength);
-    vvsqrtf(magnitude.data(), magnitude.data(), &length_int);
+    return *spectrumKernel;
+}
+
+void AudioProcessor::computeFFT(const float* input, size_t inputLength, std::vector<float>& magnitude) const {
+    // Prepare magnitude output (length is validated by kernelFor)
+    const SpectrumKernel& kernel = kernelFor(inputLength);
+    magnitude.resize(kernel.getBinCount());
+    kernel.magnitude(input, magnitude.data());
+}
+
+void AudioProcessor::computeMagnitudeFrame(const float* input, size_t inputLength, float* magnitude) const {
+    // Windowed, transformed and reduced to sqrt(|X|^2 / N) by the kernel of this length
+    kernelFor(inputLength).magnitude(input, magnitude);
 }
 
 void AudioProcessor::computePowerSpectrum(const float* input, size_t inputLength, std::vector<float>& power) const {
-    // Validate input length is power of 2
-    if (inputLength == 0 || (inputLength & (inputLength - 1)) != 0) {
-        throw std::invalid_argument("FFT length must be power of 2 and > 0");
-    }
-    
-    if (inputLength > MAX_FRAME_SIZE) {
-        throw std::invalid_argument("FFT length exceeds maximum frame size");
-    }
-    
-    vDSP_Length log2Length = static_cast<vDSP_Length>(log2(inputLength));
-    size_t halfLength = inputLength / 2;
-    
-    // Prepare power output
-    power.resize(halfLength);
-    
-    // Ensure working buffer is large enough
-    if (workingBuffer.size() < inputLength) {
-        workingBuffer.resize(inputLength);
-    }
-    
-    // Copy and window the input
-    std::copy(input, input + inputLength, workingBuffer.begin());
-    applyHannWindow(workingBuffer.data(), inputLength);
-    
-    // Set up split complex structure using working buffer
-    DSPSplitComplex localSplitComplex;
-    localSplitComplex.realp = workingBuffer.data();
-    localSplitComplex.imagp = workingBuffer.data() + halfLength;
-    
-    // Convert real input to split complex format (interleaved to split)
-    vDSP_ctoz((const DSPComplex*)workingBuffer.data(), 2, &localSplitComplex, 1, halfLength);
-    
-    // Perform forward FFT
-    vDSP_fft_zrip(fftSetup, &localSplitComplex, 1, log2Length, FFT_FORWARD);
-    
-    // Compute power spectrum: real^2 + imag^2
-    vDSP_zvmags(&localSplitComplex, 1, power.data(), 1, halfLength);
-    
-    // Apply scaling for proper normalization
-    float scale = 1.0f / (inputLength * inputLength);
-    vDSP_vsmul(power.data(), 1, &scale, power.data(), 1, halfLength);
+    // Power spectrum |X|^2 / N^2 of the windowed frame
+    const SpectrumKernel& kernel = kernelFor(inputLength);
+    power.resize(kernel.getBinCount());
+    kernel.power(input, power.data());
 }
 
 void AudioProcessor::magnitudeToDb(const std::vector<float>& magnitude, std::vector<float>& db, float minDb) const {
@@ -519,7 +607,7 @@ void AudioProcessor::magnitudeToDb(const std::vector<float>& magnitude, std::vec
     db.resize(magnitude.size());
     
     // Convert to dB: 20 * log10(magnitude)
-    // Using vvlog10f for vectorized log10, then scale by 20
+    // Vectorized log10, then scale by 20
     std::vector<float> temp = magnitude;
     
     // Clamp to minimum value to avoid log(0)
@@ -531,12 +619,10 @@ void AudioProcessor::magnitudeToDb(const std::vector<float>& magnitude, std::vec
     }
     
     // Vectorized log10
-    int size = static_cast<int>(temp.size());
-    vvlog10f(db.data(), temp.data(), &size);
+    DSP::log10(temp.data(), db.data(), temp.size());
     
     // Scale by 20
-    float scale = 20.0f;
-    vDSP_vsmul(db.data(), 1, &scale, db.data(), 1, temp.size());
+    DSP::scale(db.data(), 20.0f, db.data(), temp.size());
 }
 
 void AudioProcessor::powerToDb(const std::vector<float>& power, std::vector<float>& db, float minDb) const {
@@ -559,109 +645,10 @@ void AudioProcessor::powerToDb(const std::vector<float>& power, std::vector<floa
     }
     
     // Vectorized log10
-    int size = static_cast<int>(temp.size());
-    vvlog10f(db.data(), temp.data(), &size);
+    DSP::log10(temp.data(), db.data(), temp.size());
     
     // Scale by 10
-    float scale = 10.0f;
-    vDSP_vsmul(db.data(), 1, &scale, db.data(), 1, temp.size());
-}
-
-float AudioProcessor::frequencyToMel(float frequency) {
-    return 2595.0f * std::log10(1.0f + frequency / 700.0f);
-}
-
-float AudioProcessor::melToFrequency(float mel) {
-    return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f);
-}
-
-std::vector<std::vector<float>> AudioProcessor::createMelFilterBank(int numFilters, int fftSize, double sampleRate) const {
-    std::vector<std::vector<float>> filterBank(numFilters, std::vector<float>(fftSize, 0.0f));
-    
-    // Frequency range
-    float lowFreq = 0.0f;
-    float highFreq = sampleRate / 2.0f;
-    
-    // Convert to mel scale
-    float lowMel = frequencyToMel(lowFreq);
-    float highMel = frequencyToMel(highFreq);
-    
-    // Create equally spaced mel points
-    std::vector<float> melPoints(numFilters + 2);
-    for (int i = 0; i < numFilters + 2; ++i) {
-        melPoints[i] = lowMel + (highMel - lowMel) * i / (numFilters + 1);
-    }
-    
-    // Convert back to Hz and then to FFT bin indices
-    std::vector<int> binIndices(numFilters + 2);
-    for (int i = 0; i < numFilters + 2; ++i) {
-        float freq = melToFrequency(melPoints[i]);
-        binIndices[i] = static_cast<int>(freq * fftSize * 2 / sampleRate);
-        binIndices[i] = std::min(binIndices[i], fftSize - 1);
-    }
-    
-    // Create triangular filters
-    for (int i = 0; i < numFilters; ++i) {
-        int left = binIndices[i];
-        int center = binIndices[i + 1];
-        int right = binIndices[i + 2];
-        
-        // Left slope
-        for (int j = left; j < center; ++j) {
-            if (center > left) {
-                filterBank[i][j] = static_cast<float>(j - left) / (center - left);
-            }
-        }
-        
-        // Right slope
-        for (int j = center; j < right; ++j) {
-            if (right > center) {
-                filterBank[i][j] = static_cast<float>(right - j) / (right - center);
-            }
-        }
-    }
-    
-    return filterBank;
-}
-
-void AudioProcessor::computeDCT(const std::vector<float>& input, std::vector<float>& output, int numCoeffs) const {
-    output.resize(numCoeffs);
-    
-    for (int k = 0; k < numCoeffs; ++k) {
-        double sum = 0.0;
-        for (size_t n = 0; n < input.size(); ++n) {
-            sum += input[n] * std::cos(M_PI * k * (n + 0.5) / input.size());
-        }
-        output[k] = static_cast<float>(sum);
-    }
-}
-
-void AudioProcessor::computeChromaVector(const std::vector<float>& magnitude, std::vector<float>& chroma) const {
-    chroma.assign(12, 0.0f);
-    
-    // Map frequency bins to chroma classes
-    for (size_t i = 1; i < magnitude.size(); ++i) { // Skip DC
-        // Convert bin to frequency
-        double freq = i * sampleRate / (2.0 * (magnitude.size() - 1));
-        
-        if (freq > 80.0 && freq < 2000.0) { // Focus on musical range
-            // Convert to MIDI note number
-            double midiNote = 12.0 * std::log2(freq / 440.0) + 69.0; // A4 = 440Hz = MIDI 69
-            
-            if (midiNote >= 0) {
-                int chromaClass = static_cast<int>(midiNote) % 12;
-                chroma[chromaClass] += magnitude[i];
-            }
-        }
-    }
-    
-    // Normalize chroma vector
-    float sum = std::accumulate(chroma.begin(), chroma.end(), 0.0f);
-    if (sum > 0.0f) {
-        for (float& value : chroma) {
-            value /= sum;
-        }
-    }
+    DSP::scale(db.data(), 10.0f, db.data(), temp.size());
 }
 
 float AudioProcessor::calculateRMSEnergy(const float* data, size_t length) const {
@@ -675,35 +662,8 @@ float AudioProcessor::calculateRMSEnergy(const float* data, size_t length) const
     return std::sqrt(sum / length);
 }
 
-float AudioProcessor::findPeak(const float* data, size_t length) const {
-    if (length == 0) return 0.0f;
-    
-    float peak = 0.0f;
-    for (size_t i = 0; i < length; ++i) {
-        peak = std::max(peak, std::abs(data[i]));
-    }
-    
-    return peak;
-}
-
 void AudioProcessor::smoothFeatures(std::vector<float>& features, int filterSize) const {
-    if (features.size() < 3 || filterSize < 3) return;
-    
-    std::vector<float> smoothed = features;
-    int halfSize = filterSize / 2;
-    
-    for (size_t i = halfSize; i < features.size() - halfSize; ++i) {
-        std::vector<float> window;
-        for (int j = -halfSize; j <= halfSize; ++j) {
-            window.push_back(features[i + j]);
-        }
-        
-        // Median filter
-        std::sort(window.begin(), window.end());
-        smoothed[i] = window[window.size() / 2];
-    }
-    
-    features = std::move(smoothed);
+    FeatureFilters::medianFilter(features, filterSize);
 }
 
 } // namespace HarmoniqSync
\ No newline at end of file
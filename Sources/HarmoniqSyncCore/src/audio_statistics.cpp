@@ -0,0 +1,201 @@
+//
+//  audio_statistics.cpp
+//  HarmoniqSyncCore
+//
+//  Fused single-pass sample statistics
+//
+
+#include "../include/audio_statistics.hpp"
+#include "../include/audio_processor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+static const size_t BLOCK_LENGTH = 2048;  // Samples per block; float partials stay exact enough, and with its copy a block stays in L1
+static const int32_t EXPONENT_MASK = static_cast<int32_t>(AudioStatistics::EXPONENT_MASK);
+
+// MARK: - Helpers
+
+/// Float and integer partials of one block
+struct BlockPartials {
+    float sum = 0.0f;
+    float squares = 0.0f;
+    float peak = 0.0f;
+    int32_t silent = 0;
+    int32_t clipped = 0;
+    int32_t crossings = 0;
+    int32_t nonFinite = 0;
+};
+
+/// Bit pattern of a sample
+static inline int32_t sampleBits(float sample) {
+    int32_t bits;
+    std::memcpy(&bits, &sample, sizeof(bits));
+    return bits;
+}
+
+/// Fold samples [begin, end) into the partials, copying each one when a destination is given
+/// Every test is written as mask arithmetic on the bit pattern so the loop has no
+/// branches and vectorizes; a non-finite sample reads as +0 everywhere but its count.
+template <bool Copy>
+static void accumulateBlock(BlockPartials& partials, const float* samples, float* copy, size_t begin, size_t end,
+                            float offset, float silenceThreshold, float clippingThreshold) {
+    float sum = 0.0f, squares = 0.0f, peak = 0.0f;
+    int32_t silent = 0, clipped = 0, crossings = 0, nonFinite = 0;
+
+    for (size_t i = begin; i < end; ++i) {
+        float sample = samples[i];
+        if (Copy) copy[i] = sample;
+
+        int32_t bits = sampleBits(sample);
+        int32_t previousBits = sampleBits(samples[i - 1]);
+        int32_t finite = (bits & EXPONENT_MASK) != EXPONENT_MASK ? -1 : 0;
+        int32_t previousFinite = (previousBits & EXPONENT_MASK) != EXPONENT_MASK ? -1 : 0;
+
+        int32_t valueBits = bits & finite;
+        int32_t magnitudeBits = valueBits & 0x7FFFFFFF;
+        float value, magnitude, previousValue;
+        std::memcpy(&value, &valueBits, sizeof(value));
+        std::memcpy(&magnitude, &magnitudeBits, sizeof(magnitude));
+        int32_t previousValueBits = previousBits & previousFinite;
+        std::memcpy(&previousValue, &previousValueBits, sizeof(previousValue));
+
+        float centred = value - (finite ? offset : 0.0f);
+        sum += centred;
+        squares += centred * centred;
+        peak = std::max(peak, magnitude);
+        silent += (finite & (magnitude < silenceThreshold ? 1 : 0));
+        clipped += magnitude >= clippingThreshold ? 1 : 0;
+        crossings += (value >= 0.0f ? 1 : 0) ^ (previousValue >= 0.0f ? 1 : 0);
+        nonFinite += finite + 1;
+    }
+
+    partials.sum += sum;
+    partials.squares += squares;
+    partials.peak = std::max(partials.peak, peak);
+    partials.silent += silent;
+    partials.clipped += clipped;
+    partials.crossings += crossings;
+    partials.nonFinite += nonFinite;
+}
+
+// MARK: - Measurement
+
+AudioStatistics AudioStatistics::measure(const float* samples, size_t length,
+                                         float silenceThreshold, float clippingThreshold, float* copy) {
+    AudioStatistics statistics;
+    statistics.sampleCount = length;
+    statistics.firstNonFinite = length;
+    statistics.silenceThreshold = silenceThreshold;
+    statistics.clippingThreshold = clippingThreshold;
+    if (!samples || length == 0) return statistics;
+
+    const float offset = AudioStatistics::isFiniteSample(samples[0]) ? samples[0] : 0.0f;
+    statistics.offset = offset;
+
+    for (size_t start = 0; start < length; start += BLOCK_LENGTH) {
+        size_t end = std::min(start + BLOCK_LENGTH, length);
+        BlockPartials partials;
+
+        // The first sample has no neighbour to cross zero with: it is its own
+        // predecessor, so the shared loop counts no crossing for it
+        size_t begin = start;
+        if (start == 0) {
+            const float first[2] = {samples[0], samples[0]};
+            if (copy) copy[0] = samples[0];
+            accumulateBlock<false>(partials, first, nullptr, 1, 2, offset, silenceThreshold, clippingThreshold);
+            begin = 1;
+        }
+        if (copy) {
+            accumulateBlock<true>(partials, samples, copy, begin, end, offset, silenceThreshold, clippingThreshold);
+        } else {
+            accumulateBlock<false>(partials, samples, nullptr, begin, end, offset, silenceThreshold, clippingThreshold);
+        }
+
+        size_t blockNonFinite = static_cast<size_t>(partials.nonFinite);
+        statistics.sum += partials.sum;
+        statistics.sumSquares += partials.squares;
+        statistics.peak = std::max(statistics.peak, static_cast<double>(partials.peak));
+        statistics.silentCount += static_cast<size_t>(partials.silent);
+        statistics.clippedCount += static_cast<size_t>(partials.clipped);
+        statistics.zeroCrossings += static_cast<size_t>(partials.crossings);
+
+        // Only the block holding the first non-finite sample is scanned again
+        if (blockNonFinite > 0 && statistics.nonFiniteCount == 0) {
+            for (size_t i = start; i < end; ++i) {
+                if (!AudioStatistics::isFiniteSample(samples[i])) {
+                    statistics.firstNonFinite = i;
+                    break;
+                }
+            }
+        }
+        statistics.nonFiniteCount += blockNonFinite;
+    }
+
+    return statistics;
+}
+
+bool AudioStatistics::allFiniteSamples(const float* samples, size_t length) {
+    // Branch-free so the loop vectorizes; accumulates the answer instead of exiting early
+    int32_t nonFinite = 0;
+    for (size_t i = 0; i < length; ++i) {
+        nonFinite |= static_cast<int32_t>((sampleBits(samples[i]) & EXPONENT_MASK) == EXPONENT_MASK);
+    }
+    return nonFinite == 0;
+}
+
+double AudioStatistics::spectralCentroid(const Spectrogram& spectrogram) {
+    if (spectrogram.empty() || spectrogram.windowSize <= 0) return 0.0;
+
+    double weighted = 0.0;
+    double total = 0.0;
+    for (size_t frame = 0; frame < spectrogram.numFrames; ++frame) {
+        const float* magnitudes = spectrogram.frame(frame);
+        for (size_t bin = 0; bin < spectrogram.numBins; ++bin) {
+            weighted += static_cast<double>(bin) * magnitudes[bin];
+            total += magnitudes[bin];
+        }
+    }
+    if (total <= 0.0) return 0.0;
+
+    return weighted / total * spectrogram.sampleRate / static_cast<double>(spectrogram.windowSize);
+}
+
+// MARK: - Derived Values
+
+double AudioStatistics::mean() const {
+    size_t count = finiteCount();
+    return count > 0 ? offset + sum / static_cast<double>(count) : 0.0;
+}
+
+double AudioStatistics::variance() const {
+    size_t count = finiteCount();
+    if (count == 0) return 0.0;
+
+    double centredMean = sum / static_cast<double>(count);
+    return std::max(0.0, sumSquares / static_cast<double>(count) - centredMean * centredMean);
+}
+
+double AudioStatistics::rms() const {
+    double average = mean();
+    return std::sqrt(average * average + variance());
+}
+
+double AudioStatistics::silenceRatio() const {
+    return sampleCount > 0 ? static_cast<double>(silentCount) / static_cast<double>(sampleCount) : 1.0;
+}
+
+double AudioStatistics::clippingRatio() const {
+    return sampleCount > 0 ? static_cast<double>(clippedCount) / static_cast<double>(sampleCount) : 0.0;
+}
+
+double AudioStatistics::zeroCrossingRate() const {
+    return sampleCount > 1 ? static_cast<double>(zeroCrossings) / static_cast<double>(sampleCount - 1) : 0.0;
+}
+
+} // namespace HarmoniqSync
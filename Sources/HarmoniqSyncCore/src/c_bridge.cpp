@@ -9,10 +9,22 @@
 #include "../include/audio_processor.hpp"
 #include "../include/alignment_engine.hpp"
 #include "../include/sync_engine.hpp"
+#include "../include/reference_fingerprint.hpp"
+#include "../include/live_sync_tracker.hpp"
+#include "../include/feature_cache.hpp"
+#include "../include/cost_model.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <map>
+#include <cstring>
+#include <cstdlib>
 
 using namespace HarmoniqSync;
 
@@ -30,10 +42,18 @@ namespace {
             engineConfig.hopSize = config->hop_size;
             engineConfig.noiseGateDb = config->noise_gate_db;
             engineConfig.enableDriftCorrection = config->enable_drift_correction != 0;
+            engineConfig.numWorkers = config->worker_count;
+            engineConfig.coarseToFine.hopSize = config->coarse_hop_size;
+            engineConfig.analysisSampleRate = config->analysis_sample_rate;
+            engineConfig.cascade.enabled = config->hybrid_cascade != 0;
+            engineConfig.correlationPrecision = config->correlation_precision != 0 ? CorrelationEngine::Precision::Single
+                                                                                   : CorrelationEngine::Precision::Double;
+            engineConfig.correlationMemoryBytes = static_cast<size_t>(std::max(0, config->correlation_memory_mb)) << 20;
             
             // Algorithm-specific configurations
             engineConfig.spectralFlux.preEmphasisAlpha = 0.97f;
-            engineConfig.spectralFlux.medianFilterSize = 5;
+            // An onset raises the flux for two hops of a four-hop window; a wider median erases it
+            engineConfig.spectralFlux.medianFilterSize = 3;
             
             engineConfig.chroma.numChromaBins = 12;
             
@@ -48,6 +68,20 @@ namespace {
     }
 }
 
+/// Operation handle shared by the caller and the running task
+/// Each side holds a reference; the last one released deletes the handle.
+struct harmoniq_sync_operation {
+    std::shared_ptr<SyncOperation> operation;
+    std::mutex startMutex;   // Held until operation is assigned
+    std::atomic<int> references{2};
+    
+    void release() {
+        if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+};
+
 // MARK: - Core API Implementation
 
 extern "C" {
@@ -72,14 +106,14 @@ harmoniq_sync_result_t harmoniq_sync_align(
         // Create audio processors
         AudioProcessor refProcessor, targetProcessor;
         
-        // Load audio data
-        if (!refProcessor.loadAudio(reference_audio, ref_length, sample_rate)) {
+        // Borrow the caller's buffers for the duration of the call
+        if (!refProcessor.loadAudioView(reference_audio, ref_length, sample_rate)) {
             result.error = HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
             std::strcpy(result.method, "LoadFailed");
             return result;
         }
         
-        if (!targetProcessor.loadAudio(target_audio, target_length, sample_rate)) {
+        if (!targetProcessor.loadAudioView(target_audio, target_length, sample_rate)) {
             result.error = HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
             std::strcpy(result.method, "LoadFailed");
             return result;
@@ -137,7 +171,7 @@ harmoniq_sync_batch_result_t harmoniq_sync_align_batch(
         
         // Create reference processor once
         AudioProcessor refProcessor;
-        if (!refProcessor.loadAudio(reference_audio, ref_length, sample_rate)) {
+        if (!refProcessor.loadAudioView(reference_audio, ref_length, sample_rate)) {
             batch_result.error = HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
             return batch_result;
         }
@@ -150,7 +184,7 @@ harmoniq_sync_batch_result_t harmoniq_sync_align_batch(
         // Create target processors
         std::vector<AudioProcessor> targetProcessors(target_count);
         for (size_t i = 0; i < target_count; i++) {
-            if (!targetProcessors[i].loadAudio(target_audios[i], target_lengths[i], sample_rate)) {
+            if (!targetProcessors[i].loadAudioView(target_audios[i], target_lengths[i], sample_rate)) {
                 // We will continue and let the batch alignment handle the error
             }
         }
@@ -180,6 +214,31 @@ harmoniq_sync_batch_result_t harmoniq_sync_align_batch(
     }
 }
 
+harmoniq_sync_error_t harmoniq_sync_correct_drift(
+    const float* target_audio, size_t target_length,
+    const harmoniq_sync_result_t* result,
+    float* output
+) {
+    if (!target_audio || !result || !output || target_length == 0) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    if (result->error != HARMONIQ_SYNC_SUCCESS) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    try {
+        auto corrected = AlignmentEngine::correctDrift(target_audio, target_length,
+                                                       result->offset_samples_fractional, result->drift_ppm);
+        std::copy(corrected.begin(), corrected.end(), output);
+        return HARMONIQ_SYNC_SUCCESS;
+    } catch (const std::bad_alloc&) {
+        return HARMONIQ_SYNC_ERROR_OUT_OF_MEMORY;
+    } catch (...) {
+        return HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
+    }
+}
+
 harmoniq_sync_config_t harmoniq_sync_default_config(void) {
     harmoniq_sync_config_t config = {};
     
@@ -189,6 +248,12 @@ harmoniq_sync_config_t harmoniq_sync_default_config(void) {
     config.hop_size = 256;
     config.noise_gate_db = -40.0;
     config.enable_drift_correction = 1;
+    config.worker_count = 0; // Use all pool threads
+    config.coarse_hop_size = 0; // Single resolution search
+    config.analysis_sample_rate = 0.0; // Analyse at the source rate
+    config.hybrid_cascade = 0; // Hybrid combines every method
+    config.correlation_precision = 0; // Double precision correlation
+    config.correlation_memory_mb = 0; // Correlations are never partitioned
     
     return config;
 }
@@ -263,6 +328,10 @@ const char* harmoniq_sync_error_description(harmoniq_sync_error_t error) {
             return "Insufficient memory to complete operation";
         case HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT:
             return "Unsupported audio format or configuration";
+        case HARMONIQ_SYNC_ERROR_CANCELLED:
+            return "Operation was cancelled";
+        case HARMONIQ_SYNC_ERROR_TIMEOUT:
+            return "Operation did not finish before its timeout";
         default:
             return "Unknown error occurred";
     }
@@ -310,6 +379,38 @@ harmoniq_sync_error_t harmoniq_sync_validate_config(const harmoniq_sync_config_t
         return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
     }
     
+    // Validate worker count (0 = auto)
+    if (config->worker_count < 0) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    // Validate coarse search hop (0 = disabled, otherwise at least one analysis hop)
+    if (config->coarse_hop_size < 0 ||
+        (config->coarse_hop_size > 0 && config->coarse_hop_size < config->hop_size)) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    // Validate analysis rate (0 = source rate, otherwise a supported sample rate)
+    if (config->analysis_sample_rate < 0.0 ||
+        (config->analysis_sample_rate > 0.0 && config->analysis_sample_rate < 8000.0)) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    // Validate hybrid cascade flag
+    if (config->hybrid_cascade != 0 && config->hybrid_cascade != 1) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    // Validate correlation precision (0 = double, 1 = single)
+    if (config->correlation_precision != 0 && config->correlation_precision != 1) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    // Validate correlation memory budget (0 = no limit)
+    if (config->correlation_memory_mb < 0) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
     return HARMONIQ_SYNC_SUCCESS;
 }
 
@@ -482,6 +583,325 @@ harmoniq_sync_error_t harmoniq_sync_set_engine_config(
     }
 }
 
+harmoniq_sync_reference_t* harmoniq_sync_create_reference(
+    const float* reference_audio, size_t ref_length,
+    double sample_rate,
+    harmoniq_sync_method_t method,
+    const harmoniq_sync_config_t* config
+) {
+    if (!reference_audio || ref_length == 0 || sample_rate <= 0) {
+        return nullptr;
+    }
+    
+    try {
+        auto reference = new ReferenceFingerprint(reference_audio, ref_length, sample_rate,
+                                                  method, createEngineConfig(config));
+        return reinterpret_cast<harmoniq_sync_reference_t*>(reference);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void harmoniq_sync_destroy_reference(harmoniq_sync_reference_t* reference) {
+    if (reference) {
+        auto fingerprint = reinterpret_cast<ReferenceFingerprint*>(reference);
+        delete fingerprint;
+    }
+}
+
+harmoniq_sync_result_t harmoniq_sync_align_with_reference(
+    const harmoniq_sync_reference_t* reference,
+    const float* target_audio, size_t target_length,
+    double sample_rate
+) {
+    harmoniq_sync_result_t result = {};
+    
+    if (!reference || !target_audio || target_length == 0 || sample_rate <= 0) {
+        result.error = HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+        std::strcpy(result.method, "Invalid");
+        return result;
+    }
+    
+    try {
+        auto fingerprint = reinterpret_cast<const ReferenceFingerprint*>(reference);
+        return fingerprint->align(target_audio, target_length, sample_rate);
+    } catch (const std::exception& e) {
+        result.error = HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
+        std::strcpy(result.method, "Exception");
+        return result;
+    } catch (...) {
+        result.error = HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
+        std::strcpy(result.method, "Unknown");
+        return result;
+    }
+}
+
+harmoniq_sync_batch_result_t harmoniq_sync_align_batch_with_reference(
+    const harmoniq_sync_reference_t* reference,
+    const float** target_audios, const size_t* target_lengths, size_t target_count,
+    double sample_rate
+) {
+    harmoniq_sync_batch_result_t batch_result = {};
+    
+    if (!reference || !target_audios || !target_lengths || target_count == 0 || sample_rate <= 0) {
+        batch_result.error = HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+        return batch_result;
+    }
+    
+    try {
+        auto fingerprint = reinterpret_cast<const ReferenceFingerprint*>(reference);
+        auto results = fingerprint->alignBatch(target_audios, target_lengths, target_count, sample_rate);
+        
+        // Allocate results array and copy results
+        batch_result.results = (harmoniq_sync_result_t*)std::malloc(sizeof(harmoniq_sync_result_t) * results.size());
+        if (!batch_result.results) {
+            batch_result.error = HARMONIQ_SYNC_ERROR_OUT_OF_MEMORY;
+            return batch_result;
+        }
+        
+        std::copy(results.begin(), results.end(), batch_result.results);
+        batch_result.count = results.size();
+        batch_result.error = HARMONIQ_SYNC_SUCCESS;
+        
+        return batch_result;
+        
+    } catch (...) {
+        batch_result.error = HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
+        return batch_result;
+    }
+}
+
+harmoniq_sync_grouping_result_t harmoniq_sync_group_clips(
+    const float** clip_audios, const size_t* clip_lengths, size_t clip_count,
+    double sample_rate,
+    const harmoniq_sync_config_t* config
+) {
+    harmoniq_sync_grouping_result_t grouping_result = {};
+    
+    if (!clip_audios || !clip_lengths || clip_count == 0 || sample_rate <= 0) {
+        grouping_result.error = HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+        return grouping_result;
+    }
+    
+    try {
+        // Clips that fail to load stay invalid and are placed alone
+        std::vector<AudioProcessor> clips(clip_count);
+        for (size_t i = 0; i < clip_count; i++) {
+            if (clip_audios[i]) {
+                clips[i].loadAudioView(clip_audios[i], clip_lengths[i], sample_rate);
+            }
+        }
+        
+        AlignmentEngine engine;
+        engine.setConfig(createEngineConfig(config));
+        auto grouping = engine.groupClips(clips);
+        
+        grouping_result.placements = (harmoniq_sync_clip_placement_t*)std::malloc(
+            sizeof(harmoniq_sync_clip_placement_t) * grouping.clips.size());
+        if (!grouping_result.placements) {
+            grouping_result.error = HARMONIQ_SYNC_ERROR_OUT_OF_MEMORY;
+            return grouping_result;
+        }
+        
+        for (size_t i = 0; i < grouping.clips.size(); i++) {
+            const auto& clip = grouping.clips[i];
+            auto& placement = grouping_result.placements[i];
+            placement.timeline_offset_fractional = clip.startSamples;
+            placement.timeline_offset_samples = static_cast<int64_t>(std::llround(clip.startSamples));
+            placement.group = static_cast<int>(clip.group);
+            placement.pair_count = static_cast<int>(clip.measurements);
+        }
+        grouping_result.count = grouping.clips.size();
+        grouping_result.group_count = grouping.groupCount;
+        grouping_result.error = HARMONIQ_SYNC_SUCCESS;
+        
+        return grouping_result;
+        
+    } catch (...) {
+        grouping_result.error = HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
+        return grouping_result;
+    }
+}
+
+void harmoniq_sync_free_grouping_result(harmoniq_sync_grouping_result_t* grouping_result) {
+    if (grouping_result && grouping_result->placements) {
+        std::free(grouping_result->placements);
+        grouping_result->placements = nullptr;
+        grouping_result->count = 0;
+    }
+}
+
+harmoniq_sync_tracker_t* harmoniq_sync_create_tracker(
+    double sample_rate, size_t feed_count,
+    double window_seconds, double max_lag_seconds, double update_interval_ms
+) {
+    if (sample_rate <= 0 || feed_count < 2 ||
+        window_seconds < 0 || max_lag_seconds < 0 || update_interval_ms < 0) {
+        return nullptr;
+    }
+    
+    try {
+        LiveSyncTracker::Settings settings;
+        if (window_seconds > 0) settings.windowSeconds = window_seconds;
+        if (max_lag_seconds > 0) settings.maxLagSeconds = max_lag_seconds;
+        if (update_interval_ms > 0) settings.updateIntervalMs = update_interval_ms;
+        
+        auto tracker = new LiveSyncTracker(sample_rate, feed_count, settings);
+        return reinterpret_cast<harmoniq_sync_tracker_t*>(tracker);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void harmoniq_sync_destroy_tracker(harmoniq_sync_tracker_t* tracker) {
+    if (tracker) {
+        auto liveTracker = reinterpret_cast<LiveSyncTracker*>(tracker);
+        delete liveTracker;
+    }
+}
+
+harmoniq_sync_error_t harmoniq_sync_tracker_push(
+    harmoniq_sync_tracker_t* tracker, size_t feed,
+    const float* samples, size_t length
+) {
+    if (!tracker) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    auto liveTracker = reinterpret_cast<LiveSyncTracker*>(tracker);
+    return liveTracker->processBlock(feed, samples, length) ? HARMONIQ_SYNC_SUCCESS
+                                                            : HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+}
+
+harmoniq_sync_error_t harmoniq_sync_tracker_get_estimate(
+    harmoniq_sync_tracker_t* tracker, size_t feed,
+    harmoniq_sync_live_estimate_t* estimate
+) {
+    if (!tracker || !estimate) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    auto liveTracker = reinterpret_cast<LiveSyncTracker*>(tracker);
+    if (feed == 0 || feed >= liveTracker->getFeedCount()) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    auto current = liveTracker->getEstimate(feed);
+    estimate->valid = current.valid ? 1 : 0;
+    estimate->offset_samples = current.offsetSamples;
+    estimate->confidence = current.confidence;
+    estimate->secondary_peak_ratio = current.secondaryPeakRatio;
+    estimate->drift_ppm = current.driftPpm;
+    estimate->drift_points = static_cast<int>(current.driftPoints);
+    estimate->time_seconds = current.timeSeconds;
+    return HARMONIQ_SYNC_SUCCESS;
+}
+
+harmoniq_sync_operation_t* harmoniq_sync_process_async(
+    harmoniq_sync_engine_t* engine,
+    const float* reference_samples, size_t ref_count,
+    const float* target_samples, size_t target_count,
+    double timeout_seconds,
+    harmoniq_sync_completion_callback_t callback,
+    void* user_data
+) {
+    if (!engine || !reference_samples || !target_samples || ref_count == 0 || target_count == 0 ||
+        !(timeout_seconds >= 0.0)) {
+        return nullptr;
+    }
+    
+    harmoniq_sync_operation_t* handle = nullptr;
+    try {
+        handle = new harmoniq_sync_operation();
+        auto syncEngine = reinterpret_cast<SyncEngine*>(engine);
+        auto timeout = std::chrono::milliseconds(static_cast<int64_t>(std::ceil(timeout_seconds * 1000.0)));
+        
+        // Same defaults as harmoniq_sync_process
+        std::lock_guard<std::mutex> lock(handle->startMutex);
+        handle->operation = syncEngine->processAsync(
+            reference_samples, ref_count,
+            target_samples, target_count,
+            44100.0, HARMONIQ_SYNC_SPECTRAL_FLUX, timeout,
+            [handle, callback, user_data](const harmoniq_sync_result_t& result) {
+                // Do not hand out the handle before it is complete
+                { std::lock_guard<std::mutex> started(handle->startMutex); }
+                if (callback) {
+                    callback(handle, &result, user_data);
+                }
+                handle->release();
+            });
+        return handle;
+    } catch (...) {
+        // Nothing was queued, so the task's reference is never released
+        delete handle;
+        return nullptr;
+    }
+}
+
+harmoniq_sync_error_t harmoniq_sync_cancel(harmoniq_sync_operation_t* operation) {
+    if (!operation) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    operation->operation->cancel();
+    return HARMONIQ_SYNC_SUCCESS;
+}
+
+harmoniq_sync_error_t harmoniq_sync_wait(harmoniq_sync_operation_t* operation, harmoniq_sync_result_t* result) {
+    if (!operation) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    harmoniq_sync_result_t finished = operation->operation->wait();
+    if (result) {
+        *result = finished;
+    }
+    return finished.error;
+}
+
+void harmoniq_sync_release_operation(harmoniq_sync_operation_t* operation) {
+    if (operation) {
+        operation->release();
+    }
+}
+
+harmoniq_sync_error_t harmoniq_sync_set_feature_cache_directory(
+    harmoniq_sync_engine_t* engine,
+    const char* directory
+) {
+    return harmoniq_sync_set_feature_cache(engine, directory, HARMONIQ_SYNC_FEATURE_STORAGE_FLOAT32);
+}
+
+harmoniq_sync_error_t harmoniq_sync_set_feature_cache(
+    harmoniq_sync_engine_t* engine,
+    const char* directory,
+    harmoniq_sync_feature_storage_t storage
+) {
+    static_assert(static_cast<int>(FeatureCache::Storage::BFloat16) == HARMONIQ_SYNC_FEATURE_STORAGE_BFLOAT16 &&
+                  static_cast<int>(FeatureCache::Storage::Int16) == HARMONIQ_SYNC_FEATURE_STORAGE_INT16,
+                  "harmoniq_sync_feature_storage_t must match FeatureCache::Storage");
+    if (!engine || storage < HARMONIQ_SYNC_FEATURE_STORAGE_FLOAT32 || storage > HARMONIQ_SYNC_FEATURE_STORAGE_INT16) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    auto syncEngine = reinterpret_cast<SyncEngine*>(engine);
+    if (!directory || directory[0] == '\0') {
+        syncEngine->setFeatureCache(nullptr);
+        return HARMONIQ_SYNC_SUCCESS;
+    }
+    
+    try {
+        syncEngine->setFeatureCache(std::make_shared<FeatureCache>(directory, static_cast<FeatureCache::Storage>(storage)));
+        return HARMONIQ_SYNC_SUCCESS;
+    } catch (const std::invalid_argument&) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    } catch (const std::bad_alloc&) {
+        return HARMONIQ_SYNC_ERROR_OUT_OF_MEMORY;
+    } catch (...) {
+        return HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
+    }
+}
+
 harmoniq_sync_config_t harmoniq_sync_get_engine_config(harmoniq_sync_engine_t* engine) {
     harmoniq_sync_config_t defaultConfig = harmoniq_sync_default_config();
     
@@ -497,4 +917,94 @@ harmoniq_sync_config_t harmoniq_sync_get_engine_config(harmoniq_sync_engine_t* e
     }
 }
 
+harmoniq_sync_error_t harmoniq_sync_get_last_stats(
+    const harmoniq_sync_engine_t* engine,
+    harmoniq_sync_stats_t* stats
+) {
+    if (!engine || !stats) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    auto syncEngine = reinterpret_cast<const SyncEngine*>(engine);
+    auto last = syncEngine->getLastProcessingStats();
+    const auto& stages = last.stages;
+    
+    *stats = {};
+    stats->total_seconds = last.processingTimeSeconds;
+    stats->audio_length_seconds = last.audioLengthSeconds;
+    stats->realtime_ratio = last.realtimeRatio;
+    stats->load_seconds = stages.seconds(ProcessingStage::LoadValidate);
+    stats->resample_seconds = stages.seconds(ProcessingStage::Resample);
+    stats->stft_seconds = stages.seconds(ProcessingStage::STFT);
+    stats->feature_seconds = stages.seconds(ProcessingStage::FeatureExtraction);
+    stats->post_process_seconds = stages.seconds(ProcessingStage::FeaturePostProcessing);
+    stats->correlation_seconds = stages.seconds(ProcessingStage::Correlation);
+    stats->peak_picking_seconds = stages.seconds(ProcessingStage::PeakPicking);
+    stats->confidence_seconds = stages.seconds(ProcessingStage::Confidence);
+    stats->drift_seconds = stages.seconds(ProcessingStage::DriftEstimation);
+    stats->refinement_seconds = stages.seconds(ProcessingStage::Refinement);
+    std::copy(stages.methodSeconds.begin(), stages.methodSeconds.end(), stats->method_seconds);
+    std::copy(stages.methodRuns.begin(), stages.methodRuns.end(), stats->method_runs);
+    stats->peak_allocated_bytes = last.memoryUsedBytes;
+    stats->method = last.methodUsed;
+    stats->successful = last.successful ? 1 : 0;
+    
+    return HARMONIQ_SYNC_SUCCESS;
+}
+
+
+harmoniq_sync_error_t harmoniq_sync_load_cost_profile(const char* path) {
+    if (!path) {
+        CostModel::setShared(nullptr);
+        return HARMONIQ_SYNC_SUCCESS;
+    }
+    
+    try {
+        auto model = std::make_shared<CostModel>();
+        if (!model->load(path)) {
+            return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+        }
+        CostModel::setShared(std::move(model));
+        return HARMONIQ_SYNC_SUCCESS;
+    } catch (...) {
+        return HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
+    }
+}
+
+harmoniq_sync_error_t harmoniq_sync_estimate_cost(
+    const harmoniq_sync_engine_t* engine,
+    size_t ref_count, size_t target_count,
+    double sample_rate,
+    harmoniq_sync_method_t method,
+    double deadline_seconds,
+    size_t memory_budget_bytes,
+    double confidence,
+    harmoniq_sync_cost_estimate_t* estimate
+) {
+    static_assert(sizeof(estimate->stage_seconds) / sizeof(double) == PROCESSING_STAGE_COUNT,
+                  "stage_seconds must hold every ProcessingStage");
+    if (!engine || !estimate || sample_rate <= 0.0 ||
+        method < HARMONIQ_SYNC_SPECTRAL_FLUX || method > HARMONIQ_SYNC_HYBRID) {
+        return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
+    }
+    
+    try {
+        auto syncEngine = reinterpret_cast<const SyncEngine*>(engine);
+        auto admission = syncEngine->admitJob(ref_count, target_count, sample_rate, method,
+                                              deadline_seconds, memory_budget_bytes, confidence);
+        
+        *estimate = {};
+        estimate->expected_seconds = admission.prediction.seconds;
+        estimate->upper_seconds = admission.prediction.upperSeconds;
+        estimate->on_time_probability = admission.onTimeProbability;
+        estimate->peak_bytes = admission.prediction.peakBytes;
+        estimate->admitted = admission.admitted ? 1 : 0;
+        std::copy(admission.prediction.stageSeconds.begin(), admission.prediction.stageSeconds.end(),
+                  estimate->stage_seconds);
+        return HARMONIQ_SYNC_SUCCESS;
+    } catch (...) {
+        return HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
+    }
+}
+
 } // extern "C"
\ No newline at end of file
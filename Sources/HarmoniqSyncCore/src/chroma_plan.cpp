@@ -0,0 +1,132 @@
+//
+//  chroma_plan.cpp
+//  HarmoniqSyncCore
+//
+//  Run-length bin-to-pitch-class map applied as a gather-accumulate over frames
+//  Uses the DSP backend for the run sums
+//
+
+#include "../include/chroma_plan.hpp"
+#include "../include/dsp_backend.hpp"
+#include "../include/operation_control.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Musical range considered, in Hz (exclusive bounds)
+static const double MIN_FREQUENCY = 80.0;
+static const double MAX_FREQUENCY = 2000.0;
+
+// Harmonics credited when harmonic weighting is enabled, and the weight ratio between them
+static const int NUM_HARMONICS = 4;
+static const float HARMONIC_DECAY = 0.6f;
+
+// MARK: - Lifecycle
+
+ChromaPlan::ChromaPlan(double sampleRate, size_t numBins, int numChromaBins, bool harmonicWeighting)
+    : sampleRate_(sampleRate)
+    , numBins_(numBins)
+    , numChromaBins_(numChromaBins)
+    , harmonicWeighting_(harmonicWeighting) {
+    if (sampleRate <= 0.0 || numBins < 2 || numChromaBins <= 0) {
+        throw std::invalid_argument("Invalid chroma plan configuration");
+    }
+
+    buildRuns();
+}
+
+std::shared_ptr<const ChromaPlan> ChromaPlan::get(double sampleRate, size_t numBins, int numChromaBins, bool harmonicWeighting) {
+    using Key = std::tuple<double, size_t, int, bool>;
+    static std::mutex mutex;
+    static std::map<Key, std::shared_ptr<const ChromaPlan>> plans;
+
+    Key key(sampleRate, numBins, numChromaBins, harmonicWeighting);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = plans.find(key);
+    if (it != plans.end()) {
+        return it->second;
+    }
+
+    auto plan = std::make_shared<const ChromaPlan>(sampleRate, numBins, numChromaBins, harmonicWeighting);
+    plans.emplace(key, plan);
+    return plan;
+}
+
+// MARK: - Processing
+
+void ChromaPlan::apply(const float* magnitudes, size_t numFrames, float* output) const {
+    const size_t numClasses = static_cast<size_t>(numChromaBins_);
+
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        CancellationScope::check();
+        const float* magnitude = magnitudes + frame * numBins_;
+        float* chroma = output + frame * numClasses;
+        std::fill(chroma, chroma + numClasses, 0.0f);
+
+        for (const Run& run : runs_) {
+            chroma[run.chromaClass] += run.weight * DSP::sum(magnitude + run.start, run.length);
+        }
+
+        // Normalize chroma vector
+        float total = DSP::sum(chroma, numClasses);
+        if (total > 0.0f) {
+            for (size_t i = 0; i < numClasses; ++i) {
+                chroma[i] /= total;
+            }
+        }
+    }
+}
+
+// MARK: - Private Methods
+
+void ChromaPlan::buildRuns() {
+    const double classesPerSemitone = numChromaBins_ / 12.0;
+    const int numHarmonics = harmonicWeighting_ ? NUM_HARMONICS : 1;
+
+    float weight = 1.0f;
+    for (int harmonic = 1; harmonic <= numHarmonics; ++harmonic, weight *= HARMONIC_DECAY) {
+        Run current;
+        current.weight = weight;
+
+        for (size_t i = 1; i < numBins_; ++i) { // Skip DC
+            // Bin spacing as extraction has always assumed it
+            double freq = i * sampleRate_ / (2.0 * (numBins_ - 1));
+            double fundamental = freq / harmonic;
+
+            int chromaClass = -1;
+            if (freq > MIN_FREQUENCY && freq < MAX_FREQUENCY && fundamental > MIN_FREQUENCY) {
+                // MIDI note number, A4 = 440Hz = MIDI 69
+                double midiNote = 12.0 * std::log2(fundamental / 440.0) + 69.0;
+                if (midiNote >= 0) {
+                    chromaClass = static_cast<int>(midiNote * classesPerSemitone) % numChromaBins_;
+                }
+            }
+
+            if (current.length > 0 && chromaClass != current.chromaClass) {
+                runs_.push_back(current);
+                current.length = 0;
+            }
+            if (chromaClass >= 0) {
+                if (current.length == 0) {
+                    current.start = i;
+                    current.chromaClass = chromaClass;
+                }
+                ++current.length;
+            }
+        }
+
+        if (current.length > 0) {
+            runs_.push_back(current);
+        }
+    }
+}
+
+} // namespace HarmoniqSync
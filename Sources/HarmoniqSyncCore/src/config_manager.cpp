@@ -6,6 +6,7 @@
 //
 
 #include "../include/config_manager.hpp"
+#include "../include/cost_model.hpp"
 #include <sstream>
 #include <fstream>
 #include <algorithm>
@@ -83,6 +84,10 @@ harmoniq_sync_config_t ConfigManager::createBaseConfig(ConfigProfile profile) {
             config.hop_size = 256;
             config.noise_gate_db = -35.0;
             config.enable_drift_correction = 0;
+            config.coarse_hop_size = 4096;
+            config.analysis_sample_rate = 16000.0;
+            config.hybrid_cascade = 1;
+            config.correlation_precision = 1;
             break;
             
         case ConfigProfile::Accurate:
@@ -119,6 +124,7 @@ harmoniq_sync_config_t ConfigManager::createBaseConfig(ConfigProfile profile) {
             config.hop_size = 128;
             config.noise_gate_db = -30.0;
             config.enable_drift_correction = 0;
+            config.analysis_sample_rate = 16000.0;
             break;
             
         default: // Custom - use balanced as starting point
@@ -509,4 +515,63 @@ ExtendedConfig ConfigBuilder::build() {
     return ConfigManager::validateConfiguration(config_);
 }
 
-} // namespace HarmoniqSync
\ No newline at end of file
+// MARK: - ConfigPerformanceAnalyzer Implementation
+
+ConfigPerformanceAnalyzer::PerformancePrediction ConfigPerformanceAnalyzer::predictPerformance(
+    const ExtendedConfig& config,
+    size_t audioLengthSamples,
+    double sampleRate
+) {
+    PerformancePrediction prediction;
+    if (sampleRate <= 0.0) return prediction;
+    
+    // Spectral flux is the engine's default method; both clips have the given length
+    auto job = CostModel::Job::fromConfig(config.config, HARMONIQ_SYNC_SPECTRAL_FLUX,
+                                          audioLengthSamples, audioLengthSamples, sampleRate);
+    auto cost = CostModel::shared()->predict(job);
+    prediction.expectedProcessingTime = cost.seconds;
+    prediction.expectedMemoryUsage = cost.peakBytes;
+    
+    std::ostringstream bound;
+    bound << "95% of runs finish within " << std::fixed << std::setprecision(3) << cost.upperSeconds << " s";
+    prediction.performanceNotes.push_back(bound.str());
+    
+    auto slowest = std::max_element(cost.stageSeconds.begin(), cost.stageSeconds.end());
+    if (cost.seconds > 0.0 && *slowest > 0.5 * cost.seconds) {
+        static const char* stageNames[PROCESSING_STAGE_COUNT] = {
+            "Loading", "Resampling", "STFT", "Feature extraction", "Feature post-processing",
+            "Correlation", "Peak picking", "Confidence scoring", "Drift estimation", "Refinement"
+        };
+        prediction.performanceNotes.push_back(std::string(stageNames[slowest - cost.stageSeconds.begin()]) +
+                                              " dominates the processing time");
+    }
+    
+    return prediction;
+}
+
+std::vector<std::pair<ExtendedConfig, ConfigPerformanceAnalyzer::PerformancePrediction>>
+ConfigPerformanceAnalyzer::comparePerformance(
+    const std::vector<ExtendedConfig>& configurations,
+    size_t audioLengthSamples,
+    double sampleRate
+) {
+    std::vector<std::pair<ExtendedConfig, PerformancePrediction>> predictions;
+    predictions.reserve(configurations.size());
+    for (const auto& config : configurations) {
+        predictions.emplace_back(config, predictPerformance(config, audioLengthSamples, sampleRate));
+    }
+    
+    // Fastest first
+    std::stable_sort(predictions.begin(), predictions.end(), [](const auto& a, const auto& b) {
+        return a.second.expectedProcessingTime < b.second.expectedProcessingTime;
+    });
+    return predictions;
+}
+
+size_t ConfigPerformanceAnalyzer::estimateMemoryFootprint(const harmoniq_sync_config_t& config, size_t audioLength) {
+    // Hybrid holds every feature matrix, so it bounds the footprint of all methods
+    auto job = CostModel::Job::fromConfig(config, HARMONIQ_SYNC_HYBRID, audioLength, audioLength, 44100.0);
+    return CostModel::shared()->predict(job).peakBytes;
+}
+
+} // namespace HarmoniqSync
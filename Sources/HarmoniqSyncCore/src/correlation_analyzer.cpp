@@ -0,0 +1,179 @@
+//
+//  correlation_analyzer.cpp
+//  HarmoniqSyncCore
+//
+//  Single-pass statistics and peak extraction for correlation curves
+//
+
+#include "../include/correlation_analyzer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Magnitudes are bucketed by their IEEE exponent and leading mantissa bits, so
+// no bucket is wider than 1/32 of its lower edge whatever the scale of the curve
+static const int MANTISSA_BITS = 5;
+static const int MIN_EXPONENT = -40;   // Smaller magnitudes share the zero bucket
+static const int OCTAVES = 64;         // Larger magnitudes share the overflow bucket
+
+static const size_t REGULAR_BUCKETS = static_cast<size_t>(OCTAVES) << MANTISSA_BITS;
+static const size_t HISTOGRAM_SIZE = REGULAR_BUCKETS + 2;
+static const uint64_t MIN_KEY = static_cast<uint64_t>(1023 + MIN_EXPONENT) << MANTISSA_BITS;
+static const double MIN_MAGNITUDE = std::ldexp(1.0, MIN_EXPONENT);
+
+// MARK: - Helpers
+
+/// Bucket of a magnitude: 0 for zero (and NaN), then REGULAR_BUCKETS logarithmic
+/// buckets, then one for everything above the regular range
+static size_t bucketOf(double magnitude) {
+    if (!(magnitude >= MIN_MAGNITUDE)) return 0;
+
+    uint64_t bits;
+    std::memcpy(&bits, &magnitude, sizeof(bits));
+    uint64_t key = (bits >> (52 - MANTISSA_BITS)) - MIN_KEY;
+    return static_cast<size_t>(std::min<uint64_t>(key, REGULAR_BUCKETS)) + 1;
+}
+
+/// Smallest magnitude in a regular or overflow bucket
+static double bucketFloor(size_t bucket) {
+    if (bucket == 0) return 0.0;
+
+    uint64_t bits = (MIN_KEY + (bucket - 1)) << (52 - MANTISSA_BITS);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// MARK: - Lifecycle
+
+CorrelationAnalyzer::CorrelationAnalyzer(size_t maxPeaks, size_t exclusionRadius)
+    : maxPeaks_(std::max<size_t>(1, maxPeaks))
+    , exclusionRadius_(exclusionRadius)
+    , admission_(-std::numeric_limits<double>::infinity())
+    , histogram_(HISTOGRAM_SIZE, 0) {
+    peaks_.reserve(maxPeaks_ + 1);
+}
+
+void CorrelationAnalyzer::reset() {
+    count_ = 0;
+    sumSquares_ = 0.0;
+    sumAbs_ = 0.0;
+    maxAbs_ = 0.0;
+    previous_ = 0.0;
+    rising_ = true;
+    admission_ = -std::numeric_limits<double>::infinity();
+    peaks_.clear();
+    std::fill(histogram_.begin(), histogram_.end(), 0u);
+}
+
+// MARK: - Accumulation
+
+void CorrelationAnalyzer::push(const double* values, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        double value = values[i];
+        double magnitude = std::abs(value);
+
+        sumSquares_ += value * value;
+        sumAbs_ += magnitude;
+        maxAbs_ = std::max(maxAbs_, magnitude);
+        histogram_[bucketOf(magnitude)]++;
+
+        if (count_ > 0) {
+            // The previous lag is a maximum if it rose from its left and does not rise to this
+            // one. Maxima not above the admission level are rejected by one well-predicted branch.
+            bool candidate = rising_ & (previous_ >= value) & (previous_ > admission_);
+            if (candidate) {
+                offerPeak(count_ - 1, previous_);
+            }
+            rising_ = value > previous_;
+        }
+        previous_ = value;
+        count_++;
+    }
+}
+
+void CorrelationAnalyzer::finish() {
+    if (count_ > 0 && rising_) {
+        offerPeak(count_ - 1, previous_);
+    }
+    rising_ = false;
+}
+
+void CorrelationAnalyzer::analyze(const std::vector<double>& correlation) {
+    reset();
+    push(correlation.data(), correlation.size());
+    finish();
+}
+
+void CorrelationAnalyzer::offerPeak(size_t index, double value) {
+    // Maxima arrive in index order, so kept peaks are never to the right of this one
+    for (const auto& peak : peaks_) {
+        if (index - peak.index <= exclusionRadius_ && peak.value >= value) {
+            return;
+        }
+    }
+
+    peaks_.erase(std::remove_if(peaks_.begin(), peaks_.end(), [&](const Peak& peak) {
+        return index - peak.index <= exclusionRadius_;
+    }), peaks_.end());
+
+    auto position = std::upper_bound(peaks_.begin(), peaks_.end(), value,
+                                     [](double v, const Peak& peak) { return v > peak.value; });
+    peaks_.insert(position, {index, value});
+    if (peaks_.size() > maxPeaks_) {
+        peaks_.pop_back();
+    }
+    
+    // Once the list is full, weaker maxima can neither enter nor displace a kept peak
+    admission_ = peaks_.size() == maxPeaks_ ? peaks_.back().value : -std::numeric_limits<double>::infinity();
+}
+
+// MARK: - Results
+
+double CorrelationAnalyzer::rms() const {
+    return count_ > 0 ? std::sqrt(sumSquares_ / count_) : 0.0;
+}
+
+double CorrelationAnalyzer::meanAbs() const {
+    return count_ > 0 ? sumAbs_ / count_ : 0.0;
+}
+
+double CorrelationAnalyzer::absQuantile(double fraction) const {
+    return quantile(fraction, count_);
+}
+
+double CorrelationAnalyzer::noiseQuantile(double fraction) const {
+    if (peaks_.empty()) return absQuantile(fraction);
+
+    size_t center = peaks_.front().index;
+    size_t first = center - std::min(center, exclusionRadius_);
+    size_t last = std::min(count_ - 1, center + exclusionRadius_);
+    return quantile(fraction, count_ - (last - first + 1));
+}
+
+double CorrelationAnalyzer::quantile(double fraction, size_t count) const {
+    if (count == 0) return 0.0;
+
+    size_t rank = std::min(count - 1, static_cast<size_t>(static_cast<double>(count) * std::max(0.0, fraction)));
+
+    size_t before = 0;
+    for (size_t bucket = 0; bucket < histogram_.size(); ++bucket) {
+        size_t inBucket = histogram_[bucket];
+        if (rank < before + inBucket) {
+            // Spread the bucket's values evenly between its edges
+            double low = bucketFloor(bucket);
+            double high = bucket + 1 < histogram_.size() ? bucketFloor(bucket + 1) : maxAbs_;
+            double position = (static_cast<double>(rank - before) + 0.5) / static_cast<double>(inBucket);
+            return std::min(maxAbs_, low + (std::max(low, high) - low) * position);
+        }
+        before += inBucket;
+    }
+    return maxAbs_;
+}
+
+} // namespace HarmoniqSync
@@ -0,0 +1,852 @@
+//
+//  correlation_engine.cpp
+//  HarmoniqSyncCore
+//
+//  Direct and FFT-based cross-correlation kernels
+//  Uses the double or single precision backend FFT for the frequency-domain path
+//
+
+#include "../include/correlation_engine.hpp"
+#include "../include/operation_control.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Below this length the direct loop always wins (setup and padding dominate)
+static const size_t MIN_FFT_CORRELATION_LENGTH = 64;
+
+// Relative cost of one FFT butterfly compared to one multiply-accumulate
+static const double FFT_BUTTERFLY_COST = 2.0;
+
+// Largest supported transform (2^27 points covers multi-hour feature streams)
+static const size_t MAX_FFT_LOG2_SIZE = 27;
+
+// Bins weaker than this are left at zero by the phase transform
+static const double PHAT_EPSILON = 1e-12;
+
+// Direct loops check for cancellation once per block of this many lags
+static const size_t LAGS_PER_CHECK = 64;
+
+// Single precision sums run over blocks of this many products before they are
+// folded into a double total, which bounds their rounding error by the block length
+static const size_t SINGLE_BLOCK_LENGTH = 256;
+
+// Independent float accumulators per block (one vector register of products)
+static const size_t SINGLE_LANES = 8;
+
+// Shortest partition chosen for a memory budget (shorter ones cost more transforms than they save)
+static const size_t MIN_PARTITION_LOG2_LENGTH = 8;
+
+// Partitioned reference spectra are cached under this key plus log2 of the partition length,
+// above every whole-signal transform size
+static const size_t PARTITION_CACHE_KEY = 64;
+
+// MARK: - Helpers
+
+static size_t nextPowerOfTwo(size_t value, size_t& log2Size) {
+    size_t size = 2;
+    log2Size = 1;
+    while (size < value) {
+        size <<= 1;
+        ++log2Size;
+    }
+    return size;
+}
+
+/// sum(a[i * strideA] * b[i * strideB]) of float products in float blocks with a double carry
+static double dotSingle(const float* a, const float* b, size_t count,
+                        size_t strideA = 1, size_t strideB = 1) {
+    double total = 0.0;
+    for (size_t start = 0; start < count; start += SINGLE_BLOCK_LENGTH) {
+        size_t end = std::min(count, start + SINGLE_BLOCK_LENGTH);
+        size_t i = start;
+
+        float lanes[SINGLE_LANES] = {};
+        if (strideA == 1 && strideB == 1) {
+            for (; i + SINGLE_LANES <= end; i += SINGLE_LANES) {
+                for (size_t lane = 0; lane < SINGLE_LANES; ++lane) {
+                    lanes[lane] += a[i + lane] * b[i + lane];
+                }
+            }
+        }
+        float tail = 0.0f;
+        for (; i < end; ++i) {
+            tail += a[i * strideA] * b[i * strideB];
+        }
+
+        double block = tail;
+        for (size_t lane = 0; lane < SINGLE_LANES; ++lane) {
+            block += lanes[lane];
+        }
+        total += block;
+    }
+    return total;
+}
+
+/// Working memory of the partitioned kernel: a delay line slot and a sum for every
+/// block of lags, the padded, reference and product buffers of 2 * partitionLength
+/// values, and one block of lags. Reference spectra kept in a cache are not counted.
+static double partitionedBytes(size_t lagCount, size_t partitionLength, double valueBytes) {
+    double blocks = static_cast<double>((lagCount + partitionLength - 1) / partitionLength);
+    double length = static_cast<double>(partitionLength);
+    return (4.0 * blocks + 6.0) * length * valueBytes + length * sizeof(double);
+}
+
+/// Cached reference spectrum at the precision of a workspace
+static CorrelationEngine::SpectrumCache::Spectrum findSpectrum(const CorrelationEngine::SpectrumCache& cache,
+                                                               size_t log2Size, double) {
+    return cache.find(log2Size);
+}
+
+static CorrelationEngine::SpectrumCache::SingleSpectrum findSpectrum(const CorrelationEngine::SpectrumCache& cache,
+                                                                     size_t log2Size, float) {
+    return cache.findSingle(log2Size);
+}
+
+// MARK: - Lifecycle
+
+CorrelationEngine::CorrelationEngine() = default;
+
+CorrelationEngine::~CorrelationEngine() = default;
+
+// MARK: - Move Semantics
+
+CorrelationEngine::CorrelationEngine(CorrelationEngine&& other) noexcept
+    : doubleWorkspace(std::move(other.doubleWorkspace))
+    , singleWorkspace(std::move(other.singleWorkspace))
+    , precision(other.precision)
+{
+}
+
+CorrelationEngine& CorrelationEngine::operator=(CorrelationEngine&& other) noexcept {
+    if (this != &other) {
+        doubleWorkspace = std::move(other.doubleWorkspace);
+        singleWorkspace = std::move(other.singleWorkspace);
+        precision = other.precision;
+    }
+    return *this;
+}
+
+// MARK: - Spectrum Cache
+
+CorrelationEngine::SpectrumCache::Spectrum CorrelationEngine::SpectrumCache::find(size_t log2Size) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = spectra_.find(log2Size);
+    return it != spectra_.end() ? it->second : nullptr;
+}
+
+CorrelationEngine::SpectrumCache::SingleSpectrum CorrelationEngine::SpectrumCache::findSingle(size_t log2Size) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = singleSpectra_.find(log2Size);
+    return it != singleSpectra_.end() ? it->second : nullptr;
+}
+
+void CorrelationEngine::SpectrumCache::store(size_t log2Size, Spectrum spectrum) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    spectra_[log2Size] = std::move(spectrum);
+}
+
+void CorrelationEngine::SpectrumCache::store(size_t log2Size, SingleSpectrum spectrum) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    singleSpectra_[log2Size] = std::move(spectrum);
+}
+
+size_t CorrelationEngine::SpectrumCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return spectra_.size() + singleSpectra_.size();
+}
+
+// MARK: - Correlation
+
+std::vector<double> CorrelationEngine::crossCorrelate(const std::vector<float>& a,
+                                                      const std::vector<float>& b,
+                                                      Mode mode) const {
+    return crossCorrelate(a, b, UNBOUNDED_LAG, mode);
+}
+
+std::vector<double> CorrelationEngine::crossCorrelate(const std::vector<float>& a,
+                                                      const std::vector<float>& b,
+                                                      size_t maxLag,
+                                                      Mode mode,
+                                                      SpectrumCache* cacheA) const {
+    if (a.empty() || b.empty()) return {};
+
+    size_t window = lagWindow(a.size(), b.size(), maxLag);
+    std::vector<double> correlation(2 * window + 1, 0.0);
+
+    bool useFFT = (mode == Mode::FFT) || (mode == Mode::Auto && shouldUseFFT(a.size(), b.size(), maxLag));
+
+    if (useFFT && precision == Precision::Single) {
+        correlateFFT(singleWorkspace, a.data(), a.size(), b.data(), b.size(), window, cacheA, correlation);
+    } else if (useFFT) {
+        correlateFFT(doubleWorkspace, a.data(), a.size(), b.data(), b.size(), window, cacheA, correlation);
+    } else {
+        correlateDirect(a.data(), a.size(), b.data(), b.size(), -static_cast<int64_t>(window), correlation);
+    }
+
+    return correlation;
+}
+
+std::vector<double> CorrelationEngine::crossCorrelateMultichannel(const std::vector<float>& a,
+                                                                  const std::vector<float>& b,
+                                                                  size_t dims,
+                                                                  size_t maxLag,
+                                                                  Layout layout,
+                                                                  const std::vector<double>& weights,
+                                                                  Mode mode,
+                                                                  SpectrumCache* cacheA) const {
+    if (dims == 0) {
+        throw std::invalid_argument("Multichannel correlation needs at least one dimension");
+    }
+
+    size_t framesA = a.size() / dims;
+    size_t framesB = b.size() / dims;
+    bool frameMajor = layout == Layout::FrameMajor;
+
+    ChannelView viewA = { a.data(), framesA, frameMajor ? dims : 1, frameMajor ? 1 : framesA };
+    ChannelView viewB = { b.data(), framesB, frameMajor ? dims : 1, frameMajor ? 1 : framesB };
+    return correlateMultichannel(viewA, viewB, dims, maxLag, weights, mode, cacheA);
+}
+
+std::vector<double> CorrelationEngine::crossCorrelateMultichannel(const FeatureMatrix& a,
+                                                                  const FeatureMatrix& b,
+                                                                  size_t maxLag,
+                                                                  const std::vector<double>& weights,
+                                                                  Mode mode,
+                                                                  SpectrumCache* cacheA) const {
+    if (a.getNumDims() == 0 || a.getNumDims() != b.getNumDims()) {
+        throw std::invalid_argument("Multichannel correlation needs matrices with the same dimensions");
+    }
+
+    ChannelView viewA = { a.data(), a.getNumFrames(), a.getStride(), 1 };
+    ChannelView viewB = { b.data(), b.getNumFrames(), b.getStride(), 1 };
+    return correlateMultichannel(viewA, viewB, a.getNumDims(), maxLag, weights, mode, cacheA);
+}
+
+std::vector<double> CorrelationEngine::crossCorrelateRange(const std::vector<float>& a,
+                                                           const std::vector<float>& b,
+                                                           int64_t firstLag,
+                                                           int64_t lastLag) const {
+    if (a.empty() || b.empty() || lastLag < firstLag) return {};
+
+    std::vector<double> correlation(static_cast<size_t>(lastLag - firstLag + 1), 0.0);
+    correlateDirect(a.data(), a.size(), b.data(), b.size(), firstLag, correlation);
+    return correlation;
+}
+
+std::vector<double> CorrelationEngine::crossCorrelatePHAT(const std::vector<float>& a,
+                                                          const std::vector<float>& b,
+                                                          size_t maxLag) const {
+    if (a.empty() || b.empty()) return {};
+
+    size_t window = lagWindow(a.size(), b.size(), maxLag);
+    std::vector<double> correlation(2 * window + 1, 0.0);
+    correlatePHAT(a.data(), a.size(), b.data(), b.size(), window, correlation);
+    return correlation;
+}
+
+void CorrelationEngine::crossCorrelatePartitioned(const std::vector<float>& a,
+                                                  const std::vector<float>& b,
+                                                  size_t maxLag,
+                                                  size_t partitionLength,
+                                                  const LagSink& sink,
+                                                  SpectrumCache* cacheA) const {
+    if (partitionLength < 2 || (partitionLength & (partitionLength - 1)) != 0) {
+        throw std::invalid_argument("Partition length must be a power of two of at least 2");
+    }
+    if (a.empty() || b.empty()) return;
+
+    size_t window = lagWindow(a.size(), b.size(), maxLag);
+    if (precision == Precision::Single) {
+        correlatePartitioned(singleWorkspace, a.data(), a.size(), b.data(), b.size(), window, partitionLength,
+                             cacheA, sink);
+    } else {
+        correlatePartitioned(doubleWorkspace, a.data(), a.size(), b.data(), b.size(), window, partitionLength,
+                             cacheA, sink);
+    }
+}
+
+size_t CorrelationEngine::partitionLengthForBudget(size_t lengthA, size_t lengthB, size_t maxLag,
+                                                   size_t budgetBytes, Precision precision) {
+    size_t window = lagWindow(lengthA, lengthB, maxLag);
+    if (budgetBytes == 0 || window == 0) return 0;
+
+    const double valueBytes = precision == Precision::Single ? sizeof(float) : sizeof(double);
+    const size_t lagCount = 2 * window + 1;
+    const double budget = static_cast<double>(budgetBytes);
+
+    double whole = static_cast<double>(workingBytes(lengthA, lengthB, maxLag, 0, precision));
+    if (whole <= budget) return 0;
+
+    // Partitions longer than both the reference and the lag range only add padding
+    size_t log2Limit = 0;
+    nextPowerOfTwo(std::max(lengthA, lagCount), log2Limit);
+    log2Limit = std::min(log2Limit, MAX_FFT_LOG2_SIZE - 1);
+
+    size_t log2Length = std::min(MIN_PARTITION_LOG2_LENGTH, log2Limit);
+    while (log2Length < log2Limit
+           && partitionedBytes(lagCount, size_t(1) << (log2Length + 1), valueBytes) <= budget) {
+        ++log2Length;
+    }
+
+    size_t partitionLength = size_t(1) << log2Length;
+    return partitionedBytes(lagCount, partitionLength, valueBytes) < whole ? partitionLength : 0;
+}
+
+size_t CorrelationEngine::workingBytes(size_t lengthA, size_t lengthB, size_t maxLag, size_t partitionLength,
+                                       Precision precision) {
+    size_t window = lagWindow(lengthA, lengthB, maxLag);
+    if (window == 0) return 0;
+
+    const double valueBytes = precision == Precision::Single ? sizeof(float) : sizeof(double);
+    if (partitionLength > 0) {
+        return static_cast<size_t>(partitionedBytes(2 * window + 1, partitionLength, valueBytes));
+    }
+
+    // Whole-signal kernel: the lag output, plus a padded buffer and two spectra for the FFT path
+    double bytes = static_cast<double>(2 * window + 1) * sizeof(double);
+    if (shouldUseFFT(lengthA, lengthB, maxLag)) {
+        size_t log2Size = 0;
+        bytes += 3.0 * valueBytes * static_cast<double>(nextPowerOfTwo(std::max(lengthA, lengthB) + window, log2Size));
+    }
+    return static_cast<size_t>(bytes);
+}
+
+size_t CorrelationEngine::lagWindow(size_t lengthA, size_t lengthB, size_t maxLag) {
+    if (lengthA == 0 || lengthB == 0) return 0;
+    return std::min(maxLag, std::min(lengthA, lengthB) - 1);
+}
+
+bool CorrelationEngine::shouldUseFFT(size_t lengthA, size_t lengthB, size_t maxLag) {
+    size_t window = lagWindow(lengthA, lengthB, maxLag);
+    if (std::min(lengthA, lengthB) < MIN_FFT_CORRELATION_LENGTH || window == 0) {
+        return false;
+    }
+
+    size_t log2Size = 0;
+    size_t fftSize = nextPowerOfTwo(std::max(lengthA, lengthB) + window, log2Size);
+    if (log2Size > MAX_FFT_LOG2_SIZE) {
+        return false;
+    }
+
+    // Direct cost is one multiply-accumulate per overlapping pair inside the
+    // lag window, the FFT path needs two forward transforms and one inverse
+    double directCost = static_cast<double>(2 * window + 1) * static_cast<double>(std::min(lengthA, lengthB));
+    double fftCost = 3.0 * static_cast<double>(fftSize) * static_cast<double>(log2Size) * FFT_BUTTERFLY_COST;
+
+    return fftCost < directCost;
+}
+
+// MARK: - Kernels
+
+void CorrelationEngine::correlateDirect(const float* a, size_t lengthA,
+                                        const float* b, size_t lengthB,
+                                        int64_t firstLag,
+                                        std::vector<double>& correlation) const {
+    const int64_t n = static_cast<int64_t>(lengthA);
+    const int64_t m = static_cast<int64_t>(lengthB);
+
+    for (size_t index = 0; index < correlation.size(); ++index) {
+        if (index % LAGS_PER_CHECK == 0) CancellationScope::check();
+        int64_t lag = firstLag + static_cast<int64_t>(index);
+
+        // Overlapping range: 0 <= i < n and 0 <= i + lag < m
+        int64_t begin = std::max<int64_t>(0, -lag);
+        int64_t end = std::min(n, m - lag);
+
+        int64_t count = end - begin;
+        double sum = 0.0;
+        if (precision == Precision::Single) {
+            sum = count > 0 ? dotSingle(a + begin, b + begin + lag, static_cast<size_t>(count)) : 0.0;
+        } else {
+            for (int64_t i = begin; i < end; ++i) {
+                sum += a[i] * b[i + lag];
+            }
+        }
+
+        correlation[index] = count > 0 ? sum / count : 0.0;
+    }
+}
+
+template <typename T>
+void CorrelationEngine::correlateFFT(Workspace<T>& work,
+                                     const float* a, size_t lengthA,
+                                     const float* b, size_t lengthB,
+                                     size_t window,
+                                     SpectrumCache* cacheA,
+                                     std::vector<double>& correlation) const {
+    // Lags outside [-window, window] may alias into the circular result as long
+    // as none of them lands inside the window: P >= max(N, M) + window suffices
+    size_t log2Size = 0;
+    size_t fftSize = nextPowerOfTwo(std::max(lengthA, lengthB) + window, log2Size);
+    if (log2Size > MAX_FFT_LOG2_SIZE) {
+        throw std::invalid_argument("Correlation length exceeds maximum FFT size");
+    }
+
+    ensureFFTSetup(work, log2Size);
+    CancellationScope::check();
+
+    size_t halfSize = fftSize / 2;
+
+    // Reuse the reference transform when a cache is attached
+    std::shared_ptr<const std::vector<T>> cachedA = cacheA ? findSpectrum(*cacheA, log2Size, T()) : nullptr;
+    if (!cachedA) {
+        forwardTransform(work, a, lengthA, fftSize, log2Size, work.spectrumA);
+        if (cacheA) {
+            cachedA = std::make_shared<const std::vector<T>>(work.spectrumA);
+            cacheA->store(log2Size, cachedA);
+        }
+    }
+    CancellationScope::check();
+    forwardTransform(work, b, lengthB, fftSize, log2Size, work.spectrumB);
+
+    // A is only read by the multiply below, so the shared spectrum can be used in place
+    T* dataA = cachedA ? const_cast<T*>(cachedA->data()) : work.spectrumA.data();
+    DSP::SplitComplex<T> splitA = { dataA, dataA + halfSize };
+    DSP::SplitComplex<T> splitB = { work.spectrumB.data(), work.spectrumB.data() + halfSize };
+
+    // Element 0 packs the purely real DC and Nyquist bins, multiply them separately
+    T dcProduct = splitA.realp[0] * splitB.realp[0];
+    T nyquistProduct = splitA.imagp[0] * splitB.imagp[0];
+
+    // conj(A) * B gives the correlation sum(a[i] * b[i + lag]) after the inverse
+    DSP::multiplyConjugate(splitA, splitB, splitB, halfSize);
+    splitB.realp[0] = dcProduct;
+    splitB.imagp[0] = nyquistProduct;
+
+    work.fft->inverse(splitB, log2Size);
+
+    // Unpack to real samples; the packed format scales forward by 2 and inverse by N
+    work.paddedBuffer.resize(fftSize);
+    DSP::unpack(splitB, work.paddedBuffer.data(), halfSize);
+
+    double scale = 1.0 / (4.0 * static_cast<double>(fftSize));
+
+    const int64_t n = static_cast<int64_t>(lengthA);
+    const int64_t m = static_cast<int64_t>(lengthB);
+    const int64_t firstLag = -static_cast<int64_t>(window);
+
+    // Negative lags wrap around to the end of the circular result
+    for (size_t index = 0; index < correlation.size(); ++index) {
+        int64_t lag = firstLag + static_cast<int64_t>(index);
+        size_t circularIndex = lag >= 0 ? static_cast<size_t>(lag) : fftSize - static_cast<size_t>(-lag);
+
+        int64_t count = std::min(n, m - lag) - std::max<int64_t>(0, -lag);
+        correlation[index] = count > 0 ? work.paddedBuffer[circularIndex] * scale / count : 0.0;
+    }
+}
+
+std::vector<double> CorrelationEngine::correlateMultichannel(const ChannelView& a, const ChannelView& b, size_t dims,
+                                                             size_t maxLag, const std::vector<double>& weights,
+                                                             Mode mode, SpectrumCache* cacheA) const {
+    if (!weights.empty() && weights.size() != dims) {
+        throw std::invalid_argument("Multichannel correlation needs one weight per dimension");
+    }
+    if (a.frames == 0 || b.frames == 0) return {};
+
+    // Normalized weights make the result a weighted mean of the per-dimension correlations
+    std::vector<double> normalized = weights.empty() ? std::vector<double>(dims, 1.0) : weights;
+    double totalWeight = 0.0;
+    for (double weight : normalized) {
+        totalWeight += weight;
+    }
+    if (!(totalWeight > 0.0)) return {};
+    for (double& weight : normalized) {
+        weight /= totalWeight;
+    }
+
+    size_t window = lagWindow(a.frames, b.frames, maxLag);
+    std::vector<double> correlation(2 * window + 1, 0.0);
+
+    bool useFFT = (mode == Mode::FFT) || (mode == Mode::Auto && shouldUseFFT(a.frames, b.frames, maxLag));
+
+    if (useFFT && precision == Precision::Single) {
+        correlateFFTMultichannel(singleWorkspace, a, b, dims, normalized, window, cacheA, correlation);
+    } else if (useFFT) {
+        correlateFFTMultichannel(doubleWorkspace, a, b, dims, normalized, window, cacheA, correlation);
+    } else {
+        correlateDirectMultichannel(a, b, dims, normalized, window, correlation);
+    }
+
+    return correlation;
+}
+
+void CorrelationEngine::correlateDirectMultichannel(const ChannelView& a, const ChannelView& b, size_t dims,
+                                                    const std::vector<double>& weights,
+                                                    size_t window,
+                                                    std::vector<double>& correlation) const {
+    const int64_t n = static_cast<int64_t>(a.frames);
+    const int64_t m = static_cast<int64_t>(b.frames);
+    const int64_t firstLag = -static_cast<int64_t>(window);
+
+    // Interleaved rows are walked frame by frame, planar columns dimension by dimension
+    const bool interleaved = a.dimStride == 1 && b.dimStride == 1;
+    const bool single = precision == Precision::Single;
+
+    // Single precision keeps one float sum per dimension for each block of frames
+    std::vector<float> blockSums(single && interleaved ? dims : 0);
+
+    for (size_t index = 0; index < correlation.size(); ++index) {
+        if (index % LAGS_PER_CHECK == 0) CancellationScope::check();
+        int64_t lag = firstLag + static_cast<int64_t>(index);
+
+        // Overlapping frames: 0 <= i < n and 0 <= i + lag < m
+        int64_t begin = std::max<int64_t>(0, -lag);
+        int64_t end = std::min(n, m - lag);
+        int64_t count = end - begin;
+        if (count <= 0) continue;
+
+        double sum = 0.0;
+        if (interleaved && single) {
+            const float* rowA = a.values + begin * a.frameStride;
+            const float* rowB = b.values + (begin + lag) * b.frameStride;
+            for (int64_t start = 0; start < count; start += static_cast<int64_t>(SINGLE_BLOCK_LENGTH)) {
+                int64_t blockEnd = std::min(count, start + static_cast<int64_t>(SINGLE_BLOCK_LENGTH));
+                std::fill(blockSums.begin(), blockSums.end(), 0.0f);
+                for (int64_t i = start; i < blockEnd; ++i, rowA += a.frameStride, rowB += b.frameStride) {
+                    for (size_t dim = 0; dim < dims; ++dim) {
+                        blockSums[dim] += rowA[dim] * rowB[dim];
+                    }
+                }
+                for (size_t dim = 0; dim < dims; ++dim) {
+                    sum += weights[dim] * blockSums[dim];
+                }
+            }
+        } else if (interleaved) {
+            const float* rowA = a.values + begin * a.frameStride;
+            const float* rowB = b.values + (begin + lag) * b.frameStride;
+            for (int64_t i = 0; i < count; ++i, rowA += a.frameStride, rowB += b.frameStride) {
+                for (size_t dim = 0; dim < dims; ++dim) {
+                    sum += weights[dim] * rowA[dim] * rowB[dim];
+                }
+            }
+        } else {
+            for (size_t dim = 0; dim < dims; ++dim) {
+                if (weights[dim] == 0.0) continue;
+
+                const float* columnA = a.values + dim * a.dimStride;
+                const float* columnB = b.values + dim * b.dimStride;
+                double dimSum = 0.0;
+                if (single) {
+                    dimSum = dotSingle(columnA + begin * a.frameStride, columnB + (begin + lag) * b.frameStride,
+                                       static_cast<size_t>(count), a.frameStride, b.frameStride);
+                } else {
+                    for (int64_t i = begin; i < end; ++i) {
+                        dimSum += columnA[i * a.frameStride] * columnB[(i + lag) * b.frameStride];
+                    }
+                }
+                sum += weights[dim] * dimSum;
+            }
+        }
+
+        correlation[index] = sum / count;
+    }
+}
+
+template <typename T>
+void CorrelationEngine::correlateFFTMultichannel(Workspace<T>& work,
+                                                 const ChannelView& a, const ChannelView& b, size_t dims,
+                                                 const std::vector<double>& weights,
+                                                 size_t window,
+                                                 SpectrumCache* cacheA,
+                                                 std::vector<double>& correlation) const {
+    size_t log2Size = 0;
+    size_t fftSize = nextPowerOfTwo(std::max(a.frames, b.frames) + window, log2Size);
+    if (log2Size > MAX_FFT_LOG2_SIZE) {
+        throw std::invalid_argument("Correlation length exceeds maximum FFT size");
+    }
+
+    ensureFFTSetup(work, log2Size);
+
+    size_t halfSize = fftSize / 2;
+
+    // The reference cache holds every dimension's spectrum back to back, independent of the weights
+    std::shared_ptr<const std::vector<T>> spectraA = cacheA ? findSpectrum(*cacheA, log2Size, T()) : nullptr;
+    if (!spectraA) {
+        auto computed = std::make_shared<std::vector<T>>(dims * fftSize);
+        for (size_t dim = 0; dim < dims; ++dim) {
+            CancellationScope::check();
+            forwardTransform(work, a.values + dim * a.dimStride, a.frames, fftSize, log2Size, work.spectrumA, a.frameStride);
+            std::copy(work.spectrumA.begin(), work.spectrumA.end(), computed->begin() + dim * fftSize);
+        }
+        spectraA = computed;
+        if (cacheA) {
+            cacheA->store(log2Size, spectraA);
+        }
+    }
+
+    work.spectrumSum.assign(fftSize, T(0));
+    DSP::SplitComplex<T> splitSum = { work.spectrumSum.data(), work.spectrumSum.data() + halfSize };
+    double dcSum = 0.0;
+    double nyquistSum = 0.0;
+
+    for (size_t dim = 0; dim < dims; ++dim) {
+        double weight = weights[dim];
+        if (weight == 0.0) continue;
+
+        CancellationScope::check();
+        forwardTransform(work, b.values + dim * b.dimStride, b.frames, fftSize, log2Size, work.spectrumB, b.frameStride);
+
+        // A is only read by the multiply below, so the shared spectrum can be used in place
+        T* dataA = const_cast<T*>(spectraA->data()) + dim * fftSize;
+        DSP::SplitComplex<T> splitA = { dataA, dataA + halfSize };
+        DSP::SplitComplex<T> splitB = { work.spectrumB.data(), work.spectrumB.data() + halfSize };
+
+        // Element 0 packs the purely real DC and Nyquist bins, accumulate them separately
+        dcSum += weight * splitA.realp[0] * splitB.realp[0];
+        nyquistSum += weight * splitA.imagp[0] * splitB.imagp[0];
+
+        // Accumulate weight * conj(A) * B; realp and imagp are contiguous, so one scale covers both
+        DSP::multiplyConjugate(splitA, splitB, splitB, halfSize);
+        DSP::scale(work.spectrumB.data(), static_cast<T>(weight), work.spectrumB.data(), fftSize);
+        DSP::add(splitSum, splitB, splitSum, halfSize);
+    }
+    splitSum.realp[0] = static_cast<T>(dcSum);
+    splitSum.imagp[0] = static_cast<T>(nyquistSum);
+
+    // One inverse transform for all dimensions
+    work.fft->inverse(splitSum, log2Size);
+
+    work.paddedBuffer.resize(fftSize);
+    DSP::unpack(splitSum, work.paddedBuffer.data(), halfSize);
+
+    double scale = 1.0 / (4.0 * static_cast<double>(fftSize));
+
+    const int64_t n = static_cast<int64_t>(a.frames);
+    const int64_t m = static_cast<int64_t>(b.frames);
+    const int64_t firstLag = -static_cast<int64_t>(window);
+
+    for (size_t index = 0; index < correlation.size(); ++index) {
+        int64_t lag = firstLag + static_cast<int64_t>(index);
+        size_t circularIndex = lag >= 0 ? static_cast<size_t>(lag) : fftSize - static_cast<size_t>(-lag);
+
+        int64_t count = std::min(n, m - lag) - std::max<int64_t>(0, -lag);
+        correlation[index] = count > 0 ? work.paddedBuffer[circularIndex] * scale / count : 0.0;
+    }
+}
+
+void CorrelationEngine::correlatePHAT(const float* a, size_t lengthA,
+                                      const float* b, size_t lengthB,
+                                      size_t window,
+                                      std::vector<double>& correlation) const {
+    size_t log2Size = 0;
+    size_t fftSize = nextPowerOfTwo(std::max(lengthA, lengthB) + window, log2Size);
+    if (log2Size > MAX_FFT_LOG2_SIZE) {
+        throw std::invalid_argument("Correlation length exceeds maximum FFT size");
+    }
+
+    // Whitening divides by bin magnitudes spanning many decades, so this kernel always runs in double
+    Workspace<double>& work = doubleWorkspace;
+    ensureFFTSetup(work, log2Size);
+
+    size_t halfSize = fftSize / 2;
+    forwardTransform(work, a, lengthA, fftSize, log2Size, work.spectrumA);
+    forwardTransform(work, b, lengthB, fftSize, log2Size, work.spectrumB);
+
+    DSP::SplitComplex<double> splitA = { work.spectrumA.data(), work.spectrumA.data() + halfSize };
+    DSP::SplitComplex<double> splitB = { work.spectrumB.data(), work.spectrumB.data() + halfSize };
+
+    // DC and Nyquist are real, so whitening reduces them to their sign
+    double dcProduct = splitA.realp[0] * splitB.realp[0];
+    double nyquistProduct = splitA.imagp[0] * splitB.imagp[0];
+
+    DSP::multiplyConjugate(splitA, splitB, splitB, halfSize);
+
+    for (size_t k = 1; k < halfSize; ++k) {
+        double magnitude = std::hypot(splitB.realp[k], splitB.imagp[k]);
+        double weight = magnitude > PHAT_EPSILON ? 1.0 / magnitude : 0.0;
+        splitB.realp[k] *= weight;
+        splitB.imagp[k] *= weight;
+    }
+    splitB.realp[0] = std::abs(dcProduct) > PHAT_EPSILON ? std::copysign(1.0, dcProduct) : 0.0;
+    splitB.imagp[0] = std::abs(nyquistProduct) > PHAT_EPSILON ? std::copysign(1.0, nyquistProduct) : 0.0;
+
+    work.fft->inverse(splitB, log2Size);
+
+    work.paddedBuffer.resize(fftSize);
+    DSP::unpack(splitB, work.paddedBuffer.data(), halfSize);
+
+    // With unit-magnitude bins the inverse peaks at fftSize for identical inputs
+    double scale = 1.0 / static_cast<double>(fftSize);
+    const int64_t firstLag = -static_cast<int64_t>(window);
+
+    for (size_t index = 0; index < correlation.size(); ++index) {
+        int64_t lag = firstLag + static_cast<int64_t>(index);
+        size_t circularIndex = lag >= 0 ? static_cast<size_t>(lag) : fftSize - static_cast<size_t>(-lag);
+        correlation[index] = work.paddedBuffer[circularIndex] * scale;
+    }
+}
+
+template <typename T>
+void CorrelationEngine::correlatePartitioned(Workspace<T>& work,
+                                             const float* a, size_t lengthA,
+                                             const float* b, size_t lengthB,
+                                             size_t window, size_t partitionLength,
+                                             SpectrumCache* cacheA,
+                                             const LagSink& sink) const {
+    // A partition of P reference frames zero-padded to 2P points meets 2P target
+    // frames per block of P lags: the circular product of the two never wraps
+    // into the lags of the block, so no output needs discarding beyond the block.
+    // Reference partition p meets target segment q = p + d at lag block d, so
+    // block d sums conj(A[p]) * B[p + d] over every partition.
+    size_t log2Partition = 0;
+    nextPowerOfTwo(partitionLength, log2Partition);
+    const size_t log2Size = log2Partition + 1;
+    if (log2Size > MAX_FFT_LOG2_SIZE) {
+        throw std::invalid_argument("Partition length exceeds maximum FFT size");
+    }
+
+    const size_t fftSize = 2 * partitionLength;
+    const size_t halfSize = partitionLength;
+    const size_t partitions = (lengthA + partitionLength - 1) / partitionLength;
+    const size_t lagCount = 2 * window + 1;
+    const size_t blocks = (lagCount + partitionLength - 1) / partitionLength;
+    ensureFFTSetup(work, log2Size);
+
+    // With a cache every reference partition is transformed once for all targets,
+    // without one each is transformed as the loop reaches it
+    const size_t cacheKey = PARTITION_CACHE_KEY + log2Partition;
+    std::shared_ptr<const std::vector<T>> spectraA = cacheA ? findSpectrum(*cacheA, cacheKey, T()) : nullptr;
+    if (cacheA && !spectraA) {
+        auto computed = std::make_shared<std::vector<T>>(partitions * fftSize);
+        for (size_t p = 0; p < partitions; ++p) {
+            CancellationScope::check();
+            size_t start = p * partitionLength;
+            forwardTransform(work, a + start, std::min(partitionLength, lengthA - start), fftSize, log2Size,
+                             work.spectrumA);
+            std::copy(work.spectrumA.begin(), work.spectrumA.end(), computed->begin() + p * fftSize);
+        }
+        spectraA = computed;
+        cacheA->store(cacheKey, spectraA);
+    }
+
+    const int64_t n = static_cast<int64_t>(lengthA);
+    const int64_t m = static_cast<int64_t>(lengthB);
+    const int64_t partitionFrames = static_cast<int64_t>(partitionLength);
+    const double scale = 1.0 / (4.0 * static_cast<double>(fftSize));
+
+    // Frequency-domain delay line: the spectra of target segments p .. p + blocks - 1,
+    // slot q % blocks holding segment q, so each segment is transformed exactly once
+    work.delayLine.resize(blocks * fftSize);
+    std::vector<char> segmentEmpty(blocks, 1);
+    auto loadSegment = [&](size_t q) {
+        const size_t slot = q % blocks;
+        int64_t segmentStart = static_cast<int64_t>(q) * partitionFrames - static_cast<int64_t>(window);
+        int64_t begin = std::max<int64_t>(0, segmentStart);
+        int64_t end = std::min<int64_t>(m, segmentStart + static_cast<int64_t>(fftSize));
+        segmentEmpty[slot] = begin >= end;
+        if (segmentEmpty[slot]) return;
+
+        work.paddedBuffer.assign(fftSize, T(0));
+        std::copy(b + begin, b + end, work.paddedBuffer.begin() + (begin - segmentStart));
+        T* data = work.delayLine.data() + slot * fftSize;
+        DSP::SplitComplex<T> split = { data, data + halfSize };
+        DSP::pack(work.paddedBuffer.data(), split, halfSize);
+        work.fft->forward(split, log2Size);
+    };
+    for (size_t q = 0; q < blocks; ++q) {
+        loadSegment(q);
+    }
+
+    // One cross spectrum accumulator per lag block
+    work.spectrumSum.assign(blocks * fftSize, T(0));
+    work.spectrumB.resize(fftSize);
+    DSP::SplitComplex<T> splitProduct = { work.spectrumB.data(), work.spectrumB.data() + halfSize };
+
+    for (size_t p = 0; p < partitions; ++p) {
+        CancellationScope::check();
+
+        // The shared spectra are only read, as in correlateFFT
+        T* dataA;
+        if (spectraA) {
+            dataA = const_cast<T*>(spectraA->data()) + p * fftSize;
+        } else {
+            size_t start = p * partitionLength;
+            forwardTransform(work, a + start, std::min(partitionLength, lengthA - start), fftSize, log2Size,
+                             work.spectrumA);
+            dataA = work.spectrumA.data();
+        }
+        DSP::SplitComplex<T> splitA = { dataA, dataA + halfSize };
+
+        for (size_t d = 0; d < blocks; ++d) {
+            size_t slot = (p + d) % blocks;
+            if (segmentEmpty[slot]) continue;
+            T* dataB = work.delayLine.data() + slot * fftSize;
+            DSP::SplitComplex<T> splitB = { dataB, dataB + halfSize };
+
+            // Element 0 packs the purely real DC and Nyquist bins, multiply them separately
+            DSP::multiplyConjugate(splitA, splitB, splitProduct, halfSize);
+            splitProduct.realp[0] = splitA.realp[0] * splitB.realp[0];
+            splitProduct.imagp[0] = splitA.imagp[0] * splitB.imagp[0];
+
+            T* dataSum = work.spectrumSum.data() + d * fftSize;
+            DSP::SplitComplex<T> splitSum = { dataSum, dataSum + halfSize };
+            DSP::add(splitSum, splitProduct, splitSum, halfSize);
+        }
+
+        // Segment p was only needed at block 0; segment p + blocks takes its slot
+        if (p + 1 < partitions) {
+            loadSegment(p + blocks);
+        }
+    }
+
+    std::vector<double> block(std::min(partitionLength, lagCount));
+    for (size_t d = 0; d < blocks; ++d) {
+        CancellationScope::check();
+        const int64_t blockLag = static_cast<int64_t>(d * partitionLength) - static_cast<int64_t>(window);
+        const size_t blockCount = std::min(partitionLength, lagCount - d * partitionLength);
+
+        T* dataSum = work.spectrumSum.data() + d * fftSize;
+        DSP::SplitComplex<T> splitSum = { dataSum, dataSum + halfSize };
+        work.fft->inverse(splitSum, log2Size);
+        work.paddedBuffer.resize(fftSize);
+        DSP::unpack(splitSum, work.paddedBuffer.data(), halfSize);
+
+        for (size_t k = 0; k < blockCount; ++k) {
+            int64_t lag = blockLag + static_cast<int64_t>(k);
+            int64_t count = std::min(n, m - lag) - std::max<int64_t>(0, -lag);
+            block[k] = count > 0 ? work.paddedBuffer[k] * scale / count : 0.0;
+        }
+        sink(block.data(), blockCount);
+    }
+}
+
+template <typename T>
+void CorrelationEngine::forwardTransform(Workspace<T>& work,
+                                         const float* input, size_t length, size_t fftSize,
+                                         size_t log2Size, std::vector<T>& spectrum,
+                                         size_t stride) const {
+    size_t halfSize = fftSize / 2;
+
+    work.paddedBuffer.assign(fftSize, T(0));
+    if (stride == 1) {
+        std::copy(input, input + length, work.paddedBuffer.begin());
+    } else {
+        for (size_t i = 0; i < length; ++i) {
+            work.paddedBuffer[i] = input[i * stride];
+        }
+    }
+
+    spectrum.resize(fftSize);
+    DSP::SplitComplex<T> split = { spectrum.data(), spectrum.data() + halfSize };
+
+    DSP::pack(work.paddedBuffer.data(), split, halfSize);
+    work.fft->forward(split, log2Size);
+}
+
+template <typename T>
+void CorrelationEngine::ensureFFTSetup(Workspace<T>& work, size_t log2Size) const {
+    if (work.fft && work.fft->getMaxLog2Size() >= log2Size) {
+        return;
+    }
+
+    // Release the old plan first so the shared cache can drop it when it grows
+    work.fft.reset();
+    work.fft = DSP::sharedRealFFT<T>(log2Size);
+}
+
+} // namespace HarmoniqSync
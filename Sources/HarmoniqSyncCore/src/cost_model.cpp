@@ -0,0 +1,495 @@
+//
+//  cost_model.cpp
+//  HarmoniqSyncCore
+//
+//  Calibrated time and memory predictions for alignment jobs
+//
+
+#include "cost_model.hpp"
+#include "correlation_engine.hpp"
+#include "feature_matrix.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// First line of a saved profile
+static const char* PROFILE_HEADER = "harmoniq-cost-profile 1";
+
+// Profile keys of the coefficient rows, indexed by harmoniq_sync_method_t
+static const char* METHOD_KEYS[CostModel::METHOD_COUNT] = { "flux", "chroma", "energy", "mfcc", "hybrid" };
+
+// Profile keys of the stages, matching the harmoniq_sync_stats_t field names
+static const char* STAGE_KEYS[PROCESSING_STAGE_COUNT] = {
+    "load", "resample", "stft", "feature", "post_process",
+    "correlation", "peak_picking", "confidence", "drift", "refinement"
+};
+
+// Feature dimensions correlated per stream
+static const double CHROMA_DIMS = 12.0;
+static const double MFCC_DIMS = 13.0;
+
+// Same cost ratio CorrelationEngine uses to choose between its kernels
+static const double FFT_CORRELATION_PASSES = 3.0;
+
+// Stage times below this are timer noise and do not steer the relative fit
+static const double MIN_FIT_SECONDS = 1e-5;
+
+// Spread below this is not trusted, however well the calibration runs agree
+static const double MIN_LOG_ERROR = 0.05;
+
+// Confidence range of inverse normal bounds
+static const double MIN_CONFIDENCE = 0.5;
+static const double MAX_CONFIDENCE = 0.9999;
+
+// Built-in profile, fitted with harmoniq_bench --calibrate on the reference
+// development machine (x86-64, one core, portable DSP backend). Rows are
+// indexed by harmoniq_sync_method_t, columns by ProcessingStage.
+static const char* BUILTIN_MACHINE_CLASS = "builtin";
+static const double BUILTIN_SECONDS_PER_UNIT[CostModel::METHOD_COUNT][PROCESSING_STAGE_COUNT] = {
+    { 1.7e-13, 3.49e-09, 6.78e-10, 2.91e-10, 2.47e-08, 7.37e-10, 5.21e-09, 7.24e-10, 1.11e-10, 0.000622 },
+    { 1.61e-13, 3.48e-09, 6.32e-10, 7.75e-10, 4.33e-12, 5.19e-10, 5.07e-09, 6.69e-10, 1.31e-10, 4e-06 },
+    { 7.74e-14, 3.59e-09, 6.78e-10, 1.22e-09, 1.5e-08, 6.83e-10, 4.17e-09, 4.79e-10, 1.31e-10, 0.000599 },
+    { 1.75e-13, 3.43e-09, 6.64e-10, 8.02e-10, 4.03e-12, 5.11e-10, 5.52e-09, 7.79e-10, 1.28e-10, 0.000623 },
+    { 1.55e-13, 3.44e-09, 6.6e-10, 7.32e-10, 1.43e-09, 5.81e-10, 5.41e-09, 5.75e-10, 1.37e-10, 0.000614 },
+};
+static const double BUILTIN_WALL_FACTOR[CostModel::METHOD_COUNT] = { 1.08, 1.1, 1.22, 1.08, 1.09 };
+static const double BUILTIN_LOG_ERROR[CostModel::METHOD_COUNT] = { 0.153, 0.0976, 0.144, 0.14, 0.221 };
+static const double BUILTIN_MEMORY_FACTOR[CostModel::METHOD_COUNT] = { 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+// MARK: - Helpers
+
+static size_t stageIndex(ProcessingStage stage) {
+    return static_cast<size_t>(stage);
+}
+
+static size_t methodIndex(harmoniq_sync_method_t method) {
+    size_t index = static_cast<size_t>(method);
+    return index < CostModel::METHOD_COUNT ? index : 0;
+}
+
+static double clampConfidence(double confidence) {
+    if (!(confidence >= MIN_CONFIDENCE)) return MIN_CONFIDENCE;
+    return std::min(confidence, MAX_CONFIDENCE);
+}
+
+/// Probability that a standard normal variable is below z
+static double normalCdf(double z) {
+    return 0.5 * std::erfc(-z / std::sqrt(2.0));
+}
+
+/// z with normalCdf(z) = p, by bisection (p within the confidence range)
+static double normalQuantile(double p) {
+    double low = 0.0;
+    double high = 8.0;
+    for (int i = 0; i < 64; ++i) {
+        double middle = 0.5 * (low + high);
+        if (normalCdf(middle) < p) low = middle;
+        else high = middle;
+    }
+    return 0.5 * (low + high);
+}
+
+/// Work of one correlation as CorrelationEngine would run it: the direct loop
+/// over the lag window or two forward and one inverse transform
+static double correlationWork(size_t framesA, size_t framesB, size_t maxLag) {
+    size_t window = CorrelationEngine::lagWindow(framesA, framesB, maxLag);
+    if (window == 0) return 0.0;
+
+    if (CorrelationEngine::shouldUseFFT(framesA, framesB, maxLag)) {
+        double size = 1.0;
+        double log2Size = 0.0;
+        double needed = static_cast<double>(std::max(framesA, framesB) + window);
+        while (size < needed) {
+            size *= 2.0;
+            log2Size += 1.0;
+        }
+        return FFT_CORRELATION_PASSES * size * log2Size;
+    }
+    return static_cast<double>(2 * window + 1) * static_cast<double>(std::min(framesA, framesB));
+}
+
+/// Work of the partitioned kernel: every reference partition and target segment
+/// transformed once and one inverse per block of lags, all at twice the partition,
+/// plus one cross spectrum pass per partition and block
+static double partitionedCorrelationWork(size_t framesA, size_t framesB, size_t maxLag, size_t partitionLength) {
+    size_t window = CorrelationEngine::lagWindow(framesA, framesB, maxLag);
+    double partitions = std::ceil(static_cast<double>(framesA) / static_cast<double>(partitionLength));
+    double blocks = std::ceil(static_cast<double>(2 * window + 1) / static_cast<double>(partitionLength));
+    double size = 2.0 * static_cast<double>(partitionLength);
+    return (2.0 * partitions + 2.0 * blocks) * size * std::log2(size) + partitions * blocks * size;
+}
+
+// MARK: - Job
+
+CostModel::Job CostModel::Job::fromConfig(const harmoniq_sync_config_t& config, harmoniq_sync_method_t method,
+                                          size_t referenceSamples, size_t targetSamples, double sampleRate) {
+    Job job;
+    job.method = method;
+    job.referenceSamples = referenceSamples;
+    job.targetSamples = targetSamples;
+    job.sampleRate = sampleRate;
+    job.windowSize = config.window_size;
+    job.hopSize = config.hop_size;
+    job.maxOffsetSamples = config.max_offset_samples;
+    job.analysisSampleRate = config.analysis_sample_rate;
+    job.coarseHopSize = config.coarse_hop_size;
+    job.driftCorrection = config.enable_drift_correction != 0;
+    job.correlationMemoryBytes = static_cast<size_t>(std::max(0, config.correlation_memory_mb)) << 20;
+    return job;
+}
+
+// MARK: - Lifecycle
+
+CostModel::CostModel() : machineClass_(BUILTIN_MACHINE_CLASS) {
+    for (size_t m = 0; m < METHOD_COUNT; ++m) {
+        Coefficients& row = coefficients_[m];
+        std::copy(BUILTIN_SECONDS_PER_UNIT[m], BUILTIN_SECONDS_PER_UNIT[m] + PROCESSING_STAGE_COUNT,
+                  row.secondsPerUnit.begin());
+        row.wallFactor = BUILTIN_WALL_FACTOR[m];
+        row.logError = BUILTIN_LOG_ERROR[m];
+        row.memoryFactor = BUILTIN_MEMORY_FACTOR[m];
+    }
+}
+
+// MARK: - Prediction
+
+CostModel::Work CostModel::measureWork(const Job& job) {
+    Work work;
+    const size_t window = static_cast<size_t>(std::max(job.windowSize, 2));
+    const size_t hop = static_cast<size_t>(job.hopSize > 0 ? job.hopSize : std::max(1, job.windowSize / 4));
+    const size_t energyHop = static_cast<size_t>(job.hopSize > 0 ? job.hopSize : std::max(1, job.windowSize / 2));
+    const double log2Window = std::log2(static_cast<double>(window));
+
+    // Decimation as AlignmentEngine::resolveDecimation picks it
+    size_t decimation = 1;
+    if (job.analysisSampleRate > 0.0 && job.sampleRate > job.analysisSampleRate) {
+        decimation = std::max<size_t>(1, static_cast<size_t>(job.sampleRate / job.analysisSampleRate));
+    }
+    const size_t analysedRef = job.referenceSamples / decimation;
+    const size_t analysedTgt = job.targetSamples / decimation;
+    const double inputSamples = static_cast<double>(job.referenceSamples + job.targetSamples);
+    const double analysedSamples = static_cast<double>(analysedRef + analysedTgt);
+
+    // Streams the method extracts; chroma and MFCC measure drift on the energy profile
+    const bool hybrid = job.method == HARMONIQ_SYNC_HYBRID;
+    const bool flux = hybrid || job.method == HARMONIQ_SYNC_SPECTRAL_FLUX;
+    const bool chroma = hybrid || job.method == HARMONIQ_SYNC_CHROMA;
+    const bool mfcc = hybrid || job.method == HARMONIQ_SYNC_MFCC;
+    const bool driftEnergy = job.driftCorrection && (job.method == HARMONIQ_SYNC_CHROMA || job.method == HARMONIQ_SYNC_MFCC);
+    const bool energy = hybrid || job.method == HARMONIQ_SYNC_ENERGY || driftEnergy;
+    const bool spectral = flux || chroma || mfcc;
+
+    const size_t refFrames = FeatureMatrix::frameCount(analysedRef, window, hop);
+    const size_t tgtFrames = FeatureMatrix::frameCount(analysedTgt, window, hop);
+    const size_t refEnergyFrames = FeatureMatrix::frameCount(analysedRef, window, energyHop);
+    const size_t tgtEnergyFrames = FeatureMatrix::frameCount(analysedTgt, window, energyHop);
+    const double frames = static_cast<double>(refFrames + tgtFrames);
+    const double energyFrames = static_cast<double>(refEnergyFrames + tgtEnergyFrames);
+    const double bins = static_cast<double>(window / 2);
+
+    auto& units = work.units;
+    units[stageIndex(ProcessingStage::LoadValidate)] = inputSamples;
+    units[stageIndex(ProcessingStage::Resample)] = decimation > 1 ? inputSamples : 0.0;
+    units[stageIndex(ProcessingStage::Refinement)] = 1.0;
+
+    double spectralStreams = (flux ? 1.0 : 0.0) + (chroma ? 1.0 : 0.0) + (mfcc ? 1.0 : 0.0);
+    if (spectral) {
+        units[stageIndex(ProcessingStage::STFT)] = frames * static_cast<double>(window) * log2Window;
+    }
+    units[stageIndex(ProcessingStage::FeatureExtraction)] =
+        spectralStreams * frames * bins + (energy ? analysedSamples : 0.0);
+
+    double featureValues = (flux ? frames : 0.0) + (chroma ? CHROMA_DIMS * frames : 0.0)
+                         + (mfcc ? MFCC_DIMS * frames : 0.0) + (energy ? energyFrames : 0.0);
+    units[stageIndex(ProcessingStage::FeaturePostProcessing)] = featureValues;
+
+    // Lag range as AlignmentEngine::calculateMaxLag derives it, in frames of each stream
+    int64_t maxOffset = job.maxOffsetSamples > 0
+        ? job.maxOffsetSamples
+        : static_cast<int64_t>(std::min(job.referenceSamples, job.targetSamples) / 4);
+    auto maxLagFor = [&](size_t streamHop) -> size_t {
+        int64_t sourceHop = static_cast<int64_t>(streamHop * decimation);
+        return maxOffset > 0 ? static_cast<size_t>((maxOffset + sourceHop - 1) / sourceHop) : 0;
+    };
+
+    double correlation = 0.0;
+    double lags = 0.0;
+    double correlationBytes = 0.0;
+    auto addStream = [&](size_t framesA, size_t framesB, size_t streamHop, double dims, bool scalar) {
+        size_t maxLag = maxLagFor(streamHop);
+        size_t lagWindow = CorrelationEngine::lagWindow(framesA, framesB, maxLag);
+        double lagCount = static_cast<double>(2 * lagWindow + 1);
+
+        // Scalar envelopes search a decimated copy first, then a few lags around its peak
+        size_t factor = job.coarseHopSize > 0 ? static_cast<size_t>(job.coarseHopSize) / (streamHop * decimation) : 0;
+        if (scalar && factor >= 2 && std::min(framesA, framesB) / factor >= 16) {
+            size_t coarseLag = (maxLag + factor - 1) / factor;
+            size_t coarseWindow = CorrelationEngine::lagWindow(framesA / factor, framesB / factor, coarseLag);
+            correlation += correlationWork(framesA / factor, framesB / factor, coarseLag)
+                         + static_cast<double>(4 * factor + 1) * static_cast<double>(std::min(framesA, framesB));
+            lagCount = static_cast<double>(2 * coarseWindow + 1);
+            correlationBytes = std::max(correlationBytes, static_cast<double>(
+                CorrelationEngine::workingBytes(framesA / factor, framesB / factor, coarseLag)));
+        } else if (size_t partitionLength = scalar ? CorrelationEngine::partitionLengthForBudget(
+                       framesA, framesB, maxLag, job.correlationMemoryBytes) : 0) {
+            // Lags stream through peak picking a partition at a time
+            correlation += partitionedCorrelationWork(framesA, framesB, maxLag, partitionLength);
+            correlationBytes = std::max(correlationBytes, static_cast<double>(
+                CorrelationEngine::workingBytes(framesA, framesB, maxLag, partitionLength)));
+        } else {
+            correlation += dims * correlationWork(framesA, framesB, maxLag);
+            correlationBytes = std::max(correlationBytes, static_cast<double>(
+                CorrelationEngine::workingBytes(framesA, framesB, maxLag)));
+        }
+        lags += lagCount;
+    };
+    if (flux) addStream(refFrames, tgtFrames, hop, 1.0, true);
+    if (chroma) addStream(refFrames, tgtFrames, hop, CHROMA_DIMS, false);
+    if (mfcc) addStream(refFrames, tgtFrames, hop, MFCC_DIMS, false);
+    if (hybrid || job.method == HARMONIQ_SYNC_ENERGY) addStream(refEnergyFrames, tgtEnergyFrames, energyHop, 1.0, true);
+
+    units[stageIndex(ProcessingStage::Correlation)] = correlation;
+    units[stageIndex(ProcessingStage::PeakPicking)] = lags;
+    units[stageIndex(ProcessingStage::Confidence)] = lags;
+    if (job.driftCorrection) {
+        units[stageIndex(ProcessingStage::DriftEstimation)] = (flux && !hybrid) ? frames : energyFrames;
+    }
+
+    // Spectrograms are cached per clip and feature matrices kept alongside them
+    work.featureBytes = (spectral ? frames * bins * sizeof(float) : 0.0)
+                      + (chroma ? CHROMA_DIMS * frames * sizeof(float) : 0.0)
+                      + (mfcc ? MFCC_DIMS * frames * sizeof(float) : 0.0);
+
+    // Input copies, the decimated copy, scalar streams and the largest correlation
+    // with its FFT buffers, counted as CorrelationEngine sizes them
+    work.bufferBytes = inputSamples * sizeof(float)
+                     + (decimation > 1 ? analysedSamples * sizeof(float) : 0.0)
+                     + ((flux ? frames : 0.0) + (energy ? energyFrames : 0.0)) * sizeof(float)
+                     + correlationBytes;
+    return work;
+}
+
+CostModel::Prediction CostModel::predict(const Job& job, double confidence) const {
+    Prediction prediction;
+    const Coefficients& row = getCoefficients(job.method);
+    Work work = measureWork(job);
+
+    double total = 0.0;
+    for (size_t s = 0; s < PROCESSING_STAGE_COUNT; ++s) {
+        prediction.stageSeconds[s] = row.secondsPerUnit[s] * work.units[s];
+        total += prediction.stageSeconds[s];
+    }
+
+    prediction.seconds = total * row.wallFactor;
+    prediction.upperSeconds = prediction.seconds * std::exp(normalQuantile(clampConfidence(confidence)) * row.logError);
+    prediction.peakBytes = static_cast<size_t>(row.memoryFactor * work.featureBytes + work.bufferBytes);
+    return prediction;
+}
+
+CostModel::Admission CostModel::admit(const Job& job, double deadlineSeconds, size_t memoryBudgetBytes,
+                                      double confidence) const {
+    Admission admission;
+    admission.prediction = predict(job, confidence);
+    const Coefficients& row = getCoefficients(job.method);
+
+    if (deadlineSeconds <= 0.0) {
+        admission.onTimeProbability = 1.0;
+    } else if (admission.prediction.seconds > 0.0) {
+        admission.onTimeProbability = normalCdf(std::log(deadlineSeconds / admission.prediction.seconds) / row.logError);
+    } else {
+        admission.onTimeProbability = 1.0;
+    }
+
+    admission.meetsDeadline = deadlineSeconds <= 0.0 || admission.prediction.upperSeconds <= deadlineSeconds;
+    admission.fitsMemory = memoryBudgetBytes == 0 || admission.prediction.peakBytes <= memoryBudgetBytes;
+    admission.admitted = admission.meetsDeadline && admission.fitsMemory;
+    return admission;
+}
+
+// MARK: - Calibration
+
+void CostModel::calibrate(const std::vector<Sample>& samples, const std::string& machineClass) {
+    machineClass_ = machineClass;
+
+    for (size_t m = 0; m < METHOD_COUNT; ++m) {
+        std::vector<const Sample*> runs;
+        std::vector<Work> works;
+        for (const Sample& sample : samples) {
+            if (methodIndex(sample.job.method) == m && sample.wallSeconds > 0.0) {
+                runs.push_back(&sample);
+                works.push_back(measureWork(sample.job));
+            }
+        }
+        if (runs.empty()) continue;
+
+        Coefficients& row = coefficients_[m];
+
+        // Seconds per unit through the origin, minimizing relative rather than
+        // absolute error so short clips weigh as much as long ones
+        for (size_t s = 0; s < PROCESSING_STAGE_COUNT; ++s) {
+            double numerator = 0.0;
+            double denominator = 0.0;
+            for (size_t r = 0; r < runs.size(); ++r) {
+                double units = works[r].units[s];
+                if (units <= 0.0) continue;
+                double weight = 1.0 / std::max(runs[r]->stages.stageSeconds[s], MIN_FIT_SECONDS);
+                numerator += runs[r]->stages.stageSeconds[s] * units * weight * weight;
+                denominator += units * units * weight * weight;
+            }
+            if (denominator > 0.0) {
+                row.secondsPerUnit[s] = numerator / denominator;
+            }
+        }
+
+        // Wall time against the summed stages: the geometric mean ratio corrects
+        // for untimed work and concurrent stages, the log spread gives the bound
+        std::vector<double> logRatios;
+        double memoryFactor = 0.0;
+        for (size_t r = 0; r < runs.size(); ++r) {
+            double total = 0.0;
+            for (size_t s = 0; s < PROCESSING_STAGE_COUNT; ++s) {
+                total += row.secondsPerUnit[s] * works[r].units[s];
+            }
+            if (total > 0.0) {
+                logRatios.push_back(std::log(runs[r]->wallSeconds / total));
+            }
+            if (works[r].featureBytes > 0.0) {
+                memoryFactor = std::max(memoryFactor, static_cast<double>(runs[r]->stages.peakAllocatedBytes) / works[r].featureBytes);
+            }
+        }
+
+        if (!logRatios.empty()) {
+            double mean = 0.0;
+            for (double ratio : logRatios) mean += ratio;
+            mean /= static_cast<double>(logRatios.size());
+            row.wallFactor = std::exp(mean);
+
+            if (logRatios.size() > 1) {
+                double variance = 0.0;
+                for (double ratio : logRatios) variance += (ratio - mean) * (ratio - mean);
+                variance /= static_cast<double>(logRatios.size() - 1);
+                row.logError = std::max(MIN_LOG_ERROR, std::sqrt(variance));
+            }
+        }
+        if (memoryFactor > 0.0) {
+            row.memoryFactor = memoryFactor;
+        }
+        row.samples = runs.size();
+    }
+}
+
+// MARK: - Profiles
+
+bool CostModel::save(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file.precision(std::numeric_limits<double>::max_digits10);
+    file << PROFILE_HEADER << "\n";
+    file << "machine " << machineClass_ << "\n";
+    for (size_t m = 0; m < METHOD_COUNT; ++m) {
+        const Coefficients& row = coefficients_[m];
+        const std::string method = METHOD_KEYS[m];
+        file << method << ".samples " << row.samples << "\n";
+        file << method << ".wall_factor " << row.wallFactor << "\n";
+        file << method << ".log_error " << row.logError << "\n";
+        file << method << ".memory_factor " << row.memoryFactor << "\n";
+        for (size_t s = 0; s < PROCESSING_STAGE_COUNT; ++s) {
+            file << method << "." << STAGE_KEYS[s] << " " << row.secondsPerUnit[s] << "\n";
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+bool CostModel::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    std::string line;
+    if (!std::getline(file, line) || line != PROFILE_HEADER) return false;
+
+    // Parse into a copy so a damaged profile leaves the model unchanged
+    CostModel loaded = *this;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t space = line.find(' ');
+        if (space == std::string::npos) return false;
+        std::string key = line.substr(0, space);
+        std::string value = line.substr(space + 1);
+
+        if (key == "machine") {
+            loaded.machineClass_ = value;
+            continue;
+        }
+
+        size_t dot = key.find('.');
+        if (dot == std::string::npos) return false;
+        const std::string method = key.substr(0, dot);
+        const std::string field = key.substr(dot + 1);
+
+        auto methodKey = std::find_if(std::begin(METHOD_KEYS), std::end(METHOD_KEYS),
+                                      [&](const char* name) { return method == name; });
+        if (methodKey == std::end(METHOD_KEYS)) return false;
+        Coefficients& row = loaded.coefficients_[static_cast<size_t>(methodKey - std::begin(METHOD_KEYS))];
+
+        std::istringstream parser(value);
+        double number = 0.0;
+        if (!(parser >> number) || !std::isfinite(number) || number < 0.0) return false;
+
+        if (field == "samples") {
+            row.samples = static_cast<size_t>(number);
+        } else if (field == "wall_factor") {
+            row.wallFactor = number;
+        } else if (field == "log_error") {
+            row.logError = std::max(MIN_LOG_ERROR, number);
+        } else if (field == "memory_factor") {
+            row.memoryFactor = number;
+        } else {
+            auto stageKey = std::find_if(std::begin(STAGE_KEYS), std::end(STAGE_KEYS),
+                                         [&](const char* name) { return field == name; });
+            if (stageKey == std::end(STAGE_KEYS)) return false;
+            row.secondsPerUnit[static_cast<size_t>(stageKey - std::begin(STAGE_KEYS))] = number;
+        }
+    }
+
+    *this = loaded;
+    return true;
+}
+
+// MARK: - Shared Model
+
+static std::mutex& sharedMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::shared_ptr<const CostModel>& sharedModel() {
+    static std::shared_ptr<const CostModel> model = std::make_shared<const CostModel>();
+    return model;
+}
+
+std::shared_ptr<const CostModel> CostModel::shared() {
+    std::lock_guard<std::mutex> lock(sharedMutex());
+    return sharedModel();
+}
+
+void CostModel::setShared(std::shared_ptr<const CostModel> model) {
+    std::lock_guard<std::mutex> lock(sharedMutex());
+    sharedModel() = model ? std::move(model) : std::make_shared<const CostModel>();
+}
+
+// MARK: - Getters
+
+const CostModel::Coefficients& CostModel::getCoefficients(harmoniq_sync_method_t method) const {
+    return coefficients_[methodIndex(method)];
+}
+
+} // namespace HarmoniqSync
@@ -0,0 +1,152 @@
+//
+//  decimator.cpp
+//  HarmoniqSyncCore
+//
+//  Polyphase FIR decimation with a Kaiser-windowed sinc lowpass
+//  Uses the DSP backend for the decimating filter
+//
+
+#include "../include/decimator.hpp"
+#include "../include/dsp_backend.hpp"
+#include "../include/operation_control.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Filter taps on either side of the centre, per unit of decimation factor.
+// With the cutoff at the output Nyquist this gives a transition band from 80%
+// to 120% of the new Nyquist frequency and about 75 dB stopband rejection, so
+// anything that aliases lands above 80% of the new Nyquist frequency.
+static const size_t HALF_TAPS_PER_FACTOR = 12;
+
+// Outputs filtered per backend call, between cancellation checks
+static const size_t OUTPUTS_PER_BLOCK = 16384;
+static const double KAISER_BETA = 7.5;
+
+// MARK: - Helpers
+
+/// Zeroth-order modified Bessel function of the first kind (power series)
+static double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double quarterSquare = 0.25 * x * x;
+    for (int k = 1; k < 50 && term > 1e-12 * sum; ++k) {
+        term *= quarterSquare / (static_cast<double>(k) * k);
+        sum += term;
+    }
+    return sum;
+}
+
+// MARK: - Lifecycle
+
+Decimator::Decimator(int factor)
+    : factor_(factor)
+    , halfLength_(0) {
+    if (factor < 1) {
+        throw std::invalid_argument("Decimation factor must be at least 1");
+    }
+
+    designFilter();
+}
+
+std::shared_ptr<const Decimator> Decimator::get(int factor) {
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const Decimator>> decimators;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = decimators.find(factor);
+    if (it != decimators.end()) {
+        return it->second;
+    }
+
+    auto decimator = std::make_shared<const Decimator>(factor);
+    decimators.emplace(factor, decimator);
+    return decimator;
+}
+
+// MARK: - Processing
+
+size_t Decimator::outputLength(size_t length, int factor) {
+    if (factor < 1) return 0;
+    return (length + static_cast<size_t>(factor) - 1) / static_cast<size_t>(factor);
+}
+
+void Decimator::process(const float* input, size_t length, float* output) const {
+    const size_t step = static_cast<size_t>(factor_);
+    const size_t numOutputs = outputLength(length, factor_);
+    const size_t numTaps = taps_.size();
+
+    // Output n reads input[n * factor - halfLength .. n * factor + halfLength];
+    // the ones whose window fits inside the input go through the backend in blocks
+    size_t first = (halfLength_ + step - 1) / step;
+    size_t last = length >= numTaps ? (length - numTaps + halfLength_) / step + 1 : 0;
+    first = std::min(first, numOutputs);
+    last = std::min(std::max(last, first), numOutputs);
+
+    for (size_t block = first; block < last; block += OUTPUTS_PER_BLOCK) {
+        CancellationScope::check();
+        DSP::decimate(input + block * step - halfLength_, step, taps_.data(), numTaps,
+                      output + block, std::min(OUTPUTS_PER_BLOCK, last - block));
+    }
+
+    // Edge outputs see zeros beyond the ends of the input
+    auto edge = [&](size_t n) {
+        double sum = 0.0;
+        for (size_t p = 0; p < numTaps; ++p) {
+            int64_t index = static_cast<int64_t>(n * step + p) - static_cast<int64_t>(halfLength_);
+            if (index >= 0 && index < static_cast<int64_t>(length)) {
+                sum += static_cast<double>(taps_[p]) * input[index];
+            }
+        }
+        output[n] = static_cast<float>(sum);
+    };
+    for (size_t n = 0; n < first; ++n) edge(n);
+    for (size_t n = last; n < numOutputs; ++n) edge(n);
+}
+
+void Decimator::process(const float* input, size_t length, std::vector<float>& output) const {
+    output.resize(outputLength(length, factor_));
+    process(input, length, output.data());
+}
+
+// MARK: - Private Methods
+
+void Decimator::designFilter() {
+    halfLength_ = factor_ > 1 ? HALF_TAPS_PER_FACTOR * static_cast<size_t>(factor_) : 0;
+    taps_.assign(2 * halfLength_ + 1, 0.0f);
+
+    const double cutoff = 0.5 / factor_;  // Cycles per input sample
+    const double window = besselI0(KAISER_BETA);
+
+    double sum = 0.0;
+    std::vector<double> taps(taps_.size());
+    for (size_t p = 0; p < taps.size(); ++p) {
+        double k = static_cast<double>(p) - static_cast<double>(halfLength_);
+        double sinc = k == 0.0 ? 1.0 : std::sin(2.0 * M_PI * cutoff * k) / (2.0 * M_PI * cutoff * k);
+
+        double ratio = halfLength_ > 0 ? k / halfLength_ : 0.0;
+        double kaiser = besselI0(KAISER_BETA * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) / window;
+
+        taps[p] = sinc * kaiser;
+        sum += taps[p];
+    }
+
+    // Unity gain at DC
+    for (size_t p = 0; p < taps.size(); ++p) {
+        taps_[p] = static_cast<float>(taps[p] / sum);
+    }
+}
+
+} // namespace HarmoniqSync
@@ -0,0 +1,256 @@
+//
+//  dsp_backend_accelerate.cpp
+//  HarmoniqSyncCore
+//
+//  DSP backend on Apple Accelerate
+//  Every kernel forwards to the vDSP routine it is named after
+//
+
+#include "../include/dsp_backend.hpp"
+#include <Accelerate/Accelerate.h>
+#include <stdexcept>
+
+namespace HarmoniqSync {
+namespace DSP {
+
+// MARK: - Helpers
+
+static DSPSplitComplex toVDSP(const SplitComplex<float>& split) {
+    return { split.realp, split.imagp };
+}
+
+static DSPDoubleSplitComplex toVDSP(const SplitComplex<double>& split) {
+    return { split.realp, split.imagp };
+}
+
+/// vDSP setup type and entry points per precision
+template <typename T>
+struct SetupTraits;
+
+template <>
+struct SetupTraits<float> {
+    using Handle = FFTSetup;
+
+    static Handle create(size_t log2Size) { return vDSP_create_fftsetup(static_cast<vDSP_Length>(log2Size), FFT_RADIX2); }
+    static void destroy(Handle handle) { vDSP_destroy_fftsetup(handle); }
+
+    static void transform(Handle handle, const SplitComplex<float>& data, size_t log2Size, FFTDirection direction) {
+        DSPSplitComplex split = toVDSP(data);
+        vDSP_fft_zrip(handle, &split, 1, static_cast<vDSP_Length>(log2Size), direction);
+    }
+};
+
+template <>
+struct SetupTraits<double> {
+    using Handle = FFTSetupD;
+
+    static Handle create(size_t log2Size) { return vDSP_create_fftsetupD(static_cast<vDSP_Length>(log2Size), FFT_RADIX2); }
+    static void destroy(Handle handle) { vDSP_destroy_fftsetupD(handle); }
+
+    static void transform(Handle handle, const SplitComplex<double>& data, size_t log2Size, FFTDirection direction) {
+        DSPDoubleSplitComplex split = toVDSP(data);
+        vDSP_fft_zripD(handle, &split, 1, static_cast<vDSP_Length>(log2Size), direction);
+    }
+};
+
+const char* backendName() {
+    return "Accelerate";
+}
+
+// MARK: - Real FFT
+
+template <typename T>
+struct RealFFT<T>::Setup {
+    typename SetupTraits<T>::Handle handle;
+
+    explicit Setup(size_t log2Size) : handle(SetupTraits<T>::create(log2Size)) {}
+    ~Setup() { if (handle) SetupTraits<T>::destroy(handle); }
+};
+
+template <typename T>
+RealFFT<T>::RealFFT(size_t maxLog2Size)
+    : maxLog2Size_(maxLog2Size) {
+    if (maxLog2Size == 0) {
+        throw std::invalid_argument("FFT size must be at least 2 points");
+    }
+
+    setup_ = std::make_unique<Setup>(maxLog2Size);
+    if (!setup_->handle) {
+        throw std::runtime_error("Failed to initialize Apple Accelerate FFT setup");
+    }
+}
+
+template <typename T>
+RealFFT<T>::~RealFFT() = default;
+
+template <typename T>
+RealFFT<T>::RealFFT(RealFFT&& other) noexcept = default;
+
+template <typename T>
+RealFFT<T>& RealFFT<T>::operator=(RealFFT&& other) noexcept = default;
+
+template <typename T>
+void RealFFT<T>::forward(const SplitComplex<T>& data, size_t log2Size) const {
+    SetupTraits<T>::transform(setup_->handle, data, log2Size, FFT_FORWARD);
+}
+
+template <typename T>
+void RealFFT<T>::inverse(const SplitComplex<T>& data, size_t log2Size) const {
+    SetupTraits<T>::transform(setup_->handle, data, log2Size, FFT_INVERSE);
+}
+
+template class RealFFT<float>;
+template class RealFFT<double>;
+
+void pack(const float* input, const SplitComplex<float>& split, size_t count) {
+    DSPSplitComplex output = toVDSP(split);
+    vDSP_ctoz(reinterpret_cast<const DSPComplex*>(input), 2, &output, 1, static_cast<vDSP_Length>(count));
+}
+
+void pack(const double* input, const SplitComplex<double>& split, size_t count) {
+    DSPDoubleSplitComplex output = toVDSP(split);
+    vDSP_ctozD(reinterpret_cast<const DSPDoubleComplex*>(input), 2, &output, 1, static_cast<vDSP_Length>(count));
+}
+
+void unpack(const SplitComplex<float>& split, float* output, size_t count) {
+    DSPSplitComplex input = toVDSP(split);
+    vDSP_ztoc(&input, 1, reinterpret_cast<DSPComplex*>(output), 2, static_cast<vDSP_Length>(count));
+}
+
+void unpack(const SplitComplex<double>& split, double* output, size_t count) {
+    DSPDoubleSplitComplex input = toVDSP(split);
+    vDSP_ztocD(&input, 1, reinterpret_cast<DSPDoubleComplex*>(output), 2, static_cast<vDSP_Length>(count));
+}
+
+// MARK: - Complex Vectors
+
+void squaredMagnitudes(const SplitComplex<float>& input, float* output, size_t count) {
+    DSPSplitComplex split = toVDSP(input);
+    vDSP_zvmags(&split, 1, output, 1, static_cast<vDSP_Length>(count));
+}
+
+void multiplyConjugate(const SplitComplex<float>& a, const SplitComplex<float>& b,
+                       const SplitComplex<float>& output, size_t count) {
+    DSPSplitComplex splitA = toVDSP(a);
+    DSPSplitComplex splitB = toVDSP(b);
+    DSPSplitComplex splitOutput = toVDSP(output);
+    vDSP_zvmul(&splitA, 1, &splitB, 1, &splitOutput, 1, static_cast<vDSP_Length>(count), -1);
+}
+
+void multiplyConjugate(const SplitComplex<double>& a, const SplitComplex<double>& b,
+                       const SplitComplex<double>& output, size_t count) {
+    DSPDoubleSplitComplex splitA = toVDSP(a);
+    DSPDoubleSplitComplex splitB = toVDSP(b);
+    DSPDoubleSplitComplex splitOutput = toVDSP(output);
+    vDSP_zvmulD(&splitA, 1, &splitB, 1, &splitOutput, 1, static_cast<vDSP_Length>(count), -1);
+}
+
+void add(const SplitComplex<float>& a, const SplitComplex<float>& b,
+         const SplitComplex<float>& output, size_t count) {
+    DSPSplitComplex splitA = toVDSP(a);
+    DSPSplitComplex splitB = toVDSP(b);
+    DSPSplitComplex splitOutput = toVDSP(output);
+    vDSP_zvadd(&splitA, 1, &splitB, 1, &splitOutput, 1, static_cast<vDSP_Length>(count));
+}
+
+void add(const SplitComplex<double>& a, const SplitComplex<double>& b,
+         const SplitComplex<double>& output, size_t count) {
+    DSPDoubleSplitComplex splitA = toVDSP(a);
+    DSPDoubleSplitComplex splitB = toVDSP(b);
+    DSPDoubleSplitComplex splitOutput = toVDSP(output);
+    vDSP_zvaddD(&splitA, 1, &splitB, 1, &splitOutput, 1, static_cast<vDSP_Length>(count));
+}
+
+// MARK: - Real Vectors
+
+void multiply(const float* a, const float* b, float* output, size_t count) {
+    vDSP_vmul(a, 1, b, 1, output, 1, static_cast<vDSP_Length>(count));
+}
+
+void scale(const float* input, float scale, float* output, size_t count) {
+    vDSP_vsmul(input, 1, &scale, output, 1, static_cast<vDSP_Length>(count));
+}
+
+void scale(const double* input, double scale, double* output, size_t count) {
+    vDSP_vsmulD(input, 1, &scale, output, 1, static_cast<vDSP_Length>(count));
+}
+
+void addScalar(const float* input, float offset, float* output, size_t count) {
+    vDSP_vsadd(input, 1, &offset, output, 1, static_cast<vDSP_Length>(count));
+}
+
+void scaleAdd(const float* input, float scale, float offset, float* output, size_t count) {
+    vDSP_vsmsa(input, 1, &scale, &offset, output, 1, static_cast<vDSP_Length>(count));
+}
+
+void threshold(const float* input, float lower, float* output, size_t count) {
+    vDSP_vthr(input, 1, &lower, output, 1, static_cast<vDSP_Length>(count));
+}
+
+void squareRoot(const float* input, float* output, size_t count) {
+    int length = static_cast<int>(count);
+    vvsqrtf(output, input, &length);
+}
+
+void log10(const float* input, float* output, size_t count) {
+    int length = static_cast<int>(count);
+    vvlog10f(output, input, &length);
+}
+
+// MARK: - Reductions
+
+float sum(const float* input, size_t count) {
+    float result = 0.0f;
+    vDSP_sve(input, 1, &result, static_cast<vDSP_Length>(count));
+    return result;
+}
+
+float sumOfSquares(const float* input, size_t count) {
+    float result = 0.0f;
+    vDSP_svesq(input, 1, &result, static_cast<vDSP_Length>(count));
+    return result;
+}
+
+float mean(const float* input, size_t count) {
+    float result = 0.0f;
+    vDSP_meanv(input, 1, &result, static_cast<vDSP_Length>(count));
+    return result;
+}
+
+float minimum(const float* input, size_t count) {
+    float result = 0.0f;
+    vDSP_minv(input, 1, &result, static_cast<vDSP_Length>(count));
+    return result;
+}
+
+float maximum(const float* input, size_t count) {
+    float result = 0.0f;
+    vDSP_maxv(input, 1, &result, static_cast<vDSP_Length>(count));
+    return result;
+}
+
+float dot(const float* a, const float* b, size_t count) {
+    float result = 0.0f;
+    vDSP_dotpr(a, 1, b, 1, &result, static_cast<vDSP_Length>(count));
+    return result;
+}
+
+// MARK: - Filters and Windows
+
+void hannWindow(float* window, size_t length) {
+    vDSP_hann_window(window, static_cast<vDSP_Length>(length), vDSP_HANN_NORM);
+}
+
+void decimate(const float* input, size_t factor, const float* taps, size_t numTaps,
+              float* output, size_t numOutputs) {
+    vDSP_desamp(input, static_cast<vDSP_Stride>(factor), taps, output,
+                static_cast<vDSP_Length>(numOutputs), static_cast<vDSP_Length>(numTaps));
+}
+
+void matrixMultiply(const float* a, const float* b, float* c, size_t rows, size_t cols, size_t inner) {
+    vDSP_mmul(a, 1, b, 1, c, 1, static_cast<vDSP_Length>(rows), static_cast<vDSP_Length>(cols),
+              static_cast<vDSP_Length>(inner));
+}
+
+} // namespace DSP
+} // namespace HarmoniqSync
@@ -0,0 +1,535 @@
+//
+//  dsp_backend_portable.cpp
+//  HarmoniqSyncCore
+//
+//  DSP backend in plain C++ for platforms without Accelerate
+//  Loops are kept simple and contiguous so the compiler vectorizes them
+//
+
+#include "../include/dsp_backend.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace HarmoniqSync {
+namespace DSP {
+
+// MARK: - Constants
+
+// Amplitude of vDSP_HANN_NORM, which scales the window to unit RMS
+static const double HANN_NORM_SCALE = 0.8165;
+
+// MARK: - Helpers
+
+template <typename T>
+static bool overlaps(const T* a, size_t lengthA, const T* b, size_t lengthB) {
+    return a < b + lengthB && b < a + lengthA;
+}
+
+/// Reorder a split complex vector of 2^n values into bit-reversed index order.
+/// `reversed` holds the reversed indices for the setup's largest transform, so a
+/// shorter one drops the low `shift` bits of each entry
+template <typename T>
+static void bitReverse(const size_t* reversed, size_t shift, T* re, T* im, size_t count) {
+    for (size_t i = 1; i < count; ++i) {
+        size_t j = reversed[i] >> shift;
+        if (i < j) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+}
+
+/// One radix-2 stage over a block of two half-length runs, with the twiddles at
+/// wr / wi. The runs never overlap; taking them as separate restrict parameters
+/// spares the vectorizer more alias checks than it is willing to emit
+template <typename T>
+static void radix2Block(const T* __restrict wr, const T* __restrict wi, T sign, size_t half,
+                        T* __restrict re0, T* __restrict im0, T* __restrict re1, T* __restrict im1) {
+    for (size_t j = 0; j < half; ++j) {
+        T c = wr[j];
+        T s = sign * wi[j];
+        T tr = c * re1[j] - s * im1[j];
+        T ti = c * im1[j] + s * re1[j];
+        re1[j] = re0[j] - tr;
+        im1[j] = im0[j] - ti;
+        re0[j] += tr;
+        im0[j] += ti;
+    }
+}
+
+/// Two radix-2 stages (spans 2 * half and 4 * half) over one block of four
+/// quarter-length runs, with the same restrict parameters as radix2Block
+template <typename T>
+static void radix4Block(const T* __restrict cosines, const T* __restrict sines, T sign, size_t half,
+                        T* __restrict re0, T* __restrict im0, T* __restrict re1, T* __restrict im1,
+                        T* __restrict re2, T* __restrict im2, T* __restrict re3, T* __restrict im3) {
+    const T* w1r = cosines + half - 1;
+    const T* w1i = sines + half - 1;
+    const T* w2r = cosines + 2 * half - 1;
+    const T* w2i = sines + 2 * half - 1;
+
+    for (size_t j = 0; j < half; ++j) {
+        // Span 2 * half: (0, 1) and (2, 3) share the twiddle W1
+        T c1 = w1r[j];
+        T s1 = sign * w1i[j];
+        T tr = c1 * re1[j] - s1 * im1[j];
+        T ti = c1 * im1[j] + s1 * re1[j];
+        T ur = c1 * re3[j] - s1 * im3[j];
+        T ui = c1 * im3[j] + s1 * re3[j];
+        T aRe = re0[j] + tr;
+        T aIm = im0[j] + ti;
+        T bRe = re0[j] - tr;
+        T bIm = im0[j] - ti;
+        T cRe = re2[j] + ur;
+        T cIm = im2[j] + ui;
+        T dRe = re2[j] - ur;
+        T dIm = im2[j] - ui;
+
+        // Span 4 * half: (0, 2) take W2 and (1, 3) take W2 * sign * i
+        T c2 = w2r[j];
+        T s2 = sign * w2i[j];
+        T vr = c2 * cRe - s2 * cIm;
+        T vi = c2 * cIm + s2 * cRe;
+        T zr = -sign * (c2 * dIm + s2 * dRe);
+        T zi = sign * (c2 * dRe - s2 * dIm);
+        re0[j] = aRe + vr;
+        im0[j] = aIm + vi;
+        re2[j] = aRe - vr;
+        im2[j] = aIm - vi;
+        re1[j] = bRe + zr;
+        im1[j] = bIm + zi;
+        re3[j] = bRe - zr;
+        im3[j] = bIm - zi;
+    }
+}
+
+/// One radix-2 stage: butterflies of span 2 * half
+template <typename T>
+static void radix2Stage(const T* cosines, const T* sines, T sign, T* re, T* im, size_t count, size_t half) {
+    for (size_t start = 0; start < count; start += 2 * half) {
+        radix2Block(cosines + half - 1, sines + half - 1, sign, half,
+                    re + start, im + start, re + start + half, im + start + half);
+    }
+}
+
+/// Two radix-2 stages in one pass over the data, so each value is loaded and
+/// stored once per pair of stages instead of once per stage
+template <typename T>
+static void radix4Stage(const T* cosines, const T* sines, T sign, T* re, T* im, size_t count, size_t half) {
+    for (size_t start = 0; start < count; start += 4 * half) {
+        T* re0 = re + start;
+        T* im0 = im + start;
+        radix4Block(cosines, sines, sign, half,
+                    re0, im0, re0 + half, im0 + half,
+                    re0 + 2 * half, im0 + 2 * half, re0 + 3 * half, im0 + 3 * half);
+    }
+}
+
+/// Unscaled in-place complex FFT of 2^n split values: the first two stages have
+/// trivial twiddles (1 and +/-i) and run as one pass, the rest go two at a time.
+/// Twiddles for a butterfly span of 2 * half are the `half` entries starting at
+/// cosines[half - 1] / sines[half - 1], so every stage reads them contiguously.
+template <typename T>
+static void complexTransform(const T* cosines, const T* sines, const size_t* reversed, size_t shift,
+                             T* re, T* im, size_t count, bool inverse) {
+    bitReverse(reversed, shift, re, im, count);
+
+    const T sign = inverse ? T(1) : T(-1);
+    if (count < 4) {
+        if (count == 2) {
+            radix2Stage(cosines, sines, sign, re, im, count, 1);
+        }
+        return;
+    }
+
+    // Spans 2 and 4; the odd output of the second takes the twiddle sign * i
+    for (size_t start = 0; start < count; start += 4) {
+        T aRe = re[start] + re[start + 1];
+        T aIm = im[start] + im[start + 1];
+        T bRe = re[start] - re[start + 1];
+        T bIm = im[start] - im[start + 1];
+        T cRe = re[start + 2] + re[start + 3];
+        T cIm = im[start + 2] + im[start + 3];
+        T dRe = re[start + 2] - re[start + 3];
+        T dIm = im[start + 2] - im[start + 3];
+        T zr = -sign * dIm;
+        T zi = sign * dRe;
+
+        re[start] = aRe + cRe;
+        im[start] = aIm + cIm;
+        re[start + 2] = aRe - cRe;
+        im[start + 2] = aIm - cIm;
+        re[start + 1] = bRe + zr;
+        im[start + 1] = bIm + zi;
+        re[start + 3] = bRe - zr;
+        im[start + 3] = bIm - zi;
+    }
+
+    size_t half = 4;
+    for (; 4 * half <= count; half <<= 2) {
+        radix4Stage(cosines, sines, sign, re, im, count, half);
+    }
+    if (half < count) {
+        radix2Stage(cosines, sines, sign, re, im, count, half);
+    }
+}
+
+/// Scratch for packing when the interleaved input shares storage with the split halves
+template <typename T>
+static std::vector<T>& packScratch() {
+    thread_local std::vector<T> scratch;
+    return scratch;
+}
+
+template <typename T>
+static void packInterleaved(const T* input, const SplitComplex<T>& split, size_t count) {
+    if (overlaps(input, 2 * count, split.realp, count) || overlaps(input, 2 * count, split.imagp, count)) {
+        std::vector<T>& scratch = packScratch<T>();
+        scratch.assign(input, input + 2 * count);
+        input = scratch.data();
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        split.realp[i] = input[2 * i];
+        split.imagp[i] = input[2 * i + 1];
+    }
+}
+
+const char* backendName() {
+    return "Portable";
+}
+
+// MARK: - Real FFT
+
+template <typename T>
+struct RealFFT<T>::Setup {
+    // cos / sin(2 * pi * j / (2 * half)) for every half = 1, 2, 4, ... up to
+    // the real transform size / 2, concatenated (see complexTransform)
+    std::vector<T> cosines;
+    std::vector<T> sines;
+    // Bit-reversed index of every slot of the largest complex transform
+    std::vector<size_t> reversed;
+    size_t complexLog2Size;
+
+    explicit Setup(size_t log2Size)
+        : complexLog2Size(log2Size - 1) {
+        const size_t length = size_t(1) << log2Size;
+        cosines.reserve(length - 1);
+        sines.reserve(length - 1);
+
+        for (size_t half = 1; half < length; half <<= 1) {
+            for (size_t j = 0; j < half; ++j) {
+                double angle = M_PI * static_cast<double>(j) / static_cast<double>(half);
+                cosines.push_back(static_cast<T>(std::cos(angle)));
+                sines.push_back(static_cast<T>(std::sin(angle)));
+            }
+        }
+
+        const size_t count = length / 2;
+        reversed.assign(count, 0);
+        for (size_t i = 1; i < count; ++i) {
+            reversed[i] = (reversed[i >> 1] >> 1) | ((i & 1) ? count >> 1 : 0);
+        }
+    }
+
+    void transform(T* re, T* im, size_t log2Size, bool inverse) const {
+        complexTransform(cosines.data(), sines.data(), reversed.data(), complexLog2Size - (log2Size - 1),
+                         re, im, (size_t(1) << log2Size) / 2, inverse);
+    }
+};
+
+template <typename T>
+RealFFT<T>::RealFFT(size_t maxLog2Size)
+    : maxLog2Size_(maxLog2Size) {
+    if (maxLog2Size == 0) {
+        throw std::invalid_argument("FFT size must be at least 2 points");
+    }
+    if (maxLog2Size >= sizeof(size_t) * 8 - 1) {
+        throw std::runtime_error("Failed to initialize portable FFT setup");
+    }
+
+    setup_ = std::make_unique<Setup>(maxLog2Size);
+}
+
+template <typename T>
+RealFFT<T>::~RealFFT() = default;
+
+template <typename T>
+RealFFT<T>::RealFFT(RealFFT&& other) noexcept = default;
+
+template <typename T>
+RealFFT<T>& RealFFT<T>::operator=(RealFFT&& other) noexcept = default;
+
+template <typename T>
+void RealFFT<T>::forward(const SplitComplex<T>& data, size_t log2Size) const {
+    const size_t half = (size_t(1) << log2Size) / 2;
+    T* re = data.realp;
+    T* im = data.imagp;
+
+    setup_->transform(re, im, log2Size, false);
+
+    // Split the half-length transform Z of even + i * odd samples into the real
+    // spectrum: 2X[k] = E - i W^k O, with E = Z[k] + conj(Z[h - k]),
+    // O = Z[k] - conj(Z[h - k]) and W = exp(-2 pi i / N)
+    const T* wr = setup_->cosines.data() + half - 1;
+    const T* wi = setup_->sines.data() + half - 1;
+
+    T dc = re[0] + im[0];
+    T nyquist = re[0] - im[0];
+    re[0] = 2 * dc;
+    im[0] = 2 * nyquist;
+
+    for (size_t k = 1; k <= half / 2; ++k) {
+        size_t mirror = half - k;
+        T evenRe = re[k] + re[mirror];
+        T evenIm = im[k] - im[mirror];
+        T oddRe = re[k] - re[mirror];
+        T oddIm = im[k] + im[mirror];
+
+        // W^k * O with W^k = wr[k] - i * wi[k]
+        T rotatedRe = wr[k] * oddRe + wi[k] * oddIm;
+        T rotatedIm = wr[k] * oddIm - wi[k] * oddRe;
+
+        // Bin h - k is conj(E + i W^k O)
+        re[k] = evenRe + rotatedIm;
+        im[k] = evenIm - rotatedRe;
+        re[mirror] = evenRe - rotatedIm;
+        im[mirror] = -(evenIm + rotatedRe);
+    }
+}
+
+template <typename T>
+void RealFFT<T>::inverse(const SplitComplex<T>& data, size_t log2Size) const {
+    const size_t half = (size_t(1) << log2Size) / 2;
+    T* re = data.realp;
+    T* im = data.imagp;
+
+    // Rebuild the half-length spectrum of even + i * odd outputs:
+    // Z[k] = E + i conj(W^k) O, the exact reverse of the forward split
+    const T* wr = setup_->cosines.data() + half - 1;
+    const T* wi = setup_->sines.data() + half - 1;
+
+    T dc = re[0];
+    T nyquist = im[0];
+    re[0] = dc + nyquist;
+    im[0] = dc - nyquist;
+
+    for (size_t k = 1; k <= half / 2; ++k) {
+        size_t mirror = half - k;
+        T evenRe = re[k] + re[mirror];
+        T evenIm = im[k] - im[mirror];
+        T oddRe = re[k] - re[mirror];
+        T oddIm = im[k] + im[mirror];
+
+        // conj(W^k) * O with conj(W^k) = wr[k] + i * wi[k]
+        T rotatedRe = wr[k] * oddRe - wi[k] * oddIm;
+        T rotatedIm = wr[k] * oddIm + wi[k] * oddRe;
+
+        // Bin h - k is conj(E - i conj(W^k) O)
+        re[k] = evenRe - rotatedIm;
+        im[k] = evenIm + rotatedRe;
+        re[mirror] = evenRe + rotatedIm;
+        im[mirror] = rotatedRe - evenIm;
+    }
+
+    setup_->transform(re, im, log2Size, true);
+}
+
+template class RealFFT<float>;
+template class RealFFT<double>;
+
+void pack(const float* input, const SplitComplex<float>& split, size_t count) {
+    packInterleaved(input, split, count);
+}
+
+void pack(const double* input, const SplitComplex<double>& split, size_t count) {
+    packInterleaved(input, split, count);
+}
+
+void unpack(const SplitComplex<float>& split, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[2 * i] = split.realp[i];
+        output[2 * i + 1] = split.imagp[i];
+    }
+}
+
+void unpack(const SplitComplex<double>& split, double* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[2 * i] = split.realp[i];
+        output[2 * i + 1] = split.imagp[i];
+    }
+}
+
+// MARK: - Complex Vectors
+
+void squaredMagnitudes(const SplitComplex<float>& input, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = input.realp[i] * input.realp[i] + input.imagp[i] * input.imagp[i];
+    }
+}
+
+void multiplyConjugate(const SplitComplex<float>& a, const SplitComplex<float>& b,
+                       const SplitComplex<float>& output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float aRe = a.realp[i], aIm = a.imagp[i];
+        float bRe = b.realp[i], bIm = b.imagp[i];
+        output.realp[i] = aRe * bRe + aIm * bIm;
+        output.imagp[i] = aRe * bIm - aIm * bRe;
+    }
+}
+
+void multiplyConjugate(const SplitComplex<double>& a, const SplitComplex<double>& b,
+                       const SplitComplex<double>& output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        double aRe = a.realp[i], aIm = a.imagp[i];
+        double bRe = b.realp[i], bIm = b.imagp[i];
+        output.realp[i] = aRe * bRe + aIm * bIm;
+        output.imagp[i] = aRe * bIm - aIm * bRe;
+    }
+}
+
+void add(const SplitComplex<float>& a, const SplitComplex<float>& b,
+         const SplitComplex<float>& output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output.realp[i] = a.realp[i] + b.realp[i];
+        output.imagp[i] = a.imagp[i] + b.imagp[i];
+    }
+}
+
+void add(const SplitComplex<double>& a, const SplitComplex<double>& b,
+         const SplitComplex<double>& output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output.realp[i] = a.realp[i] + b.realp[i];
+        output.imagp[i] = a.imagp[i] + b.imagp[i];
+    }
+}
+
+// MARK: - Real Vectors
+
+void multiply(const float* a, const float* b, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = a[i] * b[i];
+    }
+}
+
+void scale(const float* input, float scale, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = input[i] * scale;
+    }
+}
+
+void scale(const double* input, double scale, double* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = input[i] * scale;
+    }
+}
+
+void addScalar(const float* input, float offset, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = input[i] + offset;
+    }
+}
+
+void scaleAdd(const float* input, float scale, float offset, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = input[i] * scale + offset;
+    }
+}
+
+void threshold(const float* input, float lower, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = input[i] < lower ? lower : input[i];
+    }
+}
+
+void squareRoot(const float* input, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = std::sqrt(input[i]);
+    }
+}
+
+void log10(const float* input, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = std::log10(input[i]);
+    }
+}
+
+// MARK: - Reductions
+
+float sum(const float* input, size_t count) {
+    float result = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        result += input[i];
+    }
+    return result;
+}
+
+float sumOfSquares(const float* input, size_t count) {
+    float result = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        result += input[i] * input[i];
+    }
+    return result;
+}
+
+float mean(const float* input, size_t count) {
+    return count > 0 ? sum(input, count) / static_cast<float>(count) : 0.0f;
+}
+
+float minimum(const float* input, size_t count) {
+    return count > 0 ? *std::min_element(input, input + count) : INFINITY;
+}
+
+float maximum(const float* input, size_t count) {
+    return count > 0 ? *std::max_element(input, input + count) : -INFINITY;
+}
+
+float dot(const float* a, const float* b, size_t count) {
+    float result = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+// MARK: - Filters and Windows
+
+void hannWindow(float* window, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        double phase = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(length);
+        window[i] = static_cast<float>(HANN_NORM_SCALE * (1.0 - std::cos(phase)));
+    }
+}
+
+void decimate(const float* input, size_t factor, const float* taps, size_t numTaps,
+              float* output, size_t numOutputs) {
+    for (size_t n = 0; n < numOutputs; ++n) {
+        output[n] = dot(input + n * factor, taps, numTaps);
+    }
+}
+
+void matrixMultiply(const float* a, const float* b, float* c, size_t rows, size_t cols, size_t inner) {
+    // Row-times-matrix order keeps the innermost loop on contiguous rows of b and c
+    for (size_t row = 0; row < rows; ++row) {
+        float* out = c + row * cols;
+        std::fill(out, out + cols, 0.0f);
+
+        for (size_t k = 0; k < inner; ++k) {
+            const float weight = a[row * inner + k];
+            const float* source = b + k * cols;
+            for (size_t col = 0; col < cols; ++col) {
+                out[col] += weight * source[col];
+            }
+        }
+    }
+}
+
+} // namespace DSP
+} // namespace HarmoniqSync
@@ -0,0 +1,59 @@
+//
+//  dsp_shared_plans.cpp
+//  HarmoniqSyncCore
+//
+//  Process-wide FFT plans and window tables shared by every engine
+//  Backend independent: built on the RealFFT and hannWindow of the compiled-in backend
+//
+
+#include "../include/dsp_backend.hpp"
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace HarmoniqSync {
+namespace DSP {
+
+// MARK: - Shared Plans
+
+template <typename T>
+std::shared_ptr<const RealFFT<T>> sharedRealFFT(size_t minLog2Size) {
+    if (minLog2Size == 0) {
+        throw std::invalid_argument("FFT size must be at least 2 points");
+    }
+
+    static std::mutex mutex;
+    static std::shared_ptr<const RealFFT<T>> plan;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!plan || plan->getMaxLog2Size() < minLog2Size) {
+        // Drop the kept plan first; holders of it keep their own reference
+        plan.reset();
+        plan = std::make_shared<const RealFFT<T>>(minLog2Size);
+    }
+    return plan;
+}
+
+template std::shared_ptr<const RealFFT<float>> sharedRealFFT<float>(size_t minLog2Size);
+template std::shared_ptr<const RealFFT<double>> sharedRealFFT<double>(size_t minLog2Size);
+
+std::shared_ptr<const std::vector<float>> sharedHannWindow(size_t length) {
+    static std::mutex mutex;
+    static std::map<size_t, std::shared_ptr<const std::vector<float>>> windows;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = windows.find(length);
+    if (it != windows.end()) {
+        return it->second;
+    }
+
+    auto window = std::make_shared<std::vector<float>>(length);
+    hannWindow(window->data(), length);
+    windows.emplace(length, window);
+    return window;
+}
+
+} // namespace DSP
+} // namespace HarmoniqSync
@@ -9,17 +9,179 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
-#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 namespace HarmoniqSync {
 
 // Static member definitions
-std::mutex ErrorHandler::errorMutex_;
-std::vector<ErrorContext> ErrorHandler::errorLog_;
-std::vector<ErrorHandler::ErrorCallback> ErrorHandler::callbacks_;
-ErrorSeverity ErrorHandler::minimumSeverity_ = ErrorSeverity::Info;
+std::atomic<ErrorSeverity> ErrorHandler::minimumSeverity_{ErrorSeverity::Info};
 std::atomic<uint64_t> ErrorHandler::operationCounter_{0};
 
+// MARK: - Constants
+
+// Counter shards; threads are spread over them round robin
+static const size_t COUNTER_SHARD_COUNT = 16;
+
+// Keeps producer and consumer positions, and counter shards, on their own cache lines
+static const size_t CACHE_LINE_SIZE = 64;
+
+// Pushes retried while another thread drains a full ring, which frees slots as it goes
+static const size_t FULL_RING_RETRIES = 256;
+
+// MARK: - Event Ring
+
+/// Bounded multi-producer ring of events with one consumer at a time. Each slot
+/// carries a sequence number: a producer claims position p by moving the head
+/// past it while slot p has sequence p, writes the event and publishes it with
+/// sequence p + 1; the consumer takes it and frees the slot for the next lap
+/// with sequence p + capacity. A full ring fails the push instead of waiting.
+class EventRing {
+public:
+    EventRing() : head_(0), tail_(0) {
+        for (size_t i = 0; i < ErrorHandler::EVENT_RING_CAPACITY; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    
+    /// Append an event (any thread)
+    /// @return False if the ring is full
+    bool tryPush(const ErrorContext& event) {
+        uint64_t position = head_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots_[position % ErrorHandler::EVENT_RING_CAPACITY];
+            uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+            if (difference == 0) {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+        
+        slot->event = event;
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /// Take the oldest published event (one consumer at a time)
+    /// @return False if the ring is empty or its oldest slot is still being written
+    bool tryPop(ErrorContext& event) {
+        Slot& slot = slots_[tail_ % ErrorHandler::EVENT_RING_CAPACITY];
+        if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1) return false;
+        
+        event = std::move(slot.event);
+        slot.event = ErrorContext();
+        slot.sequence.store(tail_ + ErrorHandler::EVENT_RING_CAPACITY, std::memory_order_release);
+        ++tail_;
+        return true;
+    }
+    
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        ErrorContext event;
+    };
+    
+    Slot slots_[ErrorHandler::EVENT_RING_CAPACITY];
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_;
+    alignas(CACHE_LINE_SIZE) uint64_t tail_;  // Consumer side, guarded by the drain mutex
+};
+
+/// Drained events and the ring that feeds them; the mutex serializes consumers only
+struct EventLog {
+    std::mutex drainMutex;
+    EventRing ring;
+    std::deque<ErrorContext> history;
+    uint64_t historyStart = 0;  // Events that ever left the history, i.e. the cursor of history.front()
+    
+    /// Move published events into the history (drain mutex held)
+    /// At most one ring's worth is taken, so loggers that keep up cannot hold a reader here.
+    void drain() {
+        ErrorContext event;
+        for (size_t i = 0; i < ErrorHandler::EVENT_RING_CAPACITY && ring.tryPop(event); ++i) {
+            history.push_back(std::move(event));
+            if (history.size() > ErrorHandler::EVENT_HISTORY_CAPACITY) {
+                history.pop_front();
+                ++historyStart;
+            }
+        }
+    }
+};
+
+static EventLog& eventLog() {
+    static EventLog log;
+    return log;
+}
+
+// MARK: - Counter Shards
+
+struct alignas(CACHE_LINE_SIZE) CounterShard {
+    std::array<std::atomic<uint64_t>, ERROR_SEVERITY_COUNT> logged;
+    std::atomic<uint64_t> filtered;
+    std::atomic<uint64_t> dropped;
+};
+
+static std::array<CounterShard, COUNTER_SHARD_COUNT>& counterShards() {
+    static std::array<CounterShard, COUNTER_SHARD_COUNT> shards{};
+    return shards;
+}
+
+/// Shard of the calling thread, assigned on its first event
+static CounterShard& threadShard() {
+    static std::atomic<size_t> nextShard{0};
+    thread_local size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % COUNTER_SHARD_COUNT;
+    return counterShards()[index];
+}
+
+static size_t severityIndex(ErrorSeverity severity) {
+    size_t index = static_cast<size_t>(severity);
+    return std::min(index, ERROR_SEVERITY_COUNT - 1);
+}
+
+// MARK: - Callbacks
+
+using CallbackList = std::vector<ErrorHandler::ErrorCallback>;
+
+static std::mutex& callbackMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::shared_ptr<const CallbackList>& callbackList() {
+    static std::shared_ptr<const CallbackList> list;
+    return list;
+}
+
+// Bumped on every change so threads only lock to pick up a new list
+static std::atomic<uint64_t>& callbackVersion() {
+    static std::atomic<uint64_t> version{0};
+    return version;
+}
+
+/// Registered callbacks as the calling thread last saw them
+static std::shared_ptr<const CallbackList> currentCallbacks() {
+    thread_local std::shared_ptr<const CallbackList> cached;
+    thread_local uint64_t cachedVersion = 0;
+    
+    if (callbackVersion().load(std::memory_order_acquire) != cachedVersion) {
+        std::lock_guard<std::mutex> lock(callbackMutex());
+        cached = callbackList();
+        cachedVersion = callbackVersion().load(std::memory_order_relaxed);
+    }
+    return cached;
+}
+
+/// Install a new list; the caller holds callbackMutex, so read, change and swap are one step
+static void publishCallbacks(std::shared_ptr<const CallbackList> list) {
+    callbackList() = std::move(list);
+    callbackVersion().fetch_add(1, std::memory_order_release);
+}
+
 // MARK: - ErrorHandler Implementation
 
 ErrorContext ErrorHandler::createError(
@@ -55,29 +217,39 @@ ErrorContext ErrorHandler::createError(
 }
 
 void ErrorHandler::logError(const ErrorContext& context) {
+    CounterShard& shard = threadShard();
+    
     // Check if severity meets minimum threshold
-    if (context.severity < minimumSeverity_) {
+    if (context.severity < minimumSeverity_.load(std::memory_order_relaxed)) {
+        shard.filtered.fetch_add(1, std::memory_order_relaxed);
         return;
     }
     
-    {
-        std::lock_guard<std::mutex> lock(errorMutex_);
-        
-        // Add to error log with size limit
-        errorLog_.push_back(context);
-        if (errorLog_.size() > 1000) { // Keep last 1000 errors
-            errorLog_.erase(errorLog_.begin());
+    // A full ring is drained by this thread, or retried while another thread drains it
+    EventLog& log = eventLog();
+    bool stored = log.ring.tryPush(context);
+    for (size_t attempt = 0; !stored && attempt < FULL_RING_RETRIES; ++attempt) {
+        std::unique_lock<std::mutex> lock(log.drainMutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            log.drain();
+        } else {
+            std::this_thread::yield();  // Lets a preempted drainer run on a busy machine
         }
+        stored = log.ring.tryPush(context);
+    }
+    if (stored) {
+        shard.logged[severityIndex(context.severity)].fetch_add(1, std::memory_order_relaxed);
+    } else {
+        shard.dropped.fetch_add(1, std::memory_order_relaxed);
     }
     
     // Call all registered callbacks
-    std::vector<ErrorCallback> callbacks;
-    {
-        std::lock_guard<std::mutex> lock(errorMutex_);
-        callbacks = callbacks_;
+    auto callbacks = currentCallbacks();
+    if (!callbacks) {
+        return;
     }
     
-    for (const auto& callback : callbacks) {
+    for (const auto& callback : *callbacks) {
         try {
             callback(context);
         } catch (...) {
@@ -87,36 +259,72 @@ void ErrorHandler::logError(const ErrorContext& context) {
 }
 
 std::vector<ErrorContext> ErrorHandler::getRecentErrors(size_t maxCount) {
-    std::lock_guard<std::mutex> lock(errorMutex_);
+    EventLog& log = eventLog();
+    std::lock_guard<std::mutex> lock(log.drainMutex);
+    log.drain();
     
-    std::vector<ErrorContext> result;
-    size_t startIndex = errorLog_.size() > maxCount ? errorLog_.size() - maxCount : 0;
+    size_t count = std::min(maxCount, log.history.size());
+    return std::vector<ErrorContext>(log.history.end() - static_cast<std::ptrdiff_t>(count), log.history.end());
+}
+
+std::vector<ErrorContext> ErrorHandler::drainEvents(uint64_t& cursor, size_t maxCount) {
+    EventLog& log = eventLog();
+    std::lock_guard<std::mutex> lock(log.drainMutex);
+    log.drain();
     
-    result.reserve(errorLog_.size() - startIndex);
-    for (size_t i = startIndex; i < errorLog_.size(); ++i) {
-        result.push_back(errorLog_[i]);
-    }
+    uint64_t first = std::max(cursor, log.historyStart);
+    uint64_t end = log.historyStart + log.history.size();
+    uint64_t count = first < end ? std::min<uint64_t>(end - first, maxCount) : 0;
     
-    return result;
+    auto begin = log.history.begin() + static_cast<std::ptrdiff_t>(first - log.historyStart);
+    std::vector<ErrorContext> events(begin, begin + static_cast<std::ptrdiff_t>(count));
+    cursor = std::max(cursor, first + count);
+    return events;
+}
+
+ErrorHandler::LogStats ErrorHandler::getStats() {
+    LogStats stats;
+    for (const CounterShard& shard : counterShards()) {
+        for (size_t s = 0; s < ERROR_SEVERITY_COUNT; ++s) {
+            stats.logged[s] += shard.logged[s].load(std::memory_order_relaxed);
+        }
+        stats.filtered += shard.filtered.load(std::memory_order_relaxed);
+        stats.dropped += shard.dropped.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+uint64_t ErrorHandler::LogStats::totalLogged() const {
+    uint64_t total = 0;
+    for (uint64_t count : logged) total += count;
+    return total;
 }
 
 void ErrorHandler::clearErrorLog() {
-    std::lock_guard<std::mutex> lock(errorMutex_);
-    errorLog_.clear();
+    EventLog& log = eventLog();
+    std::lock_guard<std::mutex> lock(log.drainMutex);
+    log.drain();
+    
+    // Cursors handed out before stay valid: they now point past the cleared events
+    log.historyStart += log.history.size();
+    log.history.clear();
 }
 
 void ErrorHandler::registerErrorCallback(ErrorCallback callback) {
-    std::lock_guard<std::mutex> lock(errorMutex_);
-    callbacks_.push_back(callback);
+    std::lock_guard<std::mutex> lock(callbackMutex());
+    const auto& current = callbackList();
+    auto list = current ? std::make_shared<CallbackList>(*current) : std::make_shared<CallbackList>();
+    list->push_back(std::move(callback));
+    publishCallbacks(std::move(list));
 }
 
 void ErrorHandler::clearErrorCallbacks() {
-    std::lock_guard<std::mutex> lock(errorMutex_);
-    callbacks_.clear();
+    std::lock_guard<std::mutex> lock(callbackMutex());
+    publishCallbacks(nullptr);
 }
 
 void ErrorHandler::setMinimumSeverity(ErrorSeverity minSeverity) {
-    minimumSeverity_ = minSeverity;
+    minimumSeverity_.store(minSeverity, std::memory_order_relaxed);
 }
 
 ErrorSeverity ErrorHandler::getErrorSeverity(harmoniq_sync_error_t code) {
@@ -129,6 +337,10 @@ ErrorSeverity ErrorHandler::getErrorSeverity(harmoniq_sync_error_t code) {
             return ErrorSeverity::Warning;
         case HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT:
             return ErrorSeverity::Warning;
+        case HARMONIQ_SYNC_ERROR_CANCELLED:
+            return ErrorSeverity::Info;
+        case HARMONIQ_SYNC_ERROR_TIMEOUT:
+            return ErrorSeverity::Warning;
         case HARMONIQ_SYNC_ERROR_PROCESSING_FAILED:
             return ErrorSeverity::Error;
         case HARMONIQ_SYNC_ERROR_OUT_OF_MEMORY:
@@ -158,6 +370,8 @@ std::string ErrorHandler::getErrorCodeName(harmoniq_sync_error_t code) {
         case HARMONIQ_SYNC_ERROR_PROCESSING_FAILED: return "PROCESSING_FAILED";
         case HARMONIQ_SYNC_ERROR_OUT_OF_MEMORY: return "OUT_OF_MEMORY";
         case HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT: return "UNSUPPORTED_FORMAT";
+        case HARMONIQ_SYNC_ERROR_CANCELLED: return "CANCELLED";
+        case HARMONIQ_SYNC_ERROR_TIMEOUT: return "TIMEOUT";
         default: return "UNKNOWN_ERROR";
     }
 }
@@ -0,0 +1,457 @@
+//
+//  feature_cache.cpp
+//  HarmoniqSyncCore
+//
+//  Persistent on-disk store of prepared feature streams keyed by audio content
+//
+
+#include "../include/feature_cache.hpp"
+#include "../include/dsp_backend.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Bumped whenever the layout or the meaning of a stored stream changes
+static const uint32_t FORMAT_VERSION = 1;
+static const char FORMAT_MAGIC[8] = {'H', 'S', 'F', 'E', 'A', 'T', 'U', 'R'};
+
+// Streams start on cache-line boundaries within the file
+static const size_t PAYLOAD_ALIGNMENT = 64;
+
+// Largest magnitude of an Int16 stream value
+static const float INT16_RANGE = 32767.0f;
+
+static const uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+static const uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+/// Fixed-size file header, followed by spectral flux, energy, chroma and MFCC values.
+/// Files written before storages existed have zero reserved bytes, i.e. Float32 storage.
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t method;
+    uint64_t contentHash;
+    uint64_t settingsHash;
+    uint64_t audioLength;
+    double sampleRate;
+    int32_t hopSize;
+    int32_t energyHopSize;
+    uint64_t spectralFluxLength;
+    uint64_t energyLength;
+    uint64_t chromaFrames;
+    uint64_t chromaDims;
+    uint64_t mfccFrames;
+    uint64_t mfccDims;
+    uint32_t storage;   // FeatureCache::Storage of every stream
+    float scales[4];    // Int16 step of flux, energy, chroma and MFCC values
+    uint8_t reserved[4];
+};
+static_assert(sizeof(FileHeader) == 128, "Feature cache header layout changed");
+
+// MARK: - Helpers
+
+static uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static uint64_t read64(const unsigned char* bytes) {
+    uint64_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+static uint64_t mixLane(uint64_t accumulator, uint64_t lane) {
+    accumulator += lane * PRIME2;
+    return rotateLeft(accumulator, 31) * PRIME1;
+}
+
+static uint64_t mergeLane(uint64_t hash, uint64_t accumulator) {
+    hash ^= mixLane(0, accumulator);
+    return hash * PRIME1 + PRIME4;
+}
+
+/// 64-bit hash in the layout of XXH64: four independent lanes over 32-byte stripes,
+/// so the loop runs at memory speed
+static uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    const unsigned char* end = bytes + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        uint64_t lanes[4] = {seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1};
+        for (; end - bytes >= 32; bytes += 32) {
+            lanes[0] = mixLane(lanes[0], read64(bytes));
+            lanes[1] = mixLane(lanes[1], read64(bytes + 8));
+            lanes[2] = mixLane(lanes[2], read64(bytes + 16));
+            lanes[3] = mixLane(lanes[3], read64(bytes + 24));
+        }
+
+        hash = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18);
+        for (uint64_t lane : lanes) {
+            hash = mergeLane(hash, lane);
+        }
+    } else {
+        hash = seed + PRIME5;
+    }
+
+    hash += static_cast<uint64_t>(size);
+    for (; end - bytes >= 8; bytes += 8) {
+        hash ^= mixLane(0, read64(bytes));
+        hash = rotateLeft(hash, 27) * PRIME1 + PRIME4;
+    }
+    for (; bytes < end; ++bytes) {
+        hash ^= *bytes * PRIME5;
+        hash = rotateLeft(hash, 11) * PRIME1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+static uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static size_t alignedOffset(size_t offset) {
+    return (offset + PAYLOAD_ALIGNMENT - 1) / PAYLOAD_ALIGNMENT * PAYLOAD_ALIGNMENT;
+}
+
+static size_t valueBytes(FeatureCache::Storage storage) {
+    return storage == FeatureCache::Storage::Float32 ? sizeof(float) : sizeof(uint16_t);
+}
+
+static uint16_t toBFloat16(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if (std::isnan(value)) return static_cast<uint16_t>((bits >> 16) | 0x0040);
+
+    // Round to nearest, ties to even
+    bits += 0x7FFF + ((bits >> 16) & 1);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+static float fromBFloat16(uint16_t half) {
+    uint32_t bits = static_cast<uint32_t>(half) << 16;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/// Step between Int16 codes that spans the stream's peak magnitude
+static float int16Scale(const float* values, size_t count) {
+    float peak = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        peak = std::max(peak, std::abs(values[i]));
+    }
+    return peak / INT16_RANGE;
+}
+
+static void encodeStream(const float* values, size_t count, FeatureCache::Storage storage, float scale,
+                         unsigned char* output) {
+    if (count == 0) return;
+    switch (storage) {
+        case FeatureCache::Storage::Float32:
+            std::memcpy(output, values, count * sizeof(float));
+            break;
+        case FeatureCache::Storage::BFloat16:
+            for (size_t i = 0; i < count; ++i) {
+                uint16_t half = toBFloat16(values[i]);
+                std::memcpy(output + i * sizeof(half), &half, sizeof(half));
+            }
+            break;
+        case FeatureCache::Storage::Int16: {
+            float inverse = scale > 0.0f ? 1.0f / scale : 0.0f;
+            for (size_t i = 0; i < count; ++i) {
+                int16_t code = static_cast<int16_t>(std::lround(values[i] * inverse));
+                std::memcpy(output + i * sizeof(code), &code, sizeof(code));
+            }
+            break;
+        }
+    }
+}
+
+static void decodeStream(const unsigned char* input, size_t count, FeatureCache::Storage storage, float scale,
+                         float* output) {
+    if (count == 0) return;
+    switch (storage) {
+        case FeatureCache::Storage::Float32:
+            std::memcpy(output, input, count * sizeof(float));
+            break;
+        case FeatureCache::Storage::BFloat16:
+            for (size_t i = 0; i < count; ++i) {
+                uint16_t half;
+                std::memcpy(&half, input + i * sizeof(half), sizeof(half));
+                output[i] = fromBFloat16(half);
+            }
+            break;
+        case FeatureCache::Storage::Int16:
+            for (size_t i = 0; i < count; ++i) {
+                int16_t code;
+                std::memcpy(&code, input + i * sizeof(code), sizeof(code));
+                output[i] = code * scale;
+            }
+            break;
+    }
+}
+
+/// Byte layout of the streams described by a header
+struct PayloadLayout {
+    size_t spectralFlux, energy, chroma, mfcc, end;
+    bool valid;
+};
+
+static PayloadLayout layoutPayload(const FileHeader& header) {
+    PayloadLayout layout{};
+    const uint64_t limit = std::numeric_limits<uint32_t>::max();
+    layout.valid = header.spectralFluxLength <= limit && header.energyLength <= limit &&
+                   header.chromaFrames <= limit && header.chromaDims <= 1024 &&
+                   header.mfccFrames <= limit && header.mfccDims <= 1024 &&
+                   header.storage <= static_cast<uint32_t>(FeatureCache::Storage::Int16);
+    if (!layout.valid) return layout;
+
+    size_t bytes = valueBytes(static_cast<FeatureCache::Storage>(header.storage));
+    layout.spectralFlux = alignedOffset(sizeof(FileHeader));
+    layout.energy = alignedOffset(layout.spectralFlux + header.spectralFluxLength * bytes);
+    layout.chroma = alignedOffset(layout.energy + header.energyLength * bytes);
+    layout.mfcc = alignedOffset(layout.chroma + header.chromaFrames * header.chromaDims * bytes);
+    layout.end = layout.mfcc + header.mfccFrames * header.mfccDims * bytes;
+    return layout;
+}
+
+/// Read-only mapping of a whole file (RAII)
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) return;
+
+        struct stat info;
+        if (::fstat(descriptor, &info) == 0 && info.st_size > 0) {
+            void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapping != MAP_FAILED) {
+                data_ = static_cast<const unsigned char*>(mapping);
+                size_ = static_cast<size_t>(info.st_size);
+            }
+        }
+        ::close(descriptor);
+    }
+
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// MARK: - Lifecycle
+
+FeatureCache::FeatureCache(const std::string& directory, Storage storage)
+    : directory_(directory)
+    , storage_(storage)
+{
+    if (directory_.empty()) {
+        throw std::invalid_argument("Feature cache directory is empty");
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (error || !std::filesystem::is_directory(directory_, error)) {
+        throw std::invalid_argument("Feature cache directory cannot be created: " + directory_);
+    }
+}
+
+// MARK: - Keys
+
+uint64_t FeatureCache::hashContent(const float* samples, size_t length, double sampleRate) {
+    if (!samples) length = 0;
+    return hashBytes(samples, length * sizeof(float), doubleBits(sampleRate));
+}
+
+uint64_t FeatureCache::hashSettings(const AlignmentEngine::Config& config, harmoniq_sync_method_t method) {
+    // Everything prepareFeatures() reads, plus the backend whose kernels computed the values
+    const uint64_t fields[] = {
+        FORMAT_VERSION,
+        static_cast<uint64_t>(method),
+        static_cast<uint64_t>(config.windowSize),
+        static_cast<uint64_t>(config.hopSize),
+        doubleBits(config.analysisSampleRate),
+        config.enableDriftCorrection ? 1u : 0u,
+        static_cast<uint64_t>(config.spectralFlux.medianFilterSize),
+        static_cast<uint64_t>(config.chroma.numChromaBins),
+        config.chroma.useHarmonicWeighting ? 1u : 0u,
+        static_cast<uint64_t>(config.energy.smoothingWindowSize),
+        static_cast<uint64_t>(config.mfcc.numCoeffs),
+        static_cast<uint64_t>(config.mfcc.numMelFilters),
+    };
+
+    const char* backend = DSP::backendName();
+    return hashBytes(backend, std::strlen(backend), hashBytes(fields, sizeof(fields), 0));
+}
+
+// MARK: - Access
+
+std::string FeatureCache::pathFor(const Key& key) const {
+    // Storages are named apart so caches with different storages can share a directory
+    static const char* const suffixes[] = {"", "-bf16", "-i16"};
+    char name[56];
+    std::snprintf(name, sizeof(name), "%016llx-%016llx%s.features",
+                  static_cast<unsigned long long>(key.contentHash),
+                  static_cast<unsigned long long>(key.settingsHash),
+                  suffixes[static_cast<size_t>(storage_)]);
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+bool FeatureCache::load(const Key& key, AlignmentEngine::ClipFeatures& features) const {
+    MappedFile file(pathFor(key));
+    if (!file.data() || file.size() < sizeof(FileHeader)) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    PayloadLayout layout = layoutPayload(header);
+    bool matches = std::memcmp(header.magic, FORMAT_MAGIC, sizeof(FORMAT_MAGIC)) == 0 &&
+                   header.version == FORMAT_VERSION &&
+                   header.storage == static_cast<uint32_t>(storage_) &&
+                   header.contentHash == key.contentHash &&
+                   header.settingsHash == key.settingsHash &&
+                   header.audioLength > 0 &&
+                   layout.valid && layout.end == file.size();
+    if (!matches) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Streams are decoded straight out of the page cache into the aligned feature buffers
+    const unsigned char* bytes = file.data();
+    AlignmentEngine::ClipFeatures loaded;
+    loaded.method = static_cast<harmoniq_sync_method_t>(header.method);
+    loaded.audioLength = static_cast<size_t>(header.audioLength);
+    loaded.sampleRate = header.sampleRate;
+    loaded.hopSize = header.hopSize;
+    loaded.energyHopSize = header.energyHopSize;
+
+    loaded.spectralFlux.resize(header.spectralFluxLength);
+    decodeStream(bytes + layout.spectralFlux, loaded.spectralFlux.size(), storage_, header.scales[0],
+                 loaded.spectralFlux.data());
+    loaded.energy.resize(header.energyLength);
+    decodeStream(bytes + layout.energy, loaded.energy.size(), storage_, header.scales[1], loaded.energy.data());
+
+    loaded.chroma.resize(header.chromaFrames, header.chromaDims);
+    if (!loaded.chroma.empty()) {
+        decodeStream(bytes + layout.chroma, loaded.chroma.size(), storage_, header.scales[2], loaded.chroma.data());
+    }
+    loaded.mfcc.resize(header.mfccFrames, header.mfccDims);
+    if (!loaded.mfcc.empty()) {
+        decodeStream(bytes + layout.mfcc, loaded.mfcc.size(), storage_, header.scales[3], loaded.mfcc.data());
+    }
+
+    features = std::move(loaded);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool FeatureCache::store(const Key& key, const AlignmentEngine::ClipFeatures& features) const {
+    if (features.audioLength == 0) return false;
+
+    FileHeader header{};
+    std::memcpy(header.magic, FORMAT_MAGIC, sizeof(FORMAT_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.method = static_cast<uint32_t>(features.method);
+    header.contentHash = key.contentHash;
+    header.settingsHash = key.settingsHash;
+    header.audioLength = features.audioLength;
+    header.sampleRate = features.sampleRate;
+    header.hopSize = features.hopSize;
+    header.energyHopSize = features.energyHopSize;
+    header.spectralFluxLength = features.spectralFlux.size();
+    header.energyLength = features.energy.size();
+
+    // Empty matrices are stored as 0 x 0 whatever their layout
+    std::vector<float> chroma = features.chroma.toVector();
+    std::vector<float> mfcc = features.mfcc.toVector();
+    header.chromaFrames = chroma.empty() ? 0 : features.chroma.getNumFrames();
+    header.chromaDims = chroma.empty() ? 0 : features.chroma.getNumDims();
+    header.mfccFrames = mfcc.empty() ? 0 : features.mfcc.getNumFrames();
+    header.mfccDims = mfcc.empty() ? 0 : features.mfcc.getNumDims();
+
+    header.storage = static_cast<uint32_t>(storage_);
+    const std::vector<float>* streams[] = {&features.spectralFlux, &features.energy, &chroma, &mfcc};
+    if (storage_ == Storage::Int16) {
+        for (size_t stream = 0; stream < 4; ++stream) {
+            header.scales[stream] = int16Scale(streams[stream]->data(), streams[stream]->size());
+        }
+    }
+
+    PayloadLayout layout = layoutPayload(header);
+    if (!layout.valid) return false;
+
+    std::vector<unsigned char> buffer(layout.end, 0);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    const size_t offsets[] = {layout.spectralFlux, layout.energy, layout.chroma, layout.mfcc};
+    for (size_t stream = 0; stream < 4; ++stream) {
+        encodeStream(streams[stream]->data(), streams[stream]->size(), storage_, header.scales[stream],
+                     buffer.data() + offsets[stream]);
+    }
+
+    // Readers only ever see complete files: write aside, then rename over the target
+    std::string path = pathFor(key);
+    std::string temporary = path + ".tmp" + std::to_string(static_cast<long>(::getpid())) + "-" +
+                            std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        if (!output) {
+            output.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace HarmoniqSync
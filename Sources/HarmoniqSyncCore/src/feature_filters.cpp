@@ -0,0 +1,248 @@
+//
+//  feature_filters.cpp
+//  HarmoniqSyncCore
+//
+//  Sorting-network and running medians, selection-based percentiles
+//  Uses the DSP backend for range normalization
+//
+
+#include "../include/feature_filters.hpp"
+#include "../include/dsp_backend.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Largest window handled by a compare-exchange network
+static const size_t MAX_NETWORK_WINDOW = 7;
+
+// Inputs at least this long are bucketed before selection
+static const size_t HISTOGRAM_MIN_LENGTH = 16384;
+
+// Buckets of the percentile histogram (kept on the stack)
+static const size_t HISTOGRAM_BINS = 1024;
+
+// MARK: - Helpers
+
+static inline void compareExchange(float& a, float& b) {
+    float low = std::min(a, b);
+    b = std::max(a, b);
+    a = low;
+}
+
+// Exact rank selection shared by the float and double percentiles.
+// The bucket index is monotonic in the value, so every value in a lower bucket
+// is smaller than every value in a higher one and only the bucket holding the
+// requested rank has to be selected from.
+template <typename T, typename Transform>
+static T selectRank(const T* values, size_t length, double fraction, std::vector<T>& scratch, Transform transform) {
+    if (!values || length == 0) return T(0);
+
+    double clamped = std::max(0.0, fraction);
+    size_t rank = std::min(length - 1, static_cast<size_t>(length * clamped));
+
+    if (length < HISTOGRAM_MIN_LENGTH) {
+        scratch.resize(length);
+        std::transform(values, values + length, scratch.begin(), transform);
+        std::nth_element(scratch.begin(), scratch.begin() + rank, scratch.end());
+        return scratch[rank];
+    }
+
+    T minValue = transform(values[0]);
+    T maxValue = minValue;
+    for (size_t i = 1; i < length; ++i) {
+        T value = transform(values[i]);
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+    if (!(maxValue > minValue)) return minValue;
+
+    const double scale = HISTOGRAM_BINS / (static_cast<double>(maxValue) - static_cast<double>(minValue));
+    auto bucketOf = [&](T value) {
+        auto bucket = static_cast<size_t>((static_cast<double>(value) - static_cast<double>(minValue)) * scale);
+        return std::min(bucket, HISTOGRAM_BINS - 1);
+    };
+
+    std::array<size_t, HISTOGRAM_BINS> counts{};
+    for (size_t i = 0; i < length; ++i) {
+        ++counts[bucketOf(transform(values[i]))];
+    }
+
+    size_t bucket = 0;
+    size_t below = 0;
+    while (below + counts[bucket] <= rank) {
+        below += counts[bucket];
+        ++bucket;
+    }
+
+    scratch.clear();
+    scratch.reserve(counts[bucket]);
+    for (size_t i = 0; i < length; ++i) {
+        T value = transform(values[i]);
+        if (bucketOf(value) == bucket) {
+            scratch.push_back(value);
+        }
+    }
+
+    size_t rankInBucket = rank - below;
+    std::nth_element(scratch.begin(), scratch.begin() + rankInBucket, scratch.end());
+    return scratch[rankInBucket];
+}
+
+// MARK: - Median Filtering
+
+float FeatureFilters::median3(float* v) {
+    compareExchange(v[0], v[1]);
+    compareExchange(v[1], v[2]);
+    compareExchange(v[0], v[1]);
+    return v[1];
+}
+
+float FeatureFilters::median5(float* v) {
+    compareExchange(v[0], v[1]);
+    compareExchange(v[3], v[4]);
+    compareExchange(v[0], v[3]);
+    compareExchange(v[1], v[4]);
+    compareExchange(v[1], v[2]);
+    compareExchange(v[2], v[3]);
+    compareExchange(v[1], v[2]);
+    return v[2];
+}
+
+float FeatureFilters::median7(float* v) {
+    compareExchange(v[0], v[5]);
+    compareExchange(v[0], v[3]);
+    compareExchange(v[1], v[6]);
+    compareExchange(v[2], v[4]);
+    compareExchange(v[0], v[1]);
+    compareExchange(v[3], v[5]);
+    compareExchange(v[2], v[6]);
+    compareExchange(v[2], v[3]);
+    compareExchange(v[3], v[6]);
+    compareExchange(v[4], v[5]);
+    compareExchange(v[1], v[4]);
+    compareExchange(v[1], v[3]);
+    compareExchange(v[3], v[4]);
+    return v[3];
+}
+
+void FeatureFilters::medianFilter(std::vector<float>& features, int filterSize) {
+    if (features.size() < 3 || filterSize < 3) return;
+
+    const size_t half = static_cast<size_t>(filterSize / 2);
+    const size_t width = 2 * half + 1;
+    const size_t length = features.size();
+    if (length < width) return;
+
+    // Filtering runs in place: the window keeps the original values of the
+    // already-written positions, and positions ahead of i are still original.
+    if (width <= MAX_NETWORK_WINDOW) {
+        std::array<float, MAX_NETWORK_WINDOW> window;
+        std::copy(features.begin(), features.begin() + width, window.begin());
+
+        for (size_t i = half; i + half < length; ++i) {
+            std::array<float, MAX_NETWORK_WINDOW> work = window;
+            float median = width == 3 ? median3(work.data())
+                         : width == 5 ? median5(work.data())
+                                      : median7(work.data());
+
+            std::copy(window.begin() + 1, window.begin() + width, window.begin());
+            if (i + half + 1 < length) {
+                window[width - 1] = features[i + half + 1];
+            }
+            features[i] = median;
+        }
+        return;
+    }
+
+    RunningMedian window(width);
+    for (size_t i = 0; i < width; ++i) {
+        window.push(features[i]);
+    }
+
+    for (size_t i = half; i + half < length; ++i) {
+        float median = window.median();
+        if (i + half + 1 < length) {
+            window.push(features[i + half + 1]);
+        }
+        features[i] = median;
+    }
+}
+
+// MARK: - Running Median
+
+FeatureFilters::RunningMedian::RunningMedian(size_t windowSize)
+    : ring_(std::max<size_t>(1, windowSize)), sorted_(std::max<size_t>(1, windowSize)) {}
+
+void FeatureFilters::RunningMedian::push(float value) {
+    const size_t capacity = ring_.size();
+
+    if (count_ < capacity) {
+        ring_[(head_ + count_) % capacity] = value;
+        auto position = std::upper_bound(sorted_.begin(), sorted_.begin() + count_, value);
+        std::copy_backward(position, sorted_.begin() + count_, sorted_.begin() + count_ + 1);
+        *position = value;
+        ++count_;
+        return;
+    }
+
+    float oldest = ring_[head_];
+    ring_[head_] = value;
+    head_ = (head_ + 1) % capacity;
+
+    // Reuse the slot of the evicted value and slide neighbours until the new one fits
+    size_t slot = static_cast<size_t>(std::lower_bound(sorted_.begin(), sorted_.end(), oldest) - sorted_.begin());
+    while (slot + 1 < count_ && sorted_[slot + 1] < value) {
+        sorted_[slot] = sorted_[slot + 1];
+        ++slot;
+    }
+    while (slot > 0 && sorted_[slot - 1] > value) {
+        sorted_[slot] = sorted_[slot - 1];
+        --slot;
+    }
+    sorted_[slot] = value;
+}
+
+float FeatureFilters::RunningMedian::median() const {
+    return count_ > 0 ? sorted_[count_ / 2] : 0.0f;
+}
+
+void FeatureFilters::RunningMedian::clear() {
+    head_ = 0;
+    count_ = 0;
+}
+
+// MARK: - Percentiles
+
+float FeatureFilters::percentile(const float* values, size_t length, float fraction, std::vector<float>& scratch) {
+    return selectRank(values, length, fraction, scratch, [](float value) { return value; });
+}
+
+double FeatureFilters::percentile(const double* values, size_t length, double fraction, std::vector<double>& scratch) {
+    return selectRank(values, length, fraction, scratch, [](double value) { return value; });
+}
+
+double FeatureFilters::absPercentile(const double* values, size_t length, double fraction, std::vector<double>& scratch) {
+    return selectRank(values, length, fraction, scratch, [](double value) { return std::abs(value); });
+}
+
+// MARK: - Normalization
+
+void FeatureFilters::normalizeRange(std::vector<float>& features) {
+    if (features.empty()) return;
+
+    float minValue = DSP::minimum(features.data(), features.size());
+    float maxValue = DSP::maximum(features.data(), features.size());
+
+    if (maxValue > minValue) {
+        // x * scale + offset == (x - min) / range
+        float scale = 1.0f / (maxValue - minValue);
+        float offset = -minValue * scale;
+        DSP::scaleAdd(features.data(), scale, offset, features.data(), features.size());
+    }
+}
+
+} // namespace HarmoniqSync
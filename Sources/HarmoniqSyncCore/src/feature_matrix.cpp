@@ -0,0 +1,64 @@
+//
+//  feature_matrix.cpp
+//  HarmoniqSyncCore
+//
+//  Aligned frames x dims feature storage
+//
+
+#include "../include/feature_matrix.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace HarmoniqSync {
+
+// MARK: - Lifecycle
+
+FeatureMatrix::FeatureMatrix(size_t numFrames, size_t numDims, size_t stride) {
+    resize(numFrames, numDims, stride);
+}
+
+// MARK: - Shape
+
+void FeatureMatrix::resize(size_t numFrames, size_t numDims, size_t stride) {
+    if (stride == 0) stride = numDims;
+    if (stride < numDims) {
+        throw std::invalid_argument("Feature matrix stride is smaller than its row");
+    }
+
+    numFrames_ = numFrames;
+    numDims_ = numDims;
+    stride_ = stride;
+    values_.resize(numFrames * stride);
+}
+
+float* FeatureMatrix::appendFrames(size_t count) {
+    size_t first = numFrames_;
+    numFrames_ += count;
+
+    // vector growth is geometric, so streaming appends stay amortized O(1) per frame
+    values_.resize(numFrames_ * stride_);
+
+    return row(first);
+}
+
+size_t FeatureMatrix::frameCount(size_t length, size_t windowSize, size_t hopSize) {
+    if (windowSize == 0 || hopSize == 0 || length < windowSize) return 0;
+    return (length - windowSize) / hopSize + 1;
+}
+
+// MARK: - Access
+
+std::vector<float> FeatureMatrix::toVector() const {
+    std::vector<float> values(numFrames_ * numDims_);
+    if (isDense()) {
+        std::copy(values_.begin(), values_.begin() + values.size(), values.begin());
+        return values;
+    }
+
+    for (size_t frame = 0; frame < numFrames_; ++frame) {
+        std::copy(row(frame), row(frame) + numDims_, values.begin() + frame * numDims_);
+    }
+    return values;
+}
+
+} // namespace HarmoniqSync
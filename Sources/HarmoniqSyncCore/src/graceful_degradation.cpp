@@ -6,6 +6,7 @@
 //
 
 #include "../include/graceful_degradation.hpp"
+#include "../include/cost_model.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -94,23 +95,20 @@ DegradationResult GracefulDegradation::recommendDegradation(
     result.levelApplied = DegradationLevel::None;
     result.modifiedConfig = config;
     
-    // Estimate resource requirements
-    size_t estimatedMemory = InputValidator::estimateMemoryUsage(
-        static_cast<size_t>(referenceAudio.sampleCount),
-        static_cast<size_t>(targetAudio.sampleCount),
-        config
-    );
-    
-    double estimatedTime = InputValidator::estimateProcessingTime(
-        std::max(referenceAudio.sampleCount, targetAudio.sampleCount),
-        referenceAudio.sampleRate,
-        HARMONIQ_SYNC_SPECTRAL_FLUX, // Default method for estimation
-        config
-    );
+    // Admit the job on the calibrated cost model of this machine
+    const size_t refSamples = static_cast<size_t>(referenceAudio.sampleCount);
+    const size_t targetSamples = static_cast<size_t>(targetAudio.sampleCount);
+    const double sampleRate = referenceAudio.sampleRate;
+    auto model = CostModel::shared();
+    auto admit = [&](const harmoniq_sync_config_t& candidate) {
+        auto job = CostModel::Job::fromConfig(candidate, HARMONIQ_SYNC_SPECTRAL_FLUX, refSamples, targetSamples, sampleRate);
+        return model->admit(job, maxProcessingTime, availableMemory);
+    };
+    auto admission = admit(config);
     
     // Check if degradation is needed
-    bool memoryPressure = (estimatedMemory > availableMemory * 0.8);
-    bool timePressure = (estimatedTime > maxProcessingTime * 0.8);
+    bool memoryPressure = !admission.fitsMemory;
+    bool timePressure = !admission.meetsDeadline;
     
     if (!memoryPressure && !timePressure) {
         result.description = "No degradation needed - resources sufficient for full quality processing";
@@ -122,37 +120,44 @@ DegradationResult GracefulDegradation::recommendDegradation(
         result.strategyUsed = DegradationStrategy::Progressive;
         result.levelApplied = DegradationLevel::Moderate;
         result.modifiedConfig = AdaptiveParameterAdjuster::adjustForMemoryConstraints(
-            config, availableMemory, static_cast<size_t>(referenceAudio.sampleCount)
+            config, availableMemory, refSamples
         );
         result.modifiedConfig = AdaptiveParameterAdjuster::adjustForTimeConstraints(
-            result.modifiedConfig, maxProcessingTime, estimatedTime
+            result.modifiedConfig, HARMONIQ_SYNC_SPECTRAL_FLUX, refSamples, targetSamples, sampleRate, maxProcessingTime
         );
         result.description = "Applied memory and time optimizations";
-        result.processingSpeedup = 2.0;
         result.expectedConfidenceImpact = 15.0;
         result.expectedAccuracyImpact = 10.0;
     } else if (memoryPressure) {
         result.strategyUsed = DegradationStrategy::ReducePrecision;
         result.levelApplied = DegradationLevel::Minimal;
         result.modifiedConfig = AdaptiveParameterAdjuster::adjustForMemoryConstraints(
-            config, availableMemory, static_cast<size_t>(referenceAudio.sampleCount)
+            config, availableMemory, refSamples
         );
         result.description = "Applied memory optimizations";
-        result.processingSpeedup = 1.3;
         result.expectedConfidenceImpact = 8.0;
         result.expectedAccuracyImpact = 5.0;
     } else if (timePressure) {
         result.strategyUsed = DegradationStrategy::ReduceQuality;
         result.levelApplied = DegradationLevel::Minimal;
         result.modifiedConfig = AdaptiveParameterAdjuster::adjustForTimeConstraints(
-            config, maxProcessingTime, estimatedTime
+            config, HARMONIQ_SYNC_SPECTRAL_FLUX, refSamples, targetSamples, sampleRate, maxProcessingTime
         );
         result.description = "Applied time optimizations";
-        result.processingSpeedup = 1.5;
         result.expectedConfidenceImpact = 10.0;
         result.expectedAccuracyImpact = 8.0;
     }
     
+    // Speedup and the remaining shortfall come from the same predictions
+    auto degraded = admit(result.modifiedConfig);
+    if (degraded.prediction.seconds > 0.0) {
+        result.processingSpeedup = admission.prediction.seconds / degraded.prediction.seconds;
+    }
+    if (!degraded.admitted) {
+        result.canRecover = false;
+        result.description += " - predicted cost still exceeds the available resources";
+    }
+    
     return result;
 }
 
@@ -205,6 +210,7 @@ DegradationResult GracefulDegradation::applyReduceQuality(
         case DegradationLevel::Moderate:
             result.modifiedConfig.window_size = 512;
             result.modifiedConfig.hop_size = 128;
+            result.modifiedConfig.coarse_hop_size = 2048;
             result.modifiedConfig.confidence_threshold = std::max(0.5, result.modifiedConfig.confidence_threshold - 0.1);
             result.expectedConfidenceImpact = 15.0;
             result.expectedAccuracyImpact = 10.0;
@@ -214,6 +220,8 @@ DegradationResult GracefulDegradation::applyReduceQuality(
         case DegradationLevel::Significant:
             result.modifiedConfig.window_size = 256;
             result.modifiedConfig.hop_size = 64;
+            result.modifiedConfig.coarse_hop_size = 4096;
+            result.modifiedConfig.analysis_sample_rate = 16000.0;
             result.modifiedConfig.confidence_threshold = std::max(0.4, result.modifiedConfig.confidence_threshold - 0.2);
             result.expectedConfidenceImpact = 25.0;
             result.expectedAccuracyImpact = 20.0;
@@ -223,6 +231,8 @@ DegradationResult GracefulDegradation::applyReduceQuality(
         case DegradationLevel::Emergency:
             result.modifiedConfig.window_size = 256;
             result.modifiedConfig.hop_size = 128;
+            result.modifiedConfig.coarse_hop_size = 8192;
+            result.modifiedConfig.analysis_sample_rate = 8000.0;
             result.modifiedConfig.confidence_threshold = 0.3;
             result.expectedConfidenceImpact = 40.0;
             result.expectedAccuracyImpact = 35.0;
@@ -274,27 +284,26 @@ DegradationResult GracefulDegradation::applyReducePrecision(
     result.strategyUsed = DegradationStrategy::ReducePrecision;
     result.modifiedConfig = context.originalConfig;
     
-    // Reduce precision by simplifying algorithms
+    // Every level correlates in single precision; stronger levels also coarsen the hop
+    result.modifiedConfig.correlation_precision = 1;
     switch (level) {
         case DegradationLevel::Minimal:
-            result.modifiedConfig.hop_size = std::max(result.modifiedConfig.hop_size, 
-                                                     result.modifiedConfig.window_size / 2);
-            result.processingSpeedup = 1.8;
-            result.expectedAccuracyImpact = 5.0;
+            result.processingSpeedup = 1.3;
+            result.expectedAccuracyImpact = 1.0;
             break;
             
         case DegradationLevel::Moderate:
-            result.modifiedConfig.hop_size = result.modifiedConfig.window_size / 2;
-            result.modifiedConfig.confidence_threshold = std::max(0.5, result.modifiedConfig.confidence_threshold - 0.05);
-            result.processingSpeedup = 2.5;
-            result.expectedAccuracyImpact = 12.0;
+            result.modifiedConfig.hop_size = std::max(result.modifiedConfig.hop_size, 
+                                                     result.modifiedConfig.window_size / 2);
+            result.processingSpeedup = 2.2;
+            result.expectedAccuracyImpact = 6.0;
             break;
             
         case DegradationLevel::Significant:
-            result.modifiedConfig.hop_size = result.modifiedConfig.window_size;
-            result.modifiedConfig.confidence_threshold = 0.4;
-            result.processingSpeedup = 4.0;
-            result.expectedAccuracyImpact = 25.0;
+            result.modifiedConfig.hop_size = result.modifiedConfig.window_size / 2;
+            result.modifiedConfig.confidence_threshold = std::max(0.5, result.modifiedConfig.confidence_threshold - 0.05);
+            result.processingSpeedup = 3.0;
+            result.expectedAccuracyImpact = 13.0;
             break;
             
         default:
@@ -407,6 +416,12 @@ harmoniq_sync_config_t AdaptiveParameterAdjuster::adjustForMemoryConstraints(
         // Aggressive reduction
         adjusted.window_size = std::max(256, adjusted.window_size / 4);
         adjusted.hop_size = adjusted.window_size / 2;
+        
+        // Stream long correlations within a quarter of what is available
+        int budgetMb = static_cast<int>(std::max<size_t>(1, (availableMemory / 4) >> 20));
+        if (adjusted.correlation_memory_mb == 0 || adjusted.correlation_memory_mb > budgetMb) {
+            adjusted.correlation_memory_mb = budgetMb;
+        }
     } else if (memoryPressure > 0.6) {
         // Moderate reduction
         adjusted.window_size = std::max(512, adjusted.window_size / 2);
@@ -437,6 +452,53 @@ harmoniq_sync_config_t AdaptiveParameterAdjuster::adjustForTimeConstraints(
     return adjusted;
 }
 
+harmoniq_sync_config_t AdaptiveParameterAdjuster::adjustForTimeConstraints(
+    const harmoniq_sync_config_t& baseConfig,
+    harmoniq_sync_method_t method,
+    size_t refSampleCount,
+    size_t targetSampleCount,
+    double sampleRate,
+    double maxProcessingTime,
+    double confidence
+) {
+    auto model = CostModel::shared();
+    auto fits = [&](const harmoniq_sync_config_t& candidate) {
+        auto job = CostModel::Job::fromConfig(candidate, method, refSampleCount, targetSampleCount, sampleRate);
+        return model->predict(job, confidence).upperSeconds <= maxProcessingTime;
+    };
+    
+    harmoniq_sync_config_t adjusted = baseConfig;
+    if (fits(adjusted)) return adjusted;
+    
+    // Longer hop: fewer frames for every stage after loading
+    int hop = adjusted.hop_size > 0 ? adjusted.hop_size : std::max(1, adjusted.window_size / 4);
+    adjusted.hop_size = std::max(hop, adjusted.window_size / 2);
+    if (fits(adjusted)) return adjusted;
+    
+    // Coarse-to-fine search: full lag range on envelopes decimated 8x
+    if (adjusted.coarse_hop_size <= 0) {
+        adjusted.coarse_hop_size = adjusted.hop_size * 8;
+        if (fits(adjusted)) return adjusted;
+    }
+    
+    // Analyse at a lower rate (onsets and chroma survive 11 kHz)
+    double analysisRate = adjusted.analysis_sample_rate > 0.0 ? adjusted.analysis_sample_rate : sampleRate;
+    if (analysisRate > 11025.0) {
+        adjusted.analysis_sample_rate = 11025.0;
+        if (fits(adjusted)) return adjusted;
+    }
+    
+    // Shorter window, as far as frequency resolution allows
+    while (adjusted.window_size > 512) {
+        adjusted.window_size /= 2;
+        adjusted.hop_size = adjusted.window_size / 2;
+        if (adjusted.coarse_hop_size > 0) adjusted.coarse_hop_size = adjusted.hop_size * 8;
+        if (fits(adjusted)) return adjusted;
+    }
+    
+    return adjusted;
+}
+
 double AdaptiveParameterAdjuster::estimateQualityImpact(
     const harmoniq_sync_config_t& original,
     const harmoniq_sync_config_t& adjusted
@@ -546,4 +608,20 @@ std::vector<harmoniq_sync_method_t> FallbackMethodSelector::getCompatibleMethods
     return compatible;
 }
 
-} // namespace HarmoniqSync
\ No newline at end of file
+// MARK: - ResourceAwareProcessor Implementation
+
+ResourceAwareProcessor::ResourceMonitor ResourceAwareProcessor::estimateResourceRequirements(
+    const harmoniq_sync_config_t& config,
+    size_t audioLength,
+    harmoniq_sync_method_t method
+) {
+    auto job = CostModel::Job::fromConfig(config, method, audioLength, audioLength, 44100.0);
+    auto prediction = CostModel::shared()->predict(job);
+    
+    ResourceMonitor monitor;
+    monitor.peakMemoryUsage = prediction.peakBytes;
+    monitor.processingTime = prediction.seconds;
+    return monitor;
+}
+
+} // namespace HarmoniqSync
@@ -6,6 +6,7 @@
 //
 
 #include "../include/input_validator.hpp"
+#include "../include/cost_model.hpp"
 #include <cmath>
 #include <algorithm>
 #include <numeric>
@@ -13,6 +14,10 @@
 
 namespace HarmoniqSync {
 
+// MARK: - Constants
+
+static const double CONSTANT_SIGNAL_DEVIATION = 0.001; // Standard deviation below which a clip counts as constant
+
 // Static member definitions
 InputValidator::ValidationLimits InputValidator::validationLimits_;
 
@@ -29,75 +34,12 @@ ErrorContext InputValidator::validateAudioFormat(
     scope.addMetadata("sample_count", std::to_string(sampleCount));
     scope.addMetadata("sample_rate", std::to_string(sampleRate));
     
-    // Check null pointer
-    if (!audioData) {
-        return ErrorHandler::createError(
-            HARMONIQ_SYNC_ERROR_INVALID_INPUT,
-            "Audio data pointer is null",
-            "InputValidator",
-            __FUNCTION__,
-            "Provide valid audio data pointer"
-        );
-    }
-    
-    // Check sample count
-    if (sampleCount < validationLimits_.minSampleCount) {
-        std::ostringstream oss;
-        oss << audioName << " has insufficient samples (" << sampleCount 
-            << " < " << validationLimits_.minSampleCount << ")";
-        return ErrorHandler::createError(
-            HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA,
-            oss.str(),
-            "InputValidator",
-            __FUNCTION__,
-            "Provide audio with at least " + std::to_string(validationLimits_.minSampleCount) + " samples"
-        );
-    }
-    
-    if (sampleCount > validationLimits_.maxSampleCount) {
-        std::ostringstream oss;
-        oss << audioName << " has too many samples (" << sampleCount 
-            << " > " << validationLimits_.maxSampleCount << ")";
-        return ErrorHandler::createError(
-            HARMONIQ_SYNC_ERROR_INVALID_INPUT,
-            oss.str(),
-            "InputValidator",
-            __FUNCTION__,
-            "Reduce audio length or increase processing limits"
-        );
-    }
-    
-    // Check sample rate
-    if (sampleRate < validationLimits_.minSampleRate || sampleRate > validationLimits_.maxSampleRate) {
-        std::ostringstream oss;
-        oss << audioName << " sample rate (" << sampleRate 
-            << " Hz) is outside supported range [" << validationLimits_.minSampleRate 
-            << ", " << validationLimits_.maxSampleRate << "]";
-        return ErrorHandler::createError(
-            HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT,
-            oss.str(),
-            "InputValidator",
-            __FUNCTION__,
-            "Resample audio to supported sample rate (44.1kHz or 48kHz recommended)"
-        );
-    }
-    
-    // Check for NaN or infinite values
-    for (size_t i = 0; i < sampleCount; ++i) {
-        if (!std::isfinite(audioData[i])) {
-            std::ostringstream oss;
-            oss << audioName << " contains invalid values (NaN/Inf) at sample " << i;
-            return ErrorHandler::createError(
-                HARMONIQ_SYNC_ERROR_INVALID_INPUT,
-                oss.str(),
-                "InputValidator",
-                __FUNCTION__,
-                "Clean audio data to remove NaN/Inf values"
-            );
-        }
+    auto parameterError = validateAudioParameters(audioData, sampleCount, sampleRate, audioName);
+    if (parameterError.code != HARMONIQ_SYNC_SUCCESS) {
+        return parameterError;
     }
     
-    return ErrorHandler::createError(HARMONIQ_SYNC_SUCCESS, "Audio format validation passed");
+    return validateSamples(measureAudio(audioData, sampleCount), audioName);
 }
 
 AudioQualityReport InputValidator::analyzeAudioQuality(
@@ -105,32 +47,61 @@ AudioQualityReport InputValidator::analyzeAudioQuality(
     size_t sampleCount,
     double sampleRate,
     const std::string& audioName
+) {
+    return analyzeAudioQuality(measureAudio(audioData, sampleCount), sampleRate, audioName);
+}
+
+AudioQualityReport InputValidator::analyzeAudioQuality(
+    const AudioProcessor& audio,
+    const std::string& audioName
+) {
+    // The loader measured at the default thresholds; other limits need a pass of their own
+    const AudioStatistics& loaded = audio.getStatistics();
+    AudioStatistics configured = measureAudio(nullptr, 0); // Empty, but carries the configured thresholds
+    if (loaded.silenceThreshold == configured.silenceThreshold &&
+        loaded.clippingThreshold == configured.clippingThreshold) {
+        return analyzeAudioQuality(loaded, audio.getSampleRate(), audioName, audio.getCachedSpectrogram());
+    }
+    
+    SampleSpan samples = audio.getAudioData();
+    return analyzeAudioQuality(measureAudio(samples.data(), samples.size()), audio.getSampleRate(),
+                               audioName, audio.getCachedSpectrogram());
+}
+
+AudioQualityReport InputValidator::analyzeAudioQuality(
+    const AudioStatistics& statistics,
+    double sampleRate,
+    const std::string& audioName,
+    const Spectrogram* spectrogram
 ) {
     ErrorScope scope("analyzeAudioQuality");
     scope.addMetadata("audio_name", audioName);
     
     AudioQualityReport report;
     report.sampleRate = sampleRate;
-    report.sampleCount = sampleCount;
-    report.durationSeconds = static_cast<double>(sampleCount) / sampleRate;
+    report.sampleCount = statistics.sampleCount;
+    report.durationSeconds = static_cast<double>(statistics.sampleCount) / sampleRate;
     
-    // Calculate basic audio metrics
-    report.rmsLevel = calculateRMSLevel(audioData, sampleCount);
-    report.peakLevel = calculatePeakLevel(audioData, sampleCount);
+    // Basic audio metrics
+    report.rmsLevel = statistics.rms();
+    report.peakLevel = statistics.peak;
     report.dynamicRange = 20.0 * std::log10(report.peakLevel / (report.rmsLevel + 1e-10));
-    report.silenceRatio = calculateSilenceRatio(audioData, sampleCount, validationLimits_.silenceThreshold);
-    report.clippingRatio = calculateClippingRatio(audioData, sampleCount);
-    
-    // Calculate spectral characteristics
-    report.spectralCentroid = calculateSpectralCentroid(audioData, sampleCount);
+    report.silenceRatio = statistics.silenceRatio();
+    report.clippingRatio = statistics.clippingRatio();
+    
+    // Spectral characteristics; a pure tone of f Hz crosses zero 2f times a second
+    report.zeroCrossingRate = statistics.zeroCrossingRate();
+    report.spectralCentroid = (spectrogram && !spectrogram->empty())
+        ? AudioStatistics::spectralCentroid(*spectrogram)
+        : report.zeroCrossingRate * sampleRate / 2.0;
     report.spectralRolloff = report.spectralCentroid * 1.5; // Approximation
-    report.zeroCrossingRate = calculateZeroCrossingRate(audioData, sampleCount);
     
     // Determine quality indicators
     report.hasSufficientContent = (report.silenceRatio < validationLimits_.maxSilenceRatio);
     report.hasExcessiveClipping = (report.clippingRatio > validationLimits_.maxClippingRatio);
     report.hasGoodDynamicRange = (report.dynamicRange >= validationLimits_.minDynamicRange);
-    report.isMonotonic = isMonotonic(audioData, sampleCount);
+    report.isMonotonic = statistics.sampleCount < 2 ||
+                         statistics.variance() < CONSTANT_SIGNAL_DEVIATION * CONSTANT_SIGNAL_DEVIATION;
     
     // Generate warnings and recommendations
     report.warnings = generateWarnings(report);
@@ -399,96 +370,89 @@ harmoniq_sync_config_t InputValidator::optimizeConfiguration(
 
 // MARK: - Internal Analysis Functions
 
-double InputValidator::calculateRMSLevel(const float* audioData, size_t sampleCount) {
-    if (sampleCount == 0) return 0.0;
-    
-    double sum = 0.0;
-    for (size_t i = 0; i < sampleCount; ++i) {
-        sum += audioData[i] * audioData[i];
-    }
-    return std::sqrt(sum / sampleCount);
+AudioStatistics InputValidator::measureAudio(const float* audioData, size_t sampleCount) {
+    float silenceThreshold = static_cast<float>(std::pow(10.0, validationLimits_.silenceThreshold / 20.0));
+    return AudioStatistics::measure(audioData, sampleCount, silenceThreshold,
+                                    static_cast<float>(validationLimits_.clippingLevel));
 }
 
-double InputValidator::calculatePeakLevel(const float* audioData, size_t sampleCount) {
-    if (sampleCount == 0) return 0.0;
-    
-    double peak = 0.0;
-    for (size_t i = 0; i < sampleCount; ++i) {
-        peak = std::max(peak, std::abs(static_cast<double>(audioData[i])));
-    }
-    return peak;
-}
-
-double InputValidator::calculateSilenceRatio(
+ErrorContext InputValidator::validateAudioParameters(
     const float* audioData,
     size_t sampleCount,
-    double silenceThreshold
+    double sampleRate,
+    const std::string& audioName
 ) {
-    if (sampleCount == 0) return 1.0;
-    
-    double linearThreshold = std::pow(10.0, silenceThreshold / 20.0);
-    size_t silentSamples = 0;
-    
-    for (size_t i = 0; i < sampleCount; ++i) {
-        if (std::abs(audioData[i]) < linearThreshold) {
-            silentSamples++;
-        }
+    // Check null pointer
+    if (!audioData) {
+        return ErrorHandler::createError(
+            HARMONIQ_SYNC_ERROR_INVALID_INPUT,
+            "Audio data pointer is null",
+            "InputValidator",
+            __FUNCTION__,
+            "Provide valid audio data pointer"
+        );
     }
     
-    return static_cast<double>(silentSamples) / sampleCount;
-}
-
-double InputValidator::calculateClippingRatio(
-    const float* audioData,
-    size_t sampleCount,
-    double clippingThreshold
-) {
-    if (sampleCount == 0) return 0.0;
-    
-    size_t clippedSamples = 0;
-    
-    for (size_t i = 0; i < sampleCount; ++i) {
-        if (std::abs(audioData[i]) >= clippingThreshold) {
-            clippedSamples++;
-        }
+    // Check sample count
+    if (sampleCount < validationLimits_.minSampleCount) {
+        std::ostringstream oss;
+        oss << audioName << " has insufficient samples (" << sampleCount 
+            << " < " << validationLimits_.minSampleCount << ")";
+        return ErrorHandler::createError(
+            HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA,
+            oss.str(),
+            "InputValidator",
+            __FUNCTION__,
+            "Provide audio with at least " + std::to_string(validationLimits_.minSampleCount) + " samples"
+        );
     }
     
-    return static_cast<double>(clippedSamples) / sampleCount;
-}
-
-double InputValidator::calculateZeroCrossingRate(const float* audioData, size_t sampleCount) {
-    if (sampleCount < 2) return 0.0;
+    if (sampleCount > validationLimits_.maxSampleCount) {
+        std::ostringstream oss;
+        oss << audioName << " has too many samples (" << sampleCount 
+            << " > " << validationLimits_.maxSampleCount << ")";
+        return ErrorHandler::createError(
+            HARMONIQ_SYNC_ERROR_INVALID_INPUT,
+            oss.str(),
+            "InputValidator",
+            __FUNCTION__,
+            "Reduce audio length or increase processing limits"
+        );
+    }
     
-    size_t crossings = 0;
-    for (size_t i = 1; i < sampleCount; ++i) {
-        if ((audioData[i] >= 0.0) != (audioData[i-1] >= 0.0)) {
-            crossings++;
-        }
+    // Check sample rate
+    if (sampleRate < validationLimits_.minSampleRate || sampleRate > validationLimits_.maxSampleRate) {
+        std::ostringstream oss;
+        oss << audioName << " sample rate (" << sampleRate 
+            << " Hz) is outside supported range [" << validationLimits_.minSampleRate 
+            << ", " << validationLimits_.maxSampleRate << "]";
+        return ErrorHandler::createError(
+            HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT,
+            oss.str(),
+            "InputValidator",
+            __FUNCTION__,
+            "Resample audio to supported sample rate (44.1kHz or 48kHz recommended)"
+        );
     }
     
-    return static_cast<double>(crossings) / (sampleCount - 1);
+    return ErrorHandler::createError(HARMONIQ_SYNC_SUCCESS, "Audio parameter validation passed");
 }
 
-bool InputValidator::isMonotonic(const float* audioData, size_t sampleCount, double threshold) {
-    if (sampleCount < 2) return true;
-    
-    double variance = 0.0;
-    double mean = 0.0;
-    
-    // Calculate mean
-    for (size_t i = 0; i < sampleCount; ++i) {
-        mean += audioData[i];
-    }
-    mean /= sampleCount;
-    
-    // Calculate variance
-    for (size_t i = 0; i < sampleCount; ++i) {
-        double diff = audioData[i] - mean;
-        variance += diff * diff;
+ErrorContext InputValidator::validateSamples(const AudioStatistics& statistics, const std::string& audioName) {
+    // Check for NaN or infinite values
+    if (!statistics.allFinite()) {
+        std::ostringstream oss;
+        oss << audioName << " contains invalid values (NaN/Inf) at sample " << statistics.firstNonFinite;
+        return ErrorHandler::createError(
+            HARMONIQ_SYNC_ERROR_INVALID_INPUT,
+            oss.str(),
+            "InputValidator",
+            __FUNCTION__,
+            "Clean audio data to remove NaN/Inf values"
+        );
     }
-    variance /= sampleCount;
     
-    return variance < (threshold * threshold);
+    return ErrorHandler::createError(HARMONIQ_SYNC_SUCCESS, "Audio format validation passed");
 }
 
 std::vector<std::string> InputValidator::generateWarnings(const AudioQualityReport& report) {
@@ -552,13 +516,23 @@ ValidationResult InputValidator::validateSyncRequest(
 ) {
     ValidationResult result;
     
-    // Validate basic audio format
-    auto refFormatError = validateAudioFormat(referenceAudio, refSampleCount, sampleRate, "reference");
+    // Validate basic audio format; one fused pass per clip serves the NaN/Inf check and the quality report
+    AudioStatistics refStatistics;
+    auto refFormatError = validateAudioParameters(referenceAudio, refSampleCount, sampleRate, "reference");
+    if (refFormatError.code == HARMONIQ_SYNC_SUCCESS) {
+        refStatistics = measureAudio(referenceAudio, refSampleCount);
+        refFormatError = validateSamples(refStatistics, "reference");
+    }
     if (refFormatError.code != HARMONIQ_SYNC_SUCCESS) {
         result.errors.push_back(refFormatError);
     }
     
-    auto targetFormatError = validateAudioFormat(targetAudio, targetSampleCount, sampleRate, "target");
+    AudioStatistics targetStatistics;
+    auto targetFormatError = validateAudioParameters(targetAudio, targetSampleCount, sampleRate, "target");
+    if (targetFormatError.code == HARMONIQ_SYNC_SUCCESS) {
+        targetStatistics = measureAudio(targetAudio, targetSampleCount);
+        targetFormatError = validateSamples(targetStatistics, "target");
+    }
     if (targetFormatError.code != HARMONIQ_SYNC_SUCCESS) {
         result.errors.push_back(targetFormatError);
     }
@@ -569,8 +543,8 @@ ValidationResult InputValidator::validateSyncRequest(
     }
     
     // Analyze audio quality
-    result.referenceAudio = analyzeAudioQuality(referenceAudio, refSampleCount, sampleRate, "reference");
-    result.targetAudio = analyzeAudioQuality(targetAudio, targetSampleCount, sampleRate, "target");
+    result.referenceAudio = analyzeAudioQuality(refStatistics, sampleRate, "reference");
+    result.targetAudio = analyzeAudioQuality(targetStatistics, sampleRate, "target");
     
     // Check audio compatibility
     auto compatError = validateAudioCompatibility(result.referenceAudio, result.targetAudio);
@@ -655,24 +629,11 @@ double InputValidator::estimateProcessingTime(
     harmoniq_sync_method_t method,
     const harmoniq_sync_config_t& config
 ) {
-    double durationSeconds = audioLengthSamples / sampleRate;
-    double baseMultiplier = 0.1; // Base 10% of audio duration
+    if (sampleRate <= 0.0) return 0.0;
     
-    // Method-specific multipliers
-    switch (method) {
-        case HARMONIQ_SYNC_SPECTRAL_FLUX: baseMultiplier = 0.08; break;
-        case HARMONIQ_SYNC_CHROMA: baseMultiplier = 0.12; break;
-        case HARMONIQ_SYNC_ENERGY: baseMultiplier = 0.04; break;
-        case HARMONIQ_SYNC_MFCC: baseMultiplier = 0.18; break;
-        case HARMONIQ_SYNC_HYBRID: baseMultiplier = 0.35; break;
-    }
-    
-    // Configuration adjustments
-    double configMultiplier = 1.0;
-    if (config.window_size > 2048) configMultiplier *= 1.5;
-    if (config.hop_size < config.window_size / 8) configMultiplier *= 1.2;
-    
-    return durationSeconds * baseMultiplier * configMultiplier;
+    // Both clips of the estimated length, on the calibrated profile of this machine
+    auto job = CostModel::Job::fromConfig(config, method, audioLengthSamples, audioLengthSamples, sampleRate);
+    return CostModel::shared()->predict(job).seconds;
 }
 
 size_t InputValidator::estimateMemoryUsage(
@@ -680,12 +641,10 @@ size_t InputValidator::estimateMemoryUsage(
     size_t targetSampleCount,
     const harmoniq_sync_config_t& config
 ) {
-    size_t totalSamples = refSampleCount + targetSampleCount;
-    size_t workingMemory = totalSamples * sizeof(float) * 2; // Input + working buffers
-    size_t fftMemory = config.window_size * sizeof(float) * 4; // FFT buffers
-    size_t correlationMemory = (refSampleCount + targetSampleCount) * sizeof(double); // Correlation buffer
-    
-    return workingMemory + fftMemory + correlationMemory;
+    // Hybrid holds every feature matrix, so it bounds the memory of all methods;
+    // without a sample rate decimation is assumed to start from 44.1 kHz
+    auto job = CostModel::Job::fromConfig(config, HARMONIQ_SYNC_HYBRID, refSampleCount, targetSampleCount, 44100.0);
+    return CostModel::shared()->predict(job).peakBytes;
 }
 
 void InputValidator::setValidationLimits(const ValidationLimits& limits) {
@@ -0,0 +1,209 @@
+//
+//  landmark_index.cpp
+//  HarmoniqSyncCore
+//
+//  Onset-pair fingerprints and an inverted index for offset voting
+//
+
+#include "../include/landmark_index.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Hash layout: first band (5 bits), second band (5 bits), frame distance (10 bits)
+static const int BAND_BITS = 5;
+static const int DISTANCE_BITS = 10;
+static const int MAX_BANDS = 1 << BAND_BITS;
+static const int MAX_PAIR_FRAMES = (1 << DISTANCE_BITS) - 1;
+
+// Band analysis window: ~46 ms, rounded up to a power of two
+static const double BAND_WINDOW_SECONDS = 0.046;
+static const size_t MIN_BAND_WINDOW = 64;
+static const size_t MAX_BAND_WINDOW = 8192;
+
+// Offsets are stored next to their clip id in one sortable 64-bit key
+static const int64_t OFFSET_BIAS = int64_t(1) << 31;
+
+// MARK: - Helpers
+
+static uint32_t landmarkHash(int firstBand, int secondBand, int distance) {
+    return (static_cast<uint32_t>(firstBand) << (BAND_BITS + DISTANCE_BITS))
+         | (static_cast<uint32_t>(secondBand) << DISTANCE_BITS)
+         | static_cast<uint32_t>(distance);
+}
+
+static void validateSettings(const LandmarkIndex::Settings& settings) {
+    if (settings.fanOut == 0 || settings.maxPairFrames < 1 || settings.maxPairFrames > MAX_PAIR_FRAMES ||
+        settings.numBands < 1 || settings.numBands > MAX_BANDS ||
+        !(settings.minFrequency > 0.0) || !(settings.maxFrequency > settings.minFrequency)) {
+        throw std::invalid_argument("Invalid landmark settings");
+    }
+}
+
+// MARK: - Fingerprints
+
+std::vector<LandmarkIndex::Landmark> LandmarkIndex::extractLandmarks(const std::vector<size_t>& onsets,
+                                                                     const AudioProcessor& audio,
+                                                                     int hopSize,
+                                                                     const Settings& settings) {
+    validateSettings(settings);
+
+    std::vector<Landmark> landmarks;
+    const auto samples = audio.getAudioData();
+    const double sampleRate = audio.getSampleRate();
+    if (onsets.size() < 2 || hopSize <= 0 || !(sampleRate > 0.0)) return landmarks;
+
+    size_t window = MIN_BAND_WINDOW;
+    while (window < MAX_BAND_WINDOW && window < BAND_WINDOW_SECONDS * sampleRate) window *= 2;
+    if (samples.size() < window) return landmarks;
+
+    // Bin k of the window belongs to band floor(numBands * log(f / min) / log(max / min))
+    const double maxFrequency = std::min(settings.maxFrequency, sampleRate / 2.0);
+    if (!(maxFrequency > settings.minFrequency)) return landmarks;
+
+    const double binHz = sampleRate / static_cast<double>(window);
+    const double bandsPerLog = settings.numBands / std::log(maxFrequency / settings.minFrequency);
+    std::vector<int> binBand(window / 2, -1);
+    for (size_t bin = 1; bin < binBand.size(); ++bin) {
+        double frequency = bin * binHz;
+        if (frequency >= settings.minFrequency && frequency < maxFrequency) {
+            int band = static_cast<int>(std::log(frequency / settings.minFrequency) * bandsPerLog);
+            binBand[bin] = std::min(band, settings.numBands - 1);
+        }
+    }
+
+    // Dominant band at every onset
+    std::vector<int> onsetBand(onsets.size(), 0);
+    std::vector<float> power;
+    std::vector<double> bandEnergy(static_cast<size_t>(settings.numBands));
+    for (size_t i = 0; i < onsets.size(); ++i) {
+        size_t start = std::min(onsets[i] * static_cast<size_t>(hopSize), samples.size() - window);
+        audio.computePowerSpectrum(samples.data() + start, window, power);
+
+        std::fill(bandEnergy.begin(), bandEnergy.end(), 0.0);
+        for (size_t bin = 0; bin < binBand.size(); ++bin) {
+            if (binBand[bin] >= 0) bandEnergy[static_cast<size_t>(binBand[bin])] += power[bin];
+        }
+        onsetBand[i] = static_cast<int>(std::distance(bandEnergy.begin(),
+                                                      std::max_element(bandEnergy.begin(), bandEnergy.end())));
+    }
+
+    // Pair each onset with the next fanOut onsets close enough to share a hash
+    landmarks.reserve(onsets.size() * settings.fanOut);
+    for (size_t i = 0; i < onsets.size(); ++i) {
+        size_t last = std::min(onsets.size(), i + 1 + settings.fanOut);
+        for (size_t j = i + 1; j < last; ++j) {
+            size_t distance = onsets[j] - onsets[i];
+            if (distance > static_cast<size_t>(settings.maxPairFrames)) break;
+            if (distance == 0) continue;
+            landmarks.push_back({landmarkHash(onsetBand[i], onsetBand[j], static_cast<int>(distance)),
+                                 static_cast<uint32_t>(onsets[i])});
+        }
+    }
+    return landmarks;
+}
+
+// MARK: - Lifecycle
+
+LandmarkIndex::LandmarkIndex(const std::vector<std::vector<Landmark>>& clips, const Settings& settings)
+    : settings_(settings)
+{
+    validateSettings(settings_);
+
+    size_t total = 0;
+    for (const auto& clip : clips) total += clip.size();
+    postings_.reserve(total);
+    clipLandmarks_.reserve(clips.size());
+
+    for (size_t clip = 0; clip < clips.size(); ++clip) {
+        for (const auto& landmark : clips[clip]) {
+            postings_.push_back({landmark.hash, static_cast<uint32_t>(clip), landmark.frame});
+        }
+        clipLandmarks_.push_back(clips[clip].size());
+    }
+
+    std::sort(postings_.begin(), postings_.end(), [](const Posting& a, const Posting& b) {
+        return std::tie(a.hash, a.clip, a.frame) < std::tie(b.hash, b.clip, b.frame);
+    });
+}
+
+// MARK: - Query
+
+std::vector<LandmarkIndex::Match> LandmarkIndex::query(const std::vector<Landmark>& landmarks, size_t maxMatches,
+                                                       int toleranceFrames, size_t minVotes) const {
+    std::vector<Match> matches;
+    if (maxMatches == 0 || landmarks.empty() || postings_.empty()) return matches;
+
+    // One vote per shared hash occurrence for the offset it implies
+    std::vector<uint64_t> votes;
+    auto byHash = [](const Posting& posting, uint32_t hash) { return posting.hash < hash; };
+    for (const auto& landmark : landmarks) {
+        auto first = std::lower_bound(postings_.begin(), postings_.end(), landmark.hash, byHash);
+        auto last = first;
+        while (last != postings_.end() && last->hash == landmark.hash) ++last;
+        if (static_cast<size_t>(last - first) > settings_.maxPostings) continue;
+
+        for (auto posting = first; posting != last; ++posting) {
+            int64_t offset = static_cast<int64_t>(landmark.frame) - static_cast<int64_t>(posting->frame);
+            votes.push_back((static_cast<uint64_t>(posting->clip) << 32) | static_cast<uint64_t>(offset + OFFSET_BIAS));
+        }
+    }
+    std::sort(votes.begin(), votes.end());
+
+    // Distinct (clip, offset) pairs with their vote counts, in key order
+    struct Bin {
+        size_t clip;
+        int64_t offset;
+        size_t count;
+    };
+    std::vector<Bin> bins;
+    for (size_t i = 0; i < votes.size();) {
+        size_t j = i;
+        while (j < votes.size() && votes[j] == votes[i]) ++j;
+        bins.push_back({static_cast<size_t>(votes[i] >> 32),
+                        static_cast<int64_t>(votes[i] & 0xFFFFFFFFu) - OFFSET_BIAS,
+                        j - i});
+        i = j;
+    }
+
+    // Votes within the tolerance of each offset, summed with a sliding window per clip
+    const int64_t tolerance = std::max(0, toleranceFrames);
+    std::vector<Match> candidates;
+    size_t low = 0, high = 0;
+    size_t windowVotes = 0;
+    for (size_t i = 0; i < bins.size(); ++i) {
+        while (high < bins.size() && bins[high].clip == bins[i].clip &&
+               bins[high].offset <= bins[i].offset + tolerance) {
+            windowVotes += bins[high++].count;
+        }
+        while (bins[low].clip != bins[i].clip || bins[low].offset < bins[i].offset - tolerance) {
+            windowVotes -= bins[low++].count;
+        }
+        if (windowVotes >= std::max<size_t>(1, minVotes)) {
+            candidates.push_back({bins[i].clip, bins[i].offset, windowVotes});
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Match& a, const Match& b) {
+        return std::make_tuple(b.votes, a.clip, a.offsetFrames) < std::make_tuple(a.votes, b.clip, b.offsetFrames);
+    });
+
+    // Strongest first; weaker offsets sharing votes with a kept one on the same clip are its shoulders
+    for (const auto& candidate : candidates) {
+        bool separate = std::none_of(matches.begin(), matches.end(), [&](const Match& kept) {
+            return kept.clip == candidate.clip && std::abs(kept.offsetFrames - candidate.offsetFrames) <= 2 * tolerance;
+        });
+        if (separate) {
+            matches.push_back(candidate);
+            if (matches.size() == maxMatches) break;
+        }
+    }
+    return matches;
+}
+
+} // namespace HarmoniqSync
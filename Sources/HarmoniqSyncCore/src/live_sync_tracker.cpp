@@ -0,0 +1,386 @@
+//
+//  live_sync_tracker.cpp
+//  HarmoniqSyncCore
+//
+//  Continuous offset and drift tracking of live feeds with bounded latency
+//
+
+#include "../include/live_sync_tracker.hpp"
+#include "../include/audio_statistics.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Lags closer than this to the peak belong to it when looking for a rival peak
+static const int64_t PEAK_NEIGHBOURHOOD_FRAMES = 4;
+
+// An estimate further than this many hops from the previous one starts a new drift fit
+static const double DRIFT_JUMP_HOPS = 2.0;
+
+static const int MAX_WINDOW_SIZE = 16384;
+
+// Published index in bits 0-1, unread flag in bit 2
+static const uint8_t SLOT_MASK = 3;
+static const uint8_t SLOT_FRESH = 4;
+
+// MARK: - Helpers
+
+static size_t framesFor(double seconds, double sampleRate, int hopSize) {
+    return static_cast<size_t>(std::llround(seconds * sampleRate / hopSize));
+}
+
+// MARK: - Lifecycle
+
+LiveSyncTracker::LiveSyncTracker(double sampleRate, size_t feedCount, const Settings& settings)
+    : sampleRate_(sampleRate)
+    , settings_(settings)
+    , feeds_(feedCount)
+    , pairs_(feedCount > 0 ? feedCount - 1 : 0)
+{
+    const int window = settings_.windowSize;
+    if (!(sampleRate_ > 0.0) || !std::isfinite(sampleRate_) || feedCount < 2) {
+        throw std::invalid_argument("Live tracking needs a valid sample rate and at least two feeds");
+    }
+    if (window < 2 || window > MAX_WINDOW_SIZE || (window & (window - 1)) != 0 ||
+        settings_.hopSize < 1 || settings_.hopSize > window) {
+        throw std::invalid_argument("Live tracking window must be a power of two no smaller than the hop");
+    }
+    if (!(settings_.windowSeconds > 0.0) || !(settings_.maxLagSeconds >= 0.0) ||
+        !(settings_.updateIntervalMs > 0.0) || !(settings_.maxSkewSeconds >= 0.0) ||
+        !(settings_.meanSeconds > 0.0) || !(settings_.driftSpacingSeconds >= 0.0) || settings_.driftHistory < 2 ||
+        settings_.minDriftPoints < 2 || settings_.minDriftPoints > settings_.driftHistory) {
+        throw std::invalid_argument("Invalid live tracking settings");
+    }
+
+    windowFrames_ = std::max<size_t>(1, framesFor(settings_.windowSeconds, sampleRate_, settings_.hopSize));
+    maxLagFrames_ = framesFor(settings_.maxLagSeconds, sampleRate_, settings_.hopSize);
+    lagCount_ = 2 * maxLagFrames_ + 1;
+    skewFrames_ = std::max<size_t>(1, framesFor(settings_.maxSkewSeconds, sampleRate_, settings_.hopSize));
+    updateFrames_ = std::max<size_t>(1, framesFor(settings_.updateIntervalMs / 1000.0, sampleRate_, settings_.hopSize));
+    meanRate_ = std::min(1.0, settings_.hopSize / (settings_.meanSeconds * sampleRate_));
+
+    // Correlation reaches back a window plus the largest lag behind the oldest
+    // uncorrelated frame, and the newest frame may be up to the skew ahead of it
+    ringFrames_ = windowFrames_ + maxLagFrames_ + skewFrames_ + 2;
+
+    const size_t bins = static_cast<size_t>(window) / 2;
+    for (auto& feed : feeds_) {
+        feed.window.assign(static_cast<size_t>(window), 0.0f);
+        feed.previous.assign(bins, 0.0f);
+        feed.envelope.assign(ringFrames_, 0.0f);
+        feed.energy.assign(ringFrames_, 0.0);
+    }
+    for (auto& pair : pairs_) {
+        pair.sums.assign(lagCount_, 0.0);
+        pair.driftTimes.assign(settings_.driftHistory, 0.0);
+        pair.driftOffsets.assign(settings_.driftHistory, 0.0);
+    }
+
+    spectrumKernel_ = SpectrumKernel::get(static_cast<size_t>(window));
+    magnitude_.assign(bins, 0.0f);
+    correlation_.assign(lagCount_, 0.0);
+
+    footprintBytes_ = sizeof(*this)
+        + feeds_.size() * (sizeof(Feed) + (window + bins + ringFrames_) * sizeof(float) + ringFrames_ * sizeof(double))
+        + pairs_.size() * (sizeof(Pair) + (lagCount_ + 2 * settings_.driftHistory) * sizeof(double))
+        + bins * sizeof(float) + lagCount_ * sizeof(double);
+}
+
+void LiveSyncTracker::reset() {
+    for (auto& feed : feeds_) {
+        std::fill(feed.window.begin(), feed.window.end(), 0.0f);
+        std::fill(feed.previous.begin(), feed.previous.end(), 0.0f);
+        std::fill(feed.envelope.begin(), feed.envelope.end(), 0.0f);
+        std::fill(feed.energy.begin(), feed.energy.end(), 0.0);
+        feed.filled = 0;
+        feed.hasPrevious = false;
+        feed.mean = 0.0;
+        feed.frames = 0;
+    }
+    for (auto& pair : pairs_) {
+        restartPair(pair, 0);
+        pair.current = Estimate();
+        for (auto& slot : pair.slots) slot = Estimate();
+        pair.published.store(1, std::memory_order_release);
+        pair.back = 0;
+        pair.front = 2;
+    }
+    worstBlockSeconds_.store(0.0, std::memory_order_relaxed);
+}
+
+// MARK: - Streaming
+
+bool LiveSyncTracker::processBlock(size_t feedIndex, const float* samples, size_t length) {
+    if (feedIndex >= feeds_.size()) return false;
+    if (length == 0) return true;
+    if (!samples) return false;
+    if (!AudioStatistics::allFiniteSamples(samples, length)) return false;
+
+    const auto started = std::chrono::steady_clock::now();
+
+    Feed& feed = feeds_[feedIndex];
+    const size_t window = feed.window.size();
+    size_t used = 0;
+    while (used < length) {
+        size_t count = std::min(window - feed.filled, length - used);
+        std::copy(samples + used, samples + used + count, feed.window.begin() + feed.filled);
+        feed.filled += count;
+        used += count;
+
+        if (feed.filled == window) {
+            extractFrame(feedIndex);
+            if (feedIndex == 0) {
+                for (size_t f = 1; f < feeds_.size(); ++f) advancePair(f);
+            } else {
+                advancePair(feedIndex);
+            }
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (seconds > worstBlockSeconds_.load(std::memory_order_relaxed)) {
+        worstBlockSeconds_.store(seconds, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+size_t LiveSyncTracker::getMaxFramesPerBlock(size_t blockLength) const {
+    // At most windowSize - 1 samples wait for the next frame
+    return blockLength == 0 ? 0 : (blockLength - 1) / static_cast<size_t>(settings_.hopSize) + 1;
+}
+
+void LiveSyncTracker::extractFrame(size_t feedIndex) {
+    Feed& feed = feeds_[feedIndex];
+    const size_t bins = spectrumKernel_->getBinCount();
+
+    // Windowed magnitude spectrum, the same kernel AudioProcessor::computeFFT uses
+    spectrumKernel_->magnitude(feed.window.data(), magnitude_.data());
+
+    // Spectral flux against the previous frame, without the DC bin
+    double flux = 0.0;
+    if (feed.hasPrevious) {
+        for (size_t bin = 1; bin < bins; ++bin) {
+            float rise = magnitude_[bin] - feed.previous[bin];
+            if (rise > 0.0f) flux += rise;
+        }
+    }
+    std::copy(magnitude_.begin(), magnitude_.end(), feed.previous.begin());
+    feed.hasPrevious = true;
+
+    // Onsets stand out against the running mean, which level changes would otherwise dominate
+    float value = static_cast<float>(flux - feed.mean);
+    feed.mean += meanRate_ * (flux - feed.mean);
+
+    const size_t frame = feed.frames;
+    feed.envelope[frame % ringFrames_] = value;
+    feed.energy[frame % ringFrames_] = energyAt(feed, static_cast<int64_t>(frame) - 1)
+                                     + static_cast<double>(value) * value;
+    feed.frames++;
+
+    // Next window starts one hop later
+    const size_t hop = static_cast<size_t>(settings_.hopSize);
+    std::copy(feed.window.begin() + hop, feed.window.end(), feed.window.begin());
+    feed.filled = feed.window.size() - hop;
+
+    // A stream too far ahead overwrites frames its pairs still need; restart them
+    auto checkSkew = [&](Pair& pair) {
+        if (frame >= pair.consumed + skewFrames_) {
+            restartPair(pair, frame + 1 - skewFrames_);
+        }
+    };
+    if (feedIndex == 0) {
+        for (auto& pair : pairs_) checkSkew(pair);
+    } else {
+        checkSkew(pairs_[feedIndex - 1]);
+    }
+}
+
+void LiveSyncTracker::advancePair(size_t feedIndex) {
+    Pair& pair = pairs_[feedIndex - 1];
+    const size_t available = std::min(feeds_[0].frames, feeds_[feedIndex].frames);
+    while (pair.consumed < available) {
+        correlateFrame(feedIndex);
+        if (pair.consumed - pair.start >= windowFrames_ && pair.consumed % updateFrames_ == 0) {
+            updateEstimate(feedIndex);
+        }
+    }
+}
+
+void LiveSyncTracker::correlateFrame(size_t feedIndex) {
+    Pair& pair = pairs_[feedIndex - 1];
+    const float* reference = feeds_[0].envelope.data();
+    const float* target = feeds_[feedIndex].envelope.data();
+
+    // Lag L pairs reference frame n - max(L, 0) with feed frame n - max(-L, 0); the
+    // window holds the pairs whose newer frame n lies in the last windowFrames_ frames
+    const int64_t newest = static_cast<int64_t>(pair.consumed);
+    const int64_t oldest = newest - static_cast<int64_t>(windowFrames_);
+    const int64_t start = static_cast<int64_t>(pair.start);
+    const int64_t maxLag = static_cast<int64_t>(maxLagFrames_);
+    const int64_t ring = static_cast<int64_t>(ringFrames_);
+
+    for (int64_t lag = -maxLag; lag <= maxLag; ++lag) {
+        const int64_t referenceShift = std::max<int64_t>(lag, 0);
+        const int64_t targetShift = std::max<int64_t>(-lag, 0);
+        const int64_t first = start + std::abs(lag);
+        double& sum = pair.sums[static_cast<size_t>(lag + maxLag)];
+
+        if (newest >= first) {
+            sum += static_cast<double>(reference[(newest - referenceShift) % ring])
+                 * target[(newest - targetShift) % ring];
+        }
+        if (oldest >= first) {
+            sum -= static_cast<double>(reference[(oldest - referenceShift) % ring])
+                 * target[(oldest - targetShift) % ring];
+        }
+    }
+    pair.consumed++;
+}
+
+void LiveSyncTracker::updateEstimate(size_t feedIndex) {
+    Pair& pair = pairs_[feedIndex - 1];
+    const Feed& reference = feeds_[0];
+    const Feed& target = feeds_[feedIndex];
+
+    const int64_t newest = static_cast<int64_t>(pair.consumed) - 1;
+    const int64_t windowStart = newest - static_cast<int64_t>(windowFrames_) + 1;
+    const int64_t start = static_cast<int64_t>(pair.start);
+    const int64_t maxLag = static_cast<int64_t>(maxLagFrames_);
+
+    // Normalized correlation per lag, from the running energies of the frames each lag pairs
+    size_t best = 0;
+    for (int64_t lag = -maxLag; lag <= maxLag; ++lag) {
+        const int64_t referenceShift = std::max<int64_t>(lag, 0);
+        const int64_t targetShift = std::max<int64_t>(-lag, 0);
+        const int64_t first = std::max(windowStart, start + std::abs(lag));
+        const size_t index = static_cast<size_t>(lag + maxLag);
+
+        double value = 0.0;
+        if (first <= newest) {
+            double referenceEnergy = energyAt(reference, newest - referenceShift)
+                                   - energyAt(reference, first - referenceShift - 1);
+            double targetEnergy = energyAt(target, newest - targetShift)
+                                - energyAt(target, first - targetShift - 1);
+            if (referenceEnergy > 0.0 && targetEnergy > 0.0) {
+                value = pair.sums[index] / std::sqrt(referenceEnergy * targetEnergy);
+            }
+        }
+        correlation_[index] = value;
+        if (value > correlation_[best]) best = index;
+    }
+
+    double rival = 0.0;
+    for (size_t index = 0; index < lagCount_; ++index) {
+        if (std::abs(static_cast<int64_t>(index) - static_cast<int64_t>(best)) > PEAK_NEIGHBOURHOOD_FRAMES) {
+            rival = std::max(rival, correlation_[index]);
+        }
+    }
+
+    // Parabolic interpolation between the neighbouring lags
+    const double peak = correlation_[best];
+    double fraction = 0.0;
+    if (best > 0 && best + 1 < lagCount_) {
+        double left = correlation_[best - 1];
+        double right = correlation_[best + 1];
+        double curvature = left - 2.0 * peak + right;
+        if (curvature < 0.0) fraction = std::clamp(0.5 * (left - right) / curvature, -0.5, 0.5);
+    }
+
+    Estimate& estimate = pair.current;
+    estimate.offsetSamples = (static_cast<double>(best) - maxLag + fraction) * settings_.hopSize;
+    estimate.confidence = std::clamp(peak, 0.0, 1.0);
+    estimate.secondaryPeakRatio = peak <= 0.0 ? 1.0 : rival > 0.0 ? peak / rival : 1e10;
+    estimate.valid = peak >= settings_.minCorrelation;
+    estimate.timeSeconds = static_cast<double>(pair.consumed) * settings_.hopSize / sampleRate_;
+    estimate.updates++;
+
+    // Least-squares line through the recent offsets; a jump means the feed was re-cued
+    if (estimate.valid) {
+        if (pair.driftCount > 0 &&
+            std::abs(estimate.offsetSamples - pair.lastOffset) > DRIFT_JUMP_HOPS * settings_.hopSize) {
+            pair.driftCount = 0;
+        }
+        pair.lastOffset = estimate.offsetSamples;
+
+        // Neighbouring windows overlap almost entirely, so only spaced estimates add information
+        const double time = estimate.timeSeconds * sampleRate_;
+        const size_t latest = (pair.driftNext + settings_.driftHistory - 1) % settings_.driftHistory;
+        if (pair.driftCount == 0 ||
+            time - pair.driftTimes[latest] >= settings_.driftSpacingSeconds * sampleRate_) {
+            pair.driftTimes[pair.driftNext] = time;
+            pair.driftOffsets[pair.driftNext] = estimate.offsetSamples;
+            pair.driftNext = (pair.driftNext + 1) % settings_.driftHistory;
+            pair.driftCount = std::min(pair.driftCount + 1, settings_.driftHistory);
+        }
+    }
+
+    estimate.driftPpm = 0.0;
+    estimate.driftPoints = 0;
+    if (pair.driftCount >= settings_.minDriftPoints) {
+        double meanTime = 0.0, meanOffset = 0.0;
+        for (size_t i = 0; i < pair.driftCount; ++i) {
+            size_t slot = (pair.driftNext + settings_.driftHistory - 1 - i) % settings_.driftHistory;
+            meanTime += pair.driftTimes[slot];
+            meanOffset += pair.driftOffsets[slot];
+        }
+        meanTime /= pair.driftCount;
+        meanOffset /= pair.driftCount;
+
+        double covariance = 0.0, variance = 0.0;
+        for (size_t i = 0; i < pair.driftCount; ++i) {
+            size_t slot = (pair.driftNext + settings_.driftHistory - 1 - i) % settings_.driftHistory;
+            double time = pair.driftTimes[slot] - meanTime;
+            covariance += time * (pair.driftOffsets[slot] - meanOffset);
+            variance += time * time;
+        }
+        if (variance > 0.0) {
+            estimate.driftPpm = covariance / variance * 1e6;
+            estimate.driftPoints = pair.driftCount;
+        }
+    }
+
+    publish(pair);
+}
+
+void LiveSyncTracker::restartPair(Pair& pair, size_t frame) {
+    std::fill(pair.sums.begin(), pair.sums.end(), 0.0);
+    pair.consumed = frame;
+    pair.start = frame;
+    pair.driftCount = 0;
+    pair.driftNext = 0;
+    pair.lastOffset = 0.0;
+}
+
+double LiveSyncTracker::energyAt(const Feed& feed, int64_t frame) const {
+    return frame < 0 ? 0.0 : feed.energy[static_cast<size_t>(frame) % ringFrames_];
+}
+
+// MARK: - Estimates
+
+void LiveSyncTracker::publish(Pair& pair) {
+    pair.slots[pair.back] = pair.current;
+    uint8_t previous = pair.published.exchange(static_cast<uint8_t>(pair.back | SLOT_FRESH),
+                                               std::memory_order_acq_rel);
+    pair.back = previous & SLOT_MASK;
+}
+
+LiveSyncTracker::Estimate LiveSyncTracker::getEstimate(size_t feed) {
+    if (feed >= feeds_.size()) {
+        throw std::out_of_range("Feed index out of range");
+    }
+    if (feed == 0) return Estimate();
+
+    Pair& pair = pairs_[feed - 1];
+    if (pair.published.load(std::memory_order_acquire) & SLOT_FRESH) {
+        uint8_t previous = pair.published.exchange(pair.front, std::memory_order_acq_rel);
+        pair.front = previous & SLOT_MASK;
+    }
+    return pair.slots[pair.front];
+}
+
+} // namespace HarmoniqSync
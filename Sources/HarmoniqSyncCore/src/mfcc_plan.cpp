@@ -0,0 +1,159 @@
+//
+//  mfcc_plan.cpp
+//  HarmoniqSyncCore
+//
+//  Sparse mel projection, log and DCT-II over blocks of frames
+//  Uses the DSP backend for the filter dot products and the DCT matrix multiply
+//
+
+#include "../include/mfcc_plan.hpp"
+#include "../include/dsp_backend.hpp"
+#include "../include/operation_control.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Frames projected per matrix multiply (bounds the mel scratch buffer)
+static const size_t FRAMES_PER_BLOCK = 256;
+
+// Added to mel energies before the log
+static const float LOG_EPSILON = 1e-10f;
+
+// MARK: - Lifecycle
+
+MFCCPlan::MFCCPlan(double sampleRate, size_t numBins, int numFilters, int numCoeffs)
+    : sampleRate_(sampleRate)
+    , numBins_(numBins)
+    , numFilters_(numFilters)
+    , numCoeffs_(numCoeffs) {
+    if (sampleRate <= 0.0 || numBins < 2 || numFilters <= 0 || numCoeffs <= 0) {
+        throw std::invalid_argument("Invalid MFCC plan configuration");
+    }
+
+    buildFilterBank();
+    buildDCTBasis();
+}
+
+std::shared_ptr<const MFCCPlan> MFCCPlan::get(double sampleRate, size_t numBins, int numFilters, int numCoeffs) {
+    using Key = std::tuple<double, size_t, int, int>;
+    static std::mutex mutex;
+    static std::map<Key, std::shared_ptr<const MFCCPlan>> plans;
+
+    Key key(sampleRate, numBins, numFilters, numCoeffs);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = plans.find(key);
+    if (it != plans.end()) {
+        return it->second;
+    }
+
+    auto plan = std::make_shared<const MFCCPlan>(sampleRate, numBins, numFilters, numCoeffs);
+    plans.emplace(key, plan);
+    return plan;
+}
+
+// MARK: - Processing
+
+void MFCCPlan::apply(const float* magnitudes, size_t numFrames, float* output) const {
+    const size_t numFilters = static_cast<size_t>(numFilters_);
+    // Per-thread scratch: plans are shared, and batch alignment extracts on several threads
+    static thread_local std::vector<float> melBlock;
+    melBlock.resize(std::min(numFrames, FRAMES_PER_BLOCK) * numFilters);
+
+    for (size_t first = 0; first < numFrames; first += FRAMES_PER_BLOCK) {
+        CancellationScope::check();
+        size_t blockFrames = std::min(FRAMES_PER_BLOCK, numFrames - first);
+
+        // Sparse mel projection: one dot product over each filter's non-zero span
+        for (size_t frame = 0; frame < blockFrames; ++frame) {
+            const float* magnitude = magnitudes + (first + frame) * numBins_;
+            float* mel = melBlock.data() + frame * numFilters;
+
+            for (size_t i = 0; i < numFilters; ++i) {
+                const Filter& filter = filters_[i];
+                float energy = 0.0f;
+                if (filter.length > 0) {
+                    energy = DSP::dot(magnitude + filter.start, weights_.data() + filter.offset, filter.length);
+                }
+                mel[i] = std::log(energy + LOG_EPSILON);
+            }
+        }
+
+        // (blockFrames x numFilters) * (numFilters x numCoeffs) writes the block's rows in place
+        DSP::matrixMultiply(melBlock.data(), dctBasis_.data(), output + first * numCoeffs_,
+                            blockFrames, numCoeffs_, numFilters);
+    }
+}
+
+// MARK: - Mel Scale
+
+float MFCCPlan::frequencyToMel(float frequency) {
+    return 2595.0f * std::log10(1.0f + frequency / 700.0f);
+}
+
+float MFCCPlan::melToFrequency(float mel) {
+    return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f);
+}
+
+// MARK: - Private Methods
+
+void MFCCPlan::buildFilterBank() {
+    const int fftSize = static_cast<int>(numBins_);
+
+    // Frequency range
+    float lowFreq = 0.0f;
+    float highFreq = sampleRate_ / 2.0f;
+
+    // Equally spaced mel points, mapped back to bin indices
+    float lowMel = frequencyToMel(lowFreq);
+    float highMel = frequencyToMel(highFreq);
+
+    std::vector<int> binIndices(numFilters_ + 2);
+    for (int i = 0; i < numFilters_ + 2; ++i) {
+        float mel = lowMel + (highMel - lowMel) * i / (numFilters_ + 1);
+        float freq = melToFrequency(mel);
+        binIndices[i] = static_cast<int>(freq * fftSize * 2 / sampleRate_);
+        binIndices[i] = std::min(binIndices[i], fftSize - 1);
+    }
+
+    // Triangular filters rising over [left, center) and falling over [center, right)
+    filters_.resize(numFilters_);
+    for (int i = 0; i < numFilters_; ++i) {
+        int left = binIndices[i];
+        int center = binIndices[i + 1];
+        int right = binIndices[i + 2];
+
+        Filter& filter = filters_[i];
+        filter.start = static_cast<size_t>(left);
+        filter.length = static_cast<size_t>(std::max(0, right - left));
+        filter.offset = weights_.size();
+
+        for (int j = left; j < right; ++j) {
+            weights_.push_back(j < center ? static_cast<float>(j - left) / (center - left)
+                                          : static_cast<float>(right - j) / (right - center));
+        }
+    }
+}
+
+void MFCCPlan::buildDCTBasis() {
+    dctBasis_.resize(static_cast<size_t>(numFilters_) * numCoeffs_);
+
+    for (int n = 0; n < numFilters_; ++n) {
+        for (int k = 0; k < numCoeffs_; ++k) {
+            dctBasis_[n * numCoeffs_ + k] = static_cast<float>(std::cos(M_PI * k * (n + 0.5) / numFilters_));
+        }
+    }
+}
+
+} // namespace HarmoniqSync
@@ -0,0 +1,75 @@
+//
+//  operation_control.cpp
+//  HarmoniqSyncCore
+//
+//  Cooperative cancellation and deadlines for long-running operations
+//
+
+#include "../include/operation_control.hpp"
+
+namespace HarmoniqSync {
+
+// MARK: - Cancellation Token
+
+CancellationToken::CancellationToken() : cancelled_(false) {}
+
+CancellationToken::~CancellationToken() = default;
+
+bool CancellationToken::isCancelled() const {
+    return cancelled_.load(std::memory_order_relaxed);
+}
+
+void CancellationToken::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancelled_.store(true, std::memory_order_relaxed);
+    }
+    condition_.notify_all();
+}
+
+void CancellationToken::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled_.store(false, std::memory_order_relaxed);
+}
+
+bool CancellationToken::waitForCancellation(std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condition_.wait_for(lock, timeout, [this] { return cancelled_.load(std::memory_order_relaxed); });
+}
+
+// MARK: - Cancellation Scope
+
+CancellationScope::CancellationScope(const CancellationToken* token, Clock::time_point deadline)
+    : CancellationScope(Context{ token, deadline }) {}
+
+CancellationScope::CancellationScope(const Context& context)
+    : previous_(threadContext()) {
+    threadContext() = context;
+}
+
+CancellationScope::~CancellationScope() {
+    threadContext() = previous_;
+}
+
+CancellationScope::Context CancellationScope::current() {
+    return threadContext();
+}
+
+void CancellationScope::check() {
+    const Context& context = threadContext();
+    if (context.token && context.token->isCancelled()) {
+        throw OperationCancelledException("Operation cancelled");
+    }
+    
+    // Only bounded scopes pay for reading the clock
+    if (context.deadline != Clock::time_point::max() && Clock::now() >= context.deadline) {
+        throw OperationTimeoutException("Operation timed out");
+    }
+}
+
+CancellationScope::Context& CancellationScope::threadContext() {
+    static thread_local Context context;
+    return context;
+}
+
+} // namespace HarmoniqSync
@@ -0,0 +1,80 @@
+//
+//  reference_fingerprint.cpp
+//  HarmoniqSyncCore
+//
+//  Precomputed reference features for repeated alignment
+//
+
+#include "../include/reference_fingerprint.hpp"
+#include <stdexcept>
+
+namespace HarmoniqSync {
+
+// MARK: - Lifecycle
+
+ReferenceFingerprint::ReferenceFingerprint(const float* samples, size_t length, double sampleRate,
+                                           harmoniq_sync_method_t method,
+                                           const AlignmentEngine::Config& config)
+    : config_(config)
+    , method_(method)
+{
+    if (method < HARMONIQ_SYNC_SPECTRAL_FLUX || method > HARMONIQ_SYNC_HYBRID) {
+        throw std::invalid_argument("Unknown alignment method");
+    }
+    
+    // Features and excerpts are copied out, so the samples only need to outlive the constructor
+    AudioProcessor reference;
+    if (!reference.loadAudioView(samples, length, sampleRate)) {
+        throw std::invalid_argument("Failed to load reference audio");
+    }
+    
+    AlignmentEngine engine;
+    engine.setConfig(config_);
+    features_ = engine.prepareReferenceFeatures(reference, method_);
+    if (features_.audioLength == 0) {
+        throw std::invalid_argument("Reference audio contains non-finite samples");
+    }
+}
+
+ReferenceFingerprint::ReferenceFingerprint(const StreamingFeatureExtractor& stream)
+    : config_(stream.getConfig())
+    , method_(stream.getMethod())
+{
+    if (stream.getSamplesProcessed() == 0) {
+        throw std::invalid_argument("Reference stream is empty");
+    }
+    
+    // Stream features are extracted at the source rate, so targets must be too
+    config_.analysisSampleRate = 0.0;
+    
+    AlignmentEngine engine;
+    engine.setConfig(config_);
+    features_ = engine.prepareReferenceFeatures(stream);
+}
+
+// MARK: - Alignment
+
+harmoniq_sync_result_t ReferenceFingerprint::align(const float* samples, size_t length, double sampleRate) const {
+    AudioProcessor target;
+    target.loadAudioView(samples, length, sampleRate);
+    
+    // Engines are cheap and own per-call scratch, so each call gets its own
+    AlignmentEngine engine;
+    engine.setConfig(config_);
+    return engine.alignPrepared(features_, target, method_);
+}
+
+std::vector<harmoniq_sync_result_t> ReferenceFingerprint::alignBatch(const float* const* samples, const size_t* lengths,
+                                                                     size_t count, double sampleRate) const {
+    std::vector<AudioProcessor> targets(count);
+    for (size_t i = 0; i < count; ++i) {
+        // Load failures surface as invalid input results from alignBatch
+        targets[i].loadAudioView(samples[i], lengths[i], sampleRate);
+    }
+    
+    AlignmentEngine engine;
+    engine.setConfig(config_);
+    return engine.alignBatch(features_, targets, method_);
+}
+
+} // namespace HarmoniqSync
@@ -0,0 +1,112 @@
+//
+//  spectrum_kernel.cpp
+//  HarmoniqSyncCore
+//
+//  Per-length frame spectrum kernels with a dispatch table for the standard window sizes
+//  Uses the DSP backend for the FFT; windowing, packing and magnitudes are fused loops
+//
+
+#include "../include/spectrum_kernel.hpp"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Standard window sizes with compile-time kernels: 2^9 .. 2^12
+static const size_t MIN_SPECIALIZED_LOG2_LENGTH = 9;
+static const size_t SPECIALIZED_KERNEL_COUNT = 4;
+
+// Stack scratch is aligned for the widest vector loads of any backend
+static const size_t SCRATCH_ALIGNMENT = 64;
+
+// MARK: - Frame Kernels
+
+template <size_t Length, bool Power>
+void SpectrumKernel::transformFrame(const SpectrumKernel& kernel, const float* input, float* output) {
+    // Length is a constant in the specialised kernels, so every loop below has a fixed trip count
+    constexpr size_t SCRATCH_LENGTH = Length > 0 ? Length : MAX_FRAME_LENGTH;
+    const size_t length = Length > 0 ? Length : kernel.frameLength_;
+    const size_t half = length / 2;
+    const float* window = kernel.window_->data();
+
+    alignas(SCRATCH_ALIGNMENT) float scratch[SCRATCH_LENGTH];
+    float* real = scratch;
+    float* imag = scratch + half;
+
+    // Window and split into packed form in one pass: even samples to realp, odd to imagp
+    for (size_t k = 0; k < half; ++k) {
+        real[k] = input[2 * k] * window[2 * k];
+        imag[k] = input[2 * k + 1] * window[2 * k + 1];
+    }
+
+    kernel.fft_->forward({real, imag}, kernel.log2Length_);
+
+    // Scaled squared magnitudes, and their square roots for the magnitude spectrum
+    const float scale = Power ? 1.0f / static_cast<float>(length * length) : 1.0f / static_cast<float>(length);
+    for (size_t k = 0; k < half; ++k) {
+        float power = (real[k] * real[k] + imag[k] * imag[k]) * scale;
+        output[k] = Power ? power : std::sqrt(power);
+    }
+}
+
+// MARK: - Lifecycle
+
+SpectrumKernel::SpectrumKernel(size_t frameLength)
+    : frameLength_(frameLength)
+    , log2Length_(0)
+    , specialized_(false)
+    , magnitudeFunction_(&transformFrame<0, false>)
+    , powerFunction_(&transformFrame<0, true>) {
+    if (frameLength < 2 || frameLength > MAX_FRAME_LENGTH || (frameLength & (frameLength - 1)) != 0) {
+        throw std::invalid_argument("Frame length must be a power of 2 no longer than the maximum frame");
+    }
+
+    while ((size_t(1) << log2Length_) < frameLength) {
+        ++log2Length_;
+    }
+    window_ = DSP::sharedHannWindow(frameLength);
+    fft_ = DSP::sharedRealFFT<float>(log2Length_);
+
+    // Dispatch table, indexed by log2(length) - MIN_SPECIALIZED_LOG2_LENGTH
+    static const FrameFunction MAGNITUDE_KERNELS[SPECIALIZED_KERNEL_COUNT] = {
+        &transformFrame<512, false>,
+        &transformFrame<1024, false>,
+        &transformFrame<2048, false>,
+        &transformFrame<4096, false>,
+    };
+    static const FrameFunction POWER_KERNELS[SPECIALIZED_KERNEL_COUNT] = {
+        &transformFrame<512, true>,
+        &transformFrame<1024, true>,
+        &transformFrame<2048, true>,
+        &transformFrame<4096, true>,
+    };
+
+    if (log2Length_ >= MIN_SPECIALIZED_LOG2_LENGTH &&
+        log2Length_ < MIN_SPECIALIZED_LOG2_LENGTH + SPECIALIZED_KERNEL_COUNT) {
+        magnitudeFunction_ = MAGNITUDE_KERNELS[log2Length_ - MIN_SPECIALIZED_LOG2_LENGTH];
+        powerFunction_ = POWER_KERNELS[log2Length_ - MIN_SPECIALIZED_LOG2_LENGTH];
+        specialized_ = true;
+    }
+}
+
+std::shared_ptr<const SpectrumKernel> SpectrumKernel::get(size_t frameLength) {
+    static std::mutex mutex;
+    static std::map<size_t, std::shared_ptr<const SpectrumKernel>> kernels;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = kernels.find(frameLength);
+    if (it != kernels.end()) {
+        return it->second;
+    }
+
+    auto kernel = std::make_shared<const SpectrumKernel>(frameLength);
+    kernels.emplace(frameLength, kernel);
+    return kernel;
+}
+
+} // namespace HarmoniqSync
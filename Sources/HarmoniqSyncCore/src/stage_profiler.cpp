@@ -0,0 +1,119 @@
+//
+//  stage_profiler.cpp
+//  HarmoniqSyncCore
+//
+//  Per-stage timing and allocation tracking for the alignment pipeline
+//
+
+#include "../include/stage_profiler.hpp"
+#include <algorithm>
+
+namespace HarmoniqSync {
+
+// MARK: - Stage Profile
+
+void StageProfile::merge(const StageProfile& other) {
+    for (size_t stage = 0; stage < PROCESSING_STAGE_COUNT; ++stage) {
+        stageSeconds[stage] += other.stageSeconds[stage];
+    }
+    for (size_t method = 0; method < PROFILED_METHOD_COUNT; ++method) {
+        methodSeconds[method] += other.methodSeconds[method];
+        methodRuns[method] += other.methodRuns[method];
+    }
+    
+    // The other thread's peak may have coincided with everything held here
+    int64_t held = std::max<int64_t>(0, allocatedBytes);
+    peakAllocatedBytes = std::max(peakAllocatedBytes, static_cast<size_t>(held) + other.peakAllocatedBytes);
+}
+
+// MARK: - Stage Profiler
+
+StageProfiler::StageProfiler(StageProfile* profile)
+    : previous_(threadState())
+    , start_(std::chrono::steady_clock::now()) {
+    threadState() = { profile, ProcessingStage::Count, start_ };
+}
+
+StageProfiler::~StageProfiler() {
+    // The enclosing stage keeps its own mark, so suspended time is charged to it
+    threadState() = previous_;
+}
+
+double StageProfiler::getElapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+}
+
+StageProfile* StageProfiler::active() {
+    return threadState().profile;
+}
+
+void StageProfiler::recordAllocation(size_t bytes) noexcept {
+    StageProfile* profile = threadState().profile;
+    if (!profile) return;
+    
+    profile->allocatedBytes += static_cast<int64_t>(bytes);
+    if (profile->allocatedBytes > 0) {
+        profile->peakAllocatedBytes = std::max(profile->peakAllocatedBytes, static_cast<size_t>(profile->allocatedBytes));
+    }
+}
+
+void StageProfiler::recordDeallocation(size_t bytes) noexcept {
+    StageProfile* profile = threadState().profile;
+    if (profile) {
+        profile->allocatedBytes -= static_cast<int64_t>(bytes);
+    }
+}
+
+StageProfiler::SavedState& StageProfiler::threadState() {
+    static thread_local SavedState state = { nullptr, ProcessingStage::Count, {} };
+    return state;
+}
+
+void StageProfiler::charge(SavedState& state, std::chrono::steady_clock::time_point now) {
+    if (state.stage != ProcessingStage::Count) {
+        state.profile->stageSeconds[static_cast<size_t>(state.stage)] +=
+            std::chrono::duration<double>(now - state.mark).count();
+    }
+    state.mark = now;
+}
+
+// MARK: - Scoped Timers
+
+ScopedStageTimer::ScopedStageTimer(ProcessingStage stage)
+    : profile_(nullptr)
+    , enclosing_(ProcessingStage::Count) {
+    auto& state = StageProfiler::threadState();
+    if (!state.profile) return;
+    
+    StageProfiler::charge(state, std::chrono::steady_clock::now());
+    profile_ = state.profile;
+    enclosing_ = state.stage;
+    state.stage = stage;
+}
+
+ScopedStageTimer::~ScopedStageTimer() {
+    auto& state = StageProfiler::threadState();
+    if (!profile_ || state.profile != profile_) return;
+    
+    StageProfiler::charge(state, std::chrono::steady_clock::now());
+    state.stage = enclosing_;
+}
+
+ScopedMethodTimer::ScopedMethodTimer(harmoniq_sync_method_t method)
+    : profile_(StageProfiler::active())
+    , index_(static_cast<size_t>(method)) {
+    if (profile_ && index_ < PROFILED_METHOD_COUNT) {
+        start_ = std::chrono::steady_clock::now();
+    } else {
+        profile_ = nullptr;
+    }
+}
+
+ScopedMethodTimer::~ScopedMethodTimer() {
+    if (profile_ && StageProfiler::active() == profile_) {
+        profile_->methodSeconds[index_] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        profile_->methodRuns[index_]++;
+    }
+}
+
+} // namespace HarmoniqSync
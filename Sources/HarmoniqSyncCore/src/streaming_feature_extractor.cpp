@@ -0,0 +1,221 @@
+//
+//  streaming_feature_extractor.cpp
+//  HarmoniqSyncCore
+//
+//  Incremental feature extraction from pushed audio blocks
+//
+
+#include "../include/streaming_feature_extractor.hpp"
+#include "../include/audio_statistics.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+static const double MIN_SAMPLE_RATE = 8000.0;
+static const double MAX_SAMPLE_RATE = 192000.0;
+static const int MAX_WINDOW_SIZE = 8192;
+
+// MARK: - Helpers
+
+// Append one block's feature rows to a stream matrix (dense rows on both sides)
+static void appendRows(const FeatureMatrix& rows, FeatureMatrix& stream) {
+    if (rows.empty()) return;
+    if (stream.getNumDims() != rows.getNumDims()) {
+        stream.resize(0, rows.getNumDims());
+    }
+
+    float* destination = stream.appendFrames(rows.getNumFrames());
+    std::copy(rows.data(), rows.data() + rows.size(), destination);
+}
+
+// MARK: - Lifecycle
+
+StreamingFeatureExtractor::StreamingFeatureExtractor(double sampleRate,
+                                                     harmoniq_sync_method_t method,
+                                                     const AlignmentEngine::Config& config)
+    : sampleRate_(sampleRate)
+    , method_(method)
+    , config_(config)
+    , hopSize_(0)
+    , energyHopSize_(0)
+    , bufferStart_(0)
+    , samplesProcessed_(0)
+    , nextSpectralFrame_(0)
+    , nextEnergyFrame_(0)
+    , spectralFrames_(0)
+{
+    if (!(sampleRate >= MIN_SAMPLE_RATE && sampleRate <= MAX_SAMPLE_RATE)) {
+        throw std::invalid_argument("Unsupported sample rate");
+    }
+
+    if (method < HARMONIQ_SYNC_SPECTRAL_FLUX || method > HARMONIQ_SYNC_HYBRID) {
+        throw std::invalid_argument("Unknown alignment method");
+    }
+
+    int windowSize = config_.windowSize;
+    if (windowSize <= 0 || windowSize > MAX_WINDOW_SIZE || (windowSize & (windowSize - 1)) != 0) {
+        throw std::invalid_argument("Window size must be a power of 2 no larger than 8192");
+    }
+
+    // Same hop resolution as AlignmentEngine::prepareFeatures
+    hopSize_ = config_.hopSize > 0 ? config_.hopSize : std::max(1, windowSize / 4);
+    energyHopSize_ = config_.hopSize > 0 ? config_.hopSize : std::max(1, windowSize / 2);
+
+    bool hybrid = (method == HARMONIQ_SYNC_HYBRID);
+    wantsSpectralFlux_ = hybrid || method == HARMONIQ_SYNC_SPECTRAL_FLUX;
+    wantsChroma_ = hybrid || method == HARMONIQ_SYNC_CHROMA;
+    wantsEnergy_ = hybrid || method == HARMONIQ_SYNC_ENERGY;
+    wantsMFCC_ = hybrid || method == HARMONIQ_SYNC_MFCC;
+
+    blockSpectrogram_.windowSize = windowSize;
+    blockSpectrogram_.hopSize = hopSize_;
+    blockSpectrogram_.sampleRate = sampleRate_;
+    blockSpectrogram_.numBins = static_cast<size_t>(windowSize / 2);
+
+    // Enough room for one window plus a typical decoder block
+    buffer_.reserve(static_cast<size_t>(windowSize) * 2);
+}
+
+// MARK: - Streaming
+
+bool StreamingFeatureExtractor::processBlock(const float* samples, size_t length) {
+    if (length == 0) return true;
+    if (!samples) return false;
+
+    // Validate before touching any state so a rejected block leaves no trace
+    if (!AudioStatistics::allFiniteSamples(samples, length)) {
+        return false;
+    }
+
+    buffer_.insert(buffer_.end(), samples, samples + length);
+    samplesProcessed_ += length;
+
+    if (wantsSpectralFlux_ || wantsChroma_ || wantsMFCC_) {
+        extractSpectralFrames();
+    }
+
+    if (wantsEnergy_) {
+        extractEnergyFrames();
+    }
+
+    trimBuffer();
+    return true;
+}
+
+void StreamingFeatureExtractor::reset() {
+    buffer_.clear();
+    bufferStart_ = 0;
+    samplesProcessed_ = 0;
+    nextSpectralFrame_ = 0;
+    nextEnergyFrame_ = 0;
+    spectralFrames_ = 0;
+
+    previousMagnitude_.clear();
+    spectralFlux_.clear();
+    chroma_.clear();
+    energy_.clear();
+    mfcc_.clear();
+}
+
+// MARK: - Features
+
+std::vector<float> StreamingFeatureExtractor::getSpectralFlux() const {
+    // The median filter needs its right neighbour, so it runs over the whole stream on read
+    std::vector<float> spectralFlux = spectralFlux_;
+    dsp_.smoothFeatures(spectralFlux, 3);
+    return spectralFlux;
+}
+
+std::vector<float> StreamingFeatureExtractor::getEnergyProfile() const {
+    std::vector<float> energy = energy_;
+    dsp_.smoothFeatures(energy, 5);
+    return energy;
+}
+
+// MARK: - Private Methods
+
+void StreamingFeatureExtractor::extractSpectralFrames() {
+    const size_t windowSize = static_cast<size_t>(config_.windowSize);
+    const size_t hopSize = static_cast<size_t>(hopSize_);
+    const size_t numBins = blockSpectrogram_.numBins;
+
+    size_t numFrames = 0;
+    for (size_t start = nextSpectralFrame_; start + windowSize <= samplesProcessed_; start += hopSize) {
+        ++numFrames;
+    }
+    if (numFrames == 0) return;
+
+    blockSpectrogram_.numFrames = numFrames;
+    blockSpectrogram_.magnitudes.resize(numFrames, numBins);
+
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        dsp_.computeMagnitudeFrame(&buffer_[nextSpectralFrame_ - bufferStart_], windowSize,
+                                   blockSpectrogram_.magnitudes.row(frame));
+        nextSpectralFrame_ += hopSize;
+    }
+
+    if (wantsSpectralFlux_) {
+        for (size_t frame = 0; frame < numFrames; ++frame) {
+            const float* magnitude = blockSpectrogram_.frame(frame);
+            const float* prevMagnitude = frame > 0 ? blockSpectrogram_.frame(frame - 1)
+                                                   : (previousMagnitude_.empty() ? nullptr : previousMagnitude_.data());
+            if (!prevMagnitude) continue; // The very first frame has no predecessor
+
+            // Same definition as AudioProcessor::extractSpectralFlux (DC skipped)
+            float flux = 0.0f;
+            for (size_t i = 1; i < numBins; ++i) {
+                float diff = magnitude[i] - prevMagnitude[i];
+                if (diff > 0) {
+                    flux += diff;
+                }
+            }
+            spectralFlux_.push_back(flux);
+        }
+
+        const float* last = blockSpectrogram_.frame(numFrames - 1);
+        previousMagnitude_.assign(last, last + numBins);
+    }
+
+    if (wantsChroma_) {
+        dsp_.extractChromaFeatures(blockSpectrogram_, blockFeatures_, config_.chroma.numChromaBins,
+                                   config_.chroma.useHarmonicWeighting);
+        appendRows(blockFeatures_, chroma_);
+    }
+
+    if (wantsMFCC_) {
+        dsp_.extractMFCC(blockSpectrogram_, blockFeatures_, config_.mfcc.numCoeffs, config_.mfcc.numMelFilters);
+        appendRows(blockFeatures_, mfcc_);
+    }
+
+    spectralFrames_ += numFrames;
+}
+
+void StreamingFeatureExtractor::extractEnergyFrames() {
+    const size_t windowSize = static_cast<size_t>(config_.windowSize);
+    const size_t hopSize = static_cast<size_t>(energyHopSize_);
+
+    while (nextEnergyFrame_ + windowSize <= samplesProcessed_) {
+        energy_.push_back(dsp_.calculateRMSEnergy(&buffer_[nextEnergyFrame_ - bufferStart_], windowSize));
+        nextEnergyFrame_ += hopSize;
+    }
+}
+
+void StreamingFeatureExtractor::trimBuffer() {
+    size_t keepFrom = samplesProcessed_;
+    if (wantsSpectralFlux_ || wantsChroma_ || wantsMFCC_) {
+        keepFrom = std::min(keepFrom, nextSpectralFrame_);
+    }
+    if (wantsEnergy_) {
+        keepFrom = std::min(keepFrom, nextEnergyFrame_);
+    }
+
+    if (keepFrom > bufferStart_) {
+        buffer_.erase(buffer_.begin(), buffer_.begin() + (keepFrom - bufferStart_));
+        bufferStart_ = keepFrom;
+    }
+}
+
+} // namespace HarmoniqSync
@@ -6,14 +6,36 @@
 //
 
 #include "../include/sync_engine.hpp"
-#include <chrono>
+#include "../include/thread_pool.hpp"
 #include <cstring>
 
 namespace HarmoniqSync {
 
+// MARK: - Constants
+
+// Idle alignment engines kept warm between calls; engines returned beyond this are freed
+static const size_t MAX_IDLE_ENGINES = 16;
+
+// MARK: - Engine Lease
+
+class SyncEngine::EngineLease {
+public:
+    explicit EngineLease(SyncEngine& owner) : owner_(owner), engine_(owner.acquireEngine()) {}
+    ~EngineLease() { owner_.releaseEngine(std::move(engine_)); }
+    
+    EngineLease(const EngineLease&) = delete;
+    EngineLease& operator=(const EngineLease&) = delete;
+    
+    AlignmentEngine* operator->() const { return engine_.get(); }
+    
+private:
+    SyncEngine& owner_;
+    std::unique_ptr<AlignmentEngine> engine_;
+};
+
 // MARK: - Lifecycle
 
-SyncEngine::SyncEngine() : alignmentEngine_(std::make_unique<AlignmentEngine>()) {
+SyncEngine::SyncEngine() {
     // Initialize with default configuration
     config_ = {
         0.7,        // confidence_threshold
@@ -21,11 +43,16 @@ SyncEngine::SyncEngine() : alignmentEngine_(std::make_unique<AlignmentEngine>())
         1024,       // window_size
         256,        // hop_size
         -40.0,      // noise_gate_db
-        1           // enable_drift_correction
+        1,          // enable_drift_correction
+        0,          // worker_count (auto)
+        0,          // coarse_hop_size (single resolution)
+        0.0,        // analysis_sample_rate (source rate)
+        0,          // hybrid_cascade (combine every method)
+        0,          // correlation_precision (double)
+        0           // correlation_memory_mb (no limit)
     };
     
-    // Set default config in alignment engine
-    alignmentEngine_->setConfig(convertConfig(config_));
+    engineConfig_ = convertConfig(config_);
 }
 
 SyncEngine::~SyncEngine() = default;
@@ -33,18 +60,29 @@ SyncEngine::~SyncEngine() = default;
 // MARK: - Configuration
 
 void SyncEngine::setConfig(const harmoniq_sync_config_t& config) {
-    config_ = config;
+    // Leased engines pick up the new configuration at their next lease
+    AlignmentEngine::Config engineConfig = convertConfig(config);
     
-    // Update alignment engine configuration
-    if (alignmentEngine_) {
-        alignmentEngine_->setConfig(convertConfig(config_));
-    }
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    config_ = config;
+    engineConfig_ = engineConfig;
 }
 
 harmoniq_sync_config_t SyncEngine::getConfig() const {
+    std::lock_guard<std::mutex> lock(stateMutex_);
     return config_;
 }
 
+void SyncEngine::setFeatureCache(std::shared_ptr<const FeatureCache> cache) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    featureCache_ = std::move(cache);
+}
+
+std::shared_ptr<const FeatureCache> SyncEngine::getFeatureCache() const {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return featureCache_;
+}
+
 // MARK: - Main Processing Interface
 
 harmoniq_sync_result_t SyncEngine::process(
@@ -53,91 +91,114 @@ harmoniq_sync_result_t SyncEngine::process(
     double sampleRate,
     harmoniq_sync_method_t method
 ) {
-    auto startTime = std::chrono::high_resolution_clock::now();
+    StageProfile profile;
+    StageProfiler profiler(&profile);
+    ProgressCallback progressCallback = snapshotProgressCallback();
     
-    updateProgress(0.0f, "Starting synchronization");
+    updateProgress(progressCallback, 0.0f, "Starting synchronization");
     
     // Validate inputs
-    auto validationError = validateInputs(referenceAudio, refLength, targetAudio, targetLength, sampleRate);
+    harmoniq_sync_error_t validationError;
+    {
+        ScopedStageTimer timer(ProcessingStage::LoadValidate);
+        validationError = validateInputs(referenceAudio, refLength, targetAudio, targetLength, sampleRate);
+    }
     if (validationError != HARMONIQ_SYNC_SUCCESS) {
-        updateProcessingStats(0.0, 0.0, method, false);
+        updateProcessingStats(profiler, profile, 0.0, method, false);
         return createErrorResult(validationError, "Validation");
     }
     
-    updateProgress(0.1f, "Creating audio processors");
+    updateProgress(progressCallback, 0.1f, "Creating audio processors");
     
     try {
+        // An operation cancelled while queued stops before any work
+        CancellationScope::check();
+        
         // Create audio processors
         AudioProcessor refProcessor, targetProcessor;
         
-        // Load audio data
-        if (!refProcessor.loadAudio(referenceAudio, refLength, sampleRate)) {
-            updateProcessingStats(0.0, refLength / sampleRate, method, false);
+        // Borrow the caller's buffers; they outlive this call, so no copy is needed
+        bool refLoaded;
+        {
+            ScopedStageTimer timer(ProcessingStage::LoadValidate);
+            refLoaded = refProcessor.loadAudioView(referenceAudio, refLength, sampleRate);
+        }
+        if (!refLoaded) {
+            updateProcessingStats(profiler, profile, refLength / sampleRate, method, false);
             return createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "LoadReference");
         }
         
-        updateProgress(0.3f, "Loading target audio");
+        updateProgress(progressCallback, 0.3f, "Loading target audio");
         
-        if (!targetProcessor.loadAudio(targetAudio, targetLength, sampleRate)) {
-            updateProcessingStats(0.0, refLength / sampleRate, method, false);
+        bool targetLoaded;
+        {
+            ScopedStageTimer timer(ProcessingStage::LoadValidate);
+            targetLoaded = targetProcessor.loadAudioView(targetAudio, targetLength, sampleRate);
+        }
+        if (!targetLoaded) {
+            updateProcessingStats(profiler, profile, refLength / sampleRate, method, false);
             return createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "LoadTarget");
         }
         
-        updateProgress(0.5f, "Performing alignment");
+        updateProgress(progressCallback, 0.5f, "Performing alignment");
         
-        // Perform alignment based on method
+        // Perform alignment based on method, with scratch buffers no other call uses
         harmoniq_sync_result_t result;
+        EngineLease alignmentEngine(*this);
         
         switch (method) {
             case HARMONIQ_SYNC_SPECTRAL_FLUX:
-                updateProgress(0.6f, "Extracting spectral flux features");
-                result = alignmentEngine_->alignSpectralFlux(refProcessor, targetProcessor);
+                updateProgress(progressCallback, 0.6f, "Extracting spectral flux features");
+                result = alignmentEngine->alignSpectralFlux(refProcessor, targetProcessor);
                 break;
                 
             case HARMONIQ_SYNC_CHROMA:
-                updateProgress(0.6f, "Extracting chroma features");
-                result = alignmentEngine_->alignChromaFeatures(refProcessor, targetProcessor);
+                updateProgress(progressCallback, 0.6f, "Extracting chroma features");
+                result = alignmentEngine->alignChromaFeatures(refProcessor, targetProcessor);
                 break;
                 
             case HARMONIQ_SYNC_ENERGY:
-                updateProgress(0.6f, "Analyzing energy correlation");
-                result = alignmentEngine_->alignEnergyCorrelation(refProcessor, targetProcessor);
+                updateProgress(progressCallback, 0.6f, "Analyzing energy correlation");
+                result = alignmentEngine->alignEnergyCorrelation(refProcessor, targetProcessor);
                 break;
                 
             case HARMONIQ_SYNC_MFCC:
-                updateProgress(0.6f, "Computing MFCC features");
-                result = alignmentEngine_->alignMFCC(refProcessor, targetProcessor);
+                updateProgress(progressCallback, 0.6f, "Computing MFCC features");
+                result = alignmentEngine->alignMFCC(refProcessor, targetProcessor);
                 break;
                 
             case HARMONIQ_SYNC_HYBRID:
-                updateProgress(0.6f, "Running hybrid analysis");
-                result = alignmentEngine_->alignHybrid(refProcessor, targetProcessor);
+                updateProgress(progressCallback, 0.6f, "Running hybrid analysis");
+                result = alignmentEngine->alignHybrid(refProcessor, targetProcessor);
                 break;
                 
             default:
-                updateProcessingStats(0.0, refLength / sampleRate, method, false);
+                updateProcessingStats(profiler, profile, refLength / sampleRate, method, false);
                 return createErrorResult(HARMONIQ_SYNC_ERROR_INVALID_INPUT, "UnknownMethod");
         }
         
-        updateProgress(0.9f, "Finalizing results");
+        updateProgress(progressCallback, 0.9f, "Finalizing results");
         
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-        double processingTimeSeconds = duration.count() / 1000.0;
         double audioLengthSeconds = std::max(refLength, targetLength) / sampleRate;
         
         bool successful = (result.error == HARMONIQ_SYNC_SUCCESS);
-        updateProcessingStats(processingTimeSeconds, audioLengthSeconds, method, successful);
+        updateProcessingStats(profiler, profile, audioLengthSeconds, method, successful);
         
-        updateProgress(1.0f, successful ? "Synchronization complete" : "Synchronization failed");
+        updateProgress(progressCallback, 1.0f, successful ? "Synchronization complete" : "Synchronization failed");
         
         return result;
         
+    } catch (const OperationCancelledException&) {
+        updateProcessingStats(profiler, profile, refLength / sampleRate, method, false);
+        return createErrorResult(HARMONIQ_SYNC_ERROR_CANCELLED, "Cancelled");
+    } catch (const OperationTimeoutException&) {
+        updateProcessingStats(profiler, profile, refLength / sampleRate, method, false);
+        return createErrorResult(HARMONIQ_SYNC_ERROR_TIMEOUT, "Timeout");
     } catch (const std::exception& e) {
-        updateProcessingStats(0.0, refLength / sampleRate, method, false);
+        updateProcessingStats(profiler, profile, refLength / sampleRate, method, false);
         return createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "Exception");
     } catch (...) {
-        updateProcessingStats(0.0, refLength / sampleRate, method, false);
+        updateProcessingStats(profiler, profile, refLength / sampleRate, method, false);
         return createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "UnknownError");
     }
 }
@@ -148,12 +209,15 @@ std::vector<harmoniq_sync_result_t> SyncEngine::processBatch(
     double sampleRate,
     harmoniq_sync_method_t method
 ) {
-    auto startTime = std::chrono::high_resolution_clock::now();
+    StageProfile profile;
+    StageProfiler profiler(&profile);
+    
+    ProgressCallback progressCallback = snapshotProgressCallback();
     
     std::vector<harmoniq_sync_result_t> results;
     results.reserve(targetCount);
     
-    updateProgress(0.0f, "Starting batch synchronization");
+    updateProgress(progressCallback, 0.0f, "Starting batch synchronization");
     
     // Validate inputs
     if (!referenceAudio || !targetAudios || !targetLengths || targetCount == 0) {
@@ -165,33 +229,36 @@ std::vector<harmoniq_sync_result_t> SyncEngine::processBatch(
     try {
         // Create reference processor once
         AudioProcessor refProcessor;
-        if (!refProcessor.loadAudio(referenceAudio, refLength, sampleRate)) {
+        bool refLoaded;
+        {
+            ScopedStageTimer timer(ProcessingStage::LoadValidate);
+            refLoaded = refProcessor.loadAudioView(referenceAudio, refLength, sampleRate);
+        }
+        if (!refLoaded) {
             harmoniq_sync_result_t errorResult = createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "BatchLoadReference");
             results.resize(targetCount, errorResult);
             return results;
         }
         
-        updateProgress(0.1f, "Processing batch targets");
+        updateProgress(progressCallback, 0.1f, "Processing batch targets");
         
         // Create target processors
         std::vector<AudioProcessor> targetProcessors(targetCount);
         for (size_t i = 0; i < targetCount; i++) {
-            if (!targetProcessors[i].loadAudio(targetAudios[i], targetLengths[i], sampleRate)) {
+            ScopedStageTimer timer(ProcessingStage::LoadValidate);
+            if (!targetProcessors[i].loadAudioView(targetAudios[i], targetLengths[i], sampleRate)) {
                 // Continue processing - individual failures will be handled by batch alignment
             }
             
             float progress = 0.1f + (0.2f * (i + 1) / targetCount);
-            updateProgress(progress, "Loading target " + std::to_string(i + 1) + "/" + std::to_string(targetCount));
+            updateProgress(progressCallback, progress, "Loading target " + std::to_string(i + 1) + "/" + std::to_string(targetCount));
         }
         
-        updateProgress(0.3f, "Running batch alignment");
+        updateProgress(progressCallback, 0.3f, "Running batch alignment");
         
         // Use batch processing for efficiency
-        results = alignmentEngine_->alignBatch(refProcessor, targetProcessors, method);
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-        double processingTimeSeconds = duration.count() / 1000.0;
+        EngineLease alignmentEngine(*this);
+        results = alignmentEngine->alignBatch(refProcessor, targetProcessors, method);
         
         // Calculate average audio length for stats
         double totalAudioLength = refLength / sampleRate;
@@ -209,13 +276,19 @@ std::vector<harmoniq_sync_result_t> SyncEngine::processBatch(
         }
         
         bool overallSuccess = (successCount > 0);
-        updateProcessingStats(processingTimeSeconds, avgAudioLength, method, overallSuccess);
+        updateProcessingStats(profiler, profile, avgAudioLength, method, overallSuccess);
         
-        updateProgress(1.0f, "Batch synchronization complete: " + std::to_string(successCount) + 
+        updateProgress(progressCallback, 1.0f, "Batch synchronization complete: " + std::to_string(successCount) + 
                       "/" + std::to_string(targetCount) + " successful");
         
         return results;
         
+    } catch (const OperationCancelledException&) {
+        results.assign(targetCount, createErrorResult(HARMONIQ_SYNC_ERROR_CANCELLED, "BatchCancelled"));
+        return results;
+    } catch (const OperationTimeoutException&) {
+        results.assign(targetCount, createErrorResult(HARMONIQ_SYNC_ERROR_TIMEOUT, "BatchTimeout"));
+        return results;
     } catch (const std::exception& e) {
         harmoniq_sync_result_t errorResult = createErrorResult(HARMONIQ_SYNC_ERROR_PROCESSING_FAILED, "BatchException");
         results.resize(targetCount, errorResult);
@@ -227,16 +300,87 @@ std::vector<harmoniq_sync_result_t> SyncEngine::processBatch(
     }
 }
 
+// MARK: - Asynchronous Processing
+
+std::shared_ptr<SyncOperation> SyncEngine::processAsync(
+    const float* referenceAudio, size_t refLength,
+    const float* targetAudio, size_t targetLength,
+    double sampleRate,
+    harmoniq_sync_method_t method,
+    std::chrono::milliseconds timeout,
+    CompletionCallback completion
+) {
+    auto operation = std::make_shared<SyncOperation>();
+    
+    // The deadline runs from the request, so time spent queued counts towards it
+    auto deadline = CancellationScope::Clock::time_point::max();
+    if (timeout.count() > 0) {
+        deadline = CancellationScope::Clock::now() + timeout;
+    }
+    
+    ThreadPool::shared().submit([this, operation, deadline, completion = std::move(completion),
+                                 referenceAudio, refLength, targetAudio, targetLength, sampleRate, method] {
+        harmoniq_sync_result_t result;
+        {
+            CancellationScope scope(&operation->token_, deadline);
+            result = process(referenceAudio, refLength, targetAudio, targetLength, sampleRate, method);
+        }
+        
+        // Publish first, so a callback or a thread it signals may wait on the operation
+        operation->finish(result);
+        if (completion) {
+            try {
+                completion(result);
+            } catch (...) {
+                // The pool discards escaping exceptions
+            }
+        }
+    });
+    
+    return operation;
+}
+
+void SyncOperation::cancel() {
+    token_.cancel();
+}
+
+bool SyncOperation::isFinished() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return finished_;
+}
+
+harmoniq_sync_result_t SyncOperation::wait() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finishedCondition_.wait(lock, [this] { return finished_; });
+    return result_;
+}
+
+void SyncOperation::finish(const harmoniq_sync_result_t& result) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result_ = result;
+        finished_ = true;
+    }
+    finishedCondition_.notify_all();
+}
+
 // MARK: - Progress Monitoring
 
 void SyncEngine::setProgressCallback(ProgressCallback callback) {
-    progressCallback_ = callback;
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    progressCallback_ = std::move(callback);
 }
 
 void SyncEngine::clearProgressCallback() {
+    std::lock_guard<std::mutex> lock(stateMutex_);
     progressCallback_ = nullptr;
 }
 
+SyncEngine::ProgressCallback SyncEngine::snapshotProgressCallback() const {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return progressCallback_;
+}
+
 // MARK: - Validation
 
 harmoniq_sync_error_t SyncEngine::validateInputs(
@@ -269,23 +413,25 @@ harmoniq_sync_error_t SyncEngine::validateInputs(
 }
 
 harmoniq_sync_error_t SyncEngine::validateConfig() const {
+    harmoniq_sync_config_t config = getConfig();
+    
     // Validate confidence threshold
-    if (config_.confidence_threshold < 0.0 || config_.confidence_threshold > 1.0) {
+    if (config.confidence_threshold < 0.0 || config.confidence_threshold > 1.0) {
         return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
     }
     
     // Validate window and hop sizes
-    if (config_.window_size <= 0 || config_.hop_size <= 0) {
+    if (config.window_size <= 0 || config.hop_size <= 0) {
         return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
     }
     
     // Validate hop size relative to window size
-    if (config_.hop_size > config_.window_size) {
+    if (config.hop_size > config.window_size) {
         return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
     }
     
     // Validate noise gate
-    if (config_.noise_gate_db > 0.0 || config_.noise_gate_db < -120.0) {
+    if (config.noise_gate_db > 0.0 || config.noise_gate_db < -120.0) {
         return HARMONIQ_SYNC_ERROR_INVALID_INPUT;
     }
     
@@ -294,42 +440,89 @@ harmoniq_sync_error_t SyncEngine::validateConfig() const {
 
 // MARK: - Performance Metrics
 
+CostModel::Prediction SyncEngine::predictCost(
+    size_t refLength, size_t targetLength,
+    double sampleRate,
+    harmoniq_sync_method_t method,
+    double confidence
+) const {
+    auto job = CostModel::Job::fromConfig(getConfig(), method, refLength, targetLength, sampleRate);
+    return getCostModel()->predict(job, confidence);
+}
+
+CostModel::Admission SyncEngine::admitJob(
+    size_t refLength, size_t targetLength,
+    double sampleRate,
+    harmoniq_sync_method_t method,
+    double deadlineSeconds,
+    size_t memoryBudgetBytes,
+    double confidence
+) const {
+    auto job = CostModel::Job::fromConfig(getConfig(), method, refLength, targetLength, sampleRate);
+    return getCostModel()->admit(job, deadlineSeconds, memoryBudgetBytes, confidence);
+}
+
 double SyncEngine::estimateProcessingTime(
     size_t audioLengthSamples,
     double sampleRate,
     harmoniq_sync_method_t method
 ) const {
     if (sampleRate <= 0) return 0.0;
-    
-    double durationSeconds = audioLengthSamples / sampleRate;
-    
-    // Estimate processing time based on method complexity
-    // These are estimates based on Apple Silicon M1 performance
-    switch (method) {
-        case HARMONIQ_SYNC_SPECTRAL_FLUX:
-            return durationSeconds * 0.08; // ~8% of audio duration
-        case HARMONIQ_SYNC_CHROMA:
-            return durationSeconds * 0.12; // ~12% of audio duration  
-        case HARMONIQ_SYNC_ENERGY:
-            return durationSeconds * 0.04; // ~4% of audio duration
-        case HARMONIQ_SYNC_MFCC:
-            return durationSeconds * 0.18; // ~18% of audio duration
-        case HARMONIQ_SYNC_HYBRID:
-            return durationSeconds * 0.35; // ~35% of audio duration (runs all methods)
-        default:
-            return durationSeconds * 0.08;
-    }
+    return predictCost(audioLengthSamples, audioLengthSamples, sampleRate, method).seconds;
+}
+
+void SyncEngine::setCostModel(std::shared_ptr<const CostModel> model) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    costModel_ = std::move(model);
+}
+
+std::shared_ptr<const CostModel> SyncEngine::getCostModel() const {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return costModel_ ? costModel_ : CostModel::shared();
 }
 
 SyncEngine::ProcessingStats SyncEngine::getLastProcessingStats() const {
+    std::lock_guard<std::mutex> lock(stateMutex_);
     return lastStats_;
 }
 
 // MARK: - Internal Processing
 
-void SyncEngine::updateProgress(float progress, const std::string& status) {
-    if (progressCallback_) {
-        progressCallback_(progress, status);
+std::unique_ptr<AlignmentEngine> SyncEngine::acquireEngine() {
+    std::unique_ptr<AlignmentEngine> engine;
+    AlignmentEngine::Config config;
+    std::shared_ptr<const FeatureCache> cache;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (!idleEngines_.empty()) {
+            engine = std::move(idleEngines_.back());
+            idleEngines_.pop_back();
+        }
+        config = engineConfig_;
+        cache = featureCache_;
+    }
+    
+    if (!engine) {
+        engine = std::make_unique<AlignmentEngine>();
+    }
+    engine->setConfig(config);
+    engine->setFeatureCache(std::move(cache));
+    return engine;
+}
+
+void SyncEngine::releaseEngine(std::unique_ptr<AlignmentEngine> engine) {
+    if (!engine) return;
+    
+    // With the pool full the engine is freed with the parameter, after the lock is released
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    if (idleEngines_.size() < MAX_IDLE_ENGINES) {
+        idleEngines_.push_back(std::move(engine));
+    }
+}
+
+void SyncEngine::updateProgress(const ProgressCallback& callback, float progress, const std::string& status) {
+    if (callback) {
+        callback(progress, status);
     }
 }
 
@@ -342,10 +535,18 @@ AlignmentEngine::Config SyncEngine::convertConfig(const harmoniq_sync_config_t&
     engineConfig.hopSize = cConfig.hop_size;
     engineConfig.noiseGateDb = cConfig.noise_gate_db;
     engineConfig.enableDriftCorrection = (cConfig.enable_drift_correction != 0);
+    engineConfig.numWorkers = cConfig.worker_count;
+    engineConfig.coarseToFine.hopSize = cConfig.coarse_hop_size;
+    engineConfig.analysisSampleRate = cConfig.analysis_sample_rate;
+    engineConfig.cascade.enabled = (cConfig.hybrid_cascade != 0);
+    engineConfig.correlationPrecision = cConfig.correlation_precision != 0 ? CorrelationEngine::Precision::Single
+                                                                           : CorrelationEngine::Precision::Double;
+    engineConfig.correlationMemoryBytes = static_cast<size_t>(std::max(0, cConfig.correlation_memory_mb)) << 20;
     
     // Algorithm-specific configurations with defaults
     engineConfig.spectralFlux.preEmphasisAlpha = 0.97f;
-    engineConfig.spectralFlux.medianFilterSize = 5;
+    // An onset raises the flux for two hops of a four-hop window; a wider median erases it
+    engineConfig.spectralFlux.medianFilterSize = 3;
     
     engineConfig.chroma.numChromaBins = 12;
     engineConfig.chroma.useHarmonicWeighting = true;
@@ -366,6 +567,10 @@ harmoniq_sync_result_t SyncEngine::createErrorResult(
     harmoniq_sync_result_t result = {};
     
     result.offset_samples = 0;
+    result.offset_samples_fractional = 0.0;
+    result.drift_ppm = 0.0;
+    result.drift_segments = 0;
+    result.searched_offset_samples = 0;
     result.confidence = 0.0;
     result.peak_correlation = 0.0;
     result.secondary_peak_ratio = 1.0;
@@ -382,18 +587,24 @@ harmoniq_sync_result_t SyncEngine::createErrorResult(
 }
 
 void SyncEngine::updateProcessingStats(
-    double processingTime,
+    const StageProfiler& profiler,
+    const StageProfile& profile,
     double audioLength,
     harmoniq_sync_method_t method,
-    bool successful,
-    size_t memoryUsed
+    bool successful
 ) {
-    lastStats_.processingTimeSeconds = processingTime;
-    lastStats_.audioLengthSeconds = audioLength;
-    lastStats_.realtimeRatio = (audioLength > 0) ? (processingTime / audioLength) : 0.0;
-    lastStats_.memoryUsedBytes = memoryUsed;
-    lastStats_.methodUsed = method;
-    lastStats_.successful = successful;
+    ProcessingStats stats;
+    double processingTime = profiler.getElapsedSeconds();
+    stats.processingTimeSeconds = processingTime;
+    stats.audioLengthSeconds = audioLength;
+    stats.realtimeRatio = (audioLength > 0) ? (processingTime / audioLength) : 0.0;
+    stats.memoryUsedBytes = profile.peakAllocatedBytes;
+    stats.methodUsed = method;
+    stats.successful = successful;
+    stats.stages = profile;
+    
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    lastStats_ = stats;
 }
 
 } // namespace HarmoniqSync
\ No newline at end of file
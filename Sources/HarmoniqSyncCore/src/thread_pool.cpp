@@ -0,0 +1,205 @@
+//
+//  thread_pool.cpp
+//  HarmoniqSyncCore
+//
+//  Persistent work-stealing thread pool for batch alignment
+//
+
+#include "../include/thread_pool.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace HarmoniqSync {
+
+// MARK: - Lifecycle
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : pendingTasks_(0)
+    , nextQueue_(0)
+    , stopping_(false)
+{
+    if (threadCount == 0) {
+        // The thread calling parallelFor also does work, so leave one core for it
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    queues_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    sleepCondition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// MARK: - Scheduling
+
+void ThreadPool::submit(std::function<void()> task) {
+    size_t queueIndex = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+    // Count the task before it becomes visible so sleeping workers never miss it
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        pendingTasks_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues_[queueIndex]->mutex);
+        queues_[queueIndex]->tasks.push_back(std::move(task));
+    }
+
+    sleepCondition_.notify_one();
+}
+
+size_t ThreadPool::resolveParallelism(size_t count, size_t maxParallelism) const {
+    size_t available = workers_.size() + 1;
+    if (maxParallelism == 0 || maxParallelism > available) {
+        maxParallelism = available;
+    }
+    return std::min(count, maxParallelism);
+}
+
+void ThreadPool::parallelFor(size_t count, size_t maxParallelism,
+                             const std::function<void(size_t index, size_t slot)>& body) {
+    size_t parallelism = resolveParallelism(count, maxParallelism);
+    if (parallelism == 0) return;
+
+    if (parallelism == 1) {
+        for (size_t index = 0; index < count; ++index) {
+            body(index, 0);
+        }
+        return;
+    }
+
+    std::atomic<size_t> nextIndex(0);
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    size_t activeHelpers = parallelism - 1;
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+
+    // Each slot claims indices until none are left, so fast slots pick up the slack
+    auto runSlot = [&](size_t slot) {
+        for (size_t index = nextIndex.fetch_add(1); index < count; index = nextIndex.fetch_add(1)) {
+            try {
+                body(index, slot);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+                nextIndex.store(count);
+            }
+        }
+    };
+
+    for (size_t slot = 1; slot < parallelism; ++slot) {
+        submit([&, slot] {
+            runSlot(slot);
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (--activeHelpers == 0) {
+                doneCondition.notify_all();
+            }
+        });
+    }
+
+    runSlot(0);
+
+    // Help drain the pool while waiting so nested calls from worker threads cannot
+    // deadlock. Once no queued task is left every helper has started and will finish.
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (activeHelpers == 0) break;
+        }
+
+        if (!tryRunTask(0)) {
+            std::unique_lock<std::mutex> lock(doneMutex);
+            doneCondition.wait(lock, [&] { return activeHelpers == 0; });
+            break;
+        }
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+// MARK: - Private Methods
+
+void ThreadPool::workerLoop(size_t workerIndex) {
+    while (true) {
+        if (tryRunTask(workerIndex)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this] {
+            return stopping_ || pendingTasks_.load(std::memory_order_relaxed) > 0;
+        });
+
+        if (stopping_ && pendingTasks_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::tryRunTask(size_t preferredQueue) {
+    std::function<void()> task;
+    size_t queueCount = queues_.size();
+
+    for (size_t offset = 0; offset < queueCount && !task; ++offset) {
+        WorkQueue& queue = *queues_[(preferredQueue + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty()) continue;
+
+        // Own queue is consumed FIFO, victims are robbed from the opposite end
+        if (offset == 0) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        } else {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    pendingTasks_.fetch_sub(1, std::memory_order_relaxed);
+
+    try {
+        task();
+    } catch (...) {
+        // Keep the worker alive; parallelFor reports errors through its own channel
+    }
+
+    return true;
+}
+
+} // namespace HarmoniqSync
@@ -0,0 +1,183 @@
+//
+//  timeline_solver.cpp
+//  HarmoniqSyncCore
+//
+//  Consistent clip positions from pairwise alignment offsets
+//
+
+#include "../include/timeline_solver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace HarmoniqSync {
+
+// MARK: - Constants
+
+// Conjugate gradient stops after this many iterations or once the squared residual
+// falls below this fraction of the squared right-hand side
+static const size_t MAX_ITERATIONS = 1000;
+static const double RELATIVE_TOLERANCE = 1e-20;
+
+// MARK: - Helpers
+
+static size_t findSet(std::vector<size_t>& parent, size_t clip) {
+    while (parent[clip] != clip) {
+        parent[clip] = parent[parent[clip]];
+        clip = parent[clip];
+    }
+    return clip;
+}
+
+static double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    return std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+}
+
+// MARK: - Solving
+
+TimelineSolver::Solution TimelineSolver::solve(size_t clipCount, const std::vector<Measurement>& measurements,
+                                               double toleranceSamples) {
+    for (const auto& measurement : measurements) {
+        if (measurement.reference >= clipCount || measurement.target >= clipCount) {
+            throw std::invalid_argument("Measurement refers to a clip out of range");
+        }
+    }
+
+    Solution solution;
+    solution.clips.resize(clipCount);
+    solution.consistent.assign(measurements.size(), false);
+
+    // Usable measurements, most trusted first (ties keep input order)
+    std::vector<size_t> order;
+    for (size_t i = 0; i < measurements.size(); ++i) {
+        const auto& m = measurements[i];
+        if (m.reference != m.target && m.weight > 0.0 && std::isfinite(m.offsetSamples)) {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return measurements[a].weight > measurements[b].weight;
+    });
+
+    // Maximum-weight spanning forest; a tree edge places its target at reference - offset
+    std::vector<size_t> parent(clipCount);
+    std::iota(parent.begin(), parent.end(), size_t(0));
+    std::vector<std::vector<std::pair<size_t, double>>> tree(clipCount);
+    for (size_t i : order) {
+        const auto& m = measurements[i];
+        size_t a = findSet(parent, m.reference);
+        size_t b = findSet(parent, m.target);
+        if (a == b) continue;
+
+        parent[std::max(a, b)] = std::min(a, b);
+        tree[m.reference].emplace_back(m.target, -m.offsetSamples);
+        tree[m.target].emplace_back(m.reference, m.offsetSamples);
+    }
+
+    // Walk each tree from its lowest clip, which anchors the group during the fit
+    std::vector<double> position(clipCount, 0.0);
+    std::vector<bool> visited(clipCount, false);
+    std::vector<bool> pinned(clipCount, false);
+    std::vector<size_t> pending;
+    for (size_t root = 0; root < clipCount; ++root) {
+        if (visited[root]) continue;
+
+        size_t group = solution.groupCount++;
+        visited[root] = true;
+        pinned[root] = true;
+        pending.assign(1, root);
+        while (!pending.empty()) {
+            size_t clip = pending.back();
+            pending.pop_back();
+            solution.clips[clip].group = group;
+            for (const auto& [neighbour, delta] : tree[clip]) {
+                if (!visited[neighbour]) {
+                    visited[neighbour] = true;
+                    position[neighbour] = position[clip] + delta;
+                    pending.push_back(neighbour);
+                }
+            }
+        }
+    }
+
+    // Measurements far from the tree placement are false matches
+    std::vector<size_t> used;
+    for (size_t i : order) {
+        const auto& m = measurements[i];
+        double residual = position[m.reference] - position[m.target] - m.offsetSamples;
+        if (std::abs(residual) <= toleranceSamples) {
+            solution.consistent[i] = true;
+            used.push_back(i);
+            solution.clips[m.reference].measurements++;
+            solution.clips[m.target].measurements++;
+        }
+    }
+
+    // Weighted least squares: the normal equations are a graph Laplacian, solved by
+    // conjugate gradient from the tree placement with each group's root held fixed
+    auto applyLaplacian = [&](const std::vector<double>& x, std::vector<double>& out) {
+        std::fill(out.begin(), out.end(), 0.0);
+        for (size_t i : used) {
+            const auto& m = measurements[i];
+            double difference = m.weight * (x[m.reference] - x[m.target]);
+            out[m.reference] += difference;
+            out[m.target] -= difference;
+        }
+        for (size_t clip = 0; clip < clipCount; ++clip) {
+            if (pinned[clip]) out[clip] = 0.0;
+        }
+    };
+
+    std::vector<double> rhs(clipCount, 0.0);
+    for (size_t i : used) {
+        const auto& m = measurements[i];
+        rhs[m.reference] += m.weight * m.offsetSamples;
+        rhs[m.target] -= m.weight * m.offsetSamples;
+    }
+    for (size_t clip = 0; clip < clipCount; ++clip) {
+        if (pinned[clip]) rhs[clip] = 0.0;
+    }
+
+    std::vector<double> residual(clipCount), direction(clipCount), product(clipCount);
+    applyLaplacian(position, product);
+    for (size_t clip = 0; clip < clipCount; ++clip) {
+        residual[clip] = rhs[clip] - product[clip];
+    }
+    direction = residual;
+
+    double residualNorm = dot(residual, residual);
+    const double stopNorm = RELATIVE_TOLERANCE * std::max(1.0, dot(rhs, rhs));
+    for (size_t iteration = 0; iteration < MAX_ITERATIONS && residualNorm > stopNorm; ++iteration) {
+        applyLaplacian(direction, product);
+        double curvature = dot(direction, product);
+        if (!(curvature > 0.0)) break;
+
+        double step = residualNorm / curvature;
+        for (size_t clip = 0; clip < clipCount; ++clip) {
+            position[clip] += step * direction[clip];
+            residual[clip] -= step * product[clip];
+        }
+
+        double nextNorm = dot(residual, residual);
+        for (size_t clip = 0; clip < clipCount; ++clip) {
+            direction[clip] = residual[clip] + (nextNorm / residualNorm) * direction[clip];
+        }
+        residualNorm = nextNorm;
+    }
+
+    // Each timeline starts at its earliest clip
+    std::vector<double> groupStart(solution.groupCount, std::numeric_limits<double>::infinity());
+    for (size_t clip = 0; clip < clipCount; ++clip) {
+        auto& start = groupStart[solution.clips[clip].group];
+        start = std::min(start, position[clip]);
+    }
+    for (size_t clip = 0; clip < clipCount; ++clip) {
+        solution.clips[clip].startSamples = position[clip] - groupStart[solution.clips[clip].group];
+    }
+    return solution;
+}
+
+} // namespace HarmoniqSync
@@ -0,0 +1,475 @@
+//
+//  test_alignment_engine.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for AlignmentEngine search strategies
+//
+
+#include <gtest/gtest.h>
+#include "../include/alignment_engine.hpp"
+#include "../include/stage_profiler.hpp"
+#include "test_signals.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class AlignmentEngineTest : public ::testing::Test {
+protected:
+    harmoniq_sync_result_t align(harmoniq_sync_method_t method, const AlignmentEngine::Config& config,
+                                 const std::vector<float>& reference, const std::vector<float>& target) {
+        AudioProcessor refProcessor, targetProcessor;
+        EXPECT_TRUE(refProcessor.loadAudio(reference.data(), reference.size(), sampleRate));
+        EXPECT_TRUE(targetProcessor.loadAudio(target.data(), target.size(), sampleRate));
+
+        AlignmentEngine engine;
+        engine.setConfig(config);
+        return method == HARMONIQ_SYNC_ENERGY ? engine.alignEnergyCorrelation(refProcessor, targetProcessor)
+                                              : engine.alignSpectralFlux(refProcessor, targetProcessor);
+    }
+
+    const double sampleRate = 22050.0;
+};
+
+// MARK: - Coarse-to-Fine Tests
+
+TEST_F(AlignmentEngineTest, CoarseToFineMatchesSingleResolution) {
+    auto reference = TestSignals::noiseBursts(static_cast<size_t>(sampleRate * 40), 3);
+    auto target = TestSignals::delayed(reference, 37 * 512);
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+
+    AlignmentEngine::Config coarseConfig = config;
+    coarseConfig.coarseToFine.hopSize = 4096;
+
+    for (auto method : {HARMONIQ_SYNC_ENERGY, HARMONIQ_SYNC_SPECTRAL_FLUX}) {
+        auto single = align(method, config, reference, target);
+        auto coarse = align(method, coarseConfig, reference, target);
+
+        ASSERT_EQ(single.error, HARMONIQ_SYNC_SUCCESS);
+        ASSERT_EQ(coarse.error, HARMONIQ_SYNC_SUCCESS);
+        EXPECT_EQ(single.offset_samples, 37 * 512) << "Method " << method;
+        EXPECT_EQ(coarse.offset_samples, single.offset_samples) << "Method " << method;
+        EXPECT_NEAR(coarse.peak_correlation, single.peak_correlation, 1e-6) << "Method " << method;
+    }
+}
+
+TEST_F(AlignmentEngineTest, CoarseToFineFindsNegativeOffset) {
+    auto target = TestSignals::noiseBursts(static_cast<size_t>(sampleRate * 40), 5);
+    auto reference = TestSignals::delayed(target, 21 * 512);
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+    config.coarseToFine.hopSize = 4096;
+
+    auto result = align(HARMONIQ_SYNC_ENERGY, config, reference, target);
+    ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(result.offset_samples, -21 * 512);
+}
+
+TEST_F(AlignmentEngineTest, CoarseToFineFallsBackOnShortClips) {
+    // Two seconds decimate to fewer coarse frames than minCoarseFrames
+    auto reference = TestSignals::noiseBursts(static_cast<size_t>(sampleRate * 2), 7);
+    auto target = TestSignals::delayed(reference, 4 * 512);
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+
+    AlignmentEngine::Config coarseConfig = config;
+    coarseConfig.coarseToFine.hopSize = 8192;
+
+    auto single = align(HARMONIQ_SYNC_ENERGY, config, reference, target);
+    auto coarse = align(HARMONIQ_SYNC_ENERGY, coarseConfig, reference, target);
+
+    EXPECT_EQ(coarse.offset_samples, single.offset_samples);
+    EXPECT_DOUBLE_EQ(coarse.confidence, single.confidence);
+}
+
+// MARK: - Sub-Frame Refinement Tests
+
+TEST_F(AlignmentEngineTest, SampleDomainRefinementResolvesSubHopDelay) {
+    auto reference = TestSignals::noiseBursts(static_cast<size_t>(sampleRate * 20), 9);
+    auto target = TestSignals::delayed(reference, 1000);
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+
+    for (auto method : {HARMONIQ_SYNC_ENERGY, HARMONIQ_SYNC_SPECTRAL_FLUX}) {
+        auto result = align(method, config, reference, target);
+        ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS);
+        EXPECT_EQ(result.offset_samples, 1000) << "Method " << method;
+        EXPECT_NEAR(result.offset_samples_fractional, 1000.0, 0.5) << "Method " << method;
+    }
+}
+
+TEST_F(AlignmentEngineTest, RefinementDisabledKeepsHopGrid) {
+    auto reference = TestSignals::noiseBursts(static_cast<size_t>(sampleRate * 20), 9);
+    auto target = TestSignals::delayed(reference, 1000);
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+    config.refinement.interpolatePeak = false;
+    config.refinement.sampleDomain = false;
+
+    auto result = align(HARMONIQ_SYNC_SPECTRAL_FLUX, config, reference, target);
+    ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(result.offset_samples % 256, 0);
+    EXPECT_LE(std::abs(result.offset_samples - 1000), 256);
+    EXPECT_DOUBLE_EQ(result.offset_samples_fractional, static_cast<double>(result.offset_samples));
+}
+
+// MARK: - Search Window Tests
+
+TEST_F(AlignmentEngineTest, ResultsReportTheSearchedOffsetWindow) {
+    auto reference = TestSignals::noiseBursts(static_cast<size_t>(sampleRate * 20), 9);
+    const int64_t delay = static_cast<int64_t>(sampleRate * 8);
+    auto target = TestSignals::delayed(reference, static_cast<size_t>(delay));
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+
+    AlignmentEngine::Config wideConfig = config;
+    wideConfig.maxOffsetSamples = delay + 1000;
+
+    for (auto method : {HARMONIQ_SYNC_ENERGY, HARMONIQ_SYNC_SPECTRAL_FLUX}) {
+        // By default a quarter of the clip is searched, so the delay cannot be found and the result says so
+        auto narrow = align(method, config, reference, target);
+        ASSERT_EQ(narrow.error, HARMONIQ_SYNC_SUCCESS);
+        EXPECT_GE(narrow.searched_offset_samples, static_cast<int64_t>(reference.size() / 4)) << "Method " << method;
+        EXPECT_LT(narrow.searched_offset_samples, delay) << "Method " << method;
+        EXPECT_LE(std::abs(narrow.offset_samples), narrow.searched_offset_samples) << "Method " << method;
+
+        auto wide = align(method, wideConfig, reference, target);
+        ASSERT_EQ(wide.error, HARMONIQ_SYNC_SUCCESS);
+        EXPECT_GE(wide.searched_offset_samples, wideConfig.maxOffsetSamples) << "Method " << method;
+        EXPECT_EQ(wide.offset_samples, delay) << "Method " << method;
+    }
+}
+
+// MARK: - Drift Tests
+
+// Target recorded `delay` samples late on a clock running `ppm` fast
+static std::vector<float> drifted(const std::vector<float>& samples, double delay, double ppm) {
+    std::vector<float> result(samples.size(), 0.0f);
+    const double rate = 1.0 + ppm * 1e-6;
+    for (size_t n = 0; n < result.size(); ++n) {
+        double position = (static_cast<double>(n) - delay) / rate;
+        if (position < 0.0 || position + 1.0 >= samples.size()) continue;
+        size_t index = static_cast<size_t>(position);
+        float t = static_cast<float>(position - index);
+        result[n] = samples[index] + t * (samples[index + 1] - samples[index]);
+    }
+    return result;
+}
+
+TEST_F(AlignmentEngineTest, DriftIsMeasuredAndOffsetAnchoredAtStart) {
+    auto reference = TestSignals::noiseBursts(static_cast<size_t>(sampleRate * 180), 11);
+    auto target = drifted(reference, 3000.0, 100.0);
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+
+    // Three minutes only pin the slope to a fraction of an energy frame
+    auto result = align(HARMONIQ_SYNC_ENERGY, config, reference, target);
+    ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_GE(result.drift_segments, 4);
+    EXPECT_NEAR(result.drift_ppm, 100.0, 15.0);
+    EXPECT_NEAR(result.offset_samples_fractional, 3000.0, 64.0);
+}
+
+TEST_F(AlignmentEngineTest, NoDriftReportsZeroPpm) {
+    auto reference = TestSignals::noiseBursts(static_cast<size_t>(sampleRate * 120), 13);
+    auto target = TestSignals::delayed(reference, 2500);
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+
+    auto result = align(HARMONIQ_SYNC_ENERGY, config, reference, target);
+    ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_GE(result.drift_segments, 4);
+    EXPECT_DOUBLE_EQ(result.drift_ppm, 0.0);
+    EXPECT_EQ(result.offset_samples, 2500);
+
+    config.enableDriftCorrection = false;
+    auto disabled = align(HARMONIQ_SYNC_ENERGY, config, reference, target);
+    EXPECT_EQ(disabled.drift_segments, 0);
+    EXPECT_EQ(disabled.offset_samples, 2500);
+}
+
+TEST_F(AlignmentEngineTest, CorrectedTargetHasNoDrift) {
+    auto reference = TestSignals::noiseBursts(static_cast<size_t>(sampleRate * 180), 17);
+    auto target = drifted(reference, 3000.0, -80.0);
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+
+    auto result = align(HARMONIQ_SYNC_ENERGY, config, reference, target);
+    ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS);
+    ASSERT_NE(result.drift_ppm, 0.0);
+
+    auto corrected = AlignmentEngine::correctDrift(target.data(), target.size(),
+                                                   result.offset_samples_fractional, result.drift_ppm);
+    ASSERT_EQ(corrected.size(), target.size());
+
+    auto check = align(HARMONIQ_SYNC_ENERGY, config, reference, corrected);
+    ASSERT_EQ(check.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_DOUBLE_EQ(check.drift_ppm, 0.0);
+    EXPECT_NEAR(check.offset_samples_fractional, 3000.0, 8.0);
+}
+
+TEST_F(AlignmentEngineTest, CorrectDriftWithoutDriftCopiesInput) {
+    std::vector<float> samples = {0.1f, -0.2f, 0.3f, 0.4f};
+    EXPECT_EQ(AlignmentEngine::correctDrift(samples.data(), samples.size(), 100.0, 0.0), samples);
+    EXPECT_TRUE(AlignmentEngine::correctDrift(nullptr, 0, 0.0, 10.0).empty());
+}
+
+// MARK: - Analysis Rate Tests
+
+TEST_F(AlignmentEngineTest, DecimatedAnalysisReportsSourceRateOffsets) {
+    const double sourceRate = 48000.0;
+    auto reference = TestSignals::noiseBursts(static_cast<size_t>(sourceRate * 20), 21);
+    auto target = TestSignals::delayed(reference, 12345);
+
+    AudioProcessor refProcessor, targetProcessor;
+    ASSERT_TRUE(refProcessor.loadAudioView(reference.data(), reference.size(), sourceRate));
+    ASSERT_TRUE(targetProcessor.loadAudioView(target.data(), target.size(), sourceRate));
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+    config.analysisSampleRate = 16000.0;
+
+    AlignmentEngine engine;
+    engine.setConfig(config);
+
+    // Features at 16 kHz are hop-accurate; refinement on the source samples restores the exact lag
+    for (auto method : {HARMONIQ_SYNC_ENERGY, HARMONIQ_SYNC_SPECTRAL_FLUX}) {
+        auto result = method == HARMONIQ_SYNC_ENERGY ? engine.alignEnergyCorrelation(refProcessor, targetProcessor)
+                                                     : engine.alignSpectralFlux(refProcessor, targetProcessor);
+        ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS) << "Method " << method;
+        EXPECT_EQ(result.offset_samples, 12345) << "Method " << method;
+    }
+
+    config.refinement.sampleDomain = false;
+    engine.setConfig(config);
+    auto coarse = engine.alignSpectralFlux(refProcessor, targetProcessor);
+    ASSERT_EQ(coarse.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_NEAR(static_cast<double>(coarse.offset_samples), 12345.0, 3.0 * 256);
+}
+
+// MARK: - Peak Picking Tests
+
+TEST_F(AlignmentEngineTest, SecondaryPeakRatioComparesSeparatePeaks) {
+    // Broad main lobe, a second lobe at half its height, low noise elsewhere
+    std::mt19937 gen(31);
+    std::uniform_real_distribution<double> noise(-0.02, 0.02);
+    std::vector<double> correlation(801);
+    for (double& value : correlation) value = noise(gen);
+    for (int i = -6; i <= 6; ++i) {
+        correlation[200 + i] = 0.8 * (1.0 - std::abs(i) / 7.0);
+        correlation[600 + i] = 0.4 * (1.0 - std::abs(i) / 7.0);
+    }
+
+    AlignmentEngine engine;
+    auto peak = engine.findBestAlignment(correlation);
+    EXPECT_EQ(peak.index, 200u);
+    EXPECT_DOUBLE_EQ(peak.value, 0.8);
+    EXPECT_NEAR(peak.secondaryPeakRatio, 2.0, 1e-9);
+    EXPECT_GT(peak.snrEstimate, 20.0);
+    EXPECT_LT(peak.noiseFloorDb, -40.0);
+
+    // A radius spanning the whole curve leaves a single peak
+    AlignmentEngine::Config config;
+    config.peakPicking.exclusionRadius = correlation.size();
+    engine.setConfig(config);
+    EXPECT_EQ(engine.findBestAlignment(correlation).secondaryPeakRatio, 1e10);
+}
+
+// MARK: - Hybrid Tests
+
+TEST_F(AlignmentEngineTest, ConcurrentHybridMatchesSequential) {
+    auto reference = TestSignals::noiseBursts(220500, 37);
+    auto target = TestSignals::delayed(reference, 5000);
+
+    AudioProcessor refProcessor, targetProcessor;
+    ASSERT_TRUE(refProcessor.loadAudio(reference.data(), reference.size(), sampleRate));
+    ASSERT_TRUE(targetProcessor.loadAudio(target.data(), target.size(), sampleRate));
+
+    // Every method contributes to the consensus
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+    config.concurrentHybrid = false;
+    AlignmentEngine sequentialEngine;
+    sequentialEngine.setConfig(config);
+    auto sequential = sequentialEngine.alignHybrid(refProcessor, targetProcessor);
+
+    config.concurrentHybrid = true;
+    AlignmentEngine concurrentEngine;
+    concurrentEngine.setConfig(config);
+    StageProfile profile;
+    harmoniq_sync_result_t concurrent;
+    {
+        StageProfiler profiler(&profile);
+        concurrent = concurrentEngine.alignHybrid(refProcessor, targetProcessor);
+    }
+
+    ASSERT_EQ(sequential.error, HARMONIQ_SYNC_SUCCESS);
+    ASSERT_EQ(concurrent.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_NEAR(static_cast<double>(concurrent.offset_samples), 5000.0, 2.0);
+    EXPECT_EQ(concurrent.offset_samples, sequential.offset_samples);
+    EXPECT_EQ(concurrent.offset_samples_fractional, sequential.offset_samples_fractional);
+    EXPECT_EQ(concurrent.confidence, sequential.confidence);
+    EXPECT_EQ(concurrent.peak_correlation, sequential.peak_correlation);
+    EXPECT_EQ(concurrent.secondary_peak_ratio, sequential.secondary_peak_ratio);
+    EXPECT_STREQ(concurrent.method, "Hybrid");
+
+    // Worker profiles are folded into the caller's
+    for (size_t method = 0; method < PROFILED_METHOD_COUNT; ++method) {
+        EXPECT_GT(profile.methodSeconds[method], 0.0) << "method " << method;
+    }
+}
+
+TEST_F(AlignmentEngineTest, SinglePrecisionHybridMatchesDouble) {
+    auto reference = TestSignals::noiseBursts(220500, 38);
+    auto target = TestSignals::delayed(reference, 7300);
+
+    AudioProcessor refProcessor, targetProcessor;
+    ASSERT_TRUE(refProcessor.loadAudio(reference.data(), reference.size(), sampleRate));
+    ASSERT_TRUE(targetProcessor.loadAudio(target.data(), target.size(), sampleRate));
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+    AlignmentEngine doubleEngine;
+    doubleEngine.setConfig(config);
+    auto expected = doubleEngine.alignHybrid(refProcessor, targetProcessor);
+
+    config.correlationPrecision = CorrelationEngine::Precision::Single;
+    AlignmentEngine singleEngine;
+    singleEngine.setConfig(config);
+    auto actual = singleEngine.alignHybrid(refProcessor, targetProcessor);
+
+    ASSERT_EQ(expected.error, HARMONIQ_SYNC_SUCCESS);
+    ASSERT_EQ(actual.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(actual.offset_samples, expected.offset_samples);
+    EXPECT_NEAR(actual.offset_samples_fractional, expected.offset_samples_fractional, 0.01);
+    EXPECT_NEAR(actual.confidence, expected.confidence, 1e-4);
+    EXPECT_NEAR(actual.peak_correlation, expected.peak_correlation, 1e-4);
+}
+
+TEST_F(AlignmentEngineTest, PartitionedCorrelationMatchesStoredCurve) {
+    auto reference = TestSignals::noiseBursts(220500, 39);
+    auto target = TestSignals::delayed(reference, 6100);
+
+    AudioProcessor refProcessor, targetProcessor;
+    ASSERT_TRUE(refProcessor.loadAudio(reference.data(), reference.size(), sampleRate));
+    ASSERT_TRUE(targetProcessor.loadAudio(target.data(), target.size(), sampleRate));
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+    config.enableDriftCorrection = false;
+    AlignmentEngine storedEngine;
+    storedEngine.setConfig(config);
+
+    // A budget below the whole-signal kernel's buffers streams the lags in partitions
+    config.correlationMemoryBytes = 16384;
+    AlignmentEngine streamedEngine;
+    streamedEngine.setConfig(config);
+
+    for (harmoniq_sync_method_t method : {HARMONIQ_SYNC_SPECTRAL_FLUX, HARMONIQ_SYNC_ENERGY}) {
+        auto expected = method == HARMONIQ_SYNC_ENERGY ? storedEngine.alignEnergyCorrelation(refProcessor, targetProcessor)
+                                                       : storedEngine.alignSpectralFlux(refProcessor, targetProcessor);
+        auto actual = method == HARMONIQ_SYNC_ENERGY ? streamedEngine.alignEnergyCorrelation(refProcessor, targetProcessor)
+                                                     : streamedEngine.alignSpectralFlux(refProcessor, targetProcessor);
+
+        ASSERT_EQ(expected.error, HARMONIQ_SYNC_SUCCESS);
+        ASSERT_EQ(actual.error, HARMONIQ_SYNC_SUCCESS);
+        EXPECT_EQ(actual.offset_samples, expected.offset_samples) << expected.method;
+        EXPECT_NEAR(actual.offset_samples_fractional, expected.offset_samples_fractional, 0.01) << expected.method;
+        EXPECT_NEAR(actual.confidence, expected.confidence, 1e-4) << expected.method;
+        EXPECT_NEAR(actual.peak_correlation, expected.peak_correlation, 1e-6) << expected.method;
+        EXPECT_NEAR(actual.secondary_peak_ratio, expected.secondary_peak_ratio, 1e-4) << expected.method;
+    }
+}
+
+TEST_F(AlignmentEngineTest, CascadeStopsAtConfidentMethod) {
+    auto reference = TestSignals::noiseBursts(220500, 41);
+    auto target = TestSignals::delayed(reference, 5000);
+
+    AudioProcessor refProcessor, targetProcessor;
+    ASSERT_TRUE(refProcessor.loadAudio(reference.data(), reference.size(), sampleRate));
+    ASSERT_TRUE(targetProcessor.loadAudio(target.data(), target.size(), sampleRate));
+
+    // This material scores just under 0.6 with every method
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.5;
+    config.cascade.enabled = true;
+    config.cascade.acceptConfidence = 0.55;
+    AlignmentEngine engine;
+    engine.setConfig(config);
+
+    StageProfile profile;
+    harmoniq_sync_result_t result;
+    {
+        StageProfiler profiler(&profile);
+        result = engine.alignHybrid(refProcessor, targetProcessor);
+    }
+
+    ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_NEAR(static_cast<double>(result.offset_samples), 5000.0, 2.0);
+    EXPECT_STREQ(result.method, "Hybrid");
+
+    // Energy needs no spectrogram, so nothing else was extracted or correlated
+    EXPECT_EQ(profile.methodRuns[HARMONIQ_SYNC_ENERGY], 1u);
+    EXPECT_EQ(profile.methodRuns[HARMONIQ_SYNC_SPECTRAL_FLUX], 0u);
+    EXPECT_EQ(profile.methodRuns[HARMONIQ_SYNC_CHROMA], 0u);
+    EXPECT_EQ(profile.methodRuns[HARMONIQ_SYNC_MFCC], 0u);
+    EXPECT_EQ(profile.seconds(ProcessingStage::STFT), 0.0);
+}
+
+TEST_F(AlignmentEngineTest, CascadeEscalatesUntilMethodsAgree) {
+    auto reference = TestSignals::noiseBursts(220500, 43);
+    auto target = TestSignals::delayed(reference, 5000);
+
+    AudioProcessor refProcessor, targetProcessor;
+    ASSERT_TRUE(refProcessor.loadAudio(reference.data(), reference.size(), sampleRate));
+    ASSERT_TRUE(targetProcessor.loadAudio(target.data(), target.size(), sampleRate));
+
+    // No single method is confident enough, so the first two that agree settle it
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+    config.cascade.enabled = true;
+    config.cascade.acceptConfidence = 2.0;
+
+    AlignmentEngine engine;
+    engine.setConfig(config);
+    auto refFeatures = engine.prepareReferenceFeatures(refProcessor, HARMONIQ_SYNC_HYBRID);
+
+    StageProfile profile;
+    harmoniq_sync_result_t result;
+    {
+        StageProfiler profiler(&profile);
+        result = engine.alignPrepared(refFeatures, targetProcessor, HARMONIQ_SYNC_HYBRID);
+    }
+
+    ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_NEAR(static_cast<double>(result.offset_samples), 5000.0, 2.0);
+    EXPECT_EQ(profile.methodRuns[HARMONIQ_SYNC_ENERGY], 1u);
+    EXPECT_EQ(profile.methodRuns[HARMONIQ_SYNC_SPECTRAL_FLUX], 1u);
+    EXPECT_EQ(profile.methodRuns[HARMONIQ_SYNC_CHROMA], 0u);
+    EXPECT_EQ(profile.methodRuns[HARMONIQ_SYNC_MFCC], 0u);
+
+    // An agreement tolerance nothing can meet runs every method
+    config.cascade.toleranceSamples = 1;
+    engine.setConfig(config);
+    StageProfile fullProfile;
+    {
+        StageProfiler profiler(&fullProfile);
+        result = engine.alignPrepared(refFeatures, targetProcessor, HARMONIQ_SYNC_HYBRID);
+    }
+    EXPECT_EQ(result.error, HARMONIQ_SYNC_SUCCESS);
+    for (size_t method = 0; method < PROFILED_METHOD_COUNT; ++method) {
+        EXPECT_EQ(fullProfile.methodRuns[method], 1u) << "method " << method;
+    }
+}
@@ -301,6 +301,49 @@ TEST_F(AudioProcessorTest, ExtractMFCC) {
     }
 }
 
+// MARK: - Spectrogram Tests
+
+TEST_F(AudioProcessorTest, SpectrogramMatchesPerFrameFFT) {
+    auto samples = generateWhiteNoise(8192, 0.5);
+    EXPECT_TRUE(processor->loadAudio(samples.data(), samples.size(), 44100.0));
+
+    const auto& spectrogram = processor->getSpectrogram(1024, 256);
+    EXPECT_EQ(spectrogram.numBins, 512u);
+    EXPECT_EQ(spectrogram.numFrames, (8192u - 1024u) / 256u + 1u);
+    EXPECT_EQ(spectrogram.magnitudes.size(), spectrogram.numFrames * spectrogram.numBins);
+
+    std::vector<float> magnitude;
+    processor->computeFFT(&processor->getAudioData()[3 * 256], 1024, magnitude);
+    for (size_t i = 0; i < magnitude.size(); ++i) {
+        EXPECT_FLOAT_EQ(spectrogram.frame(3)[i], magnitude[i]);
+    }
+}
+
+TEST_F(AudioProcessorTest, SpectrogramIsCachedPerWindowAndHop) {
+    auto samples = generateSineWave(440.0, 1.0, 44100.0);
+    EXPECT_TRUE(processor->loadAudio(samples.data(), samples.size(), 44100.0));
+
+    const Spectrogram* first = &processor->getSpectrogram(1024, 256);
+    EXPECT_EQ(&processor->getSpectrogram(1024, 256), first);
+    EXPECT_EQ(&processor->getSpectrogram(1024, 0), first); // Default hop is windowSize/4
+    EXPECT_NE(&processor->getSpectrogram(2048, 512), first);
+
+    // Features derived from the cached spectrogram match the direct extractors
+    auto flux = processor->extractSpectralFlux(processor->getSpectrogram(1024, 256));
+    EXPECT_EQ(flux, processor->extractSpectralFlux(1024, 256));
+}
+
+TEST_F(AudioProcessorTest, SpectrogramInvalidatedWhenAudioChanges) {
+    auto samples = generateSineWave(440.0, 1.0, 44100.0, 0.5);
+    EXPECT_TRUE(processor->loadAudio(samples.data(), samples.size(), 44100.0));
+
+    float before = processor->getSpectrogram(1024, 256).frame(0)[10];
+    processor->normalize(1.0f);
+    float after = processor->getSpectrogram(1024, 256).frame(0)[10];
+
+    EXPECT_NEAR(after, before * 2.0f, std::abs(before) * 1e-3f);
+}
+
 // MARK: - Preprocessing Tests
 
 TEST_F(AudioProcessorTest, ApplyPreEmphasis) {
@@ -417,6 +460,62 @@ TEST_F(AudioProcessorTest, MoveAssignment) {
     EXPECT_FALSE(processor->isValid());
 }
 
+// MARK: - View Tests
+
+TEST_F(AudioProcessorTest, ViewReadsCallerSamplesWithoutCopy) {
+    auto samples = generateSineWave(440.0, 0.5, 44100.0);
+    AudioProcessor owned;
+    ASSERT_TRUE(owned.loadAudio(samples.data(), samples.size(), 44100.0));
+    ASSERT_TRUE(processor->loadAudioView(samples.data(), samples.size(), 44100.0));
+    
+    EXPECT_TRUE(processor->isView());
+    EXPECT_FALSE(owned.isView());
+    EXPECT_EQ(processor->getAudioData().data(), samples.data());
+    EXPECT_EQ(processor->getLength(), samples.size());
+    
+    EXPECT_EQ(processor->extractSpectralFlux(1024, 256), owned.extractSpectralFlux(1024, 256));
+    EXPECT_EQ(processor->extractEnergyProfile(512, 256), owned.extractEnergyProfile(512, 256));
+    EXPECT_TRUE(processor->isValid());
+    
+    // Moving keeps pointing at the caller's buffer
+    AudioProcessor moved = std::move(*processor);
+    EXPECT_EQ(moved.getAudioData().data(), samples.data());
+    EXPECT_FALSE(processor->isValid());
+}
+
+TEST_F(AudioProcessorTest, ViewRejectsNonFiniteSamplesOnFirstPass) {
+    auto samples = generateSineWave(440.0, 0.5, 44100.0);
+    
+    // Past the last full frame, so only the tail check can see it
+    samples[samples.size() - 3] = std::numeric_limits<float>::quiet_NaN();
+    ASSERT_TRUE(processor->loadAudioView(samples.data(), samples.size(), 44100.0));
+    EXPECT_TRUE(processor->isValid()); // Not scanned yet
+    
+    EXPECT_TRUE(processor->extractSpectralFlux(1024, 256).empty());
+    EXPECT_FALSE(processor->isValid());
+    EXPECT_TRUE(processor->extractMFCC().empty());
+    
+    // The energy pass performs the same check
+    samples[samples.size() - 3] = 0.0f;
+    samples[1000] = std::numeric_limits<float>::infinity();
+    ASSERT_TRUE(processor->loadAudioView(samples.data(), samples.size(), 44100.0));
+    EXPECT_TRUE(processor->extractEnergyProfile(512, 256).empty());
+    EXPECT_FALSE(processor->isValid());
+}
+
+TEST_F(AudioProcessorTest, PreprocessingCopiesViewOnWrite) {
+    auto samples = generateSineWave(440.0, 0.1, 44100.0);
+    const auto original = samples;
+    ASSERT_TRUE(processor->loadAudioView(samples.data(), samples.size(), 44100.0));
+    
+    processor->applyPreEmphasis(0.97f);
+    
+    EXPECT_FALSE(processor->isView());
+    EXPECT_NE(processor->getAudioData().data(), samples.data());
+    EXPECT_EQ(samples, original); // Caller's buffer untouched
+    EXPECT_NEAR(processor->getAudioData()[1], original[1] - 0.97f * original[0], 1e-6f);
+}
+
 // MARK: - Edge Case Tests
 
 TEST_F(AudioProcessorTest, VeryShortAudio) {
@@ -0,0 +1,157 @@
+//
+//  test_audio_statistics.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for fused single-pass sample statistics
+//
+
+#include <gtest/gtest.h>
+#include "../include/audio_statistics.hpp"
+#include "../include/audio_processor.hpp"
+#include "test_signals.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class AudioStatisticsTest : public ::testing::Test {};
+
+// MARK: - Measurement
+
+TEST_F(AudioStatisticsTest, MatchesSeparatePasses) {
+    auto samples = TestSignals::mixedSignal(10007, 17);
+    auto statistics = AudioStatistics::measure(samples.data(), samples.size());
+
+    double sum = 0.0, squares = 0.0, peak = 0.0;
+    size_t silent = 0, clipped = 0, crossings = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        float magnitude = std::fabs(samples[i]);
+        sum += samples[i];
+        squares += static_cast<double>(samples[i]) * samples[i];
+        peak = std::max(peak, static_cast<double>(magnitude));
+        silent += magnitude < AudioStatistics::DEFAULT_SILENCE_THRESHOLD;
+        clipped += magnitude >= AudioStatistics::DEFAULT_CLIPPING_THRESHOLD;
+        if (i > 0) crossings += (samples[i] >= 0.0f) != (samples[i - 1] >= 0.0f);
+    }
+    double n = static_cast<double>(samples.size());
+
+    EXPECT_EQ(statistics.sampleCount, samples.size());
+    EXPECT_TRUE(statistics.allFinite());
+    EXPECT_EQ(statistics.firstNonFinite, samples.size());
+    EXPECT_EQ(statistics.silentCount, silent);
+    EXPECT_EQ(statistics.clippedCount, clipped);
+    EXPECT_EQ(statistics.zeroCrossings, crossings);
+    EXPECT_GT(clipped, 0u);
+    EXPECT_DOUBLE_EQ(statistics.peak, peak);
+    EXPECT_NEAR(statistics.mean(), sum / n, 1e-6);
+    EXPECT_NEAR(statistics.rms(), std::sqrt(squares / n), 1e-5);
+    EXPECT_NEAR(statistics.silenceRatio(), silent / n, 1e-12);
+    EXPECT_NEAR(statistics.zeroCrossingRate(), crossings / (n - 1.0), 1e-12);
+}
+
+TEST_F(AudioStatisticsTest, CopiesInTheSamePass) {
+    auto samples = TestSignals::mixedSignal(5000, 17);
+    std::vector<float> copy(samples.size(), -2.0f);
+
+    auto copied = AudioStatistics::measure(samples.data(), samples.size(),
+                                           AudioStatistics::DEFAULT_SILENCE_THRESHOLD,
+                                           AudioStatistics::DEFAULT_CLIPPING_THRESHOLD, copy.data());
+    auto measured = AudioStatistics::measure(samples.data(), samples.size());
+
+    EXPECT_EQ(copy, samples);
+    EXPECT_EQ(copied.zeroCrossings, measured.zeroCrossings);
+    EXPECT_DOUBLE_EQ(copied.sumSquares, measured.sumSquares);
+}
+
+TEST_F(AudioStatisticsTest, CountsAndLocatesNonFiniteSamples) {
+    auto samples = TestSignals::mixedSignal(9000, 17);
+    samples[5000] = std::numeric_limits<float>::quiet_NaN();
+    samples[7000] = std::numeric_limits<float>::infinity();
+
+    auto statistics = AudioStatistics::measure(samples.data(), samples.size());
+
+    EXPECT_FALSE(statistics.allFinite());
+    EXPECT_EQ(statistics.nonFiniteCount, 2u);
+    EXPECT_EQ(statistics.firstNonFinite, 5000u);
+    EXPECT_LE(statistics.peak, 1.0);
+    EXPECT_TRUE(std::isfinite(statistics.rms()));
+}
+
+TEST_F(AudioStatisticsTest, SampleChecksSurviveFiniteMath) {
+    // The release build assumes finite math, so these must not reduce to std::isfinite
+    auto samples = TestSignals::mixedSignal(5000, 17);
+    EXPECT_TRUE(AudioStatistics::allFiniteSamples(samples.data(), samples.size()));
+    EXPECT_TRUE(AudioStatistics::isFiniteSample(std::numeric_limits<float>::max()));
+    EXPECT_TRUE(AudioStatistics::isFiniteSample(std::numeric_limits<float>::denorm_min()));
+
+    for (float bad : {std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+                      -std::numeric_limits<float>::infinity()}) {
+        EXPECT_FALSE(AudioStatistics::isFiniteSample(bad));
+        samples[4321] = bad;
+        EXPECT_FALSE(AudioStatistics::allFiniteSamples(samples.data(), samples.size()));
+        EXPECT_TRUE(AudioStatistics::allFiniteSamples(samples.data(), 4321));
+    }
+}
+
+TEST_F(AudioStatisticsTest, ConstantSignalHasNoVariance) {
+    std::vector<float> samples(100000, 0.3f);
+    auto statistics = AudioStatistics::measure(samples.data(), samples.size());
+
+    EXPECT_DOUBLE_EQ(statistics.variance(), 0.0);
+    EXPECT_NEAR(statistics.mean(), 0.3, 1e-7);
+    EXPECT_NEAR(statistics.rms(), 0.3, 1e-7);
+    EXPECT_EQ(statistics.zeroCrossings, 0u);
+}
+
+TEST_F(AudioStatisticsTest, EmptyBufferIsAllSilent) {
+    auto statistics = AudioStatistics::measure(nullptr, 0);
+
+    EXPECT_EQ(statistics.sampleCount, 0u);
+    EXPECT_DOUBLE_EQ(statistics.rms(), 0.0);
+    EXPECT_DOUBLE_EQ(statistics.silenceRatio(), 1.0);
+    EXPECT_DOUBLE_EQ(statistics.zeroCrossingRate(), 0.0);
+}
+
+TEST_F(AudioStatisticsTest, SpectralCentroidOfTone) {
+    AudioProcessor processor;
+    auto samples = TestSignals::tone(1000.0, 44100.0, 44100);
+    ASSERT_TRUE(processor.loadAudio(samples.data(), samples.size(), 44100.0));
+
+    EXPECT_EQ(processor.getCachedSpectrogram(), nullptr);
+    const Spectrogram& spectrogram = processor.getSpectrogram(2048);
+    EXPECT_EQ(processor.getCachedSpectrogram(), &spectrogram);
+
+    EXPECT_NEAR(AudioStatistics::spectralCentroid(spectrogram), 1000.0, 50.0);
+}
+
+// MARK: - Processor Integration
+
+TEST_F(AudioStatisticsTest, ProcessorKeepsLoaderStatistics) {
+    AudioProcessor processor;
+    auto samples = TestSignals::mixedSignal(20000, 17);
+    ASSERT_TRUE(processor.loadAudio(samples.data(), samples.size(), 44100.0));
+
+    auto expected = AudioStatistics::measure(samples.data(), samples.size());
+    const AudioStatistics& loaded = processor.getStatistics();
+    EXPECT_EQ(loaded.zeroCrossings, expected.zeroCrossings);
+    EXPECT_DOUBLE_EQ(loaded.peak, expected.peak);
+    EXPECT_EQ(&processor.getStatistics(), &loaded);
+
+    // Preprocessing measures the modified samples again
+    processor.normalize(0.5f);
+    EXPECT_NEAR(processor.getStatistics().peak, 0.5, 1e-6);
+}
+
+TEST_F(AudioStatisticsTest, ViewStatisticsCheckSamples) {
+    auto samples = TestSignals::mixedSignal(20000, 17);
+    samples[12345] = std::numeric_limits<float>::quiet_NaN();
+
+    AudioProcessor processor;
+    ASSERT_TRUE(processor.loadAudioView(samples.data(), samples.size(), 44100.0));
+    EXPECT_TRUE(processor.isValid());
+
+    EXPECT_EQ(processor.getStatistics().firstNonFinite, 12345u);
+    EXPECT_FALSE(processor.isValid());
+}
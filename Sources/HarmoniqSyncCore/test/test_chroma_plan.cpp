@@ -0,0 +1,155 @@
+//
+//  test_chroma_plan.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for the cached bin-to-pitch-class chroma plan
+//
+
+#include <gtest/gtest.h>
+#include "../include/chroma_plan.hpp"
+#include "../include/audio_processor.hpp"
+#include "test_signals.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class ChromaPlanTest : public ::testing::Test {
+protected:
+    std::vector<float> generateMagnitudes(size_t numFrames, size_t numBins, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dis(0.0f, 2.0f);
+
+        std::vector<float> magnitudes(numFrames * numBins);
+        for (float& value : magnitudes) {
+            value = dis(gen);
+        }
+        return magnitudes;
+    }
+
+    // Per-bin log2 mapping, as extractChromaFeatures computed it before plans
+    static std::vector<float> referenceChroma(const std::vector<float>& magnitudes, size_t numFrames,
+                                              size_t numBins, double sampleRate) {
+        std::vector<float> result;
+        for (size_t frame = 0; frame < numFrames; ++frame) {
+            std::vector<float> chroma(12, 0.0f);
+            for (size_t i = 1; i < numBins; ++i) {
+                double freq = i * sampleRate / (2.0 * (numBins - 1));
+                if (freq > 80.0 && freq < 2000.0) {
+                    double midiNote = 12.0 * std::log2(freq / 440.0) + 69.0;
+                    if (midiNote >= 0) {
+                        chroma[static_cast<int>(midiNote) % 12] += magnitudes[frame * numBins + i];
+                    }
+                }
+            }
+
+            float sum = std::accumulate(chroma.begin(), chroma.end(), 0.0f);
+            for (float& value : chroma) {
+                result.push_back(sum > 0.0f ? value / sum : value);
+            }
+        }
+        return result;
+    }
+};
+
+// MARK: - Equivalence Tests
+
+TEST_F(ChromaPlanTest, MatchesPerBinReference) {
+    const size_t numBins = 512;
+    const size_t numFrames = 40;
+    auto magnitudes = generateMagnitudes(numFrames, numBins, 11);
+
+    for (double sampleRate : {22050.0, 48000.0}) {
+        ChromaPlan plan(sampleRate, numBins, 12, false);
+        std::vector<float> chroma(numFrames * 12);
+        plan.apply(magnitudes.data(), numFrames, chroma.data());
+
+        auto expected = referenceChroma(magnitudes, numFrames, numBins, sampleRate);
+        ASSERT_EQ(chroma.size(), expected.size());
+        for (size_t i = 0; i < chroma.size(); ++i) {
+            ASSERT_NEAR(chroma[i], expected[i], 1e-5f) << "at index " << i;
+        }
+    }
+}
+
+TEST_F(ChromaPlanTest, RunsAreFewerThanBins) {
+    ChromaPlan plain(22050.0, 2048, 12, false);
+    ChromaPlan weighted(22050.0, 2048, 12, true);
+
+    // One run per semitone in range, far fewer than the bins they cover
+    EXPECT_GT(plain.getRunCount(), 0u);
+    EXPECT_LT(plain.getRunCount(), 2048u / 4u);
+    EXPECT_GT(weighted.getRunCount(), plain.getRunCount());
+}
+
+// MARK: - Configuration Tests
+
+TEST_F(ChromaPlanTest, FinerBinsSubdivideSemitones) {
+    const size_t numBins = 512;
+    const size_t numFrames = 8;
+    auto magnitudes = generateMagnitudes(numFrames, numBins, 5);
+
+    ChromaPlan semitones(22050.0, numBins, 12, false);
+    ChromaPlan thirdTones(22050.0, numBins, 36, false);
+
+    std::vector<float> coarse(numFrames * 12), fine(numFrames * 36);
+    semitones.apply(magnitudes.data(), numFrames, coarse.data());
+    thirdTones.apply(magnitudes.data(), numFrames, fine.data());
+
+    // Folding each group of three sub-bins gives the semitone chroma back
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        for (size_t pitch = 0; pitch < 12; ++pitch) {
+            const float* group = fine.data() + frame * 36 + pitch * 3;
+            float folded = group[0] + group[1] + group[2];
+            EXPECT_NEAR(folded, coarse[frame * 12 + pitch], 2e-2f) << "Frame " << frame << ", pitch " << pitch;
+        }
+    }
+}
+
+TEST_F(ChromaPlanTest, HarmonicWeightingCreditsFundamental) {
+    const double sampleRate = 22050.0;
+    // Midway through E5, the third harmonic of a note midway through A3
+    auto samples = TestSignals::tone(678.57, sampleRate, 16384);
+
+    AudioProcessor processor;
+    ASSERT_TRUE(processor.loadAudio(samples.data(), samples.size(), sampleRate));
+
+    auto plain = processor.extractChromaFeatures(4096, 1024, 12, false);
+    auto weighted = processor.extractChromaFeatures(4096, 1024, 12, true);
+    ASSERT_EQ(plain.size(), weighted.size());
+    ASSERT_FALSE(plain.empty());
+
+    const size_t pitchE = 4, pitchA = 9;
+    EXPECT_GT(plain[pitchE], 0.5f);
+    EXPECT_LT(plain[pitchA], 0.05f);
+    EXPECT_GT(weighted[pitchA], 0.1f);
+    EXPECT_GT(weighted[pitchE], weighted[pitchA]);
+
+    float sum = std::accumulate(weighted.begin(), weighted.begin() + 12, 0.0f);
+    EXPECT_NEAR(sum, 1.0f, 1e-5f);
+}
+
+// MARK: - Cache Tests
+
+TEST_F(ChromaPlanTest, GetReusesPlansPerConfiguration) {
+    auto first = ChromaPlan::get(22050.0, 2048, 12, true);
+    auto second = ChromaPlan::get(22050.0, 2048, 12, true);
+    auto plain = ChromaPlan::get(22050.0, 2048, 12, false);
+    auto finer = ChromaPlan::get(22050.0, 2048, 24, true);
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, plain);
+    EXPECT_NE(first, finer);
+    EXPECT_EQ(finer->getNumChromaBins(), 24);
+    EXPECT_FALSE(plain->usesHarmonicWeighting());
+}
+
+TEST_F(ChromaPlanTest, ConstructorValidatesArguments) {
+    EXPECT_THROW(ChromaPlan(0.0, 512, 12, false), std::invalid_argument);
+    EXPECT_THROW(ChromaPlan(22050.0, 1, 12, false), std::invalid_argument);
+    EXPECT_THROW(ChromaPlan(22050.0, 512, 0, false), std::invalid_argument);
+}
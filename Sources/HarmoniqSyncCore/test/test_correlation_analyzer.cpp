@@ -0,0 +1,181 @@
+//
+//  test_correlation_analyzer.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for single-pass correlation statistics and peak extraction
+//
+
+#include <gtest/gtest.h>
+#include "../include/correlation_analyzer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class CorrelationAnalyzerTest : public ::testing::Test {
+protected:
+    static std::vector<double> noise(size_t length, unsigned seed, double scale = 0.1) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<double> value(0.0, scale);
+
+        std::vector<double> values(length);
+        for (double& v : values) {
+            v = value(gen);
+        }
+        return values;
+    }
+
+    // Triangular lobe of the given height and half-width centred on `center`
+    static void addLobe(std::vector<double>& values, size_t center, double height, size_t halfWidth) {
+        for (size_t i = center - halfWidth; i <= center + halfWidth; ++i) {
+            double distance = std::abs(static_cast<double>(i) - static_cast<double>(center));
+            values[i] = std::max(values[i], height * (1.0 - distance / (halfWidth + 1)));
+        }
+    }
+
+    static double exactAbsQuantile(std::vector<double> values, double fraction) {
+        for (double& v : values) v = std::abs(v);
+        size_t rank = std::min(values.size() - 1, static_cast<size_t>(values.size() * fraction));
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    }
+};
+
+// MARK: - Peak Tests
+
+TEST_F(CorrelationAnalyzerTest, SecondaryPeakIsOutsideExclusionZone) {
+    std::vector<double> values = noise(1000, 1, 0.01);
+    addLobe(values, 300, 1.0, 8);
+    addLobe(values, 700, 0.5, 8);
+
+    CorrelationAnalyzer analysis(4, 10);
+    analysis.analyze(values);
+
+    const auto& peaks = analysis.getPeaks();
+    ASSERT_GE(peaks.size(), 2u);
+    EXPECT_EQ(peaks[0].index, 300u);
+    EXPECT_DOUBLE_EQ(peaks[0].value, 1.0);
+
+    // Not the shoulder of the main lobe, but the second lobe
+    EXPECT_EQ(peaks[1].index, 700u);
+    EXPECT_DOUBLE_EQ(peaks[1].value, 0.5);
+
+    for (size_t i = 0; i < peaks.size(); ++i) {
+        for (size_t j = i + 1; j < peaks.size(); ++j) {
+            EXPECT_GT(std::max(peaks[i].index, peaks[j].index) - std::min(peaks[i].index, peaks[j].index), 10u);
+            EXPECT_GE(peaks[i].value, peaks[j].value);
+        }
+    }
+}
+
+TEST_F(CorrelationAnalyzerTest, KeepsStrongestPeaksInOrder) {
+    std::vector<double> values(200, 0.0);
+    const double heights[] = {0.3, 0.9, 0.1, 0.6, 0.8, 0.2};
+    for (size_t k = 0; k < 6; ++k) {
+        values[20 + 30 * k] = heights[k];
+    }
+
+    CorrelationAnalyzer analysis(3, 5);
+    analysis.analyze(values);
+
+    const auto& peaks = analysis.getPeaks();
+    ASSERT_EQ(peaks.size(), 3u);
+    EXPECT_EQ(peaks[0].index, 50u);
+    EXPECT_EQ(peaks[1].index, 140u);
+    EXPECT_EQ(peaks[2].index, 110u);
+}
+
+TEST_F(CorrelationAnalyzerTest, PrimaryIsFirstGlobalMaximum) {
+    std::vector<double> values = {0.2, 0.5, 0.5, 0.1, 0.0, 0.5, 0.3};
+    CorrelationAnalyzer analysis(4, 0);
+    analysis.analyze(values);
+
+    auto expected = std::max_element(values.begin(), values.end()) - values.begin();
+    ASSERT_FALSE(analysis.getPeaks().empty());
+    EXPECT_EQ(analysis.getPeaks()[0].index, static_cast<size_t>(expected));
+    EXPECT_EQ(analysis.getPeaks()[1].index, 5u);
+}
+
+TEST_F(CorrelationAnalyzerTest, CurveEndsCanBePeaks) {
+    CorrelationAnalyzer analysis(2, 1);
+    analysis.analyze({0.9, 0.5, 0.1, 0.2, 0.7});
+    ASSERT_EQ(analysis.getPeaks().size(), 2u);
+    EXPECT_EQ(analysis.getPeaks()[0].index, 0u);
+    EXPECT_EQ(analysis.getPeaks()[1].index, 4u);
+
+    analysis.analyze({0.4});
+    ASSERT_EQ(analysis.getPeaks().size(), 1u);
+    EXPECT_EQ(analysis.getPeaks()[0].index, 0u);
+
+    analysis.analyze({});
+    EXPECT_TRUE(analysis.getPeaks().empty());
+    EXPECT_EQ(analysis.rms(), 0.0);
+    EXPECT_EQ(analysis.absQuantile(0.5), 0.0);
+}
+
+// MARK: - Statistics Tests
+
+TEST_F(CorrelationAnalyzerTest, MomentsMatchDirectSums) {
+    auto values = noise(5000, 2);
+    CorrelationAnalyzer analysis(2, 10);
+    analysis.analyze(values);
+
+    double squares = 0.0, absolute = 0.0;
+    for (double v : values) {
+        squares += v * v;
+        absolute += std::abs(v);
+    }
+    EXPECT_EQ(analysis.size(), values.size());
+    EXPECT_NEAR(analysis.rms(), std::sqrt(squares / values.size()), 1e-12);
+    EXPECT_NEAR(analysis.meanAbs(), absolute / values.size(), 1e-12);
+}
+
+TEST_F(CorrelationAnalyzerTest, QuantilesAreWithinBucketResolution) {
+    for (double scale : {1e-6, 0.1, 5.0}) {
+        auto values = noise(20000, 3, scale);
+        CorrelationAnalyzer analysis(2, 10);
+        analysis.analyze(values);
+
+        for (double fraction : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+            double exact = exactAbsQuantile(values, fraction);
+            EXPECT_NEAR(analysis.absQuantile(fraction), exact, 0.035 * exact)
+                << "scale " << scale << " fraction " << fraction;
+        }
+    }
+}
+
+TEST_F(CorrelationAnalyzerTest, NoiseQuantileLeavesOutPrimaryLobe) {
+    auto values = noise(2001, 4, 0.01);
+    addLobe(values, 1000, 1.0, 50);
+
+    CorrelationAnalyzer analysis(2, 60);
+    analysis.analyze(values);
+
+    std::vector<double> outside(values.begin(), values.begin() + 940);
+    outside.insert(outside.end(), values.begin() + 1061, values.end());
+    double exact = exactAbsQuantile(outside, 0.5);
+
+    EXPECT_NEAR(analysis.noiseQuantile(0.5), exact, 0.035 * exact);
+    EXPECT_GT(analysis.absQuantile(0.5), analysis.noiseQuantile(0.5));
+}
+
+TEST_F(CorrelationAnalyzerTest, ChunkedPushMatchesWholeCurve) {
+    auto values = noise(3000, 5);
+    addLobe(values, 1500, 2.0, 4);
+
+    CorrelationAnalyzer whole(4, 10), chunked(4, 10);
+    whole.analyze(values);
+    for (size_t start = 0; start < values.size(); start += 317) {
+        chunked.push(values.data() + start, std::min<size_t>(317, values.size() - start));
+    }
+    chunked.finish();
+
+    ASSERT_EQ(chunked.getPeaks().size(), whole.getPeaks().size());
+    for (size_t i = 0; i < whole.getPeaks().size(); ++i) {
+        EXPECT_EQ(chunked.getPeaks()[i].index, whole.getPeaks()[i].index);
+    }
+    EXPECT_DOUBLE_EQ(chunked.absQuantile(0.1), whole.absQuantile(0.1));
+    EXPECT_NEAR(chunked.rms(), whole.rms(), 1e-12);
+}
@@ -0,0 +1,471 @@
+//
+//  test_correlation_engine.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for CorrelationEngine kernels
+//
+
+#include <gtest/gtest.h>
+#include "../include/correlation_engine.hpp"
+#include <vector>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+using namespace HarmoniqSync;
+
+class CorrelationEngineTest : public ::testing::Test {
+protected:
+    // Generate reproducible random feature vector
+    std::vector<float> generateFeatures(size_t length, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+
+        std::vector<float> features(length);
+        for (float& value : features) {
+            value = dis(gen);
+        }
+        return features;
+    }
+
+    CorrelationEngine engine;
+};
+
+// MARK: - Kernel Equivalence Tests
+
+TEST_F(CorrelationEngineTest, FFTMatchesDirectForEqualLengths) {
+    auto a = generateFeatures(1000, 1);
+    auto b = generateFeatures(1000, 2);
+
+    auto direct = engine.crossCorrelate(a, b, CorrelationEngine::Mode::Direct);
+    auto fft = engine.crossCorrelate(a, b, CorrelationEngine::Mode::FFT);
+
+    ASSERT_EQ(direct.size(), 2 * 1000 - 1);
+    ASSERT_EQ(fft.size(), direct.size());
+
+    for (size_t i = 0; i < direct.size(); ++i) {
+        EXPECT_NEAR(fft[i], direct[i], 1e-6) << "Mismatch at lag index " << i;
+    }
+}
+
+TEST_F(CorrelationEngineTest, FFTMatchesDirectForDifferentLengths) {
+    // Reference shorter and longer than target, including non power-of-two sizes
+    std::vector<std::pair<size_t, size_t>> lengths = {{300, 777}, {777, 300}, {1, 50}, {129, 128}};
+
+    for (const auto& [lengthA, lengthB] : lengths) {
+        auto a = generateFeatures(lengthA, 3);
+        auto b = generateFeatures(lengthB, 4);
+
+        auto direct = engine.crossCorrelate(a, b, CorrelationEngine::Mode::Direct);
+        auto fft = engine.crossCorrelate(a, b, CorrelationEngine::Mode::FFT);
+
+        ASSERT_EQ(direct.size(), 2 * std::min(lengthA, lengthB) - 1);
+        ASSERT_EQ(fft.size(), direct.size());
+
+        for (size_t i = 0; i < direct.size(); ++i) {
+            EXPECT_NEAR(fft[i], direct[i], 1e-6)
+                << "Mismatch at lag index " << i << " for " << lengthA << "x" << lengthB;
+        }
+    }
+}
+
+TEST_F(CorrelationEngineTest, PeakAtKnownLag) {
+    // Target is the reference delayed by 37 frames
+    auto a = generateFeatures(2000, 5);
+    std::vector<float> b(37, 0.0f);
+    b.insert(b.end(), a.begin(), a.end() - 37);
+
+    auto correlation = engine.crossCorrelate(a, b, CorrelationEngine::Mode::FFT);
+    auto peak = std::max_element(correlation.begin(), correlation.end()) - correlation.begin();
+
+    EXPECT_EQ(static_cast<int64_t>(peak) - (2000 - 1), 37);
+}
+
+// MARK: - Bounded Lag Window Tests
+
+TEST_F(CorrelationEngineTest, BoundedWindowMatchesFullRange) {
+    auto a = generateFeatures(1500, 7);
+    auto b = generateFeatures(1200, 8);
+    const size_t maxLag = 100;
+
+    auto full = engine.crossCorrelate(a, b, CorrelationEngine::Mode::Direct);
+    const size_t fullCenter = 1200 - 1;
+
+    for (auto mode : {CorrelationEngine::Mode::Direct, CorrelationEngine::Mode::FFT}) {
+        auto bounded = engine.crossCorrelate(a, b, maxLag, mode);
+        ASSERT_EQ(bounded.size(), 2 * maxLag + 1);
+
+        for (size_t i = 0; i < bounded.size(); ++i) {
+            EXPECT_NEAR(bounded[i], full[fullCenter - maxLag + i], 1e-6) << "Mismatch at lag index " << i;
+        }
+    }
+}
+
+TEST_F(CorrelationEngineTest, WindowClampedToOverlap) {
+    auto a = generateFeatures(50, 9);
+    auto b = generateFeatures(80, 10);
+
+    EXPECT_EQ(CorrelationEngine::lagWindow(50, 80, 1000), 49u);
+    EXPECT_EQ(CorrelationEngine::lagWindow(50, 80, 10), 10u);
+    EXPECT_EQ(engine.crossCorrelate(a, b, 1000).size(), 2 * 49 + 1);
+    EXPECT_EQ(engine.crossCorrelate(a, b, 0).size(), 1u);
+}
+
+TEST_F(CorrelationEngineTest, PeakOutsideWindowIsIgnored) {
+    // Target is the reference delayed by 300 frames, window only reaches 50
+    auto a = generateFeatures(2000, 11);
+    std::vector<float> b(300, 0.0f);
+    b.insert(b.end(), a.begin(), a.end() - 300);
+
+    auto correlation = engine.crossCorrelate(a, b, 50, CorrelationEngine::Mode::FFT);
+    ASSERT_EQ(correlation.size(), 101u);
+
+    auto peak = std::max_element(correlation.begin(), correlation.end()) - correlation.begin();
+    EXPECT_NE(static_cast<int64_t>(peak) - 50, 300);
+}
+
+TEST_F(CorrelationEngineTest, RangeMatchesSymmetricWindow) {
+    auto a = generateFeatures(300, 13);
+    auto b = generateFeatures(250, 14);
+
+    const size_t window = 60;
+    auto symmetric = engine.crossCorrelate(a, b, window, CorrelationEngine::Mode::Direct);
+    auto range = engine.crossCorrelateRange(a, b, 10, 40);
+
+    ASSERT_EQ(range.size(), 31u);
+    for (size_t i = 0; i < range.size(); ++i) {
+        EXPECT_DOUBLE_EQ(range[i], symmetric[window + 10 + i]) << "Lag " << 10 + i;
+    }
+}
+
+TEST_F(CorrelationEngineTest, RangeWithoutOverlapIsZero) {
+    auto a = generateFeatures(50, 15);
+    auto b = generateFeatures(50, 16);
+
+    auto range = engine.crossCorrelateRange(a, b, 48, 52);
+    ASSERT_EQ(range.size(), 5u);
+    EXPECT_NE(range[0], 0.0);
+    EXPECT_EQ(range[2], 0.0);
+    EXPECT_EQ(range[4], 0.0);
+    EXPECT_TRUE(engine.crossCorrelateRange(a, b, 5, 4).empty());
+}
+
+TEST_F(CorrelationEngineTest, SpectrumCacheMatchesUncached) {
+    auto a = generateFeatures(900, 12);
+    CorrelationEngine::SpectrumCache cache;
+
+    for (unsigned seed : {13u, 14u}) {
+        auto b = generateFeatures(900, seed);
+        auto uncached = engine.crossCorrelate(a, b, 200, CorrelationEngine::Mode::FFT);
+        auto cached = engine.crossCorrelate(a, b, 200, CorrelationEngine::Mode::FFT, &cache);
+
+        ASSERT_EQ(cached.size(), uncached.size());
+        for (size_t i = 0; i < cached.size(); ++i) {
+            EXPECT_DOUBLE_EQ(cached[i], uncached[i]);
+        }
+    }
+
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+// MARK: - Multichannel Tests
+
+TEST_F(CorrelationEngineTest, MultichannelMatchesWeightedPerDimensionMean) {
+    const size_t dims = 4;
+    const size_t framesA = 400, framesB = 350;
+    auto a = generateFeatures(framesA * dims, 21);
+    auto b = generateFeatures(framesB * dims, 22);
+    const std::vector<double> weights = {1.0, 0.0, 2.0, 0.5};
+
+    // Per-dimension reference: de-interleave, correlate, weighted mean
+    std::vector<double> expected;
+    for (size_t dim = 0; dim < dims; ++dim) {
+        std::vector<float> columnA, columnB;
+        for (size_t i = dim; i < a.size(); i += dims) columnA.push_back(a[i]);
+        for (size_t i = dim; i < b.size(); i += dims) columnB.push_back(b[i]);
+
+        auto correlation = engine.crossCorrelate(columnA, columnB, 100, CorrelationEngine::Mode::Direct);
+        expected.resize(correlation.size(), 0.0);
+        for (size_t k = 0; k < correlation.size(); ++k) {
+            expected[k] += correlation[k] * weights[dim] / 3.5;
+        }
+    }
+
+    // Same matrices stored dimension-major
+    std::vector<float> planarA(a.size()), planarB(b.size());
+    for (size_t i = 0; i < a.size(); ++i) planarA[(i % dims) * framesA + i / dims] = a[i];
+    for (size_t i = 0; i < b.size(); ++i) planarB[(i % dims) * framesB + i / dims] = b[i];
+
+    for (auto mode : {CorrelationEngine::Mode::Direct, CorrelationEngine::Mode::FFT}) {
+        auto interleaved = engine.crossCorrelateMultichannel(a, b, dims, 100, CorrelationEngine::Layout::FrameMajor,
+                                                             weights, mode);
+        auto planar = engine.crossCorrelateMultichannel(planarA, planarB, dims, 100,
+                                                        CorrelationEngine::Layout::DimensionMajor, weights, mode);
+        ASSERT_EQ(interleaved.size(), expected.size());
+        ASSERT_EQ(planar.size(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            EXPECT_NEAR(interleaved[k], expected[k], 1e-6) << "Frame-major mismatch at lag index " << k;
+            EXPECT_NEAR(planar[k], expected[k], 1e-6) << "Dimension-major mismatch at lag index " << k;
+        }
+    }
+}
+
+TEST_F(CorrelationEngineTest, MultichannelPeakAtKnownLag) {
+    const size_t dims = 12;
+    const size_t lag = 37;
+    auto a = generateFeatures(500 * dims, 23);
+
+    // Target starts `lag` frames into the reference
+    std::vector<float> b(a.begin() + lag * dims, a.end());
+
+    auto correlation = engine.crossCorrelateMultichannel(a, b, dims, 100);
+    size_t peak = std::max_element(correlation.begin(), correlation.end()) - correlation.begin();
+    EXPECT_EQ(static_cast<int64_t>(peak) - 100, -static_cast<int64_t>(lag));
+}
+
+TEST_F(CorrelationEngineTest, MultichannelSpectrumCacheMatchesUncached) {
+    const size_t dims = 3;
+    auto a = generateFeatures(600 * dims, 24);
+    CorrelationEngine::SpectrumCache cache;
+
+    for (unsigned seed = 25; seed < 28; ++seed) {
+        auto b = generateFeatures(600 * dims, seed);
+        auto cached = engine.crossCorrelateMultichannel(a, b, dims, 200, CorrelationEngine::Layout::FrameMajor,
+                                                        {}, CorrelationEngine::Mode::FFT, &cache);
+        auto uncached = engine.crossCorrelateMultichannel(a, b, dims, 200, CorrelationEngine::Layout::FrameMajor,
+                                                          {}, CorrelationEngine::Mode::FFT);
+        ASSERT_EQ(cached, uncached);
+    }
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(CorrelationEngineTest, MultichannelValidatesArguments) {
+    auto a = generateFeatures(40, 29);
+
+    EXPECT_THROW(engine.crossCorrelateMultichannel(a, a, 0, 10), std::invalid_argument);
+    EXPECT_THROW(engine.crossCorrelateMultichannel(a, a, 4, 10, CorrelationEngine::Layout::FrameMajor, {1.0, 2.0}),
+                 std::invalid_argument);
+    EXPECT_TRUE(engine.crossCorrelateMultichannel(a, a, 4, 10, CorrelationEngine::Layout::FrameMajor,
+                                                  {0.0, 0.0, 0.0, 0.0}).empty());
+    EXPECT_TRUE(engine.crossCorrelateMultichannel(a, {}, 4, 10).empty());
+}
+
+// MARK: - Phase Transform Tests
+
+TEST_F(CorrelationEngineTest, PHATPeaksAtKnownLag) {
+    // Target is the reference delayed by 23 samples
+    auto a = generateFeatures(4096, 17);
+    std::vector<float> b(23, 0.0f);
+    b.insert(b.end(), a.begin(), a.end() - 23);
+
+    auto correlation = engine.crossCorrelatePHAT(a, b, 64);
+    ASSERT_EQ(correlation.size(), 129u);
+
+    auto peak = std::max_element(correlation.begin(), correlation.end()) - correlation.begin();
+    EXPECT_EQ(static_cast<int64_t>(peak) - 64, 23);
+}
+
+TEST_F(CorrelationEngineTest, PHATSelfMatchIsUnitPeak) {
+    auto a = generateFeatures(2048, 18);
+
+    auto correlation = engine.crossCorrelatePHAT(a, a, 16);
+    ASSERT_EQ(correlation.size(), 33u);
+    EXPECT_NEAR(correlation[16], 1.0, 1e-6);
+    EXPECT_TRUE(engine.crossCorrelatePHAT(a, {}, 16).empty());
+}
+
+// MARK: - Precision Tests
+
+TEST_F(CorrelationEngineTest, SinglePrecisionMatchesDouble) {
+    auto a = generateFeatures(20000, 31);
+    auto b = generateFeatures(18000, 32);
+
+    CorrelationEngine single;
+    single.setPrecision(CorrelationEngine::Precision::Single);
+    EXPECT_EQ(single.getPrecision(), CorrelationEngine::Precision::Single);
+
+    for (auto mode : {CorrelationEngine::Mode::Direct, CorrelationEngine::Mode::FFT}) {
+        auto expected = engine.crossCorrelate(a, b, 300, mode);
+        auto actual = single.crossCorrelate(a, b, 300, mode);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            EXPECT_NEAR(actual[k], expected[k], 1e-5) << "Mismatch at lag index " << k;
+        }
+    }
+}
+
+TEST_F(CorrelationEngineTest, SinglePrecisionLongSumStaysAccurate) {
+    // A plain float running sum of a million equal products drifts by percent
+    std::vector<float> a(1 << 20, 0.1f);
+
+    CorrelationEngine single;
+    single.setPrecision(CorrelationEngine::Precision::Single);
+    auto expected = engine.crossCorrelateRange(a, a, 0, 0);
+    auto actual = single.crossCorrelateRange(a, a, 0, 0);
+    ASSERT_EQ(actual.size(), 1u);
+    EXPECT_NEAR(actual[0], expected[0], expected[0] * 1e-6);
+}
+
+TEST_F(CorrelationEngineTest, SinglePrecisionMultichannelMatchesDouble) {
+    const size_t dims = 13;
+    auto a = generateFeatures(3000 * dims, 33);
+    auto b = generateFeatures(2800 * dims, 34);
+    const std::vector<double> weights = {1.0, 0.5, 2.0, 0.0, 1.0, 1.0, 1.0, 3.0, 1.0, 1.0, 0.2, 1.0, 1.0};
+
+    CorrelationEngine single;
+    single.setPrecision(CorrelationEngine::Precision::Single);
+
+    for (auto layout : {CorrelationEngine::Layout::FrameMajor, CorrelationEngine::Layout::DimensionMajor}) {
+        for (auto mode : {CorrelationEngine::Mode::Direct, CorrelationEngine::Mode::FFT}) {
+            auto expected = engine.crossCorrelateMultichannel(a, b, dims, 200, layout, weights, mode);
+            auto actual = single.crossCorrelateMultichannel(a, b, dims, 200, layout, weights, mode);
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t k = 0; k < expected.size(); ++k) {
+                EXPECT_NEAR(actual[k], expected[k], 1e-5) << "Mismatch at lag index " << k;
+            }
+        }
+    }
+}
+
+TEST_F(CorrelationEngineTest, SpectrumCacheKeepsPrecisionsApart) {
+    auto a = generateFeatures(900, 35);
+    auto b = generateFeatures(900, 36);
+    CorrelationEngine::SpectrumCache cache;
+
+    CorrelationEngine single;
+    single.setPrecision(CorrelationEngine::Precision::Single);
+
+    auto doubleCached = engine.crossCorrelate(a, b, 200, CorrelationEngine::Mode::FFT, &cache);
+    auto singleUncached = single.crossCorrelate(a, b, 200, CorrelationEngine::Mode::FFT);
+    auto singleCached = single.crossCorrelate(a, b, 200, CorrelationEngine::Mode::FFT, &cache);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(singleCached, singleUncached);
+    EXPECT_EQ(engine.crossCorrelate(a, b, 200, CorrelationEngine::Mode::FFT, &cache), doubleCached);
+}
+
+// MARK: - Partitioned Kernel Tests
+
+TEST_F(CorrelationEngineTest, PartitionedMatchesWholeSignalKernel) {
+    // Reference shorter and longer than target, full and bounded lag windows
+    struct Case { size_t lengthA, lengthB, maxLag, partition; };
+    std::vector<Case> cases = {
+        {1000, 1000, CorrelationEngine::UNBOUNDED_LAG, 64},
+        {300, 777, CorrelationEngine::UNBOUNDED_LAG, 128},
+        {777, 300, 100, 16},
+        {2000, 1500, 37, 256},
+        {20000, 18000, 300, 64},
+        {5, 9, CorrelationEngine::UNBOUNDED_LAG, 2}
+    };
+
+    for (const auto& test : cases) {
+        auto a = generateFeatures(test.lengthA, 41);
+        auto b = generateFeatures(test.lengthB, 42);
+        auto expected = engine.crossCorrelate(a, b, test.maxLag, CorrelationEngine::Mode::Direct);
+
+        std::vector<double> streamed;
+        size_t blocks = 0;
+        engine.crossCorrelatePartitioned(a, b, test.maxLag, test.partition, [&](const double* values, size_t count) {
+            EXPECT_LE(count, test.partition);
+            streamed.insert(streamed.end(), values, values + count);
+            ++blocks;
+        });
+
+        ASSERT_EQ(streamed.size(), expected.size()) << test.lengthA << " x " << test.lengthB;
+        EXPECT_EQ(blocks, (expected.size() + test.partition - 1) / test.partition);
+        for (size_t k = 0; k < expected.size(); ++k) {
+            EXPECT_NEAR(streamed[k], expected[k], 1e-6) << "Mismatch at lag index " << k;
+        }
+    }
+}
+
+TEST_F(CorrelationEngineTest, PartitionedCachesReferencePartitions) {
+    auto a = generateFeatures(3000, 43);
+    auto b = generateFeatures(2500, 44);
+    CorrelationEngine::SpectrumCache cache;
+
+    auto collect = [&](const CorrelationEngine& kernel, CorrelationEngine::SpectrumCache* spectra) {
+        std::vector<double> values;
+        kernel.crossCorrelatePartitioned(a, b, 500, 256, [&](const double* block, size_t count) {
+            values.insert(values.end(), block, block + count);
+        }, spectra);
+        return values;
+    };
+
+    auto uncached = collect(engine, nullptr);
+    EXPECT_EQ(collect(engine, &cache), uncached);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(collect(engine, &cache), uncached);
+
+    // Partition spectra do not collide with the whole-signal transform of the same reference
+    auto whole = engine.crossCorrelate(a, b, 500, CorrelationEngine::Mode::FFT, &cache);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(whole, engine.crossCorrelate(a, b, 500, CorrelationEngine::Mode::FFT));
+
+    // Single precision keeps its own partitions and stays close to double
+    CorrelationEngine single;
+    single.setPrecision(CorrelationEngine::Precision::Single);
+    auto singleValues = collect(single, &cache);
+    EXPECT_EQ(cache.size(), 3u);
+    ASSERT_EQ(singleValues.size(), uncached.size());
+    for (size_t k = 0; k < uncached.size(); ++k) {
+        EXPECT_NEAR(singleValues[k], uncached[k], 1e-4) << "Mismatch at lag index " << k;
+    }
+}
+
+TEST_F(CorrelationEngineTest, PartitionLengthFollowsMemoryBudget) {
+    auto noop = [](const double*, size_t) {};
+    auto a = generateFeatures(10, 45);
+    EXPECT_THROW(engine.crossCorrelatePartitioned(a, a, 4, 3, noop), std::invalid_argument);
+    EXPECT_THROW(engine.crossCorrelatePartitioned(a, a, 4, 1, noop), std::invalid_argument);
+
+    const size_t frames = 1 << 20;
+    const size_t maxLag = frames / 8;
+
+    // No budget, or one the whole-signal kernel fits, needs no partitions
+    EXPECT_EQ(CorrelationEngine::partitionLengthForBudget(frames, frames, maxLag, 0), 0u);
+    EXPECT_EQ(CorrelationEngine::partitionLengthForBudget(frames, frames, maxLag, size_t(1) << 30), 0u);
+
+    // A tighter budget picks a power of two; a smaller budget never picks a longer partition
+    size_t loose = CorrelationEngine::partitionLengthForBudget(frames, frames, maxLag, size_t(48) << 20);
+    size_t tight = CorrelationEngine::partitionLengthForBudget(frames, frames, maxLag, size_t(24) << 20);
+    ASSERT_GT(loose, 0u);
+    ASSERT_GT(tight, 0u);
+    EXPECT_EQ(loose & (loose - 1), 0u);
+    EXPECT_LE(tight, loose);
+    EXPECT_LE(CorrelationEngine::workingBytes(frames, frames, maxLag, tight), size_t(24) << 20);
+
+    // Single precision halves the value bytes, so it fits a longer partition or none at all
+    size_t single = CorrelationEngine::partitionLengthForBudget(frames, frames, maxLag, size_t(24) << 20,
+                                                                CorrelationEngine::Precision::Single);
+    EXPECT_TRUE(single == 0 || single >= tight);
+
+    // Partitioned memory follows the lag window, not the input lengths
+    EXPECT_EQ(CorrelationEngine::workingBytes(frames, frames, maxLag, tight),
+              CorrelationEngine::workingBytes(16 * frames, 16 * frames, maxLag, tight));
+
+    // Over an unbounded lag window the partitions hold as much as the whole-signal kernel
+    EXPECT_EQ(CorrelationEngine::partitionLengthForBudget(frames, frames, CorrelationEngine::UNBOUNDED_LAG,
+                                                          size_t(24) << 20), 0u);
+}
+
+// MARK: - Mode Selection Tests
+
+TEST_F(CorrelationEngineTest, AutoModeSelection) {
+    EXPECT_FALSE(CorrelationEngine::shouldUseFFT(32, 32));
+    EXPECT_FALSE(CorrelationEngine::shouldUseFFT(10, 100000));
+    EXPECT_TRUE(CorrelationEngine::shouldUseFFT(4096, 4096));
+    EXPECT_TRUE(CorrelationEngine::shouldUseFFT(1000000, 1000000));
+
+    // A narrow lag window makes the direct loop cheaper again
+    EXPECT_FALSE(CorrelationEngine::shouldUseFFT(4096, 4096, 4));
+}
+
+TEST_F(CorrelationEngineTest, EmptyInputReturnsEmpty) {
+    std::vector<float> empty;
+    auto a = generateFeatures(10, 6);
+
+    EXPECT_TRUE(engine.crossCorrelate(empty, a).empty());
+    EXPECT_TRUE(engine.crossCorrelate(a, empty).empty());
+}
@@ -0,0 +1,383 @@
+//
+//  test_cost_model.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for calibrated cost prediction and job admission
+//
+
+#include <gtest/gtest.h>
+#include "../include/cost_model.hpp"
+#include "../include/sync_engine.hpp"
+#include "../include/harmoniq_sync.h"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class CostModelTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::string name = std::string("harmoniq_cost_profile_") +
+                           ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        path = (std::filesystem::temp_directory_path() / name).string();
+        std::filesystem::remove(path);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+        CostModel::setShared(nullptr);
+    }
+
+    CostModel::Job makeJob(harmoniq_sync_method_t method, double seconds) const {
+        CostModel::Job job;
+        job.method = method;
+        job.sampleRate = sampleRate;
+        job.referenceSamples = static_cast<size_t>(seconds * sampleRate);
+        job.targetSamples = job.referenceSamples;
+        return job;
+    }
+
+    // Runs whose stage times follow known coefficients, with lognormal wall time noise
+    std::vector<CostModel::Sample> syntheticRuns(harmoniq_sync_method_t method, double secondsPerUnit,
+                                                 double wallFactor, double logError, unsigned seed) const {
+        std::mt19937 gen(seed);
+        std::normal_distribution<double> noise(0.0, logError);
+        std::vector<CostModel::Sample> samples;
+        for (double seconds : {5.0, 10.0, 20.0, 40.0, 80.0, 160.0}) {
+            for (int window : {512, 1024, 2048}) {
+                CostModel::Sample sample;
+                sample.job = makeJob(method, seconds);
+                sample.job.windowSize = window;
+                sample.job.hopSize = window / 4;
+
+                auto work = CostModel::measureWork(sample.job);
+                double total = 0.0;
+                for (size_t s = 0; s < PROCESSING_STAGE_COUNT; ++s) {
+                    sample.stages.stageSeconds[s] = secondsPerUnit * static_cast<double>(s + 1) * work.units[s];
+                    total += sample.stages.stageSeconds[s];
+                }
+                sample.stages.peakAllocatedBytes = static_cast<size_t>(0.8 * work.featureBytes);
+                sample.wallSeconds = wallFactor * total * std::exp(noise(gen));
+                samples.push_back(sample);
+            }
+        }
+        return samples;
+    }
+
+    // Noise under a random gain every quarter second, so the envelope never repeats
+    std::vector<float> generateSignal(size_t numSamples, unsigned seed) const {
+        std::mt19937 gen(seed);
+        std::normal_distribution<float> dis(0.0f, 0.3f);
+        std::uniform_real_distribution<float> level(0.1f, 1.0f);
+        const size_t segment = static_cast<size_t>(0.25 * sampleRate);
+        std::vector<float> signal(numSamples);
+        float gain = level(gen);
+        for (size_t i = 0; i < numSamples; ++i) {
+            if (i % segment == 0) gain = level(gen);
+            signal[i] = gain * dis(gen);
+        }
+        return signal;
+    }
+
+    const double sampleRate = 22050.0;
+    std::string path;
+};
+
+// MARK: - Work
+
+TEST_F(CostModelTest, WorkFollowsTheEnginesChoices) {
+    auto shortJob = makeJob(HARMONIQ_SYNC_SPECTRAL_FLUX, 10.0);
+    auto longJob = makeJob(HARMONIQ_SYNC_SPECTRAL_FLUX, 40.0);
+    auto shortWork = CostModel::measureWork(shortJob);
+    auto longWork = CostModel::measureWork(longJob);
+
+    size_t load = static_cast<size_t>(ProcessingStage::LoadValidate);
+    size_t stft = static_cast<size_t>(ProcessingStage::STFT);
+    size_t resample = static_cast<size_t>(ProcessingStage::Resample);
+    size_t drift = static_cast<size_t>(ProcessingStage::DriftEstimation);
+    EXPECT_DOUBLE_EQ(longWork.units[load], 4.0 * shortWork.units[load]);
+    EXPECT_NEAR(longWork.units[stft] / shortWork.units[stft], 4.0, 0.05);
+    EXPECT_EQ(shortWork.units[resample], 0.0);
+    EXPECT_EQ(shortWork.units[drift], 0.0);
+
+    // Energy needs no spectrogram; decimation and drift add their stages
+    auto energy = CostModel::measureWork(makeJob(HARMONIQ_SYNC_ENERGY, 10.0));
+    EXPECT_EQ(energy.units[stft], 0.0);
+    EXPECT_EQ(energy.featureBytes, 0.0);
+
+    auto decimated = shortJob;
+    decimated.sampleRate = 48000.0;
+    decimated.analysisSampleRate = 16000.0;
+    decimated.driftCorrection = true;
+    auto decimatedWork = CostModel::measureWork(decimated);
+    EXPECT_GT(decimatedWork.units[resample], 0.0);
+    EXPECT_GT(decimatedWork.units[drift], 0.0);
+
+    // Hybrid extracts every stream, so it does at least the work of each single method
+    auto hybrid = CostModel::measureWork(makeJob(HARMONIQ_SYNC_HYBRID, 10.0));
+    auto mfcc = CostModel::measureWork(makeJob(HARMONIQ_SYNC_MFCC, 10.0));
+    size_t correlation = static_cast<size_t>(ProcessingStage::Correlation);
+    EXPECT_GT(hybrid.units[correlation], mfcc.units[correlation]);
+    EXPECT_GT(hybrid.featureBytes, mfcc.featureBytes);
+
+    // A bounded search correlates fewer lags
+    auto bounded = shortJob;
+    bounded.maxOffsetSamples = static_cast<int64_t>(sampleRate);
+    size_t peak = static_cast<size_t>(ProcessingStage::PeakPicking);
+    EXPECT_LT(CostModel::measureWork(bounded).units[peak], shortWork.units[peak]);
+}
+
+TEST_F(CostModelTest, CorrelationMemoryBudgetBoundsBuffers) {
+    // Three hours of flux: the whole-signal correlation needs far more than the budget
+    auto whole = makeJob(HARMONIQ_SYNC_SPECTRAL_FLUX, 3.0 * 3600.0);
+    auto partitioned = whole;
+    partitioned.correlationMemoryBytes = size_t(16) << 20;
+
+    auto wholeWork = CostModel::measureWork(whole);
+    auto partitionedWork = CostModel::measureWork(partitioned);
+    size_t correlation = static_cast<size_t>(ProcessingStage::Correlation);
+    size_t peak = static_cast<size_t>(ProcessingStage::PeakPicking);
+
+    EXPECT_LT(partitionedWork.bufferBytes, wholeWork.bufferBytes);
+    EXPECT_GT(partitionedWork.units[correlation], 0.0);
+    EXPECT_DOUBLE_EQ(partitionedWork.units[peak], wholeWork.units[peak]);
+    EXPECT_DOUBLE_EQ(partitionedWork.featureBytes, wholeWork.featureBytes);
+
+    // A budget the whole-signal kernel fits in changes nothing
+    partitioned.correlationMemoryBytes = size_t(1) << 30;
+    EXPECT_DOUBLE_EQ(CostModel::measureWork(partitioned).bufferBytes, wholeWork.bufferBytes);
+}
+
+// MARK: - Calibration
+
+TEST_F(CostModelTest, CalibrationRecoversCoefficients) {
+    auto samples = syntheticRuns(HARMONIQ_SYNC_CHROMA, 2e-9, 1.3, 0.1, 3);
+
+    CostModel model;
+    model.calibrate(samples, "test-machine");
+    EXPECT_EQ(model.getMachineClass(), "test-machine");
+
+    const auto& row = model.getCoefficients(HARMONIQ_SYNC_CHROMA);
+    EXPECT_EQ(row.samples, samples.size());
+    for (size_t s = 0; s < PROCESSING_STAGE_COUNT; ++s) {
+        if (CostModel::measureWork(samples[0].job).units[s] > 0.0) {
+            EXPECT_NEAR(row.secondsPerUnit[s], 2e-9 * static_cast<double>(s + 1), 1e-12) << "stage " << s;
+        }
+    }
+    EXPECT_NEAR(row.wallFactor, 1.3, 0.08);
+    EXPECT_NEAR(row.logError, 0.1, 0.04);
+    EXPECT_NEAR(row.memoryFactor, 0.8, 1e-6);
+
+    // Methods without runs keep their coefficients
+    CostModel builtin;
+    EXPECT_EQ(model.getCoefficients(HARMONIQ_SYNC_ENERGY).secondsPerUnit,
+              builtin.getCoefficients(HARMONIQ_SYNC_ENERGY).secondsPerUnit);
+    EXPECT_EQ(model.getCoefficients(HARMONIQ_SYNC_ENERGY).samples, 0u);
+}
+
+TEST_F(CostModelTest, BoundsCoverTheRequestedShareOfRuns) {
+    CostModel model;
+    model.calibrate(syntheticRuns(HARMONIQ_SYNC_MFCC, 1e-9, 1.0, 0.2, 5), "test-machine");
+
+    // Fresh runs from the same distribution stay under the 90% bound about 90% of the time
+    auto fresh = syntheticRuns(HARMONIQ_SYNC_MFCC, 1e-9, 1.0, 0.2, 11);
+    auto more = syntheticRuns(HARMONIQ_SYNC_MFCC, 1e-9, 1.0, 0.2, 12);
+    fresh.insert(fresh.end(), more.begin(), more.end());
+
+    size_t covered = 0;
+    for (const auto& sample : fresh) {
+        auto prediction = model.predict(sample.job, 0.9);
+        EXPECT_GT(prediction.upperSeconds, prediction.seconds);
+        covered += sample.wallSeconds <= prediction.upperSeconds;
+    }
+    double share = static_cast<double>(covered) / static_cast<double>(fresh.size());
+    EXPECT_GT(share, 0.75);
+    EXPECT_LT(share, 1.0);
+
+    auto job = makeJob(HARMONIQ_SYNC_MFCC, 30.0);
+    EXPECT_GT(model.predict(job, 0.99).upperSeconds, model.predict(job, 0.9).upperSeconds);
+}
+
+TEST_F(CostModelTest, CalibratedOnEngineRunsPredictsUnseenLengths) {
+    // Every run must succeed to be a calibration sample; the threshold does not change the work
+    harmoniq_sync_config_t config = harmoniq_sync_default_config();
+    config.confidence_threshold = 0.0;
+    SyncEngine engine;
+    engine.setConfig(config);
+
+    // Stage times follow known coefficients instead of the clock, so the fit is exact
+    // however loaded the machine is; memory comes from the runs themselves
+    auto injectTimes = [](CostModel::Sample& sample) {
+        auto work = CostModel::measureWork(sample.job);
+        double total = 0.0;
+        for (size_t s = 0; s < PROCESSING_STAGE_COUNT; ++s) {
+            sample.stages.stageSeconds[s] = 2e-9 * static_cast<double>(s + 1) * work.units[s];
+            total += sample.stages.stageSeconds[s];
+        }
+        sample.wallSeconds = 0.8 * total;
+    };
+
+    std::vector<CostModel::Sample> samples;
+    for (double seconds : {4.0, 8.0, 16.0, 32.0}) {
+        size_t length = static_cast<size_t>(seconds * sampleRate);
+        auto reference = generateSignal(length, 1);
+        auto target = generateSignal(length, 1);
+        auto result = engine.process(reference.data(), length, target.data(), length,
+                                     sampleRate, HARMONIQ_SYNC_SPECTRAL_FLUX);
+        ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS) << result.method;
+
+        CostModel::Sample sample;
+        sample.job = CostModel::Job::fromConfig(config, HARMONIQ_SYNC_SPECTRAL_FLUX, length, length, sampleRate);
+        sample.stages = engine.getLastProcessingStats().stages;
+        injectTimes(sample);
+        samples.push_back(sample);
+    }
+
+    auto model = std::make_shared<CostModel>();
+    model->calibrate(samples, "this-machine");
+    engine.setCostModel(model);
+    EXPECT_EQ(engine.getCostModel(), model);
+
+    size_t length = static_cast<size_t>(24.0 * sampleRate);
+    auto reference = generateSignal(length, 2);
+    auto target = generateSignal(length, 2);
+    auto prediction = engine.predictCost(length, length, sampleRate, HARMONIQ_SYNC_SPECTRAL_FLUX);
+    engine.process(reference.data(), length, target.data(), length, sampleRate, HARMONIQ_SYNC_SPECTRAL_FLUX);
+
+    CostModel::Sample unseen;
+    unseen.job = CostModel::Job::fromConfig(config, HARMONIQ_SYNC_SPECTRAL_FLUX, length, length, sampleRate);
+    injectTimes(unseen);
+    EXPECT_NEAR(prediction.seconds, unseen.wallSeconds, 0.05 * unseen.wallSeconds);
+    EXPECT_GE(prediction.peakBytes, engine.getLastProcessingStats().memoryUsedBytes);
+}
+
+// MARK: - Admission
+
+TEST_F(CostModelTest, AdmissionChecksDeadlineAndMemory) {
+    CostModel model;
+    auto job = makeJob(HARMONIQ_SYNC_HYBRID, 60.0);
+    auto prediction = model.predict(job, 0.95);
+    ASSERT_GT(prediction.seconds, 0.0);
+    ASSERT_GT(prediction.peakBytes, 0u);
+
+    auto unlimited = model.admit(job, 0.0, 0, 0.95);
+    EXPECT_TRUE(unlimited.admitted);
+    EXPECT_DOUBLE_EQ(unlimited.onTimeProbability, 1.0);
+
+    auto generous = model.admit(job, prediction.upperSeconds * 2.0, prediction.peakBytes * 2, 0.95);
+    EXPECT_TRUE(generous.admitted);
+    EXPECT_GT(generous.onTimeProbability, 0.95);
+
+    // A deadline at the expected time is met only half the time
+    auto tight = model.admit(job, prediction.seconds, 0, 0.95);
+    EXPECT_FALSE(tight.meetsDeadline);
+    EXPECT_TRUE(tight.fitsMemory);
+    EXPECT_NEAR(tight.onTimeProbability, 0.5, 1e-6);
+
+    auto lowMemory = model.admit(job, 0.0, prediction.peakBytes / 2, 0.95);
+    EXPECT_FALSE(lowMemory.admitted);
+    EXPECT_FALSE(lowMemory.fitsMemory);
+    EXPECT_TRUE(lowMemory.meetsDeadline);
+}
+
+// MARK: - Profiles
+
+TEST_F(CostModelTest, ProfilesRoundTrip) {
+    CostModel model;
+    model.calibrate(syntheticRuns(HARMONIQ_SYNC_ENERGY, 3e-9, 1.1, 0.15, 7), "x86-64 8-core");
+    ASSERT_TRUE(model.save(path));
+
+    CostModel loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.getMachineClass(), "x86-64 8-core");
+    for (size_t m = 0; m < CostModel::METHOD_COUNT; ++m) {
+        auto method = static_cast<harmoniq_sync_method_t>(m);
+        EXPECT_EQ(loaded.getCoefficients(method).secondsPerUnit, model.getCoefficients(method).secondsPerUnit);
+        EXPECT_EQ(loaded.getCoefficients(method).wallFactor, model.getCoefficients(method).wallFactor);
+        EXPECT_EQ(loaded.getCoefficients(method).logError, model.getCoefficients(method).logError);
+        EXPECT_EQ(loaded.getCoefficients(method).samples, model.getCoefficients(method).samples);
+    }
+}
+
+TEST_F(CostModelTest, DamagedProfilesAreRejected) {
+    CostModel model;
+    auto before = model.getCoefficients(HARMONIQ_SYNC_MFCC).secondsPerUnit;
+    EXPECT_FALSE(model.load(path));
+
+    {
+        std::ofstream file(path);
+        file << "not a profile\n";
+    }
+    EXPECT_FALSE(model.load(path));
+
+    // Valid lines before a bad one are not applied either
+    {
+        std::ofstream file(path);
+        file << "harmoniq-cost-profile 1\nmfcc.stft 1.0\nmfcc.unknown_stage 2.0\n";
+    }
+    EXPECT_FALSE(model.load(path));
+    EXPECT_EQ(model.getCoefficients(HARMONIQ_SYNC_MFCC).secondsPerUnit, before);
+    EXPECT_EQ(model.getMachineClass(), "builtin");
+}
+
+// MARK: - Engine and C API
+
+TEST_F(CostModelTest, EngineEstimatesUseTheSharedProfile) {
+    SyncEngine engine;
+    size_t length = static_cast<size_t>(30.0 * sampleRate);
+    double builtin = engine.estimateProcessingTime(length, sampleRate, HARMONIQ_SYNC_CHROMA);
+    EXPECT_GT(builtin, 0.0);
+    EXPECT_GT(engine.estimateProcessingTime(2 * length, sampleRate, HARMONIQ_SYNC_CHROMA), builtin);
+    EXPECT_EQ(engine.estimateProcessingTime(length, 0.0, HARMONIQ_SYNC_CHROMA), 0.0);
+
+    // A profile for a machine twice as slow doubles every prediction
+    CostModel slow;
+    slow.calibrate(syntheticRuns(HARMONIQ_SYNC_CHROMA, 2e-9, 1.0, 0.1, 3), "slow");
+    CostModel fast;
+    fast.calibrate(syntheticRuns(HARMONIQ_SYNC_CHROMA, 1e-9, 1.0, 0.1, 3), "fast");
+    ASSERT_TRUE(slow.save(path));
+
+    ASSERT_EQ(harmoniq_sync_load_cost_profile(path.c_str()), HARMONIQ_SYNC_SUCCESS);
+    double slowSeconds = engine.estimateProcessingTime(length, sampleRate, HARMONIQ_SYNC_CHROMA);
+    engine.setCostModel(std::make_shared<CostModel>(fast));
+    double fastSeconds = engine.estimateProcessingTime(length, sampleRate, HARMONIQ_SYNC_CHROMA);
+    EXPECT_NEAR(slowSeconds / fastSeconds, 2.0, 0.01);
+
+    ASSERT_EQ(harmoniq_sync_load_cost_profile(nullptr), HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(CostModel::shared()->getMachineClass(), "builtin");
+    EXPECT_EQ(harmoniq_sync_load_cost_profile("/nonexistent/profile"), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+}
+
+TEST_F(CostModelTest, CApiEstimatesCost) {
+    harmoniq_sync_engine_t* engine = harmoniq_sync_create_engine();
+    ASSERT_NE(engine, nullptr);
+
+    size_t length = static_cast<size_t>(20.0 * sampleRate);
+    harmoniq_sync_cost_estimate_t estimate;
+    ASSERT_EQ(harmoniq_sync_estimate_cost(engine, length, length, sampleRate, HARMONIQ_SYNC_SPECTRAL_FLUX,
+                                          0.0, 0, 0.95, &estimate), HARMONIQ_SYNC_SUCCESS);
+    EXPECT_GT(estimate.expected_seconds, 0.0);
+    EXPECT_GT(estimate.upper_seconds, estimate.expected_seconds);
+    EXPECT_GT(estimate.peak_bytes, length * 2 * sizeof(float));
+    EXPECT_EQ(estimate.admitted, 1);
+
+    double stageTotal = 0.0;
+    for (double seconds : estimate.stage_seconds) stageTotal += seconds;
+    EXPECT_GT(stageTotal, 0.0);
+
+    ASSERT_EQ(harmoniq_sync_estimate_cost(engine, length, length, sampleRate, HARMONIQ_SYNC_SPECTRAL_FLUX,
+                                          estimate.expected_seconds * 1e-3, 0, 0.95, &estimate), HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(estimate.admitted, 0);
+    EXPECT_LT(estimate.on_time_probability, 0.01);
+
+    EXPECT_EQ(harmoniq_sync_estimate_cost(engine, length, length, 0.0, HARMONIQ_SYNC_SPECTRAL_FLUX,
+                                          0.0, 0, 0.95, &estimate), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+    EXPECT_EQ(harmoniq_sync_estimate_cost(nullptr, length, length, sampleRate, HARMONIQ_SYNC_SPECTRAL_FLUX,
+                                          0.0, 0, 0.95, &estimate), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+
+    harmoniq_sync_destroy_engine(engine);
+}
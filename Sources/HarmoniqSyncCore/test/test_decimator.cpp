@@ -0,0 +1,116 @@
+//
+//  test_decimator.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for anti-aliased integer-factor decimation
+//
+
+#include <gtest/gtest.h>
+#include "../include/decimator.hpp"
+#include "../include/audio_processor.hpp"
+#include "test_signals.hpp"
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class DecimatorTest : public ::testing::Test {
+protected:
+    // RMS away from the zero-padded edges
+    static double interiorRms(const std::vector<float>& samples, size_t margin) {
+        double sum = 0.0;
+        for (size_t i = margin; i + margin < samples.size(); ++i) {
+            sum += static_cast<double>(samples[i]) * samples[i];
+        }
+        return std::sqrt(sum / (samples.size() - 2 * margin));
+    }
+};
+
+// MARK: - Filter Tests
+
+TEST_F(DecimatorTest, PassbandKeptAndStopbandRejected) {
+    Decimator decimator(3);
+    std::vector<float> output;
+
+    // 1 kHz is well inside the 8 kHz output band
+    decimator.process(TestSignals::tone(1000.0, 48000.0, 48000).data(), 48000, output);
+    ASSERT_EQ(output.size(), 16000u);
+    EXPECT_NEAR(interiorRms(output, 100), 0.5 / std::sqrt(2.0), 5e-3);
+
+    // 14 kHz would alias to 2 kHz without the lowpass
+    decimator.process(TestSignals::tone(14000.0, 48000.0, 48000).data(), 48000, output);
+    EXPECT_LT(interiorRms(output, 100), 1e-3);
+}
+
+TEST_F(DecimatorTest, OutputSamplesLineUpWithSource) {
+    auto samples = TestSignals::tone(200.0, 44100.0, 10000);
+    std::vector<float> output;
+    Decimator::get(4)->process(samples.data(), samples.size(), output);
+
+    // Zero-phase filter: output n sits on input n * factor
+    ASSERT_EQ(output.size(), Decimator::outputLength(samples.size(), 4));
+    for (size_t n = 20; n + 20 < output.size(); ++n) {
+        ASSERT_NEAR(output[n], samples[n * 4], 2e-3f) << "at output " << n;
+    }
+}
+
+TEST_F(DecimatorTest, EdgesMatchZeroPaddedInterior) {
+    std::mt19937 gen(7);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+    std::vector<float> samples(1001);
+    for (float& sample : samples) {
+        sample = noise(gen);
+    }
+
+    // Leading zeros move the edge outputs into the vectorized interior
+    const int factor = 4;
+    const size_t shift = 40;
+    std::vector<float> padded(shift * factor, 0.0f);
+    padded.insert(padded.end(), samples.begin(), samples.end());
+    padded.resize(padded.size() + shift * factor, 0.0f);
+
+    Decimator decimator(factor);
+    std::vector<float> direct, reference;
+    decimator.process(samples.data(), samples.size(), direct);
+    decimator.process(padded.data(), padded.size(), reference);
+
+    ASSERT_EQ(direct.size(), 251u);
+    for (size_t n = 0; n < direct.size(); ++n) {
+        ASSERT_NEAR(direct[n], reference[n + shift], 1e-5f) << "at output " << n;
+    }
+}
+
+TEST_F(DecimatorTest, FactorOnePassesThrough) {
+    std::vector<float> samples = {0.25f, -0.5f, 0.75f, 1.0f};
+    std::vector<float> output;
+    Decimator(1).process(samples.data(), samples.size(), output);
+
+    EXPECT_EQ(output, samples);
+}
+
+// MARK: - Integration Tests
+
+TEST_F(DecimatorTest, IntegerResamplingIsAntiAliased) {
+    auto samples = TestSignals::tone(14000.0, 48000.0, 48000);
+    AudioProcessor processor;
+    ASSERT_TRUE(processor.loadAudio(samples.data(), samples.size(), 48000.0, 16000.0));
+
+    EXPECT_EQ(processor.getSampleRate(), 16000.0);
+    EXPECT_EQ(processor.getLength(), 16000u);
+    std::vector<float> resampled(processor.getAudioData().begin(), processor.getAudioData().end());
+    EXPECT_LT(interiorRms(resampled, 100), 1e-3);
+}
+
+// MARK: - Cache Tests
+
+TEST_F(DecimatorTest, GetReusesDecimatorsPerFactor) {
+    auto first = Decimator::get(3);
+    EXPECT_EQ(first, Decimator::get(3));
+    EXPECT_NE(first, Decimator::get(2));
+    EXPECT_EQ(first->getFactor(), 3);
+    EXPECT_EQ(first->getNumTaps() % 2, 1u);
+
+    EXPECT_THROW(Decimator(0), std::invalid_argument);
+}
@@ -0,0 +1,299 @@
+//
+//  test_dsp_backend.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for the configured DSP backend against scalar references
+//
+
+#include <gtest/gtest.h>
+#include "../include/dsp_backend.hpp"
+#include <cmath>
+#include <complex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace HarmoniqSync;
+
+class DSPBackendTest : public ::testing::Test {
+protected:
+    static std::vector<double> noise(size_t length, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+        std::vector<double> samples(length);
+        for (double& sample : samples) {
+            sample = value(gen);
+        }
+        return samples;
+    }
+
+    static std::vector<float> toFloat(const std::vector<double>& values) {
+        return std::vector<float>(values.begin(), values.end());
+    }
+
+    // Bins 0..N/2 of the unscaled DFT
+    static std::vector<std::complex<double>> naiveDFT(const std::vector<double>& samples) {
+        const size_t length = samples.size();
+        std::vector<std::complex<double>> bins(length / 2 + 1);
+        for (size_t k = 0; k < bins.size(); ++k) {
+            for (size_t n = 0; n < length; ++n) {
+                double angle = -2.0 * M_PI * static_cast<double>(k * n % length) / length;
+                bins[k] += samples[n] * std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+        }
+        return bins;
+    }
+
+    // Packed forward transform must hold 2x the DFT, Nyquist in imagp[0]
+    template <typename T>
+    static void expectPackedSpectrum(const T* realp, const T* imagp,
+                                     const std::vector<std::complex<double>>& bins, double tolerance) {
+        const size_t half = bins.size() - 1;
+        EXPECT_NEAR(realp[0], 2.0 * bins[0].real(), tolerance);
+        EXPECT_NEAR(imagp[0], 2.0 * bins[half].real(), tolerance);
+        for (size_t k = 1; k < half; ++k) {
+            EXPECT_NEAR(realp[k], 2.0 * bins[k].real(), tolerance) << "bin " << k;
+            EXPECT_NEAR(imagp[k], 2.0 * bins[k].imag(), tolerance) << "bin " << k;
+        }
+    }
+};
+
+// MARK: - FFT Tests
+
+TEST_F(DSPBackendTest, ReportsBackendName) {
+    std::string name = DSP::backendName();
+    EXPECT_TRUE(name == "Accelerate" || name == "Portable") << name;
+}
+
+TEST_F(DSPBackendTest, DoubleForwardMatchesNaiveDFT) {
+    DSP::RealFFT<double> fft(10);
+    for (size_t log2Size = 1; log2Size <= 10; ++log2Size) {
+        const size_t length = size_t(1) << log2Size;
+        auto samples = noise(length, static_cast<unsigned>(log2Size));
+        auto bins = naiveDFT(samples);
+
+        std::vector<double> spectrum(length);
+        DSP::SplitComplex<double> split = { spectrum.data(), spectrum.data() + length / 2 };
+        DSP::pack(samples.data(), split, length / 2);
+        fft.forward(split, log2Size);
+
+        SCOPED_TRACE(length);
+        expectPackedSpectrum(split.realp, split.imagp, bins, 1e-9 * length);
+    }
+}
+
+TEST_F(DSPBackendTest, FloatForwardMatchesNaiveDFTInPlace) {
+    const size_t log2Size = 9;
+    const size_t length = size_t(1) << log2Size;
+    auto samples = noise(length, 3);
+    auto bins = naiveDFT(samples);
+
+    // Pack from the same buffer the split halves point into, as the spectrogram does
+    auto buffer = toFloat(samples);
+    DSP::SplitComplex<float> split = { buffer.data(), buffer.data() + length / 2 };
+    DSP::pack(buffer.data(), split, length / 2);
+
+    DSP::RealFFT<float> fft(13);
+    fft.forward(split, log2Size);
+    expectPackedSpectrum(split.realp, split.imagp, bins, 1e-3);
+}
+
+TEST_F(DSPBackendTest, RoundTripScalesByTwiceTheLength) {
+    DSP::RealFFT<double> fft(12);
+    for (size_t log2Size : {1u, 2u, 5u, 12u}) {
+        const size_t length = size_t(1) << log2Size;
+        auto samples = noise(length, 40 + static_cast<unsigned>(log2Size));
+
+        std::vector<double> spectrum(length), output(length);
+        DSP::SplitComplex<double> split = { spectrum.data(), spectrum.data() + length / 2 };
+        DSP::pack(samples.data(), split, length / 2);
+        fft.forward(split, log2Size);
+        fft.inverse(split, log2Size);
+        DSP::unpack(split, output.data(), length / 2);
+
+        for (size_t i = 0; i < length; ++i) {
+            ASSERT_NEAR(output[i], 2.0 * length * samples[i], 1e-9 * length) << "size " << length << " at " << i;
+        }
+    }
+}
+
+TEST_F(DSPBackendTest, PlansAreMovableAndValidated) {
+    EXPECT_THROW(DSP::RealFFT<float>(0), std::invalid_argument);
+
+    DSP::RealFFT<double> source(4);
+    DSP::RealFFT<double> fft(std::move(source));
+    EXPECT_EQ(fft.getMaxLog2Size(), 4u);
+
+    std::vector<double> spectrum = {1, 0, 0, 0, 0, 0, 0, 0};
+    DSP::SplitComplex<double> split = { spectrum.data(), spectrum.data() + 4 };
+    fft.forward(split, 3);
+
+    // An impulse has a flat spectrum of 2 (packed DC and Nyquist included)
+    for (double value : {split.realp[0], split.imagp[0], split.realp[1], split.realp[3]}) {
+        EXPECT_NEAR(value, 2.0, 1e-12);
+    }
+}
+
+TEST_F(DSPBackendTest, SharedPlansGrowWithoutInvalidatingHolders) {
+    EXPECT_THROW(DSP::sharedRealFFT<double>(0), std::invalid_argument);
+
+    // Requests within the kept plan return it unchanged
+    auto plan = DSP::sharedRealFFT<double>(3);
+    ASSERT_GE(plan->getMaxLog2Size(), 3u);
+    EXPECT_EQ(DSP::sharedRealFFT<double>(3), plan);
+    EXPECT_EQ(DSP::sharedRealFFT<double>(plan->getMaxLog2Size()), plan);
+
+    // A larger request replaces the kept plan, which serves smaller sizes from then on
+    auto larger = DSP::sharedRealFFT<double>(plan->getMaxLog2Size() + 1);
+    EXPECT_NE(larger, plan);
+    EXPECT_EQ(DSP::sharedRealFFT<double>(3), larger);
+
+    // The replaced plan still transforms for its holder
+    std::vector<double> spectrum = {1, 0, 0, 0, 0, 0, 0, 0};
+    DSP::SplitComplex<double> split = { spectrum.data(), spectrum.data() + 4 };
+    plan->forward(split, 3);
+    for (double value : {split.realp[0], split.imagp[0], split.realp[1], split.realp[3]}) {
+        EXPECT_NEAR(value, 2.0, 1e-12);
+    }
+
+    // Windows are built once per length
+    auto window = DSP::sharedHannWindow(64);
+    EXPECT_EQ(DSP::sharedHannWindow(64), window);
+    std::vector<float> expected(64);
+    DSP::hannWindow(expected.data(), expected.size());
+    EXPECT_EQ(*window, expected);
+}
+
+// MARK: - Vector Tests
+
+TEST_F(DSPBackendTest, ComplexProductsMatchStdComplex) {
+    auto values = noise(4 * 33, 5);
+    std::vector<double> a(values.begin(), values.begin() + 66), b(values.begin() + 66, values.end());
+    std::vector<double> product(66), total(66);
+    DSP::SplitComplex<double> splitA = { a.data(), a.data() + 33 };
+    DSP::SplitComplex<double> splitB = { b.data(), b.data() + 33 };
+    DSP::SplitComplex<double> splitProduct = { product.data(), product.data() + 33 };
+    DSP::SplitComplex<double> splitTotal = { total.data(), total.data() + 33 };
+
+    DSP::multiplyConjugate(splitA, splitB, splitProduct, 33);
+    DSP::add(splitA, splitB, splitTotal, 33);
+
+    for (size_t i = 0; i < 33; ++i) {
+        std::complex<double> x(a[i], a[33 + i]), y(b[i], b[33 + i]);
+        std::complex<double> expected = std::conj(x) * y;
+        EXPECT_NEAR(product[i], expected.real(), 1e-12);
+        EXPECT_NEAR(product[33 + i], expected.imag(), 1e-12);
+        EXPECT_NEAR(total[i], a[i] + b[i], 1e-12);
+        EXPECT_NEAR(total[33 + i], a[33 + i] + b[33 + i], 1e-12);
+    }
+}
+
+TEST_F(DSPBackendTest, SinglePrecisionComplexProductsMatchStdComplex) {
+    auto values = toFloat(noise(4 * 33, 8));
+    std::vector<float> a(values.begin(), values.begin() + 66), b(values.begin() + 66, values.end());
+    std::vector<float> product(66), total(66), interleaved(66);
+    DSP::SplitComplex<float> splitA = { a.data(), a.data() + 33 };
+    DSP::SplitComplex<float> splitB = { b.data(), b.data() + 33 };
+    DSP::SplitComplex<float> splitProduct = { product.data(), product.data() + 33 };
+    DSP::SplitComplex<float> splitTotal = { total.data(), total.data() + 33 };
+
+    DSP::multiplyConjugate(splitA, splitB, splitProduct, 33);
+    DSP::add(splitA, splitB, splitTotal, 33);
+    DSP::unpack(splitA, interleaved.data(), 33);
+
+    for (size_t i = 0; i < 33; ++i) {
+        std::complex<float> x(a[i], a[33 + i]), y(b[i], b[33 + i]);
+        std::complex<float> expected = std::conj(x) * y;
+        EXPECT_NEAR(product[i], expected.real(), 1e-5f);
+        EXPECT_NEAR(product[33 + i], expected.imag(), 1e-5f);
+        EXPECT_FLOAT_EQ(total[i], a[i] + b[i]);
+        EXPECT_FLOAT_EQ(total[33 + i], a[33 + i] + b[33 + i]);
+        EXPECT_EQ(interleaved[2 * i], a[i]);
+        EXPECT_EQ(interleaved[2 * i + 1], a[33 + i]);
+    }
+}
+
+TEST_F(DSPBackendTest, ReductionsMatchScalarLoops) {
+    auto a = toFloat(noise(1001, 6));
+    auto b = toFloat(noise(1001, 7));
+
+    double sum = 0.0, squares = 0.0, dot = 0.0;
+    float minValue = a[0], maxValue = a[0];
+    for (size_t i = 0; i < a.size(); ++i) {
+        sum += a[i];
+        squares += static_cast<double>(a[i]) * a[i];
+        dot += static_cast<double>(a[i]) * b[i];
+        minValue = std::min(minValue, a[i]);
+        maxValue = std::max(maxValue, a[i]);
+    }
+
+    EXPECT_NEAR(DSP::sum(a.data(), a.size()), sum, 1e-3);
+    EXPECT_NEAR(DSP::sumOfSquares(a.data(), a.size()), squares, 1e-3);
+    EXPECT_NEAR(DSP::mean(a.data(), a.size()), sum / a.size(), 1e-6);
+    EXPECT_NEAR(DSP::dot(a.data(), b.data(), a.size()), dot, 1e-3);
+    EXPECT_EQ(DSP::minimum(a.data(), a.size()), minValue);
+    EXPECT_EQ(DSP::maximum(a.data(), a.size()), maxValue);
+    EXPECT_EQ(DSP::sum(a.data(), 0), 0.0f);
+}
+
+TEST_F(DSPBackendTest, ElementwiseOpsMatchScalarLoops) {
+    auto a = toFloat(noise(257, 8));
+    auto b = toFloat(noise(257, 9));
+    std::vector<float> output(a.size());
+
+    DSP::multiply(a.data(), b.data(), output.data(), a.size());
+    for (size_t i = 0; i < a.size(); ++i) EXPECT_FLOAT_EQ(output[i], a[i] * b[i]);
+
+    DSP::scaleAdd(a.data(), 3.0f, -0.5f, output.data(), a.size());
+    for (size_t i = 0; i < a.size(); ++i) EXPECT_NEAR(output[i], a[i] * 3.0f - 0.5f, 1e-6);
+
+    DSP::addScalar(a.data(), 0.25f, output.data(), a.size());
+    DSP::threshold(output.data(), 0.0f, output.data(), a.size());
+    for (size_t i = 0; i < a.size(); ++i) EXPECT_FLOAT_EQ(output[i], std::max(0.0f, a[i] + 0.25f));
+
+    DSP::squareRoot(output.data(), b.data(), a.size());
+    DSP::log10(output.data(), output.data(), a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        float value = std::max(0.0f, a[i] + 0.25f);
+        EXPECT_NEAR(b[i], std::sqrt(value), 1e-6);
+        if (value > 0.0f) {
+            EXPECT_NEAR(output[i], std::log10(value), 1e-5);
+        }
+    }
+}
+
+TEST_F(DSPBackendTest, WindowFilterAndMatrixProduct) {
+    std::vector<float> window(64);
+    DSP::hannWindow(window.data(), window.size());
+    EXPECT_FLOAT_EQ(window[0], 0.0f);
+    EXPECT_NEAR(window[32], 2.0 * 0.8165, 1e-5);
+    EXPECT_NEAR(window[16], window[48], 1e-6);
+
+    // Every third sample through a 4-tap filter
+    auto input = toFloat(noise(3 * 9 + 4, 10));
+    std::vector<float> taps = {0.1f, -0.2f, 0.3f, 0.4f}, output(10);
+    DSP::decimate(input.data(), 3, taps.data(), taps.size(), output.data(), output.size());
+    for (size_t n = 0; n < output.size(); ++n) {
+        double expected = 0.0;
+        for (size_t p = 0; p < taps.size(); ++p) expected += input[n * 3 + p] * taps[p];
+        EXPECT_NEAR(output[n], expected, 1e-6);
+    }
+
+    // (2 x 3) * (3 x 2)
+    std::vector<float> a = {1, 2, 3, 4, 5, 6}, b = {7, 8, 9, 10, 11, 12}, c(4);
+    DSP::matrixMultiply(a.data(), b.data(), c.data(), 2, 2, 3);
+    EXPECT_EQ(c, (std::vector<float>{58, 64, 139, 154}));
+}
+
+TEST_F(DSPBackendTest, SquaredMagnitudesOfSplitVector) {
+    std::vector<float> re = {3, 0, -1}, im = {4, 2, 1}, output(3);
+    DSP::SplitComplex<float> split = { re.data(), im.data() };
+    DSP::squaredMagnitudes(split, output.data(), 3);
+    EXPECT_EQ(output, (std::vector<float>{25, 4, 2}));
+}
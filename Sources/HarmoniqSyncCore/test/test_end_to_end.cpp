@@ -8,9 +8,14 @@
 #include <gtest/gtest.h>
 #include "../include/harmoniq_sync.h"
 #include "../include/sync_engine.hpp"
+#include <chrono>
+#include <condition_variable>
 #include <vector>
 #include <cmath>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 using namespace HarmoniqSync;
 
@@ -240,15 +245,29 @@ TEST_F(EndToEndSyncTest, UncorrelatedAudioLowConfidence) {
         &result
     );
     
-    // Should complete but with low confidence
-    EXPECT_EQ(error, HARMONIQ_SYNC_SUCCESS);
-    EXPECT_EQ(result.error, HARMONIQ_SYNC_SUCCESS);
+    // Below the default confidence threshold the alignment is rejected
+    EXPECT_EQ(error, HARMONIQ_SYNC_ERROR_PROCESSING_FAILED);
+    EXPECT_EQ(result.error, HARMONIQ_SYNC_ERROR_PROCESSING_FAILED);
     
     // Should have low confidence (<0.2 as specified in Sprint 2 plan)
     EXPECT_LT(result.confidence, 0.2);
     
     // Correlation should be low
     EXPECT_LT(result.peak_correlation, 0.3);
+    
+    // Accepting any confidence reports the weak alignment instead
+    config_.confidence_threshold = 0.0;
+    ASSERT_EQ(harmoniq_sync_set_engine_config(engine_, &config_), HARMONIQ_SYNC_SUCCESS);
+    error = harmoniq_sync_process(
+        engine_,
+        audio1.data(), audio1.size(),
+        audio2.data(), audio2.size(),
+        &result
+    );
+    
+    EXPECT_EQ(error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_LT(result.confidence, 0.7);
+    EXPECT_LT(result.peak_correlation, 0.5);
 }
 
 TEST_F(EndToEndSyncTest, InvalidInputHandling) {
@@ -301,6 +320,25 @@ TEST_F(EndToEndSyncTest, InvalidInputHandling) {
     EXPECT_EQ(error, HARMONIQ_SYNC_ERROR_INSUFFICIENT_DATA);
 }
 
+TEST_F(EndToEndSyncTest, DriftCorrectionValidatesInput) {
+    auto audio = generateSineWave(440.0, TEST_DURATION, SAMPLE_RATE);
+    std::vector<float> output(audio.size());
+    
+    harmoniq_sync_result_t result = {};
+    result.offset_samples_fractional = 100.0;
+    
+    // A result without drift copies the target unchanged
+    EXPECT_EQ(harmoniq_sync_correct_drift(audio.data(), audio.size(), &result, output.data()), HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(output, audio);
+    
+    EXPECT_EQ(harmoniq_sync_correct_drift(nullptr, audio.size(), &result, output.data()), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+    EXPECT_EQ(harmoniq_sync_correct_drift(audio.data(), audio.size(), nullptr, output.data()), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+    EXPECT_EQ(harmoniq_sync_correct_drift(audio.data(), audio.size(), &result, nullptr), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+    
+    result.error = HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
+    EXPECT_EQ(harmoniq_sync_correct_drift(audio.data(), audio.size(), &result, output.data()), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+}
+
 TEST_F(EndToEndSyncTest, ShortAudioHandling) {
     // Generate very short audio (less than minimum required)
     double shortDuration = 0.1; // 100ms - too short for reliable sync
@@ -406,6 +444,254 @@ TEST_F(EndToEndSyncTest, CppSyncEngineIntegration) {
     EXPECT_EQ(stats.methodUsed, HARMONIQ_SYNC_SPECTRAL_FLUX);
 }
 
+TEST_F(EndToEndSyncTest, ConcurrentProcessCallsMatchSerialResults) {
+    SyncEngine cppEngine;
+    harmoniq_sync_config_t config = cppEngine.getConfig();
+    config.confidence_threshold = 0.0;
+    cppEngine.setConfig(config);
+    
+    struct Job {
+        std::vector<float> target;
+        harmoniq_sync_method_t method;
+        harmoniq_sync_result_t expected;
+    };
+    
+    auto audio = generateClickAudio(TEST_DURATION, SAMPLE_RATE, {0.5, 1.3, 2.2, 3.6});
+    const harmoniq_sync_method_t methods[] = {
+        HARMONIQ_SYNC_SPECTRAL_FLUX, HARMONIQ_SYNC_ENERGY, HARMONIQ_SYNC_CHROMA, HARMONIQ_SYNC_MFCC
+    };
+    std::vector<Job> jobs;
+    for (size_t i = 0; i < 8; ++i) {
+        Job job;
+        job.target = createOffsetAudio(audio, 1024 + 2048 * i, SAMPLE_RATE);
+        job.method = methods[i % 4];
+        job.expected = cppEngine.process(audio.data(), audio.size(), job.target.data(), job.target.size(),
+                                         SAMPLE_RATE, job.method);
+        ASSERT_EQ(job.expected.error, HARMONIQ_SYNC_SUCCESS);
+        jobs.push_back(std::move(job));
+    }
+    
+    // Every thread runs every job on the one engine, in a different order
+    const size_t threadCount = 4;
+    std::vector<std::vector<harmoniq_sync_result_t>> results(threadCount, std::vector<harmoniq_sync_result_t>(jobs.size()));
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t n = 0; n < jobs.size(); ++n) {
+                size_t index = (n + 3 * t) % jobs.size();
+                const Job& job = jobs[index];
+                results[t][index] = cppEngine.process(audio.data(), audio.size(), job.target.data(), job.target.size(),
+                                                      SAMPLE_RATE, job.method);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    for (size_t t = 0; t < threadCount; ++t) {
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            EXPECT_EQ(results[t][i].error, HARMONIQ_SYNC_SUCCESS) << "thread " << t << " job " << i;
+            EXPECT_EQ(results[t][i].offset_samples, jobs[i].expected.offset_samples) << "thread " << t << " job " << i;
+            EXPECT_DOUBLE_EQ(results[t][i].confidence, jobs[i].expected.confidence) << "thread " << t << " job " << i;
+        }
+    }
+    EXPECT_TRUE(cppEngine.getLastProcessingStats().successful);
+}
+
+TEST_F(EndToEndSyncTest, LastStatsBreakDownStages) {
+    harmoniq_sync_stats_t stats;
+    EXPECT_EQ(harmoniq_sync_get_last_stats(nullptr, &stats), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+    EXPECT_EQ(harmoniq_sync_get_last_stats(engine_, nullptr), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+    
+    auto audio = generateClickAudio(TEST_DURATION, SAMPLE_RATE, {0.5, 1.5, 2.5, 3.5});
+    auto target = createOffsetAudio(audio, 2205, SAMPLE_RATE);
+    
+    harmoniq_sync_result_t result;
+    ASSERT_EQ(harmoniq_sync_process(engine_, audio.data(), audio.size(), target.data(), target.size(), &result),
+              HARMONIQ_SYNC_SUCCESS);
+    ASSERT_EQ(harmoniq_sync_get_last_stats(engine_, &stats), HARMONIQ_SYNC_SUCCESS);
+    
+    EXPECT_EQ(stats.successful, 1);
+    EXPECT_EQ(stats.method, HARMONIQ_SYNC_SPECTRAL_FLUX);
+    EXPECT_GT(stats.stft_seconds, 0.0);
+    EXPECT_GT(stats.correlation_seconds, 0.0);
+    EXPECT_GT(stats.peak_picking_seconds, 0.0);
+    EXPECT_GT(stats.confidence_seconds, 0.0);
+    EXPECT_GT(stats.method_seconds[HARMONIQ_SYNC_SPECTRAL_FLUX], 0.0);
+    EXPECT_EQ(stats.method_seconds[HARMONIQ_SYNC_MFCC], 0.0);
+    
+    // Exclusive stage times fit inside the wall time
+    double stages = stats.load_seconds + stats.resample_seconds + stats.stft_seconds + stats.feature_seconds +
+                    stats.post_process_seconds + stats.correlation_seconds + stats.peak_picking_seconds +
+                    stats.confidence_seconds + stats.drift_seconds + stats.refinement_seconds;
+    EXPECT_LE(stages, stats.total_seconds);
+    EXPECT_GT(stats.total_seconds, 0.0);
+    
+    // Both spectrograms (windowSize / 2 bins per frame) are held at once
+    size_t frames = (audio.size() - config_.window_size) / config_.hop_size + 1;
+    EXPECT_GE(stats.peak_allocated_bytes, 2 * frames * (config_.window_size / 2) * sizeof(float));
+}
+
+TEST_F(EndToEndSyncTest, HybridStatsTimeEveryMethod) {
+    SyncEngine engine;
+    auto audio = generateClickAudio(TEST_DURATION, SAMPLE_RATE, {0.5, 1.5, 2.5, 3.5});
+    
+    engine.process(audio.data(), audio.size(), audio.data(), audio.size(), SAMPLE_RATE, HARMONIQ_SYNC_HYBRID);
+    auto stats = engine.getLastProcessingStats();
+    
+    for (size_t method = 0; method < PROFILED_METHOD_COUNT; ++method) {
+        EXPECT_GT(stats.stages.methodSeconds[method], 0.0) << "method " << method;
+    }
+    EXPECT_EQ(stats.memoryUsedBytes, stats.stages.peakAllocatedBytes);
+    EXPECT_GT(stats.memoryUsedBytes, 0u);
+}
+
+// MARK: - Asynchronous Processing
+
+namespace {
+    struct CompletionRecord {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool called = false;
+        harmoniq_sync_result_t result = {};
+    };
+    
+    void recordCompletion(harmoniq_sync_operation_t*, const harmoniq_sync_result_t* result, void* user_data) {
+        auto record = static_cast<CompletionRecord*>(user_data);
+        std::lock_guard<std::mutex> lock(record->mutex);
+        record->result = *result;
+        record->called = true;
+        record->condition.notify_all();
+    }
+}
+
+TEST_F(EndToEndSyncTest, AsyncProcessDeliversCompletion) {
+    auto audio = generateClickAudio(TEST_DURATION, SAMPLE_RATE, {0.5, 1.5, 2.5, 3.5});
+    auto target = createOffsetAudio(audio, 2205, SAMPLE_RATE);
+    
+    EXPECT_EQ(harmoniq_sync_process_async(nullptr, audio.data(), audio.size(), target.data(), target.size(),
+                                          0.0, nullptr, nullptr), nullptr);
+    
+    CompletionRecord record;
+    harmoniq_sync_operation_t* operation = harmoniq_sync_process_async(
+        engine_, audio.data(), audio.size(), target.data(), target.size(), 0.0, recordCompletion, &record);
+    ASSERT_NE(operation, nullptr);
+    
+    harmoniq_sync_result_t result;
+    EXPECT_EQ(harmoniq_sync_wait(operation, &result), HARMONIQ_SYNC_SUCCESS);
+    
+    // Same answer as the blocking call
+    harmoniq_sync_result_t expected;
+    ASSERT_EQ(harmoniq_sync_process(engine_, audio.data(), audio.size(), target.data(), target.size(), &expected),
+              HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(result.offset_samples, expected.offset_samples);
+    EXPECT_DOUBLE_EQ(result.confidence, expected.confidence);
+    
+    // The callback runs after the result is published and sees the same result
+    {
+        std::unique_lock<std::mutex> lock(record.mutex);
+        ASSERT_TRUE(record.condition.wait_for(lock, std::chrono::seconds(30), [&] { return record.called; }));
+        EXPECT_EQ(record.result.offset_samples, result.offset_samples);
+    }
+    harmoniq_sync_release_operation(operation);
+}
+
+TEST_F(EndToEndSyncTest, CallbackMayWaitOnItsOperation) {
+    auto audio = generateClickAudio(TEST_DURATION, SAMPLE_RATE, {0.5, 1.5, 2.5, 3.5});
+    
+    struct WaitingRecord {
+        CompletionRecord completion;
+        harmoniq_sync_error_t waited = HARMONIQ_SYNC_ERROR_PROCESSING_FAILED;
+    } record;
+    auto waitInCallback = [](harmoniq_sync_operation_t* operation, const harmoniq_sync_result_t* result,
+                             void* user_data) {
+        auto waiting = static_cast<WaitingRecord*>(user_data);
+        harmoniq_sync_result_t waitedResult;
+        harmoniq_sync_error_t waited = harmoniq_sync_wait(operation, &waitedResult);
+        std::lock_guard<std::mutex> lock(waiting->completion.mutex);
+        waiting->waited = waited;
+        waiting->completion.result = *result;
+        waiting->completion.called = true;
+        waiting->completion.condition.notify_all();
+    };
+    
+    harmoniq_sync_operation_t* operation = harmoniq_sync_process_async(
+        engine_, audio.data(), audio.size(), audio.data(), audio.size(), 0.0, waitInCallback, &record);
+    ASSERT_NE(operation, nullptr);
+    harmoniq_sync_release_operation(operation);
+    
+    std::unique_lock<std::mutex> lock(record.completion.mutex);
+    ASSERT_TRUE(record.completion.condition.wait_for(lock, std::chrono::seconds(30),
+                                                     [&] { return record.completion.called; }));
+    EXPECT_EQ(record.waited, record.completion.result.error);
+}
+
+TEST_F(EndToEndSyncTest, AsyncCancelStopsLongAudio) {
+    auto audio = generateClickAudio(120.0, SAMPLE_RATE, {0.5, 30.0, 60.0, 90.0});
+    
+    CompletionRecord record;
+    auto start = std::chrono::steady_clock::now();
+    harmoniq_sync_operation_t* operation = harmoniq_sync_process_async(
+        engine_, audio.data(), audio.size(), audio.data(), audio.size(), 0.0, recordCompletion, &record);
+    ASSERT_NE(operation, nullptr);
+    EXPECT_EQ(harmoniq_sync_cancel(operation), HARMONIQ_SYNC_SUCCESS);
+    
+    // Release before completion: the running task keeps the handle alive
+    harmoniq_sync_release_operation(operation);
+    
+    std::unique_lock<std::mutex> lock(record.mutex);
+    ASSERT_TRUE(record.condition.wait_for(lock, std::chrono::seconds(30), [&] { return record.called; }));
+    EXPECT_EQ(record.result.error, HARMONIQ_SYNC_ERROR_CANCELLED);
+    EXPECT_LT(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1.0);
+    EXPECT_STREQ(harmoniq_sync_error_description(HARMONIQ_SYNC_ERROR_CANCELLED), "Operation was cancelled");
+}
+
+TEST_F(EndToEndSyncTest, AsyncTimeoutReportsTimeout) {
+    auto audio = generateClickAudio(120.0, SAMPLE_RATE, {0.5, 30.0, 60.0, 90.0});
+    
+    harmoniq_sync_operation_t* operation = harmoniq_sync_process_async(
+        engine_, audio.data(), audio.size(), audio.data(), audio.size(), 0.001, nullptr, nullptr);
+    ASSERT_NE(operation, nullptr);
+    
+    harmoniq_sync_result_t result;
+    EXPECT_EQ(harmoniq_sync_wait(operation, &result), HARMONIQ_SYNC_ERROR_TIMEOUT);
+    EXPECT_EQ(result.error, HARMONIQ_SYNC_ERROR_TIMEOUT);
+    harmoniq_sync_release_operation(operation);
+    
+    // The engine is reusable after a stopped operation
+    harmoniq_sync_stats_t stats;
+    ASSERT_EQ(harmoniq_sync_get_last_stats(engine_, &stats), HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(stats.successful, 0);
+}
+
+TEST_F(EndToEndSyncTest, CancelDuringExtractionStopsMidFlight) {
+    SyncEngine engine;
+    auto audio = generateClickAudio(60.0, SAMPLE_RATE, {0.5, 20.0, 40.0});
+    
+    // Cancel from the progress report issued just before feature extraction starts
+    std::shared_ptr<SyncOperation> operation;
+    std::mutex operationMutex;
+    engine.setProgressCallback([&](float progress, const std::string&) {
+        if (progress >= 0.6f) {
+            std::lock_guard<std::mutex> lock(operationMutex);
+            if (operation) operation->cancel();
+        }
+    });
+    
+    {
+        std::lock_guard<std::mutex> lock(operationMutex);
+        operation = engine.processAsync(audio.data(), audio.size(), audio.data(), audio.size(), SAMPLE_RATE,
+                                        HARMONIQ_SYNC_HYBRID, std::chrono::milliseconds(0), nullptr);
+    }
+    
+    harmoniq_sync_result_t result = operation->wait();
+    EXPECT_TRUE(operation->isFinished());
+    EXPECT_EQ(result.error, HARMONIQ_SYNC_ERROR_CANCELLED);
+    EXPECT_STREQ(result.method, "Cancelled");
+    EXPECT_TRUE(operation->getCancellationToken().isCancelled());
+}
+
 // MARK: - Test Main
 
 // Note: Google Test main is handled by the test framework
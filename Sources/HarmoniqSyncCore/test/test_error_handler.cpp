@@ -0,0 +1,231 @@
+//
+//  test_error_handler.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for the lock-free error log, its counters and callbacks
+//
+
+#include <gtest/gtest.h>
+#include "../include/error_handler.hpp"
+#include <atomic>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class ErrorHandlerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ErrorHandler::setMinimumSeverity(ErrorSeverity::Trace);
+        ErrorHandler::clearErrorCallbacks();
+        ErrorHandler::clearErrorLog();
+    }
+
+    void TearDown() override {
+        ErrorHandler::setMinimumSeverity(ErrorSeverity::Info);
+        ErrorHandler::clearErrorCallbacks();
+        ErrorHandler::clearErrorLog();
+    }
+
+    static void log(const std::string& message, ErrorSeverity severity = ErrorSeverity::Warning) {
+        ErrorHandler::logError(ErrorHandler::createError(HARMONIQ_SYNC_SUCCESS, severity, message, "Test"));
+    }
+
+    // Messages are "<producer>:<index>" so every event can be traced back to where it came from
+    static std::pair<size_t, size_t> parseMessage(const std::string& message) {
+        size_t colon = message.find(':');
+        return {std::stoul(message.substr(0, colon)), std::stoul(message.substr(colon + 1))};
+    }
+};
+
+// MARK: - History
+
+TEST_F(ErrorHandlerTest, RecentErrorsAreOldestFirst) {
+    for (int i = 0; i < 10; ++i) {
+        log(std::to_string(i));
+    }
+
+    auto recent = ErrorHandler::getRecentErrors(4);
+    ASSERT_EQ(recent.size(), 4u);
+    for (size_t i = 0; i < recent.size(); ++i) {
+        EXPECT_EQ(recent[i].message, std::to_string(6 + i));
+    }
+
+    ErrorHandler::clearErrorLog();
+    EXPECT_TRUE(ErrorHandler::getRecentErrors().empty());
+}
+
+TEST_F(ErrorHandlerTest, OverflowWithoutReaderKeepsNewestHistory) {
+    // Several rings' worth with nobody reading: the logger drains the full ring itself
+    const size_t total = ErrorHandler::EVENT_RING_CAPACITY * 5;
+    auto before = ErrorHandler::getStats();
+    for (size_t i = 0; i < total; ++i) {
+        log(std::to_string(i));
+    }
+    auto after = ErrorHandler::getStats();
+
+    EXPECT_EQ(after.dropped, before.dropped);
+    EXPECT_EQ(after.totalLogged() - before.totalLogged(), total);
+
+    auto recent = ErrorHandler::getRecentErrors(total);
+    ASSERT_EQ(recent.size(), ErrorHandler::EVENT_HISTORY_CAPACITY);
+    EXPECT_EQ(recent.front().message, std::to_string(total - ErrorHandler::EVENT_HISTORY_CAPACITY));
+    EXPECT_EQ(recent.back().message, std::to_string(total - 1));
+}
+
+// MARK: - Cursors
+
+TEST_F(ErrorHandlerTest, DrainEventsAdvancesCursor) {
+    uint64_t cursor = 0;
+    ErrorHandler::drainEvents(cursor);
+
+    for (int i = 0; i < 5; ++i) log(std::to_string(i));
+    auto first = ErrorHandler::drainEvents(cursor, 3);
+    ASSERT_EQ(first.size(), 3u);
+    EXPECT_EQ(first.back().message, "2");
+
+    auto rest = ErrorHandler::drainEvents(cursor);
+    ASSERT_EQ(rest.size(), 2u);
+    EXPECT_EQ(rest.front().message, "3");
+    EXPECT_TRUE(ErrorHandler::drainEvents(cursor).empty());
+
+    // Clearing keeps the cursor valid: only later events are returned
+    ErrorHandler::clearErrorLog();
+    log("after");
+    auto later = ErrorHandler::drainEvents(cursor);
+    ASSERT_EQ(later.size(), 1u);
+    EXPECT_EQ(later.front().message, "after");
+}
+
+TEST_F(ErrorHandlerTest, DrainEventsSkipsEventsThatLeftTheHistory) {
+    uint64_t cursor = 0;
+    ErrorHandler::drainEvents(cursor);
+    const uint64_t start = cursor;
+
+    const size_t total = ErrorHandler::EVENT_HISTORY_CAPACITY + 250;
+    for (size_t i = 0; i < total; ++i) log(std::to_string(i));
+
+    auto events = ErrorHandler::drainEvents(cursor);
+    ASSERT_EQ(events.size(), ErrorHandler::EVENT_HISTORY_CAPACITY);
+    EXPECT_EQ(events.front().message, "250");
+    EXPECT_EQ(cursor, start + total);
+}
+
+// MARK: - Counters
+
+TEST_F(ErrorHandlerTest, StatsCountBySeverityAndFilter) {
+    auto before = ErrorHandler::getStats();
+    ErrorHandler::setMinimumSeverity(ErrorSeverity::Warning);
+    log("kept", ErrorSeverity::Warning);
+    log("kept", ErrorSeverity::Critical);
+    log("kept", ErrorSeverity::Critical);
+    log("filtered", ErrorSeverity::Info);
+    log("filtered", ErrorSeverity::Debug);
+    auto after = ErrorHandler::getStats();
+
+    auto logged = [&](ErrorSeverity severity) {
+        size_t s = static_cast<size_t>(severity);
+        return after.logged[s] - before.logged[s];
+    };
+    EXPECT_EQ(logged(ErrorSeverity::Warning), 1u);
+    EXPECT_EQ(logged(ErrorSeverity::Critical), 2u);
+    EXPECT_EQ(logged(ErrorSeverity::Info), 0u);
+    EXPECT_EQ(after.filtered - before.filtered, 2u);
+    EXPECT_EQ(ErrorHandler::getRecentErrors().size(), 3u);
+
+    // Clearing the log leaves the counters alone
+    ErrorHandler::clearErrorLog();
+    EXPECT_EQ(ErrorHandler::getStats().totalLogged(), after.totalLogged());
+}
+
+// MARK: - Concurrency
+
+TEST_F(ErrorHandlerTest, ConcurrentProducersWithDrainingReader) {
+    const size_t producers = 8;
+    const size_t perProducer = 4000;
+
+    uint64_t cursor = 0;
+    ErrorHandler::drainEvents(cursor);
+    const uint64_t start = cursor;
+    auto before = ErrorHandler::getStats();
+
+    std::atomic<bool> done{false};
+    std::vector<ErrorContext> drained;
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            auto events = ErrorHandler::drainEvents(cursor, 256);
+            drained.insert(drained.end(), events.begin(), events.end());
+        }
+    });
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([p, perProducer] {
+            for (size_t i = 0; i < perProducer; ++i) {
+                log(std::to_string(p) + ":" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    auto rest = ErrorHandler::drainEvents(cursor);
+    drained.insert(drained.end(), rest.begin(), rest.end());
+    auto after = ErrorHandler::getStats();
+
+    // Every event is either stored or counted as dropped, and the cursor passed each stored one
+    uint64_t logged = after.totalLogged() - before.totalLogged();
+    EXPECT_EQ(logged + (after.dropped - before.dropped), producers * perProducer);
+    EXPECT_EQ(cursor - start, logged);
+    EXPECT_LE(drained.size(), logged);
+
+    // Nothing read twice, and each producer's events arrive in the order it logged them
+    std::set<std::pair<size_t, size_t>> seen;
+    std::map<size_t, size_t> next;
+    for (const auto& event : drained) {
+        auto id = parseMessage(event.message);
+        EXPECT_TRUE(seen.insert(id).second) << event.message;
+        EXPECT_GE(id.second, next[id.first]) << event.message;
+        next[id.first] = id.second + 1;
+    }
+}
+
+TEST_F(ErrorHandlerTest, ConcurrentRegistrationsKeepEveryCallback) {
+    const size_t threadCount = 8;
+    const size_t perThread = 50;
+    std::atomic<size_t> calls{0};
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&] {
+            for (size_t i = 0; i < perThread; ++i) {
+                ErrorHandler::registerErrorCallback([&calls](const ErrorContext&) {
+                    calls.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    log("once");
+    EXPECT_EQ(calls.load(), threadCount * perThread);
+
+    // A thread that already cached the list picks up the cleared one
+    ErrorHandler::clearErrorCallbacks();
+    log("none");
+    EXPECT_EQ(calls.load(), threadCount * perThread);
+}
+
+TEST_F(ErrorHandlerTest, ThrowingCallbackDoesNotStopOthers) {
+    size_t calls = 0;
+    ErrorHandler::registerErrorCallback([](const ErrorContext&) { throw std::runtime_error("bad"); });
+    ErrorHandler::registerErrorCallback([&calls](const ErrorContext&) { ++calls; });
+
+    EXPECT_NO_THROW(log("event"));
+    EXPECT_EQ(calls, 1u);
+}
@@ -0,0 +1,284 @@
+//
+//  test_feature_cache.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for the persistent feature cache and its C API
+//
+
+#include <gtest/gtest.h>
+#include "../include/feature_cache.hpp"
+#include "../include/harmoniq_sync.h"
+#include "test_signals.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class FeatureCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::string name = std::string("harmoniq_feature_cache_") +
+                           ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        directory = (std::filesystem::temp_directory_path() / name).string();
+        std::filesystem::remove_all(directory);
+
+        samples = TestSignals::gatedNoise(static_cast<size_t>(sampleRate * 3), 1);
+        ASSERT_TRUE(audio.loadAudio(samples.data(), samples.size(), sampleRate));
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    FeatureCache::Key keyFor(const AlignmentEngine::Config& config, harmoniq_sync_method_t method) const {
+        return {FeatureCache::hashContent(samples.data(), samples.size(), sampleRate),
+                FeatureCache::hashSettings(config, method)};
+    }
+
+    static void expectSameFeatures(const AlignmentEngine::ClipFeatures& a, const AlignmentEngine::ClipFeatures& b) {
+        EXPECT_EQ(a.method, b.method);
+        EXPECT_EQ(a.audioLength, b.audioLength);
+        EXPECT_EQ(a.sampleRate, b.sampleRate);
+        EXPECT_EQ(a.hopSize, b.hopSize);
+        EXPECT_EQ(a.energyHopSize, b.energyHopSize);
+        EXPECT_EQ(a.spectralFlux, b.spectralFlux);
+        EXPECT_EQ(a.energy, b.energy);
+        EXPECT_EQ(a.chroma.getNumFrames(), b.chroma.getNumFrames());
+        EXPECT_EQ(a.chroma.toVector(), b.chroma.toVector());
+        EXPECT_EQ(a.mfcc.getNumFrames(), b.mfcc.getNumFrames());
+        EXPECT_EQ(a.mfcc.toVector(), b.mfcc.toVector());
+    }
+
+    const double sampleRate = 22050.0;
+    std::string directory;
+    std::vector<float> samples;
+    AudioProcessor audio;
+};
+
+// MARK: - Key Tests
+
+TEST_F(FeatureCacheTest, ContentHashTracksSamplesAndRate) {
+    uint64_t hash = FeatureCache::hashContent(samples.data(), samples.size(), sampleRate);
+    EXPECT_EQ(hash, FeatureCache::hashContent(samples.data(), samples.size(), sampleRate));
+    EXPECT_NE(hash, FeatureCache::hashContent(samples.data(), samples.size(), 44100.0));
+    EXPECT_NE(hash, FeatureCache::hashContent(samples.data(), samples.size() - 1, sampleRate));
+
+    // A single changed sample anywhere changes the key
+    for (size_t position : {size_t(0), samples.size() / 2, samples.size() - 1}) {
+        auto edited = samples;
+        edited[position] += 1e-3f;
+        EXPECT_NE(hash, FeatureCache::hashContent(edited.data(), edited.size(), sampleRate)) << position;
+    }
+}
+
+TEST_F(FeatureCacheTest, SettingsHashTracksFeatureSettingsOnly) {
+    AlignmentEngine::Config config;
+    uint64_t hash = FeatureCache::hashSettings(config, HARMONIQ_SYNC_HYBRID);
+    EXPECT_NE(hash, FeatureCache::hashSettings(config, HARMONIQ_SYNC_MFCC));
+
+    auto changed = config;
+    changed.windowSize = 2048;
+    EXPECT_NE(hash, FeatureCache::hashSettings(changed, HARMONIQ_SYNC_HYBRID));
+    changed = config;
+    changed.analysisSampleRate = 16000.0;
+    EXPECT_NE(hash, FeatureCache::hashSettings(changed, HARMONIQ_SYNC_HYBRID));
+
+    // Search and scoring settings do not touch the features
+    changed = config;
+    changed.confidenceThreshold = 0.1;
+    changed.maxOffsetSamples = 12345;
+    changed.cascade.enabled = true;
+    EXPECT_EQ(hash, FeatureCache::hashSettings(changed, HARMONIQ_SYNC_HYBRID));
+}
+
+// MARK: - Storage Tests
+
+TEST_F(FeatureCacheTest, StoredFeaturesReadBackExactly) {
+    FeatureCache cache(directory);
+    AlignmentEngine engine;
+    auto features = engine.prepareFeatures(audio, HARMONIQ_SYNC_HYBRID);
+    auto key = keyFor(engine.getConfig(), HARMONIQ_SYNC_HYBRID);
+
+    AlignmentEngine::ClipFeatures loaded;
+    EXPECT_FALSE(cache.load(key, loaded));
+    ASSERT_TRUE(cache.store(key, features));
+    ASSERT_TRUE(cache.load(key, loaded));
+    expectSameFeatures(loaded, features);
+
+    EXPECT_EQ(cache.getHits(), 1u);
+    EXPECT_EQ(cache.getMisses(), 1u);
+}
+
+TEST_F(FeatureCacheTest, SixteenBitStoragesReadBackClosely) {
+    AlignmentEngine engine;
+    auto features = engine.prepareFeatures(audio, HARMONIQ_SYNC_HYBRID);
+    auto key = keyFor(engine.getConfig(), HARMONIQ_SYNC_HYBRID);
+
+    FeatureCache exact(directory);
+    ASSERT_TRUE(exact.store(key, features));
+    auto exactSize = std::filesystem::file_size(exact.pathFor(key));
+
+    // bfloat16 keeps 8 significant bits, Int16 a step of 1/32767 of each stream's peak
+    auto expectClose = [](const std::vector<float>& actual, const std::vector<float>& expected,
+                          FeatureCache::Storage storage) {
+        ASSERT_EQ(actual.size(), expected.size());
+        float peak = 0.0f;
+        for (float value : expected) peak = std::max(peak, std::abs(value));
+        for (size_t i = 0; i < expected.size(); ++i) {
+            float tolerance = storage == FeatureCache::Storage::BFloat16 ? std::abs(expected[i]) / 256.0f
+                                                                         : peak / 32767.0f;
+            EXPECT_NEAR(actual[i], expected[i], tolerance) << "value " << i;
+        }
+    };
+
+    for (auto storage : {FeatureCache::Storage::BFloat16, FeatureCache::Storage::Int16}) {
+        FeatureCache cache(directory, storage);
+        EXPECT_EQ(cache.getStorage(), storage);
+        EXPECT_NE(cache.pathFor(key), exact.pathFor(key));
+
+        AlignmentEngine::ClipFeatures loaded;
+        EXPECT_FALSE(cache.load(key, loaded));
+        ASSERT_TRUE(cache.store(key, features));
+        ASSERT_TRUE(cache.load(key, loaded));
+        EXPECT_LT(std::filesystem::file_size(cache.pathFor(key)), exactSize * 6 / 10);
+
+        EXPECT_EQ(loaded.audioLength, features.audioLength);
+        expectClose(loaded.spectralFlux, features.spectralFlux, storage);
+        expectClose(loaded.energy, features.energy, storage);
+        EXPECT_EQ(loaded.chroma.getNumFrames(), features.chroma.getNumFrames());
+        expectClose(loaded.chroma.toVector(), features.chroma.toVector(), storage);
+        EXPECT_EQ(loaded.mfcc.getNumFrames(), features.mfcc.getNumFrames());
+        expectClose(loaded.mfcc.toVector(), features.mfcc.toVector(), storage);
+
+        // A file of another storage is never decoded as this one
+        std::filesystem::copy_file(cache.pathFor(key), exact.pathFor(key),
+                                   std::filesystem::copy_options::overwrite_existing);
+        EXPECT_FALSE(exact.load(key, loaded));
+        ASSERT_TRUE(exact.store(key, features));
+    }
+}
+
+TEST_F(FeatureCacheTest, DamagedFilesAreMisses) {
+    FeatureCache cache(directory);
+    AlignmentEngine engine;
+    auto key = keyFor(engine.getConfig(), HARMONIQ_SYNC_CHROMA);
+    ASSERT_TRUE(cache.store(key, engine.prepareFeatures(audio, HARMONIQ_SYNC_CHROMA)));
+
+    auto size = std::filesystem::file_size(cache.pathFor(key));
+    std::filesystem::resize_file(cache.pathFor(key), size - 4);
+    AlignmentEngine::ClipFeatures loaded;
+    EXPECT_FALSE(cache.load(key, loaded));
+    EXPECT_EQ(loaded.audioLength, 0u);
+
+    {
+        std::ofstream garbage(cache.pathFor(key), std::ios::binary | std::ios::trunc);
+        garbage << std::string(512, 'x');
+    }
+    EXPECT_FALSE(cache.load(key, loaded));
+
+    // A file for another key is not taken for this one
+    FeatureCache::Key other = key;
+    other.settingsHash ^= 1;
+    ASSERT_TRUE(cache.store(key, engine.prepareFeatures(audio, HARMONIQ_SYNC_CHROMA)));
+    std::filesystem::copy_file(cache.pathFor(key), cache.pathFor(other));
+    EXPECT_FALSE(cache.load(other, loaded));
+}
+
+TEST_F(FeatureCacheTest, DirectoryIsCreatedOrRejected) {
+    EXPECT_THROW(FeatureCache(""), std::invalid_argument);
+
+    std::string nested = directory + "/a/b";
+    FeatureCache cache(nested);
+    EXPECT_TRUE(std::filesystem::is_directory(nested));
+
+    std::string file = directory + "/file";
+    { std::ofstream(file) << "x"; }
+    EXPECT_THROW(FeatureCache(file + "/sub"), std::invalid_argument);
+}
+
+// MARK: - Engine Integration Tests
+
+TEST_F(FeatureCacheTest, EngineReadsUnchangedClipsFromCache) {
+    auto cache = std::make_shared<FeatureCache>(directory);
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+
+    AlignmentEngine plain;
+    plain.setConfig(config);
+    AlignmentEngine cached;
+    cached.setConfig(config);
+    cached.setFeatureCache(cache);
+
+    auto extracted = plain.prepareFeatures(audio, HARMONIQ_SYNC_HYBRID);
+    expectSameFeatures(cached.prepareFeatures(audio, HARMONIQ_SYNC_HYBRID), extracted);
+    EXPECT_EQ(cache->getMisses(), 1u);
+
+    // Warm: no extraction at all
+    StageProfile profile;
+    AlignmentEngine::ClipFeatures warm;
+    {
+        StageProfiler profiler(&profile);
+        warm = cached.prepareFeatures(audio, HARMONIQ_SYNC_HYBRID);
+    }
+    expectSameFeatures(warm, extracted);
+    EXPECT_EQ(cache->getHits(), 1u);
+    EXPECT_EQ(profile.seconds(ProcessingStage::STFT), 0.0);
+
+    // Other settings get their own file
+    config.windowSize = 2048;
+    cached.setConfig(config);
+    cached.prepareFeatures(audio, HARMONIQ_SYNC_HYBRID);
+    EXPECT_EQ(cache->getMisses(), 2u);
+}
+
+TEST_F(FeatureCacheTest, CApiSetsCacheDirectory) {
+    auto* engine = harmoniq_sync_create_engine();
+    ASSERT_NE(engine, nullptr);
+
+    std::vector<float> target(2000, 0.0f);
+    target.insert(target.end(), samples.begin(), samples.end() - 2000);
+
+    harmoniq_sync_config_t config = harmoniq_sync_default_config();
+    config.confidence_threshold = 0.0;
+    ASSERT_EQ(harmoniq_sync_set_engine_config(engine, &config), HARMONIQ_SYNC_SUCCESS);
+    ASSERT_EQ(harmoniq_sync_set_feature_cache_directory(engine, directory.c_str()), HARMONIQ_SYNC_SUCCESS);
+    harmoniq_sync_result_t cold, warm;
+    ASSERT_EQ(harmoniq_sync_process(engine, samples.data(), samples.size(), target.data(), target.size(), &cold),
+              HARMONIQ_SYNC_SUCCESS);
+    ASSERT_EQ(harmoniq_sync_process(engine, samples.data(), samples.size(), target.data(), target.size(), &warm),
+              HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(warm.offset_samples, cold.offset_samples);
+    EXPECT_EQ(warm.confidence, cold.confidence);
+
+    size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        EXPECT_EQ(entry.path().extension(), ".features");
+        files++;
+    }
+    EXPECT_EQ(files, 2u);  // Reference and target
+
+    EXPECT_EQ(harmoniq_sync_set_feature_cache_directory(engine, nullptr), HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(harmoniq_sync_set_feature_cache_directory(nullptr, directory.c_str()), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+
+    std::string file = directory + "/file";
+    { std::ofstream(file) << "x"; }
+    EXPECT_EQ(harmoniq_sync_set_feature_cache_directory(engine, (file + "/sub").c_str()), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+
+    // 16-bit storage finds the same offset
+    ASSERT_EQ(harmoniq_sync_set_feature_cache(engine, directory.c_str(), HARMONIQ_SYNC_FEATURE_STORAGE_BFLOAT16),
+              HARMONIQ_SYNC_SUCCESS);
+    for (int pass = 0; pass < 2; ++pass) {
+        ASSERT_EQ(harmoniq_sync_process(engine, samples.data(), samples.size(), target.data(), target.size(), &warm),
+                  HARMONIQ_SYNC_SUCCESS);
+        EXPECT_EQ(warm.offset_samples, cold.offset_samples);
+    }
+    EXPECT_EQ(harmoniq_sync_set_feature_cache(engine, directory.c_str(), static_cast<harmoniq_sync_feature_storage_t>(3)),
+              HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+
+    harmoniq_sync_destroy_engine(engine);
+}
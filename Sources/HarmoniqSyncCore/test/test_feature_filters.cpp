@@ -0,0 +1,168 @@
+//
+//  test_feature_filters.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for median filters, percentiles and normalization
+//
+
+#include <gtest/gtest.h>
+#include "../include/feature_filters.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class FeatureFiltersTest : public ::testing::Test {
+protected:
+    std::vector<float> generateValues(size_t length, unsigned seed, int levels = 0) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+        std::uniform_int_distribution<int> level(0, std::max(0, levels - 1));
+
+        // Quantized values exercise ties
+        std::vector<float> values(length);
+        for (float& value : values) {
+            value = levels > 0 ? static_cast<float>(level(gen)) : dis(gen);
+        }
+        return values;
+    }
+
+    // Sort-based median filter the kernels must reproduce exactly
+    static std::vector<float> referenceMedianFilter(const std::vector<float>& features, int filterSize) {
+        std::vector<float> smoothed = features;
+        int half = filterSize / 2;
+        for (size_t i = half; i + half < features.size(); ++i) {
+            std::vector<float> window(features.begin() + (i - half), features.begin() + (i + half + 1));
+            std::sort(window.begin(), window.end());
+            smoothed[i] = window[window.size() / 2];
+        }
+        return smoothed;
+    }
+
+    template <typename T>
+    static T referencePercentile(std::vector<T> values, double fraction) {
+        std::sort(values.begin(), values.end());
+        return values[std::min(values.size() - 1, static_cast<size_t>(values.size() * fraction))];
+    }
+};
+
+// MARK: - Median Tests
+
+TEST_F(FeatureFiltersTest, NetworksMatchSortOnAllPermutations) {
+    for (size_t width : {3u, 5u, 7u}) {
+        std::vector<float> values(width);
+        for (size_t i = 0; i < width; ++i) {
+            values[i] = static_cast<float>(i);
+        }
+
+        do {
+            std::vector<float> work = values;
+            float median = width == 3 ? FeatureFilters::median3(work.data())
+                         : width == 5 ? FeatureFilters::median5(work.data())
+                                      : FeatureFilters::median7(work.data());
+            ASSERT_FLOAT_EQ(median, static_cast<float>(width / 2)) << "Width " << width;
+        } while (std::next_permutation(values.begin(), values.end()));
+    }
+}
+
+TEST_F(FeatureFiltersTest, MedianFilterMatchesSortBasedFilter) {
+    for (int filterSize : {3, 4, 5, 7, 9, 15, 31}) {
+        for (int levels : {0, 3}) {
+            auto values = generateValues(500, 21 + filterSize, levels);
+            auto expected = referenceMedianFilter(values, filterSize);
+
+            FeatureFilters::medianFilter(values, filterSize);
+            ASSERT_EQ(values, expected) << "Filter size " << filterSize << ", levels " << levels;
+        }
+    }
+}
+
+TEST_F(FeatureFiltersTest, MedianFilterIgnoresShortInput) {
+    std::vector<float> values = {3.0f, 1.0f, 2.0f};
+    FeatureFilters::medianFilter(values, 9);
+    EXPECT_EQ(values, (std::vector<float>{3.0f, 1.0f, 2.0f}));
+
+    FeatureFilters::medianFilter(values, 3);
+    EXPECT_EQ(values, (std::vector<float>{3.0f, 2.0f, 2.0f}));
+}
+
+TEST_F(FeatureFiltersTest, RunningMedianTracksSlidingWindow) {
+    auto values = generateValues(300, 5, 7);
+    const size_t width = 11;
+
+    FeatureFilters::RunningMedian running(width);
+    for (size_t i = 0; i < values.size(); ++i) {
+        running.push(values[i]);
+
+        size_t begin = i + 1 >= width ? i + 1 - width : 0;
+        std::vector<float> window(values.begin() + begin, values.begin() + i + 1);
+        std::sort(window.begin(), window.end());
+
+        ASSERT_EQ(running.size(), window.size());
+        ASSERT_FLOAT_EQ(running.median(), window[window.size() / 2]) << "at index " << i;
+    }
+
+    running.clear();
+    EXPECT_EQ(running.size(), 0u);
+    EXPECT_FLOAT_EQ(running.median(), 0.0f);
+}
+
+// MARK: - Percentile Tests
+
+TEST_F(FeatureFiltersTest, PercentileMatchesSortForShortAndLongInput) {
+    std::vector<float> scratch;
+
+    // Short inputs select directly, long ones go through the histogram
+    for (size_t length : {1u, 17u, 1000u, 100000u}) {
+        for (int levels : {0, 5}) {
+            auto values = generateValues(length, static_cast<unsigned>(length), levels);
+            for (float fraction : {0.0f, 0.1f, 0.5f, 0.9f, 1.0f}) {
+                EXPECT_FLOAT_EQ(FeatureFilters::percentile(values.data(), values.size(), fraction, scratch),
+                                referencePercentile(values, fraction))
+                    << "Length " << length << ", levels " << levels << ", fraction " << fraction;
+            }
+        }
+    }
+}
+
+TEST_F(FeatureFiltersTest, PercentileHandlesSkewedLongInput) {
+    // Nearly every value lands in one histogram bucket
+    std::vector<double> values(50000, 0.001);
+    values[0] = 1000.0;
+    values[1] = -1000.0;
+    for (size_t i = 2; i < values.size(); i += 7) {
+        values[i] = 0.001 * static_cast<double>(i % 13);
+    }
+
+    std::vector<double> scratch;
+    for (double fraction : {0.1, 0.5, 0.99}) {
+        EXPECT_DOUBLE_EQ(FeatureFilters::percentile(values.data(), values.size(), fraction, scratch),
+                         referencePercentile(values, fraction));
+    }
+}
+
+TEST_F(FeatureFiltersTest, AbsPercentileUsesMagnitudes) {
+    std::vector<double> values = {-5.0, 1.0, -2.0, 4.0, 3.0};
+    std::vector<double> scratch;
+
+    EXPECT_DOUBLE_EQ(FeatureFilters::absPercentile(values.data(), values.size(), 0.0, scratch), 1.0);
+    EXPECT_DOUBLE_EQ(FeatureFilters::absPercentile(values.data(), values.size(), 1.0, scratch), 5.0);
+    EXPECT_DOUBLE_EQ(FeatureFilters::percentile(values.data(), 0, 0.5, scratch), 0.0);
+}
+
+// MARK: - Normalization Tests
+
+TEST_F(FeatureFiltersTest, NormalizeRangeMapsToUnitInterval) {
+    std::vector<float> values = {2.0f, 4.0f, 3.0f, 6.0f};
+    FeatureFilters::normalizeRange(values);
+
+    EXPECT_FLOAT_EQ(values[0], 0.0f);
+    EXPECT_FLOAT_EQ(values[1], 0.5f);
+    EXPECT_FLOAT_EQ(values[2], 0.25f);
+    EXPECT_FLOAT_EQ(values[3], 1.0f);
+
+    std::vector<float> constant(4, 7.0f);
+    FeatureFilters::normalizeRange(constant);
+    EXPECT_EQ(constant, std::vector<float>(4, 7.0f));
+}
@@ -0,0 +1,141 @@
+//
+//  test_feature_matrix.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for aligned feature matrices and matrix-based extraction
+//
+
+#include <gtest/gtest.h>
+#include "../include/feature_matrix.hpp"
+#include "../include/audio_processor.hpp"
+#include "../include/correlation_engine.hpp"
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class FeatureMatrixTest : public ::testing::Test {
+protected:
+    std::vector<float> generateSamples(size_t length, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<float> noise(0.0f, 0.3f);
+
+        std::vector<float> samples(length);
+        for (float& sample : samples) {
+            sample = noise(gen);
+        }
+        return samples;
+    }
+
+    static bool isAligned(const float* pointer) {
+        return reinterpret_cast<std::uintptr_t>(pointer) % FeatureMatrix::ALIGNMENT == 0;
+    }
+};
+
+// MARK: - Layout Tests
+
+TEST_F(FeatureMatrixTest, StorageIsAlignedAndZeroed) {
+    FeatureMatrix matrix(37, 13);
+
+    EXPECT_TRUE(isAligned(matrix.data()));
+    EXPECT_EQ(matrix.getNumFrames(), 37u);
+    EXPECT_EQ(matrix.getNumDims(), 13u);
+    EXPECT_EQ(matrix.getStride(), 13u);
+    EXPECT_TRUE(matrix.isDense());
+    EXPECT_EQ(matrix.size(), 37u * 13u);
+    EXPECT_EQ(matrix.row(5), matrix.data() + 5 * 13);
+    EXPECT_EQ(matrix.toVector(), std::vector<float>(37 * 13, 0.0f));
+}
+
+TEST_F(FeatureMatrixTest, PaddedRowsCopyOutDense) {
+    FeatureMatrix matrix(3, 2, 16);
+    for (size_t frame = 0; frame < 3; ++frame) {
+        matrix.row(frame)[0] = static_cast<float>(frame);
+        matrix.row(frame)[1] = static_cast<float>(10 + frame);
+    }
+
+    // Rows start on their own cache line
+    EXPECT_FALSE(matrix.isDense());
+    EXPECT_TRUE(isAligned(matrix.row(2)));
+    EXPECT_EQ(matrix.toVector(), (std::vector<float>{0.0f, 10.0f, 1.0f, 11.0f, 2.0f, 12.0f}));
+    EXPECT_THROW(matrix.resize(3, 4, 2), std::invalid_argument);
+}
+
+TEST_F(FeatureMatrixTest, AppendKeepsExistingRows) {
+    FeatureMatrix matrix(0, 3);
+    for (size_t block = 0; block < 50; ++block) {
+        float* rows = matrix.appendFrames(2);
+        for (size_t i = 0; i < 6; ++i) {
+            rows[i] = static_cast<float>(block * 6 + i);
+        }
+    }
+
+    ASSERT_EQ(matrix.getNumFrames(), 100u);
+    EXPECT_TRUE(isAligned(matrix.data()));
+    auto values = matrix.toVector();
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_FLOAT_EQ(values[i], static_cast<float>(i));
+    }
+
+    matrix.clear();
+    EXPECT_TRUE(matrix.empty());
+    EXPECT_EQ(matrix.getNumDims(), 3u);
+}
+
+TEST_F(FeatureMatrixTest, FrameCountMatchesSlidingWindow) {
+    EXPECT_EQ(FeatureMatrix::frameCount(4096, 1024, 256), 13u);
+    EXPECT_EQ(FeatureMatrix::frameCount(1024, 1024, 256), 1u);
+    EXPECT_EQ(FeatureMatrix::frameCount(1000, 1024, 256), 0u);
+    EXPECT_EQ(FeatureMatrix::frameCount(4096, 1024, 0), 0u);
+}
+
+// MARK: - Extraction Tests
+
+TEST_F(FeatureMatrixTest, MatrixExtractionMatchesFlatExtraction) {
+    auto samples = generateSamples(22050, 31);
+    AudioProcessor processor;
+    ASSERT_TRUE(processor.loadAudio(samples.data(), samples.size(), 22050.0));
+
+    const Spectrogram& spectrogram = processor.getSpectrogram(1024, 256);
+    EXPECT_TRUE(isAligned(spectrogram.magnitudes.data()));
+    EXPECT_EQ(spectrogram.numFrames, FeatureMatrix::frameCount(samples.size(), 1024, 256));
+
+    FeatureMatrix chroma, mfcc;
+    processor.extractChromaFeatures(spectrogram, chroma, 12, true);
+    processor.extractMFCC(spectrogram, mfcc, 13, 26);
+
+    EXPECT_EQ(chroma.getNumFrames(), spectrogram.numFrames);
+    EXPECT_EQ(chroma.getNumDims(), 12u);
+    EXPECT_EQ(chroma.toVector(), processor.extractChromaFeatures(spectrogram, 12, true));
+    EXPECT_EQ(mfcc.getNumDims(), 13u);
+    EXPECT_EQ(mfcc.toVector(), processor.extractMFCC(spectrogram, 13, 26));
+
+    // A reused matrix keeps its storage when the shape shrinks
+    const float* storage = mfcc.data();
+    processor.extractMFCC(processor.getSpectrogram(1024, 512), mfcc, 13, 26);
+    EXPECT_EQ(mfcc.data(), storage);
+}
+
+TEST_F(FeatureMatrixTest, PaddedMatrixCorrelatesLikeDenseVector) {
+    auto values = generateSamples(300 * 5, 32);
+    FeatureMatrix dense(300, 5), padded(300, 5, 8);
+    for (size_t frame = 0; frame < 300; ++frame) {
+        for (size_t dim = 0; dim < 5; ++dim) {
+            dense.row(frame)[dim] = values[frame * 5 + dim];
+            padded.row(frame)[dim] = values[frame * 5 + dim];
+        }
+    }
+
+    CorrelationEngine engine;
+    for (auto mode : {CorrelationEngine::Mode::Direct, CorrelationEngine::Mode::FFT}) {
+        auto expected = engine.crossCorrelateMultichannel(values, values, 5, 50, CorrelationEngine::Layout::FrameMajor,
+                                                          {}, mode);
+        auto fromDense = engine.crossCorrelateMultichannel(dense, padded, 50, {}, mode);
+        ASSERT_EQ(fromDense.size(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            EXPECT_NEAR(fromDense[k], expected[k], 1e-9) << "at lag index " << k;
+        }
+    }
+}
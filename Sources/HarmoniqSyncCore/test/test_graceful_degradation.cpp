@@ -0,0 +1,98 @@
+//
+//  test_graceful_degradation.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for cost-based degradation and parameter adjustment
+//
+
+#include <gtest/gtest.h>
+#include "../include/graceful_degradation.hpp"
+#include "../include/cost_model.hpp"
+#include "../include/harmoniq_sync.h"
+#include <string>
+
+using namespace HarmoniqSync;
+
+class GracefulDegradationTest : public ::testing::Test {
+protected:
+    // Only the length and rate of a report enter the cost prediction
+    AudioQualityReport report(double seconds) const {
+        AudioQualityReport quality{};
+        quality.sampleRate = sampleRate;
+        quality.sampleCount = static_cast<size_t>(seconds * sampleRate);
+        quality.durationSeconds = seconds;
+        return quality;
+    }
+
+    CostModel::Prediction predict(const harmoniq_sync_config_t& config, double seconds) const {
+        size_t length = static_cast<size_t>(seconds * sampleRate);
+        auto job = CostModel::Job::fromConfig(config, HARMONIQ_SYNC_SPECTRAL_FLUX, length, length, sampleRate);
+        return CostModel::shared()->predict(job);
+    }
+
+    const double sampleRate = 44100.0;
+    const double clipSeconds = 600.0;
+};
+
+// MARK: - Recommendation
+
+TEST_F(GracefulDegradationTest, AdmittedJobIsNotDegraded) {
+    harmoniq_sync_config_t config = harmoniq_sync_default_config();
+    auto prediction = predict(config, clipSeconds);
+
+    auto result = GracefulDegradation::recommendDegradation(report(clipSeconds), report(clipSeconds), config,
+                                                            prediction.peakBytes * 2, prediction.upperSeconds * 2.0);
+    EXPECT_TRUE(result.canRecover);
+    EXPECT_EQ(result.levelApplied, DegradationLevel::None);
+    EXPECT_EQ(result.modifiedConfig.window_size, config.window_size);
+    EXPECT_EQ(result.modifiedConfig.hop_size, config.hop_size);
+}
+
+TEST_F(GracefulDegradationTest, TightDeadlineDegradesUntilPredictionFits) {
+    harmoniq_sync_config_t config = harmoniq_sync_default_config();
+    auto prediction = predict(config, clipSeconds);
+    double deadline = prediction.upperSeconds * 0.6;
+
+    auto result = GracefulDegradation::recommendDegradation(report(clipSeconds), report(clipSeconds), config,
+                                                            0, deadline);
+    EXPECT_EQ(result.strategyUsed, DegradationStrategy::ReduceQuality);
+    EXPECT_TRUE(result.canRecover) << result.description;
+    EXPECT_LE(predict(result.modifiedConfig, clipSeconds).upperSeconds, deadline);
+    EXPECT_GT(result.processingSpeedup, 1.0);
+    EXPECT_DOUBLE_EQ(result.processingSpeedup,
+                     prediction.seconds / predict(result.modifiedConfig, clipSeconds).seconds);
+}
+
+TEST_F(GracefulDegradationTest, UnreachableDeadlineCannotRecover) {
+    harmoniq_sync_config_t config = harmoniq_sync_default_config();
+    auto result = GracefulDegradation::recommendDegradation(report(clipSeconds), report(clipSeconds), config,
+                                                            0, 1e-6);
+    EXPECT_FALSE(result.canRecover);
+    EXPECT_NE(result.description.find("still exceeds"), std::string::npos);
+}
+
+// MARK: - Parameter Adjustment
+
+TEST_F(GracefulDegradationTest, TimeAdjustmentStopsAtFirstFittingSetting) {
+    harmoniq_sync_config_t config = harmoniq_sync_default_config();
+    const size_t length = static_cast<size_t>(clipSeconds * sampleRate);
+    auto upper = [&](const harmoniq_sync_config_t& candidate) {
+        auto job = CostModel::Job::fromConfig(candidate, HARMONIQ_SYNC_SPECTRAL_FLUX, length, length, sampleRate);
+        return CostModel::shared()->predict(job, 0.95).upperSeconds;
+    };
+
+    // A deadline the base configuration meets leaves it alone
+    auto unchanged = AdaptiveParameterAdjuster::adjustForTimeConstraints(
+        config, HARMONIQ_SYNC_SPECTRAL_FLUX, length, length, sampleRate, upper(config) * 1.5);
+    EXPECT_EQ(unchanged.hop_size, config.hop_size);
+    EXPECT_EQ(unchanged.coarse_hop_size, config.coarse_hop_size);
+
+    // Half the hop is the first step, so a deadline it meets stops there
+    harmoniq_sync_config_t longerHop = config;
+    longerHop.hop_size = config.window_size / 2;
+    auto adjusted = AdaptiveParameterAdjuster::adjustForTimeConstraints(
+        config, HARMONIQ_SYNC_SPECTRAL_FLUX, length, length, sampleRate, upper(longerHop));
+    EXPECT_EQ(adjusted.hop_size, longerHop.hop_size);
+    EXPECT_EQ(adjusted.window_size, config.window_size);
+    EXPECT_EQ(adjusted.coarse_hop_size, config.coarse_hop_size);
+}
@@ -0,0 +1,199 @@
+//
+//  test_input_validator.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for input validation, quality reports and cost estimates
+//
+
+#include <gtest/gtest.h>
+#include "../include/input_validator.hpp"
+#include "../include/audio_processor.hpp"
+#include "../include/audio_statistics.hpp"
+#include "../include/cost_model.hpp"
+#include "../include/harmoniq_sync.h"
+#include "test_signals.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class InputValidatorTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        CostModel::setShared(nullptr);
+        InputValidator::setValidationLimits(InputValidator::ValidationLimits{});
+    }
+
+    const double sampleRate = 44100.0;
+};
+
+// MARK: - Quality Reports
+
+TEST_F(InputValidatorTest, QualityReportMatchesSeparatePasses) {
+    auto samples = TestSignals::mixedSignal(44100 * 2 + 17, 23);
+    auto report = InputValidator::analyzeAudioQuality(samples.data(), samples.size(), sampleRate, "mixed");
+
+    // The configured limits: -60 dB silence, clipping at 0.95 of full scale
+    double squares = 0.0, peak = 0.0;
+    size_t silent = 0, clipped = 0, crossings = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        float magnitude = std::fabs(samples[i]);
+        squares += static_cast<double>(samples[i]) * samples[i];
+        peak = std::max(peak, static_cast<double>(magnitude));
+        silent += magnitude < 0.001f;
+        clipped += magnitude >= 0.95f;
+        if (i > 0) crossings += (samples[i] >= 0.0f) != (samples[i - 1] >= 0.0f);
+    }
+    double n = static_cast<double>(samples.size());
+
+    EXPECT_EQ(report.sampleCount, samples.size());
+    EXPECT_DOUBLE_EQ(report.durationSeconds, n / sampleRate);
+    EXPECT_NEAR(report.rmsLevel, std::sqrt(squares / n), 1e-5);
+    EXPECT_DOUBLE_EQ(report.peakLevel, peak);
+    EXPECT_NEAR(report.silenceRatio, silent / n, 1e-12);
+    EXPECT_NEAR(report.clippingRatio, clipped / n, 1e-12);
+    EXPECT_NEAR(report.zeroCrossingRate, crossings / (n - 1.0), 1e-12);
+    EXPECT_NEAR(report.dynamicRange, 20.0 * std::log10(peak / std::sqrt(squares / n)), 1e-3);
+    EXPECT_GT(clipped, 0u);
+
+    EXPECT_TRUE(report.hasSufficientContent);
+    EXPECT_FALSE(report.hasExcessiveClipping);
+    EXPECT_FALSE(report.isMonotonic);
+}
+
+TEST_F(InputValidatorTest, QualityReportFlagsSilentAndConstantClips) {
+    std::vector<float> silence(44100, 0.0f);
+    auto silent = InputValidator::analyzeAudioQuality(silence.data(), silence.size(), sampleRate, "silence");
+    EXPECT_DOUBLE_EQ(silent.silenceRatio, 1.0);
+    EXPECT_FALSE(silent.hasSufficientContent);
+    EXPECT_TRUE(silent.isMonotonic);
+    EXPECT_FALSE(silent.warnings.empty());
+
+    std::vector<float> dc(44100, 0.3f);
+    auto constant = InputValidator::analyzeAudioQuality(dc.data(), dc.size(), sampleRate, "dc");
+    EXPECT_TRUE(constant.hasSufficientContent);
+    EXPECT_TRUE(constant.isMonotonic);
+    EXPECT_DOUBLE_EQ(constant.zeroCrossingRate, 0.0);
+}
+
+TEST_F(InputValidatorTest, ProcessorReportReusesLoaderPass) {
+    auto samples = TestSignals::tone(1000.0, sampleRate, 44100);
+    AudioProcessor processor;
+    ASSERT_TRUE(processor.loadAudio(samples.data(), samples.size(), sampleRate));
+
+    // Without a spectrogram the centroid falls back to the zero-crossing estimate
+    auto direct = InputValidator::analyzeAudioQuality(samples.data(), samples.size(), sampleRate, "tone");
+    auto loaded = InputValidator::analyzeAudioQuality(processor, "tone");
+    EXPECT_EQ(loaded.sampleCount, direct.sampleCount);
+    EXPECT_DOUBLE_EQ(loaded.rmsLevel, direct.rmsLevel);
+    EXPECT_DOUBLE_EQ(loaded.zeroCrossingRate, direct.zeroCrossingRate);
+    EXPECT_DOUBLE_EQ(loaded.spectralCentroid, direct.spectralCentroid);
+    EXPECT_NEAR(loaded.spectralCentroid, 1000.0, 5.0);
+
+    // Once the processor has a spectrogram the report takes its centroid
+    const Spectrogram& spectrogram = processor.getSpectrogram(2048);
+    auto spectral = InputValidator::analyzeAudioQuality(processor, "tone");
+    EXPECT_DOUBLE_EQ(spectral.spectralCentroid, AudioStatistics::spectralCentroid(spectrogram));
+    EXPECT_DOUBLE_EQ(spectral.spectralRolloff, 1.5 * spectral.spectralCentroid);
+    EXPECT_DOUBLE_EQ(spectral.rmsLevel, direct.rmsLevel);
+}
+
+TEST_F(InputValidatorTest, ProcessorReportHonoursConfiguredThresholds) {
+    auto samples = TestSignals::mixedSignal(44100, 23);
+    AudioProcessor processor;
+    ASSERT_TRUE(processor.loadAudio(samples.data(), samples.size(), sampleRate));
+
+    // The loader counted clipping at 0.95; a lower limit needs its own pass
+    InputValidator::ValidationLimits limits;
+    limits.clippingLevel = 0.5;
+    limits.silenceThreshold = -20.0;
+    InputValidator::setValidationLimits(limits);
+
+    auto expected = AudioStatistics::measure(samples.data(), samples.size(),
+                                             static_cast<float>(std::pow(10.0, -20.0 / 20.0)), 0.5f);
+    auto report = InputValidator::analyzeAudioQuality(processor, "mixed");
+    EXPECT_DOUBLE_EQ(report.clippingRatio, expected.clippingRatio());
+    EXPECT_DOUBLE_EQ(report.silenceRatio, expected.silenceRatio());
+    EXPECT_GT(report.clippingRatio, processor.getStatistics().clippingRatio());
+}
+
+TEST_F(InputValidatorTest, NonFiniteSamplesFailBeforeTheReport) {
+    auto samples = TestSignals::mixedSignal(44100, 23);
+    samples[5000] = std::numeric_limits<float>::quiet_NaN();
+
+    auto format = InputValidator::validateAudioFormat(samples.data(), samples.size(), sampleRate, "reference");
+    EXPECT_EQ(format.code, HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+    EXPECT_NE(format.message.find("sample 5000"), std::string::npos) << format.message;
+
+    auto clean = TestSignals::mixedSignal(44100, 23);
+    auto result = InputValidator::validateSyncRequest(samples.data(), samples.size(), clean.data(), clean.size(),
+                                                      sampleRate, HARMONIQ_SYNC_SPECTRAL_FLUX,
+                                                      harmoniq_sync_default_config());
+    EXPECT_FALSE(result.isValid);
+    ASSERT_EQ(result.errors.size(), 1u);
+    EXPECT_EQ(result.errors.front().code, HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+
+    // A clean request reports on both clips from the validation pass
+    auto valid = InputValidator::validateSyncRequest(clean.data(), clean.size(), clean.data(), clean.size(),
+                                                     sampleRate, HARMONIQ_SYNC_SPECTRAL_FLUX,
+                                                     harmoniq_sync_default_config());
+    EXPECT_EQ(valid.referenceAudio.sampleCount, clean.size());
+    EXPECT_DOUBLE_EQ(valid.referenceAudio.rmsLevel,
+                     InputValidator::analyzeAudioQuality(clean.data(), clean.size(), sampleRate, "c").rmsLevel);
+}
+
+// MARK: - Performance Estimation
+
+TEST_F(InputValidatorTest, EstimatesComeFromSharedCostModel) {
+    harmoniq_sync_config_t config = harmoniq_sync_default_config();
+    const size_t length = static_cast<size_t>(60.0 * sampleRate);
+    auto model = CostModel::shared();
+
+    for (auto method : {HARMONIQ_SYNC_SPECTRAL_FLUX, HARMONIQ_SYNC_MFCC, HARMONIQ_SYNC_HYBRID}) {
+        auto job = CostModel::Job::fromConfig(config, method, length, length, sampleRate);
+        EXPECT_DOUBLE_EQ(InputValidator::estimateProcessingTime(length, sampleRate, method, config),
+                         model->predict(job).seconds);
+    }
+    EXPECT_GT(InputValidator::estimateProcessingTime(2 * length, sampleRate, HARMONIQ_SYNC_CHROMA, config),
+              InputValidator::estimateProcessingTime(length, sampleRate, HARMONIQ_SYNC_CHROMA, config));
+    EXPECT_DOUBLE_EQ(InputValidator::estimateProcessingTime(length, 0.0, HARMONIQ_SYNC_CHROMA, config), 0.0);
+
+    // Hybrid holds every feature matrix, so it bounds the memory of each single method
+    auto hybrid = CostModel::Job::fromConfig(config, HARMONIQ_SYNC_HYBRID, length, length / 2, sampleRate);
+    auto flux = CostModel::Job::fromConfig(config, HARMONIQ_SYNC_SPECTRAL_FLUX, length, length / 2, sampleRate);
+    size_t memory = InputValidator::estimateMemoryUsage(length, length / 2, config);
+    EXPECT_EQ(memory, model->predict(hybrid).peakBytes);
+    EXPECT_GE(memory, model->predict(flux).peakBytes);
+}
+
+TEST_F(InputValidatorTest, EstimatesFollowInstalledProfile) {
+    harmoniq_sync_config_t config = harmoniq_sync_default_config();
+    const size_t length = static_cast<size_t>(30.0 * sampleRate);
+    double builtIn = InputValidator::estimateProcessingTime(length, sampleRate, HARMONIQ_SYNC_ENERGY, config);
+
+    // Runs four times slower than the built-in coefficients predict
+    CostModel reference;
+    std::vector<CostModel::Sample> samples;
+    for (double seconds : {10.0, 20.0, 40.0, 80.0}) {
+        CostModel::Sample sample;
+        sample.job = CostModel::Job::fromConfig(config, HARMONIQ_SYNC_ENERGY,
+                                                static_cast<size_t>(seconds * sampleRate),
+                                                static_cast<size_t>(seconds * sampleRate), sampleRate);
+        auto prediction = reference.predict(sample.job);
+        for (size_t s = 0; s < PROCESSING_STAGE_COUNT; ++s) {
+            sample.stages.stageSeconds[s] = 4.0 * prediction.stageSeconds[s];
+        }
+        sample.wallSeconds = 4.0 * prediction.seconds;
+        samples.push_back(sample);
+    }
+    auto slower = std::make_shared<CostModel>();
+    slower->calibrate(samples, "slower-machine");
+    CostModel::setShared(slower);
+
+    EXPECT_NEAR(InputValidator::estimateProcessingTime(length, sampleRate, HARMONIQ_SYNC_ENERGY, config),
+                4.0 * builtIn, 0.05 * 4.0 * builtIn);
+}
@@ -0,0 +1,264 @@
+//
+//  test_landmark_index.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for landmark fingerprints, offset voting, landmark alignment and clip grouping
+//
+
+#include <gtest/gtest.h>
+#include "../include/landmark_index.hpp"
+#include "../include/alignment_engine.hpp"
+#include "../include/harmoniq_sync.h"
+#include "test_signals.hpp"
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class LandmarkIndexTest : public ::testing::Test {
+protected:
+    // Excerpt of a clip with independent noise on top, as picked up by a second recorder
+    std::vector<float> excerpt(const std::vector<float>& samples, size_t start, size_t length, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<float> noise(0.0f, 0.01f);
+        std::vector<float> result(samples.begin() + start, samples.begin() + start + length);
+        for (auto& sample : result) sample += noise(gen);
+        return result;
+    }
+
+    const double sampleRate = 22050.0;
+};
+
+// MARK: - Index Tests
+
+TEST_F(LandmarkIndexTest, VotesFindOffsetPerClip) {
+    std::vector<LandmarkIndex::Landmark> first, second, query;
+    for (uint32_t i = 0; i < 50; ++i) {
+        first.push_back({1000 + i, 100 + 7 * i});
+        second.push_back({2000 + i, 40 + 5 * i});
+    }
+    // The query holds part of the first clip 30 frames earlier and of the second 12 frames later
+    for (uint32_t i = 10; i < 30; ++i) query.push_back({1000 + i, 100 + 7 * i - 30});
+    for (uint32_t i = 20; i < 25; ++i) query.push_back({2000 + i, 40 + 5 * i + 12});
+
+    LandmarkIndex index({first, second}, {});
+    EXPECT_EQ(index.getClipCount(), 2u);
+    EXPECT_EQ(index.getLandmarkCount(), 100u);
+    EXPECT_EQ(index.getLandmarkCount(1), 50u);
+
+    auto matches = index.query(query, 4);
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_EQ(matches[0].clip, 0u);
+    EXPECT_EQ(matches[0].offsetFrames, -30);
+    EXPECT_EQ(matches[0].votes, 20u);
+    EXPECT_EQ(matches[1].clip, 1u);
+    EXPECT_EQ(matches[1].offsetFrames, 12);
+    EXPECT_EQ(matches[1].votes, 5u);
+
+    // Fewer votes than required are not candidates
+    matches = index.query(query, 4, 1, 6);
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0].clip, 0u);
+}
+
+TEST_F(LandmarkIndexTest, ToleranceGathersJitteredVotes) {
+    std::vector<LandmarkIndex::Landmark> clip, query;
+    for (uint32_t i = 0; i < 40; ++i) {
+        clip.push_back({i, 10 * i});
+        query.push_back({i, 10 * i + 100 + (i % 3 == 0 ? 1 : 0)});
+    }
+
+    LandmarkIndex index({clip}, {});
+    auto exact = index.query(query, 4, 0);
+    ASSERT_FALSE(exact.empty());
+    EXPECT_EQ(exact[0].offsetFrames, 100);
+    EXPECT_LT(exact[0].votes, 40u);
+
+    // Neighbouring offsets vote together and are not reported as separate matches
+    auto tolerant = index.query(query, 4, 1);
+    ASSERT_EQ(tolerant.size(), 1u);
+    EXPECT_EQ(tolerant[0].votes, 40u);
+    EXPECT_NEAR(static_cast<double>(tolerant[0].offsetFrames), 100.0, 1.0);
+}
+
+TEST_F(LandmarkIndexTest, CommonHashesDoNotVote) {
+    std::vector<LandmarkIndex::Landmark> clip;
+    for (uint32_t i = 0; i < 20; ++i) clip.push_back({7, i});
+
+    LandmarkIndex::Settings settings;
+    settings.maxPostings = 10;
+    LandmarkIndex index({clip}, settings);
+    EXPECT_TRUE(index.query({{7, 5}, {7, 6}}, 4, 0, 1).empty());
+
+    settings.maxPostings = 20;
+    EXPECT_FALSE(LandmarkIndex({clip}, settings).query({{7, 5}, {7, 6}}, 4, 0, 1).empty());
+}
+
+TEST_F(LandmarkIndexTest, InvalidSettingsThrow) {
+    LandmarkIndex::Settings settings;
+    settings.numBands = 64;
+    EXPECT_THROW(LandmarkIndex({}, settings), std::invalid_argument);
+
+    settings = {};
+    settings.maxPairFrames = 2000;
+    EXPECT_THROW(LandmarkIndex({}, settings), std::invalid_argument);
+
+    settings = {};
+    settings.fanOut = 0;
+    AudioProcessor audio;
+    EXPECT_THROW(LandmarkIndex::extractLandmarks({1, 2}, audio, 256, settings), std::invalid_argument);
+}
+
+// MARK: - Fingerprint Tests
+
+TEST_F(LandmarkIndexTest, ExcerptSharesLandmarksAtItsOffset) {
+    auto reference = TestSignals::toneBursts(static_cast<size_t>(sampleRate * 90), sampleRate, 1);
+    const size_t start = 256 * 2000;
+    auto target = excerpt(reference, start, static_cast<size_t>(sampleRate * 15), 2);
+
+    AudioProcessor refAudio, targetAudio;
+    ASSERT_TRUE(refAudio.loadAudio(reference.data(), reference.size(), sampleRate));
+    ASSERT_TRUE(targetAudio.loadAudio(target.data(), target.size(), sampleRate));
+
+    AlignmentEngine engine;
+    auto refFeatures = engine.prepareFeatures(refAudio, HARMONIQ_SYNC_SPECTRAL_FLUX);
+    auto targetFeatures = engine.prepareFeatures(targetAudio, HARMONIQ_SYNC_SPECTRAL_FLUX);
+    auto refLandmarks = engine.extractLandmarks(refAudio, refFeatures);
+    auto targetLandmarks = engine.extractLandmarks(targetAudio, targetFeatures);
+    ASSERT_GT(targetLandmarks.size(), 100u);
+
+    LandmarkIndex index({refLandmarks}, engine.getConfig().landmarks.fingerprint);
+    auto matches = index.query(targetLandmarks, 2);
+    ASSERT_FALSE(matches.empty());
+    EXPECT_NEAR(static_cast<double>(matches[0].offsetFrames), -2000.0, 1.0);
+
+    // The true offset stands well clear of chance agreements elsewhere
+    EXPECT_GT(matches[0].votes, targetLandmarks.size() / 4);
+    if (matches.size() > 1) {
+        EXPECT_GT(matches[0].votes, 4 * matches[1].votes);
+    }
+}
+
+// MARK: - Engine Tests
+
+TEST_F(LandmarkIndexTest, FindsShortClipAnywhereInLongReference) {
+    auto reference = TestSignals::toneBursts(static_cast<size_t>(sampleRate * 180), sampleRate, 3);
+    AudioProcessor refAudio;
+    ASSERT_TRUE(refAudio.loadAudio(reference.data(), reference.size(), sampleRate));
+
+    AlignmentEngine engine;
+    auto prepared = engine.prepareLandmarkReference(refAudio);
+    ASSERT_TRUE(prepared.landmarks);
+    EXPECT_EQ(prepared.landmarks->getClipCount(), 1u);
+
+    // Far outside the default dense lag window of 25% of the 20 s target
+    for (size_t start : {size_t(12345), size_t(sampleRate * 97.3), size_t(sampleRate * 159)}) {
+        auto target = excerpt(reference, start, static_cast<size_t>(sampleRate * 20), 4);
+        AudioProcessor targetAudio;
+        ASSERT_TRUE(targetAudio.loadAudio(target.data(), target.size(), sampleRate));
+
+        // Prepared excerpts rarely fall inside a short target, so the offset is feature accurate
+        auto result = engine.alignLandmarks(prepared, targetAudio);
+        ASSERT_EQ(result.error, HARMONIQ_SYNC_SUCCESS) << start;
+        EXPECT_NEAR(static_cast<double>(result.offset_samples), -static_cast<double>(start), 256.0) << start;
+        EXPECT_STREQ(result.method, "Landmarks");
+        
+        // With the reference PCM at hand refinement uses excerpts from the overlap
+        auto refined = engine.alignLandmarks(refAudio, targetAudio);
+        ASSERT_EQ(refined.error, HARMONIQ_SYNC_SUCCESS) << start;
+        EXPECT_NEAR(static_cast<double>(refined.offset_samples), -static_cast<double>(start), 2.0) << start;
+    }
+}
+
+TEST_F(LandmarkIndexTest, UnrelatedAudioIsRejected) {
+    auto reference = TestSignals::toneBursts(static_cast<size_t>(sampleRate * 60), sampleRate, 5);
+    auto unrelated = TestSignals::toneBursts(static_cast<size_t>(sampleRate * 15), sampleRate, 6);
+
+    AudioProcessor refAudio, targetAudio;
+    ASSERT_TRUE(refAudio.loadAudio(reference.data(), reference.size(), sampleRate));
+    ASSERT_TRUE(targetAudio.loadAudio(unrelated.data(), unrelated.size(), sampleRate));
+
+    AlignmentEngine engine;
+    auto result = engine.alignLandmarks(refAudio, targetAudio);
+    EXPECT_EQ(result.error, HARMONIQ_SYNC_ERROR_PROCESSING_FAILED);
+}
+
+TEST_F(LandmarkIndexTest, RequiresLandmarkReference) {
+    auto reference = TestSignals::toneBursts(static_cast<size_t>(sampleRate * 10), sampleRate, 7);
+    AudioProcessor refAudio;
+    ASSERT_TRUE(refAudio.loadAudio(reference.data(), reference.size(), sampleRate));
+
+    AlignmentEngine engine;
+    auto plain = engine.prepareReferenceFeatures(refAudio, HARMONIQ_SYNC_SPECTRAL_FLUX);
+    EXPECT_EQ(engine.alignLandmarks(plain, refAudio).error, HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+}
+
+// MARK: - Grouping Tests
+
+TEST_F(LandmarkIndexTest, GroupsClipsOnOneTimeline) {
+    auto event = TestSignals::toneBursts(static_cast<size_t>(sampleRate * 90), sampleRate, 8);
+    auto unrelated = TestSignals::toneBursts(static_cast<size_t>(sampleRate * 20), sampleRate, 9);
+
+    // Two recorders covering the event in overlapping takes, a third with one short take
+    const std::vector<std::pair<double, double>> takes = {
+        {0.0, 30.0}, {35.0, 65.0}, {15.0, 45.0}, {55.0, 90.0}, {25.0, 40.0}
+    };
+    std::vector<std::vector<float>> samples;
+    for (size_t i = 0; i < takes.size(); ++i) {
+        size_t start = static_cast<size_t>(takes[i].first * sampleRate);
+        size_t length = static_cast<size_t>((takes[i].second - takes[i].first) * sampleRate);
+        samples.push_back(excerpt(event, start, length, 20 + static_cast<unsigned>(i)));
+    }
+    samples.push_back(unrelated);
+
+    std::vector<AudioProcessor> clips(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        ASSERT_TRUE(clips[i].loadAudio(samples[i].data(), samples[i].size(), sampleRate));
+    }
+
+    AlignmentEngine engine;
+    auto grouping = engine.groupClips(clips);
+    ASSERT_EQ(grouping.clips.size(), samples.size());
+    EXPECT_EQ(grouping.groupCount, 2u);
+
+    for (size_t i = 0; i < takes.size(); ++i) {
+        EXPECT_EQ(grouping.clips[i].group, 0u) << i;
+        EXPECT_GT(grouping.clips[i].measurements, 0u) << i;
+        EXPECT_NEAR(grouping.clips[i].startSamples, std::floor(takes[i].first * sampleRate), 2.0) << i;
+    }
+    EXPECT_EQ(grouping.clips.back().group, 1u);
+    EXPECT_EQ(grouping.clips.back().measurements, 0u);
+    EXPECT_EQ(grouping.clips.back().startSamples, 0.0);
+
+    // Only pairs sharing fingerprints were verified, never the unrelated clip
+    for (const auto& pair : grouping.pairs) {
+        EXPECT_LT(pair.reference, pair.target);
+        if (pair.consistent) {
+            EXPECT_NE(pair.target, takes.size());
+        }
+    }
+}
+
+TEST_F(LandmarkIndexTest, CApiGroupsClips) {
+    auto event = TestSignals::toneBursts(static_cast<size_t>(sampleRate * 40), sampleRate, 10);
+    auto first = excerpt(event, 0, static_cast<size_t>(sampleRate * 25), 11);
+    auto second = excerpt(event, static_cast<size_t>(sampleRate * 12), static_cast<size_t>(sampleRate * 28), 12);
+
+    const float* audios[] = {second.data(), first.data()};
+    const size_t lengths[] = {second.size(), first.size()};
+    auto grouping = harmoniq_sync_group_clips(audios, lengths, 2, sampleRate, nullptr);
+    ASSERT_EQ(grouping.error, HARMONIQ_SYNC_SUCCESS);
+    ASSERT_EQ(grouping.count, 2u);
+    EXPECT_EQ(grouping.group_count, 1u);
+    EXPECT_EQ(grouping.placements[0].group, grouping.placements[1].group);
+    EXPECT_EQ(grouping.placements[0].pair_count, 1);
+    EXPECT_NEAR(static_cast<double>(grouping.placements[0].timeline_offset_samples), sampleRate * 12, 2.0);
+    EXPECT_EQ(grouping.placements[1].timeline_offset_samples, 0);
+    harmoniq_sync_free_grouping_result(&grouping);
+    EXPECT_EQ(grouping.placements, nullptr);
+
+    EXPECT_EQ(harmoniq_sync_group_clips(nullptr, lengths, 2, sampleRate, nullptr).error,
+              HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+}
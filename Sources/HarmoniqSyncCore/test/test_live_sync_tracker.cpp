@@ -0,0 +1,290 @@
+//
+//  test_live_sync_tracker.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for live offset and drift tracking
+//
+
+#include <gtest/gtest.h>
+#include "../include/live_sync_tracker.hpp"
+#include "../include/harmoniq_sync.h"
+#include "test_signals.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+// Every allocation in the test binary goes through here, so a test can check that
+// a stretch of code allocates nothing
+static std::atomic<size_t> allocationCount{0};
+
+static void* countedAllocate(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+
+// Scalar, array and sized forms are all replaced, so every pair of new and delete
+// goes through malloc and free
+void* operator new(size_t size) { return countedAllocate(size); }
+void* operator new[](size_t size) { return countedAllocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+class LiveSyncTrackerTest : public ::testing::Test {
+protected:
+    // Second recording of the source: content at source sample r is at feed sample
+    // offset + r * (1 + ppm * 1e-6), with independent noise on top
+    std::vector<float> record(const std::vector<float>& source, double offset, double ppm, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<float> noise(0.0f, 0.01f);
+        std::vector<float> feed(source.size());
+        for (size_t m = 0; m < feed.size(); ++m) {
+            double position = (static_cast<double>(m) - offset) / (1.0 + ppm * 1e-6);
+            float value = 0.0f;
+            if (position >= 0.0 && position + 1.0 < source.size()) {
+                size_t index = static_cast<size_t>(position);
+                float fraction = static_cast<float>(position - index);
+                value = source[index] * (1.0f - fraction) + source[index + 1] * fraction;
+            }
+            feed[m] = value + noise(gen);
+        }
+        return feed;
+    }
+
+    // Push every feed block by block in lockstep, starting at the given sample
+    void pushAll(LiveSyncTracker& tracker, const std::vector<std::vector<float>>& feeds,
+                 size_t begin, size_t end, size_t blockSize = 512) {
+        for (size_t position = begin; position < end; position += blockSize) {
+            size_t length = std::min(blockSize, end - position);
+            for (size_t feed = 0; feed < feeds.size(); ++feed) {
+                ASSERT_TRUE(tracker.processBlock(feed, feeds[feed].data() + position, length));
+            }
+        }
+    }
+
+    const double sampleRate = 22050.0;
+};
+
+// MARK: - Tracking Tests
+
+TEST_F(LiveSyncTrackerTest, TracksOffsetsOfSeveralFeeds) {
+    auto source = TestSignals::toneBursts(static_cast<size_t>(12 * sampleRate), sampleRate, 3);
+    std::vector<std::vector<float>> feeds = {
+        record(source, 0.0, 0.0, 10),
+        record(source, 3000.0, 0.0, 11),    // Delayed
+        record(source, -2000.0, 0.0, 12),   // Early
+    };
+
+    LiveSyncTracker tracker(sampleRate, feeds.size(), {});
+    EXPECT_GT(tracker.getLagCount(), 2 * 3000 / 256);
+
+    // Nothing is reported before a full window has been correlated
+    size_t halfWindow = static_cast<size_t>(tracker.getSettings().windowSeconds * sampleRate / 2);
+    pushAll(tracker, feeds, 0, halfWindow);
+    EXPECT_EQ(tracker.getEstimate(1).updates, 0u);
+    EXPECT_FALSE(tracker.getEstimate(1).valid);
+
+    pushAll(tracker, feeds, halfWindow, source.size());
+    auto delayed = tracker.getEstimate(1);
+    auto early = tracker.getEstimate(2);
+
+    ASSERT_TRUE(delayed.valid);
+    ASSERT_TRUE(early.valid);
+    EXPECT_NEAR(delayed.offsetSamples, 3000.0, 64.0);
+    EXPECT_NEAR(early.offsetSamples, -2000.0, 64.0);
+    EXPECT_GT(delayed.confidence, 0.5);
+    EXPECT_GT(delayed.secondaryPeakRatio, 1.25);
+    EXPECT_GT(delayed.updates, 10u);
+    EXPECT_NEAR(delayed.timeSeconds, source.size() / sampleRate, 0.2);
+
+    // The reference has no estimate of its own
+    EXPECT_FALSE(tracker.getEstimate(0).valid);
+    EXPECT_EQ(tracker.getEstimate(0).updates, 0u);
+}
+
+TEST_F(LiveSyncTrackerTest, MeasuresDrift) {
+    const double ppm = 500.0;
+    // Estimates scatter by a fraction of a hop, so the fit needs tens of seconds
+    auto source = TestSignals::toneBursts(static_cast<size_t>(45 * sampleRate), sampleRate, 5);
+    std::vector<std::vector<float>> feeds = {
+        record(source, 0.0, 0.0, 20),
+        record(source, 1000.0, ppm, 21),
+    };
+
+    LiveSyncTracker tracker(sampleRate, feeds.size(), {});
+    pushAll(tracker, feeds, 0, source.size());
+
+    auto estimate = tracker.getEstimate(1);
+    ASSERT_TRUE(estimate.valid);
+    ASSERT_GE(estimate.driftPoints, tracker.getSettings().minDriftPoints);
+    EXPECT_NEAR(estimate.driftPpm, ppm, 0.15 * ppm);
+
+    // The offset is the one at the centre of the last window
+    double centre = (estimate.timeSeconds - tracker.getSettings().windowSeconds / 2) * sampleRate;
+    EXPECT_NEAR(estimate.offsetSamples, 1000.0 + centre * ppm * 1e-6, 64.0);
+}
+
+TEST_F(LiveSyncTrackerTest, FollowsRecuedFeed) {
+    auto source = TestSignals::toneBursts(static_cast<size_t>(24 * sampleRate), sampleRate, 7);
+    auto before = record(source, 1000.0, 0.0, 30);
+    auto after = record(source, 4000.0, 0.0, 31);
+
+    // The feed is re-cued halfway, moving its offset from 1000 to 4000 samples
+    size_t cut = source.size() / 2;
+    std::vector<float> feed(before.begin(), before.begin() + cut);
+    feed.insert(feed.end(), after.begin() + cut, after.end());
+    std::vector<std::vector<float>> feeds = { record(source, 0.0, 0.0, 32), feed };
+
+    LiveSyncTracker tracker(sampleRate, feeds.size(), {});
+    pushAll(tracker, feeds, 0, cut);
+    auto first = tracker.getEstimate(1);
+    ASSERT_TRUE(first.valid);
+    EXPECT_NEAR(first.offsetSamples, 1000.0, 64.0);
+
+    pushAll(tracker, feeds, cut, source.size());
+    auto second = tracker.getEstimate(1);
+    ASSERT_TRUE(second.valid);
+    EXPECT_NEAR(second.offsetSamples, 4000.0, 64.0);
+
+    // The jump starts a new drift fit instead of being read as drift
+    EXPECT_LT(std::abs(second.driftPpm), 100.0);
+}
+
+TEST_F(LiveSyncTrackerTest, ToleratesSkewedPushes) {
+    auto source = TestSignals::toneBursts(static_cast<size_t>(16 * sampleRate), sampleRate, 9);
+    std::vector<std::vector<float>> feeds = {
+        record(source, 0.0, 0.0, 40),
+        record(source, 2500.0, 0.0, 41),
+    };
+
+    LiveSyncTracker::Settings settings;
+    settings.maxSkewSeconds = 2.0;
+    LiveSyncTracker tracker(sampleRate, feeds.size(), settings);
+
+    // The reference arrives a second early; the feed catches up within the skew
+    size_t lead = static_cast<size_t>(sampleRate);
+    ASSERT_TRUE(tracker.processBlock(0, feeds[0].data(), lead));
+    for (size_t position = 0; position + lead < source.size(); position += 500) {
+        size_t length = std::min<size_t>(500, source.size() - lead - position);
+        ASSERT_TRUE(tracker.processBlock(1, feeds[1].data() + position, length));
+        ASSERT_TRUE(tracker.processBlock(0, feeds[0].data() + lead + position, length));
+    }
+    ASSERT_TRUE(tracker.processBlock(1, feeds[1].data() + source.size() - lead, lead));
+
+    auto estimate = tracker.getEstimate(1);
+    ASSERT_TRUE(estimate.valid);
+    EXPECT_NEAR(estimate.offsetSamples, 2500.0, 64.0);
+    EXPECT_EQ(tracker.getFrameCount(0), tracker.getFrameCount(1));
+
+    // A feed that falls further behind restarts its window and recovers
+    tracker.reset();
+    size_t farLead = static_cast<size_t>(4 * sampleRate);
+    ASSERT_TRUE(tracker.processBlock(0, feeds[0].data(), farLead));
+    ASSERT_TRUE(tracker.processBlock(1, feeds[1].data(), farLead));
+    pushAll(tracker, feeds, farLead, source.size());
+    estimate = tracker.getEstimate(1);
+    ASSERT_TRUE(estimate.valid);
+    EXPECT_NEAR(estimate.offsetSamples, 2500.0, 64.0);
+}
+
+// MARK: - Real-Time Constraints
+
+TEST_F(LiveSyncTrackerTest, PushingNeverAllocates) {
+    auto source = TestSignals::toneBursts(static_cast<size_t>(12 * sampleRate), sampleRate, 11);
+    std::vector<std::vector<float>> feeds = {
+        record(source, 0.0, 0.0, 50),
+        record(source, 800.0, 0.0, 51),
+        record(source, -800.0, 0.0, 52),
+    };
+
+    // Backend kernels may set up per-thread state on first use; the tracker itself must not allocate
+    LiveSyncTracker warmUp(sampleRate, feeds.size(), {});
+    pushAll(warmUp, feeds, 0, 4096);
+
+    LiveSyncTracker tracker(sampleRate, feeds.size(), {});
+    const size_t footprint = tracker.getFootprintBytes();
+    EXPECT_GT(footprint, 0u);
+
+    size_t before = allocationCount.load();
+    for (size_t position = 0; position < source.size(); position += 256) {
+        size_t length = std::min<size_t>(256, source.size() - position);
+        for (size_t feed = 0; feed < feeds.size(); ++feed) {
+            tracker.processBlock(feed, feeds[feed].data() + position, length);
+        }
+    }
+    auto estimate = tracker.getEstimate(1);
+    EXPECT_EQ(allocationCount.load(), before);
+
+    EXPECT_TRUE(estimate.valid);
+    EXPECT_EQ(tracker.getFootprintBytes(), footprint);
+    EXPECT_GT(tracker.getWorstBlockSeconds(), 0.0);
+
+    // A block completes at most one frame per hop
+    EXPECT_EQ(tracker.getMaxFramesPerBlock(0), 0u);
+    EXPECT_EQ(tracker.getMaxFramesPerBlock(256), 1u);
+    EXPECT_EQ(tracker.getMaxFramesPerBlock(257), 2u);
+}
+
+TEST_F(LiveSyncTrackerTest, RejectsInvalidInput) {
+    LiveSyncTracker::Settings settings;
+    EXPECT_THROW(LiveSyncTracker(0.0, 2, settings), std::invalid_argument);
+    EXPECT_THROW(LiveSyncTracker(sampleRate, 1, settings), std::invalid_argument);
+
+    settings.windowSize = 1000;
+    EXPECT_THROW(LiveSyncTracker(sampleRate, 2, settings), std::invalid_argument);
+    settings = LiveSyncTracker::Settings();
+    settings.hopSize = 2048;
+    EXPECT_THROW(LiveSyncTracker(sampleRate, 2, settings), std::invalid_argument);
+    settings = LiveSyncTracker::Settings();
+    settings.minDriftPoints = settings.driftHistory + 1;
+    EXPECT_THROW(LiveSyncTracker(sampleRate, 2, settings), std::invalid_argument);
+
+    LiveSyncTracker tracker(sampleRate, 2, {});
+    std::vector<float> block(512, 0.1f);
+    EXPECT_TRUE(tracker.processBlock(0, block.data(), 0));
+    EXPECT_FALSE(tracker.processBlock(2, block.data(), block.size()));
+    EXPECT_FALSE(tracker.processBlock(0, nullptr, block.size()));
+
+    block[100] = std::numeric_limits<float>::quiet_NaN();
+    EXPECT_FALSE(tracker.processBlock(1, block.data(), block.size()));
+    EXPECT_EQ(tracker.getFrameCount(1), 0u);
+
+    EXPECT_THROW(tracker.getEstimate(2), std::out_of_range);
+}
+
+// MARK: - C API
+
+TEST_F(LiveSyncTrackerTest, CApiTracksOffset) {
+    auto source = TestSignals::toneBursts(static_cast<size_t>(10 * sampleRate), sampleRate, 13);
+    auto reference = record(source, 0.0, 0.0, 60);
+    auto feed = record(source, 1500.0, 0.0, 61);
+
+    EXPECT_EQ(harmoniq_sync_create_tracker(sampleRate, 1, 0, 0, 0), nullptr);
+
+    auto tracker = harmoniq_sync_create_tracker(sampleRate, 2, 6.0, 0.5, 50.0);
+    ASSERT_NE(tracker, nullptr);
+    for (size_t position = 0; position < source.size(); position += 1024) {
+        size_t length = std::min<size_t>(1024, source.size() - position);
+        EXPECT_EQ(harmoniq_sync_tracker_push(tracker, 0, reference.data() + position, length), HARMONIQ_SYNC_SUCCESS);
+        EXPECT_EQ(harmoniq_sync_tracker_push(tracker, 1, feed.data() + position, length), HARMONIQ_SYNC_SUCCESS);
+    }
+    EXPECT_EQ(harmoniq_sync_tracker_push(tracker, 2, feed.data(), 16), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+
+    harmoniq_sync_live_estimate_t estimate = {};
+    EXPECT_EQ(harmoniq_sync_tracker_get_estimate(tracker, 0, &estimate), HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+    ASSERT_EQ(harmoniq_sync_tracker_get_estimate(tracker, 1, &estimate), HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(estimate.valid, 1);
+    EXPECT_NEAR(estimate.offset_samples, 1500.0, 64.0);
+    EXPECT_GT(estimate.confidence, 0.5);
+
+    harmoniq_sync_destroy_tracker(tracker);
+}
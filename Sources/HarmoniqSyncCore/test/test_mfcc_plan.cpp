@@ -0,0 +1,145 @@
+//
+//  test_mfcc_plan.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for the cached MFCC filterbank and DCT plan
+//
+
+#include <gtest/gtest.h>
+#include "../include/mfcc_plan.hpp"
+#include "../include/audio_processor.hpp"
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class MFCCPlanTest : public ::testing::Test {
+protected:
+    std::vector<float> generateMagnitudes(size_t numFrames, size_t numBins, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dis(0.0f, 2.0f);
+
+        std::vector<float> magnitudes(numFrames * numBins);
+        for (float& value : magnitudes) {
+            value = dis(gen);
+        }
+        return magnitudes;
+    }
+
+    // Dense filterbank and per-frame cosine DCT, as extractMFCC computed them before plans
+    static std::vector<float> referenceMFCC(const std::vector<float>& magnitudes, size_t numFrames, size_t numBins,
+                                            double sampleRate, int numFilters, int numCoeffs) {
+        const int fftSize = static_cast<int>(numBins);
+        float lowMel = MFCCPlan::frequencyToMel(0.0f);
+        float highMel = MFCCPlan::frequencyToMel(sampleRate / 2.0f);
+
+        std::vector<int> bins(numFilters + 2);
+        for (int i = 0; i < numFilters + 2; ++i) {
+            float freq = MFCCPlan::melToFrequency(lowMel + (highMel - lowMel) * i / (numFilters + 1));
+            bins[i] = std::min(static_cast<int>(freq * fftSize * 2 / sampleRate), fftSize - 1);
+        }
+
+        std::vector<std::vector<float>> bank(numFilters, std::vector<float>(numBins, 0.0f));
+        for (int i = 0; i < numFilters; ++i) {
+            for (int j = bins[i]; j < bins[i + 1]; ++j) {
+                bank[i][j] = static_cast<float>(j - bins[i]) / (bins[i + 1] - bins[i]);
+            }
+            for (int j = bins[i + 1]; j < bins[i + 2]; ++j) {
+                bank[i][j] = static_cast<float>(bins[i + 2] - j) / (bins[i + 2] - bins[i + 1]);
+            }
+        }
+
+        std::vector<float> result;
+        std::vector<double> mel(numFilters);
+        for (size_t frame = 0; frame < numFrames; ++frame) {
+            for (int i = 0; i < numFilters; ++i) {
+                double energy = 0.0;
+                for (size_t j = 0; j < numBins; ++j) {
+                    energy += magnitudes[frame * numBins + j] * bank[i][j];
+                }
+                mel[i] = std::log(energy + 1e-10);
+            }
+            for (int k = 0; k < numCoeffs; ++k) {
+                double sum = 0.0;
+                for (int n = 0; n < numFilters; ++n) {
+                    sum += mel[n] * std::cos(M_PI * k * (n + 0.5) / numFilters);
+                }
+                result.push_back(static_cast<float>(sum));
+            }
+        }
+        return result;
+    }
+};
+
+// MARK: - Equivalence Tests
+
+TEST_F(MFCCPlanTest, MatchesDenseReference) {
+    const size_t numBins = 512;
+    // More frames than one block, and a partial last block
+    const size_t numFrames = 600;
+    auto magnitudes = generateMagnitudes(numFrames, numBins, 3);
+
+    for (double sampleRate : {22050.0, 48000.0}) {
+        MFCCPlan plan(sampleRate, numBins, 26, 13);
+        std::vector<float> mfcc(numFrames * 13);
+        plan.apply(magnitudes.data(), numFrames, mfcc.data());
+
+        auto expected = referenceMFCC(magnitudes, numFrames, numBins, sampleRate, 26, 13);
+        ASSERT_EQ(mfcc.size(), expected.size());
+        for (size_t i = 0; i < mfcc.size(); ++i) {
+            ASSERT_NEAR(mfcc[i], expected[i], 1e-3f * std::max(1.0f, std::abs(expected[i]))) << "at index " << i;
+        }
+    }
+}
+
+TEST_F(MFCCPlanTest, FilterbankIsSparse) {
+    MFCCPlan plan(44100.0, 512, 26, 13);
+
+    // Neighbouring triangles overlap once, so every bin appears in at most two filters
+    EXPECT_LE(plan.getWeightCount(), 2u * 512u);
+    EXPECT_GT(plan.getWeightCount(), 0u);
+}
+
+// MARK: - Cache Tests
+
+TEST_F(MFCCPlanTest, GetReusesPlansPerConfiguration) {
+    auto first = MFCCPlan::get(22050.0, 512, 26, 13);
+    auto second = MFCCPlan::get(22050.0, 512, 26, 13);
+    auto otherRate = MFCCPlan::get(44100.0, 512, 26, 13);
+    auto otherCoeffs = MFCCPlan::get(22050.0, 512, 26, 20);
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, otherRate);
+    EXPECT_NE(first, otherCoeffs);
+    EXPECT_EQ(otherCoeffs->getNumCoeffs(), 20);
+}
+
+TEST_F(MFCCPlanTest, ExtractMFCCUsesRequestedFilterCount) {
+    std::vector<float> samples(22050);
+    std::mt19937 gen(9);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+    for (float& sample : samples) {
+        sample = noise(gen);
+    }
+
+    AudioProcessor processor;
+    ASSERT_TRUE(processor.loadAudio(samples.data(), samples.size(), 22050.0));
+
+    const auto& spectrogram = processor.getSpectrogram(1024, 256);
+    auto mfcc = processor.extractMFCC(spectrogram, 13, 40);
+    auto expected = referenceMFCC(spectrogram.magnitudes.toVector(), spectrogram.numFrames, spectrogram.numBins, 22050.0, 40, 13);
+
+    ASSERT_EQ(mfcc.size(), expected.size());
+    for (size_t i = 0; i < mfcc.size(); ++i) {
+        ASSERT_NEAR(mfcc[i], expected[i], 1e-3f * std::max(1.0f, std::abs(expected[i]))) << "at index " << i;
+    }
+}
+
+TEST_F(MFCCPlanTest, ConstructorValidatesArguments) {
+    EXPECT_THROW(MFCCPlan(0.0, 512, 26, 13), std::invalid_argument);
+    EXPECT_THROW(MFCCPlan(22050.0, 1, 26, 13), std::invalid_argument);
+    EXPECT_THROW(MFCCPlan(22050.0, 512, 0, 13), std::invalid_argument);
+    EXPECT_THROW(MFCCPlan(22050.0, 512, 26, 0), std::invalid_argument);
+}
@@ -0,0 +1,103 @@
+//
+//  test_operation_control.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for cancellation tokens and scopes
+//
+
+#include <gtest/gtest.h>
+#include "../include/operation_control.hpp"
+#include "../include/thread_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace HarmoniqSync;
+
+// MARK: - Token Tests
+
+TEST(CancellationTokenTest, CancelAndReset) {
+    CancellationToken token;
+    EXPECT_FALSE(token.isCancelled());
+    EXPECT_FALSE(token.waitForCancellation(std::chrono::milliseconds(1)));
+
+    token.cancel();
+    EXPECT_TRUE(token.isCancelled());
+    EXPECT_TRUE(token.waitForCancellation(std::chrono::milliseconds(0)));
+
+    token.reset();
+    EXPECT_FALSE(token.isCancelled());
+}
+
+TEST(CancellationTokenTest, WaitWakesOnCancel) {
+    CancellationToken token;
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        token.cancel();
+    });
+
+    EXPECT_TRUE(token.waitForCancellation(std::chrono::seconds(10)));
+    canceller.join();
+}
+
+// MARK: - Scope Tests
+
+TEST(CancellationScopeTest, CheckWithoutScopeNeverThrows) {
+    EXPECT_EQ(CancellationScope::current().token, nullptr);
+    EXPECT_NO_THROW(CancellationScope::check());
+}
+
+TEST(CancellationScopeTest, CheckThrowsOnceCancelled) {
+    CancellationToken token;
+    CancellationScope scope(&token);
+    EXPECT_NO_THROW(CancellationScope::check());
+
+    token.cancel();
+    EXPECT_THROW(CancellationScope::check(), OperationCancelledException);
+}
+
+TEST(CancellationScopeTest, CheckThrowsAfterDeadline) {
+    CancellationScope scope(nullptr, CancellationScope::Clock::now() + std::chrono::milliseconds(5));
+    EXPECT_NO_THROW(CancellationScope::check());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_THROW(CancellationScope::check(), OperationTimeoutException);
+}
+
+TEST(CancellationScopeTest, InnermostScopeWinsAndRestores) {
+    CancellationToken outer, inner;
+    outer.cancel();
+
+    CancellationScope outerScope(&outer);
+    {
+        CancellationScope innerScope(&inner);
+        EXPECT_EQ(CancellationScope::current().token, &inner);
+        EXPECT_NO_THROW(CancellationScope::check());
+    }
+    EXPECT_EQ(CancellationScope::current().token, &outer);
+    EXPECT_THROW(CancellationScope::check(), OperationCancelledException);
+}
+
+TEST(CancellationScopeTest, ScopesAreThreadLocalUntilForwarded) {
+    CancellationToken token;
+    token.cancel();
+    CancellationScope scope(&token);
+
+    bool sawToken = true;
+    std::thread worker([&] { sawToken = CancellationScope::current().token != nullptr; });
+    worker.join();
+    EXPECT_FALSE(sawToken);
+
+    // Forwarding the context makes pool tasks stop too
+    auto context = CancellationScope::current();
+    std::atomic<size_t> cancelled{0};
+    ThreadPool::shared().parallelFor(8, 0, [&](size_t, size_t) {
+        CancellationScope forwarded(context);
+        try {
+            CancellationScope::check();
+        } catch (const OperationCancelledException&) {
+            cancelled++;
+        }
+    });
+    EXPECT_EQ(cancelled.load(), 8u);
+}
@@ -0,0 +1,131 @@
+//
+//  test_reference_fingerprint.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for precomputed reference fingerprints and their C API
+//
+
+#include <gtest/gtest.h>
+#include "../include/reference_fingerprint.hpp"
+#include "../include/harmoniq_sync.h"
+#include "test_signals.hpp"
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class ReferenceFingerprintTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        reference = TestSignals::gatedNoise(static_cast<size_t>(sampleRate * 3), 1);
+        config.confidenceThreshold = 0.0;
+        config.hopSize = 256;
+    }
+    
+    std::vector<float> delayed(size_t delay) const {
+        return TestSignals::delayed(reference, delay);
+    }
+    
+    const double sampleRate = 22050.0;
+    std::vector<float> reference;
+    AlignmentEngine::Config config;
+};
+
+// MARK: - Fingerprint Tests
+
+TEST_F(ReferenceFingerprintTest, MatchesDirectAlignment) {
+    auto target = delayed(1024);
+    
+    ReferenceFingerprint fingerprint(reference.data(), reference.size(), sampleRate,
+                                     HARMONIQ_SYNC_ENERGY, config);
+    auto viaFingerprint = fingerprint.align(target.data(), target.size(), sampleRate);
+    
+    AudioProcessor refProcessor, targetProcessor;
+    ASSERT_TRUE(refProcessor.loadAudio(reference.data(), reference.size(), sampleRate));
+    ASSERT_TRUE(targetProcessor.loadAudio(target.data(), target.size(), sampleRate));
+    
+    AlignmentEngine engine;
+    engine.setConfig(config);
+    auto direct = engine.alignEnergyCorrelation(refProcessor, targetProcessor);
+    
+    ASSERT_EQ(viaFingerprint.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(viaFingerprint.offset_samples, direct.offset_samples);
+    EXPECT_NEAR(viaFingerprint.confidence, direct.confidence, 1e-9);
+}
+
+TEST_F(ReferenceFingerprintTest, ReusesReferenceTransforms) {
+    config.correlationMode = CorrelationEngine::Mode::FFT;
+    ReferenceFingerprint fingerprint(reference.data(), reference.size(), sampleRate,
+                                     HARMONIQ_SYNC_SPECTRAL_FLUX, config);
+    
+    auto first = fingerprint.align(delayed(512).data(), reference.size(), sampleRate);
+    ASSERT_EQ(first.error, HARMONIQ_SYNC_SUCCESS);
+    
+    const auto& spectra = fingerprint.getFeatures().spectra;
+    ASSERT_TRUE(spectra != nullptr);
+    EXPECT_EQ(spectra->spectralFlux.size(), 1u);
+    
+    // Same-length targets hit the cached transform and still align correctly
+    auto target = delayed(2048);
+    auto second = fingerprint.align(target.data(), target.size(), sampleRate);
+    EXPECT_EQ(spectra->spectralFlux.size(), 1u);
+    EXPECT_EQ(second.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(second.offset_samples, 2048);
+}
+
+TEST_F(ReferenceFingerprintTest, RejectsMismatchedSampleRate) {
+    ReferenceFingerprint fingerprint(reference.data(), reference.size(), sampleRate,
+                                     HARMONIQ_SYNC_ENERGY, config);
+    auto target = delayed(0);
+    
+    auto result = fingerprint.align(target.data(), target.size(), 44100.0);
+    EXPECT_EQ(result.error, HARMONIQ_SYNC_ERROR_UNSUPPORTED_FORMAT);
+}
+
+TEST_F(ReferenceFingerprintTest, ConstructorThrowsOnInvalidInput) {
+    EXPECT_THROW(ReferenceFingerprint(nullptr, 100, sampleRate, HARMONIQ_SYNC_ENERGY, config), std::invalid_argument);
+    EXPECT_THROW(ReferenceFingerprint(reference.data(), reference.size(), sampleRate,
+                                      static_cast<harmoniq_sync_method_t>(99), config), std::invalid_argument);
+}
+
+// MARK: - C API Tests
+
+TEST_F(ReferenceFingerprintTest, CAPIBatchReturnsResultsInInputOrder) {
+    harmoniq_sync_config_t cConfig = harmoniq_sync_default_config();
+    cConfig.confidence_threshold = 0.0;
+    
+    harmoniq_sync_reference_t* handle = harmoniq_sync_create_reference(
+        reference.data(), reference.size(), sampleRate, HARMONIQ_SYNC_ENERGY, &cConfig);
+    ASSERT_NE(handle, nullptr);
+    
+    std::vector<std::vector<float>> targets = {delayed(0), delayed(1024), delayed(512)};
+    std::vector<const float*> pointers;
+    std::vector<size_t> lengths;
+    for (const auto& target : targets) {
+        pointers.push_back(target.data());
+        lengths.push_back(target.size());
+    }
+    
+    auto batch = harmoniq_sync_align_batch_with_reference(handle, pointers.data(), lengths.data(),
+                                                          targets.size(), sampleRate);
+    ASSERT_EQ(batch.error, HARMONIQ_SYNC_SUCCESS);
+    ASSERT_EQ(batch.count, targets.size());
+    
+    for (size_t i = 0; i < targets.size(); ++i) {
+        auto single = harmoniq_sync_align_with_reference(handle, pointers[i], lengths[i], sampleRate);
+        EXPECT_EQ(batch.results[i].offset_samples, single.offset_samples) << "Target " << i;
+    }
+    EXPECT_EQ(batch.results[1].offset_samples, 1024);
+    
+    harmoniq_sync_free_batch_result(&batch);
+    harmoniq_sync_destroy_reference(handle);
+}
+
+TEST_F(ReferenceFingerprintTest, CAPIRejectsNullHandle) {
+    EXPECT_EQ(harmoniq_sync_create_reference(nullptr, 0, sampleRate, HARMONIQ_SYNC_ENERGY, nullptr), nullptr);
+    
+    auto result = harmoniq_sync_align_with_reference(nullptr, reference.data(), reference.size(), sampleRate);
+    EXPECT_EQ(result.error, HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+    
+    harmoniq_sync_destroy_reference(nullptr);
+}
@@ -0,0 +1,112 @@
+//
+//  test_signals.hpp
+//  HarmoniqSyncCore
+//
+//  Reproducible synthetic signals shared by the unit tests
+//
+
+#ifndef TEST_SIGNALS_HPP
+#define TEST_SIGNALS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace HarmoniqSync {
+namespace TestSignals {
+
+/// Noise with a slow on/off envelope (loud every third 2205-sample stretch), so every method sees distinct structure
+inline std::vector<float> gatedNoise(size_t numSamples, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+
+    std::vector<float> samples(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        float envelope = (i / 2205) % 3 == 0 ? 1.0f : 0.2f;
+        samples[i] = envelope * noise(gen);
+    }
+    return samples;
+}
+
+/// Noise bursts of random length and level, so no lag but the true one lines up
+inline std::vector<float> noiseBursts(size_t numSamples, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+    std::uniform_int_distribution<size_t> segmentLength(2000, 20000);
+    std::uniform_real_distribution<float> level(0.05f, 1.0f);
+
+    std::vector<float> samples;
+    samples.reserve(numSamples);
+    while (samples.size() < numSamples) {
+        size_t length = std::min(segmentLength(gen), numSamples - samples.size());
+        float envelope = level(gen);
+        for (size_t i = 0; i < length; ++i) {
+            samples.push_back(envelope * noise(gen));
+        }
+    }
+    return samples;
+}
+
+/// Clipped noise with a silent stretch from a third to half way through, so the
+/// statistics passes see silent, clipped and ordinary samples
+inline std::vector<float> mixedSignal(size_t numSamples, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> noise(0.1f, 0.3f);
+
+    std::vector<float> samples(numSamples);
+    for (auto& sample : samples) sample = std::clamp(noise(gen), -1.0f, 1.0f);
+    std::fill(samples.begin() + numSamples / 3, samples.begin() + numSamples / 2, 0.0f);
+    return samples;
+}
+
+/// Decaying tone bursts at random pitches and intervals over a light noise floor,
+/// so onsets and their dominant bands form a pattern that never repeats
+inline std::vector<float> toneBursts(size_t numSamples, double sampleRate, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> noise(0.0f, 0.005f);
+    std::uniform_int_distribution<size_t> gap(1500, 6000);
+    std::uniform_real_distribution<double> pitch(std::log(200.0), std::log(6000.0));
+    std::uniform_real_distribution<float> level(0.2f, 0.8f);
+
+    std::vector<float> samples(numSamples);
+    for (auto& sample : samples) sample = noise(gen);
+
+    const double twoPi = 2.0 * M_PI;
+    for (size_t start = gap(gen); start < numSamples; start += gap(gen)) {
+        double frequency = std::exp(pitch(gen));
+        float amplitude = level(gen);
+        size_t length = std::min<size_t>(4000, numSamples - start);
+        for (size_t i = 0; i < length; ++i) {
+            samples[start + i] += amplitude * std::exp(-static_cast<float>(i) / 800.0f) *
+                                  static_cast<float>(std::sin(twoPi * frequency * i / sampleRate));
+        }
+    }
+    return samples;
+}
+
+/// Sine at half of full scale
+inline std::vector<float> tone(double frequency, double sampleRate, size_t numSamples) {
+    std::vector<float> samples(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        samples[i] = 0.5f * static_cast<float>(std::sin(2.0 * M_PI * frequency * i / sampleRate));
+    }
+    return samples;
+}
+
+/// The same length of audio starting delay samples later, as a late-started recorder captures it
+inline std::vector<float> delayed(const std::vector<float>& samples, size_t delay) {
+    std::vector<float> result(delay, 0.0f);
+    result.insert(result.end(), samples.begin(), samples.end() - delay);
+    return result;
+}
+
+} // namespace TestSignals
+} // namespace HarmoniqSync
+
+#endif /* TEST_SIGNALS_HPP */
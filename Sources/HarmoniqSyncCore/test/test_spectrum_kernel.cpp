@@ -0,0 +1,109 @@
+//
+//  test_spectrum_kernel.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for per-length frame spectrum kernels
+//
+
+#include <gtest/gtest.h>
+#include "../include/spectrum_kernel.hpp"
+#include "../include/audio_processor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class SpectrumKernelTest : public ::testing::Test {
+protected:
+    static std::vector<float> noise(size_t length) {
+        std::mt19937 gen(23);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        std::vector<float> samples(length);
+        for (auto& sample : samples) sample = dist(gen);
+        return samples;
+    }
+
+    // Separate window, pack, transform and magnitude passes through the DSP backend
+    static std::vector<float> referencePower(const std::vector<float>& input) {
+        const size_t length = input.size();
+        const size_t half = length / 2;
+        size_t log2Length = 0;
+        while ((size_t(1) << log2Length) < length) ++log2Length;
+
+        std::vector<float> window(length), windowed(length), frame(length), power(half);
+        DSP::hannWindow(window.data(), length);
+        DSP::multiply(input.data(), window.data(), windowed.data(), length);
+        DSP::SplitComplex<float> split = { frame.data(), frame.data() + half };
+        DSP::pack(windowed.data(), split, half);
+        DSP::RealFFT<float> fft(log2Length);
+        fft.forward(split, log2Length);
+        DSP::squaredMagnitudes(split, power.data(), half);
+        DSP::scale(power.data(), 1.0f / static_cast<float>(length * length), power.data(), half);
+        return power;
+    }
+};
+
+// MARK: - Dispatch
+
+TEST_F(SpectrumKernelTest, StandardSizesAreSpecialized) {
+    for (size_t length : {512u, 1024u, 2048u, 4096u}) {
+        EXPECT_TRUE(SpectrumKernel::get(length)->isSpecialized()) << length;
+    }
+    for (size_t length : {2u, 256u, 8192u, 16384u}) {
+        EXPECT_FALSE(SpectrumKernel::get(length)->isSpecialized()) << length;
+    }
+}
+
+TEST_F(SpectrumKernelTest, RejectsUnsupportedLengths) {
+    EXPECT_THROW(SpectrumKernel(0), std::invalid_argument);
+    EXPECT_THROW(SpectrumKernel(1000), std::invalid_argument);
+    EXPECT_THROW(SpectrumKernel::get(SpectrumKernel::MAX_FRAME_LENGTH * 2), std::invalid_argument);
+}
+
+TEST_F(SpectrumKernelTest, SharesKernelsPerLength) {
+    auto kernel = SpectrumKernel::get(1024);
+    EXPECT_EQ(kernel, SpectrumKernel::get(1024));
+    EXPECT_NE(kernel, SpectrumKernel::get(2048));
+    EXPECT_EQ(kernel->getBinCount(), 512u);
+}
+
+// MARK: - Spectra
+
+TEST_F(SpectrumKernelTest, MatchesSeparatePasses) {
+    for (size_t length : {256u, 1024u, 4096u, 8192u}) {
+        auto input = noise(length);
+        auto expected = referencePower(input);
+        auto kernel = SpectrumKernel::get(length);
+
+        std::vector<float> power(length / 2), magnitude(length / 2);
+        kernel->power(input.data(), power.data());
+        kernel->magnitude(input.data(), magnitude.data());
+
+        float peak = *std::max_element(expected.begin(), expected.end());
+        for (size_t k = 0; k < length / 2; ++k) {
+            ASSERT_NEAR(power[k], expected[k], peak * 1e-5f) << length << " bin " << k;
+            ASSERT_NEAR(magnitude[k] * magnitude[k], expected[k] * length, peak * length * 1e-5f)
+                << length << " bin " << k;
+        }
+    }
+}
+
+TEST_F(SpectrumKernelTest, ProcessorFramesUseKernel) {
+    const size_t length = 2048;
+    auto input = noise(length);
+    auto kernel = SpectrumKernel::get(length);
+
+    std::vector<float> kernelPower(length / 2), kernelMagnitude(length / 2);
+    kernel->power(input.data(), kernelPower.data());
+    kernel->magnitude(input.data(), kernelMagnitude.data());
+
+    AudioProcessor processor;
+    std::vector<float> power, magnitude;
+    processor.computePowerSpectrum(input.data(), length, power);
+    processor.computeFFT(input.data(), length, magnitude);
+    EXPECT_EQ(power, kernelPower);
+    EXPECT_EQ(magnitude, kernelMagnitude);
+}
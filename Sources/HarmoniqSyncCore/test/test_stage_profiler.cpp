@@ -0,0 +1,170 @@
+//
+//  test_stage_profiler.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for per-stage timing and allocation tracking
+//
+
+#include <gtest/gtest.h>
+#include "../include/stage_profiler.hpp"
+#include "../include/feature_matrix.hpp"
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace HarmoniqSync;
+
+class StageProfilerTest : public ::testing::Test {
+protected:
+    static void busyWait(std::chrono::milliseconds duration) {
+        auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end) {
+        }
+    }
+
+    static double totalSeconds(const StageProfile& profile) {
+        double total = 0.0;
+        for (double seconds : profile.stageSeconds) total += seconds;
+        return total;
+    }
+};
+
+// MARK: - Timing Tests
+
+TEST_F(StageProfilerTest, TimersWithoutProfilerAreIgnored) {
+    EXPECT_EQ(StageProfiler::active(), nullptr);
+
+    // Must not crash or record anywhere
+    ScopedStageTimer timer(ProcessingStage::STFT);
+    ScopedMethodTimer methodTimer(HARMONIQ_SYNC_CHROMA);
+    StageProfiler::recordAllocation(128);
+    StageProfiler::recordDeallocation(128);
+}
+
+TEST_F(StageProfilerTest, NestedStagesAreExclusive) {
+    StageProfile profile;
+    double elapsed = 0.0;
+    {
+        StageProfiler profiler(&profile);
+        EXPECT_EQ(StageProfiler::active(), &profile);
+        {
+            ScopedStageTimer outer(ProcessingStage::FeatureExtraction);
+            busyWait(std::chrono::milliseconds(10));
+            {
+                ScopedStageTimer inner(ProcessingStage::STFT);
+                busyWait(std::chrono::milliseconds(20));
+            }
+            busyWait(std::chrono::milliseconds(10));
+        }
+        elapsed = profiler.getElapsedSeconds();
+    }
+    EXPECT_EQ(StageProfiler::active(), nullptr);
+
+    EXPECT_GE(profile.seconds(ProcessingStage::STFT), 0.020);
+    EXPECT_GE(profile.seconds(ProcessingStage::FeatureExtraction), 0.020);
+    EXPECT_EQ(profile.seconds(ProcessingStage::Correlation), 0.0);
+
+    // The inner stage is not counted in the outer one as well
+    EXPECT_LE(totalSeconds(profile), elapsed);
+}
+
+TEST_F(StageProfilerTest, SuspendedProfilerChargesEnclosingStage) {
+    StageProfile profile;
+    {
+        StageProfiler profiler(&profile);
+        ScopedStageTimer drift(ProcessingStage::DriftEstimation);
+        {
+            StageProfiler suspended(nullptr);
+            EXPECT_EQ(StageProfiler::active(), nullptr);
+
+            ScopedStageTimer correlation(ProcessingStage::Correlation);
+            busyWait(std::chrono::milliseconds(10));
+        }
+        EXPECT_EQ(StageProfiler::active(), &profile);
+    }
+
+    EXPECT_GE(profile.seconds(ProcessingStage::DriftEstimation), 0.010);
+    EXPECT_EQ(profile.seconds(ProcessingStage::Correlation), 0.0);
+}
+
+TEST_F(StageProfilerTest, MethodTimersAreInclusive) {
+    StageProfile profile;
+    {
+        StageProfiler profiler(&profile);
+        ScopedMethodTimer methodTimer(HARMONIQ_SYNC_ENERGY);
+        ScopedStageTimer correlation(ProcessingStage::Correlation);
+        busyWait(std::chrono::milliseconds(5));
+
+        // Hybrid is not a single method and is not recorded
+        ScopedMethodTimer hybridTimer(HARMONIQ_SYNC_HYBRID);
+    }
+
+    EXPECT_GE(profile.methodSeconds[HARMONIQ_SYNC_ENERGY], profile.seconds(ProcessingStage::Correlation));
+    EXPECT_EQ(profile.methodRuns[HARMONIQ_SYNC_ENERGY], 1u);
+    EXPECT_EQ(profile.methodRuns[HARMONIQ_SYNC_SPECTRAL_FLUX], 0u);
+    EXPECT_EQ(profile.methodSeconds[HARMONIQ_SYNC_SPECTRAL_FLUX], 0.0);
+}
+
+TEST_F(StageProfilerTest, ProfilesAreThreadLocal) {
+    StageProfile profile;
+    StageProfiler profiler(&profile);
+
+    StageProfile* seen = &profile;
+    std::thread worker([&] {
+        seen = StageProfiler::active();
+        ScopedStageTimer timer(ProcessingStage::Correlation);
+    });
+    worker.join();
+
+    EXPECT_EQ(seen, nullptr);
+    EXPECT_EQ(profile.seconds(ProcessingStage::Correlation), 0.0);
+}
+
+// MARK: - Allocation Tests
+
+TEST_F(StageProfilerTest, TracksPeakAlignedStorage) {
+    StageProfile profile;
+    {
+        StageProfiler profiler(&profile);
+        FeatureMatrix first(100, 10);
+        {
+            FeatureMatrix second(50, 10);
+        }
+        FeatureMatrix third(20, 10);
+    }
+
+    EXPECT_EQ(profile.peakAllocatedBytes, 150 * 10 * sizeof(float));
+    EXPECT_EQ(profile.allocatedBytes, 0);
+}
+
+TEST_F(StageProfilerTest, StorageFromBeforeProfilingDoesNotCount) {
+    auto matrix = std::make_unique<FeatureMatrix>(100, 10);
+
+    StageProfile profile;
+    {
+        StageProfiler profiler(&profile);
+        matrix.reset();
+        FeatureMatrix small(10, 10);
+    }
+
+    EXPECT_EQ(profile.peakAllocatedBytes, 0u);
+}
+
+TEST_F(StageProfilerTest, MergeSumsTimesAndStacksPeaks) {
+    StageProfile total, worker;
+    total.stageSeconds[static_cast<size_t>(ProcessingStage::STFT)] = 1.0;
+    total.allocatedBytes = 300;
+    total.peakAllocatedBytes = 500;
+
+    worker.stageSeconds[static_cast<size_t>(ProcessingStage::STFT)] = 0.5;
+    worker.methodSeconds[HARMONIQ_SYNC_MFCC] = 0.25;
+    worker.methodRuns[HARMONIQ_SYNC_MFCC] = 2;
+    worker.peakAllocatedBytes = 400;
+
+    total.merge(worker);
+    EXPECT_DOUBLE_EQ(total.seconds(ProcessingStage::STFT), 1.5);
+    EXPECT_DOUBLE_EQ(total.methodSeconds[HARMONIQ_SYNC_MFCC], 0.25);
+    EXPECT_EQ(total.methodRuns[HARMONIQ_SYNC_MFCC], 2u);
+    EXPECT_EQ(total.peakAllocatedBytes, 700u);
+    EXPECT_DOUBLE_EQ(totalSeconds(total), 1.5);
+}
@@ -0,0 +1,176 @@
+//
+//  test_streaming_feature_extractor.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for block-wise feature extraction
+//
+
+#include <gtest/gtest.h>
+#include "../include/streaming_feature_extractor.hpp"
+#include "../include/reference_fingerprint.hpp"
+#include "test_signals.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class StreamingFeatureExtractorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Gated noise plus a tone for chroma
+        samples = TestSignals::gatedNoise(static_cast<size_t>(sampleRate * 2), 7);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            samples[i] += 0.2f * std::sin(2.0f * static_cast<float>(M_PI) * 440.0f * i / static_cast<float>(sampleRate));
+        }
+    }
+
+    // Push the samples in blocks of blockSize (the last block may be shorter)
+    void stream(StreamingFeatureExtractor& extractor, size_t blockSize) const {
+        for (size_t pos = 0; pos < samples.size(); pos += blockSize) {
+            size_t length = std::min(blockSize, samples.size() - pos);
+            ASSERT_TRUE(extractor.processBlock(samples.data() + pos, length));
+        }
+    }
+
+    static void expectEqual(const std::vector<float>& expected, const std::vector<float>& actual) {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_FLOAT_EQ(expected[i], actual[i]) << "at index " << i;
+        }
+    }
+
+    const double sampleRate = 22050.0;
+    std::vector<float> samples;
+};
+
+// MARK: - Batch Equivalence Tests
+
+TEST_F(StreamingFeatureExtractorTest, MatchesBatchExtraction) {
+    AudioProcessor processor;
+    ASSERT_TRUE(processor.loadAudio(samples.data(), samples.size(), sampleRate));
+
+    // Default configuration: 12 harmonically weighted chroma bins
+    AlignmentEngine::Config config;
+
+    // Block sizes smaller than, unrelated to and larger than the window
+    for (size_t blockSize : {100u, 1000u, 4096u}) {
+        StreamingFeatureExtractor extractor(sampleRate, HARMONIQ_SYNC_HYBRID);
+        stream(extractor, blockSize);
+
+        expectEqual(processor.extractSpectralFlux(1024, 256), extractor.getSpectralFlux());
+        expectEqual(processor.extractChromaFeatures(1024, 256, config.chroma.numChromaBins, config.chroma.useHarmonicWeighting),
+                    extractor.getChromaFeatures().toVector());
+        expectEqual(processor.extractEnergyProfile(1024, 512), extractor.getEnergyProfile());
+        expectEqual(processor.extractMFCC(13, 1024, 256), extractor.getMFCC().toVector());
+        EXPECT_EQ(extractor.getSamplesProcessed(), samples.size());
+    }
+}
+
+TEST_F(StreamingFeatureExtractorTest, PreparedFeaturesMatchBatch) {
+    AlignmentEngine::Config config;
+    config.hopSize = 256;
+
+    AlignmentEngine engine;
+    engine.setConfig(config);
+
+    AudioProcessor processor;
+    ASSERT_TRUE(processor.loadAudio(samples.data(), samples.size(), sampleRate));
+    auto batch = engine.prepareFeatures(processor, HARMONIQ_SYNC_HYBRID);
+
+    StreamingFeatureExtractor extractor(sampleRate, HARMONIQ_SYNC_HYBRID, config);
+    stream(extractor, 512);
+    auto streamed = engine.prepareFeatures(extractor);
+
+    EXPECT_EQ(batch.audioLength, streamed.audioLength);
+    EXPECT_EQ(batch.hopSize, streamed.hopSize);
+    EXPECT_EQ(batch.energyHopSize, streamed.energyHopSize);
+    expectEqual(batch.spectralFlux, streamed.spectralFlux);
+    expectEqual(batch.energy, streamed.energy);
+    expectEqual(batch.chroma.toVector(), streamed.chroma.toVector());
+    expectEqual(batch.mfcc.toVector(), streamed.mfcc.toVector());
+}
+
+// MARK: - Streaming Behaviour Tests
+
+TEST_F(StreamingFeatureExtractorTest, BuffersAtMostOneWindow) {
+    StreamingFeatureExtractor extractor(sampleRate, HARMONIQ_SYNC_HYBRID);
+
+    for (size_t pos = 0; pos + 700 <= samples.size(); pos += 700) {
+        ASSERT_TRUE(extractor.processBlock(samples.data() + pos, 700));
+        EXPECT_LT(extractor.getBufferedSamples(), static_cast<size_t>(extractor.getWindowSize()));
+    }
+}
+
+TEST_F(StreamingFeatureExtractorTest, OnlyRequestedStreamsAreExtracted) {
+    StreamingFeatureExtractor extractor(sampleRate, HARMONIQ_SYNC_ENERGY);
+    stream(extractor, 1000);
+
+    EXPECT_FALSE(extractor.getEnergyProfile().empty());
+    EXPECT_TRUE(extractor.getSpectralFlux().empty());
+    EXPECT_TRUE(extractor.getChromaFeatures().empty());
+    EXPECT_TRUE(extractor.getMFCC().empty());
+}
+
+TEST_F(StreamingFeatureExtractorTest, RejectsInvalidBlocks) {
+    StreamingFeatureExtractor extractor(sampleRate, HARMONIQ_SYNC_SPECTRAL_FLUX);
+
+    std::vector<float> bad(64, 0.0f);
+    bad[10] = std::numeric_limits<float>::quiet_NaN();
+
+    EXPECT_FALSE(extractor.processBlock(nullptr, 10));
+    EXPECT_FALSE(extractor.processBlock(bad.data(), bad.size()));
+    EXPECT_TRUE(extractor.processBlock(nullptr, 0));
+    EXPECT_EQ(extractor.getSamplesProcessed(), 0u);
+}
+
+TEST_F(StreamingFeatureExtractorTest, ResetDiscardsState) {
+    StreamingFeatureExtractor extractor(sampleRate, HARMONIQ_SYNC_HYBRID);
+    stream(extractor, 2048);
+    extractor.reset();
+
+    EXPECT_EQ(extractor.getSamplesProcessed(), 0u);
+    EXPECT_EQ(extractor.getSpectralFrameCount(), 0u);
+    EXPECT_EQ(extractor.getBufferedSamples(), 0u);
+    EXPECT_TRUE(extractor.getMFCC().empty());
+}
+
+TEST_F(StreamingFeatureExtractorTest, ConstructorValidatesArguments) {
+    AlignmentEngine::Config config;
+    config.windowSize = 1000;
+
+    EXPECT_THROW(StreamingFeatureExtractor(1000.0, HARMONIQ_SYNC_ENERGY), std::invalid_argument);
+    EXPECT_THROW(StreamingFeatureExtractor(sampleRate, static_cast<harmoniq_sync_method_t>(99)), std::invalid_argument);
+    EXPECT_THROW(StreamingFeatureExtractor(sampleRate, HARMONIQ_SYNC_ENERGY, config), std::invalid_argument);
+}
+
+// MARK: - Fingerprint Tests
+
+TEST_F(StreamingFeatureExtractorTest, StreamedFingerprintMatchesBatchFingerprint) {
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+    config.hopSize = 256;
+
+    StreamingFeatureExtractor extractor(sampleRate, HARMONIQ_SYNC_ENERGY, config);
+    stream(extractor, 4096);
+    ReferenceFingerprint streamed(extractor);
+    ReferenceFingerprint batch(samples.data(), samples.size(), sampleRate, HARMONIQ_SYNC_ENERGY, config);
+
+    const size_t delay = 2048;
+    std::vector<float> target(delay, 0.0f);
+    target.insert(target.end(), samples.begin(), samples.end() - delay);
+
+    auto viaStream = streamed.align(target.data(), target.size(), sampleRate);
+    auto viaBatch = batch.align(target.data(), target.size(), sampleRate);
+
+    EXPECT_EQ(viaStream.error, HARMONIQ_SYNC_SUCCESS);
+    EXPECT_EQ(viaStream.offset_samples, viaBatch.offset_samples);
+    EXPECT_DOUBLE_EQ(viaStream.confidence, viaBatch.confidence);
+}
+
+TEST_F(StreamingFeatureExtractorTest, EmptyStreamFingerprintThrows) {
+    StreamingFeatureExtractor extractor(sampleRate, HARMONIQ_SYNC_ENERGY);
+    EXPECT_THROW(ReferenceFingerprint fingerprint(extractor), std::invalid_argument);
+}
@@ -0,0 +1,133 @@
+//
+//  test_thread_pool.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for ThreadPool and parallel batch alignment
+//
+
+#include <gtest/gtest.h>
+#include "../include/thread_pool.hpp"
+#include "../include/alignment_engine.hpp"
+#include "test_signals.hpp"
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+class ThreadPoolTest : public ::testing::Test {};
+
+// MARK: - Pool Tests
+
+TEST_F(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+
+    pool.parallelFor(visits.size(), 0, [&](size_t index, size_t) {
+        visits[index].fetch_add(1);
+    });
+
+    for (size_t i = 0; i < visits.size(); ++i) {
+        EXPECT_EQ(visits[i].load(), 1) << "Index " << i;
+    }
+}
+
+TEST_F(ThreadPoolTest, SlotsAreExclusiveAndBounded) {
+    ThreadPool pool(4);
+    const size_t maxParallelism = 3;
+    std::vector<std::atomic<int>> inUse(maxParallelism);
+    std::atomic<bool> overlap(false);
+    std::atomic<bool> outOfRange(false);
+
+    pool.parallelFor(200, maxParallelism, [&](size_t, size_t slot) {
+        if (slot >= maxParallelism) {
+            outOfRange = true;
+            return;
+        }
+        if (inUse[slot].fetch_add(1) != 0) overlap = true;
+        std::this_thread::yield();
+        inUse[slot].fetch_sub(1);
+    });
+
+    EXPECT_FALSE(outOfRange.load());
+    EXPECT_FALSE(overlap.load());
+}
+
+TEST_F(ThreadPoolTest, ExceptionIsRethrownToCaller) {
+    ThreadPool pool(2);
+
+    EXPECT_THROW(pool.parallelFor(100, 0, [](size_t index, size_t) {
+        if (index == 42) throw std::runtime_error("failure");
+    }), std::runtime_error);
+
+    // Pool remains usable afterwards
+    std::atomic<size_t> count(0);
+    pool.parallelFor(10, 0, [&](size_t, size_t) { count.fetch_add(1); });
+    EXPECT_EQ(count.load(), 10u);
+}
+
+TEST_F(ThreadPoolTest, NestedParallelForCompletes) {
+    ThreadPool pool(2);
+    std::atomic<size_t> count(0);
+
+    pool.parallelFor(8, 0, [&](size_t, size_t) {
+        pool.parallelFor(8, 0, [&](size_t, size_t) { count.fetch_add(1); });
+    });
+
+    EXPECT_EQ(count.load(), 64u);
+}
+
+// MARK: - Batch Alignment Tests
+
+TEST_F(ThreadPoolTest, ParallelBatchMatchesSerialInInputOrder) {
+    const double sampleRate = 22050.0;
+    auto referenceSamples = TestSignals::gatedNoise(static_cast<size_t>(sampleRate * 3), 1);
+
+    AudioProcessor reference;
+    ASSERT_TRUE(reference.loadAudio(referenceSamples.data(), referenceSamples.size(), sampleRate));
+
+    // Targets are delayed copies at different offsets
+    const std::vector<size_t> delays = {0, 512, 1024, 2048, 256, 768};
+    std::vector<AudioProcessor> targets(delays.size());
+    for (size_t i = 0; i < delays.size(); ++i) {
+        auto delayed = TestSignals::delayed(referenceSamples, delays[i]);
+        ASSERT_TRUE(targets[i].loadAudio(delayed.data(), delayed.size(), sampleRate));
+    }
+
+    AlignmentEngine::Config config;
+    config.confidenceThreshold = 0.0;
+    config.hopSize = 256;
+
+    AlignmentEngine serialEngine;
+    config.numWorkers = 1;
+    serialEngine.setConfig(config);
+    auto serial = serialEngine.alignBatch(reference, targets, HARMONIQ_SYNC_ENERGY);
+
+    AlignmentEngine parallelEngine;
+    config.numWorkers = 4;
+    parallelEngine.setConfig(config);
+    auto parallel = parallelEngine.alignBatch(reference, targets, HARMONIQ_SYNC_ENERGY);
+
+    ASSERT_EQ(serial.size(), delays.size());
+    ASSERT_EQ(parallel.size(), delays.size());
+
+    for (size_t i = 0; i < delays.size(); ++i) {
+        EXPECT_EQ(parallel[i].error, serial[i].error);
+        EXPECT_EQ(parallel[i].offset_samples, serial[i].offset_samples);
+        EXPECT_DOUBLE_EQ(parallel[i].confidence, serial[i].confidence);
+    }
+}
+
+TEST_F(ThreadPoolTest, BatchWithInvalidReferenceReportsEveryTarget) {
+    AudioProcessor reference;
+    std::vector<AudioProcessor> targets(3);
+
+    AlignmentEngine engine;
+    auto results = engine.alignBatch(reference, targets, HARMONIQ_SYNC_SPECTRAL_FLUX);
+
+    ASSERT_EQ(results.size(), 3u);
+    for (const auto& result : results) {
+        EXPECT_EQ(result.error, HARMONIQ_SYNC_ERROR_INVALID_INPUT);
+    }
+}
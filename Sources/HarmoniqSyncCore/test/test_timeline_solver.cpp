@@ -0,0 +1,80 @@
+//
+//  test_timeline_solver.cpp
+//  HarmoniqSyncCore
+//
+//  Unit tests for placing clips on timelines from pairwise offsets
+//
+
+#include <gtest/gtest.h>
+#include "../include/timeline_solver.hpp"
+#include <stdexcept>
+#include <vector>
+
+using namespace HarmoniqSync;
+
+// Offset reported when aligning `target` against `reference` for clips starting at these positions
+static TimelineSolver::Measurement measure(const std::vector<double>& starts, size_t reference, size_t target,
+                                           double error = 0.0, double weight = 1.0) {
+    return {reference, target, starts[reference] - starts[target] + error, weight};
+}
+
+// MARK: - Placement Tests
+
+TEST(TimelineSolverTest, SpanningTreePlacesChain) {
+    const std::vector<double> starts = {1000.0, 0.0, 5000.0, 2500.0};
+    auto solution = TimelineSolver::solve(4, {measure(starts, 0, 1), measure(starts, 2, 1), measure(starts, 3, 2)}, 10.0);
+
+    EXPECT_EQ(solution.groupCount, 1u);
+    for (size_t clip = 0; clip < starts.size(); ++clip) {
+        EXPECT_EQ(solution.clips[clip].group, 0u);
+        EXPECT_NEAR(solution.clips[clip].startSamples, starts[clip], 1e-9) << clip;
+    }
+    EXPECT_EQ(solution.clips[1].measurements, 2u);
+    EXPECT_EQ(solution.clips[3].measurements, 1u);
+}
+
+TEST(TimelineSolverTest, LeastSquaresAveragesRedundantPairs) {
+    // A triangle of pairs each 2 samples off; the spanning tree alone would place
+    // the clips at 298 and 696
+    const std::vector<double> starts = {0.0, 300.0, 700.0};
+    auto solution = TimelineSolver::solve(3, {measure(starts, 0, 1, 2.0), measure(starts, 1, 2, 2.0),
+                                              measure(starts, 0, 2, -2.0)}, 10.0);
+
+    // The fit spreads the loop error over all three pairs, which cancels it here
+    EXPECT_NEAR(solution.clips[1].startSamples - solution.clips[0].startSamples, 300.0, 1e-6);
+    EXPECT_NEAR(solution.clips[2].startSamples - solution.clips[0].startSamples, 700.0, 1e-6);
+    for (bool used : solution.consistent) EXPECT_TRUE(used);
+}
+
+TEST(TimelineSolverTest, InconsistentPairsAreDropped) {
+    const std::vector<double> starts = {0.0, 400.0, 900.0};
+    auto solution = TimelineSolver::solve(3, {measure(starts, 0, 1, 0.0, 0.9), measure(starts, 1, 2, 0.0, 0.8),
+                                              measure(starts, 0, 2, 4000.0, 0.5)}, 10.0);
+
+    EXPECT_TRUE(solution.consistent[0]);
+    EXPECT_TRUE(solution.consistent[1]);
+    EXPECT_FALSE(solution.consistent[2]);
+    EXPECT_NEAR(solution.clips[2].startSamples, 900.0, 1e-9);
+}
+
+TEST(TimelineSolverTest, UnlinkedClipsFormTheirOwnGroups) {
+    const std::vector<double> starts = {0.0, 0.0, 800.0, 200.0};
+    auto solution = TimelineSolver::solve(4, {measure(starts, 3, 2), {1, 1, 5.0, 1.0}, measure(starts, 0, 1, 0.0, 0.0)}, 10.0);
+
+    EXPECT_EQ(solution.groupCount, 3u);
+    EXPECT_EQ(solution.clips[0].group, 0u);
+    EXPECT_EQ(solution.clips[1].group, 1u);
+    EXPECT_EQ(solution.clips[2].group, 2u);
+    EXPECT_EQ(solution.clips[3].group, 2u);
+
+    // Every group starts at its earliest clip
+    EXPECT_EQ(solution.clips[0].startSamples, 0.0);
+    EXPECT_EQ(solution.clips[1].measurements, 0u);
+    EXPECT_NEAR(solution.clips[3].startSamples, 0.0, 1e-9);
+    EXPECT_NEAR(solution.clips[2].startSamples, 600.0, 1e-9);
+}
+
+TEST(TimelineSolverTest, RejectsClipsOutOfRange) {
+    EXPECT_THROW(TimelineSolver::solve(2, {{0, 2, 0.0, 1.0}}, 10.0), std::invalid_argument);
+    EXPECT_EQ(TimelineSolver::solve(0, {}, 10.0).groupCount, 0u);
+}
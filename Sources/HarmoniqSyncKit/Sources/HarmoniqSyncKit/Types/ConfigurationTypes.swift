@@ -12,7 +12,7 @@ import HarmoniqSyncCore
 
 public struct SyncConfiguration: Sendable {
     public let confidenceThreshold: Double
-    public let maxOffsetSeconds: Double?
+    public let maxOffsetSeconds: Double?  // Largest offset searched (nil = a quarter of the shorter clip)
     public let windowSize: Int
     public let hopSize: Int?
     public let noiseGateDb: Double
@@ -45,7 +45,13 @@ public struct SyncConfiguration: Sendable {
             window_size: Int32(windowSize),
             hop_size: Int32(actualHopSize),
             noise_gate_db: noiseGateDb,
-            enable_drift_correction: enableDriftCorrection ? 1 : 0
+            enable_drift_correction: enableDriftCorrection ? 1 : 0,
+            worker_count: 0,
+            coarse_hop_size: 0,
+            analysis_sample_rate: 0,
+            hybrid_cascade: 0,
+            correlation_precision: 0,
+            correlation_memory_mb: 0
         )
     }
     
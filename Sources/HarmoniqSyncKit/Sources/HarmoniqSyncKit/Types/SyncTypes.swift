@@ -94,17 +94,19 @@ public struct AlignmentResult: Sendable {
     public let secondaryPeakRatio: Double
     public let snrEstimate: Double
     public let noiseFloorDb: Double
+    public let driftPpm: Double  // Target clock drift (0 = none detected)
     public let method: String
     public let isValid: Bool
     
     internal init(from cResult: harmoniq_sync_result_t, sampleRate: Double) {
         self.offsetSamples = cResult.offset_samples
-        self.offsetSeconds = Double(cResult.offset_samples) / sampleRate
+        self.offsetSeconds = cResult.offset_samples_fractional / sampleRate
         self.confidence = cResult.confidence
         self.peakCorrelation = cResult.peak_correlation
         self.secondaryPeakRatio = cResult.secondary_peak_ratio
         self.snrEstimate = cResult.snr_estimate
         self.noiseFloorDb = cResult.noise_floor_db
+        self.driftPpm = cResult.drift_ppm
         self.method = String(cString: withUnsafeBytes(of: cResult.method) { bytes in
             bytes.bindMemory(to: CChar.self).baseAddress!
         })
@@ -265,7 +267,7 @@ extension AlignmentResult {
             components.append("SNR: \(String(format: "%.1f dB", snrEstimate))")
         }
         
-        if secondaryPeakRatio < 0.5 {
+        if secondaryPeakRatio > 2.0 {
             components.append("Clear primary peak")
         } else {
             components.append("Multiple potential peaks")